@@ -1,48 +1,434 @@
 #pragma once
 
-#include <unordered_map>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <limits>
 #include <list>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct CacheStatistics
+{
+    uint64_t numHits = 0;
+    uint64_t numMisses = 0;
+    uint64_t numEvictions = 0;
+
+    int numEntries = 0;
+    uint64_t numBytes = 0;
+
+    //spill tier
+    uint64_t numSpillHits = 0;
+    int numSpilledEntries = 0;
+    uint64_t numSpilledBytes = 0;
+};
+
+/**
+ * Memory budget shared by all caches of the process. A cache which allocates beyond the budget evicts its own entries until the budget is
+ * met again.
+ */
+class CacheMemoryBudget
+{
+public:
+    //the instance is never destroyed since caches may be members of other singletons which are destroyed later
+    static CacheMemoryBudget& get()
+    {
+        static auto instance = new CacheMemoryBudget;
+        return *instance;
+    }
+
+    static uint64_t constexpr DefaultMaxBytes = 2ull << 30;
+
+    void setMaxBytes(uint64_t value) { _maxBytes = value; }
+    uint64_t getMaxBytes() const { return _maxBytes; }
+    uint64_t getUsedBytes() const { return _usedBytes; }
+    bool isExceeded() const { return _usedBytes > _maxBytes; }
 
-template<typename Key, typename Value, int MaxEntries>
+    void allocate(uint64_t numBytes) { _usedBytes += numBytes; }
+    void release(uint64_t numBytes) { _usedBytes -= numBytes; }
+
+private:
+    std::atomic<uint64_t> _maxBytes = DefaultMaxBytes;
+    std::atomic<uint64_t> _usedBytes = 0;
+
+    CacheMemoryBudget() = default;
+    CacheMemoryBudget(CacheMemoryBudget const&) = delete;
+    CacheMemoryBudget& operator=(CacheMemoryBudget const&) = delete;
+};
+
+/**
+ * Thread-safe LRU cache with a byte budget. The sizes of the values are estimated by a pluggable size function.
+ * Entries are distributed on shards with separate locks. If the budget of the cache or the global CacheMemoryBudget is exceeded, the least
+ * recently used entries are evicted, except for the most recently inserted entry. Evicted entries are moved to an optional spill tier on
+ * disk and reloaded on access.
+ */
+template <typename Key, typename Value>
 class Cache
 {
 public:
-    void insertOrAssign(Key const& key, Value const& value);
+    using SizeFunction = std::function<uint64_t(Value const&)>;
+
+    struct SpillTier
+    {
+        std::filesystem::path directory;
+        uint64_t maxBytes = 0;
+        std::function<std::string(Value const&)> serialize;
+        std::function<Value(std::string const&)> deserialize;  //throws std::runtime_error
+    };
 
+    static int constexpr DefaultNumShards = 8;
+
+    Cache(uint64_t maxBytes, SizeFunction const& sizeFunction = [](Value const&) { return sizeof(Value); }, int numShards = DefaultNumShards);
+    ~Cache();
+
+    Cache(Cache const&) = delete;
+    Cache& operator=(Cache const&) = delete;
+
+    void setSpillTier(SpillTier const& spillTier);
+
+    void insertOrAssign(Key const& key, Value const& value);
     std::optional<Value> find(Key const& key);
+    void erase(Key const& key);
+    void clear();
+
+    CacheStatistics getStatistics() const;
 
 private:
-    std::unordered_map<Key, Value> _cacheMap;
-    std::list<Key> _usedKeys;
+    struct Entry
+    {
+        Key key;
+        std::shared_ptr<Value const> value;
+        uint64_t size = 0;
+        uint64_t lastAccess = 0;
+    };
+    struct Shard
+    {
+        std::mutex mutex;
+        std::list<Entry> entries;  //most recently used entry first
+        std::unordered_map<Key, typename std::list<Entry>::iterator> entryByKey;
+    };
+    struct SpilledEntry
+    {
+        Key key;
+        std::filesystem::path filename;
+        uint64_t size = 0;
+    };
+
+    Shard& getShard(Key const& key);
+    void eraseFromShard(Shard& shard, typename std::list<Entry>::iterator entryIt);
+    void evictEntries();
+
+    void spill(Key const& key, Value const& value);
+    std::optional<Value> loadFromSpillTier(Key const& key);
+    void eraseFromSpillTier(Key const& key);
+    void eraseSpilledEntry(typename std::list<SpilledEntry>::iterator entryIt);
+
+    uint64_t _maxBytes = 0;
+    SizeFunction _sizeFunction;
+    std::vector<Shard> _shards;
+
+    std::atomic<uint64_t> _accessCounter = 0;
+    std::atomic<int> _numEntries = 0;
+    std::atomic<uint64_t> _numBytes = 0;
+    std::atomic<uint64_t> _numHits = 0;
+    std::atomic<uint64_t> _numMisses = 0;
+    std::atomic<uint64_t> _numEvictions = 0;
+    std::atomic<uint64_t> _numSpillHits = 0;
+
+    mutable std::mutex _spillMutex;
+    std::optional<SpillTier> _spillTier;
+    std::string _spillFilePrefix;
+    uint64_t _spillFileCounter = 0;
+    std::list<SpilledEntry> _spilledEntries;  //most recently spilled entry first
+    std::unordered_map<Key, typename std::list<SpilledEntry>::iterator> _spilledEntryByKey;
+    uint64_t _numSpilledBytes = 0;
 };
 
 /************************************************************************/
 /* Implementation                                                       */
 /************************************************************************/
-template <typename Key, typename Value, int MaxEntries>
-void Cache<Key, Value, MaxEntries>::insertOrAssign(Key const& key, Value const& value)
+template <typename Key, typename Value>
+Cache<Key, Value>::Cache(uint64_t maxBytes, SizeFunction const& sizeFunction, int numShards)
+    : _maxBytes(maxBytes)
+    , _sizeFunction(sizeFunction)
+    , _shards(std::max(1, numShards))
+    , _spillFilePrefix("cache_" + std::to_string(std::random_device()()) + "_")
+{}
+
+template <typename Key, typename Value>
+Cache<Key, Value>::~Cache()
+{
+    clear();
+}
+
+template <typename Key, typename Value>
+void Cache<Key, Value>::setSpillTier(SpillTier const& spillTier)
+{
+    std::lock_guard lock(_spillMutex);
+    _spillTier = spillTier;
+}
+
+template <typename Key, typename Value>
+void Cache<Key, Value>::insertOrAssign(Key const& key, Value const& value)
+{
+    auto sharedValue = std::make_shared<Value const>(value);
+    auto size = _sizeFunction(value);
+    {
+        auto& shard = getShard(key);
+        std::lock_guard lock(shard.mutex);
+        auto findResult = shard.entryByKey.find(key);
+        if (findResult != shard.entryByKey.end()) {
+            eraseFromShard(shard, findResult->second);
+        }
+        shard.entries.emplace_front(Entry{key, sharedValue, size, ++_accessCounter});
+        shard.entryByKey.emplace(key, shard.entries.begin());
+        ++_numEntries;
+        _numBytes += size;
+        CacheMemoryBudget::get().allocate(size);
+    }
+    eraseFromSpillTier(key);
+    evictEntries();
+}
+
+template <typename Key, typename Value>
+std::optional<Value> Cache<Key, Value>::find(Key const& key)
+{
+    std::shared_ptr<Value const> value;
+    {
+        auto& shard = getShard(key);
+        std::lock_guard lock(shard.mutex);
+        auto findResult = shard.entryByKey.find(key);
+        if (findResult != shard.entryByKey.end()) {
+            auto entryIt = findResult->second;
+            entryIt->lastAccess = ++_accessCounter;
+            shard.entries.splice(shard.entries.begin(), shard.entries, entryIt);
+            value = entryIt->value;
+        }
+    }
+
+    //the value is copied outside the lock
+    if (value) {
+        ++_numHits;
+        return *value;
+    }
+    if (auto spilledValue = loadFromSpillTier(key)) {
+        ++_numHits;
+        ++_numSpillHits;
+        insertOrAssign(key, *spilledValue);
+        return spilledValue;
+    }
+    ++_numMisses;
+    return std::nullopt;
+}
+
+template <typename Key, typename Value>
+void Cache<Key, Value>::erase(Key const& key)
+{
+    {
+        auto& shard = getShard(key);
+        std::lock_guard lock(shard.mutex);
+        auto findResult = shard.entryByKey.find(key);
+        if (findResult != shard.entryByKey.end()) {
+            eraseFromShard(shard, findResult->second);
+        }
+    }
+    eraseFromSpillTier(key);
+}
+
+template <typename Key, typename Value>
+void Cache<Key, Value>::clear()
+{
+    for (auto& shard : _shards) {
+        std::lock_guard lock(shard.mutex);
+        while (!shard.entries.empty()) {
+            eraseFromShard(shard, shard.entries.begin());
+        }
+    }
+
+    std::lock_guard lock(_spillMutex);
+    while (!_spilledEntries.empty()) {
+        eraseSpilledEntry(_spilledEntries.begin());
+    }
+}
+
+template <typename Key, typename Value>
+CacheStatistics Cache<Key, Value>::getStatistics() const
+{
+    CacheStatistics result;
+    result.numHits = _numHits;
+    result.numMisses = _numMisses;
+    result.numEvictions = _numEvictions;
+    result.numEntries = _numEntries;
+    result.numBytes = _numBytes;
+    result.numSpillHits = _numSpillHits;
+
+    std::lock_guard lock(_spillMutex);
+    result.numSpilledEntries = static_cast<int>(_spilledEntries.size());
+    result.numSpilledBytes = _numSpilledBytes;
+    return result;
+}
+
+template <typename Key, typename Value>
+auto Cache<Key, Value>::getShard(Key const& key) -> Shard&
+{
+    return _shards.at(std::hash<Key>{}(key) % _shards.size());
+}
+
+template <typename Key, typename Value>
+void Cache<Key, Value>::eraseFromShard(Shard& shard, typename std::list<Entry>::iterator entryIt)
+{
+    --_numEntries;
+    _numBytes -= entryIt->size;
+    CacheMemoryBudget::get().release(entryIt->size);
+    shard.entryByKey.erase(entryIt->key);
+    shard.entries.erase(entryIt);
+}
+
+template <typename Key, typename Value>
+void Cache<Key, Value>::evictEntries()
+{
+    while ((_numBytes > _maxBytes || CacheMemoryBudget::get().isExceeded()) && _numEntries > 1) {
+
+        //the shards are locked one after another, hence the least recently used entry is determined approximately
+        Shard* oldestShard = nullptr;
+        auto oldestAccess = std::numeric_limits<uint64_t>::max();
+        for (auto& shard : _shards) {
+            std::lock_guard lock(shard.mutex);
+            if (!shard.entries.empty() && shard.entries.back().lastAccess < oldestAccess) {
+                oldestAccess = shard.entries.back().lastAccess;
+                oldestShard = &shard;
+            }
+        }
+        if (!oldestShard) {
+            return;
+        }
+
+        std::optional<Entry> evictedEntry;
+        {
+            std::lock_guard lock(oldestShard->mutex);
+            if (oldestShard->entries.empty()) {
+                continue;
+            }
+            evictedEntry = oldestShard->entries.back();
+            eraseFromShard(*oldestShard, std::prev(oldestShard->entries.end()));
+        }
+        ++_numEvictions;
+        spill(evictedEntry->key, *evictedEntry->value);
+    }
+}
+
+template <typename Key, typename Value>
+void Cache<Key, Value>::spill(Key const& key, Value const& value)
+{
+    std::optional<SpillTier> spillTier;
+    std::filesystem::path filename;
+    {
+        std::lock_guard lock(_spillMutex);
+        if (!_spillTier) {
+            return;
+        }
+        spillTier = _spillTier;
+        filename = _spillTier->directory / (_spillFilePrefix + std::to_string(++_spillFileCounter) + ".bin");
+    }
+
+    uint64_t size = 0;
+    try {
+        auto data = spillTier->serialize(value);
+        size = data.size();
+        if (size > spillTier->maxBytes) {
+            return;
+        }
+        std::filesystem::create_directories(spillTier->directory);
+        std::ofstream stream(filename, std::ios::binary);
+        stream.write(data.data(), data.size());
+        stream.close();
+        if (!stream) {
+            throw std::runtime_error("Could not write spill file.");
+        }
+    } catch (...) {
+
+        //entries which cannot be spilled are dropped like evicted entries without spill tier
+        std::error_code errorCode;
+        std::filesystem::remove(filename, errorCode);
+        return;
+    }
+
+    std::lock_guard lock(_spillMutex);
+    auto findResult = _spilledEntryByKey.find(key);
+    if (findResult != _spilledEntryByKey.end()) {
+        eraseSpilledEntry(findResult->second);
+    }
+    _spilledEntries.emplace_front(SpilledEntry{key, filename, size});
+    _spilledEntryByKey.emplace(key, _spilledEntries.begin());
+    _numSpilledBytes += size;
+    while (_numSpilledBytes > spillTier->maxBytes && !_spilledEntries.empty()) {
+        eraseSpilledEntry(std::prev(_spilledEntries.end()));
+    }
+}
+
+template <typename Key, typename Value>
+std::optional<Value> Cache<Key, Value>::loadFromSpillTier(Key const& key)
 {
-    if (_cacheMap.size() >= MaxEntries) {
-        _cacheMap.erase(_usedKeys.front());
-        _usedKeys.pop_front();
+    std::filesystem::path filename;
+    std::function<Value(std::string const&)> deserialize;
+    {
+        std::lock_guard lock(_spillMutex);
+        auto findResult = _spilledEntryByKey.find(key);
+        if (findResult == _spilledEntryByKey.end()) {
+            return std::nullopt;
+        }
+        filename = findResult->second->filename;
+        deserialize = _spillTier->deserialize;
+
+        //the entry leaves the spill tier and is inserted in memory by the caller
+        _numSpilledBytes -= findResult->second->size;
+        _spilledEntries.erase(findResult->second);
+        _spilledEntryByKey.erase(findResult);
     }
+
+    std::optional<Value> result;
     try {
-        auto keyInserted = _cacheMap.insert_or_assign(key, value).second;
-        if (keyInserted) {
-            _usedKeys.emplace_back(key);
+        std::ifstream stream(filename, std::ios::binary);
+        if (stream) {
+            std::string data((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+            result = deserialize(data);
         }
     } catch (...) {
+
+        //a corrupt spill file is treated as a miss
+        result.reset();
     }
+    std::error_code errorCode;
+    std::filesystem::remove(filename, errorCode);
+    return result;
 }
 
-template <typename Key, typename Value, int MaxEntries>
-std::optional<Value> Cache<Key, Value, MaxEntries>::find(Key const& key)
+template <typename Key, typename Value>
+void Cache<Key, Value>::eraseFromSpillTier(Key const& key)
 {
-    auto findResult = _cacheMap.find(key);
-    if (findResult != _cacheMap.end()) {
-        return findResult->second;
-    } else {
-        return std::nullopt;
+    std::lock_guard lock(_spillMutex);
+    auto findResult = _spilledEntryByKey.find(key);
+    if (findResult != _spilledEntryByKey.end()) {
+        eraseSpilledEntry(findResult->second);
     }
 }
+
+template <typename Key, typename Value>
+void Cache<Key, Value>::eraseSpilledEntry(typename std::list<SpilledEntry>::iterator entryIt)
+{
+    std::error_code errorCode;
+    std::filesystem::remove(entryIt->filename, errorCode);
+    _numSpilledBytes -= entryIt->size;
+    _spilledEntryByKey.erase(entryIt->key);
+    _spilledEntries.erase(entryIt);
+}
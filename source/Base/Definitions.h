@@ -24,6 +24,8 @@ using std::uint64_t;
 class _FileLogger;
 using FileLogger = std::shared_ptr<_FileLogger>;
 
+class ThreadPool;
+
 constexpr float NEAR_ZERO = 1.0e-4f;
 
 template <typename T>
@@ -1,24 +1,65 @@
 #include "FileLogger.h"
 
 #include "Base/LoggingService.h"
-#include "Base/Resources.h"
 
 #include "Definitions.h"
 
-_FileLogger::_FileLogger()
+_FileLogger::_FileLogger(std::filesystem::path const& filename, uint64_t maxFileSize, int numRotatedFiles)
+    : _filename(filename)
+    , _maxFileSize(maxFileSize)
+    , _numRotatedFiles(numRotatedFiles)
 {
-    LoggingService::get().registerCallBack(this);
+    std::error_code errorCode;
+    std::filesystem::remove(_filename, errorCode);
+    for (int i = 1; i <= _numRotatedFiles; ++i) {
+        std::filesystem::remove(getRotatedFilename(i), errorCode);
+    }
+    _outfile.open(_filename, std::ios_base::app);
 
-    std::filesystem::remove(Const::LogFilename);
-    _outfile.open(Const::LogFilename, std::ios_base::app);
+    LoggingService::get().registerCallBack(this);
 }
 
 _FileLogger::~_FileLogger()
 {
+    LoggingService::get().flush();
     LoggingService::get().unregisterCallBack(this);
 }
 
 void _FileLogger::newLogMessage(Priority priority, std::string const& message)
 {
-    _outfile << message << std::endl;
+    auto messageSize = message.size() + 1;
+    if (_fileSize > 0 && _fileSize + messageSize > _maxFileSize) {
+        rotate();
+    }
+    _outfile << message << '\n';
+    _fileSize += messageSize;
+}
+
+void _FileLogger::flush()
+{
+    _outfile.flush();
+}
+
+std::filesystem::path _FileLogger::getRotatedFilename(int index) const
+{
+    auto result = _filename;
+    result.replace_filename(_filename.stem().string() + "." + std::to_string(index) + _filename.extension().string());
+    return result;
+}
+
+void _FileLogger::rotate()
+{
+    _outfile.close();
+
+    std::error_code errorCode;
+    if (_numRotatedFiles > 0) {
+        for (int i = _numRotatedFiles - 1; i >= 1; --i) {
+            if (std::filesystem::exists(getRotatedFilename(i), errorCode)) {
+                std::filesystem::rename(getRotatedFilename(i), getRotatedFilename(i + 1), errorCode);
+            }
+        }
+        std::filesystem::rename(_filename, getRotatedFilename(1), errorCode);
+    }
+    _outfile.open(_filename, std::ios_base::trunc);
+    _fileSize = 0;
 }
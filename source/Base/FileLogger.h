@@ -1,19 +1,34 @@
 #pragma once
 
+#include <filesystem>
 #include <fstream>
 
 #include "Base/LoggingService.h"
+#include "Base/Resources.h"
 #include "Definitions.h"
 
+//the log file is flushed after each batch of messages and rotated to <name>.1<ext>, <name>.2<ext>, ... when it exceeds maxFileSize
 class _FileLogger : public LoggingCallBack
 {
 
 public:
-    _FileLogger();
+    _FileLogger(
+        std::filesystem::path const& filename = Const::LogFilename,
+        uint64_t maxFileSize = Const::MaxLogFileSize,
+        int numRotatedFiles = Const::NumRotatedLogFiles);
     ~_FileLogger() override;
 
     void newLogMessage(Priority priority, std::string const& message) override;
+    void flush() override;
 
 private:
+    std::filesystem::path getRotatedFilename(int index) const;
+    void rotate();
+
+    std::filesystem::path _filename;
+    uint64_t _maxFileSize = 0;
+    int _numRotatedFiles = 0;
+
     std::ofstream _outfile;
+    uint64_t _fileSize = 0;
 };
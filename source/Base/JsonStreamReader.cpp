@@ -0,0 +1,224 @@
+#include "JsonStreamReader.h"
+
+#include <stdexcept>
+
+void JsonStreamReader::read(std::string_view json, ValueCallback const& callback)
+{
+    JsonStreamReader reader(json, callback);
+    reader.skipWhitespace();
+    reader.parseValue();
+    reader.skipWhitespace();
+    if (reader._pos != json.size()) {
+        reader.throwSyntaxError();
+    }
+}
+
+JsonStreamReader::JsonStreamReader(std::string_view json, ValueCallback const& callback)
+    : _json(json)
+    , _callback(callback)
+{}
+
+void JsonStreamReader::parseValue()
+{
+    if (_pos >= _json.size()) {
+        throwSyntaxError();
+    }
+    auto ch = _json[_pos];
+    if (ch == '{') {
+        parseObject();
+    } else if (ch == '[') {
+        parseArray();
+    } else if (ch == '"') {
+        _callback(_path, parseString());
+    } else {
+        _callback(_path, parseLiteral());
+    }
+}
+
+void JsonStreamReader::parseObject()
+{
+    expect('{');
+    skipWhitespace();
+    if (consume('}')) {
+        return;
+    }
+    ++_depth;
+    auto pathLength = _path.size();
+    do {
+        skipWhitespace();
+        appendToPath(parseString());
+        skipWhitespace();
+        expect(':');
+        skipWhitespace();
+        parseValue();
+        _path.resize(pathLength);
+        skipWhitespace();
+    } while (consume(','));
+    expect('}');
+    --_depth;
+}
+
+void JsonStreamReader::parseArray()
+{
+    expect('[');
+    skipWhitespace();
+    if (consume(']')) {
+        return;
+    }
+    ++_depth;
+    auto pathLength = _path.size();
+    do {
+        skipWhitespace();
+        appendToPath({});
+        parseValue();
+        _path.resize(pathLength);
+        skipWhitespace();
+    } while (consume(','));
+    expect(']');
+    --_depth;
+}
+
+std::string_view JsonStreamReader::parseString()
+{
+    expect('"');
+    auto start = _pos;
+    auto end = _json.find_first_of("\"\\", start);
+    if (end == std::string_view::npos) {
+        throwSyntaxError();
+    }
+    if (_json[end] == '"') {
+        _pos = end + 1;
+        return _json.substr(start, end - start);
+    }
+
+    //slow path for strings with escape sequences
+    _unescapedString.assign(_json.substr(start, end - start));
+    _pos = end;
+    while (true) {
+        if (_pos >= _json.size()) {
+            throwSyntaxError();
+        }
+        auto ch = _json[_pos++];
+        if (ch == '"') {
+            return _unescapedString;
+        }
+        if (ch != '\\') {
+            _unescapedString += ch;
+            continue;
+        }
+        if (_pos >= _json.size()) {
+            throwSyntaxError();
+        }
+        switch (_json[_pos++]) {
+        case '"':
+            _unescapedString += '"';
+            break;
+        case '\\':
+            _unescapedString += '\\';
+            break;
+        case '/':
+            _unescapedString += '/';
+            break;
+        case 'b':
+            _unescapedString += '\b';
+            break;
+        case 'f':
+            _unescapedString += '\f';
+            break;
+        case 'n':
+            _unescapedString += '\n';
+            break;
+        case 'r':
+            _unescapedString += '\r';
+            break;
+        case 't':
+            _unescapedString += '\t';
+            break;
+        case 'u': {
+            if (_pos + 4 > _json.size()) {
+                throwSyntaxError();
+            }
+            unsigned int codePoint = 0;
+            for (int i = 0; i < 4; ++i) {
+                auto digit = _json[_pos++];
+                codePoint <<= 4;
+                if (digit >= '0' && digit <= '9') {
+                    codePoint += digit - '0';
+                } else if (digit >= 'a' && digit <= 'f') {
+                    codePoint += digit - 'a' + 10;
+                } else if (digit >= 'A' && digit <= 'F') {
+                    codePoint += digit - 'A' + 10;
+                } else {
+                    throwSyntaxError();
+                }
+            }
+            //UTF-8 encoding as in boost::property_tree::read_json
+            if (codePoint < 0x80) {
+                _unescapedString += static_cast<char>(codePoint);
+            } else if (codePoint < 0x800) {
+                _unescapedString += static_cast<char>(0xC0 | (codePoint >> 6));
+                _unescapedString += static_cast<char>(0x80 | (codePoint & 0x3F));
+            } else {
+                _unescapedString += static_cast<char>(0xE0 | (codePoint >> 12));
+                _unescapedString += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                _unescapedString += static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+            break;
+        }
+        default:
+            throwSyntaxError();
+        }
+    }
+}
+
+std::string_view JsonStreamReader::parseLiteral()
+{
+    auto start = _pos;
+    while (_pos < _json.size()) {
+        auto ch = _json[_pos];
+        if (ch == ',' || ch == '}' || ch == ']' || ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r') {
+            break;
+        }
+        ++_pos;
+    }
+    if (_pos == start) {
+        throwSyntaxError();
+    }
+    return _json.substr(start, _pos - start);
+}
+
+void JsonStreamReader::appendToPath(std::string_view key)
+{
+    if (_depth > 1) {
+        _path += '.';
+    }
+    _path += key;
+}
+
+void JsonStreamReader::skipWhitespace()
+{
+    while (_pos < _json.size() && (_json[_pos] == ' ' || _json[_pos] == '\t' || _json[_pos] == '\n' || _json[_pos] == '\r')) {
+        ++_pos;
+    }
+}
+
+bool JsonStreamReader::consume(char ch)
+{
+    if (_pos < _json.size() && _json[_pos] == ch) {
+        ++_pos;
+        return true;
+    }
+    return false;
+}
+
+void JsonStreamReader::expect(char ch)
+{
+    if (!consume(ch)) {
+        throwSyntaxError();
+    }
+}
+
+void JsonStreamReader::throwSyntaxError() const
+{
+    throw std::runtime_error("Invalid JSON at position " + std::to_string(_pos) + ".");
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <string_view>
+
+/**
+ * Reads JSON in a single pass without building a tree and reports each value with its dotted node path.
+ * Numbers, booleans and null are reported as written and array elements with empty keys, as in boost::property_tree::read_json.
+ * Throws std::runtime_error on syntax errors.
+ */
+class JsonStreamReader
+{
+public:
+    using ValueCallback = std::function<void(std::string_view path, std::string_view value)>;
+
+    static void read(std::string_view json, ValueCallback const& callback);
+
+private:
+    JsonStreamReader(std::string_view json, ValueCallback const& callback);
+
+    void parseValue();
+    void parseObject();
+    void parseArray();
+    std::string_view parseString();  //returned view is valid until the next call
+    std::string_view parseLiteral();
+
+    void appendToPath(std::string_view key);
+    void skipWhitespace();
+    bool consume(char ch);
+    void expect(char ch);
+    [[noreturn]] void throwSyntaxError() const;
+
+    std::string_view _json;
+    size_t _pos = 0;
+    ValueCallback const& _callback;
+    int _depth = 0;
+    std::string _path;
+    std::string _unescapedString;
+};
@@ -0,0 +1,144 @@
+#include "JsonStreamWriter.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+    std::string_view getFirstComponent(std::string_view path)
+    {
+        return path.substr(0, path.find('.'));
+    }
+
+    void writeIndentation(std::ostream& stream, size_t depth)
+    {
+        static std::string const Spaces(64, ' ');
+        for (auto remaining = 4 * depth; remaining > 0;) {
+            auto length = std::min(remaining, Spaces.size());
+            stream.write(Spaces.data(), length);
+            remaining -= length;
+        }
+    }
+
+    bool isWrittenUnescaped(unsigned char c)
+    {
+        return c == 0x20 || c == 0x21 || (c >= 0x23 && c <= 0x2E) || (c >= 0x30 && c <= 0x5B) || c >= 0x5D;
+    }
+}
+
+JsonStreamWriter::JsonStreamWriter(std::ostream& stream)
+    : _stream(stream)
+{
+    _stream << '{';
+    _hasChildren.emplace_back(false);
+}
+
+void JsonStreamWriter::write(std::string_view path, std::string_view value)
+{
+    //close the objects not containing the path
+    size_t numCommonObjects = 0;
+    auto remainingPath = path;
+    while (numCommonObjects < _openObjects.size()) {
+        auto separatorPos = remainingPath.find('.');
+        if (separatorPos == std::string_view::npos || remainingPath.substr(0, separatorPos) != _openObjects.at(numCommonObjects)) {
+            break;
+        }
+        remainingPath.remove_prefix(separatorPos + 1);
+        ++numCommonObjects;
+    }
+    while (_openObjects.size() > numCommonObjects) {
+        closeObject();
+    }
+
+    //open the missing objects
+    for (auto separatorPos = remainingPath.find('.'); separatorPos != std::string_view::npos; separatorPos = remainingPath.find('.')) {
+        openObject(getFirstComponent(remainingPath));
+        remainingPath.remove_prefix(separatorPos + 1);
+    }
+
+    writeKey(remainingPath);
+    _stream << '"';
+    writeEscaped(value);
+    _stream << '"';
+}
+
+void JsonStreamWriter::finish()
+{
+    while (!_openObjects.empty()) {
+        closeObject();
+    }
+    _stream << "\n}" << std::endl;
+}
+
+void JsonStreamWriter::openObject(std::string_view key)
+{
+    if (!_openPath.empty()) {
+        _openPath += '.';
+    }
+    _openPath += key;
+    if (_closedPaths.contains(_openPath)) {
+        throw std::logic_error("JSON object " + _openPath + " has already been written.");
+    }
+    writeKey(key);
+    _stream << '{';
+    _openObjects.emplace_back(key);
+    _hasChildren.emplace_back(false);
+}
+
+void JsonStreamWriter::closeObject()
+{
+    _hasChildren.pop_back();
+    _stream << '\n';
+    writeIndentation(_stream, _openObjects.size());
+    _stream << '}';
+
+    _closedPaths.insert(_openPath);
+    _openPath.resize(_openObjects.size() > 1 ? _openPath.size() - _openObjects.back().size() - 1 : 0);
+    _openObjects.pop_back();
+}
+
+void JsonStreamWriter::writeKey(std::string_view key)
+{
+    _stream << (_hasChildren.back() ? ",\n" : "\n");
+    writeIndentation(_stream, _openObjects.size() + 1);
+    _stream << '"';
+    writeEscaped(key);
+    _stream << "\": ";
+    _hasChildren.back() = true;
+}
+
+void JsonStreamWriter::writeEscaped(std::string_view text)
+{
+    //same escaping as boost::property_tree::write_json, runs of unescaped characters are written at once
+    size_t runStart = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+        auto ch = text[i];
+        if (isWrittenUnescaped(static_cast<unsigned char>(ch))) {
+            continue;
+        }
+        _stream.write(text.data() + runStart, i - runStart);
+        runStart = i + 1;
+        if (ch == '\b') {
+            _stream << "\\b";
+        } else if (ch == '\f') {
+            _stream << "\\f";
+        } else if (ch == '\n') {
+            _stream << "\\n";
+        } else if (ch == '\r') {
+            _stream << "\\r";
+        } else if (ch == '\t') {
+            _stream << "\\t";
+        } else if (ch == '/') {
+            _stream << "\\/";
+        } else if (ch == '"') {
+            _stream << "\\\"";
+        } else if (ch == '\\') {
+            _stream << "\\\\";
+        } else {
+            auto c = static_cast<unsigned char>(ch);
+            char const* hexDigits = "0123456789ABCDEF";
+            _stream << "\\u00" << hexDigits[c / 16] << hexDigits[c % 16];
+        }
+    }
+    _stream.write(text.data() + runStart, text.size() - runStart);
+}
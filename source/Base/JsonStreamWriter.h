@@ -0,0 +1,33 @@
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * Writes string values at dotted node paths as nested JSON objects without building a tree.
+ * The output has the format of boost::property_tree::write_json such that it can be read by the ptree based parsers.
+ * Values whose paths share a prefix must be written consecutively, reopening a closed object throws std::logic_error.
+ */
+class JsonStreamWriter
+{
+public:
+    JsonStreamWriter(std::ostream& stream);
+
+    void write(std::string_view path, std::string_view value);
+    void finish();  //closes all open objects, must be called once after the last value
+
+private:
+    void openObject(std::string_view key);
+    void closeObject();
+    void writeKey(std::string_view key);
+    void writeEscaped(std::string_view text);
+
+    std::ostream& _stream;
+    std::vector<std::string> _openObjects;
+    std::vector<bool> _hasChildren;  //for the root and each open object
+    std::string _openPath;  //dotted path of the open objects
+    std::unordered_set<std::string> _closedPaths;
+};
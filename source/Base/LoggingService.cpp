@@ -6,30 +6,124 @@
 #include <sstream>
 #include <algorithm>
 
-void LoggingService::log(Priority priority, std::string const& message)
+namespace
 {
-    std::lock_guard<std::mutex> lock(_mutex);
+    auto constexpr BufferCapacity = 1 << 14;
+
+    std::string enrichMessage(std::time_t time, std::string const& message)
+    {
+        auto tm = *std::localtime(&time);
+
+        std::stringstream stream;
+        stream << std::put_time(&tm, "%Y-%m-%d %H-%M-%S") << ": " << message;
+        return stream.str();
+    }
+}
 
-    auto t = std::time(nullptr);
-    auto tm = *std::localtime(&t);
+LoggingService::LoggingService()
+    : _buffer(BufferCapacity)
+{
+    _dispatcherThread = std::thread([this] { dispatchMessages(); });
+}
+
+LoggingService::~LoggingService()
+{
+    _shutdown = true;
+    _wakeUpCounter.fetch_add(1);
+    _wakeUpCounter.notify_one();
+    _dispatcherThread.join();
+}
+
+void LoggingService::log(Priority priority, std::string const& message)
+{
+    if (_buffer.tryPush({.priority = priority, .time = std::time(nullptr), .message = message})) {
+        _numPushedMessages.fetch_add(1);
+    } else {
+        _numDroppedMessages.fetch_add(1);
+    }
+    _wakeUpCounter.fetch_add(1);
+    _wakeUpCounter.notify_one();
+}
 
-    std::stringstream stream;
-    stream << std::put_time(&tm, "%Y-%m-%d %H-%M-%S") << ": " << message;
+void LoggingService::flush()
+{
+    auto numPushedMessages = _numPushedMessages.load();
+    auto numDroppedMessages = _numDroppedMessages.load();
+    _wakeUpCounter.fetch_add(1);
+    _wakeUpCounter.notify_one();
 
-    auto enrichedMessage = stream.str();
-    for (auto const& callback : _callbacks) {
-        callback->newLogMessage(priority, enrichedMessage);
+    auto numDispatchedMessages = _numDispatchedMessages.load();
+    while (numDispatchedMessages < numPushedMessages) {
+        _numDispatchedMessages.wait(numDispatchedMessages);
+        numDispatchedMessages = _numDispatchedMessages.load();
+    }
+    auto numReportedDroppedMessages = _numReportedDroppedMessages.load();
+    while (numReportedDroppedMessages < numDroppedMessages) {
+        _numReportedDroppedMessages.wait(numReportedDroppedMessages);
+        numReportedDroppedMessages = _numReportedDroppedMessages.load();
     }
 }
 
 void LoggingService::registerCallBack(LoggingCallBack* callback)
 {
+    std::lock_guard<std::mutex> lock(_mutex);
     _callbacks.emplace_back(callback);
 }
 
 void LoggingService::unregisterCallBack(LoggingCallBack* callback)
 {
+    std::lock_guard<std::mutex> lock(_mutex);
     auto end = std::remove_if(_callbacks.begin(), _callbacks.end(), [&](auto const& callback_) { return callback_ == callback; });
 
     _callbacks.erase(end, _callbacks.end());
 }
+
+uint64_t LoggingService::getNumDroppedMessages() const
+{
+    return _numDroppedMessages.load();
+}
+
+void LoggingService::dispatchMessages()
+{
+    std::vector<LogEntry> batch;
+    while (true) {
+        auto wakeUpCounter = _wakeUpCounter.load();
+
+        batch.clear();
+        while (auto entry = _buffer.tryPop()) {
+            batch.emplace_back(std::move(*entry));
+        }
+        auto numDroppedMessages = _numDroppedMessages.load();
+        auto numNewDroppedMessages = numDroppedMessages - _numReportedDroppedMessages.load();
+
+        if (!batch.empty() || numNewDroppedMessages > 0) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (auto const& entry : batch) {
+                auto enrichedMessage = enrichMessage(entry.time, entry.message);
+                for (auto const& callback : _callbacks) {
+                    callback->newLogMessage(entry.priority, enrichedMessage);
+                }
+            }
+            if (numNewDroppedMessages > 0) {
+                auto enrichedMessage = enrichMessage(std::time(nullptr), std::to_string(numNewDroppedMessages) + " log messages have been dropped");
+                for (auto const& callback : _callbacks) {
+                    callback->newLogMessage(Priority::Important, enrichedMessage);
+                }
+            }
+            for (auto const& callback : _callbacks) {
+                callback->flush();
+            }
+        }
+        _numDispatchedMessages.fetch_add(batch.size());
+        _numDispatchedMessages.notify_all();
+        _numReportedDroppedMessages.store(numDroppedMessages);
+        _numReportedDroppedMessages.notify_all();
+
+        if (batch.empty()) {
+            if (_shutdown && _numDispatchedMessages.load() == _numPushedMessages.load()) {
+                return;
+            }
+            _wakeUpCounter.wait(wakeUpCounter);
+        }
+    }
+}
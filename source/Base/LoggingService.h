@@ -1,9 +1,13 @@
 #pragma once
 
+#include <atomic>
+#include <ctime>
 #include <string>
+#include <thread>
 #include <vector>
 #include <mutex>
 
+#include "MpscRingBuffer.h"
 #include "Singleton.h"
 
 enum class Priority
@@ -17,24 +21,57 @@ class LoggingCallBack
 public:
     virtual ~LoggingCallBack() = default;
     virtual void newLogMessage(Priority priority, std::string const& message) = 0;
+    virtual void flush() {}  //called after each batch of messages
 };
 
+/**
+ * log() only enqueues the message into a bounded lock-free ring buffer and never blocks.
+ * A background thread passes the messages in batches to the callbacks. Messages are dropped if the buffer is full,
+ * the number of dropped messages is reported with the next batch.
+ */
 class LoggingService
 {
-    MAKE_SINGLETON(LoggingService);
+    MAKE_SINGLETON_NO_DEFAULT_CONSTRUCTION(LoggingService);
 
 public:
+    ~LoggingService();
+
     void log(Priority priority, std::string const& message);
 
+    //waits until all messages logged so far are passed to the callbacks, must not be called from a callback
+    void flush();
+
     void registerCallBack(LoggingCallBack* callback);
     void unregisterCallBack(LoggingCallBack* callback);
 
+    uint64_t getNumDroppedMessages() const;
+
 private:
+    LoggingService();
+
+    void dispatchMessages();
+
+    struct LogEntry
+    {
+        Priority priority = Priority::Unimportant;
+        std::time_t time = 0;
+        std::string message;
+    };
+    MpscRingBuffer<LogEntry> _buffer;
+
+    std::atomic<uint64_t> _numPushedMessages = 0;
+    std::atomic<uint64_t> _numDispatchedMessages = 0;
+    std::atomic<uint64_t> _numDroppedMessages = 0;
+    std::atomic<uint64_t> _numReportedDroppedMessages = 0;
+    std::atomic<uint64_t> _wakeUpCounter = 0;
+    std::atomic<bool> _shutdown = false;
+
     std::vector<LoggingCallBack*> _callbacks;
     std::mutex _mutex;
+    std::thread _dispatcherThread;
 };
 
 inline void log(Priority priority, std::string const& message)
 {
     LoggingService::get().log(priority, message);
-}
\ No newline at end of file
+}
@@ -0,0 +1,105 @@
+#include "MappedFile.h"
+
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+MappedFile::MappedFile(std::filesystem::path const& filename)
+{
+    auto fileHandle = CreateFileW(filename.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Could not open " + filename.string() + ".");
+    }
+    _fileHandle = fileHandle;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(fileHandle, &size)) {
+        CloseHandle(fileHandle);
+        throw std::runtime_error("Could not determine size of " + filename.string() + ".");
+    }
+    _size = static_cast<size_t>(size.QuadPart);
+    if (_size == 0) {
+        return;
+    }
+
+    auto mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mappingHandle) {
+        CloseHandle(fileHandle);
+        throw std::runtime_error("Could not map " + filename.string() + ".");
+    }
+    _mappingHandle = mappingHandle;
+
+    _data = static_cast<uint8_t const*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    if (!_data) {
+        CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+        throw std::runtime_error("Could not map " + filename.string() + ".");
+    }
+}
+
+MappedFile::~MappedFile()
+{
+    if (_data) {
+        UnmapViewOfFile(_data);
+    }
+    if (_mappingHandle) {
+        CloseHandle(_mappingHandle);
+    }
+    if (_fileHandle) {
+        CloseHandle(_fileHandle);
+    }
+}
+#else
+MappedFile::MappedFile(std::filesystem::path const& filename)
+{
+    _fileDescriptor = open(filename.c_str(), O_RDONLY);
+    if (_fileDescriptor == -1) {
+        throw std::runtime_error("Could not open " + filename.string() + ".");
+    }
+
+    struct stat fileStatus;
+    if (fstat(_fileDescriptor, &fileStatus) == -1) {
+        close(_fileDescriptor);
+        throw std::runtime_error("Could not determine size of " + filename.string() + ".");
+    }
+    _size = static_cast<size_t>(fileStatus.st_size);
+    if (_size == 0) {
+        return;
+    }
+
+    auto data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, _fileDescriptor, 0);
+    if (data == MAP_FAILED) {
+        close(_fileDescriptor);
+        throw std::runtime_error("Could not map " + filename.string() + ".");
+    }
+    _data = static_cast<uint8_t const*>(data);
+}
+
+MappedFile::~MappedFile()
+{
+    if (_data) {
+        munmap(const_cast<uint8_t*>(_data), _size);
+    }
+    if (_fileDescriptor != -1) {
+        close(_fileDescriptor);
+    }
+}
+#endif
+
+uint8_t const* MappedFile::getData() const
+{
+    return _data;
+}
+
+size_t MappedFile::getSize() const
+{
+    return _size;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+/**
+ * Read-only memory mapping of a whole file. Throws std::runtime_error if the file cannot be mapped.
+ */
+class MappedFile
+{
+public:
+    MappedFile(std::filesystem::path const& filename);
+    ~MappedFile();
+
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+
+    uint8_t const* getData() const;
+    size_t getSize() const;
+
+private:
+    uint8_t const* _data = nullptr;
+    size_t _size = 0;
+
+#ifdef _WIN32
+    void* _fileHandle = nullptr;
+    void* _mappingHandle = nullptr;
+#else
+    int _fileDescriptor = -1;
+#endif
+};
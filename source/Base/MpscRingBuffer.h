@@ -0,0 +1,95 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+/**
+ * Bounded lock-free queue for multiple producers and a single consumer.
+ * Each slot carries a sequence number that tells whether it is free for the producer of a round or filled for the consumer,
+ * so producers only contend on a single atomic increment and never wait for each other.
+ */
+template <typename T>
+class MpscRingBuffer
+{
+public:
+    MpscRingBuffer(uint64_t capacity);  //capacity is rounded up to a power of two
+
+    uint64_t getCapacity() const;
+
+    bool tryPush(T&& value);  //returns false if the buffer is full, may be called from any thread
+    std::optional<T> tryPop();  //returns nothing if the next element is not available yet, must only be called from the consumer thread
+
+private:
+    struct Slot
+    {
+        std::atomic<uint64_t> sequence;
+        T value;
+    };
+
+    uint64_t _capacity = 1;
+    std::unique_ptr<Slot[]> _slots;
+
+    alignas(64) std::atomic<uint64_t> _pushPos = 0;
+    alignas(64) uint64_t _popPos = 0;
+};
+
+/************************************************************************/
+/* Implementation                                                       */
+/************************************************************************/
+
+template <typename T>
+MpscRingBuffer<T>::MpscRingBuffer(uint64_t capacity)
+{
+    while (_capacity < capacity) {
+        _capacity *= 2;
+    }
+    _slots = std::make_unique<Slot[]>(_capacity);
+    for (uint64_t i = 0; i < _capacity; ++i) {
+        _slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template <typename T>
+uint64_t MpscRingBuffer<T>::getCapacity() const
+{
+    return _capacity;
+}
+
+template <typename T>
+bool MpscRingBuffer<T>::tryPush(T&& value)
+{
+    auto pos = _pushPos.load(std::memory_order_relaxed);
+    Slot* slot;
+    while (true) {
+        slot = &_slots[pos & (_capacity - 1)];
+        auto sequence = slot->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos);
+        if (diff == 0) {
+            if (_pushPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = _pushPos.load(std::memory_order_relaxed);
+        }
+    }
+    slot->value = std::move(value);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+std::optional<T> MpscRingBuffer<T>::tryPop()
+{
+    auto& slot = _slots[_popPos & (_capacity - 1)];
+    if (slot.sequence.load(std::memory_order_acquire) != _popPos + 1) {
+        return std::nullopt;
+    }
+    std::optional<T> result = std::move(slot.value);
+    slot.sequence.store(_popPos + _capacity, std::memory_order_release);
+    ++_popPos;
+    return result;
+}
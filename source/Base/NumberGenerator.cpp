@@ -6,12 +6,19 @@
 
 NumberGenerator::NumberGenerator()
 {
-    _arrayOfRandomNumbers.reserve(1323781);
     _runningNumber = 0;
     std::random_device rd;   //Will be used to obtain a seed for the random number engine
-    std::mt19937 gen(rd());  //Standard mersenne_twister_engine seeded with rd()
+    setSeed(rd());
+}
+
+void NumberGenerator::setSeed(uint32_t seed)
+{
+    std::mt19937 gen(seed);  //Standard mersenne_twister_engine
     std::uniform_int_distribution<> distrib(0);
 
+    _index = 0;
+    _arrayOfRandomNumbers.clear();
+    _arrayOfRandomNumbers.reserve(1323781);
     for (uint32_t i = 0; i < 1323781; ++i) {
         _arrayOfRandomNumbers.emplace_back(distrib(gen));
     }
@@ -8,6 +8,7 @@ class NumberGenerator
     MAKE_SINGLETON_NO_DEFAULT_CONSTRUCTION(NumberGenerator);
 
 public:
+    void setSeed(uint32_t seed);  //makes the subsequent random numbers reproducible
 
 	uint32_t getRandomInt();
     uint32_t getRandomInt(uint32_t range);
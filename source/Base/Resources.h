@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
 
 namespace Const
@@ -11,6 +12,8 @@ namespace Const
     std::filesystem::path const ResourcePath = "resources";
 
     std::filesystem::path const LogFilename = "log.txt";
+    uint64_t const MaxLogFileSize = 10 * 1024 * 1024;
+    int const NumRotatedLogFiles = 3;
     std::filesystem::path const AutosaveFileWithoutPath = "autosave.sim";
     std::filesystem::path const AutosaveFile = ResourcePath / AutosaveFileWithoutPath;
     std::filesystem::path const SettingsFilename = ResourcePath / "settings.json";
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+/**
+ * Versions of a value published by a single writer thread and read by any thread without waiting for the writer.
+ * Each published version is a new immutable object, readers keep their snapshot alive by its shared pointer.
+ */
+template <typename T>
+class SnapshotBuffer
+{
+public:
+    using Snapshot = std::shared_ptr<T const>;
+
+    SnapshotBuffer();
+
+    Snapshot getLatest() const;
+    uint64_t getVersion() const;  //incremented on each publish
+
+    void publish(T&& value);  //writer thread only
+
+private:
+    std::atomic<Snapshot> _latest;
+    std::atomic<uint64_t> _version = 0;
+};
+
+/************************************************************************/
+/* Implementation                                                       */
+/************************************************************************/
+
+template <typename T>
+SnapshotBuffer<T>::SnapshotBuffer()
+    : _latest(std::make_shared<T const>())
+{}
+
+template <typename T>
+auto SnapshotBuffer<T>::getLatest() const -> Snapshot
+{
+    return _latest.load();
+}
+
+template <typename T>
+uint64_t SnapshotBuffer<T>::getVersion() const
+{
+    return _version.load();
+}
+
+template <typename T>
+void SnapshotBuffer<T>::publish(T&& value)
+{
+    //previous versions are never reused since use_count() does not synchronize with readers releasing them
+    _latest.store(std::make_shared<T const>(std::move(value)));
+    ++_version;
+}
@@ -0,0 +1,156 @@
+#include "ThreadPool.h"
+
+#include "Definitions.h"
+
+namespace
+{
+    auto constexpr ChunksPerQueue = 4;
+}
+
+ThreadPool::ThreadPool(int numThreads)
+{
+    if (numThreads <= 0) {
+        numThreads = std::max(1, toInt(std::thread::hardware_concurrency()));
+    }
+
+    //the calling threads of parallelFor count as one of the threads
+    auto numWorkerThreads = numThreads - 1;
+    for (int i = 0; i < numWorkerThreads + 1; ++i) {
+        _queues.emplace_back(std::make_unique<WorkQueue>());
+    }
+    for (int i = 0; i < numWorkerThreads; ++i) {
+        _threads.emplace_back(&ThreadPool::runWorker, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock(_mutex);
+        _shutdown = true;
+    }
+    _workAvailable.notify_all();
+    for (auto& thread : _threads) {
+        thread.join();
+    }
+}
+
+int ThreadPool::getNumThreads() const
+{
+    return toInt(_queues.size());
+}
+
+void ThreadPool::parallelFor(size_t numElements, RangeFunction const& func, size_t minChunkSize)
+{
+    if (numElements == 0) {
+        return;
+    }
+    minChunkSize = std::max(size_t(1), minChunkSize);
+    if (_threads.empty() || numElements <= minChunkSize) {
+        func(0, numElements);
+        return;
+    }
+
+    auto numQueues = _queues.size();
+    auto numChunks = std::min((numElements + minChunkSize - 1) / minChunkSize, numQueues * ChunksPerQueue);
+    auto chunkSize = (numElements + numChunks - 1) / numChunks;
+    numChunks = (numElements + chunkSize - 1) / chunkSize;
+
+    Job job;
+    job.func = &func;
+    job.numPendingChunks = numChunks;
+
+    //neighboring chunks are put into the same queue for better cache locality
+    for (size_t chunkIndex = 0; chunkIndex < numChunks; ++chunkIndex) {
+        auto& queue = *_queues.at(chunkIndex * numQueues / numChunks);
+        std::lock_guard lock(queue.mutex);
+        queue.chunks.push_back(Chunk{&job, chunkIndex * chunkSize, std::min(numElements, (chunkIndex + 1) * chunkSize)});
+    }
+    {
+        std::lock_guard lock(_mutex);
+        ++_generation;
+    }
+    _workAvailable.notify_all();
+
+    processChunks(toInt(numQueues) - 1, &job);
+    {
+        std::unique_lock lock(_mutex);
+        _workDone.wait(lock, [&job] { return job.numPendingChunks.load() == 0; });
+    }
+
+    if (job.exception) {
+        std::rethrow_exception(job.exception);
+    }
+}
+
+void ThreadPool::runWorker(int queueIndex)
+{
+    uint64_t processedGeneration = 0;
+    while (true) {
+        {
+            std::unique_lock lock(_mutex);
+            _workAvailable.wait(lock, [&] { return _shutdown || _generation != processedGeneration; });
+            if (_shutdown) {
+                return;
+            }
+            processedGeneration = _generation;
+        }
+        processChunks(queueIndex);
+    }
+}
+
+void ThreadPool::processChunks(int queueIndex, Job const* job)
+{
+    while (!job || job->numPendingChunks.load() > 0) {
+        auto chunk = takeChunk(queueIndex);
+        if (!chunk) {
+            return;
+        }
+        processChunk(*chunk);
+    }
+}
+
+void ThreadPool::processChunk(Chunk const& chunk)
+{
+    auto& job = *chunk.job;
+    try {
+        (*job.func)(chunk.startIndex, chunk.endIndex);
+    } catch (...) {
+        std::lock_guard lock(job.mutexForException);
+        if (!job.exception) {
+            job.exception = std::current_exception();
+        }
+    }
+
+    //job may be destroyed by its calling thread as soon as the last chunk is finished
+    if (job.numPendingChunks.fetch_sub(1) == 1) {
+        std::lock_guard lock(_mutex);
+        _workDone.notify_all();
+    }
+}
+
+auto ThreadPool::takeChunk(int queueIndex) -> std::optional<Chunk>
+{
+    {
+        auto& ownQueue = *_queues.at(queueIndex);
+        std::lock_guard lock(ownQueue.mutex);
+        if (!ownQueue.chunks.empty()) {
+            auto result = ownQueue.chunks.back();
+            ownQueue.chunks.pop_back();
+            return result;
+        }
+    }
+
+    //steal from the other queues
+    auto numQueues = toInt(_queues.size());
+    for (int i = 1; i < numQueues; ++i) {
+        auto& otherQueue = *_queues.at((queueIndex + i) % numQueues);
+        std::lock_guard lock(otherQueue.mutex);
+        if (!otherQueue.chunks.empty()) {
+            auto result = otherQueue.chunks.front();
+            otherQueue.chunks.pop_front();
+            return result;
+        }
+    }
+    return std::nullopt;
+}
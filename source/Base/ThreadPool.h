@@ -0,0 +1,107 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "Singleton.h"
+
+/**
+ * Fixed-size pool of worker threads with one task deque per worker.
+ * A worker takes chunks from the back of its own deque and steals from the front of the other deques when it runs dry.
+ * The calling thread of parallelFor participates as an additional worker. Several threads may call parallelFor concurrently, also from
+ * within a running parallelFor, their chunks are processed by the same workers.
+ * ThreadPool::get() provides the pool shared by all components, dedicated pools are only needed for a specific number of threads.
+ */
+class ThreadPool
+{
+    MAKE_SINGLETON_NO_DEFAULT_CONSTRUCTION(ThreadPool);
+
+public:
+    ThreadPool(int numThreads = 0);  //0 = number of hardware threads
+    ~ThreadPool();
+
+    int getNumThreads() const;
+
+    //calls func(startIndex, endIndex) with endIndex exclusive for disjoint chunks covering [0, numElements) and blocks until all chunks are processed,
+    //the first exception thrown by func is rethrown
+    using RangeFunction = std::function<void(size_t, size_t)>;
+    void parallelFor(size_t numElements, RangeFunction const& func, size_t minChunkSize = 512);
+
+    //as parallelFor, but func(startIndex, endIndex, result) may append entries to a chunk-local result
+    //the chunk results are concatenated in index order such that the outcome does not depend on the scheduling
+    template <typename T, typename Func>
+    std::vector<T> parallelCollect(size_t numElements, Func const& func, size_t minChunkSize = 512);
+
+private:
+    struct Job
+    {
+        RangeFunction const* func = nullptr;
+        std::atomic<size_t> numPendingChunks{0};
+
+        std::mutex mutexForException;
+        std::exception_ptr exception;
+    };
+    struct Chunk
+    {
+        Job* job;
+        size_t startIndex;
+        size_t endIndex;
+    };
+    struct WorkQueue
+    {
+        std::mutex mutex;
+        std::deque<Chunk> chunks;
+    };
+
+    void runWorker(int queueIndex);
+    void processChunks(int queueIndex, Job const* job = nullptr);  //returns when no chunk is available or job is finished
+    void processChunk(Chunk const& chunk);
+    std::optional<Chunk> takeChunk(int queueIndex);
+
+    std::vector<std::thread> _threads;
+    std::vector<std::unique_ptr<WorkQueue>> _queues;  //last queue belongs to the calling threads
+
+    std::mutex _mutex;
+    std::condition_variable _workAvailable;
+    std::condition_variable _workDone;
+    uint64_t _generation = 0;
+    bool _shutdown = false;
+};
+
+/************************************************************************/
+/* Implementation                                                       */
+/************************************************************************/
+
+template <typename T, typename Func>
+std::vector<T> ThreadPool::parallelCollect(size_t numElements, Func const& func, size_t minChunkSize)
+{
+    std::mutex mutex;
+    std::vector<std::pair<size_t, std::vector<T>>> chunkResults;
+    parallelFor(
+        numElements,
+        [&](size_t startIndex, size_t endIndex) {
+            std::vector<T> chunkResult;
+            func(startIndex, endIndex, chunkResult);
+            if (!chunkResult.empty()) {
+                std::lock_guard lock(mutex);
+                chunkResults.emplace_back(startIndex, std::move(chunkResult));
+            }
+        },
+        minChunkSize);
+
+    std::sort(chunkResults.begin(), chunkResults.end(), [](auto const& left, auto const& right) { return left.first < right.first; });
+    std::vector<T> result;
+    for (auto& [startIndex, chunkResult] : chunkResults) {
+        result.insert(result.end(), chunkResult.begin(), chunkResult.end());
+    }
+    return result;
+}
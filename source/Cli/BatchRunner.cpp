@@ -0,0 +1,400 @@
+#include "BatchRunner.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/range/combine.hpp>
+
+#include "Base/StringHelper.h"
+#include "EngineImpl/SimulationFacadeImpl.h"
+#include "PersisterInterface/AuxiliaryDataParserService.h"
+#include "PersisterInterface/SerializerService.h"
+
+namespace
+{
+    std::string const CheckpointPrefix = "checkpoint_";
+    std::string const ResultFilename = "result.sim";
+    std::string const RunSummaryFilename = "summary.json";
+    std::string const SummaryFilename = "summary.csv";
+
+    bool saveSimulation(SimulationFacade const& simulationFacade, AuxiliaryData auxiliaryData, std::filesystem::path const& filename)
+    {
+        auxiliaryData.timestep = simulationFacade->getCurrentTimestep();
+        auxiliaryData.simulationParameters = simulationFacade->getSimulationParameters();
+        auxiliaryData.realTime = simulationFacade->getRealTime();
+        auto statisticsSnapshot = simulationFacade->getStatisticsHistory().getSnapshot();
+        simulationFacade->saveSimulationData(filename);
+        return SerializerService::get().serializeSettingsAndStatisticsToFiles(
+            filename, auxiliaryData, statisticsSnapshot->getData(), statisticsSnapshot->getNumStableDataPoints());
+    }
+
+    std::string toCsvField(std::string const& value)
+    {
+        auto needsQuotes = value.find_first_of(",\"\r\n") != std::string::npos || (!value.empty() && (value.front() == ' ' || value.back() == ' '));
+        if (!needsQuotes) {
+            return value;
+        }
+        std::string result = "\"";
+        for (auto const& c : value) {
+            if (c == '"') {
+                result += '"';
+            }
+            result += c;
+        }
+        return result + "\"";
+    }
+
+    int getNumCells(RawStatisticsData const& statistics)
+    {
+        auto result = 0;
+        for (int i = 0; i < MAX_COLORS; ++i) {
+            result += statistics.timeline.timestep.numCells[i];
+        }
+        return result;
+    }
+}
+
+std::vector<SweepParameter> BatchRunner::readSweepSpecification(std::filesystem::path const& filename)
+{
+    std::ifstream stream(filename);
+    if (!stream) {
+        throw std::runtime_error("Could not open sweep specification " + filename.string() + ".");
+    }
+
+    //the specification is a json object mapping nodes of the settings file to arrays of values
+    boost::property_tree::ptree tree;
+    try {
+        boost::property_tree::read_json(stream, tree);
+    } catch (boost::property_tree::json_parser_error const& e) {
+        throw std::runtime_error("Could not parse sweep specification: " + std::string(e.what()));
+    }
+
+    auto defaultTree = AuxiliaryDataParserService::get().encodeSimulationParameters(SimulationParameters());
+
+    std::vector<SweepParameter> result;
+    for (auto const& [node, valuesTree] : tree) {
+        if (!defaultTree.get_child_optional(node) && !defaultTree.get_child_optional(node + "[0]")) {
+            throw std::runtime_error("Unknown simulation parameter \"" + node + "\" in sweep specification.");
+        }
+        SweepParameter parameter;
+        parameter.node = node;
+        if (valuesTree.empty()) {
+            parameter.values.emplace_back(valuesTree.data());
+        }
+        for (auto const& [key, valueTree] : valuesTree) {
+            parameter.values.emplace_back(valueTree.data());
+        }
+        if (parameter.values.empty() || parameter.values.front().empty()) {
+            throw std::runtime_error("No values given for \"" + node + "\" in sweep specification.");
+        }
+        result.emplace_back(parameter);
+    }
+    return result;
+}
+
+BatchRunner::BatchRunner(BatchSettings const& settings, DeserializedSimulation const& input)
+    : _settings(settings)
+    , _input(input)
+{
+    if (!_settings.sweepFilename.empty()) {
+        _sweepParameters = readSweepSpecification(_settings.sweepFilename);
+    }
+}
+
+bool BatchRunner::run()
+{
+    std::filesystem::create_directories(_settings.outputDirectory);
+
+    auto runSpecs = createRunSpecifications();
+
+    auto numParallelRuns = std::max(1, std::min(_settings.maxParallelRuns, toInt(runSpecs.size())));
+    auto backendSettings = _settings.backendSettings;
+    if (backendSettings.backend == SimulationBackend_Cuda && numParallelRuns > 1) {
+        print("The CUDA backend processes one run at a time since the simulation parameters are held in device constants.");
+        numParallelRuns = 1;
+    }
+    if (backendSettings.backend == SimulationBackend_Cpu) {
+        auto threadBudget = backendSettings.numCpuThreads > 0 ? backendSettings.numCpuThreads : toInt(std::thread::hardware_concurrency());
+        backendSettings.numCpuThreads = std::max(1, threadBudget / numParallelRuns);
+    }
+    print(
+        "Batch with " + std::to_string(runSpecs.size()) + " runs, " + std::to_string(numParallelRuns) + " in parallel"
+        + (backendSettings.backend == SimulationBackend_Cpu ? " with " + std::to_string(backendSettings.numCpuThreads) + " threads each" : ""));
+
+    std::vector<RunSummary> summaries(runSpecs.size());
+    std::atomic<int> nextRunIndex{0};
+    auto processRuns = [&] {
+        for (auto index = nextRunIndex++; index < toInt(runSpecs.size()); index = nextRunIndex++) {
+            summaries.at(index) = executeRun(runSpecs.at(index), backendSettings);
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int i = 1; i < numParallelRuns; ++i) {
+        threads.emplace_back(processRuns);
+    }
+    processRuns();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    writeSummary(runSpecs, summaries);
+
+    return std::none_of(summaries.begin(), summaries.end(), [](RunSummary const& summary) { return summary.status.starts_with("failed"); });
+}
+
+auto BatchRunner::createRunSpecifications() const -> std::vector<RunSpecification>
+{
+    auto numRuns = 1;
+    for (auto const& parameter : _sweepParameters) {
+        numRuns *= toInt(parameter.values.size());
+    }
+
+    //the first sweep parameter varies slowest
+    std::vector<RunSpecification> result;
+    result.reserve(numRuns);
+    for (int index = 0; index < numRuns; ++index) {
+        RunSpecification runSpec;
+        runSpec.index = index;
+        auto remainder = index;
+        runSpec.parameterValues.resize(_sweepParameters.size());
+        for (int i = toInt(_sweepParameters.size()) - 1; i >= 0; --i) {
+            auto const& values = _sweepParameters.at(i).values;
+            runSpec.parameterValues.at(i) = values.at(remainder % values.size());
+            remainder /= toInt(values.size());
+        }
+        runSpec.parameters = applySweepValues(_input.auxiliaryData.simulationParameters, runSpec.parameterValues);
+        result.emplace_back(runSpec);
+    }
+    return result;
+}
+
+SimulationParameters BatchRunner::applySweepValues(SimulationParameters const& parameters, std::vector<std::string> const& values) const
+{
+    auto tree = AuxiliaryDataParserService::get().encodeSimulationParameters(parameters);
+    for (auto const& [parameter, value] : boost::combine(_sweepParameters, values)) {
+        if (tree.get_child_optional(parameter.node)) {
+            tree.put(parameter.node, value);
+        } else {
+
+            //node without color index: value applies to all colors
+            for (int i = 0; i < MAX_COLORS; ++i) {
+                tree.put(parameter.node + "[" + std::to_string(i) + "]", value);
+            }
+        }
+    }
+    return AuxiliaryDataParserService::get().decodeSimulationParameters(tree);
+}
+
+auto BatchRunner::executeRun(RunSpecification const& runSpec, BackendSettings const& backendSettings) -> RunSummary
+{
+    RunSummary result;
+    auto runName = "Run " + std::to_string(runSpec.index);
+    try {
+        auto runDirectory = getRunDirectory(runSpec.index);
+        std::filesystem::create_directories(runDirectory);
+
+        if (std::filesystem::exists(runDirectory / ResultFilename)) {
+            print(runName + ": already finished");
+            return loadRunSummary(runDirectory);
+        }
+
+        DeserializedSimulation simData;
+        auto checkpointFilename = loadNewestCheckpoint(simData, runDirectory);
+        if (checkpointFilename) {
+            checkSweepValues(simData.auxiliaryData.simulationParameters, runSpec);
+            print(runName + ": resume from " + checkpointFilename->filename().string());
+        } else {
+            simData = _input;
+            simData.auxiliaryData.simulationParameters = runSpec.parameters;
+        }
+        auto targetTimestep = _input.auxiliaryData.timestep + _settings.timesteps;
+
+        auto simulationFacade = std::make_shared<_SimulationFacadeImpl>();
+        simulationFacade->setBackendSettings(backendSettings);
+        simulationFacade->newSimulation(simData.auxiliaryData.timestep, simData.auxiliaryData.generalSettings, simData.auxiliaryData.simulationParameters);
+        simulationFacade->setClusteredSimulationData(simData.mainData);
+        simulationFacade->setStatisticsHistory(simData.statistics);
+        simulationFacade->setRealTime(simData.auxiliaryData.realTime);
+
+        result.startTimestep = simulationFacade->getCurrentTimestep();
+        auto startTimepoint = std::chrono::steady_clock::now();
+        double cellUpdates = 0;
+        while (simulationFacade->getCurrentTimestep() < targetTimestep) {
+            auto remainingTimesteps = targetTimestep - simulationFacade->getCurrentTimestep();
+            auto timesteps = _settings.checkpointInterval > 0 ? std::min(_settings.checkpointInterval, remainingTimesteps) : remainingTimesteps;
+            simulationFacade->calcTimesteps(timesteps);
+            cellUpdates += toDouble(getNumCells(simulationFacade->getRawStatistics())) * toDouble(timesteps);
+
+            if (_settings.checkpointInterval > 0 && simulationFacade->getCurrentTimestep() < targetTimestep) {
+                auto newCheckpointFilename = runDirectory / (CheckpointPrefix + std::to_string(simulationFacade->getCurrentTimestep()) + ".sim");
+                if (!saveSimulation(simulationFacade, simData.auxiliaryData, newCheckpointFilename)) {
+                    throw std::runtime_error("could not write checkpoint " + newCheckpointFilename.string());
+                }
+                if (checkpointFilename) {
+                    SerializerService::get().deleteSimulation(*checkpointFilename);
+                }
+                checkpointFilename = newCheckpointFilename;
+                print(runName + ": checkpoint at time step " + StringHelper::format(simulationFacade->getCurrentTimestep()));
+            }
+        }
+        result.durationMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimepoint).count();
+        result.endTimestep = simulationFacade->getCurrentTimestep();
+
+        auto timesteps = result.endTimestep - result.startTimestep;
+        result.tps = result.durationMs != 0 ? 1000.0f * toFloat(timesteps) / toFloat(result.durationMs) : 0.0f;
+        result.cellUpdatesPerSecond = result.durationMs != 0 ? 1000.0 * cellUpdates / toDouble(result.durationMs) : 0.0;
+        result.status = "finished";
+
+        //the run summary is written first such that each result has one
+        saveRunSummary(result, runDirectory);
+        if (!saveSimulation(simulationFacade, simData.auxiliaryData, runDirectory / ResultFilename)) {
+            throw std::runtime_error("could not write result");
+        }
+        removeCheckpoints(runDirectory);
+        simulationFacade->closeSimulation();
+
+        print(
+            runName + ": finished " + StringHelper::format(timesteps) + " time steps, " + StringHelper::format(static_cast<uint64_t>(result.durationMs))
+            + " ms, " + StringHelper::format(result.tps, 1) + " TPS");
+    } catch (std::exception const& e) {
+        result.status = "failed: " + std::string(e.what());
+        print(runName + ": " + result.status);
+    }
+    return result;
+}
+
+std::optional<std::filesystem::path> BatchRunner::loadNewestCheckpoint(DeserializedSimulation& data, std::filesystem::path const& runDirectory) const
+{
+    std::vector<std::pair<uint64_t, std::filesystem::path>> checkpoints;
+    for (auto const& entry : std::filesystem::directory_iterator(runDirectory)) {
+        auto filename = entry.path().filename().string();
+        if (entry.path().extension() != ".sim" || !filename.starts_with(CheckpointPrefix)) {
+            continue;
+        }
+        try {
+            auto timestep = std::stoull(entry.path().stem().string().substr(CheckpointPrefix.size()));
+            checkpoints.emplace_back(timestep, entry.path());
+        } catch (std::exception const&) {
+        }
+    }
+    std::sort(checkpoints.begin(), checkpoints.end(), [](auto const& left, auto const& right) { return left.first > right.first; });
+
+    //a checkpoint may be incomplete if the process has been killed while writing it
+    for (auto const& [timestep, filename] : checkpoints) {
+        if (SerializerService::get().deserializeSimulationFromFiles(data, filename)) {
+            return filename;
+        }
+    }
+    return std::nullopt;
+}
+
+void BatchRunner::checkSweepValues(SimulationParameters const& parameters, RunSpecification const& runSpec) const
+{
+    //only the swept nodes are compared since the simulation changes other parameters over time (e.g. external energy, zone positions)
+    auto tree = AuxiliaryDataParserService::get().encodeSimulationParameters(parameters);
+    auto expectedTree = AuxiliaryDataParserService::get().encodeSimulationParameters(runSpec.parameters);
+    for (auto const& parameter : _sweepParameters) {
+        std::vector<std::string> nodes;
+        if (expectedTree.get_child_optional(parameter.node)) {
+            nodes.emplace_back(parameter.node);
+        } else {
+            for (int i = 0; i < MAX_COLORS; ++i) {
+                nodes.emplace_back(parameter.node + "[" + std::to_string(i) + "]");
+            }
+        }
+        for (auto const& node : nodes) {
+            if (tree.get_optional<std::string>(node) != expectedTree.get_optional<std::string>(node)) {
+                throw std::runtime_error("checkpoint does not match the run specification at \"" + node + "\"");
+            }
+        }
+    }
+}
+
+void BatchRunner::saveRunSummary(RunSummary const& summary, std::filesystem::path const& runDirectory) const
+{
+    boost::property_tree::ptree tree;
+    tree.put("start time step", summary.startTimestep);
+    tree.put("end time step", summary.endTimestep);
+    tree.put("duration", summary.durationMs);
+    tree.put("tps", summary.tps);
+    tree.put("cell updates per second", summary.cellUpdatesPerSecond);
+    tree.put("status", summary.status);
+
+    std::ofstream stream(runDirectory / RunSummaryFilename, std::ios::binary);
+    if (!stream) {
+        throw std::runtime_error("could not write run summary");
+    }
+    boost::property_tree::json_parser::write_json(stream, tree);
+}
+
+auto BatchRunner::loadRunSummary(std::filesystem::path const& runDirectory) const -> RunSummary
+{
+    std::ifstream stream(runDirectory / RunSummaryFilename, std::ios::binary);
+    if (!stream) {
+        throw std::runtime_error("could not read run summary of finished run");
+    }
+    boost::property_tree::ptree tree;
+    try {
+        boost::property_tree::read_json(stream, tree);
+        RunSummary result;
+        result.startTimestep = tree.get<uint64_t>("start time step");
+        result.endTimestep = tree.get<uint64_t>("end time step");
+        result.durationMs = tree.get<int64_t>("duration");
+        result.tps = tree.get<float>("tps");
+        result.cellUpdatesPerSecond = tree.get<double>("cell updates per second");
+        result.status = tree.get<std::string>("status");
+        return result;
+    } catch (boost::property_tree::ptree_error const& e) {
+        throw std::runtime_error("could not parse run summary of finished run: " + std::string(e.what()));
+    }
+}
+
+void BatchRunner::removeCheckpoints(std::filesystem::path const& runDirectory) const
+{
+    //also removes unreadable checkpoints and their settings and statistics files
+    std::vector<std::filesystem::path> filenames;
+    for (auto const& entry : std::filesystem::directory_iterator(runDirectory)) {
+        if (entry.path().filename().string().starts_with(CheckpointPrefix)) {
+            filenames.emplace_back(entry.path());
+        }
+    }
+    for (auto const& filename : filenames) {
+        std::filesystem::remove(filename);
+    }
+}
+
+void BatchRunner::writeSummary(std::vector<RunSpecification> const& runSpecs, std::vector<RunSummary> const& summaries) const
+{
+    std::ofstream stream(_settings.outputDirectory / SummaryFilename, std::ios::binary);
+    stream << "run";
+    for (auto const& parameter : _sweepParameters) {
+        stream << ", " << toCsvField(parameter.node);
+    }
+    stream << ", start time step, end time step, duration [ms], TPS, cell updates per second, status" << std::endl;
+
+    for (auto const& [runSpec, summary] : boost::combine(runSpecs, summaries)) {
+        stream << runSpec.index;
+        for (auto const& value : runSpec.parameterValues) {
+            stream << ", " << toCsvField(value);
+        }
+        stream << ", " << summary.startTimestep << ", " << summary.endTimestep << ", " << summary.durationMs << ", " << summary.tps << ", "
+               << static_cast<uint64_t>(summary.cellUpdatesPerSecond) << ", " << toCsvField(summary.status) << std::endl;
+    }
+}
+
+std::filesystem::path BatchRunner::getRunDirectory(int index) const
+{
+    return _settings.outputDirectory / ("run_" + std::to_string(index));
+}
+
+void BatchRunner::print(std::string const& message)
+{
+    std::lock_guard lock(_outputMutex);
+    std::cout << message << std::endl;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "EngineInterface/BackendSettings.h"
+#include "EngineInterface/SimulationParameters.h"
+#include "PersisterInterface/DeserializedSimulation.h"
+
+struct SweepParameter
+{
+    std::string node;  //node in the settings file, e.g. "simulation parameters.time step size"
+    std::vector<std::string> values;
+};
+
+struct BatchSettings
+{
+    std::filesystem::path sweepFilename;    //empty = single run with the parameters from the input file
+    std::filesystem::path outputDirectory;
+    uint64_t timesteps = 0;
+    uint64_t checkpointInterval = 0;        //0 = no checkpoints
+    int maxParallelRuns = 1;
+    BackendSettings backendSettings;        //numCpuThreads is the thread budget of all parallel runs together
+};
+
+/**
+ * Runs the cartesian product of the sweep parameters as separate simulations.
+ * Each run lives in its own subdirectory of the output directory, is saved every checkpointInterval time steps and is
+ * resumed from its newest readable checkpoint when the batch is started again.
+ */
+class BatchRunner
+{
+public:
+    static std::vector<SweepParameter> readSweepSpecification(std::filesystem::path const& filename);  //throws std::runtime_error
+
+    BatchRunner(BatchSettings const& settings, DeserializedSimulation const& input);
+
+    bool run();  //returns false if a run has failed
+
+private:
+    struct RunSpecification
+    {
+        int index = 0;
+        std::vector<std::string> parameterValues;
+        SimulationParameters parameters;
+    };
+
+    struct RunSummary
+    {
+        uint64_t startTimestep = 0;
+        uint64_t endTimestep = 0;
+        int64_t durationMs = 0;
+        float tps = 0;
+        double cellUpdatesPerSecond = 0;
+        std::string status;
+    };
+
+    std::vector<RunSpecification> createRunSpecifications() const;
+    SimulationParameters applySweepValues(SimulationParameters const& parameters, std::vector<std::string> const& values) const;
+
+    RunSummary executeRun(RunSpecification const& runSpec, BackendSettings const& backendSettings);
+    std::optional<std::filesystem::path> loadNewestCheckpoint(DeserializedSimulation& data, std::filesystem::path const& runDirectory) const;
+    void checkSweepValues(SimulationParameters const& parameters, RunSpecification const& runSpec) const;  //throws std::runtime_error
+    void saveRunSummary(RunSummary const& summary, std::filesystem::path const& runDirectory) const;
+    RunSummary loadRunSummary(std::filesystem::path const& runDirectory) const;  //throws std::runtime_error
+    void removeCheckpoints(std::filesystem::path const& runDirectory) const;
+    void writeSummary(std::vector<RunSpecification> const& runSpecs, std::vector<RunSummary> const& summaries) const;
+
+    std::filesystem::path getRunDirectory(int index) const;
+    void print(std::string const& message);
+
+    BatchSettings _settings;
+    DeserializedSimulation const& _input;
+    std::vector<SweepParameter> _sweepParameters;
+
+    std::mutex _outputMutex;
+};
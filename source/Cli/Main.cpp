@@ -8,9 +8,13 @@
 #include "Base/Resources.h"
 #include "Base/StringHelper.h"
 #include "Base/FileLogger.h"
+#include "PersisterInterface/ColumnarSnapshot.h"
+#include "PersisterInterface/ColumnarSnapshotService.h"
 #include "PersisterInterface/SerializerService.h"
 #include "EngineImpl/SimulationFacadeImpl.h"
 
+#include "BatchRunner.h"
+
 int main(int argc, char** argv)
 {
     try {
@@ -23,13 +27,34 @@ int main(int argc, char** argv)
         std::string outputFilename;
         std::string statisticsFilename;
         int timesteps = 0;
+        bool cpu = false;
+        int numCpuThreads = 0;
+        std::string sweepFilename;
+        std::string batchDirectory;
+        uint64_t checkpointInterval = 0;
+        int maxParallelRuns = 1;
         app.add_option(
             "-i", inputFilename, "Specifies the name of the input file for the simulation to run. The corresponding *.settings.json should also be available.");
         app.add_option(
             "-o",
             outputFilename,
-            "Specifies the name of the output file for the simulation. The *.settings.json and *.statistics.csv file will also be saved.");
+            "Specifies the name of the output file for the simulation. The *.settings.json and *.statistics.bin file will also be saved.");
         app.add_option("-t", timesteps, "The number of time steps to be calculated.");
+        app.add_flag("--cpu", cpu, "Runs the simulation on the CPU instead of a CUDA device. Only nerve and neuron cell functions are supported.");
+        app.add_option("--threads", numCpuThreads, "The number of threads for the CPU backend (0 = all hardware threads).");
+        app.add_option(
+            "--batch",
+            batchDirectory,
+            "Runs the simulation in batch mode. Each run is written to a subdirectory of the given directory, and a summary.csv is created. "
+            "Unfinished runs are resumed from their newest checkpoint.");
+        app.add_option(
+            "--sweep",
+            sweepFilename,
+            "Specifies a json file for the batch mode which maps simulation parameters (as named in the *.settings.json file) to arrays of values. A run is "
+            "started for each combination of values.");
+        app.add_option("--checkpoint-interval", checkpointInterval, "The number of time steps between two checkpoints in batch mode (0 = no checkpoints).");
+        app.add_option(
+            "--parallel-runs", maxParallelRuns, "The maximum number of runs in batch mode processed in parallel. The thread budget is shared among them.");
         CLI11_PARSE(app, argc, argv);
 
         //read input
@@ -38,18 +63,50 @@ int main(int argc, char** argv)
             std::cout << "No input file given." << std::endl;
             return 1;
         }
+        //a single run loads columnar simulation files directly into the engine unless they only contain the changes to another file
+        auto loadDirectly = batchDirectory.empty() && ColumnarSnapshot::isColumnarSnapshot(inputFilename)
+            && !ColumnarSnapshotService::get().getDeltaBaseFilename(inputFilename).has_value();
         DeserializedSimulation simData;
-        if (!SerializerService::get().deserializeSimulationFromFiles(simData, inputFilename)) {
+        auto inputRead = loadDirectly
+            ? SerializerService::get().deserializeSettingsAndStatisticsFromFiles(simData.auxiliaryData, simData.statistics, inputFilename)
+            : SerializerService::get().deserializeSimulationFromFiles(simData, inputFilename);
+        if (!inputRead) {
             std::cout << "Could not read from input files." << std::endl;
             return 1;
         }
 
+        //run batch
+        if (!batchDirectory.empty()) {
+            BatchSettings batchSettings;
+            batchSettings.sweepFilename = sweepFilename;
+            batchSettings.outputDirectory = batchDirectory;
+            batchSettings.timesteps = timesteps;
+            batchSettings.checkpointInterval = checkpointInterval;
+            batchSettings.maxParallelRuns = maxParallelRuns;
+            batchSettings.backendSettings = {cpu ? SimulationBackend_Cpu : SimulationBackend_Cuda, numCpuThreads};
+
+            BatchRunner batchRunner(batchSettings, simData);
+            if (!batchRunner.run()) {
+                std::cout << "Batch finished with failed runs." << std::endl;
+                return 1;
+            }
+            std::cout << "Finished" << std::endl;
+            return 0;
+        }
+
         //run simulation
         auto startTimepoint = std::chrono::steady_clock::now();
 
         auto simulationFacade = std::make_shared<_SimulationFacadeImpl>();
+        if (cpu) {
+            simulationFacade->setBackendSettings({SimulationBackend_Cpu, numCpuThreads});
+        }
         simulationFacade->newSimulation(simData.auxiliaryData.timestep, simData.auxiliaryData.generalSettings, simData.auxiliaryData.simulationParameters);
-        simulationFacade->setClusteredSimulationData(simData.mainData);
+        if (loadDirectly) {
+            simulationFacade->loadSimulationData(inputFilename);
+        } else {
+            simulationFacade->setClusteredSimulationData(simData.mainData);
+        }
         simulationFacade->setStatisticsHistory(simData.statistics);
         simulationFacade->setRealTime(simData.auxiliaryData.realTime);
         std::cout << "Device: " << simulationFacade->getGpuName() << std::endl;
@@ -65,16 +122,18 @@ int main(int argc, char** argv)
 
         //write output simulation file
         std::cout << "Writing output" << std::endl;
-        simData.auxiliaryData.timestep = static_cast<uint32_t>(simulationFacade->getCurrentTimestep());
-        simData.mainData = simulationFacade->getClusteredSimulationData();
-        simData.auxiliaryData.simulationParameters = simulationFacade->getSimulationParameters();
-        simData.statistics = simulationFacade->getStatisticsHistory().getCopiedData();
-        simData.auxiliaryData.realTime = simulationFacade->getRealTime();
         if (outputFilename.empty()) {
             std::cout << "No output file given." << std::endl;
             return 1;
         }
-        if (!SerializerService::get().serializeSimulationToFiles(outputFilename, simData)) {
+        simData.auxiliaryData.timestep = static_cast<uint32_t>(simulationFacade->getCurrentTimestep());
+        simData.auxiliaryData.simulationParameters = simulationFacade->getSimulationParameters();
+        auto statisticsSnapshot = simulationFacade->getStatisticsHistory().getSnapshot();
+        simData.statistics = statisticsSnapshot->getData();
+        simData.numStableStatistics = statisticsSnapshot->getNumStableDataPoints();
+        simData.auxiliaryData.realTime = simulationFacade->getRealTime();
+        simulationFacade->saveSimulationData(outputFilename);
+        if (!SerializerService::get().serializeSettingsAndStatisticsToFiles(outputFilename, simData.auxiliaryData, simData.statistics, simData.numStableStatistics)) {
             std::cout << "Could not write to output files." << std::endl;
             return 1;
         }
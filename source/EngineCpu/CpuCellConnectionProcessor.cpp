@@ -0,0 +1,229 @@
+#include "CpuCellConnectionProcessor.h"
+
+#include <algorithm>
+
+#include "Base/Math.h"
+
+#include "CpuRadiationProcessor.h"
+
+void CpuCellConnectionProcessor::processOperations(
+    CpuSimulationData& data,
+    SimulationParameters const& parameters,
+    CpuStructuralOperations& operations,
+    std::vector<CpuNewParticle>& newParticles)
+{
+    auto& cells = data.cells;
+
+    for (auto const& [cellIndex1, cellIndex2] : operations.addConnectionPairs) {
+        if (cells.numConnections[cellIndex1] < cells.maxConnections[cellIndex1] && cells.numConnections[cellIndex2] < cells.maxConnections[cellIndex2]
+            && !isConnected(data, cellIndex1, cellIndex2)) {
+            tryAddConnections(data, cellIndex1, cellIndex2);
+        }
+    }
+
+    for (auto const& cellIndex : operations.deleteAllConnections) {
+        deleteAllConnections(data, cellIndex);
+    }
+
+    if (!operations.deleteCells.empty()) {
+        std::vector<uint8_t> removed(cells.size(), 0);
+        for (auto const& cellIndex : operations.deleteCells) {
+            if (removed[cellIndex]) {
+                continue;
+            }
+            removed[cellIndex] = 1;
+
+            CpuRandom random(data.timestep, cells.id[cellIndex], CpuRandomStream_CellDeletion);
+            if (auto particle = CpuRadiationProcessor::radiate(
+                    data, parameters, random, cells.pos[cellIndex], cells.vel[cellIndex], cells.color[cellIndex], cells.energy[cellIndex])) {
+                newParticles.emplace_back(*particle);
+            }
+            deleteAllConnections(data, cellIndex);
+        }
+        compactCells(data, removed);
+    }
+    operations.clear();
+}
+
+bool CpuCellConnectionProcessor::tryAddConnections(CpuSimulationData& data, int cellIndex1, int cellIndex2)
+{
+    auto& cells = data.cells;
+    auto posDelta = data.cellMap.getCorrectedDirection(cells.pos[cellIndex2] - cells.pos[cellIndex1]);
+
+    auto origConnections = cells.connections[cellIndex1];
+    auto origNumConnections = cells.numConnections[cellIndex1];
+    if (!tryAddConnectionOneWay(data, cellIndex1, cellIndex2, posDelta)) {
+        return false;
+    }
+    if (!tryAddConnectionOneWay(data, cellIndex2, cellIndex1, posDelta * (-1.0f))) {
+        cells.connections[cellIndex1] = origConnections;
+        cells.numConnections[cellIndex1] = origNumConnections;
+        return false;
+    }
+    return true;
+}
+
+void CpuCellConnectionProcessor::deleteAllConnections(CpuSimulationData& data, int cellIndex)
+{
+    auto& cells = data.cells;
+    for (int i = 0; i < cells.numConnections[cellIndex]; ++i) {
+        deleteConnectionOneWay(data, cells.connections[cellIndex][i].cellIndex, cellIndex);
+    }
+    cells.numConnections[cellIndex] = 0;
+}
+
+void CpuCellConnectionProcessor::deleteConnections(CpuSimulationData& data, int cellIndex1, int cellIndex2)
+{
+    deleteConnectionOneWay(data, cellIndex1, cellIndex2);
+    deleteConnectionOneWay(data, cellIndex2, cellIndex1);
+}
+
+bool CpuCellConnectionProcessor::isConnected(CpuSimulationData const& data, int cellIndex1, int cellIndex2)
+{
+    auto const& cells = data.cells;
+    for (int i = 0; i < cells.numConnections[cellIndex1]; ++i) {
+        if (cells.connections[cellIndex1][i].cellIndex == cellIndex2) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void CpuCellConnectionProcessor::compactCells(CpuSimulationData& data, std::vector<uint8_t> const& removed)
+{
+    auto& cells = data.cells;
+    std::vector<int> newIndices(cells.size(), -1);
+    size_t numRemainingCells = 0;
+    for (size_t index = 0; index < cells.size(); ++index) {
+        if (!removed[index]) {
+            newIndices[index] = toInt(numRemainingCells);
+            if (numRemainingCells != index) {
+                cells.copyEntry(index, numRemainingCells);
+            }
+            ++numRemainingCells;
+        }
+    }
+    cells.resize(numRemainingCells);
+
+    for (size_t index = 0; index < numRemainingCells; ++index) {
+        for (int i = 0; i < cells.numConnections[index]; ++i) {
+            auto& connection = cells.connections[index][i];
+            connection.cellIndex = newIndices[connection.cellIndex];
+        }
+    }
+}
+
+bool CpuCellConnectionProcessor::tryAddConnectionOneWay(CpuSimulationData& data, int cellIndex1, int cellIndex2, RealVector2D const& posDelta)
+{
+    auto& cells = data.cells;
+    if (wouldResultInOverlappingConnection(data, cellIndex1, cells.pos[cellIndex2])) {
+        return false;
+    }
+
+    auto newAngle = Math::angleOfVector(posDelta);
+    auto desiredDistance = Math::length(posDelta);
+
+    auto& numConnections = cells.numConnections[cellIndex1];
+    auto& connections = cells.connections[cellIndex1];
+    if (0 == numConnections) {
+        connections[0] = CpuConnection{cellIndex2, desiredDistance, 360.0f};
+        ++numConnections;
+        return true;
+    }
+    if (1 == numConnections) {
+        auto connectedCellDelta = data.cellMap.getCorrectedDirection(cells.pos[connections[0].cellIndex] - cells.pos[cellIndex1]);
+        auto prevAngle = Math::angleOfVector(connectedCellDelta);
+        auto angleDiff = newAngle - prevAngle;
+        if (angleDiff < 0) {
+            angleDiff += 360.0f;
+        }
+        if (std::abs(angleDiff) < NEAR_ZERO || std::abs(angleDiff - 360.0f) < NEAR_ZERO || std::abs(angleDiff + 360.0f) < NEAR_ZERO) {
+            return false;
+        }
+        connections[1] = CpuConnection{cellIndex2, desiredDistance, angleDiff};
+        connections[0].angleFromPrevious = 360.0f - angleDiff;
+        ++numConnections;
+        return true;
+    }
+
+    //find appropriate index for new connection
+    int index = 0;
+    float prevAngle = 0;
+    float nextAngle = 0;
+    for (; index < numConnections; ++index) {
+        auto prevIndex = (index + numConnections - 1) % numConnections;
+        prevAngle = Math::angleOfVector(data.cellMap.getCorrectedDirection(cells.pos[connections[prevIndex].cellIndex] - cells.pos[cellIndex1]));
+        nextAngle = Math::angleOfVector(data.cellMap.getCorrectedDirection(cells.pos[connections[index].cellIndex] - cells.pos[cellIndex1]));
+        if (Math::isAngleInBetween(prevAngle, nextAngle, newAngle)) {
+            break;
+        }
+    }
+
+    auto angleFromPrevious = 0.0f;
+    auto refAngle = connections[index % numConnections].angleFromPrevious;
+    if (Math::isAngleInBetween(prevAngle, nextAngle, newAngle)) {
+        auto angleDiff1 = Math::subtractAngle(newAngle, prevAngle);
+        auto angleDiff2 = Math::subtractAngle(nextAngle, prevAngle);
+        auto factor = angleDiff2 != 0 ? angleDiff1 / angleDiff2 : 0.5f;
+        angleFromPrevious = std::min(refAngle * factor, refAngle);
+    }
+    if (angleFromPrevious < NEAR_ZERO) {
+        return false;
+    }
+
+    //adjust reference angle of next connection
+    auto nextAngleFromPrevious = refAngle - angleFromPrevious;
+    if (nextAngleFromPrevious < NEAR_ZERO) {
+        return false;
+    }
+    connections[index % numConnections].angleFromPrevious = nextAngleFromPrevious;
+
+    //add connection
+    for (int j = numConnections; j > index; --j) {
+        connections[j] = connections[j - 1];
+    }
+    connections[index] = CpuConnection{cellIndex2, desiredDistance, angleFromPrevious};
+    ++numConnections;
+    return true;
+}
+
+void CpuCellConnectionProcessor::deleteConnectionOneWay(CpuSimulationData& data, int cellIndex1, int cellIndex2)
+{
+    auto& numConnections = data.cells.numConnections[cellIndex1];
+    auto& connections = data.cells.connections[cellIndex1];
+    for (int i = 0; i < numConnections; ++i) {
+        if (connections[i].cellIndex == cellIndex2) {
+            auto angleToAdd = connections[i].angleFromPrevious;
+            for (int j = i; j < numConnections - 1; ++j) {
+                connections[j] = connections[j + 1];
+            }
+            if (i < numConnections - 1) {
+                connections[i].angleFromPrevious += angleToAdd;
+            } else {
+                connections[0].angleFromPrevious += angleToAdd;
+            }
+            --numConnections;
+            return;
+        }
+    }
+}
+
+bool CpuCellConnectionProcessor::wouldResultInOverlappingConnection(CpuSimulationData const& data, int cellIndex, RealVector2D const& otherCellPos)
+{
+    auto const& cells = data.cells;
+    auto n = cells.numConnections[cellIndex];
+    if (n < 2) {
+        return false;
+    }
+    for (int i = 0; i < n; ++i) {
+        auto connectedCellIndex = cells.connections[cellIndex][i].cellIndex;
+        auto nextConnectedCellIndex = cells.connections[cellIndex][(i + 1) % n].cellIndex;
+        if (!isConnected(data, connectedCellIndex, nextConnectedCellIndex)) {
+            continue;
+        }
+        if (Math::crossing(cells.pos[cellIndex], otherCellPos, cells.pos[connectedCellIndex], cells.pos[nextConnectedCellIndex])) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <vector>
+
+#include "EngineInterface/SimulationParameters.h"
+
+#include "CpuSimulationData.h"
+#include "Definitions.h"
+
+/**
+ * Structural operations are collected during the parallel passes and executed sequentially afterwards in index order.
+ */
+struct CpuStructuralOperations
+{
+    std::vector<std::pair<int, int>> addConnectionPairs;
+    std::vector<int> deleteAllConnections;
+    std::vector<int> deleteCells;
+
+    void clear()
+    {
+        addConnectionPairs.clear();
+        deleteAllConnections.clear();
+        deleteCells.clear();
+    }
+};
+
+class CpuCellConnectionProcessor
+{
+public:
+    static void processOperations(
+        CpuSimulationData& data,
+        SimulationParameters const& parameters,
+        CpuStructuralOperations& operations,
+        std::vector<CpuNewParticle>& newParticles);
+
+    static bool tryAddConnections(CpuSimulationData& data, int cellIndex1, int cellIndex2);
+    static void deleteAllConnections(CpuSimulationData& data, int cellIndex);
+    static void deleteConnections(CpuSimulationData& data, int cellIndex1, int cellIndex2);
+    static bool isConnected(CpuSimulationData const& data, int cellIndex1, int cellIndex2);
+
+    //removes the cells with removed[index] != 0 and fixes the connection indices, connections to removed cells must already be deleted
+    static void compactCells(CpuSimulationData& data, std::vector<uint8_t> const& removed);
+
+private:
+    static bool tryAddConnectionOneWay(CpuSimulationData& data, int cellIndex1, int cellIndex2, RealVector2D const& posDelta);
+    static void deleteConnectionOneWay(CpuSimulationData& data, int cellIndex1, int cellIndex2);
+    static bool wouldResultInOverlappingConnection(CpuSimulationData const& data, int cellIndex, RealVector2D const& otherCellPos);
+};
@@ -0,0 +1,233 @@
+#include "CpuCellFunctionProcessor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "Base/Math.h"
+#include "Base/ThreadPool.h"
+
+namespace
+{
+    struct CellFunctionActivity
+    {
+        CellFunction cellFunction;
+        uint8_t color;
+    };
+}
+
+void CpuCellFunctionProcessor::process(CpuSimulationData& data, SimulationParameters const& parameters, ThreadPool& threadPool)
+{
+    auto& cells = data.cells;
+
+    //cells with the current execution number only read signals from cells with other execution numbers, hence they can be processed in parallel
+    auto activities = threadPool.parallelCollect<CellFunctionActivity>(cells.size(), [&](size_t startIndex, size_t endIndex, std::vector<CellFunctionActivity>& result) {
+        for (auto index = toInt(startIndex); index < toInt(endIndex); ++index) {
+            if (!isActive(data, parameters, index)) {
+                continue;
+            }
+            auto cellFunction = cells.properties[index].cellFunction;
+            if (cellFunction == CellFunction_Nerve) {
+                if (processNerve(data, parameters, index)) {
+                    result.emplace_back(CellFunctionActivity{CellFunction_Nerve, cells.color[index]});
+                }
+            } else if (cellFunction == CellFunction_Neuron) {
+                processNeuron(data, index);
+                result.emplace_back(CellFunctionActivity{CellFunction_Neuron, cells.color[index]});
+            }
+        }
+    });
+
+    auto& statistics = data.accumulatedStatistics;
+    for (auto const& [cellFunction, color] : activities) {
+        if (cellFunction == CellFunction_Nerve) {
+            ++statistics.numNervePulses[color];
+        } else {
+            ++statistics.numNeuronActivities[color];
+        }
+    }
+}
+
+void CpuCellFunctionProcessor::resetFetchedSignals(CpuSimulationData& data, SimulationParameters const& parameters, ThreadPool& threadPool)
+{
+    auto& cells = data.cells;
+    auto executionOrderNumber = getCurrentExecutionNumber(data, parameters);
+
+    //the decision only depends on the execution numbers, which are not changed in this pass
+    threadPool.parallelFor(cells.size(), [&](size_t startIndex, size_t endIndex) {
+        for (auto index = startIndex; index < endIndex; ++index) {
+            auto& properties = cells.properties[index];
+            if (properties.cellFunction == CellFunction_None) {
+                std::fill(std::begin(properties.signal.channels), std::end(properties.signal.channels), 0.0f);
+                continue;
+            }
+            int maxOtherExecutionOrderNumber = -1;
+            int cellExecutionOrderNumber = properties.executionOrderNumber;
+
+            if (!properties.outputBlocked) {
+                for (int i = 0; i < cells.numConnections[index]; ++i) {
+                    auto const& otherProperties = cells.properties[cells.connections[index][i].cellIndex];
+                    int otherExecutionOrderNumber = otherProperties.executionOrderNumber;
+                    if (otherProperties.inputExecutionOrderNumber == cellExecutionOrderNumber) {
+                        if (maxOtherExecutionOrderNumber == -1) {
+                            maxOtherExecutionOrderNumber = otherExecutionOrderNumber;
+                        } else if (
+                            (maxOtherExecutionOrderNumber > cellExecutionOrderNumber
+                             && (otherExecutionOrderNumber > maxOtherExecutionOrderNumber || otherExecutionOrderNumber < cellExecutionOrderNumber))
+                            || (maxOtherExecutionOrderNumber < cellExecutionOrderNumber && otherExecutionOrderNumber > maxOtherExecutionOrderNumber
+                                && otherExecutionOrderNumber < cellExecutionOrderNumber)) {
+                            maxOtherExecutionOrderNumber = otherExecutionOrderNumber;
+                        }
+                    }
+                }
+            }
+            if ((maxOtherExecutionOrderNumber == -1 && executionOrderNumber == (cellExecutionOrderNumber + 1) % parameters.cellNumExecutionOrderNumbers)
+                || (maxOtherExecutionOrderNumber != -1 && maxOtherExecutionOrderNumber == executionOrderNumber)) {
+                std::fill(std::begin(properties.signal.channels), std::end(properties.signal.channels), 0.0f);
+            }
+        }
+    });
+}
+
+bool CpuCellFunctionProcessor::isActive(CpuSimulationData const& data, SimulationParameters const& parameters, int cellIndex)
+{
+    auto const& properties = data.cells.properties[cellIndex];
+    if (properties.cellFunction == CellFunction_None || properties.executionOrderNumber != getCurrentExecutionNumber(data, parameters)) {
+        return false;
+    }
+    auto livingState = data.cells.livingState[cellIndex];
+    return livingState != LivingState_UnderConstruction && livingState != LivingState_Activating && properties.activationTime == 0;
+}
+
+SignalTO CpuCellFunctionProcessor::calcInputSignal(CpuSimulationData const& data, int cellIndex)
+{
+    auto const& cells = data.cells;
+    auto const& properties = cells.properties[cellIndex];
+
+    SignalTO result;
+    result.origin = SignalOrigin_Unknown;
+    result.targetX = 0;
+    result.targetY = 0;
+    std::fill(std::begin(result.channels), std::end(result.channels), 0.0f);
+
+    if (properties.inputExecutionOrderNumber == -1 || properties.inputExecutionOrderNumber == properties.executionOrderNumber) {
+        return result;
+    }
+
+    int numSensorSignals = 0;
+    for (int i = 0; i < cells.numConnections[cellIndex]; ++i) {
+        auto connectedCellIndex = cells.connections[cellIndex][i].cellIndex;
+        auto const& connectedProperties = cells.properties[connectedCellIndex];
+        auto connectedLivingState = cells.livingState[connectedCellIndex];
+        if (connectedProperties.outputBlocked || connectedLivingState == LivingState_UnderConstruction || connectedLivingState == LivingState_Activating) {
+            continue;
+        }
+        if (connectedProperties.executionOrderNumber == properties.inputExecutionOrderNumber) {
+            for (int j = 0; j < MAX_CHANNELS; ++j) {
+                result.channels[j] += connectedProperties.signal.channels[j];
+                result.channels[j] = std::max(-10.0f, std::min(10.0f, result.channels[j]));  //truncate value to avoid overflow
+            }
+            if (connectedProperties.signal.origin == SignalOrigin_Sensor) {
+                result.origin = SignalOrigin_Sensor;
+                result.targetX += connectedProperties.signal.targetX;
+                result.targetY += connectedProperties.signal.targetY;
+                ++numSensorSignals;
+            }
+        }
+    }
+    if (numSensorSignals > 0) {
+        result.targetX /= numSensorSignals;
+        result.targetY /= numSensorSignals;
+    }
+    return result;
+}
+
+void CpuCellFunctionProcessor::updateInvocationState(CellTO& properties, SignalTO const& signal)
+{
+    if (properties.cellFunctionUsed == CellFunctionUsed_No) {
+        for (int i = 0; i < MAX_CHANNELS - 1; ++i) {
+            if (signal.channels[i] != 0) {
+                properties.cellFunctionUsed = CellFunctionUsed_Yes;
+                break;
+            }
+        }
+    }
+}
+
+bool CpuCellFunctionProcessor::processNerve(CpuSimulationData& data, SimulationParameters const& parameters, int cellIndex)
+{
+    auto& properties = data.cells.properties[cellIndex];
+    auto signal = calcInputSignal(data, cellIndex);
+    updateInvocationState(properties, signal);
+
+    auto const& nerve = properties.cellFunctionData.nerve;
+    auto const& numExecutionOrderNumbers = parameters.cellNumExecutionOrderNumbers;
+    auto executionOrderNumber = static_cast<uint32_t>(properties.executionOrderNumber);
+    auto counter = (data.cells.age[cellIndex] / numExecutionOrderNumbers) * numExecutionOrderNumbers + executionOrderNumber % numExecutionOrderNumbers;
+
+    auto pulse = false;
+    if (nerve.pulseMode > 0 && (counter % (numExecutionOrderNumbers * nerve.pulseMode) == executionOrderNumber)) {
+        pulse = true;
+        if (nerve.alternationMode == 0) {
+            signal.channels[0] += 1.0f;
+        } else {
+            auto evenPulse = counter % (numExecutionOrderNumbers * nerve.pulseMode * nerve.alternationMode * 2)
+                < executionOrderNumber + numExecutionOrderNumbers * nerve.pulseMode * nerve.alternationMode;
+            signal.channels[0] += evenPulse ? 1.0f : -1.0f;
+        }
+    }
+    properties.signal = signal;
+    return pulse;
+}
+
+void CpuCellFunctionProcessor::processNeuron(CpuSimulationData& data, int cellIndex)
+{
+    auto& properties = data.cells.properties[cellIndex];
+    auto inputSignal = calcInputSignal(data, cellIndex);
+    updateInvocationState(properties, inputSignal);
+
+    auto const& neuron = properties.cellFunctionData.neuron;
+    float weights[MAX_CHANNELS * MAX_CHANNELS];
+    float biases[MAX_CHANNELS];
+    auto neuronStateSize = sizeof(weights) + sizeof(biases);
+    if (neuron.weightsAndBiasesDataIndex + neuronStateSize > data.auxiliaryData.size()) {
+        return;
+    }
+    std::memcpy(weights, data.auxiliaryData.data() + neuron.weightsAndBiasesDataIndex, sizeof(weights));
+    std::memcpy(biases, data.auxiliaryData.data() + neuron.weightsAndBiasesDataIndex + sizeof(weights), sizeof(biases));
+
+    SignalTO outputSignal;
+    for (int row = 0; row < MAX_CHANNELS; ++row) {
+        auto sumInput = biases[row];
+        for (int col = 0; col < MAX_CHANNELS; ++col) {
+            sumInput += weights[row * MAX_CHANNELS + col] * inputSignal.channels[col];
+        }
+        outputSignal.channels[row] = applyActivationFunction(neuron.activationFunctions[row], sumInput);
+    }
+    outputSignal.origin = inputSignal.origin;
+    outputSignal.targetX = inputSignal.targetX;
+    outputSignal.targetY = inputSignal.targetY;
+    properties.signal = outputSignal;
+}
+
+float CpuCellFunctionProcessor::applyActivationFunction(NeuronActivationFunction activationFunction, float x)
+{
+    switch (activationFunction) {
+    case NeuronActivationFunction_Sigmoid:
+        return Math::sigmoid(x);
+    case NeuronActivationFunction_BinaryStep:
+        return Math::binaryStep(x);
+    case NeuronActivationFunction_Identity:
+        return std::max(-1.0f, std::min(1.0f, x));
+    case NeuronActivationFunction_Abs:
+        return std::min(1.0f, std::abs(x));
+    case NeuronActivationFunction_Gaussian:
+        return Math::gaussian(x);
+    }
+    return 0;
+}
+
+int CpuCellFunctionProcessor::getCurrentExecutionNumber(CpuSimulationData const& data, SimulationParameters const& parameters)
+{
+    return toInt(data.timestep % parameters.cellNumExecutionOrderNumbers);
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "EngineInterface/SimulationParameters.h"
+
+#include "CpuSimulationData.h"
+#include "Definitions.h"
+
+/**
+ * Host counterpart of the CellFunctionProcessor, NerveProcessor and NeuronProcessor in the kernel code.
+ * Only nerves and neurons are processed, all other cell functions are not supported by the CPU backend.
+ */
+class CpuCellFunctionProcessor
+{
+public:
+    static void process(CpuSimulationData& data, SimulationParameters const& parameters, ThreadPool& threadPool);
+    static void resetFetchedSignals(CpuSimulationData& data, SimulationParameters const& parameters, ThreadPool& threadPool);
+
+private:
+    static bool isActive(CpuSimulationData const& data, SimulationParameters const& parameters, int cellIndex);
+    static SignalTO calcInputSignal(CpuSimulationData const& data, int cellIndex);
+    static void updateInvocationState(CellTO& properties, SignalTO const& signal);
+
+    static bool processNerve(CpuSimulationData& data, SimulationParameters const& parameters, int cellIndex);  //returns true if a pulse has been generated
+    static void processNeuron(CpuSimulationData& data, int cellIndex);
+    static float applyActivationFunction(NeuronActivationFunction activationFunction, float x);
+
+    static int getCurrentExecutionNumber(CpuSimulationData const& data, SimulationParameters const& parameters);
+};
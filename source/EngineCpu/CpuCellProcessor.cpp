@@ -0,0 +1,775 @@
+#include "CpuCellProcessor.h"
+
+#include <cmath>
+
+#include "Base/Math.h"
+#include "Base/ThreadPool.h"
+#include "EngineInterface/GenomeAnalysis.h"
+
+#include "CpuMath.h"
+#include "CpuRadiationProcessor.h"
+#include "CpuSpotCalculator.h"
+
+namespace
+{
+    float calcKernel(float q)
+    {
+        float result;
+        if (q < 1) {
+            result = 2.0f / 3.0f - q * q + 0.5f * q * q * q;
+        } else if (q < 2) {
+            result = 2.0f - q;
+            result = result * result * result / 6;
+        } else {
+            result = 0;
+        }
+        result *= 3.0f / (2.0f * Const::Pi);
+        return result;
+    }
+
+    float calcKernel_d(float q)
+    {
+        float result;
+        if (q < 1) {
+            result = -2 * q + 3.0f / 2.0f * q * q;
+        } else if (q < 2) {
+            result = -0.5f * (2.0f - q) * (2.0f - q);
+        } else {
+            result = 0;
+        }
+        result *= 3.0f / (2.0f * Const::Pi);
+        return result;
+    }
+
+    bool isFusionPossible(CpuCells const& cells, int cellIndex, int otherCellIndex, float cellMaxBindingEnergy)
+    {
+        return cells.numConnections[cellIndex] < cells.maxConnections[cellIndex] && cells.numConnections[otherCellIndex] < cells.maxConnections[otherCellIndex]
+            && cells.energy[cellIndex] <= cellMaxBindingEnergy && cells.energy[otherCellIndex] <= cellMaxBindingEnergy && !cells.barrier[cellIndex]
+            && !cells.barrier[otherCellIndex];
+    }
+
+    using DecayOperationType = int;
+    enum DecayOperationType_
+    {
+        DecayOperationType_DeleteAllConnections,
+        DecayOperationType_DeleteCell,
+        DecayOperationType_Destruction
+    };
+
+    struct DecayOperation
+    {
+        int cellIndex;
+        DecayOperationType type;
+    };
+}
+
+void CpuCellProcessor::radiation(CpuSimulationData& data, SimulationParameters const& parameters, ThreadPool& threadPool)
+{
+    auto& cells = data.cells;
+    auto newParticles = threadPool.parallelCollect<CpuNewParticle>(cells.size(), [&](size_t startIndex, size_t endIndex, std::vector<CpuNewParticle>& result) {
+        for (auto index = startIndex; index < endIndex; ++index) {
+            if (cells.barrier[index]) {
+                continue;
+            }
+            CpuRandom random(data.timestep, cells.id[index], CpuRandomStream_CellRadiation);
+            if (random.random() >= parameters.radiationProb) {
+                continue;
+            }
+            auto color = cells.color[index];
+            auto radiationFactor = 0.0f;
+            if (cells.energy[index] > parameters.highRadiationMinCellEnergy[color]) {
+                radiationFactor += parameters.highRadiationFactor[color];
+            }
+            if (cells.age[index] > static_cast<uint32_t>(parameters.radiationMinCellAge[color])) {
+                radiationFactor += CpuSpotCalculator::calcParameter(
+                    &SimulationParametersZoneValues::radiationCellAgeStrength,
+                    &SimulationParametersZoneActivatedValues::radiationCellAgeStrength,
+                    parameters,
+                    data.cellMap,
+                    cells.pos[index],
+                    color);
+            }
+            if (radiationFactor <= 0) {
+                continue;
+            }
+
+            auto cellEnergy = cells.energy[index];
+            auto energyLoss = cellEnergy * radiationFactor / parameters.radiationProb;
+            energyLoss = 2 * energyLoss * random.random();
+            if (cellEnergy > 1) {
+                auto particleVel = cells.vel[index] * parameters.radiationVelocityMultiplier
+                    + Math::unitVectorOfAngle(random.random() * 360) * parameters.radiationVelocityPerturbation;
+                auto particlePos = cells.pos[index] + CpuMath::normalized(particleVel) * 1.5f
+                    - particleVel;  //"- particleVel" because particle will still be moved in current time step
+                data.cellMap.correctPosition(particlePos);
+                if (energyLoss > cellEnergy - 1) {
+                    energyLoss = cellEnergy - 1;
+                }
+                if (auto particle = CpuRadiationProcessor::radiate(data, parameters, random, particlePos, particleVel, color, energyLoss)) {
+                    result.emplace_back(*particle);
+                }
+                cells.energy[index] -= energyLoss;
+            }
+        }
+    });
+    CpuRadiationProcessor::addParticles(data, newParticles);
+}
+
+void CpuCellProcessor::calcFluidForces(
+    CpuSimulationData& data,
+    SimulationParameters const& parameters,
+    ThreadPool& threadPool,
+    CpuStructuralOperations& operations)
+{
+    auto& cells = data.cells;
+    auto const& fluidMotion = parameters.motionData.fluidMotion;
+    auto const& smoothingLength = fluidMotion.smoothingLength;
+
+    //position corrections and densities are applied after the pass since they are read from the neighbor cells
+    std::vector<RealVector2D> posDeltas(cells.size());
+    std::vector<float> densities(cells.size());
+
+    auto fusionPairs = threadPool.parallelCollect<std::pair<int, int>>(cells.size(), [&](size_t startIndex, size_t endIndex, std::vector<std::pair<int, int>>& result) {
+        for (auto index = toInt(startIndex); index < toInt(endIndex); ++index) {
+            RealVector2D F_pressure{0, 0};
+            RealVector2D F_viscosity{0, 0};
+            RealVector2D cellPosDelta{0, 0};
+            float density = 0;
+            auto cellMaxBindingEnergy = CpuSpotCalculator::calcParameter(
+                &SimulationParametersZoneValues::cellMaxBindingEnergy,
+                &SimulationParametersZoneActivatedValues::cellMaxBindingEnergy,
+                parameters,
+                data.cellMap,
+                cells.pos[index]);
+            auto cellFusionVelocity = CpuSpotCalculator::calcParameter(
+                &SimulationParametersZoneValues::cellFusionVelocity,
+                &SimulationParametersZoneActivatedValues::cellFusionVelocity,
+                parameters,
+                data.cellMap,
+                cells.pos[index]);
+
+            int closestBarrierCellIndex = -1;
+            float closestBarrierCellDistance = 0;
+
+            data.cellMap.executeForEach(cells.pos[index], smoothingLength * 2, [&](int otherIndex) {
+                auto posDelta = data.cellMap.getCorrectedDirection(cells.pos[index] - cells.pos[otherIndex]);
+                auto distance = Math::length(posDelta);
+                if (distance > smoothingLength * 2 || cells.detached[index] + cells.detached[otherIndex] == 1) {
+                    return;
+                }
+                if (cells.barrier[otherIndex]) {
+                    if (closestBarrierCellIndex == -1 || distance < closestBarrierCellDistance) {
+                        closestBarrierCellIndex = otherIndex;
+                        closestBarrierCellDistance = distance;
+                    }
+                    return;
+                }
+
+                //calc density
+                density += calcKernel(distance / smoothingLength) / (smoothingLength * smoothingLength);
+
+                if (index == otherIndex) {
+                    return;
+                }
+
+                //overlap correction
+                if (!cells.barrier[index] && distance < parameters.cellMinDistance) {
+                    cellPosDelta += posDelta * parameters.cellMinDistance / 5;
+                }
+
+                if (CpuCellConnectionProcessor::isConnected(data, index, otherIndex)) {
+                    return;
+                }
+
+                //calc forces: for simplicity pressure = density
+                auto velDelta = cells.vel[index] - cells.vel[otherIndex];
+                auto const& cellDensity = cells.density[index];  //optimization: using the density from last time step
+                auto const& otherCellDensity = cells.density[otherIndex];
+                auto factor = cellDensity / (cellDensity * cellDensity) + otherCellDensity / (otherCellDensity * otherCellDensity);
+
+                if (std::abs(distance) > NEAR_ZERO) {
+                    float kernel_d = calcKernel_d(distance / smoothingLength) / (smoothingLength * smoothingLength * smoothingLength);
+                    F_pressure += posDelta / (-distance) * factor * kernel_d;
+                    F_viscosity += velDelta / otherCellDensity * distance * kernel_d / (distance * distance + 0.25f);
+                }
+
+                //fusion
+                if (Math::length(velDelta) >= cellFusionVelocity && isFusionPossible(cells, index, otherIndex, cellMaxBindingEnergy)) {
+                    result.emplace_back(index, otherIndex);
+                }
+            });
+
+            //calculate barrier forces
+            auto& force = cells.force[index];
+            if (closestBarrierCellIndex != -1) {
+                RealVector2D r{0, 0};
+                auto numConnections = cells.numConnections[closestBarrierCellIndex];
+                auto const& barrierPos = cells.pos[closestBarrierCellIndex];
+                if (numConnections <= 1) {
+                    r = data.cellMap.getCorrectedDirection(cells.pos[index] - barrierPos);
+                } else {
+                    auto angleToCell = Math::angleOfVector(data.cellMap.getCorrectedDirection(cells.pos[index] - barrierPos));
+                    auto const& connections = cells.connections[closestBarrierCellIndex];
+                    for (int i = 0; i < numConnections; ++i) {
+                        auto const& otherPos1 = cells.pos[connections[i].cellIndex];
+                        auto const& otherPos2 = cells.pos[connections[(i + 1) % numConnections].cellIndex];
+                        auto angleToOtherCell1 = Math::angleOfVector(data.cellMap.getCorrectedDirection(otherPos1 - barrierPos));
+                        auto angleToOtherCell2 = Math::angleOfVector(data.cellMap.getCorrectedDirection(otherPos2 - barrierPos));
+                        if (Math::isAngleInBetween(angleToOtherCell1, angleToOtherCell2, angleToCell)) {
+                            r = CpuMath::rotateQuarterCounterClockwise(otherPos2 - otherPos1);
+                            break;
+                        }
+                    }
+                }
+                auto const& barrierVel = cells.vel[closestBarrierCellIndex];
+                auto vr = cells.vel[index] - barrierVel;
+                auto dot_vr_r = CpuMath::dot(vr, r);
+                if (dot_vr_r < 0) {
+                    auto truncated_r_squared = std::max(0.05f, CpuMath::lengthSquared(r));
+                    auto truncated_distance = std::max(0.05f, closestBarrierCellDistance);
+                    force += (vr - r * 2 * dot_vr_r / truncated_r_squared + barrierVel - cells.vel[index]) / truncated_distance;
+                }
+            }
+
+            posDeltas[index] = cellPosDelta;
+            force += F_pressure * fluidMotion.pressureStrength + F_viscosity * fluidMotion.viscosityStrength;
+            densities[index] = density;
+        }
+    });
+
+    threadPool.parallelFor(cells.size(), [&](size_t startIndex, size_t endIndex) {
+        for (auto index = startIndex; index < endIndex; ++index) {
+            cells.pos[index] += posDeltas[index];
+            cells.density[index] = densities[index];
+        }
+    });
+    operations.addConnectionPairs.insert(operations.addConnectionPairs.end(), fusionPairs.begin(), fusionPairs.end());
+}
+
+void CpuCellProcessor::calcCollisionForces(
+    CpuSimulationData& data,
+    SimulationParameters const& parameters,
+    ThreadPool& threadPool,
+    CpuStructuralOperations& operations)
+{
+    auto& cells = data.cells;
+    auto const& collisionMotion = parameters.motionData.collisionMotion;
+    std::vector<RealVector2D> posDeltas(cells.size());
+
+    auto fusionPairs = threadPool.parallelCollect<std::pair<int, int>>(cells.size(), [&](size_t startIndex, size_t endIndex, std::vector<std::pair<int, int>>& result) {
+        for (auto index = toInt(startIndex); index < toInt(endIndex); ++index) {
+            RealVector2D cellPosDelta{0, 0};
+            data.cellMap.executeForEach(cells.pos[index], collisionMotion.cellMaxCollisionDistance, [&](int otherIndex) {
+                if (otherIndex == index) {
+                    return;
+                }
+                auto posDelta = data.cellMap.getCorrectedDirection(cells.pos[index] - cells.pos[otherIndex]);
+                auto distance = Math::length(posDelta);
+                if (distance > collisionMotion.cellMaxCollisionDistance || cells.detached[index] + cells.detached[otherIndex] == 1) {
+                    return;
+                }
+
+                //overlap correction
+                if (!cells.barrier[index] && distance < parameters.cellMinDistance) {
+                    cellPosDelta += posDelta * parameters.cellMinDistance / 5;
+                }
+
+                if (CpuCellConnectionProcessor::isConnected(data, index, otherIndex)) {
+                    return;
+                }
+
+                //the kernel code applies the force of a pair to both cells, here both directions are evaluated by each cell
+                cells.force[index] += calcCollisionForce(data, parameters, index, otherIndex) - calcCollisionForce(data, parameters, otherIndex, index);
+
+                //fusion
+                auto velDelta = cells.vel[index] - cells.vel[otherIndex];
+                auto isApproaching = CpuMath::dot(posDelta, velDelta) < 0;
+                auto cellMaxBindingEnergy = CpuSpotCalculator::calcParameter(
+                    &SimulationParametersZoneValues::cellMaxBindingEnergy,
+                    &SimulationParametersZoneActivatedValues::cellMaxBindingEnergy,
+                    parameters,
+                    data.cellMap,
+                    cells.pos[index]);
+                auto cellFusionVelocity = CpuSpotCalculator::calcParameter(
+                    &SimulationParametersZoneValues::cellFusionVelocity,
+                    &SimulationParametersZoneActivatedValues::cellFusionVelocity,
+                    parameters,
+                    data.cellMap,
+                    cells.pos[index]);
+                if (Math::length(velDelta) >= cellFusionVelocity && isApproaching && isFusionPossible(cells, index, otherIndex, cellMaxBindingEnergy)) {
+                    result.emplace_back(index, otherIndex);
+                }
+            });
+            posDeltas[index] = cellPosDelta;
+        }
+    });
+
+    threadPool.parallelFor(cells.size(), [&](size_t startIndex, size_t endIndex) {
+        for (auto index = startIndex; index < endIndex; ++index) {
+            cells.pos[index] += posDeltas[index];
+        }
+    });
+    operations.addConnectionPairs.insert(operations.addConnectionPairs.end(), fusionPairs.begin(), fusionPairs.end());
+}
+
+void CpuCellProcessor::checkForces(CpuSimulationData& data, SimulationParameters const& parameters, ThreadPool& threadPool, CpuStructuralOperations& operations)
+{
+    auto& cells = data.cells;
+    auto cellIndices = threadPool.parallelCollect<int>(cells.size(), [&](size_t startIndex, size_t endIndex, std::vector<int>& result) {
+        for (auto index = startIndex; index < endIndex; ++index) {
+            if (cells.barrier[index]) {
+                continue;
+            }
+            auto cellMaxForce = CpuSpotCalculator::calcParameter(
+                &SimulationParametersZoneValues::cellMaxForce,
+                &SimulationParametersZoneActivatedValues::cellMaxForce,
+                parameters,
+                data.cellMap,
+                cells.pos[index],
+                cells.color[index]);
+            if (Math::length(cells.force[index]) > cellMaxForce) {
+                CpuRandom random(data.timestep, cells.id[index], CpuRandomStream_CellMaxForce);
+                if (random.random() < parameters.cellMaxForceDecayProb) {
+                    result.emplace_back(toInt(index));
+                }
+            }
+        }
+    });
+    operations.deleteAllConnections.insert(operations.deleteAllConnections.end(), cellIndices.begin(), cellIndices.end());
+}
+
+void CpuCellProcessor::applyForces(CpuSimulationData& data, SimulationParameters const& parameters, ThreadPool& threadPool)
+{
+    auto& cells = data.cells;
+    threadPool.parallelFor(cells.size(), [&](size_t startIndex, size_t endIndex) {
+        for (auto index = startIndex; index < endIndex; ++index) {
+            if (cells.barrier[index]) {
+                continue;
+            }
+            auto& vel = cells.vel[index];
+            vel += cells.force[index];
+            if (Math::length(vel) > parameters.cellMaxVelocity) {
+                vel = CpuMath::normalized(vel) * parameters.cellMaxVelocity;
+            }
+            cells.force[index] = {0, 0};
+        }
+    });
+}
+
+void CpuCellProcessor::calcConnectionForces(CpuSimulationData& data, SimulationParameters const& parameters, ThreadPool& threadPool, bool considerAngles)
+{
+    auto& cells = data.cells;
+
+    //first phase: each cell calculates its own force and the angle forces it exerts on its neighbors (stored per connection slot)
+    //second phase: each cell gathers the angle forces exerted by its neighbors
+    std::vector<RealVector2D> ownForces(cells.size());
+    std::vector<std::array<RealVector2D, MAX_CELL_BONDS>> forcesOnConnectedCell;
+    std::vector<std::array<RealVector2D, MAX_CELL_BONDS>> forcesOnPrevConnectedCell;
+    if (considerAngles) {
+        forcesOnConnectedCell.resize(cells.size());
+        forcesOnPrevConnectedCell.resize(cells.size());
+    }
+
+    threadPool.parallelFor(cells.size(), [&](size_t startIndex, size_t endIndex) {
+        for (auto index = startIndex; index < endIndex; ++index) {
+            if (considerAngles) {
+                forcesOnConnectedCell[index].fill({0, 0});
+                forcesOnPrevConnectedCell[index].fill({0, 0});
+            }
+            auto numConnections = cells.numConnections[index];
+            if (0 == numConnections || cells.barrier[index]) {
+                continue;
+            }
+            auto const& connections = cells.connections[index];
+            RealVector2D force{0, 0};
+            auto prevDisplacement = data.cellMap.getCorrectedDirection(cells.pos[connections[numConnections - 1].cellIndex] - cells.pos[index]);
+            auto cellStiffnessSquared = cells.stiffness[index] * cells.stiffness[index];
+
+            for (int i = 0; i < numConnections; ++i) {
+                auto connectedCellIndex = connections[i].cellIndex;
+                auto connectedCellStiffnessSquared = cells.stiffness[connectedCellIndex] * cells.stiffness[connectedCellIndex];
+
+                auto displacement = data.cellMap.getCorrectedDirection(cells.pos[connectedCellIndex] - cells.pos[index]);
+                auto actualDistance = Math::length(displacement);
+                auto deviation = actualDistance - connections[i].distance;
+                force += CpuMath::normalized(displacement) * deviation * (cellStiffnessSquared + connectedCellStiffnessSquared) / 6;
+
+                if (considerAngles && (numConnections > 2 || (numConnections == 2 && i == 0))) {
+                    auto lastIndex = (i + numConnections - 1) % numConnections;
+                    auto lastConnectedCellIndex = connections[lastIndex].cellIndex;
+
+                    //angle forces in case of no triangular connections
+                    if (!CpuCellConnectionProcessor::isConnected(data, connectedCellIndex, lastConnectedCellIndex)) {
+                        auto angle = Math::angleOfVector(displacement);
+                        auto prevAngle = Math::angleOfVector(prevDisplacement);
+                        auto actualAngleFromPrevious = Math::subtractAngle(angle, prevAngle);
+                        if (actualAngleFromPrevious < 0) {
+                            continue;
+                        }
+                        auto referenceAngleFromPrevious = connections[i].angleFromPrevious;
+                        auto strength = std::abs(referenceAngleFromPrevious - actualAngleFromPrevious) / 2000 * cellStiffnessSquared;
+
+                        auto force1 = CpuMath::rotateQuarterClockwise(
+                            CpuMath::normalized(displacement) / std::max(Math::length(displacement), parameters.cellMinDistance) * strength);
+                        auto force2 = CpuMath::rotateQuarterCounterClockwise(
+                            CpuMath::normalized(prevDisplacement) / std::max(Math::length(prevDisplacement), parameters.cellMinDistance) * strength);
+                        if (referenceAngleFromPrevious < actualAngleFromPrevious) {
+                            force1 = force1 * (-1.0f);
+                            force2 = force2 * (-1.0f);
+                        }
+                        forcesOnConnectedCell[index][i] = force1;
+                        forcesOnPrevConnectedCell[index][i] = force2;
+                        force -= force1 + force2;
+                    }
+                }
+                prevDisplacement = displacement;
+            }
+            ownForces[index] = force;
+        }
+    });
+
+    threadPool.parallelFor(cells.size(), [&](size_t startIndex, size_t endIndex) {
+        for (auto index = startIndex; index < endIndex; ++index) {
+            if (cells.barrier[index]) {
+                continue;
+            }
+            auto force = ownForces[index];
+            if (considerAngles) {
+                for (int i = 0; i < cells.numConnections[index]; ++i) {
+                    auto connectedCellIndex = cells.connections[index][i].cellIndex;
+                    auto numOtherConnections = cells.numConnections[connectedCellIndex];
+                    auto const& otherConnections = cells.connections[connectedCellIndex];
+                    for (int j = 0; j < numOtherConnections; ++j) {
+                        if (otherConnections[j].cellIndex == toInt(index)) {
+                            force += forcesOnConnectedCell[connectedCellIndex][j];
+                            force += forcesOnPrevConnectedCell[connectedCellIndex][(j + 1) % numOtherConnections];
+                        }
+                    }
+                }
+            }
+            cells.force[index] += force;
+        }
+    });
+}
+
+void CpuCellProcessor::checkConnections(CpuSimulationData& data, SimulationParameters const& parameters, ThreadPool& threadPool, CpuStructuralOperations& operations)
+{
+    auto& cells = data.cells;
+    auto cellIndices = threadPool.parallelCollect<int>(cells.size(), [&](size_t startIndex, size_t endIndex, std::vector<int>& result) {
+        for (auto index = startIndex; index < endIndex; ++index) {
+            if (cells.barrier[index]) {
+                continue;
+            }
+            for (int i = 0; i < cells.numConnections[index]; ++i) {
+                auto actualDistance = data.cellMap.getDistance(cells.pos[cells.connections[index][i].cellIndex], cells.pos[index]);
+                if (actualDistance > parameters.cellMaxBindingDistance[cells.color[index]]) {
+                    result.emplace_back(toInt(index));
+                    break;
+                }
+            }
+        }
+    });
+
+    for (auto const& cellIndex : cellIndices) {
+        operations.deleteAllConnections.emplace_back(cellIndex);
+        for (int i = 0; i < cells.numConnections[cellIndex]; ++i) {
+            cells.livingState[cells.connections[cellIndex][i].cellIndex] = LivingState_Detaching;
+        }
+    }
+}
+
+void CpuCellProcessor::verletPositionUpdate(CpuSimulationData& data, SimulationParameters const& parameters, ThreadPool& threadPool)
+{
+    auto& cells = data.cells;
+    auto const& timestepSize = parameters.timestepSize;
+    threadPool.parallelFor(cells.size(), [&](size_t startIndex, size_t endIndex) {
+        for (auto index = startIndex; index < endIndex; ++index) {
+            auto& pos = cells.pos[index];
+            if (cells.barrier[index]) {
+                pos += cells.vel[index] * timestepSize;
+            } else {
+                pos += cells.vel[index] * timestepSize + cells.force[index] * timestepSize * timestepSize / 2;
+                cells.prevForce[index] = cells.force[index];
+                cells.force[index] = {0, 0};
+            }
+            data.cellMap.correctPosition(pos);
+        }
+    });
+}
+
+void CpuCellProcessor::verletVelocityUpdate(CpuSimulationData& data, SimulationParameters const& parameters, ThreadPool& threadPool)
+{
+    auto& cells = data.cells;
+    threadPool.parallelFor(cells.size(), [&](size_t startIndex, size_t endIndex) {
+        for (auto index = startIndex; index < endIndex; ++index) {
+            if (cells.barrier[index]) {
+                continue;
+            }
+            auto acceleration = (cells.force[index] + cells.prevForce[index]) / 2;
+            cells.vel[index] += acceleration * parameters.timestepSize;
+        }
+    });
+}
+
+void CpuCellProcessor::aging(CpuSimulationData& data, SimulationParameters const& parameters, ThreadPool& threadPool)
+{
+    auto& cells = data.cells;
+    threadPool.parallelFor(cells.size(), [&](size_t startIndex, size_t endIndex) {
+        for (auto index = startIndex; index < endIndex; ++index) {
+            if (cells.barrier[index]) {
+                continue;
+            }
+            ++cells.age[index];
+
+            if (parameters.features.cellColorTransitionRules) {
+                auto color = cells.color[index] % MAX_COLORS;
+                auto spotIndex = CpuSpotCalculator::getFirstMatchingSpotOrBase(
+                    parameters, data.cellMap, cells.pos[index], &SimulationParametersZoneActivatedValues::cellColorTransition);
+                auto const& values = spotIndex == -1 ? parameters.baseValues : parameters.zone[spotIndex].values;
+                auto transitionDuration = values.cellColorTransitionDuration[color];
+                auto targetColor = values.cellColorTransitionTargetColor[color];
+                if (transitionDuration > 0 && cells.age[index] > static_cast<uint32_t>(transitionDuration)) {
+                    cells.color[index] = static_cast<uint8_t>(targetColor);
+                    cells.age[index] = 0;
+                }
+            }
+            auto& properties = cells.properties[index];
+            if (cells.livingState[index] == LivingState_Ready && properties.activationTime > 0) {
+                --properties.activationTime;
+            }
+        }
+    });
+}
+
+void CpuCellProcessor::livingStateTransition(CpuSimulationData& data, SimulationParameters const& parameters, ThreadPool& threadPool)
+{
+    auto& cells = data.cells;
+    std::vector<LivingState> nextLivingStates(cells.size());
+
+    threadPool.parallelFor(cells.size(), [&](size_t startIndex, size_t endIndex) {
+        for (auto index = startIndex; index < endIndex; ++index) {
+            bool isSameCreatureNeighborDetaching = false;
+            bool isOtherCreatureNeighborDetaching = false;
+            bool isSameCreatureNeighborReviving = false;
+            bool isNeighborActivating = false;
+            for (int i = 0; i < cells.numConnections[index]; ++i) {
+                auto connectedCellIndex = cells.connections[index][i].cellIndex;
+                auto connectedLivingState = cells.livingState[connectedCellIndex];
+                if (cells.properties[connectedCellIndex].creatureId == cells.properties[index].creatureId) {
+                    if (connectedLivingState == LivingState_Detaching) {
+                        isSameCreatureNeighborDetaching = true;
+                    } else if (connectedLivingState == LivingState_Reviving) {
+                        isSameCreatureNeighborReviving = true;
+                    } else if (connectedLivingState == LivingState_Activating) {
+                        isNeighborActivating = true;
+                    }
+                } else if (connectedLivingState == LivingState_Detaching) {
+                    isOtherCreatureNeighborDetaching = true;
+                }
+            }
+
+            auto origLivingState = cells.livingState[index];
+            auto livingState = origLivingState;
+            if (cells.barrier[index]) {
+                livingState = LivingState_Ready;
+            } else if (origLivingState == LivingState_Activating) {
+                livingState = LivingState_Ready;
+                if (parameters.features.cellAgeLimiter && parameters.cellResetAgeAfterActivation) {
+                    cells.age[index] = 0;
+                }
+            } else if (origLivingState == LivingState_Reviving) {
+                livingState = LivingState_Ready;
+            } else if (origLivingState == LivingState_UnderConstruction) {
+                if (isNeighborActivating) {
+                    livingState = LivingState_Activating;
+                }
+                if (isOtherCreatureNeighborDetaching && parameters.cellDeathConsequences != CellDeathConsquences_None) {
+                    livingState = LivingState_Detaching;
+                }
+            } else if (origLivingState == LivingState_Detaching) {
+                if (isSameCreatureNeighborReviving && parameters.cellDeathConsequences == CellDeathConsquences_DetachedPartsDie) {
+                    livingState = LivingState_Reviving;
+                }
+                if (parameters.cellDeathConsequences == CellDeathConsquences_None) {
+                    livingState = LivingState_Ready;
+                }
+            } else if (origLivingState == LivingState_Ready) {
+                if (isSameCreatureNeighborDetaching && parameters.cellDeathConsequences != CellDeathConsquences_None) {
+                    if (parameters.cellDeathConsequences == CellDeathConsquences_DetachedPartsDie
+                        && cells.properties[index].cellFunction == CellFunction_Constructor
+                        && containsSelfReplication(
+                            data, cells.properties[index].cellFunctionData.constructor.genomeDataIndex, cells.properties[index].cellFunctionData.constructor.genomeSize)) {
+                        livingState = LivingState_Reviving;
+                    } else {
+                        livingState = LivingState_Detaching;
+                    }
+                }
+            }
+            nextLivingStates[index] = livingState;
+        }
+    });
+
+    cells.livingState = std::move(nextLivingStates);
+}
+
+void CpuCellProcessor::applyInnerFriction(CpuSimulationData& data, SimulationParameters const& parameters, ThreadPool& threadPool)
+{
+    auto& cells = data.cells;
+    auto const innerFriction = parameters.innerFriction;
+
+    //the kernel code averages the velocities pairwise under locks, here the velocities of the previous state are averaged (Jacobi-style)
+    std::vector<RealVector2D> newVelocities(cells.size());
+    threadPool.parallelFor(cells.size(), [&](size_t startIndex, size_t endIndex) {
+        for (auto index = startIndex; index < endIndex; ++index) {
+            auto vel = cells.vel[index];
+            if (!cells.barrier[index]) {
+                for (int i = 0; i < cells.numConnections[index]; ++i) {
+                    auto connectedCellIndex = cells.connections[index][i].cellIndex;
+                    if (cells.barrier[connectedCellIndex]) {
+                        continue;
+                    }
+                    auto averageVel = (cells.vel[index] + cells.vel[connectedCellIndex]) / 2;
+                    vel += (averageVel - cells.vel[index]) * innerFriction;
+                }
+            }
+            newVelocities[index] = vel;
+        }
+    });
+    cells.vel = std::move(newVelocities);
+}
+
+void CpuCellProcessor::applyFriction(CpuSimulationData& data, SimulationParameters const& parameters, ThreadPool& threadPool)
+{
+    auto& cells = data.cells;
+    threadPool.parallelFor(cells.size(), [&](size_t startIndex, size_t endIndex) {
+        for (auto index = startIndex; index < endIndex; ++index) {
+            if (cells.barrier[index]) {
+                continue;
+            }
+            auto friction = CpuSpotCalculator::calcParameter(
+                &SimulationParametersZoneValues::friction, &SimulationParametersZoneActivatedValues::friction, parameters, data.cellMap, cells.pos[index]);
+            cells.vel[index] = cells.vel[index] * (1.0f - friction);
+        }
+    });
+}
+
+void CpuCellProcessor::decay(CpuSimulationData& data, SimulationParameters const& parameters, ThreadPool& threadPool, CpuStructuralOperations& operations)
+{
+    auto& cells = data.cells;
+    auto decayOperations = threadPool.parallelCollect<DecayOperation>(cells.size(), [&](size_t startIndex, size_t endIndex, std::vector<DecayOperation>& result) {
+        for (auto index = toInt(startIndex); index < toInt(endIndex); ++index) {
+            if (cells.barrier[index]) {
+                continue;
+            }
+            auto const& pos = cells.pos[index];
+            auto color = cells.color[index];
+            auto const& properties = cells.properties[index];
+
+            auto cellMaxBindingEnergy = CpuSpotCalculator::calcParameter(
+                &SimulationParametersZoneValues::cellMaxBindingEnergy,
+                &SimulationParametersZoneActivatedValues::cellMaxBindingEnergy,
+                parameters,
+                data.cellMap,
+                pos);
+            if (cells.energy[index] > cellMaxBindingEnergy) {
+                result.emplace_back(DecayOperation{index, DecayOperationType_DeleteAllConnections});
+            }
+
+            if (cells.livingState[index] == LivingState_Dying || cells.livingState[index] == LivingState_Detaching) {
+                auto cellDeathProbability = CpuSpotCalculator::calcParameter(
+                    &SimulationParametersZoneValues::cellDeathProbability,
+                    &SimulationParametersZoneActivatedValues::cellDeathProbability,
+                    parameters,
+                    data.cellMap,
+                    pos,
+                    color);
+                CpuRandom random(data.timestep, cells.id[index], CpuRandomStream_CellDecay);
+                if (random.random() < cellDeathProbability) {
+                    result.emplace_back(DecayOperation{index, DecayOperationType_DeleteCell});
+                }
+            }
+
+            auto cellMinEnergy = CpuSpotCalculator::calcParameter(
+                &SimulationParametersZoneValues::cellMinEnergy, &SimulationParametersZoneActivatedValues::cellMinEnergy, parameters, data.cellMap, pos, color);
+            bool cellDestruction = cells.energy[index] < cellMinEnergy;
+
+            auto cellMaxAge = parameters.cellMaxAge[color];
+            if (parameters.features.cellAgeLimiter && parameters.cellInactiveMaxAgeActivated && properties.mutationId != Const::MutationIdForFreeCell
+                && properties.cellFunctionUsed == CellFunctionUsed_No && cells.livingState[index] == LivingState_Ready && properties.activationTime == 0) {
+                bool adjacentCellsUsed = false;
+                for (int i = 0; i < cells.numConnections[index]; ++i) {
+                    if (cells.properties[cells.connections[index][i].cellIndex].cellFunctionUsed == CellFunctionUsed_Yes) {
+                        adjacentCellsUsed = true;
+                        break;
+                    }
+                }
+                if (!adjacentCellsUsed) {
+                    auto cellInactiveMaxAge = CpuSpotCalculator::calcParameter(
+                        &SimulationParametersZoneValues::cellInactiveMaxAge,
+                        &SimulationParametersZoneActivatedValues::cellInactiveMaxAge,
+                        parameters,
+                        data.cellMap,
+                        pos,
+                        color);
+                    cellMaxAge = toInt(cellInactiveMaxAge);
+                }
+            }
+            if (parameters.features.cellAgeLimiter && parameters.cellEmergentMaxAgeActivated && properties.mutationId == Const::MutationIdForFreeCell) {
+                cellMaxAge = parameters.cellEmergentMaxAge[color];
+            }
+            if (cellMaxAge > 0 && cells.age[index] > static_cast<uint32_t>(cellMaxAge)) {
+                cellDestruction = true;
+            }
+            if (cellDestruction) {
+                result.emplace_back(DecayOperation{index, DecayOperationType_Destruction});
+            }
+        }
+    });
+
+    for (auto const& [cellIndex, type] : decayOperations) {
+        if (type == DecayOperationType_DeleteAllConnections) {
+            operations.deleteAllConnections.emplace_back(cellIndex);
+        } else if (type == DecayOperationType_DeleteCell) {
+            operations.deleteCells.emplace_back(cellIndex);
+        } else if (cells.livingState[cellIndex] != LivingState_Dying) {
+            cells.livingState[cellIndex] = LivingState_Dying;
+            for (int i = 0; i < cells.numConnections[cellIndex]; ++i) {
+                auto& connectedLivingState = cells.livingState[cells.connections[cellIndex][i].cellIndex];
+                if (connectedLivingState != LivingState_Dying) {
+                    connectedLivingState = LivingState_Detaching;
+                }
+            }
+        }
+    }
+}
+
+void CpuCellProcessor::resetDensity(CpuSimulationData& data)
+{
+    std::fill(data.cells.density.begin(), data.cells.density.end(), 1.0f);
+}
+
+RealVector2D CpuCellProcessor::calcCollisionForce(CpuSimulationData const& data, SimulationParameters const& parameters, int cellIndex, int otherCellIndex)
+{
+    auto const& cells = data.cells;
+    auto const& collisionMotion = parameters.motionData.collisionMotion;
+    auto posDelta = data.cellMap.getCorrectedDirection(cells.pos[cellIndex] - cells.pos[otherCellIndex]);
+    auto distance = Math::length(posDelta);
+    auto velDelta = cells.vel[cellIndex] - cells.vel[otherCellIndex];
+    auto isApproaching = CpuMath::dot(posDelta, velDelta) < 0;
+    auto barrierFactor = cells.barrier[cellIndex] ? 2.0f : 1.0f;
+
+    if (Math::length(cells.vel[cellIndex]) > 0.5f && isApproaching) {
+        auto distanceSquared = distance * distance + 0.25f;
+        return posDelta * CpuMath::dot(velDelta, posDelta) / (-2 * distanceSquared) * barrierFactor;
+    } else {
+        return CpuMath::normalized(posDelta) * (collisionMotion.cellMaxCollisionDistance - distance) * collisionMotion.cellRepulsionStrength * barrierFactor;
+    }
+}
+
+bool CpuCellProcessor::containsSelfReplication(CpuSimulationData const& data, uint64_t genomeDataIndex, uint16_t genomeSize)
+{
+    if (genomeDataIndex + genomeSize > data.auxiliaryData.size()) {
+        return false;
+    }
+    return GenomeAnalysis::containsSelfReplication(data.auxiliaryData.data() + genomeDataIndex, genomeSize);
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "EngineInterface/SimulationParameters.h"
+
+#include "CpuCellConnectionProcessor.h"
+#include "CpuSimulationData.h"
+#include "Definitions.h"
+
+/**
+ * Host counterpart of the CellProcessor in the kernel code.
+ * Each pass only writes to the entries of the cell being processed. Contributions to other cells are computed from both sides
+ * of an interaction or collected and applied sequentially afterwards, which keeps the results independent of the thread count.
+ */
+class CpuCellProcessor
+{
+public:
+    static void radiation(CpuSimulationData& data, SimulationParameters const& parameters, ThreadPool& threadPool);
+
+    static void calcFluidForces(CpuSimulationData& data, SimulationParameters const& parameters, ThreadPool& threadPool, CpuStructuralOperations& operations);
+    static void calcCollisionForces(
+        CpuSimulationData& data,
+        SimulationParameters const& parameters,
+        ThreadPool& threadPool,
+        CpuStructuralOperations& operations);
+    static void checkForces(CpuSimulationData& data, SimulationParameters const& parameters, ThreadPool& threadPool, CpuStructuralOperations& operations);
+    static void applyForces(CpuSimulationData& data, SimulationParameters const& parameters, ThreadPool& threadPool);
+
+    static void calcConnectionForces(CpuSimulationData& data, SimulationParameters const& parameters, ThreadPool& threadPool, bool considerAngles);
+    static void checkConnections(CpuSimulationData& data, SimulationParameters const& parameters, ThreadPool& threadPool, CpuStructuralOperations& operations);
+    static void verletPositionUpdate(CpuSimulationData& data, SimulationParameters const& parameters, ThreadPool& threadPool);
+    static void verletVelocityUpdate(CpuSimulationData& data, SimulationParameters const& parameters, ThreadPool& threadPool);
+
+    static void aging(CpuSimulationData& data, SimulationParameters const& parameters, ThreadPool& threadPool);
+    static void livingStateTransition(CpuSimulationData& data, SimulationParameters const& parameters, ThreadPool& threadPool);
+
+    static void applyInnerFriction(CpuSimulationData& data, SimulationParameters const& parameters, ThreadPool& threadPool);
+    static void applyFriction(CpuSimulationData& data, SimulationParameters const& parameters, ThreadPool& threadPool);
+    static void decay(CpuSimulationData& data, SimulationParameters const& parameters, ThreadPool& threadPool, CpuStructuralOperations& operations);
+
+    static void resetDensity(CpuSimulationData& data);
+
+    static bool containsSelfReplication(CpuSimulationData const& data, uint64_t genomeDataIndex, uint16_t genomeSize);
+
+private:
+    static RealVector2D calcCollisionForce(CpuSimulationData const& data, SimulationParameters const& parameters, int cellIndex, int otherCellIndex);
+};
@@ -0,0 +1,306 @@
+#include "CpuDataAccessProcessor.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "EngineInterface/InspectedEntityIds.h"
+
+#include "CpuMath.h"
+
+namespace
+{
+    auto constexpr NeuronStateSize = sizeof(float) * MAX_CHANNELS * (MAX_CHANNELS + 1);
+
+    //calls func(size, dataIndex) for all sections of the auxiliary data referenced by the cell
+    template <typename Func>
+    void forEachAuxiliaryDataSection(CellTO& cellTO, Func const& func)
+    {
+        func(cellTO.metadata.nameSize, cellTO.metadata.nameDataIndex);
+        func(cellTO.metadata.descriptionSize, cellTO.metadata.descriptionDataIndex);
+        switch (cellTO.cellFunction) {
+        case CellFunction_Neuron:
+            func(NeuronStateSize, cellTO.cellFunctionData.neuron.weightsAndBiasesDataIndex);
+            break;
+        case CellFunction_Constructor:
+            func(cellTO.cellFunctionData.constructor.genomeSize, cellTO.cellFunctionData.constructor.genomeDataIndex);
+            break;
+        case CellFunction_Injector:
+            func(cellTO.cellFunctionData.injector.genomeSize, cellTO.cellFunctionData.injector.genomeDataIndex);
+            break;
+        }
+    }
+
+    bool isContainedInRect(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight, RealVector2D const& pos)
+    {
+        return pos.x >= rectUpperLeft.x && pos.x <= rectLowerRight.x && pos.y >= rectUpperLeft.y && pos.y <= rectLowerRight.y;
+    }
+
+    bool isContainedInRectModulo(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight, RealVector2D const& pos, IntVector2D const& worldSize)
+    {
+        return CpuMath::isInBetweenModulo(toFloat(rectUpperLeft.x), toFloat(rectLowerRight.x), pos.x, toFloat(worldSize.x))
+            && CpuMath::isInBetweenModulo(toFloat(rectUpperLeft.y), toFloat(rectLowerRight.y), pos.y, toFloat(worldSize.y));
+    }
+}
+
+void CpuDataAccessProcessor::getData(CpuSimulationData const& data, IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight, DataTO const& dataTO)
+{
+    getFilteredData(
+        data,
+        [&](int index) { return isContainedInRect(rectUpperLeft, rectLowerRight, data.cellMap.getCorrectedPosition(data.cells.pos[index])); },
+        [&](int index) { return isContainedInRect(rectUpperLeft, rectLowerRight, data.cellMap.getCorrectedPosition(data.particles.pos[index])); },
+        dataTO);
+}
+
+void CpuDataAccessProcessor::getSelectedData(CpuSimulationData const& data, bool includeClusters, DataTO const& dataTO)
+{
+    getFilteredData(
+        data,
+        [&](int index) { return includeClusters ? data.cells.selected[index] != 0 : data.cells.selected[index] == 1; },
+        [&](int index) { return data.particles.selected[index] != 0; },
+        dataTO);
+}
+
+void CpuDataAccessProcessor::getInspectedData(CpuSimulationData const& data, std::vector<uint64_t> const& entityIds, DataTO const& dataTO)
+{
+    if (entityIds.size() > Const::MaxInspectedObjects) {
+        *dataTO.numCells = 0;
+        *dataTO.numParticles = 0;
+        *dataTO.numAuxiliaryData = 0;
+        return;
+    }
+    auto isInspected = [&](uint64_t id) { return std::find(entityIds.begin(), entityIds.end(), id) != entityIds.end(); };
+    getFilteredData(
+        data, [&](int index) { return isInspected(data.cells.id[index]); }, [&](int index) { return isInspected(data.particles.id[index]); }, dataTO);
+}
+
+void CpuDataAccessProcessor::getOverlayData(CpuSimulationData const& data, IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight, DataTO const& dataTO)
+{
+    auto const& cells = data.cells;
+    auto const& particles = data.particles;
+    auto worldSize = data.cellMap.getWorldSize();
+
+    *dataTO.numCells = 0;
+    *dataTO.numParticles = 0;
+    for (size_t index = 0; index < cells.size(); ++index) {
+        if (!isContainedInRectModulo(rectUpperLeft, rectLowerRight, cells.pos[index], worldSize)) {
+            continue;
+        }
+        auto& cellTO = dataTO.cells[(*dataTO.numCells)++];
+        cellTO.id = cells.id[index];
+        cellTO.pos = {cells.pos[index].x, cells.pos[index].y};
+        cellTO.cellFunction = cells.properties[index].cellFunction;
+        cellTO.selected = cells.selected[index];
+        cellTO.executionOrderNumber = cells.properties[index].executionOrderNumber;
+    }
+    for (size_t index = 0; index < particles.size(); ++index) {
+        if (!isContainedInRectModulo(rectUpperLeft, rectLowerRight, particles.pos[index], worldSize)) {
+            continue;
+        }
+        auto& particleTO = dataTO.particles[(*dataTO.numParticles)++];
+        particleTO.id = particles.id[index];
+        particleTO.pos = {particles.pos[index].x, particles.pos[index].y};
+        particleTO.selected = particles.selected[index];
+    }
+}
+
+void CpuDataAccessProcessor::addData(CpuSimulationData& data, DataTO const& dataTO, bool selectData, bool createIds)
+{
+    adaptMaxIds(data, dataTO);
+
+    auto& particles = data.particles;
+    auto particleOffset = particles.size();
+    particles.resize(particleOffset + *dataTO.numParticles);
+    for (uint64_t i = 0; i < *dataTO.numParticles; ++i) {
+        auto const& particleTO = dataTO.particles[i];
+        auto index = particleOffset + i;
+        particles.id[index] = createIds ? data.createId() : particleTO.id;
+        particles.pos[index] = data.cellMap.getCorrectedPosition({particleTO.pos.x, particleTO.pos.y});
+        particles.vel[index] = {particleTO.vel.x, particleTO.vel.y};
+        particles.energy[index] = particleTO.energy;
+        particles.color[index] = particleTO.color;
+        particles.selected[index] = selectData ? 1 : 0;
+        particles.lastAbsorbedCellId[index] = 0;
+    }
+
+    auto& cells = data.cells;
+    auto cellOffset = toInt(cells.size());
+    cells.resize(cellOffset + *dataTO.numCells);
+    for (uint64_t i = 0; i < *dataTO.numCells; ++i) {
+        auto const& cellTO = dataTO.cells[i];
+        auto index = cellOffset + toInt(i);
+        setCellFromTO(data, index, cellTO, dataTO);
+        cells.id[index] = createIds ? data.createId() : cellTO.id;
+        if (createIds && cellTO.cellFunction == CellFunction_Constructor) {
+            cells.properties[index].cellFunctionData.constructor.lastConstructedCellId = 0;
+        }
+        cells.numConnections[index] = cellTO.numConnections;
+        for (int j = 0; j < cellTO.numConnections; ++j) {
+            auto const& connectionTO = cellTO.connections[j];
+            cells.connections[index][j] = CpuConnection{cellOffset + connectionTO.cellIndex, connectionTO.distance, connectionTO.angleFromPrevious};
+        }
+        cells.force[index] = {0, 0};
+        cells.prevForce[index] = {0, 0};
+        cells.density[index] = 1.0f;
+        cells.detached[index] = 0;
+        cells.selected[index] = selectData ? 1 : 0;
+    }
+
+    adaptMaxIds(data, dataTO);
+}
+
+void CpuDataAccessProcessor::changeData(CpuSimulationData& data, DataTO const& changeDataTO)
+{
+    if (*changeDataTO.numCells == 1) {
+        auto const& cellTO = changeDataTO.cells[0];
+        auto const& ids = data.cells.id;
+        auto iter = std::find(ids.begin(), ids.end(), cellTO.id);
+        if (iter != ids.end()) {
+            setCellFromTO(data, toInt(iter - ids.begin()), cellTO, changeDataTO);
+        }
+    }
+    if (*changeDataTO.numParticles == 1) {
+        auto const& particleTO = changeDataTO.particles[0];
+        auto& particles = data.particles;
+        auto iter = std::find(particles.id.begin(), particles.id.end(), particleTO.id);
+        if (iter != particles.id.end()) {
+            auto index = iter - particles.id.begin();
+            particles.energy[index] = particleTO.energy;
+            particles.pos[index] = {particleTO.pos.x, particleTO.pos.y};
+            particles.color[index] = particleTO.color;
+        }
+    }
+}
+
+void CpuDataAccessProcessor::clearData(CpuSimulationData& data)
+{
+    data.cells.resize(0);
+    data.particles.resize(0);
+    data.auxiliaryData.clear();
+}
+
+template <typename CellFilter, typename ParticleFilter>
+void CpuDataAccessProcessor::getFilteredData(CpuSimulationData const& data, CellFilter const& cellFilter, ParticleFilter const& particleFilter, DataTO const& dataTO)
+{
+    *dataTO.numCells = 0;
+    *dataTO.numParticles = 0;
+    *dataTO.numAuxiliaryData = 0;
+
+    //connections are stored as indices into the cell array and need to be mapped to the indices of the transfer objects
+    std::vector<int> cellTOIndices(data.cells.size(), -1);
+    for (int index = 0; index < toInt(data.cells.size()); ++index) {
+        if (cellFilter(index)) {
+            cellTOIndices[index] = toInt(*dataTO.numCells);
+            createCellTO(data, index, dataTO);
+        }
+    }
+    for (uint64_t i = 0; i < *dataTO.numCells; ++i) {
+        auto& cellTO = dataTO.cells[i];
+        for (int j = 0; j < cellTO.numConnections; ++j) {
+            cellTO.connections[j].cellIndex = cellTOIndices[cellTO.connections[j].cellIndex];
+        }
+    }
+
+    for (int index = 0; index < toInt(data.particles.size()); ++index) {
+        if (particleFilter(index)) {
+            createParticleTO(data, index, dataTO);
+        }
+    }
+}
+
+void CpuDataAccessProcessor::createCellTO(CpuSimulationData const& data, int cellIndex, DataTO const& dataTO)
+{
+    auto const& cells = data.cells;
+    auto& cellTO = dataTO.cells[(*dataTO.numCells)++];
+
+    cellTO = cells.properties[cellIndex];
+    cellTO.id = cells.id[cellIndex];
+    cellTO.pos = {cells.pos[cellIndex].x, cells.pos[cellIndex].y};
+    cellTO.vel = {cells.vel[cellIndex].x, cells.vel[cellIndex].y};
+    cellTO.energy = cells.energy[cellIndex];
+    cellTO.stiffness = cells.stiffness[cellIndex];
+    cellTO.color = cells.color[cellIndex];
+    cellTO.maxConnections = cells.maxConnections[cellIndex];
+    cellTO.barrier = cells.barrier[cellIndex] != 0;
+    cellTO.age = cells.age[cellIndex];
+    cellTO.livingState = cells.livingState[cellIndex];
+    cellTO.selected = cells.selected[cellIndex];
+
+    //connection indices are resolved by the caller
+    cellTO.numConnections = cells.numConnections[cellIndex];
+    for (int i = 0; i < cellTO.numConnections; ++i) {
+        auto const& connection = cells.connections[cellIndex][i];
+        cellTO.connections[i].cellIndex = connection.cellIndex;
+        cellTO.connections[i].distance = connection.distance;
+        cellTO.connections[i].angleFromPrevious = connection.angleFromPrevious;
+    }
+
+    forEachAuxiliaryDataSection(cellTO, [&](uint64_t size, uint64_t& dataIndex) { copyAuxiliaryDataToTO(data, size, dataIndex, dataTO); });
+}
+
+void CpuDataAccessProcessor::createParticleTO(CpuSimulationData const& data, int particleIndex, DataTO const& dataTO)
+{
+    auto const& particles = data.particles;
+    auto& particleTO = dataTO.particles[(*dataTO.numParticles)++];
+
+    particleTO.id = particles.id[particleIndex];
+    particleTO.pos = {particles.pos[particleIndex].x, particles.pos[particleIndex].y};
+    particleTO.vel = {particles.vel[particleIndex].x, particles.vel[particleIndex].y};
+    particleTO.energy = particles.energy[particleIndex];
+    particleTO.color = particles.color[particleIndex];
+    particleTO.selected = particles.selected[particleIndex];
+}
+
+void CpuDataAccessProcessor::setCellFromTO(CpuSimulationData& data, int cellIndex, CellTO const& cellTO, DataTO const& dataTO)
+{
+    auto& cells = data.cells;
+    auto& properties = cells.properties[cellIndex];
+
+    properties = cellTO;
+    forEachAuxiliaryDataSection(properties, [&](uint64_t size, uint64_t& dataIndex) { copyAuxiliaryDataFromTO(data, size, dataIndex, dataTO); });
+
+    cells.id[cellIndex] = cellTO.id;
+    cells.pos[cellIndex] = data.cellMap.getCorrectedPosition({cellTO.pos.x, cellTO.pos.y});
+    cells.vel[cellIndex] = {cellTO.vel.x, cellTO.vel.y};
+    cells.energy[cellIndex] = cellTO.energy;
+    cells.stiffness[cellIndex] = cellTO.stiffness;
+    cells.color[cellIndex] = cellTO.color;
+    cells.maxConnections[cellIndex] = cellTO.maxConnections;
+    cells.barrier[cellIndex] = cellTO.barrier ? 1 : 0;
+    cells.age[cellIndex] = cellTO.age;
+    cells.livingState[cellIndex] = cellTO.livingState;
+}
+
+void CpuDataAccessProcessor::adaptMaxIds(CpuSimulationData& data, DataTO const& dataTO)
+{
+    for (uint64_t i = 0; i < *dataTO.numCells; ++i) {
+        auto const& cellTO = dataTO.cells[i];
+        data.adaptMaxIds(cellTO.id, cellTO.mutationId);
+        if (cellTO.cellFunction == CellFunction_Constructor) {
+            data.adaptMaxIds(0, cellTO.cellFunctionData.constructor.offspringMutationId);
+        }
+    }
+    for (uint64_t i = 0; i < *dataTO.numParticles; ++i) {
+        data.adaptMaxIds(dataTO.particles[i].id, 0);
+    }
+}
+
+void CpuDataAccessProcessor::copyAuxiliaryDataToTO(CpuSimulationData const& data, uint64_t size, uint64_t& dataIndex, DataTO const& dataTO)
+{
+    if (size == 0) {
+        return;
+    }
+    auto targetIndex = *dataTO.numAuxiliaryData;
+    std::memcpy(dataTO.auxiliaryData + targetIndex, data.auxiliaryData.data() + dataIndex, size);
+    *dataTO.numAuxiliaryData += size;
+    dataIndex = targetIndex;
+}
+
+void CpuDataAccessProcessor::copyAuxiliaryDataFromTO(CpuSimulationData& data, uint64_t size, uint64_t& dataIndex, DataTO const& dataTO)
+{
+    if (size == 0) {
+        return;
+    }
+    auto targetIndex = data.auxiliaryData.size();
+    data.auxiliaryData.insert(data.auxiliaryData.end(), dataTO.auxiliaryData + dataIndex, dataTO.auxiliaryData + dataIndex + size);
+    dataIndex = targetIndex;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <vector>
+
+#include "Base/Vector2D.h"
+
+#include "CpuSimulationData.h"
+#include "Definitions.h"
+
+/**
+ * Host counterpart of the DataAccessKernels: converts between the simulation data and the transfer objects.
+ * Each cell owns its sections in the auxiliary data, which are copied on import and export.
+ */
+class CpuDataAccessProcessor
+{
+public:
+    static void getData(CpuSimulationData const& data, IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight, DataTO const& dataTO);
+    static void getSelectedData(CpuSimulationData const& data, bool includeClusters, DataTO const& dataTO);
+    static void getInspectedData(CpuSimulationData const& data, std::vector<uint64_t> const& entityIds, DataTO const& dataTO);
+    static void getOverlayData(CpuSimulationData const& data, IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight, DataTO const& dataTO);
+
+    static void addData(CpuSimulationData& data, DataTO const& dataTO, bool selectData, bool createIds);
+    static void changeData(CpuSimulationData& data, DataTO const& changeDataTO);  //changes the cell or particle with the id contained in changeDataTO
+    static void clearData(CpuSimulationData& data);
+
+private:
+    template <typename CellFilter, typename ParticleFilter>
+    static void getFilteredData(CpuSimulationData const& data, CellFilter const& cellFilter, ParticleFilter const& particleFilter, DataTO const& dataTO);
+
+    static void createCellTO(CpuSimulationData const& data, int cellIndex, DataTO const& dataTO);
+    static void createParticleTO(CpuSimulationData const& data, int particleIndex, DataTO const& dataTO);
+
+    static void setCellFromTO(CpuSimulationData& data, int cellIndex, CellTO const& cellTO, DataTO const& dataTO);
+    static void adaptMaxIds(CpuSimulationData& data, DataTO const& dataTO);
+
+    static void copyAuxiliaryDataToTO(CpuSimulationData const& data, uint64_t size, uint64_t& dataIndex, DataTO const& dataTO);
+    static void copyAuxiliaryDataFromTO(CpuSimulationData& data, uint64_t size, uint64_t& dataIndex, DataTO const& dataTO);
+};
@@ -0,0 +1,524 @@
+#include "CpuEditProcessor.h"
+
+#include <cmath>
+#include <deque>
+
+#include "Base/Math.h"
+
+#include "CpuCellConnectionProcessor.h"
+#include "CpuMath.h"
+#include "CpuSimulationProcessor.h"
+
+namespace
+{
+    void removeParticles(CpuParticles& particles, std::vector<uint8_t> const& removed)
+    {
+        size_t numRemainingParticles = 0;
+        for (size_t index = 0; index < particles.size(); ++index) {
+            if (!removed[index]) {
+                if (numRemainingParticles != index) {
+                    particles.copyEntry(index, numRemainingParticles);
+                }
+                ++numRemainingParticles;
+            }
+        }
+        particles.resize(numRemainingParticles);
+    }
+}
+
+void CpuEditProcessor::removeSelection(CpuSimulationData& data, bool onlyClusterSelection)
+{
+    for (auto& selected : data.cells.selected) {
+        if (!onlyClusterSelection || selected == 2) {
+            selected = 0;
+        }
+    }
+    for (auto& selected : data.particles.selected) {
+        if (!onlyClusterSelection || selected == 2) {
+            selected = 0;
+        }
+    }
+}
+
+void CpuEditProcessor::switchSelection(CpuSimulationData& data, RealVector2D const& pos, float radius)
+{
+    auto& cells = data.cells;
+    auto& particles = data.particles;
+    for (size_t index = 0; index < cells.size(); ++index) {
+        if (cells.selected[index] == 1 && data.cellMap.getDistance(pos, cells.pos[index]) < radius) {
+            return;
+        }
+    }
+    for (size_t index = 0; index < particles.size(); ++index) {
+        if (particles.selected[index] == 1 && data.cellMap.getDistance(pos, particles.pos[index]) < radius) {
+            return;
+        }
+    }
+
+    for (size_t index = 0; index < cells.size(); ++index) {
+        cells.selected[index] = data.cellMap.getDistance(pos, cells.pos[index]) < radius ? 1 : 0;
+    }
+    for (size_t index = 0; index < particles.size(); ++index) {
+        particles.selected[index] = data.cellMap.getDistance(pos, particles.pos[index]) < radius ? 1 : 0;
+    }
+    rolloutSelection(data);
+}
+
+void CpuEditProcessor::swapSelection(CpuSimulationData& data, RealVector2D const& pos, float radius)
+{
+    removeSelection(data, true);
+
+    auto& cells = data.cells;
+    auto& particles = data.particles;
+    for (size_t index = 0; index < cells.size(); ++index) {
+        if (data.cellMap.getDistance(pos, cells.pos[index]) < radius) {
+            if (cells.selected[index] == 0) {
+                cells.selected[index] = 1;
+            } else if (cells.selected[index] == 1) {
+                cells.selected[index] = 0;
+            }
+        }
+    }
+    for (size_t index = 0; index < particles.size(); ++index) {
+        if (data.cellMap.getDistance(pos, particles.pos[index]) < radius) {
+            particles.selected[index] = 1 - particles.selected[index];
+        }
+    }
+    rolloutSelection(data);
+}
+
+void CpuEditProcessor::setSelection(CpuSimulationData& data, RealVector2D const& startPos, RealVector2D const& endPos)
+{
+    auto worldSize = data.cellMap.getWorldSize();
+    auto isInArea = [&](RealVector2D const& pos) {
+        return CpuMath::isInBetweenModulo(startPos.x, endPos.x, pos.x, toFloat(worldSize.x))
+            && CpuMath::isInBetweenModulo(startPos.y, endPos.y, pos.y, toFloat(worldSize.y));
+    };
+
+    auto& cells = data.cells;
+    auto& particles = data.particles;
+    for (size_t index = 0; index < cells.size(); ++index) {
+        cells.selected[index] = isInArea(cells.pos[index]) ? 1 : 0;
+    }
+    for (size_t index = 0; index < particles.size(); ++index) {
+        particles.selected[index] = isInArea(particles.pos[index]) ? 1 : 0;
+    }
+    rolloutSelection(data);
+}
+
+void CpuEditProcessor::updateSelection(CpuSimulationData& data)
+{
+    removeSelection(data, true);
+    rolloutSelection(data);
+}
+
+void CpuEditProcessor::rolloutSelection(CpuSimulationData& data)
+{
+    auto& cells = data.cells;
+    std::deque<int> pendingCellIndices;
+    for (int index = 0; index < toInt(cells.size()); ++index) {
+        if (cells.selected[index] != 0) {
+            pendingCellIndices.emplace_back(index);
+        }
+    }
+    while (!pendingCellIndices.empty()) {
+        auto index = pendingCellIndices.front();
+        pendingCellIndices.pop_front();
+        for (int i = 0; i < cells.numConnections[index]; ++i) {
+            auto connectedCellIndex = cells.connections[index][i].cellIndex;
+            if (cells.selected[connectedCellIndex] == 0) {
+                cells.selected[connectedCellIndex] = 2;
+                pendingCellIndices.emplace_back(connectedCellIndex);
+            }
+        }
+    }
+}
+
+SelectionShallowData CpuEditProcessor::getSelectionShallowData(CpuSimulationData const& data, SimulationParameters const& parameters)
+{
+    auto const& cells = data.cells;
+    auto const& particles = data.particles;
+
+    auto refCellIndex = getCellWithMinimalPosY(data);
+    auto refPos = refCellIndex != -1 ? cells.pos[refCellIndex] : RealVector2D{0, 0};
+
+    SelectionShallowData result;
+    for (size_t index = 0; index < cells.size(); ++index) {
+        if (cells.selected[index] == 0) {
+            continue;
+        }
+        auto pos = cells.pos[index] + data.cellMap.getCorrectionIncrement(refPos, cells.pos[index]);
+        auto const& vel = cells.vel[index];
+        if (cells.selected[index] == 1) {
+            ++result.numCells;
+            result.centerPosX += pos.x;
+            result.centerPosY += pos.y;
+            result.centerVelX += vel.x;
+            result.centerVelY += vel.y;
+        }
+        ++result.numClusterCells;
+        result.clusterCenterPosX += pos.x;
+        result.clusterCenterPosY += pos.y;
+        result.clusterCenterVelX += vel.x;
+        result.clusterCenterVelY += vel.y;
+    }
+    for (size_t index = 0; index < particles.size(); ++index) {
+        if (particles.selected[index] == 0) {
+            continue;
+        }
+        auto pos = particles.pos[index] + data.cellMap.getCorrectionIncrement(refPos, particles.pos[index]);
+        auto const& vel = particles.vel[index];
+        ++result.numParticles;
+        result.centerPosX += pos.x;
+        result.centerPosY += pos.y;
+        result.centerVelX += vel.x;
+        result.centerVelY += vel.y;
+        result.clusterCenterPosX += pos.x;
+        result.clusterCenterPosY += pos.y;
+        result.clusterCenterVelX += vel.x;
+        result.clusterCenterVelY += vel.y;
+    }
+
+    auto mapCorrection = !parameters.borderlessRendering;
+    auto numEntities = result.numCells + result.numParticles;
+    if (numEntities > 0) {
+        result.centerPosX /= numEntities;
+        result.centerPosY /= numEntities;
+        result.centerVelX /= numEntities;
+        result.centerVelY /= numEntities;
+        if (mapCorrection) {
+            auto correctedPos = data.cellMap.getCorrectedPosition({result.centerPosX, result.centerPosY});
+            result.centerPosX = correctedPos.x;
+            result.centerPosY = correctedPos.y;
+        }
+    }
+    auto numClusterEntities = result.numClusterCells + result.numParticles;
+    if (numClusterEntities > 0) {
+        result.clusterCenterPosX /= numClusterEntities;
+        result.clusterCenterPosY /= numClusterEntities;
+        result.clusterCenterVelX /= numClusterEntities;
+        result.clusterCenterVelY /= numClusterEntities;
+        if (mapCorrection) {
+            auto correctedPos = data.cellMap.getCorrectedPosition({result.clusterCenterPosX, result.clusterCenterPosY});
+            result.clusterCenterPosX = correctedPos.x;
+            result.clusterCenterPosY = correctedPos.y;
+        }
+    }
+    return result;
+}
+
+void CpuEditProcessor::shallowUpdateSelectedObjects(CpuSimulationData& data, SimulationParameters const& parameters, ShallowUpdateSelectionData const& updateData)
+{
+    auto& cells = data.cells;
+    auto& particles = data.particles;
+    auto reconnectionRequired = !updateData.considerClusters && (updateData.posDeltaX != 0 || updateData.posDeltaY != 0 || updateData.angleDelta != 0);
+
+    if (reconnectionRequired) {
+        disconnectSelectionFromRemainings(data, parameters);
+    }
+
+    if (updateData.posDeltaX != 0 || updateData.posDeltaY != 0 || updateData.velX != 0 || updateData.velY != 0) {
+        RealVector2D posDelta{updateData.posDeltaX, updateData.posDeltaY};
+        RealVector2D vel{updateData.velX, updateData.velY};
+        for (int index = 0; index < toInt(cells.size()); ++index) {
+            if (isSelected(data, index, updateData.considerClusters)) {
+                cells.pos[index] = data.cellMap.getCorrectedPosition(cells.pos[index] + posDelta);
+                cells.vel[index] = vel;
+            }
+        }
+        for (size_t index = 0; index < particles.size(); ++index) {
+            if (particles.selected[index] != 0) {
+                particles.pos[index] = data.cellMap.getCorrectedPosition(particles.pos[index] + posDelta);
+                particles.vel[index] = vel;
+            }
+        }
+    }
+
+    if (updateData.angleDelta != 0 || updateData.angularVel != 0) {
+        auto refCellIndex = getCellWithMinimalPosY(data);
+        auto refPos = refCellIndex != -1 ? cells.pos[refCellIndex] : RealVector2D{0, 0};
+
+        RealVector2D center{0, 0};
+        int numEntities = 0;
+        for (int index = 0; index < toInt(cells.size()); ++index) {
+            if (isSelected(data, index, updateData.considerClusters)) {
+                center += cells.pos[index] + data.cellMap.getCorrectionIncrement(refPos, cells.pos[index]);
+                ++numEntities;
+            }
+        }
+        for (size_t index = 0; index < particles.size(); ++index) {
+            if (particles.selected[index] != 0) {
+                center += particles.pos[index];
+                ++numEntities;
+            }
+        }
+        if (numEntities != 0) {
+            center = center / toFloat(numEntities);
+        }
+
+        for (int index = 0; index < toInt(cells.size()); ++index) {
+            if (isSelected(data, index, updateData.considerClusters)) {
+                auto relPos = data.cellMap.getCorrectedDirection(cells.pos[index] - center);
+                if (updateData.angleDelta != 0) {
+                    cells.pos[index] = data.cellMap.getCorrectedPosition(Math::rotateClockwise(relPos, updateData.angleDelta) + center);
+                }
+                if (updateData.angularVel != 0) {
+                    cells.vel[index] = CpuMath::rotateQuarterClockwise(relPos) * updateData.angularVel * Const::DegToRad;
+                }
+            }
+        }
+        for (size_t index = 0; index < particles.size(); ++index) {
+            if (particles.selected[index] != 0) {
+                auto relPos = data.cellMap.getCorrectedDirection(particles.pos[index] - center);
+                particles.pos[index] = data.cellMap.getCorrectedPosition(Math::rotateClockwise(relPos, updateData.angleDelta) + center);
+            }
+        }
+    }
+
+    if (reconnectionRequired) {
+        connectSelection(data, parameters);
+        updateSelection(data);
+    }
+}
+
+void CpuEditProcessor::removeSelectedObjects(CpuSimulationData& data, bool includeClusters)
+{
+    auto& cells = data.cells;
+    std::vector<uint8_t> removedCells(cells.size(), 0);
+    for (int index = 0; index < toInt(cells.size()); ++index) {
+        if (isSelected(data, index, includeClusters)) {
+            removedCells[index] = 1;
+            CpuCellConnectionProcessor::deleteAllConnections(data, index);
+        }
+    }
+    CpuCellConnectionProcessor::compactCells(data, removedCells);
+
+    auto& particles = data.particles;
+    std::vector<uint8_t> removedParticles(particles.size(), 0);
+    for (size_t index = 0; index < particles.size(); ++index) {
+        removedParticles[index] = particles.selected[index] == 1 ? 1 : 0;
+    }
+    removeParticles(particles, removedParticles);
+}
+
+void CpuEditProcessor::relaxSelectedObjects(CpuSimulationData& data, bool includeClusters)
+{
+    auto& cells = data.cells;
+    for (int index = 0; index < toInt(cells.size()); ++index) {
+        if (!isSelected(data, index, includeClusters)) {
+            continue;
+        }
+        auto numConnections = cells.numConnections[index];
+        auto& connections = cells.connections[index];
+        for (int i = 0; i < numConnections; ++i) {
+            auto connectedCellIndex = connections[i].cellIndex;
+            if (isSelected(data, connectedCellIndex, includeClusters)) {
+                connections[i].distance = data.cellMap.getDistance(cells.pos[connectedCellIndex], cells.pos[index]);
+            }
+        }
+
+        if (numConnections > 1) {
+            for (int i = 0; i < numConnections; ++i) {
+                auto prevConnectedCellIndex = connections[(i + numConnections - 1) % numConnections].cellIndex;
+                auto connectedCellIndex = connections[i].cellIndex;
+                if (isSelected(data, connectedCellIndex, includeClusters) && isSelected(data, prevConnectedCellIndex, includeClusters)) {
+                    auto prevAngle = Math::angleOfVector(data.cellMap.getCorrectedDirection(cells.pos[prevConnectedCellIndex] - cells.pos[index]));
+                    auto angle = Math::angleOfVector(data.cellMap.getCorrectedDirection(cells.pos[connectedCellIndex] - cells.pos[index]));
+
+                    auto actualAngleFromPrevious = Math::subtractAngle(angle, prevAngle);
+                    auto angleDiff = actualAngleFromPrevious - connections[i].angleFromPrevious;
+
+                    auto nextAngleFromPrevious = connections[(i + 1) % numConnections].angleFromPrevious;
+                    if (nextAngleFromPrevious - angleDiff >= 0) {
+                        connections[i].angleFromPrevious = actualAngleFromPrevious;
+                        connections[(i + 1) % numConnections].angleFromPrevious = nextAngleFromPrevious - angleDiff;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void CpuEditProcessor::uniformVelocities(CpuSimulationData& data, bool includeClusters)
+{
+    auto& cells = data.cells;
+    auto& particles = data.particles;
+
+    RealVector2D velocity{0, 0};
+    int numEntities = 0;
+    for (int index = 0; index < toInt(cells.size()); ++index) {
+        if (isSelected(data, index, includeClusters)) {
+            velocity += cells.vel[index];
+            ++numEntities;
+        }
+    }
+    for (size_t index = 0; index < particles.size(); ++index) {
+        if (particles.selected[index] != 0) {
+            velocity += particles.vel[index];
+            ++numEntities;
+        }
+    }
+    if (numEntities == 0) {
+        return;
+    }
+    velocity = velocity / toFloat(numEntities);
+
+    for (int index = 0; index < toInt(cells.size()); ++index) {
+        if (isSelected(data, index, includeClusters)) {
+            cells.vel[index] = velocity;
+        }
+    }
+    for (size_t index = 0; index < particles.size(); ++index) {
+        if (particles.selected[index] != 0) {
+            particles.vel[index] = velocity;
+        }
+    }
+}
+
+void CpuEditProcessor::makeSticky(CpuSimulationData& data, bool includeClusters)
+{
+    for (int index = 0; index < toInt(data.cells.size()); ++index) {
+        if (isSelected(data, index, includeClusters)) {
+            data.cells.maxConnections[index] = MAX_CELL_BONDS;
+        }
+    }
+}
+
+void CpuEditProcessor::removeStickiness(CpuSimulationData& data, bool includeClusters)
+{
+    for (int index = 0; index < toInt(data.cells.size()); ++index) {
+        if (isSelected(data, index, includeClusters)) {
+            data.cells.maxConnections[index] = data.cells.numConnections[index];
+        }
+    }
+}
+
+void CpuEditProcessor::setBarrier(CpuSimulationData& data, bool value, bool includeClusters)
+{
+    for (int index = 0; index < toInt(data.cells.size()); ++index) {
+        if (isSelected(data, index, includeClusters)) {
+            data.cells.barrier[index] = value ? 1 : 0;
+        }
+    }
+}
+
+void CpuEditProcessor::colorSelectedCells(CpuSimulationData& data, unsigned char color, bool includeClusters)
+{
+    for (int index = 0; index < toInt(data.cells.size()); ++index) {
+        if (isSelected(data, index, includeClusters)) {
+            data.cells.color[index] = color;
+        }
+    }
+    auto& particles = data.particles;
+    for (size_t index = 0; index < particles.size(); ++index) {
+        if (particles.selected[index] != 0) {
+            particles.color[index] = color;
+        }
+    }
+}
+
+void CpuEditProcessor::setDetached(CpuSimulationData& data, bool value)
+{
+    for (size_t index = 0; index < data.cells.size(); ++index) {
+        if (data.cells.selected[index] != 0) {
+            data.cells.detached[index] = value ? 1 : 0;
+        }
+    }
+}
+
+void CpuEditProcessor::reconnect(CpuSimulationData& data, SimulationParameters const& parameters)
+{
+    disconnectSelectionFromRemainings(data, parameters);
+    connectSelection(data, parameters);
+    updateSelection(data);
+}
+
+void CpuEditProcessor::applyForce(CpuSimulationData& data, RealVector2D const& startPos, RealVector2D const& endPos, RealVector2D const& force, float radius)
+{
+    auto& cells = data.cells;
+    for (size_t index = 0; index < cells.size(); ++index) {
+        auto pos = cells.pos[index] + data.cellMap.getCorrectionIncrement(startPos, cells.pos[index]);
+        if (CpuMath::calcDistanceToLineSegment(startPos, endPos, pos, radius) < radius && !cells.barrier[index]) {
+            cells.vel[index] += force;
+        }
+    }
+    auto& particles = data.particles;
+    for (size_t index = 0; index < particles.size(); ++index) {
+        if (CpuMath::calcDistanceToLineSegment(startPos, endPos, particles.pos[index], radius) < radius) {
+            particles.vel[index] += force;
+        }
+    }
+}
+
+bool CpuEditProcessor::isSelected(CpuSimulationData const& data, int cellIndex, bool includeClusters)
+{
+    auto selected = data.cells.selected[cellIndex];
+    return (includeClusters && selected != 0) || (!includeClusters && selected == 1);
+}
+
+int CpuEditProcessor::getCellWithMinimalPosY(CpuSimulationData const& data)
+{
+    auto const& cells = data.cells;
+    int result = -1;
+    int minPosY = 0;
+    for (int index = 0; index < toInt(cells.size()); ++index) {
+        if (cells.selected[index] == 0) {
+            continue;
+        }
+        auto posY = static_cast<int>(std::abs(cells.pos[index].y));
+        if (result == -1 || posY < minPosY) {
+            result = index;
+            minPosY = posY;
+        }
+    }
+    return result;
+}
+
+void CpuEditProcessor::disconnectSelectionFromRemainings(CpuSimulationData& data, SimulationParameters const& parameters)
+{
+    auto& cells = data.cells;
+    std::vector<std::pair<int, int>> connectionsToDelete;
+    for (int index = 0; index < toInt(cells.size()); ++index) {
+        if (cells.selected[index] != 1) {
+            continue;
+        }
+        for (int i = 0; i < cells.numConnections[index]; ++i) {
+            auto connectedCellIndex = cells.connections[index][i].cellIndex;
+            if (cells.selected[connectedCellIndex] != 1
+                && data.cellMap.getDistance(cells.pos[index], cells.pos[connectedCellIndex]) > parameters.cellMaxBindingDistance[cells.color[index]]) {
+                connectionsToDelete.emplace_back(index, connectedCellIndex);
+            }
+        }
+    }
+    for (auto const& [cellIndex, connectedCellIndex] : connectionsToDelete) {
+        CpuCellConnectionProcessor::deleteConnections(data, cellIndex, connectedCellIndex);
+    }
+}
+
+void CpuEditProcessor::connectSelection(CpuSimulationData& data, SimulationParameters const& parameters)
+{
+    auto& cells = data.cells;
+    CpuSimulationProcessor::updateMap(data, parameters);
+
+    for (int index = 0; index < toInt(cells.size()); ++index) {
+        if (cells.selected[index] != 1) {
+            continue;
+        }
+        std::vector<int> candidateCellIndices;
+        data.cellMap.executeForEach(cells.pos[index], 1.3f, [&](int otherIndex) {
+            if (otherIndex == index || cells.selected[otherIndex] == 1 || cells.detached[index] + cells.detached[otherIndex] == 1) {
+                return;
+            }
+            if (data.cellMap.getDistance(cells.pos[index], cells.pos[otherIndex]) > 1.3f) {
+                return;
+            }
+            candidateCellIndices.emplace_back(otherIndex);
+        });
+        for (auto const& otherIndex : candidateCellIndices) {
+            if (cells.numConnections[index] < cells.maxConnections[index] && cells.numConnections[otherIndex] < cells.maxConnections[otherIndex]
+                && !CpuCellConnectionProcessor::isConnected(data, index, otherIndex)) {
+                CpuCellConnectionProcessor::tryAddConnections(data, index, otherIndex);
+            }
+        }
+    }
+}
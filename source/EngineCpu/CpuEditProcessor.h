@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Base/Vector2D.h"
+#include "EngineInterface/SelectionShallowData.h"
+#include "EngineInterface/ShallowUpdateSelectionData.h"
+#include "EngineInterface/SimulationParameters.h"
+
+#include "CpuSimulationData.h"
+#include "Definitions.h"
+
+/**
+ * Host counterpart of the EditKernels. Editing operations are executed sequentially since they are only triggered by the user.
+ */
+class CpuEditProcessor
+{
+public:
+    static void removeSelection(CpuSimulationData& data, bool onlyClusterSelection);
+    static void switchSelection(CpuSimulationData& data, RealVector2D const& pos, float radius);
+    static void swapSelection(CpuSimulationData& data, RealVector2D const& pos, float radius);
+    static void setSelection(CpuSimulationData& data, RealVector2D const& startPos, RealVector2D const& endPos);
+    static void updateSelection(CpuSimulationData& data);
+    static void rolloutSelection(CpuSimulationData& data);
+
+    static SelectionShallowData getSelectionShallowData(CpuSimulationData const& data, SimulationParameters const& parameters);
+    static void shallowUpdateSelectedObjects(CpuSimulationData& data, SimulationParameters const& parameters, ShallowUpdateSelectionData const& updateData);
+    static void removeSelectedObjects(CpuSimulationData& data, bool includeClusters);
+    static void relaxSelectedObjects(CpuSimulationData& data, bool includeClusters);
+    static void uniformVelocities(CpuSimulationData& data, bool includeClusters);
+    static void makeSticky(CpuSimulationData& data, bool includeClusters);
+    static void removeStickiness(CpuSimulationData& data, bool includeClusters);
+    static void setBarrier(CpuSimulationData& data, bool value, bool includeClusters);
+    static void colorSelectedCells(CpuSimulationData& data, unsigned char color, bool includeClusters);
+    static void setDetached(CpuSimulationData& data, bool value);
+    static void reconnect(CpuSimulationData& data, SimulationParameters const& parameters);
+    static void applyForce(CpuSimulationData& data, RealVector2D const& startPos, RealVector2D const& endPos, RealVector2D const& force, float radius);
+
+private:
+    static bool isSelected(CpuSimulationData const& data, int cellIndex, bool includeClusters);
+    static int getCellWithMinimalPosY(CpuSimulationData const& data);  //returns -1 if no cell is selected
+    static void disconnectSelectionFromRemainings(CpuSimulationData& data, SimulationParameters const& parameters);
+    static void connectSelection(CpuSimulationData& data, SimulationParameters const& parameters);
+};
@@ -0,0 +1,64 @@
+#include "CpuMap.h"
+
+#include <algorithm>
+
+void CpuMap::init(IntVector2D const& worldSize)
+{
+    _worldSize = worldSize;
+    _worldSizeFloat = {toFloat(worldSize.x), toFloat(worldSize.y)};
+    _positions = nullptr;
+    _bucketStart.clear();
+    _entries.clear();
+}
+
+void CpuMap::rebuild(std::vector<RealVector2D> const& positions, float maxInteractionDistance)
+{
+    auto bucketLength = std::max(1.0f, maxInteractionDistance);
+    _numBuckets = {
+        std::max(1, static_cast<int>(_worldSizeFloat.x / bucketLength)),
+        std::max(1, static_cast<int>(_worldSizeFloat.y / bucketLength))};
+    _bucketLength = {_worldSizeFloat.x / toFloat(_numBuckets.x), _worldSizeFloat.y / toFloat(_numBuckets.y)};
+    _positions = &positions;
+
+    //counting sort preserves the index order inside each bucket
+    auto numBuckets = _numBuckets.x * _numBuckets.y;
+    _bucketStart.assign(numBuckets + 1, 0);
+    std::vector<int> bucketOfEntry(positions.size());
+    for (size_t index = 0; index < positions.size(); ++index) {
+        auto pos = getCorrectedPosition(positions[index]);
+        auto bucket = getBucketCoordinate(pos.x, _numBuckets.x, _bucketLength.x)
+            + getBucketCoordinate(pos.y, _numBuckets.y, _bucketLength.y) * _numBuckets.x;
+        bucketOfEntry[index] = bucket;
+        ++_bucketStart[bucket + 1];
+    }
+    for (int bucket = 0; bucket < numBuckets; ++bucket) {
+        _bucketStart[bucket + 1] += _bucketStart[bucket];
+    }
+    _entries.resize(positions.size());
+    std::vector<int> fillLevel(_bucketStart.begin(), _bucketStart.end() - 1);
+    for (size_t index = 0; index < positions.size(); ++index) {
+        _entries[fillLevel[bucketOfEntry[index]]++] = toInt(index);
+    }
+}
+
+int CpuMap::getFirst(RealVector2D const& pos) const
+{
+    if (!_positions) {
+        return -1;
+    }
+    auto correctedPos = getCorrectedPosition(pos);
+    IntVector2D intPos{static_cast<int>(std::floor(correctedPos.x)), static_cast<int>(std::floor(correctedPos.y))};
+
+    //an integer position may overlap with neighboring buckets since bucket lengths are not integral
+    int result = -1;
+    executeForEach(correctedPos, 1.0f, [&](int index) {
+        if (result != -1 && index > result) {
+            return;
+        }
+        auto otherPos = getCorrectedPosition((*_positions)[index]);
+        if (static_cast<int>(std::floor(otherPos.x)) == intPos.x && static_cast<int>(std::floor(otherPos.y)) == intPos.y) {
+            result = index;
+        }
+    });
+    return result;
+}
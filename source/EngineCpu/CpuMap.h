@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+#include "Base/Definitions.h"
+#include "Base/Math.h"
+#include "Base/Vector2D.h"
+
+#include "Definitions.h"
+
+/**
+ * Periodic world geometry and a bucket grid for neighbor queries.
+ * Entries of a bucket are sorted by index such that all queries are deterministic.
+ */
+class CpuMap
+{
+public:
+    void init(IntVector2D const& worldSize);
+    IntVector2D getWorldSize() const { return _worldSize; }
+
+    void correctPosition(RealVector2D& pos) const
+    {
+        pos.x = correctCoordinate(pos.x, _worldSizeFloat.x);
+        pos.y = correctCoordinate(pos.y, _worldSizeFloat.y);
+    }
+
+    RealVector2D getCorrectedPosition(RealVector2D pos) const
+    {
+        correctPosition(pos);
+        return pos;
+    }
+
+    void correctDirection(RealVector2D& disp) const
+    {
+        disp.x = std::remainder(disp.x, _worldSizeFloat.x);
+        disp.y = std::remainder(disp.y, _worldSizeFloat.y);
+    }
+
+    RealVector2D getCorrectedDirection(RealVector2D disp) const
+    {
+        correctDirection(disp);
+        return disp;
+    }
+
+    //returns the offset which has to be added to pos2 in order to get the nearest periodic image to pos1
+    RealVector2D getCorrectionIncrement(RealVector2D const& pos1, RealVector2D const& pos2) const
+    {
+        auto delta = pos1 - pos2 + _worldSizeFloat / 2;
+        return {delta.x - Math::modulo(delta.x, _worldSizeFloat.x), delta.y - Math::modulo(delta.y, _worldSizeFloat.y)};
+    }
+
+    float getDistance(RealVector2D const& p, RealVector2D const& q) const
+    {
+        auto d = getCorrectedDirection(p - q);
+        return std::sqrt(d.x * d.x + d.y * d.y);
+    }
+
+    //positions must not be reallocated until the next call of rebuild
+    void rebuild(std::vector<RealVector2D> const& positions, float maxInteractionDistance);
+
+    //calls func(index) for all entries in buckets intersecting the circle, the distance has to be checked by the caller
+    template <typename Func>
+    void executeForEach(RealVector2D const& pos, float radius, Func const& func) const;
+
+    //returns the smallest index of the entries located at the same integer position or -1
+    int getFirst(RealVector2D const& pos) const;
+
+private:
+    static float correctCoordinate(float value, float size)
+    {
+        auto result = std::fmod(value, size);
+        if (result < 0) {
+            result += size;
+        }
+        return result < size ? result : 0.0f;
+    }
+
+    int getBucketCoordinate(float value, int numBuckets, float bucketLength) const
+    {
+        return std::min(numBuckets - 1, std::max(0, static_cast<int>(value / bucketLength)));
+    }
+
+    template <typename Func>
+    void executeForEachInBucket(int bucketX, int bucketY, Func const& func) const;
+
+    IntVector2D _worldSize;
+    RealVector2D _worldSizeFloat;
+
+    IntVector2D _numBuckets;
+    RealVector2D _bucketLength;
+    std::vector<int> _bucketStart;  //size = number of buckets + 1
+    std::vector<int> _entries;
+    std::vector<RealVector2D> const* _positions = nullptr;
+};
+
+/************************************************************************/
+/* Implementation                                                       */
+/************************************************************************/
+
+template <typename Func>
+void CpuMap::executeForEach(RealVector2D const& pos, float radius, Func const& func) const
+{
+    if (!_positions) {
+        return;
+    }
+    auto correctedPos = getCorrectedPosition(pos);
+    auto centerX = getBucketCoordinate(correctedPos.x, _numBuckets.x, _bucketLength.x);
+    auto centerY = getBucketCoordinate(correctedPos.y, _numBuckets.y, _bucketLength.y);
+    auto rangeX = static_cast<int>(std::ceil(radius / _bucketLength.x));
+    auto rangeY = static_cast<int>(std::ceil(radius / _bucketLength.y));
+
+    //visit each bucket at most once if the range covers the whole world
+    auto fromX = centerX - rangeX;
+    auto toX = centerX + rangeX;
+    if (2 * rangeX + 1 >= _numBuckets.x) {
+        fromX = 0;
+        toX = _numBuckets.x - 1;
+    }
+    auto fromY = centerY - rangeY;
+    auto toY = centerY + rangeY;
+    if (2 * rangeY + 1 >= _numBuckets.y) {
+        fromY = 0;
+        toY = _numBuckets.y - 1;
+    }
+    for (int y = fromY; y <= toY; ++y) {
+        for (int x = fromX; x <= toX; ++x) {
+            executeForEachInBucket((x + _numBuckets.x) % _numBuckets.x, (y + _numBuckets.y) % _numBuckets.y, func);
+        }
+    }
+}
+
+template <typename Func>
+void CpuMap::executeForEachInBucket(int bucketX, int bucketY, Func const& func) const
+{
+    auto bucket = bucketX + bucketY * _numBuckets.x;
+    for (int i = _bucketStart[bucket], j = _bucketStart[bucket + 1]; i < j; ++i) {
+        func(_entries[i]);
+    }
+}
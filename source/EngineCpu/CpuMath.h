@@ -0,0 +1,90 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include "Base/Math.h"
+#include "Base/Vector2D.h"
+
+/**
+ * Vector helpers of the kernel code which are not available in Base/Math.h.
+ */
+namespace CpuMath
+{
+    inline float dot(RealVector2D const& p, RealVector2D const& q)
+    {
+        return p.x * q.x + p.y * q.y;
+    }
+
+    inline float lengthSquared(RealVector2D const& v)
+    {
+        return v.x * v.x + v.y * v.y;
+    }
+
+    inline float lengthMax(RealVector2D const& v)
+    {
+        return std::max(std::abs(v.x), std::abs(v.y));
+    }
+
+    inline RealVector2D normalized(RealVector2D v)
+    {
+        auto length = std::sqrt(lengthSquared(v));
+        if (length > NEAR_ZERO) {
+            return {v.x / length, v.y / length};
+        }
+        return {1.0f, 0.0f};
+    }
+
+    inline RealVector2D rotateQuarterClockwise(RealVector2D const& v)
+    {
+        return {-v.y, v.x};
+    }
+
+    inline RealVector2D rotateQuarterCounterClockwise(RealVector2D const& v)
+    {
+        return {v.y, -v.x};
+    }
+
+    inline bool isInBetweenModulo(float value1, float value2, float candidate, float size)
+    {
+        if (value2 - value1 >= size) {
+            return true;
+        }
+        auto valueMod1 = Math::modulo(value1, size);
+        auto valueMod2 = Math::modulo(value2, size);
+        auto candidateMod = Math::modulo(candidate, size);
+
+        if (valueMod1 == valueMod2 && valueMod1 != candidateMod) {
+            return false;
+        }
+        if (candidateMod < valueMod1) {
+            candidateMod += size;
+            valueMod2 += size;
+        }
+        if (valueMod2 < candidateMod) {
+            valueMod2 += size;
+        }
+        return valueMod2 - valueMod1 < size;
+    }
+
+    //returns a value larger than boundary if pos is not located within the given distance of the segment
+    inline float calcDistanceToLineSegment(RealVector2D const& startSegment, RealVector2D const& endSegment, RealVector2D const& pos, float boundary = 0)
+    {
+        auto relPos = pos - startSegment;
+        auto segmentDirection = endSegment - startSegment;
+        auto segmentLength = std::sqrt(lengthSquared(segmentDirection));
+        if (segmentLength < NEAR_ZERO) {
+            return boundary + 1.0f;
+        }
+        segmentDirection = segmentDirection / segmentLength;
+        auto signedDistanceFromLine = dot(relPos, rotateQuarterCounterClockwise(segmentDirection));
+        if (std::abs(signedDistanceFromLine) > boundary) {
+            return boundary + 1.0f;
+        }
+        auto signedDistanceFromStart = dot(relPos, segmentDirection);
+        if (signedDistanceFromStart < 0 || signedDistanceFromStart > segmentLength) {
+            return boundary + 1.0f;
+        }
+        return std::abs(signedDistanceFromLine);
+    }
+}
@@ -0,0 +1,285 @@
+#include "CpuRadiationProcessor.h"
+
+#include <cmath>
+
+#include "Base/ThreadPool.h"
+
+#include "CpuMath.h"
+#include "CpuSpotCalculator.h"
+
+namespace
+{
+    struct EnergyTransfer
+    {
+        int cellIndex;
+        float energy;
+    };
+}
+
+void CpuRadiationProcessor::calcActiveSources(CpuSimulationData& data, SimulationParameters const& parameters)
+{
+    data.activeRadiationSources.clear();
+    for (int i = 0; i < parameters.numRadiationSources; ++i) {
+        auto const& source = parameters.radiationSource[i];
+        auto sourceActive = !CpuSpotCalculator::calcParameter(
+            &SimulationParametersZoneValues::radiationDisableSources,
+            &SimulationParametersZoneActivatedValues::radiationDisableSources,
+            parameters,
+            data.cellMap,
+            {source.posX, source.posY});
+        if (sourceActive) {
+            data.activeRadiationSources.emplace_back(i);
+        }
+    }
+}
+
+void CpuRadiationProcessor::movement(CpuSimulationData& data, SimulationParameters const& parameters, ThreadPool& threadPool)
+{
+    auto& particles = data.particles;
+    threadPool.parallelFor(particles.size(), [&](size_t startIndex, size_t endIndex) {
+        for (auto index = startIndex; index < endIndex; ++index) {
+            particles.pos[index] += particles.vel[index] * parameters.timestepSize;
+            data.cellMap.correctPosition(particles.pos[index]);
+        }
+    });
+}
+
+void CpuRadiationProcessor::collision(CpuSimulationData& data, SimulationParameters const& parameters, ThreadPool& threadPool)
+{
+    auto& particles = data.particles;
+    auto& cells = data.cells;
+
+    //particles only modify themselves in the parallel pass, the energy transfers to cells are applied afterwards in particle order
+    auto transfers = threadPool.parallelCollect<EnergyTransfer>(particles.size(), [&](size_t startIndex, size_t endIndex, std::vector<EnergyTransfer>& result) {
+        for (auto index = startIndex; index < endIndex; ++index) {
+            auto cellIndex = data.cellMap.getFirst(particles.pos[index] + particles.vel[index]);
+            if (cellIndex == -1) {
+                continue;
+            }
+            if (cells.barrier[cellIndex]) {
+                auto vr = particles.vel[index] - cells.vel[cellIndex];
+                auto r = data.cellMap.getCorrectedDirection(particles.pos[index] - cells.pos[cellIndex]);
+                auto dot_vr_r = CpuMath::dot(vr, r);
+                if (dot_vr_r < 0) {
+                    auto truncated_r_squared = std::max(0.1f, CpuMath::lengthSquared(r));
+                    particles.vel[index] = vr - r * 2 * dot_vr_r / truncated_r_squared + cells.vel[cellIndex];
+                }
+                continue;
+            }
+            if (particles.lastAbsorbedCellId[index] == cells.id[cellIndex]) {
+                continue;
+            }
+            auto const& cellPos = cells.pos[cellIndex];
+            auto cellColor = cells.color[cellIndex];
+            auto radiationAbsorption = CpuSpotCalculator::calcParameter(
+                &SimulationParametersZoneValues::radiationAbsorption,
+                &SimulationParametersZoneActivatedValues::radiationAbsorption,
+                parameters,
+                data.cellMap,
+                cellPos,
+                cellColor);
+            if (radiationAbsorption < NEAR_ZERO) {
+                continue;
+            }
+
+            auto energyToTransfer = particles.energy[index] * radiationAbsorption;
+            if (parameters.features.advancedAbsorptionControl) {
+                auto cellVelocity = Math::length(cells.vel[cellIndex]);
+                energyToTransfer *= std::max(0.0f, 1.0f - cellVelocity * parameters.radiationAbsorptionHighVelocityPenalty[cellColor]);
+
+                auto radiationAbsorptionLowVelocityPenalty = CpuSpotCalculator::calcParameter(
+                    &SimulationParametersZoneValues::radiationAbsorptionLowVelocityPenalty,
+                    &SimulationParametersZoneActivatedValues::radiationAbsorptionLowVelocityPenalty,
+                    parameters,
+                    data.cellMap,
+                    cellPos,
+                    cellColor);
+                energyToTransfer *= 1.0f - radiationAbsorptionLowVelocityPenalty / std::pow(1.0f + cellVelocity, 10.0f);
+                energyToTransfer *=
+                    std::pow(toFloat(cells.numConnections[cellIndex] + 1) / 7.0f, parameters.radiationAbsorptionLowConnectionPenalty[cellColor]);
+
+                auto radiationAbsorptionLowGenomeComplexityPenalty = CpuSpotCalculator::calcParameter(
+                    &SimulationParametersZoneValues::radiationAbsorptionLowGenomeComplexityPenalty,
+                    &SimulationParametersZoneActivatedValues::radiationAbsorptionLowGenomeComplexityPenalty,
+                    parameters,
+                    data.cellMap,
+                    cellPos,
+                    cellColor);
+                energyToTransfer *= 1.0f - radiationAbsorptionLowGenomeComplexityPenalty / std::pow(1.0f + cells.properties[cellIndex].genomeComplexity, 0.1f);
+            }
+            if (particles.energy[index] < 0.01f) {
+                energyToTransfer = particles.energy[index];
+            }
+            particles.energy[index] -= energyToTransfer;
+            particles.lastAbsorbedCellId[index] = cells.id[cellIndex];
+            result.emplace_back(EnergyTransfer{toInt(cellIndex), energyToTransfer});
+        }
+    });
+
+    for (auto const& transfer : transfers) {
+        cells.energy[transfer.cellIndex] += transfer.energy;
+    }
+    removeParticlesWithoutEnergy(data);
+}
+
+void CpuRadiationProcessor::splitting(CpuSimulationData& data, SimulationParameters const& parameters, ThreadPool& threadPool)
+{
+    auto& particles = data.particles;
+    auto newParticles = threadPool.parallelCollect<CpuNewParticle>(particles.size(), [&](size_t startIndex, size_t endIndex, std::vector<CpuNewParticle>& result) {
+        for (auto index = startIndex; index < endIndex; ++index) {
+            CpuRandom random(data.timestep, particles.id[index], CpuRandomStream_ParticleSplitting);
+            if (random.random() >= 0.01f) {
+                continue;
+            }
+            auto color = particles.color[index];
+            if (particles.energy[index] > parameters.particleSplitEnergy[color]) {
+                particles.energy[index] *= 0.5f;
+                auto velPerturbation = Math::unitVectorOfAngle(random.random() * 360);
+
+                auto otherPos = data.cellMap.getCorrectedPosition(particles.pos[index] + velPerturbation / 5);
+                particles.pos[index] -= velPerturbation / 5;
+                data.cellMap.correctPosition(particles.pos[index]);
+
+                velPerturbation *= parameters.radiationVelocityPerturbation / (particles.energy[index] + 1.0f);
+                auto otherVel = particles.vel[index] + velPerturbation;
+                particles.vel[index] -= velPerturbation;
+
+                result.emplace_back(CpuNewParticle{otherPos, otherVel, particles.energy[index], color});
+            }
+        }
+    });
+    addParticles(data, newParticles);
+}
+
+std::optional<CpuNewParticle> CpuRadiationProcessor::radiate(
+    CpuSimulationData const& data,
+    SimulationParameters const& parameters,
+    CpuRandom& random,
+    RealVector2D pos,
+    RealVector2D vel,
+    int color,
+    float energy)
+{
+    if (!data.activeRadiationSources.empty()) {
+        auto sumActiveRatios = 0.0f;
+        for (auto const& sourceIndex : data.activeRadiationSources) {
+            sumActiveRatios += parameters.radiationSource[sourceIndex].strength;
+        }
+        if (sumActiveRatios > 0) {
+            auto randomRatioValue = random.random(1.0f);
+            sumActiveRatios = 0.0f;
+            std::optional<int> matchingSourceIndex;
+            for (auto const& sourceIndex : data.activeRadiationSources) {
+                sumActiveRatios += parameters.radiationSource[sourceIndex].strength;
+                if (randomRatioValue <= sumActiveRatios) {
+                    matchingSourceIndex = sourceIndex;
+                    break;
+                }
+            }
+            if (matchingSourceIndex) {
+                auto const& source = parameters.radiationSource[*matchingSourceIndex];
+                pos = {source.posX, source.posY};
+
+                if (source.shapeType == RadiationSourceShapeType_Circular) {
+                    auto radius = std::max(1.0f, source.shapeData.circularRadiationSource.radius);
+                    RealVector2D delta{0, 0};
+                    for (int i = 0; i < 10; ++i) {
+                        delta.x = random.random() * radius * 2 - radius;
+                        delta.y = random.random() * radius * 2 - radius;
+                        if (Math::length(delta) <= radius) {
+                            break;
+                        }
+                    }
+                    pos += delta;
+                    if (source.useAngle) {
+                        vel = Math::unitVectorOfAngle(source.angle) * random.random(0.5f, 1.0f);
+                    } else {
+                        vel = CpuMath::normalized(delta) * random.random(0.5f, 1.0f);
+                    }
+                }
+                if (source.shapeType == RadiationSourceShapeType_Rectangular) {
+                    auto const& rectangle = source.shapeData.rectangularRadiationSource;
+                    RealVector2D delta;
+                    delta.x = random.random() * rectangle.width - rectangle.width / 2;
+                    delta.y = random.random() * rectangle.height - rectangle.height / 2;
+                    pos += delta;
+                    if (source.useAngle) {
+                        vel = Math::unitVectorOfAngle(source.angle) * random.random(0.5f, 1.0f);
+                    } else {
+                        auto roundSize = std::min(rectangle.width, rectangle.height) / 2;
+                        RealVector2D corner1{-rectangle.width / 2, -rectangle.height / 2};
+                        RealVector2D corner2{rectangle.width / 2, -rectangle.height / 2};
+                        RealVector2D corner3{-rectangle.width / 2, rectangle.height / 2};
+                        RealVector2D corner4{rectangle.width / 2, rectangle.height / 2};
+                        if (CpuMath::lengthMax(corner1 - delta) <= roundSize) {
+                            vel = CpuMath::normalized(delta - (corner1 + RealVector2D{roundSize, roundSize}));
+                        } else if (CpuMath::lengthMax(corner2 - delta) <= roundSize) {
+                            vel = CpuMath::normalized(delta - (corner2 + RealVector2D{-roundSize, roundSize}));
+                        } else if (CpuMath::lengthMax(corner3 - delta) <= roundSize) {
+                            vel = CpuMath::normalized(delta - (corner3 + RealVector2D{roundSize, -roundSize}));
+                        } else if (CpuMath::lengthMax(corner4 - delta) <= roundSize) {
+                            vel = CpuMath::normalized(delta - (corner4 + RealVector2D{-roundSize, -roundSize}));
+                        } else {
+                            vel = {0, 0};
+                            auto dx1 = rectangle.width / 2 + delta.x;
+                            auto dx2 = rectangle.width / 2 - delta.x;
+                            auto dy1 = rectangle.height / 2 + delta.y;
+                            auto dy2 = rectangle.height / 2 - delta.y;
+                            if (dx1 <= dy1 && dx1 <= dy2 && delta.x <= 0) {
+                                vel.x = -1;
+                            }
+                            if (dy1 <= dx1 && dy1 <= dx2 && delta.y <= 0) {
+                                vel.y = -1;
+                            }
+                            if (dx2 <= dy1 && dx2 <= dy2 && delta.x > 0) {
+                                vel.x = 1;
+                            }
+                            if (dy2 <= dx1 && dy2 <= dx2 && delta.y > 0) {
+                                vel.y = 1;
+                            }
+                        }
+                        vel = vel * random.random(0.5f, 1.0f);
+                    }
+                }
+            }
+        }
+    }
+
+    if (energy <= NEAR_ZERO) {
+        return std::nullopt;
+    }
+    return CpuNewParticle{data.cellMap.getCorrectedPosition(pos), vel, energy, static_cast<uint8_t>(color)};
+}
+
+void CpuRadiationProcessor::addParticles(CpuSimulationData& data, std::vector<CpuNewParticle> const& newParticles)
+{
+    auto& particles = data.particles;
+    auto origSize = particles.size();
+    particles.resize(origSize + newParticles.size());
+    for (size_t i = 0; i < newParticles.size(); ++i) {
+        auto const& newParticle = newParticles[i];
+        auto index = origSize + i;
+        particles.id[index] = data.createId();
+        particles.pos[index] = newParticle.pos;
+        particles.vel[index] = newParticle.vel;
+        particles.energy[index] = newParticle.energy;
+        particles.color[index] = newParticle.color;
+        particles.selected[index] = 0;
+        particles.lastAbsorbedCellId[index] = 0;
+    }
+}
+
+void CpuRadiationProcessor::removeParticlesWithoutEnergy(CpuSimulationData& data)
+{
+    auto& particles = data.particles;
+    size_t numRemainingParticles = 0;
+    for (size_t index = 0; index < particles.size(); ++index) {
+        if (particles.energy[index] >= NEAR_ZERO) {
+            if (numRemainingParticles != index) {
+                particles.copyEntry(index, numRemainingParticles);
+            }
+            ++numRemainingParticles;
+        }
+    }
+    particles.resize(numRemainingParticles);
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include "EngineInterface/SimulationParameters.h"
+
+#include "CpuSimulationData.h"
+#include "Definitions.h"
+
+class CpuRadiationProcessor
+{
+public:
+    static void calcActiveSources(CpuSimulationData& data, SimulationParameters const& parameters);
+    static void movement(CpuSimulationData& data, SimulationParameters const& parameters, ThreadPool& threadPool);
+    static void collision(CpuSimulationData& data, SimulationParameters const& parameters, ThreadPool& threadPool);
+    static void splitting(CpuSimulationData& data, SimulationParameters const& parameters, ThreadPool& threadPool);
+
+    //returns the particle to be created (if any), relocated to an active radiation source if present
+    static std::optional<CpuNewParticle> radiate(
+        CpuSimulationData const& data,
+        SimulationParameters const& parameters,
+        CpuRandom& random,
+        RealVector2D pos,
+        RealVector2D vel,
+        int color,
+        float energy);
+
+    static void addParticles(CpuSimulationData& data, std::vector<CpuNewParticle> const& newParticles);
+    static void removeParticlesWithoutEnergy(CpuSimulationData& data);
+};
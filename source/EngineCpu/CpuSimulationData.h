@@ -0,0 +1,203 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "Base/Definitions.h"
+#include "Base/Vector2D.h"
+#include "EngineInterface/CellFunctionConstants.h"
+#include "EngineInterface/EngineConstants.h"
+#include "EngineInterface/RawStatisticsData.h"
+#include "EngineGpuKernels/TOs.cuh"
+
+#include "CpuMap.h"
+#include "Definitions.h"
+
+struct CpuConnection
+{
+    int cellIndex;
+    float distance;
+    float angleFromPrevious;
+};
+
+/**
+ * Cells are stored as a structure of arrays. Attributes used by the physics passes have their own arrays.
+ * All other attributes (cell function data, signals, metadata) are kept in the transfer layout in 'properties'.
+ * The attributes in 'properties' which have their own arrays are not kept up to date.
+ */
+struct CpuCells
+{
+    std::vector<uint64_t> id;
+    std::vector<RealVector2D> pos;
+    std::vector<RealVector2D> vel;
+    std::vector<RealVector2D> force;
+    std::vector<RealVector2D> prevForce;
+    std::vector<float> energy;
+    std::vector<float> stiffness;
+    std::vector<float> density;
+    std::vector<uint8_t> color;
+    std::vector<uint8_t> maxConnections;
+    std::vector<uint8_t> numConnections;
+    std::vector<std::array<CpuConnection, MAX_CELL_BONDS>> connections;
+    std::vector<uint8_t> barrier;
+    std::vector<uint8_t> detached;
+    std::vector<uint8_t> selected;  //0 = no, 1 = selected, 2 = cluster selected
+    std::vector<uint32_t> age;
+    std::vector<LivingState> livingState;
+    std::vector<CellTO> properties;
+
+    size_t size() const { return id.size(); }
+
+    void resize(size_t size)
+    {
+        id.resize(size);
+        pos.resize(size);
+        vel.resize(size);
+        force.resize(size);
+        prevForce.resize(size);
+        energy.resize(size);
+        stiffness.resize(size);
+        density.resize(size);
+        color.resize(size);
+        maxConnections.resize(size);
+        numConnections.resize(size);
+        connections.resize(size);
+        barrier.resize(size);
+        detached.resize(size);
+        selected.resize(size);
+        age.resize(size);
+        livingState.resize(size);
+        properties.resize(size);
+    }
+
+    void copyEntry(size_t sourceIndex, size_t targetIndex)
+    {
+        id[targetIndex] = id[sourceIndex];
+        pos[targetIndex] = pos[sourceIndex];
+        vel[targetIndex] = vel[sourceIndex];
+        force[targetIndex] = force[sourceIndex];
+        prevForce[targetIndex] = prevForce[sourceIndex];
+        energy[targetIndex] = energy[sourceIndex];
+        stiffness[targetIndex] = stiffness[sourceIndex];
+        density[targetIndex] = density[sourceIndex];
+        color[targetIndex] = color[sourceIndex];
+        maxConnections[targetIndex] = maxConnections[sourceIndex];
+        numConnections[targetIndex] = numConnections[sourceIndex];
+        connections[targetIndex] = connections[sourceIndex];
+        barrier[targetIndex] = barrier[sourceIndex];
+        detached[targetIndex] = detached[sourceIndex];
+        selected[targetIndex] = selected[sourceIndex];
+        age[targetIndex] = age[sourceIndex];
+        livingState[targetIndex] = livingState[sourceIndex];
+        properties[targetIndex] = properties[sourceIndex];
+    }
+};
+
+struct CpuParticles
+{
+    std::vector<uint64_t> id;
+    std::vector<RealVector2D> pos;
+    std::vector<RealVector2D> vel;
+    std::vector<float> energy;
+    std::vector<uint8_t> color;
+    std::vector<uint8_t> selected;
+    std::vector<uint64_t> lastAbsorbedCellId;  //0 = none
+
+    size_t size() const { return id.size(); }
+
+    void resize(size_t size)
+    {
+        id.resize(size);
+        pos.resize(size);
+        vel.resize(size);
+        energy.resize(size);
+        color.resize(size);
+        selected.resize(size);
+        lastAbsorbedCellId.resize(size);
+    }
+
+    void copyEntry(size_t sourceIndex, size_t targetIndex)
+    {
+        id[targetIndex] = id[sourceIndex];
+        pos[targetIndex] = pos[sourceIndex];
+        vel[targetIndex] = vel[sourceIndex];
+        energy[targetIndex] = energy[sourceIndex];
+        color[targetIndex] = color[sourceIndex];
+        selected[targetIndex] = selected[sourceIndex];
+        lastAbsorbedCellId[targetIndex] = lastAbsorbedCellId[sourceIndex];
+    }
+};
+
+//particle which is created during a parallel pass and appended afterwards
+struct CpuNewParticle
+{
+    RealVector2D pos;
+    RealVector2D vel;
+    float energy;
+    uint8_t color;
+};
+
+struct CpuSimulationData
+{
+    uint64_t timestep = 0;
+    CpuMap cellMap;
+    CpuCells cells;
+    CpuParticles particles;
+    std::vector<uint8_t> auxiliaryData;
+
+    uint64_t maxId = 0;
+    uint32_t maxSmallId = 0;
+
+    std::vector<int> activeRadiationSources;
+    AccumulatedStatistics accumulatedStatistics;
+
+    uint64_t createId() { return ++maxId; }
+
+    void adaptMaxIds(uint64_t id, uint32_t smallId)
+    {
+        maxId = std::max(maxId, id);
+        maxSmallId = std::max(maxSmallId, smallId);
+    }
+};
+
+using CpuRandomStream = uint32_t;
+enum CpuRandomStream_
+{
+    CpuRandomStream_CellDeletion = 1,
+    CpuRandomStream_ParticleSplitting,
+    CpuRandomStream_CellMaxForce,
+    CpuRandomStream_CellRadiation,
+    CpuRandomStream_CellDecay,
+};
+
+/**
+ * Counter-based random numbers: the result only depends on the arguments and not on the processing order.
+ * This makes the simulation deterministic regardless of the number of threads.
+ */
+class CpuRandom
+{
+public:
+    CpuRandom(uint64_t timestep, uint64_t entityId, CpuRandomStream stream)
+        : _state(mix(timestep * 0x9e3779b97f4a7c15ull ^ mix(entityId + (static_cast<uint64_t>(stream) << 56))))
+    {}
+
+    float random()  //returns value in [0, 1)
+    {
+        _state = mix(_state + 0x9e3779b97f4a7c15ull);
+        return static_cast<float>(_state >> 40) / static_cast<float>(1 << 24);
+    }
+
+    float random(float maxValue) { return random() * maxValue; }
+    float random(float minValue, float maxValue) { return minValue + random() * (maxValue - minValue); }
+
+private:
+    static uint64_t mix(uint64_t z)
+    {
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    uint64_t _state;
+};
@@ -0,0 +1,57 @@
+#include "CpuSimulationProcessor.h"
+
+#include "CpuCellFunctionProcessor.h"
+#include "CpuCellProcessor.h"
+#include "CpuRadiationProcessor.h"
+
+void CpuSimulationProcessor::calcTimestep(CpuSimulationData& data, SimulationParameters const& parameters, ThreadPool& threadPool)
+{
+    //not all passes need to be executed in each time step for performance reasons
+    bool considerForcesFromAngleDifferences = (data.timestep % 3 == 0);
+    bool considerInnerFriction = (data.timestep % 3 == 0);
+
+    CpuStructuralOperations operations;
+
+    CpuRadiationProcessor::calcActiveSources(data, parameters);
+    updateMap(data, parameters);
+    CpuCellProcessor::radiation(data, parameters, threadPool);
+    if (parameters.motionType == MotionType_Fluid) {
+        CpuCellProcessor::calcFluidForces(data, parameters, threadPool, operations);
+    } else {
+        CpuCellProcessor::calcCollisionForces(data, parameters, threadPool, operations);
+    }
+    CpuCellProcessor::checkForces(data, parameters, threadPool, operations);
+    CpuCellProcessor::applyForces(data, parameters, threadPool);
+    CpuRadiationProcessor::movement(data, parameters, threadPool);
+    CpuRadiationProcessor::collision(data, parameters, threadPool);
+
+    CpuCellProcessor::calcConnectionForces(data, parameters, threadPool, considerForcesFromAngleDifferences);
+    CpuCellProcessor::verletPositionUpdate(data, parameters, threadPool);
+    CpuCellProcessor::checkConnections(data, parameters, threadPool, operations);
+    CpuRadiationProcessor::splitting(data, parameters, threadPool);
+    CpuCellProcessor::calcConnectionForces(data, parameters, threadPool, considerForcesFromAngleDifferences);
+    CpuCellProcessor::verletVelocityUpdate(data, parameters, threadPool);
+
+    //cell functions
+    CpuCellProcessor::aging(data, parameters, threadPool);
+    CpuCellProcessor::livingStateTransition(data, parameters, threadPool);
+    CpuCellFunctionProcessor::process(data, parameters, threadPool);
+
+    if (considerInnerFriction) {
+        CpuCellProcessor::applyInnerFriction(data, parameters, threadPool);
+    }
+    CpuCellFunctionProcessor::resetFetchedSignals(data, parameters, threadPool);
+    CpuCellProcessor::applyFriction(data, parameters, threadPool);
+    CpuCellProcessor::decay(data, parameters, threadPool, operations);
+
+    std::vector<CpuNewParticle> newParticles;
+    CpuCellConnectionProcessor::processOperations(data, parameters, operations, newParticles);
+    CpuRadiationProcessor::addParticles(data, newParticles);
+}
+
+void CpuSimulationProcessor::updateMap(CpuSimulationData& data, SimulationParameters const& parameters)
+{
+    auto maxInteractionDistance = parameters.motionType == MotionType_Fluid ? parameters.motionData.fluidMotion.smoothingLength * 2
+                                                                             : parameters.motionData.collisionMotion.cellMaxCollisionDistance;
+    data.cellMap.rebuild(data.cells.pos, maxInteractionDistance);
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "EngineInterface/SimulationParameters.h"
+
+#include "CpuCellConnectionProcessor.h"
+#include "CpuSimulationData.h"
+#include "Definitions.h"
+
+/**
+ * Host counterpart of the SimulationKernelsLauncher: executes the passes of one time step in the order of the kernel code.
+ */
+class CpuSimulationProcessor
+{
+public:
+    static void calcTimestep(CpuSimulationData& data, SimulationParameters const& parameters, ThreadPool& threadPool);
+
+    //has to be called whenever cells have been added, removed or moved outside of calcTimestep
+    static void updateMap(CpuSimulationData& data, SimulationParameters const& parameters);
+};
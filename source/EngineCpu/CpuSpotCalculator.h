@@ -0,0 +1,141 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include "EngineInterface/SimulationParameters.h"
+
+#include "CpuMap.h"
+
+/**
+ * Host counterpart of the SpotCalculator in the kernel code.
+ */
+class CpuSpotCalculator
+{
+public:
+    static float calcParameter(
+        float SimulationParametersZoneValues::*value,
+        bool SimulationParametersZoneActivatedValues::*valueActivated,
+        SimulationParameters const& parameters,
+        CpuMap const& map,
+        RealVector2D const& worldPos)
+    {
+        if (0 == parameters.numZones) {
+            return parameters.baseValues.*value;
+        }
+        float spotValues[MAX_ZONES];
+        float spotWeights[MAX_ZONES];
+        int numValues = 0;
+        for (int i = 0; i < parameters.numZones; ++i) {
+            auto const& zone = parameters.zone[i];
+            if (zone.activatedValues.*valueActivated) {
+                spotValues[numValues] = zone.values.*value;
+                spotWeights[numValues] = calcWeight(parameters, map, worldPos, i);
+                ++numValues;
+            }
+        }
+        return mix(parameters.baseValues.*value, spotValues, spotWeights, numValues);
+    }
+
+    static float calcParameter(
+        ColorVector<float> SimulationParametersZoneValues::*value,
+        bool SimulationParametersZoneActivatedValues::*valueActivated,
+        SimulationParameters const& parameters,
+        CpuMap const& map,
+        RealVector2D const& worldPos,
+        int color)
+    {
+        if (0 == parameters.numZones) {
+            return (parameters.baseValues.*value)[color];
+        }
+        float spotValues[MAX_ZONES];
+        float spotWeights[MAX_ZONES];
+        int numValues = 0;
+        for (int i = 0; i < parameters.numZones; ++i) {
+            auto const& zone = parameters.zone[i];
+            if (zone.activatedValues.*valueActivated) {
+                spotValues[numValues] = (zone.values.*value)[color];
+                spotWeights[numValues] = calcWeight(parameters, map, worldPos, i);
+                ++numValues;
+            }
+        }
+        return mix((parameters.baseValues.*value)[color], spotValues, spotWeights, numValues);
+    }
+
+    static bool calcParameter(
+        bool SimulationParametersZoneValues::*value,
+        bool SimulationParametersZoneActivatedValues::*valueActivated,
+        SimulationParameters const& parameters,
+        CpuMap const& map,
+        RealVector2D const& worldPos)
+    {
+        if (0 == parameters.numZones) {
+            return parameters.baseValues.*value;
+        }
+        float spotValues[MAX_ZONES];
+        float spotWeights[MAX_ZONES];
+        int numValues = 0;
+        for (int i = 0; i < parameters.numZones; ++i) {
+            auto const& zone = parameters.zone[i];
+            if (zone.activatedValues.*valueActivated) {
+                spotValues[numValues] = zone.values.*value ? 1.0f : 0.0f;
+                spotWeights[numValues] = calcWeight(parameters, map, worldPos, i);
+                ++numValues;
+            }
+        }
+        return mix(parameters.baseValues.*value ? 1.0f : 0.0f, spotValues, spotWeights, numValues) > 0.5f;
+    }
+
+    //return -1 for base
+    static int getFirstMatchingSpotOrBase(
+        SimulationParameters const& parameters,
+        CpuMap const& map,
+        RealVector2D const& worldPos,
+        bool SimulationParametersZoneActivatedValues::*valueActivated)
+    {
+        for (int i = 0; i < parameters.numZones; ++i) {
+            if (parameters.zone[i].activatedValues.*valueActivated) {
+                if (calcWeight(parameters, map, worldPos, i) < NEAR_ZERO) {
+                    return i;
+                }
+            }
+        }
+        return -1;
+    }
+
+private:
+    static float calcWeight(SimulationParameters const& parameters, CpuMap const& map, RealVector2D const& worldPos, int spotIndex)
+    {
+        auto const& spot = parameters.zone[spotIndex];
+        auto delta = map.getCorrectedDirection(RealVector2D{spot.posX, spot.posY} - worldPos);
+        if (spot.shapeType == SpotShapeType_Rectangular) {
+            auto const& rect = spot.shapeData.rectangularSpot;
+            if (std::abs(delta.x) > rect.width / 2 || std::abs(delta.y) > rect.height / 2) {
+                RealVector2D distanceFromRect{
+                    std::max(0.0f, std::abs(delta.x) - rect.width / 2), std::max(0.0f, std::abs(delta.y) - rect.height / 2)};
+                return std::min(1.0f, std::sqrt(distanceFromRect.x * distanceFromRect.x + distanceFromRect.y * distanceFromRect.y) / (spot.fadeoutRadius + 1));
+            }
+            return 0.0f;
+        } else {
+            auto distance = std::sqrt(delta.x * delta.x + delta.y * delta.y);
+            auto coreRadius = spot.shapeData.circularSpot.coreRadius;
+            return distance < coreRadius ? 0.0f : std::min(1.0f, (distance - coreRadius) / (spot.fadeoutRadius + 1));
+        }
+    }
+
+    static float mix(float baseValue, float (&spotValues)[MAX_ZONES], float (&spotWeights)[MAX_ZONES], int numValues)
+    {
+        float baseFactor = 1;
+        float sum = 0;
+        for (int i = 0; i < numValues; ++i) {
+            baseFactor *= spotWeights[i];
+            sum += 1.0f - spotWeights[i];
+        }
+        sum += baseFactor;
+        auto result = baseValue * baseFactor;
+        for (int i = 0; i < numValues; ++i) {
+            result += spotValues[i] * (1.0f - spotWeights[i]) / sum;
+        }
+        return result;
+    }
+};
@@ -0,0 +1,114 @@
+#include "CpuStatisticsProcessor.h"
+
+#include <algorithm>
+
+#include "Base/ThreadPool.h"
+
+#include "CpuCellProcessor.h"
+
+namespace
+{
+    struct GenomeInfo
+    {
+        int cellIndex;
+        bool isReplicator;
+        bool isVirus;
+    };
+}
+
+RawStatisticsData CpuStatisticsProcessor::calcStatistics(CpuSimulationData const& data, ThreadPool& threadPool)
+{
+    RawStatisticsData result;
+    calcTimestepStatistics(data, threadPool, result.timeline.timestep);
+    result.timeline.accumulated = data.accumulatedStatistics;
+    calcHistogram(data, result.histogram);
+    return result;
+}
+
+void CpuStatisticsProcessor::calcTimestepStatistics(CpuSimulationData const& data, ThreadPool& threadPool, TimestepStatistics& statistics)
+{
+    auto const& cells = data.cells;
+    auto const& particles = data.particles;
+
+    //decoding the genomes is the expensive part and therefore done in parallel
+    auto genomeInfos = threadPool.parallelCollect<GenomeInfo>(
+        cells.size(),
+        [&](size_t startIndex, size_t endIndex, std::vector<GenomeInfo>& result) {
+            for (auto index = startIndex; index < endIndex; ++index) {
+                auto const& properties = cells.properties[index];
+                if (properties.cellFunction == CellFunction_Constructor) {
+                    auto const& constructor = properties.cellFunctionData.constructor;
+                    if (CpuCellProcessor::containsSelfReplication(data, constructor.genomeDataIndex, constructor.genomeSize)) {
+                        result.emplace_back(GenomeInfo{toInt(index), true, false});
+                    }
+                } else if (properties.cellFunction == CellFunction_Injector) {
+                    auto const& injector = properties.cellFunctionData.injector;
+                    if (CpuCellProcessor::containsSelfReplication(data, injector.genomeDataIndex, injector.genomeSize)) {
+                        result.emplace_back(GenomeInfo{toInt(index), false, true});
+                    }
+                }
+            }
+        },
+        64);
+
+    for (size_t index = 0; index < cells.size(); ++index) {
+        auto color = cells.color[index];
+        ++statistics.numCells[color];
+        if (cells.properties[index].mutationId == Const::MutationIdForFreeCell) {
+            ++statistics.numFreeCells[color];
+        }
+        statistics.totalEnergy[color] += cells.energy[index];
+    }
+
+    int numReplicators = 0;
+    double summedGenomeComplexity = 0;
+    for (auto const& genomeInfo : genomeInfos) {
+        auto color = cells.color[genomeInfo.cellIndex];
+        if (genomeInfo.isReplicator) {
+            auto genomeComplexity = cells.properties[genomeInfo.cellIndex].genomeComplexity;
+            ++statistics.numSelfReplicators[color];
+            statistics.genomeComplexity[color] += genomeComplexity;
+            summedGenomeComplexity += genomeComplexity;
+            ++numReplicators;
+        }
+        if (genomeInfo.isVirus) {
+            ++statistics.numViruses[color];
+        }
+    }
+    if (numReplicators > 0) {
+        auto averageGenomeComplexity = summedGenomeComplexity / numReplicators;
+        for (auto const& genomeInfo : genomeInfos) {
+            if (genomeInfo.isReplicator) {
+                auto variance = toDouble(cells.properties[genomeInfo.cellIndex].genomeComplexity) - averageGenomeComplexity;
+                statistics.genomeComplexityVariance[cells.color[genomeInfo.cellIndex]] += variance * variance / numReplicators;
+            }
+        }
+    }
+
+    for (size_t index = 0; index < particles.size(); ++index) {
+        auto color = particles.color[index];
+        ++statistics.numParticles[color];
+        statistics.totalEnergy[color] += particles.energy[index];
+    }
+}
+
+void CpuStatisticsProcessor::calcHistogram(CpuSimulationData const& data, HistogramData& histogram)
+{
+    auto const& cells = data.cells;
+
+    histogram.maxValue = 0;
+    for (int color = 0; color < MAX_COLORS; ++color) {
+        std::fill(std::begin(histogram.numCellsByColorBySlot[color]), std::end(histogram.numCellsByColorBySlot[color]), 0);
+    }
+    for (size_t index = 0; index < cells.size(); ++index) {
+        if (!cells.barrier[index]) {
+            histogram.maxValue = std::max(histogram.maxValue, toInt(cells.age[index]));
+        }
+    }
+    for (size_t index = 0; index < cells.size(); ++index) {
+        if (!cells.barrier[index]) {
+            auto slot = static_cast<uint64_t>(cells.age[index]) * MAX_HISTOGRAM_SLOTS / (histogram.maxValue + 1);
+            ++histogram.numCellsByColorBySlot[cells.color[index]][slot];
+        }
+    }
+}
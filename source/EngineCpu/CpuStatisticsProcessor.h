@@ -0,0 +1,19 @@
+#pragma once
+
+#include "EngineInterface/RawStatisticsData.h"
+
+#include "CpuSimulationData.h"
+#include "Definitions.h"
+
+/**
+ * Host counterpart of the StatisticsKernels. Colonies and genome sizes are not tracked by the CPU backend.
+ */
+class CpuStatisticsProcessor
+{
+public:
+    static RawStatisticsData calcStatistics(CpuSimulationData const& data, ThreadPool& threadPool);
+
+private:
+    static void calcTimestepStatistics(CpuSimulationData const& data, ThreadPool& threadPool, TimestepStatistics& statistics);
+    static void calcHistogram(CpuSimulationData const& data, HistogramData& histogram);
+};
@@ -0,0 +1,97 @@
+#include "CpuSupportChecker.h"
+
+#include <cmath>
+#include <set>
+#include <stdexcept>
+
+#include "Base/Definitions.h"
+
+namespace
+{
+    std::string getCellFunctionName(CellFunction cellFunction)
+    {
+        switch (cellFunction) {
+        case CellFunction_Neuron:
+            return "neuron";
+        case CellFunction_Transmitter:
+            return "transmitter";
+        case CellFunction_Constructor:
+            return "constructor";
+        case CellFunction_Sensor:
+            return "sensor";
+        case CellFunction_Nerve:
+            return "nerve";
+        case CellFunction_Attacker:
+            return "attacker";
+        case CellFunction_Injector:
+            return "injector";
+        case CellFunction_Muscle:
+            return "muscle";
+        case CellFunction_Defender:
+            return "defender";
+        case CellFunction_Reconnector:
+            return "reconnector";
+        case CellFunction_Detonator:
+            return "detonator";
+        }
+        return "none";
+    }
+}
+
+bool CpuSupportChecker::isCellFunctionSupported(CellFunction cellFunction)
+{
+    return cellFunction == CellFunction_None || cellFunction == CellFunction_Neuron || cellFunction == CellFunction_Nerve;
+}
+
+void CpuSupportChecker::checkSimulationData(DataTO const& dataTO)
+{
+    std::set<CellFunction> unsupportedCellFunctions;
+    for (uint64_t i = 0; i < *dataTO.numCells; ++i) {
+        auto cellFunction = dataTO.cells[i].cellFunction;
+        if (!isCellFunctionSupported(cellFunction)) {
+            unsupportedCellFunctions.insert(cellFunction);
+        }
+    }
+    if (unsupportedCellFunctions.empty()) {
+        return;
+    }
+    std::string names;
+    for (auto const& cellFunction : unsupportedCellFunctions) {
+        names += (names.empty() ? "" : ", ") + getCellFunctionName(cellFunction);
+    }
+    throw std::runtime_error("The CPU backend only supports nerve and neuron cells, but the simulation contains " + names + " cells.");
+}
+
+std::vector<std::string> CpuSupportChecker::getUnsupportedParameters(SimulationParameters const& parameters)
+{
+    std::vector<std::string> result;
+
+    auto externalEnergyPresent = parameters.externalEnergy > 0;
+    for (int i = 0; i < MAX_COLORS; ++i) {
+        externalEnergyPresent |= parameters.externalEnergyBackflowFactor[i] > 0;
+    }
+    if (parameters.features.externalEnergyControl && externalEnergyPresent) {
+        result.emplace_back("external energy");
+    }
+
+    auto movingZones = false;
+    for (int i = 0; i < parameters.numZones; ++i) {
+        movingZones |= std::abs(parameters.zone[i].velX) > NEAR_ZERO || std::abs(parameters.zone[i].velY) > NEAR_ZERO;
+    }
+    if (movingZones) {
+        result.emplace_back("moving zones");
+    }
+
+    auto movingRadiationSources = false;
+    for (int i = 0; i < parameters.numRadiationSources; ++i) {
+        movingRadiationSources |= std::abs(parameters.radiationSource[i].velX) > NEAR_ZERO || std::abs(parameters.radiationSource[i].velY) > NEAR_ZERO;
+    }
+    if (movingRadiationSources) {
+        result.emplace_back("moving radiation sources");
+    }
+
+    if (parameters.cellMaxAgeBalancer) {
+        result.emplace_back("max age balancer");
+    }
+    return result;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "EngineInterface/SimulationParameters.h"
+
+#include "CpuSimulationData.h"
+
+/**
+ * The CPU backend only simulates the physics and the nerve and neuron functions. The checks make these gaps visible
+ * instead of simulating a world silently different from the CUDA backend.
+ */
+class CpuSupportChecker
+{
+public:
+    static bool isCellFunctionSupported(CellFunction cellFunction);
+
+    //throws if the data contains cells with cell functions which are not supported
+    static void checkSimulationData(DataTO const& dataTO);
+
+    //returns the names of the used features which are ignored by the CPU backend
+    static std::vector<std::string> getUnsupportedParameters(SimulationParameters const& parameters);
+};
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <memory>
+
+#include "Base/Definitions.h"
+
+class _SimulationCpuFacade;
+using CpuSimulationFacade = std::shared_ptr<_SimulationCpuFacade>;
+
+struct CpuSimulationData;
+class CpuMap;
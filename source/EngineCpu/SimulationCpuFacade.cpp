@@ -0,0 +1,413 @@
+#include "SimulationCpuFacade.h"
+
+#include <algorithm>
+#include <fstream>
+#include <thread>
+
+#include "Base/LoggingService.h"
+#include "Base/ThreadPool.h"
+
+#include "EngineInterface/SimulationParametersEditService.h"
+#include "EngineInterface/StatisticsService.h"
+
+#include "CpuCellProcessor.h"
+#include "CpuDataAccessProcessor.h"
+#include "CpuEditProcessor.h"
+#include "CpuSimulationProcessor.h"
+#include "CpuStatisticsProcessor.h"
+#include "CpuSupportChecker.h"
+
+namespace
+{
+    std::chrono::milliseconds const StatisticsUpdate(30);
+
+    RealVector2D toRealVector2D(float2 const& v)
+    {
+        return {v.x, v.y};
+    }
+
+    IntVector2D toIntVector2D(int2 const& v)
+    {
+        return {v.x, v.y};
+    }
+}
+
+std::string _SimulationCpuFacade::getCpuName()
+{
+    std::string result;
+#if defined(__linux__)
+    std::ifstream cpuInfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuInfo, line)) {
+        if (line.rfind("model name", 0) == 0) {
+            auto pos = line.find(':');
+            if (pos != std::string::npos && pos + 2 <= line.size()) {
+                result = line.substr(pos + 2);
+            }
+            break;
+        }
+    }
+#endif
+    if (result.empty()) {
+        result = "CPU";
+    }
+    return result + " (" + std::to_string(std::thread::hardware_concurrency()) + " hardware threads)";
+}
+
+_SimulationCpuFacade::_SimulationCpuFacade(uint64_t timestep, Settings const& settings, int numThreads)
+{
+    _threadPool = std::make_shared<ThreadPool>(numThreads);
+    log(Priority::Important, "initialize CPU simulation with " + std::to_string(_threadPool->getNumThreads()) + " threads");
+
+    _settings = settings;
+    _data.timestep = timestep;
+    _data.cellMap.init({settings.generalSettings.worldSizeX, settings.generalSettings.worldSizeY});
+
+    //default array sizes for empty simulation (will be resized later if not sufficient)
+    _arraySizes = {100000, 100000, 100000};
+
+    logUnsupportedParameters();
+}
+
+_SimulationCpuFacade::~_SimulationCpuFacade()
+{
+    _threadPool.reset();
+    log(Priority::Important, "simulation closed");
+}
+
+void* _SimulationCpuFacade::registerImageResource(GLuint image)
+{
+    return nullptr;
+}
+
+void _SimulationCpuFacade::calcTimestep(uint64_t timesteps, bool forceUpdateStatistics)
+{
+    for (uint64_t i = 0; i < timesteps; ++i) {
+        checkAndProcessSimulationParameterChanges();
+
+        CpuSimulationProcessor::calcTimestep(_data, _settings.simulationParameters, *_threadPool);
+
+        {
+            std::lock_guard lock(_mutexForSimulationData);
+            ++_data.timestep;
+        }
+        automaticResizeArrays();
+
+        auto now = std::chrono::steady_clock::now();
+        if (!_lastStatisticsUpdateTime || now - *_lastStatisticsUpdateTime > StatisticsUpdate) {
+            _lastStatisticsUpdateTime = now;
+            updateStatistics();
+        }
+    }
+    if (forceUpdateStatistics) {
+        updateStatistics();
+    }
+}
+
+void _SimulationCpuFacade::applyCataclysm(int power)
+{
+    //a cataclysm only mutates the genomes of constructor cells, which are rejected by the CPU backend
+}
+
+void _SimulationCpuFacade::drawVectorGraphics(
+    float2 const& rectUpperLeft,
+    float2 const& rectLowerRight,
+    void* cudaResource,
+    int2 const& imageSize,
+    double zoom)
+{
+    checkAndProcessSimulationParameterChanges();
+}
+
+void _SimulationCpuFacade::getSimulationData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataTO const& dataTO)
+{
+    CpuDataAccessProcessor::getData(_data, toIntVector2D(rectUpperLeft), toIntVector2D(rectLowerRight), dataTO);
+}
+
+void _SimulationCpuFacade::getSelectedSimulationData(bool includeClusters, DataTO const& dataTO)
+{
+    CpuDataAccessProcessor::getSelectedData(_data, includeClusters, dataTO);
+}
+
+void _SimulationCpuFacade::getInspectedSimulationData(std::vector<uint64_t> entityIds, DataTO const& dataTO)
+{
+    CpuDataAccessProcessor::getInspectedData(_data, entityIds, dataTO);
+}
+
+void _SimulationCpuFacade::getOverlayData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataTO const& dataTO)
+{
+    CpuDataAccessProcessor::getOverlayData(_data, toIntVector2D(rectUpperLeft), toIntVector2D(rectLowerRight), dataTO);
+}
+
+void _SimulationCpuFacade::addAndSelectSimulationData(DataTO const& dataTO)
+{
+    CpuSupportChecker::checkSimulationData(dataTO);
+    CpuEditProcessor::removeSelection(_data, false);
+    CpuDataAccessProcessor::addData(_data, dataTO, true, true);
+    CpuEditProcessor::rolloutSelection(_data);
+    updateMap();
+    updateStatistics();
+}
+
+void _SimulationCpuFacade::setSimulationData(DataTO const& dataTO)
+{
+    CpuSupportChecker::checkSimulationData(dataTO);
+    CpuDataAccessProcessor::clearData(_data);
+    CpuDataAccessProcessor::addData(_data, dataTO, false, false);
+    updateMap();
+    updateStatistics();
+}
+
+void _SimulationCpuFacade::removeSelectedObjects(bool includeClusters)
+{
+    CpuEditProcessor::removeSelectedObjects(_data, includeClusters);
+    updateMap();
+    updateStatistics();
+}
+
+void _SimulationCpuFacade::relaxSelectedObjects(bool includeClusters)
+{
+    CpuEditProcessor::relaxSelectedObjects(_data, includeClusters);
+}
+
+void _SimulationCpuFacade::uniformVelocitiesForSelectedObjects(bool includeClusters)
+{
+    CpuEditProcessor::uniformVelocities(_data, includeClusters);
+}
+
+void _SimulationCpuFacade::makeSticky(bool includeClusters)
+{
+    CpuEditProcessor::makeSticky(_data, includeClusters);
+}
+
+void _SimulationCpuFacade::removeStickiness(bool includeClusters)
+{
+    CpuEditProcessor::removeStickiness(_data, includeClusters);
+}
+
+void _SimulationCpuFacade::setBarrier(bool value, bool includeClusters)
+{
+    CpuEditProcessor::setBarrier(_data, value, includeClusters);
+}
+
+void _SimulationCpuFacade::changeInspectedSimulationData(DataTO const& changeDataTO)
+{
+    CpuSupportChecker::checkSimulationData(changeDataTO);
+    CpuDataAccessProcessor::changeData(_data, changeDataTO);
+    updateMap();
+    updateStatistics();
+
+    resizeArraysIfNecessary();
+}
+
+void _SimulationCpuFacade::applyForce(ApplyForceData const& applyData)
+{
+    CpuEditProcessor::applyForce(
+        _data, toRealVector2D(applyData.startPos), toRealVector2D(applyData.endPos), toRealVector2D(applyData.force), applyData.radius);
+}
+
+void _SimulationCpuFacade::switchSelection(PointSelectionData const& switchData)
+{
+    CpuEditProcessor::switchSelection(_data, toRealVector2D(switchData.pos), switchData.radius);
+}
+
+void _SimulationCpuFacade::swapSelection(PointSelectionData const& selectionData)
+{
+    CpuEditProcessor::swapSelection(_data, toRealVector2D(selectionData.pos), selectionData.radius);
+}
+
+void _SimulationCpuFacade::setSelection(AreaSelectionData const& selectionData)
+{
+    CpuEditProcessor::setSelection(_data, toRealVector2D(selectionData.startPos), toRealVector2D(selectionData.endPos));
+}
+
+SelectionShallowData _SimulationCpuFacade::getSelectionShallowData()
+{
+    return CpuEditProcessor::getSelectionShallowData(_data, _settings.simulationParameters);
+}
+
+void _SimulationCpuFacade::shallowUpdateSelectedObjects(ShallowUpdateSelectionData const& shallowUpdateData)
+{
+    CpuEditProcessor::shallowUpdateSelectedObjects(_data, _settings.simulationParameters, shallowUpdateData);
+    updateMap();
+
+    updateStatistics();
+}
+
+void _SimulationCpuFacade::removeSelection()
+{
+    CpuEditProcessor::removeSelection(_data, false);
+
+    updateStatistics();
+}
+
+void _SimulationCpuFacade::updateSelection()
+{
+    CpuEditProcessor::updateSelection(_data);
+}
+
+void _SimulationCpuFacade::colorSelectedObjects(unsigned char color, bool includeClusters)
+{
+    CpuEditProcessor::colorSelectedCells(_data, color, includeClusters);
+
+    updateStatistics();
+}
+
+void _SimulationCpuFacade::reconnectSelectedObjects()
+{
+    CpuEditProcessor::reconnect(_data, _settings.simulationParameters);
+}
+
+void _SimulationCpuFacade::setDetached(bool value)
+{
+    CpuEditProcessor::setDetached(_data, value);
+}
+
+void _SimulationCpuFacade::setGpuConstants(GpuSettings const& gpuConstants)
+{
+    _settings.gpuSettings = gpuConstants;
+}
+
+SimulationParameters _SimulationCpuFacade::getSimulationParameters() const
+{
+    std::lock_guard lock(_mutexForSimulationParameters);
+    return _newSimulationParameters ? *_newSimulationParameters : _settings.simulationParameters;
+}
+
+void _SimulationCpuFacade::setSimulationParameters(SimulationParameters const& parameters, SimulationParametersUpdateConfig const& updateConfig)
+{
+    std::lock_guard lock(_mutexForSimulationParameters);
+    _newSimulationParameters = parameters;
+    _simulationParametersUpdateConfig = updateConfig;
+}
+
+auto _SimulationCpuFacade::getArraySizes() const -> ArraySizes
+{
+    return _arraySizes;
+}
+
+RawStatisticsData _SimulationCpuFacade::getRawStatistics()
+{
+    std::lock_guard lock(_mutexForStatistics);
+    if (_statisticsData) {
+        return *_statisticsData;
+    } else {
+        return RawStatisticsData();
+    }
+}
+
+void _SimulationCpuFacade::updateStatistics()
+{
+    auto statistics = CpuStatisticsProcessor::calcStatistics(_data, *_threadPool);
+    {
+        std::lock_guard lock(_mutexForStatistics);
+        _statisticsData = statistics;
+    }
+    StatisticsService::get().addDataPoint(_statisticsHistory, statistics.timeline, getCurrentTimestep());
+}
+
+StatisticsHistory const& _SimulationCpuFacade::getStatisticsHistory() const
+{
+    return _statisticsHistory;
+}
+
+void _SimulationCpuFacade::setStatisticsHistory(StatisticsHistoryData const& data)
+{
+    StatisticsService::get().rewriteHistory(_statisticsHistory, data, getCurrentTimestep());
+}
+
+void _SimulationCpuFacade::resetTimeIntervalStatistics()
+{
+    _data.accumulatedStatistics = AccumulatedStatistics();
+}
+
+uint64_t _SimulationCpuFacade::getCurrentTimestep() const
+{
+    std::lock_guard lock(_mutexForSimulationData);
+    return _data.timestep;
+}
+
+void _SimulationCpuFacade::setCurrentTimestep(uint64_t timestep)
+{
+    {
+        std::lock_guard lock(_mutexForSimulationData);
+        _data.timestep = timestep;
+    }
+    StatisticsService::get().resetTime(_statisticsHistory, timestep);
+}
+
+void _SimulationCpuFacade::clear()
+{
+    CpuDataAccessProcessor::clearData(_data);
+    updateMap();
+}
+
+void _SimulationCpuFacade::resizeArraysIfNecessary(ArraySizes const& additionals)
+{
+    //the simulation data grows on demand, only the capacity reported for the transfer objects has to be adapted
+    ArraySizes requiredSizes{
+        _data.cells.size() + additionals.cellArraySize,
+        _data.particles.size() + additionals.particleArraySize,
+        _data.auxiliaryData.size() + additionals.auxiliaryDataSize};
+    if (requiredSizes.cellArraySize > _arraySizes.cellArraySize || requiredSizes.particleArraySize > _arraySizes.particleArraySize
+        || requiredSizes.auxiliaryDataSize > _arraySizes.auxiliaryDataSize) {
+        _arraySizes.cellArraySize = std::max(_arraySizes.cellArraySize, requiredSizes.cellArraySize * 2);
+        _arraySizes.particleArraySize = std::max(_arraySizes.particleArraySize, requiredSizes.particleArraySize * 2);
+        _arraySizes.auxiliaryDataSize = std::max(_arraySizes.auxiliaryDataSize, requiredSizes.auxiliaryDataSize * 2);
+        log(Priority::Unimportant, "transfer object sizes: " + std::to_string(_arraySizes.cellArraySize) + " cells, " + std::to_string(_arraySizes.particleArraySize) + " particles, "
+            + std::to_string(_arraySizes.auxiliaryDataSize) + " bytes auxiliary data");
+    }
+}
+
+void _SimulationCpuFacade::testOnly_mutate(uint64_t cellId, MutationType mutationType)
+{
+    throw std::runtime_error("Mutations are not supported by the CPU backend.");
+}
+
+void _SimulationCpuFacade::testOnly_mutationCheck(uint64_t cellId)
+{
+    throw std::runtime_error("Mutations are not supported by the CPU backend.");
+}
+
+void _SimulationCpuFacade::automaticResizeArrays()
+{
+    //make check after every 10th time step
+    if (getCurrentTimestep() % 10 == 0) {
+        resizeArraysIfNecessary();
+    }
+}
+
+void _SimulationCpuFacade::checkAndProcessSimulationParameterChanges()
+{
+    std::lock_guard lock(_mutexForSimulationParameters);
+    if (_newSimulationParameters) {
+        _settings.simulationParameters =
+            SimulationParametersEditService::get().integrateChanges(_settings.simulationParameters, *_newSimulationParameters, _simulationParametersUpdateConfig);
+        _newSimulationParameters.reset();
+
+        CpuCellProcessor::resetDensity(_data);
+        updateMap();
+        logUnsupportedParameters();
+    }
+}
+
+void _SimulationCpuFacade::logUnsupportedParameters()
+{
+    auto unsupportedParameters = CpuSupportChecker::getUnsupportedParameters(_settings.simulationParameters);
+    if (unsupportedParameters == _unsupportedParameters) {
+        return;
+    }
+    _unsupportedParameters = unsupportedParameters;
+    if (!unsupportedParameters.empty()) {
+        std::string names;
+        for (auto const& name : unsupportedParameters) {
+            names += (names.empty() ? "" : ", ") + name;
+        }
+        log(Priority::Important, "the CPU backend ignores the following simulation parameters: " + names);
+    }
+}
+
+void _SimulationCpuFacade::updateMap()
+{
+    CpuSimulationProcessor::updateMap(_data, _settings.simulationParameters);
+}
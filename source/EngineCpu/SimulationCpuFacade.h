@@ -0,0 +1,122 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+#include <GL/gl.h>
+
+#include "EngineInterface/ArraySizes.h"
+#include "EngineInterface/MutationType.h"
+#include "EngineInterface/RawStatisticsData.h"
+#include "EngineInterface/SelectionShallowData.h"
+#include "EngineInterface/Settings.h"
+#include "EngineInterface/ShallowUpdateSelectionData.h"
+#include "EngineInterface/SimulationParametersUpdateConfig.h"
+#include "EngineInterface/StatisticsHistory.h"
+#include "EngineGpuKernels/Definitions.cuh"
+
+#include "CpuSimulationData.h"
+#include "Definitions.h"
+
+/**
+ * Multi-threaded CPU counterpart of _SimulationCudaFacade with the same interface.
+ * The physics and the nerve and neuron functions are simulated. Data with other cell functions is rejected and ignored parameters are logged.
+ * The results do not depend on the number of threads.
+ */
+class _SimulationCpuFacade
+{
+public:
+    static std::string getCpuName();
+
+    _SimulationCpuFacade(uint64_t timestep, Settings const& settings, int numThreads);
+    ~_SimulationCpuFacade();
+
+    void* registerImageResource(GLuint image);
+
+    void calcTimestep(uint64_t timesteps, bool forceUpdateStatistics);
+    void applyCataclysm(int power);
+
+    void drawVectorGraphics(float2 const& rectUpperLeft, float2 const& rectLowerRight, void* cudaResource, int2 const& imageSize, double zoom);
+    void getSimulationData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataTO const& dataTO);
+    void getSelectedSimulationData(bool includeClusters, DataTO const& dataTO);
+    void getInspectedSimulationData(std::vector<uint64_t> entityIds, DataTO const& dataTO);
+    void getOverlayData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataTO const& dataTO);
+    void addAndSelectSimulationData(DataTO const& dataTO);
+    void setSimulationData(DataTO const& dataTO);
+    void removeSelectedObjects(bool includeClusters);
+    void relaxSelectedObjects(bool includeClusters);
+    void uniformVelocitiesForSelectedObjects(bool includeClusters);
+    void makeSticky(bool includeClusters);
+    void removeStickiness(bool includeClusters);
+    void setBarrier(bool value, bool includeClusters);
+    void changeInspectedSimulationData(DataTO const& changeDataTO);
+
+    void applyForce(ApplyForceData const& applyData);
+    void switchSelection(PointSelectionData const& switchData);
+    void swapSelection(PointSelectionData const& selectionData);
+    void setSelection(AreaSelectionData const& selectionData);
+    SelectionShallowData getSelectionShallowData();
+    void shallowUpdateSelectedObjects(ShallowUpdateSelectionData const& shallowUpdateData);
+    void removeSelection();
+    void updateSelection();
+    void colorSelectedObjects(unsigned char color, bool includeClusters);
+    void reconnectSelectedObjects();
+    void setDetached(bool value);
+
+    void setGpuConstants(GpuSettings const& cudaConstants);
+    SimulationParameters getSimulationParameters() const;
+    void setSimulationParameters(
+        SimulationParameters const& parameters,
+        SimulationParametersUpdateConfig const& updateConfig = SimulationParametersUpdateConfig::All);
+
+    ArraySizes getArraySizes() const;
+
+    RawStatisticsData getRawStatistics();
+    void updateStatistics();
+    StatisticsHistory const& getStatisticsHistory() const;
+    void setStatisticsHistory(StatisticsHistoryData const& data);
+
+    void resetTimeIntervalStatistics();
+    uint64_t getCurrentTimestep() const;
+    void setCurrentTimestep(uint64_t timestep);
+
+    void clear();
+
+    void resizeArraysIfNecessary(ArraySizes const& additionals = ArraySizes());
+
+    // only for tests
+    void testOnly_mutate(uint64_t cellId, MutationType mutationType);
+    void testOnly_mutationCheck(uint64_t cellId);
+
+private:
+    void automaticResizeArrays();
+    void checkAndProcessSimulationParameterChanges();
+    void updateMap();
+    void logUnsupportedParameters();
+
+    mutable std::mutex _mutexForSimulationParameters;
+    std::optional<SimulationParameters> _newSimulationParameters;
+    SimulationParametersUpdateConfig _simulationParametersUpdateConfig = SimulationParametersUpdateConfig::All;
+
+    Settings _settings;
+    std::vector<std::string> _unsupportedParameters;
+
+    mutable std::mutex _mutexForSimulationData;
+    CpuSimulationData _data;
+    ArraySizes _arraySizes;
+
+    mutable std::mutex _mutexForStatistics;
+    std::optional<std::chrono::steady_clock::time_point> _lastStatisticsUpdateTime;
+    std::optional<RawStatisticsData> _statisticsData;
+    StatisticsHistory _statisticsHistory;
+
+    std::shared_ptr<ThreadPool> _threadPool;
+};
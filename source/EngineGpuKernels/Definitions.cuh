@@ -4,6 +4,8 @@
 
 #include "EngineInterface/ArraySizes.h"
 
+#include "VectorTypes.h"
+
 struct Cell;
 struct Token;
 struct Particle;
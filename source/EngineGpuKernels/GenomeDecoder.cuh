@@ -3,6 +3,7 @@
 #include <nppdefs.h>
 
 #include "EngineInterface/CellFunctionConstants.h"
+#include "EngineInterface/GenomeAnalysis.h"
 #include "EngineInterface/GenomeConstants.h"
 #include "Base.cuh"
 #include "Object.cuh"
@@ -97,7 +98,7 @@ public:
     __inline__ __device__ static float convertByteToAngle(uint8_t b);
     __inline__ __device__ static uint8_t convertOptionalByteToByte(int value);
 
-    static auto constexpr MAX_SUBGENOME_RECURSION_DEPTH = 15;
+    static auto constexpr MAX_SUBGENOME_RECURSION_DEPTH = GenomeAnalysis::MAX_SUBGENOME_RECURSION_DEPTH;
 
 private:
     __inline__ __device__ static int findStartNodeAddress(uint8_t* genome, int genomeSize, int refIndex);
@@ -109,11 +110,7 @@ private:
 template <typename Func>
 __inline__ __device__ void GenomeDecoder::executeForEachNode(uint8_t* genome, int genomeSize, Func func)
 {
-    for (int currentNodeAddress = Const::GenomeHeaderSize; currentNodeAddress < genomeSize;) {
-        currentNodeAddress += Const::CellBasicBytes + GenomeDecoder::getNextCellFunctionDataSize(genome, genomeSize, currentNodeAddress);
-
-        func(currentNodeAddress);
-    }
+    GenomeAnalysis::executeForEachNode(genome, genomeSize, func);
 }
 
 template <typename Func>
@@ -121,68 +118,17 @@ __inline__ __device__ void GenomeDecoder::executeForEachNodeRecursively(uint8_t*
 {
     CUDA_CHECK(genomeSize >= Const::GenomeHeaderSize)
 
-    int subGenomeEndAddresses[MAX_SUBGENOME_RECURSION_DEPTH];
-    int subGenomeNumRepetitions[MAX_SUBGENOME_RECURSION_DEPTH + 1];
-    int depth = 0;
-    subGenomeNumRepetitions[0] = GenomeDecoder::getNumRepetitions(genome, true);
-    for (auto nodeAddress = Const::GenomeHeaderSize; nodeAddress < genomeSize;) {
-        auto cellFunction = GenomeDecoder::getNextCellFunctionType(genome, nodeAddress);
-        func(depth, nodeAddress, subGenomeNumRepetitions[depth]);
-
-        bool goToNextSibling = true;
-        if (cellFunction == CellFunction_Constructor || cellFunction == CellFunction_Injector) {
-            auto cellFunctionFixedBytes = cellFunction == CellFunction_Constructor ? Const::ConstructorFixedBytes : Const::InjectorFixedBytes;
-            auto makeSelfCopy = GenomeDecoder::convertByteToBool(genome[nodeAddress + Const::CellBasicBytes + cellFunctionFixedBytes]);
-            if (!makeSelfCopy) {
-                auto deltaSubGenomeStartPos = Const::CellBasicBytes + cellFunctionFixedBytes + 3;
-                if (!includedSeparatedParts && GenomeDecoder::isSeparating(genome + nodeAddress + deltaSubGenomeStartPos)) {
-                    //skip scanning sub-genome
-                } else {
-                    auto subGenomeSize = GenomeDecoder::getNextSubGenomeSize(genome, genomeSize, nodeAddress);
-                    nodeAddress += deltaSubGenomeStartPos;
-                    subGenomeEndAddresses[depth++] = nodeAddress + subGenomeSize;
-
-                    auto numBrachnes = countBranches ? GenomeDecoder::getNumBranches(genome + nodeAddress) : 1;
-                    auto numRepetitions = GenomeDecoder::getNumRepetitions(genome + nodeAddress, true);
-                    subGenomeNumRepetitions[depth] = subGenomeNumRepetitions[depth - 1] * numRepetitions * numBrachnes;
-                    nodeAddress += Const::GenomeHeaderSize;
-                    goToNextSibling = false;
-                }
-            }
-        }
-        if (goToNextSibling) {
-            nodeAddress += Const::CellBasicBytes + GenomeDecoder::getNextCellFunctionDataSize(genome, genomeSize, nodeAddress);
-        }
-        for (int i = 0; i < MAX_SUBGENOME_RECURSION_DEPTH && depth > 0; ++i) {
-            if (depth > 0) {
-                if (subGenomeEndAddresses[depth - 1] == nodeAddress) {
-                    --depth;
-                } else {
-                    break;
-                }
-            }
-        }
-    }
+    GenomeAnalysis::executeForEachNodeRecursively(genome, genomeSize, includedSeparatedParts, countBranches, func);
 }
 
 __inline__ __device__ int GenomeDecoder::getGenomeDepth(uint8_t* genome, int genomeSize)
 {
-    auto result = 0;
-    executeForEachNodeRecursively(genome, genomeSize, true, false, [&result](int depth, int nodeAddress, int repetition) { result = max(result, depth); });
-    return result;
+    return GenomeAnalysis::getGenomeDepth(genome, genomeSize);
 }
 
 __inline__ __device__ int GenomeDecoder::getNumNodesRecursively(uint8_t* genome, int genomeSize, bool includeRepetitions, bool includedSeparatedParts)
 {
-    auto result = 0;
-    if (!includeRepetitions) {
-        executeForEachNodeRecursively(
-            genome, genomeSize, includedSeparatedParts, true, [&result](int depth, int nodeAddress, int repetitions) { ++result; });
-    } else {
-        executeForEachNodeRecursively(
-            genome, genomeSize, includedSeparatedParts, true, [&result](int depth, int nodeAddress, int repetitions) { result += repetitions; });
-    }
-    return result;
+    return GenomeAnalysis::getNumNodesRecursively(genome, genomeSize, includeRepetitions, includedSeparatedParts);
 }
 
 __inline__ __device__ int GenomeDecoder::getRandomGenomeNodeAddress(
@@ -194,59 +140,10 @@ __inline__ __device__ int GenomeDecoder::getRandomGenomeNodeAddress(
     int* numSubGenomesSizeIndices,
     int randomRefIndex)
 {
-    if (numSubGenomesSizeIndices) {
-        *numSubGenomesSizeIndices = 0;
-    }
     CUDA_CHECK(genomeSize >= Const::GenomeHeaderSize)
 
-    if (genomeSize == Const::GenomeHeaderSize) {
-        return Const::GenomeHeaderSize;
-    }
-    if (randomRefIndex == 0) {
-        randomRefIndex = data.numberGen1.random(genomeSize - 1);
-    }
-
-    int result = 0;
-    for (int depth = 0; depth < MAX_SUBGENOME_RECURSION_DEPTH; ++depth) {
-        auto nodeAddress = findStartNodeAddress(genome, genomeSize, randomRefIndex);
-        result += nodeAddress;
-        auto cellFunction = getNextCellFunctionType(genome, nodeAddress);
-
-        if (cellFunction == CellFunction_Constructor || cellFunction == CellFunction_Injector) {
-            auto cellFunctionFixedBytes = cellFunction == CellFunction_Constructor ? Const::ConstructorFixedBytes : Const::InjectorFixedBytes;
-            auto makeSelfCopy = GenomeDecoder::convertByteToBool(genome[nodeAddress + Const::CellBasicBytes + cellFunctionFixedBytes]);
-            if (makeSelfCopy) {
-                break;
-            } else {
-                if (nodeAddress + Const::CellBasicBytes + cellFunctionFixedBytes > randomRefIndex) {
-                    break;
-                }
-                if (numSubGenomesSizeIndices) {
-                    subGenomesSizeIndices[*numSubGenomesSizeIndices] = result + Const::CellBasicBytes + cellFunctionFixedBytes + 1;
-                    ++(*numSubGenomesSizeIndices);
-                }
-                auto subGenomeStartIndex = nodeAddress + Const::CellBasicBytes + cellFunctionFixedBytes + 3;
-                auto subGenomeSize = getNextSubGenomeSize(genome, genomeSize, nodeAddress);
-                if (subGenomeSize == Const::GenomeHeaderSize) {
-                    if (considerZeroSubGenomes && data.numberGen1.randomBool()) {
-                        result += Const::CellBasicBytes + cellFunctionFixedBytes + 3 + Const::GenomeHeaderSize;
-                    } else {
-                        if (numSubGenomesSizeIndices) {
-                            --(*numSubGenomesSizeIndices);
-                        }
-                    }
-                    break;
-                }
-                genomeSize = subGenomeSize;
-                genome = genome + subGenomeStartIndex;
-                randomRefIndex -= subGenomeStartIndex;
-                result += Const::CellBasicBytes + cellFunctionFixedBytes + 3;
-            }
-        } else {
-            break;
-        }
-    }
-    return result;
+    return GenomeAnalysis::getRandomGenomeNodeAddress(
+        data.numberGen1, genome, genomeSize, considerZeroSubGenomes, subGenomesSizeIndices, numSubGenomesSizeIndices, randomRefIndex);
 }
 
 __inline__ __device__ bool GenomeDecoder::readBool(ConstructorFunction& constructor, int& genomeBytePosition)
@@ -372,35 +269,23 @@ __inline__ __device__ void GenomeDecoder::copyGenome(SimulationData& data, CellF
 
 __inline__ __device__ bool GenomeDecoder::isSeparating(uint8_t* genome)
 {
-    return GenomeDecoder::convertByteToBool(genome[Const::GenomeHeaderSeparationPos]);
+    return GenomeAnalysis::isSeparating(genome);
 }
 
 __inline__ __device__ int GenomeDecoder::getNumBranches(uint8_t* genome)
 {
-    return isSeparating(genome) ? 1 : (genome[Const::GenomeHeaderNumBranchesPos] + 5) % 6 + 1;
+    return GenomeAnalysis::getNumBranches(genome);
 }
 
 __inline__ __device__ int GenomeDecoder::getNumRepetitions(uint8_t* genome, bool countInfinityAsOne)
 {
-    int result = max(1, toInt(genome[Const::GenomeHeaderNumRepetitionsPos]));
-    if (!countInfinityAsOne) {
-        return result == 255 ? NPP_MAX_32S : result;
-    } else {
-        return result == 255 ? 1 : result;
-    }
+    return GenomeAnalysis::getNumRepetitions(genome, countInfinityAsOne);
 }
 
 template <typename ConstructorOrInjector>
 __inline__ __device__ bool GenomeDecoder::containsSelfReplication(ConstructorOrInjector const& cellFunction)
 {
-    for (int currentNodeAddress = Const::GenomeHeaderSize; currentNodeAddress < cellFunction.genomeSize;) {
-        if (isNextCellSelfReplication(cellFunction.genome, currentNodeAddress)) {
-            return true;
-        }
-        currentNodeAddress += Const::CellBasicBytes + getNextCellFunctionDataSize(cellFunction.genome, cellFunction.genomeSize, currentNodeAddress);
-    }
-
-    return false;
+    return GenomeAnalysis::containsSelfReplication(cellFunction.genome, cellFunction.genomeSize);
 }
 
 __inline__ __device__ GenomeHeader GenomeDecoder::readGenomeHeader(ConstructorFunction const& constructor)
@@ -442,7 +327,7 @@ __inline__ __device__ uint8_t GenomeDecoder::convertFloatToByte(float v)
 
 __inline__ __device__ bool GenomeDecoder::convertByteToBool(uint8_t b)
 {
-    return static_cast<int8_t>(b) > 0;
+    return GenomeAnalysis::convertByteToBool(b);
 }
 
 __inline__ __device__ uint8_t GenomeDecoder::convertBoolToByte(bool value)
@@ -452,7 +337,7 @@ __inline__ __device__ uint8_t GenomeDecoder::convertBoolToByte(bool value)
 
 __inline__ __device__ int GenomeDecoder::convertBytesToWord(uint8_t b1, uint8_t b2)
 {
-    return static_cast<int>(b1) | (static_cast<int>(b2 << 8));
+    return GenomeAnalysis::convertBytesToWord(b1, b2);
 }
 
 __inline__ __device__ void GenomeDecoder::convertWordToBytes(int word, uint8_t& b1, uint8_t& b2)
@@ -507,107 +392,33 @@ __inline__ __device__ void GenomeDecoder::setRandomCellFunctionData(
 
 __inline__ __device__ int GenomeDecoder::getNumNodes(uint8_t* genome, int genomeSize)
 {
-    int result = 0;
-    int currentNodeAddress = Const::GenomeHeaderSize;
-    for (; result < genomeSize && currentNodeAddress < genomeSize; ++result) {
-        currentNodeAddress += Const::CellBasicBytes + getNextCellFunctionDataSize(genome, genomeSize, currentNodeAddress);
-    }
-
-    return result;
+    return GenomeAnalysis::getNumNodes(genome, genomeSize);
 }
 
 __inline__ __device__ int GenomeDecoder::getNodeAddress(uint8_t* genome, int genomeSize, int nodeIndex)
 {
-    int currentNodeAddress = Const::GenomeHeaderSize;
-    for (int currentNodeIndex = 0; currentNodeIndex < nodeIndex; ++currentNodeIndex) {
-        if (currentNodeAddress >= genomeSize) {
-            break;
-        }
-        currentNodeAddress += Const::CellBasicBytes + getNextCellFunctionDataSize(genome, genomeSize, currentNodeAddress);
-    }
-
-    return currentNodeAddress;
+    return GenomeAnalysis::getNodeAddress(genome, genomeSize, nodeIndex);
 }
 
 
 __inline__ __device__ int GenomeDecoder::findStartNodeAddress(uint8_t* genome, int genomeSize, int refIndex)
 {
-    int currentNodeAddress = Const::GenomeHeaderSize;
-    for (; currentNodeAddress <= refIndex;) {
-        auto prevCurrentNodeAddress = currentNodeAddress;
-        currentNodeAddress += Const::CellBasicBytes + getNextCellFunctionDataSize(genome, genomeSize, currentNodeAddress);
-        if (currentNodeAddress > refIndex) {
-            return prevCurrentNodeAddress;
-        }
-    }
-    return Const::GenomeHeaderSize;
+    return GenomeAnalysis::findStartNodeAddress(genome, genomeSize, refIndex);
 }
 
 __inline__ __device__ int GenomeDecoder::getNextCellFunctionDataSize(uint8_t* genome, int genomeSize, int nodeAddress, bool withSubgenome)
 {
-    auto cellFunction = getNextCellFunctionType(genome, nodeAddress);
-    switch (cellFunction) {
-    case CellFunction_Neuron:
-        return Const::NeuronBytes;
-    case CellFunction_Transmitter:
-        return Const::TransmitterBytes;
-    case CellFunction_Constructor: {
-        if (withSubgenome) {
-            auto isMakeCopy = GenomeDecoder::convertByteToBool(genome[nodeAddress + Const::CellBasicBytes + Const::ConstructorFixedBytes]);
-            if (isMakeCopy) {
-                return Const::ConstructorFixedBytes + 1;
-            } else {
-                return Const::ConstructorFixedBytes + 3 + getNextSubGenomeSize(genome, genomeSize, nodeAddress);
-            }
-        } else {
-            return Const::ConstructorFixedBytes;
-        }
-    }
-    case CellFunction_Sensor:
-        return Const::SensorBytes;
-    case CellFunction_Nerve:
-        return Const::NerveBytes;
-    case CellFunction_Attacker:
-        return Const::AttackerBytes;
-    case CellFunction_Injector: {
-        if (withSubgenome) {
-            auto isMakeCopy = GenomeDecoder::convertByteToBool(genome[nodeAddress + Const::CellBasicBytes + Const::InjectorFixedBytes]);
-            if (isMakeCopy) {
-                return Const::InjectorFixedBytes + 1;
-            } else {
-                return Const::InjectorFixedBytes + 3 + getNextSubGenomeSize(genome, genomeSize, nodeAddress);
-            }
-        } else {
-            return Const::InjectorFixedBytes;
-        }
-    }
-    case CellFunction_Muscle:
-        return Const::MuscleBytes;
-    case CellFunction_Defender:
-        return Const::DefenderBytes;
-    case CellFunction_Reconnector:
-        return Const::ReconnectorBytes;
-    case CellFunction_Detonator:
-        return Const::DetonatorBytes;
-    default:
-        return 0;
-    }
+    return GenomeAnalysis::getNextCellFunctionDataSize(genome, genomeSize, nodeAddress, withSubgenome);
 }
 
 __inline__ __device__ CellFunction GenomeDecoder::getNextCellFunctionType(uint8_t* genome, int nodeAddress)
 {
-    return genome[nodeAddress] % CellFunction_Count;
+    return GenomeAnalysis::getNextCellFunctionType(genome, nodeAddress);
 }
 
 __inline__ __device__ bool GenomeDecoder::isNextCellSelfReplication(uint8_t* genome, int nodeAddress)
 {
-    switch (getNextCellFunctionType(genome, nodeAddress)) {
-    case CellFunction_Constructor:
-        return GenomeDecoder::convertByteToBool(genome[nodeAddress + Const::CellBasicBytes + Const::ConstructorFixedBytes]);
-    case CellFunction_Injector:
-        return GenomeDecoder::convertByteToBool(genome[nodeAddress + Const::CellBasicBytes + Const::InjectorFixedBytes]);
-    }
-    return false;
+    return GenomeAnalysis::isNextCellSelfReplication(genome, nodeAddress);
 }
 
 __inline__ __device__ int GenomeDecoder::getNextCellColor(uint8_t* genome, int nodeAddress)
@@ -707,67 +518,20 @@ __inline__ __device__ void GenomeDecoder::setNextConstructorNumRepetitions(uint8
 
 __inline__ __device__ int GenomeDecoder::getNextSubGenomeSize(uint8_t* genome, int genomeSize, int nodeAddress)
 {
-    auto cellFunction = getNextCellFunctionType(genome, nodeAddress);
-    auto cellFunctionFixedBytes = cellFunction == CellFunction_Constructor ? Const::ConstructorFixedBytes : Const::InjectorFixedBytes;
-    auto subGenomeSizeIndex = nodeAddress + Const::CellBasicBytes + cellFunctionFixedBytes + 1;
-    return max(min(GenomeDecoder::convertBytesToWord(genome[subGenomeSizeIndex], genome[subGenomeSizeIndex + 1]), genomeSize - (subGenomeSizeIndex + 2)), 0);
+    return GenomeAnalysis::getNextSubGenomeSize(genome, genomeSize, nodeAddress);
 }
 
 __inline__ __device__ int GenomeDecoder::getCellFunctionDataSize(CellFunction cellFunction, bool makeSelfCopy, int genomeSize)
 {
-    switch (cellFunction) {
-    case CellFunction_Neuron:
-        return Const::NeuronBytes;
-    case CellFunction_Transmitter:
-        return Const::TransmitterBytes;
-    case CellFunction_Constructor: {
-        return makeSelfCopy ? Const::ConstructorFixedBytes + 1 : Const::ConstructorFixedBytes + 3 + genomeSize;
-    }
-    case CellFunction_Sensor:
-        return Const::SensorBytes;
-    case CellFunction_Nerve:
-        return Const::NerveBytes;
-    case CellFunction_Attacker:
-        return Const::AttackerBytes;
-    case CellFunction_Injector: {
-        return makeSelfCopy ? Const::InjectorFixedBytes + 1 : Const::InjectorFixedBytes + 3 + genomeSize;
-    }
-    case CellFunction_Muscle:
-        return Const::MuscleBytes;
-    case CellFunction_Defender:
-        return Const::DefenderBytes;
-    case CellFunction_Reconnector:
-        return Const::ReconnectorBytes;
-    case CellFunction_Detonator:
-        return Const::DetonatorBytes;
-    default:
-        return 0;
-    }
+    return GenomeAnalysis::getCellFunctionDataSize(cellFunction, makeSelfCopy, genomeSize);
 }
 
 __inline__ __device__ bool GenomeDecoder::containsSectionSelfReplication(uint8_t* genome, int genomeSize)
 {
-    int nodeAddress = 0;
-    for (; nodeAddress < genomeSize;) {
-        if (isNextCellSelfReplication(genome, nodeAddress)) {
-            return true;
-        }
-        nodeAddress += Const::CellBasicBytes + getNextCellFunctionDataSize(genome, genomeSize, nodeAddress);
-    }
-
-    return false;
+    return GenomeAnalysis::containsSectionSelfReplication(genome, genomeSize);
 }
 
 __inline__ __device__ int GenomeDecoder::getNodeAddressForSelfReplication(uint8_t* genome, int genomeSize, bool& containsSelfReplicator)
 {
-    int nodeAddress = 0;
-    for (; nodeAddress < genomeSize;) {
-        if (isNextCellSelfReplication(genome, nodeAddress)) {
-            containsSelfReplicator = true;
-            return nodeAddress;
-        }
-        nodeAddress += Const::CellBasicBytes + getNextCellFunctionDataSize(genome, genomeSize, nodeAddress);
-    }
-    containsSelfReplicator = false;
-    return 0;
+    return GenomeAnalysis::getNodeAddressForSelfReplication(genome, genomeSize, containsSelfReplicator);
 }
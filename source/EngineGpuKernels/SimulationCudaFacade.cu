@@ -15,8 +15,10 @@
 
 #include "EngineInterface/InspectedEntityIds.h"
 #include "EngineInterface/SimulationParameters.h"
+#include "EngineInterface/SimulationParametersEditService.h"
 #include "EngineInterface/GpuSettings.h"
 #include "EngineInterface/SpaceCalculator.h"
+#include "EngineInterface/StatisticsService.h"
 
 #include "DataAccessKernels.cuh"
 #include "TOs.cuh"
@@ -40,7 +42,6 @@
 #include "RenderingData.cuh"
 #include "SimulationParametersUpdateService.cuh"
 #include "TestKernelsLauncher.cuh"
-#include "StatisticsService.cuh"
 #include "MaxAgeBalancer.cuh"
 
 namespace
@@ -659,7 +660,7 @@ void _SimulationCudaFacade::checkAndProcessSimulationParameterChanges()
     std::lock_guard lock(_mutexForSimulationParameters);
     if (_newSimulationParameters) {
         _settings.simulationParameters =
-            SimulationParametersUpdateService::get().integrateChanges(_settings.simulationParameters, *_newSimulationParameters, _simulationParametersUpdateConfig);
+            SimulationParametersEditService::get().integrateChanges(_settings.simulationParameters, *_newSimulationParameters, _simulationParametersUpdateConfig);
         CHECK_FOR_CUDA_ERROR(
             cudaMemcpyToSymbol(cudaSimulationParameters, &_settings.simulationParameters, sizeof(SimulationParameters), 0, cudaMemcpyHostToDevice));
         _newSimulationParameters.reset();
@@ -4,7 +4,6 @@
 
 #include "EngineInterface/RawStatisticsData.h"
 #include "EngineInterface/Settings.h"
-#include "EngineInterface/SimulationParametersUpdateConfig.h"
 
 #include "Definitions.cuh"
 
@@ -13,11 +12,6 @@ class SimulationParametersUpdateService
     MAKE_SINGLETON(SimulationParametersUpdateService);
 
 public:
-    SimulationParameters integrateChanges(
-        SimulationParameters const& currentParameters,
-        SimulationParameters const& changedParameters,
-        SimulationParametersUpdateConfig const& updateConfig) const;
-
     bool updateSimulationParametersAfterTimestep(
         Settings& settings,
         MaxAgeBalancer const& maxAgeBalancer,
@@ -1,12 +1,13 @@
 #pragma once
 
-#include <cuda_runtime.h>
 #include <stdint.h>
 
 #include "EngineInterface/EngineConstants.h"
 #include "EngineInterface/CellFunctionConstants.h"
 #include "EngineInterface/ArraySizes.h"
 
+#include "VectorTypes.h"
+
 struct ParticleTO
 {
 	uint64_t id;
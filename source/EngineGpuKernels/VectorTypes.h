@@ -0,0 +1,16 @@
+#pragma once
+
+//the transfer objects are shared with host-only targets such as the CPU backend, which may be built without the CUDA toolkit
+#if defined(__CUDACC__) || __has_include(<vector_types.h>)
+#include <vector_types.h>
+#else
+struct alignas(8) float2
+{
+    float x, y;
+};
+
+struct alignas(8) int2
+{
+    int x, y;
+};
+#endif
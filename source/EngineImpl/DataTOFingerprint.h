@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+//ids and content hashes of the cells and particles written by the DataTOSerializer
+struct DataTOFingerprint
+{
+    std::vector<std::pair<uint64_t, uint64_t>> cellHashes;  //sorted by ids
+    std::vector<std::pair<uint64_t, uint64_t>> particleHashes;  //sorted by ids
+};
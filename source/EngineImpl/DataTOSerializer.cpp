@@ -0,0 +1,723 @@
+#include "DataTOSerializer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "Base/NumberGenerator.h"
+#include "Base/Resources.h"
+#include "EngineInterface/GenomeConstants.h"
+#include "PersisterInterface/ColumnarSnapshot.h"
+#include "PersisterInterface/ColumnarSnapshotService.h"
+
+namespace
+{
+    auto constexpr NeuronDataSize = sizeof(float) * MAX_CHANNELS * (MAX_CHANNELS + 1);
+
+    template <typename T, typename Func>
+    std::vector<T> getColumn(uint64_t size, Func const& func)
+    {
+        std::vector<T> result;
+        result.reserve(size);
+        for (uint64_t i = 0; i < size; ++i) {
+            result.emplace_back(static_cast<T>(func(i)));
+        }
+        return result;
+    }
+
+    template <typename T>
+    std::vector<T> readColumn(ColumnarSnapshotReader const& reader, ColumnarSnapshotSection section, uint64_t expectedSize)
+    {
+        auto result = reader.readSection<T>(section);
+        if (result.size() != expectedSize) {
+            throw std::runtime_error("Section " + std::to_string(section) + " of columnar snapshot has an unexpected size.");
+        }
+        return result;
+    }
+
+    template <typename T, typename Func>
+    void readColumn(ColumnarSnapshotReader const& reader, ColumnarSnapshotSection section, uint64_t expectedSize, Func const& func)
+    {
+        auto column = readColumn<T>(reader, section, expectedSize);
+        for (uint64_t i = 0; i < expectedSize; ++i) {
+            func(i, column[i]);
+        }
+    }
+
+    void checkAndCorrectInvalidEnergy(float& energy)
+    {
+        if (std::isnan(energy) || energy < 0 || energy > 1e12) {
+            energy = 0;
+        }
+    }
+
+    //FNV-1a hash of the written values, provides the interfaces of ColumnarByteWriter and ColumnarGenomeWriter used by writeCellFunction
+    class ContentHash
+    {
+    public:
+        template <typename T>
+        void write(T const& value)
+        {
+            add(std::span<uint8_t const>(reinterpret_cast<uint8_t const*>(&value), sizeof(T)));
+        }
+        void write(std::optional<int> const& value) { write(value.value_or(-1)); }
+        template <typename T>
+        void writeVector(std::vector<T> const& values)
+        {
+            write(static_cast<uint32_t>(values.size()));
+            add(std::span<uint8_t const>(reinterpret_cast<uint8_t const*>(values.data()), values.size() * sizeof(T)));
+        }
+        void add(std::span<uint8_t const> bytes)
+        {
+            for (auto const& byte : bytes) {
+                _value ^= byte;
+                _value *= 1099511628211ull;
+            }
+        }
+
+        uint64_t getValue() const { return _value; }
+
+    private:
+        uint64_t _value = 14695981039346656037ull;
+    };
+
+    template <typename Writer, typename GenomeWriter>
+    void writeCellFunction(Writer& writer, GenomeWriter& genomeWriter, DataTO const& dataTO, CellTO const& cell)
+    {
+        auto writeGenome = [&](uint16_t genomeSize, uint64_t genomeDataIndex) {
+            genomeWriter.add(std::span<uint8_t const>(dataTO.auxiliaryData + genomeDataIndex, genomeSize));
+        };
+        auto writeOptional = [&](bool hasValue, int value) { writer.write(hasValue ? std::make_optional(value) : std::nullopt); };
+
+        auto const& data = cell.cellFunctionData;
+        switch (cell.cellFunction) {
+        case CellFunction_Neuron: {
+            float weightsAndBiases[MAX_CHANNELS * (MAX_CHANNELS + 1)];
+            std::memcpy(weightsAndBiases, dataTO.auxiliaryData + data.neuron.weightsAndBiasesDataIndex, NeuronDataSize);
+            writer.write(static_cast<uint32_t>(MAX_CHANNELS));
+            for (int row = 0; row < MAX_CHANNELS + 1; ++row) {
+                writer.writeVector(std::vector<float>(weightsAndBiases + row * MAX_CHANNELS, weightsAndBiases + (row + 1) * MAX_CHANNELS));
+            }
+            writer.writeVector(std::vector<NeuronActivationFunction>(data.neuron.activationFunctions, data.neuron.activationFunctions + MAX_CHANNELS));
+        } break;
+        case CellFunction_Transmitter: {
+            writer.write(data.transmitter.mode);
+        } break;
+        case CellFunction_Constructor: {
+            auto const& constructor = data.constructor;
+            writer.write(static_cast<int>(constructor.activationMode));
+            writer.write(static_cast<int>(constructor.constructionActivationTime));
+            writer.write(static_cast<int>(constructor.numInheritedGenomeNodes));
+            writer.write(static_cast<int>(constructor.genomeGeneration));
+            writer.write(constructor.constructionAngle1);
+            writer.write(constructor.constructionAngle2);
+            writer.write(constructor.lastConstructedCellId);
+            writer.write(static_cast<int>(constructor.genomeCurrentNodeIndex));
+            writer.write(static_cast<int>(constructor.genomeCurrentRepetition));
+            writer.write(static_cast<int>(constructor.currentBranch));
+            writer.write(static_cast<int>(constructor.offspringCreatureId));
+            writer.write(static_cast<int>(constructor.offspringMutationId));
+            writeGenome(constructor.genomeSize, constructor.genomeDataIndex);
+        } break;
+        case CellFunction_Sensor: {
+            auto const& sensor = data.sensor;
+            writer.write(sensor.minDensity);
+            writeOptional(sensor.minRange >= 0, sensor.minRange);
+            writeOptional(sensor.maxRange >= 0, sensor.maxRange);
+            writeOptional(sensor.restrictToColor != 255, sensor.restrictToColor);
+            writer.write(sensor.restrictToMutants);
+            writer.write(sensor.memoryChannel1);
+            writer.write(sensor.memoryChannel2);
+            writer.write(sensor.memoryChannel3);
+            writer.write(sensor.memoryTargetX);
+            writer.write(sensor.memoryTargetY);
+        } break;
+        case CellFunction_Nerve: {
+            writer.write(static_cast<int>(data.nerve.pulseMode));
+            writer.write(static_cast<int>(data.nerve.alternationMode));
+        } break;
+        case CellFunction_Attacker: {
+            writer.write(data.attacker.mode);
+        } break;
+        case CellFunction_Injector: {
+            auto const& injector = data.injector;
+            writer.write(injector.mode);
+            writer.write(static_cast<int>(injector.counter));
+            writer.write(static_cast<int>(injector.genomeGeneration));
+            writeGenome(injector.genomeSize, injector.genomeDataIndex);
+        } break;
+        case CellFunction_Muscle: {
+            auto const& muscle = data.muscle;
+            writer.write(muscle.mode);
+            writer.write(muscle.lastBendingDirection);
+            writer.write(static_cast<int>(muscle.lastBendingSourceIndex));
+            writer.write(muscle.consecutiveBendingAngle);
+            writer.write(muscle.lastMovementX);
+            writer.write(muscle.lastMovementY);
+        } break;
+        case CellFunction_Defender: {
+            writer.write(data.defender.mode);
+        } break;
+        case CellFunction_Reconnector: {
+            writeOptional(data.reconnector.restrictToColor != 255, data.reconnector.restrictToColor);
+            writer.write(data.reconnector.restrictToMutants);
+        } break;
+        case CellFunction_Detonator: {
+            writer.write(data.detonator.state);
+            writer.write(static_cast<int>(data.detonator.countdown));
+        } break;
+        }
+    }
+
+    class AuxiliaryDataWriter
+    {
+    public:
+        AuxiliaryDataWriter(DataTO const& dataTO)
+            : _dataTO(dataTO)
+        {}
+
+        uint64_t append(uint8_t const* source, uint64_t size)
+        {
+            auto result = *_dataTO.numAuxiliaryData;
+            std::memcpy(_dataTO.auxiliaryData + result, source, size);
+            *_dataTO.numAuxiliaryData += size;
+            return result;
+        }
+
+    private:
+        DataTO const& _dataTO;
+    };
+
+    void readCellFunction(
+        ColumnarByteReader& reader,
+        AuxiliaryDataWriter& auxiliaryDataWriter,
+        ColumnarGenomeReader& genomeReader,
+        std::vector<std::optional<uint64_t>>& genomeDataIndices,
+        CellTO& cell)
+    {
+        //cells referencing the same genome share its auxiliary data
+        auto readGenome = [&](uint16_t& genomeSize, uint64_t& genomeDataIndex) {
+            auto id = genomeReader.readNextId();
+            auto genome = genomeReader.getGenome(id);
+            CHECK(genome.size() >= Const::GenomeHeaderSize);
+            genomeSize = static_cast<uint16_t>(genome.size());
+            if (!genomeDataIndices.at(id)) {
+                genomeDataIndices.at(id) = auxiliaryDataWriter.append(genome.data(), genome.size());
+            }
+            genomeDataIndex = *genomeDataIndices.at(id);
+        };
+        auto readOptional = [&](int noValue) { return reader.readOptional().value_or(noValue); };
+
+        auto& data = cell.cellFunctionData;
+        switch (cell.cellFunction) {
+        case CellFunction_Neuron: {
+            float weightsAndBiases[MAX_CHANNELS * (MAX_CHANNELS + 1)];
+            if (reader.read<uint32_t>() != MAX_CHANNELS) {
+                throw std::runtime_error("Unexpected neuron size in columnar snapshot.");
+            }
+            for (int row = 0; row < MAX_CHANNELS + 1; ++row) {
+                auto values = reader.readVector<float>();
+                if (values.size() != MAX_CHANNELS) {
+                    throw std::runtime_error("Unexpected neuron size in columnar snapshot.");
+                }
+                std::copy(values.begin(), values.end(), weightsAndBiases + row * MAX_CHANNELS);
+            }
+            data.neuron.weightsAndBiasesDataIndex = auxiliaryDataWriter.append(reinterpret_cast<uint8_t const*>(weightsAndBiases), NeuronDataSize);
+            auto activationFunctions = reader.readVector<NeuronActivationFunction>();
+            if (activationFunctions.size() != MAX_CHANNELS) {
+                throw std::runtime_error("Unexpected neuron size in columnar snapshot.");
+            }
+            std::copy(activationFunctions.begin(), activationFunctions.end(), data.neuron.activationFunctions);
+        } break;
+        case CellFunction_Transmitter: {
+            data.transmitter.mode = reader.read<EnergyDistributionMode>();
+        } break;
+        case CellFunction_Constructor: {
+            auto& constructor = data.constructor;
+            constructor.activationMode = reader.read<int>();
+            constructor.constructionActivationTime = reader.read<int>();
+            constructor.numInheritedGenomeNodes = static_cast<uint16_t>(reader.read<int>());
+            constructor.genomeGeneration = reader.read<int>();
+            constructor.constructionAngle1 = reader.read<float>();
+            constructor.constructionAngle2 = reader.read<float>();
+            constructor.lastConstructedCellId = reader.read<uint64_t>();
+            constructor.genomeCurrentNodeIndex = static_cast<uint16_t>(reader.read<int>());
+            constructor.genomeCurrentRepetition = static_cast<uint16_t>(reader.read<int>());
+            constructor.currentBranch = static_cast<uint8_t>(reader.read<int>());
+            constructor.offspringCreatureId = reader.read<int>();
+            constructor.offspringMutationId = reader.read<int>();
+            readGenome(constructor.genomeSize, constructor.genomeDataIndex);
+        } break;
+        case CellFunction_Sensor: {
+            auto& sensor = data.sensor;
+            sensor.minDensity = reader.read<float>();
+            sensor.minRange = static_cast<int8_t>(readOptional(-1));
+            sensor.maxRange = static_cast<int8_t>(readOptional(-1));
+            sensor.restrictToColor = static_cast<uint8_t>(readOptional(255));
+            sensor.restrictToMutants = reader.read<SensorRestrictToMutants>();
+            sensor.memoryChannel1 = reader.read<float>();
+            sensor.memoryChannel2 = reader.read<float>();
+            sensor.memoryChannel3 = reader.read<float>();
+            sensor.memoryTargetX = reader.read<float>();
+            sensor.memoryTargetY = reader.read<float>();
+        } break;
+        case CellFunction_Nerve: {
+            data.nerve.pulseMode = static_cast<uint8_t>(reader.read<int>());
+            data.nerve.alternationMode = static_cast<uint8_t>(reader.read<int>());
+        } break;
+        case CellFunction_Attacker: {
+            data.attacker.mode = reader.read<EnergyDistributionMode>();
+        } break;
+        case CellFunction_Injector: {
+            auto& injector = data.injector;
+            injector.mode = reader.read<InjectorMode>();
+            injector.counter = reader.read<int>();
+            injector.genomeGeneration = reader.read<int>();
+            readGenome(injector.genomeSize, injector.genomeDataIndex);
+        } break;
+        case CellFunction_Muscle: {
+            auto& muscle = data.muscle;
+            muscle.mode = reader.read<MuscleMode>();
+            muscle.lastBendingDirection = reader.read<MuscleBendingDirection>();
+            muscle.lastBendingSourceIndex = static_cast<uint8_t>(reader.read<int>());
+            muscle.consecutiveBendingAngle = reader.read<float>();
+            muscle.lastMovementX = reader.read<float>();
+            muscle.lastMovementY = reader.read<float>();
+        } break;
+        case CellFunction_Defender: {
+            data.defender.mode = reader.read<DefenderMode>();
+        } break;
+        case CellFunction_Reconnector: {
+            data.reconnector.restrictToColor = static_cast<uint8_t>(readOptional(255));
+            data.reconnector.restrictToMutants = reader.read<ReconnectorRestrictToMutants>();
+        } break;
+        case CellFunction_Detonator: {
+            data.detonator.state = reader.read<DetonatorState>();
+            data.detonator.countdown = reader.read<int>();
+        } break;
+        case CellFunction_None:
+            break;
+        default:
+            throw std::runtime_error("Unknown cell function in columnar snapshot.");
+        }
+    }
+
+    void addSections(
+        ColumnarSnapshotWriter& writer,
+        DataTO const& dataTO,
+        std::vector<uint64_t> const& cellIndices,
+        std::vector<uint64_t> const& particleIndices)
+    {
+        auto const numCells = cellIndices.size();
+        auto const cells = dataTO.cells;
+
+        writer.addSection(ColumnarSnapshotSection_ClusterNumCells, numCells > 0 ? std::vector<uint32_t>{static_cast<uint32_t>(numCells)} : std::vector<uint32_t>{});
+
+        writer.addSection(ColumnarSnapshotSection_CellId, getColumn<uint64_t>(numCells, [&](auto i) { return cells[cellIndices[i]].id; }));
+        writer.addSection(ColumnarSnapshotSection_CellPosX, getColumn<float>(numCells, [&](auto i) { return cells[cellIndices[i]].pos.x; }));
+        writer.addSection(ColumnarSnapshotSection_CellPosY, getColumn<float>(numCells, [&](auto i) { return cells[cellIndices[i]].pos.y; }));
+        writer.addSection(ColumnarSnapshotSection_CellVelX, getColumn<float>(numCells, [&](auto i) { return cells[cellIndices[i]].vel.x; }));
+        writer.addSection(ColumnarSnapshotSection_CellVelY, getColumn<float>(numCells, [&](auto i) { return cells[cellIndices[i]].vel.y; }));
+        writer.addSection(ColumnarSnapshotSection_CellEnergy, getColumn<float>(numCells, [&](auto i) { return cells[cellIndices[i]].energy; }));
+        writer.addSection(ColumnarSnapshotSection_CellStiffness, getColumn<float>(numCells, [&](auto i) { return cells[cellIndices[i]].stiffness; }));
+        writer.addSection(ColumnarSnapshotSection_CellColor, getColumn<uint8_t>(numCells, [&](auto i) { return cells[cellIndices[i]].color; }));
+        writer.addSection(ColumnarSnapshotSection_CellMaxConnections, getColumn<uint8_t>(numCells, [&](auto i) { return cells[cellIndices[i]].maxConnections; }));
+        writer.addSection(ColumnarSnapshotSection_CellBarrier, getColumn<uint8_t>(numCells, [&](auto i) { return cells[cellIndices[i]].barrier ? 1 : 0; }));
+        writer.addSection(ColumnarSnapshotSection_CellAge, getColumn<int32_t>(numCells, [&](auto i) { return cells[cellIndices[i]].age; }));
+        writer.addSection(ColumnarSnapshotSection_CellLivingState, getColumn<uint8_t>(numCells, [&](auto i) { return cells[cellIndices[i]].livingState; }));
+        writer.addSection(ColumnarSnapshotSection_CellCreatureId, getColumn<int32_t>(numCells, [&](auto i) { return cells[cellIndices[i]].creatureId; }));
+        writer.addSection(ColumnarSnapshotSection_CellMutationId, getColumn<int32_t>(numCells, [&](auto i) { return cells[cellIndices[i]].mutationId; }));
+        writer.addSection(ColumnarSnapshotSection_CellAncestorMutationId, getColumn<uint8_t>(numCells, [&](auto i) { return cells[cellIndices[i]].ancestorMutationId; }));
+        writer.addSection(ColumnarSnapshotSection_CellGenomeComplexity, getColumn<float>(numCells, [&](auto i) { return cells[cellIndices[i]].genomeComplexity; }));
+        writer.addSection(ColumnarSnapshotSection_CellExecutionOrderNumber, getColumn<int32_t>(numCells, [&](auto i) { return cells[cellIndices[i]].executionOrderNumber; }));
+        writer.addSection(ColumnarSnapshotSection_CellInputExecutionOrderNumber, getColumn<int32_t>(numCells, [&](auto i) {
+                              return cells[cellIndices[i]].inputExecutionOrderNumber >= 0 ? cells[cellIndices[i]].inputExecutionOrderNumber : -1;
+                          }));
+        writer.addSection(ColumnarSnapshotSection_CellOutputBlocked, getColumn<uint8_t>(numCells, [&](auto i) { return cells[cellIndices[i]].outputBlocked ? 1 : 0; }));
+        writer.addSection(ColumnarSnapshotSection_CellCellFunction, getColumn<uint8_t>(numCells, [&](auto i) { return cells[cellIndices[i]].cellFunction; }));
+        writer.addSection(ColumnarSnapshotSection_CellSignalChannels, getColumn<float>(numCells * MAX_CHANNELS, [&](auto i) {
+                              return cells[cellIndices[i / MAX_CHANNELS]].signal.channels[i % MAX_CHANNELS];
+                          }));
+        writer.addSection(ColumnarSnapshotSection_CellSignalOrigin, getColumn<uint8_t>(numCells, [&](auto i) { return cells[cellIndices[i]].signal.origin; }));
+        writer.addSection(ColumnarSnapshotSection_CellSignalTargetX, getColumn<float>(numCells, [&](auto i) { return cells[cellIndices[i]].signal.targetX; }));
+        writer.addSection(ColumnarSnapshotSection_CellSignalTargetY, getColumn<float>(numCells, [&](auto i) { return cells[cellIndices[i]].signal.targetY; }));
+        writer.addSection(ColumnarSnapshotSection_CellActivationTime, getColumn<int32_t>(numCells, [&](auto i) { return cells[cellIndices[i]].activationTime; }));
+        writer.addSection(ColumnarSnapshotSection_CellDetectedByCreatureId, getColumn<int32_t>(numCells, [&](auto i) { return cells[cellIndices[i]].detectedByCreatureId; }));
+        writer.addSection(ColumnarSnapshotSection_CellCellFunctionUsed, getColumn<uint8_t>(numCells, [&](auto i) { return cells[cellIndices[i]].cellFunctionUsed; }));
+        writer.addSection(ColumnarSnapshotSection_CellNumConnections, getColumn<uint8_t>(numCells, [&](auto i) { return cells[cellIndices[i]].numConnections; }));
+
+        std::vector<uint64_t> connectionCellId;
+        std::vector<float> connectionDistance, connectionAngleFromPrevious;
+        ColumnarByteWriter cellFunctionData;
+        ColumnarGenomeWriter genomeWriter;
+        std::vector<uint32_t> metadataNameSizes, metadataDescriptionSizes;
+        std::vector<uint8_t> metadataStrings;
+        metadataNameSizes.reserve(numCells);
+        metadataDescriptionSizes.reserve(numCells);
+        for (uint64_t i = 0; i < numCells; ++i) {
+            auto const& cell = cells[cellIndices[i]];
+            for (int j = 0; j < cell.numConnections; ++j) {
+                auto const& connection = cell.connections[j];
+                connectionCellId.emplace_back(connection.cellIndex != -1 ? cells[connection.cellIndex].id : 0);
+                connectionDistance.emplace_back(connection.distance);
+                connectionAngleFromPrevious.emplace_back(connection.angleFromPrevious);
+            }
+
+            writeCellFunction(cellFunctionData, genomeWriter, dataTO, cell);
+
+            auto const& metadata = cell.metadata;
+            metadataNameSizes.emplace_back(metadata.nameSize);
+            metadataDescriptionSizes.emplace_back(metadata.descriptionSize);
+            if (metadata.nameSize > 0) {
+                metadataStrings.insert(
+                    metadataStrings.end(), dataTO.auxiliaryData + metadata.nameDataIndex, dataTO.auxiliaryData + metadata.nameDataIndex + metadata.nameSize);
+            }
+            if (metadata.descriptionSize > 0) {
+                metadataStrings.insert(
+                    metadataStrings.end(),
+                    dataTO.auxiliaryData + metadata.descriptionDataIndex,
+                    dataTO.auxiliaryData + metadata.descriptionDataIndex + metadata.descriptionSize);
+            }
+        }
+        writer.addSection(ColumnarSnapshotSection_ConnectionCellId, connectionCellId);
+        writer.addSection(ColumnarSnapshotSection_ConnectionDistance, connectionDistance);
+        writer.addSection(ColumnarSnapshotSection_ConnectionAngleFromPrevious, connectionAngleFromPrevious);
+        writer.addSection(ColumnarSnapshotSection_CellFunctionData, cellFunctionData.getData());
+        genomeWriter.addSections(writer);
+        writer.addSection(ColumnarSnapshotSection_MetadataNameSizes, metadataNameSizes);
+        writer.addSection(ColumnarSnapshotSection_MetadataDescriptionSizes, metadataDescriptionSizes);
+        writer.addSection(ColumnarSnapshotSection_MetadataStrings, metadataStrings);
+
+        auto const numParticles = particleIndices.size();
+        auto const particles = dataTO.particles;
+        writer.addSection(ColumnarSnapshotSection_ParticleId, getColumn<uint64_t>(numParticles, [&](auto i) { return particles[particleIndices[i]].id; }));
+        writer.addSection(ColumnarSnapshotSection_ParticlePosX, getColumn<float>(numParticles, [&](auto i) { return particles[particleIndices[i]].pos.x; }));
+        writer.addSection(ColumnarSnapshotSection_ParticlePosY, getColumn<float>(numParticles, [&](auto i) { return particles[particleIndices[i]].pos.y; }));
+        writer.addSection(ColumnarSnapshotSection_ParticleVelX, getColumn<float>(numParticles, [&](auto i) { return particles[particleIndices[i]].vel.x; }));
+        writer.addSection(ColumnarSnapshotSection_ParticleVelY, getColumn<float>(numParticles, [&](auto i) { return particles[particleIndices[i]].vel.y; }));
+        writer.addSection(ColumnarSnapshotSection_ParticleEnergy, getColumn<float>(numParticles, [&](auto i) { return particles[particleIndices[i]].energy; }));
+        writer.addSection(ColumnarSnapshotSection_ParticleColor, getColumn<uint8_t>(numParticles, [&](auto i) { return particles[particleIndices[i]].color; }));
+    }
+
+    uint64_t calcCellHash(DataTO const& dataTO, CellTO const& cell)
+    {
+        ContentHash result;
+        result.write(cell.pos.x);
+        result.write(cell.pos.y);
+        result.write(cell.vel.x);
+        result.write(cell.vel.y);
+        result.write(cell.energy);
+        result.write(cell.stiffness);
+        result.write(cell.color);
+        result.write(cell.maxConnections);
+        result.write(cell.barrier);
+        result.write(cell.age);
+        result.write(cell.livingState);
+        result.write(cell.creatureId);
+        result.write(cell.mutationId);
+        result.write(cell.ancestorMutationId);
+        result.write(cell.genomeComplexity);
+        result.write(cell.executionOrderNumber);
+        result.write(cell.inputExecutionOrderNumber);
+        result.write(cell.outputBlocked);
+        result.write(cell.cellFunction);
+        result.write(cell.signal.channels);
+        result.write(cell.signal.origin);
+        result.write(cell.signal.targetX);
+        result.write(cell.signal.targetY);
+        result.write(cell.activationTime);
+        result.write(cell.detectedByCreatureId);
+        result.write(cell.cellFunctionUsed);
+        result.write(cell.numConnections);
+        for (int i = 0; i < cell.numConnections; ++i) {
+            auto const& connection = cell.connections[i];
+            result.write(connection.cellIndex != -1 ? dataTO.cells[connection.cellIndex].id : uint64_t(0));
+            result.write(connection.distance);
+            result.write(connection.angleFromPrevious);
+        }
+        writeCellFunction(result, result, dataTO, cell);
+        result.write(cell.metadata.nameSize);
+        result.add(std::span<uint8_t const>(dataTO.auxiliaryData + cell.metadata.nameDataIndex, cell.metadata.nameSize));
+        result.write(cell.metadata.descriptionSize);
+        result.add(std::span<uint8_t const>(dataTO.auxiliaryData + cell.metadata.descriptionDataIndex, cell.metadata.descriptionSize));
+        return result.getValue();
+    }
+
+    uint64_t calcParticleHash(ParticleTO const& particle)
+    {
+        ContentHash result;
+        result.write(particle.pos.x);
+        result.write(particle.pos.y);
+        result.write(particle.vel.x);
+        result.write(particle.vel.y);
+        result.write(particle.energy);
+        result.write(particle.color);
+        return result.getValue();
+    }
+
+    template <typename T, typename Func>
+    std::vector<std::pair<uint64_t, uint64_t>> calcHashes(T const* objects, uint64_t numObjects, Func const& calcHash)
+    {
+        std::vector<std::pair<uint64_t, uint64_t>> result;
+        result.reserve(numObjects);
+        for (uint64_t i = 0; i < numObjects; ++i) {
+            result.emplace_back(objects[i].id, calcHash(objects[i]));
+        }
+        return result;
+    }
+
+    //hashes are given in the order of the objects, returns the indices of the changed objects and the ids of the removed ones
+    std::pair<std::vector<uint64_t>, std::vector<uint64_t>> calcDelta(
+        std::vector<std::pair<uint64_t, uint64_t>> const& hashes,
+        std::vector<std::pair<uint64_t, uint64_t>> const& sortedBaseHashes,
+        std::vector<std::pair<uint64_t, uint64_t>> const& sortedHashes)
+    {
+        std::vector<uint64_t> changedIndices;
+        for (uint64_t i = 0; i < hashes.size(); ++i) {
+            auto findResult = std::ranges::lower_bound(sortedBaseHashes, hashes[i].first, {}, [](auto const& idAndHash) { return idAndHash.first; });
+            if (findResult == sortedBaseHashes.end() || *findResult != hashes[i]) {
+                changedIndices.emplace_back(i);
+            }
+        }
+        std::vector<uint64_t> removedIds;
+        auto iter = sortedHashes.begin();
+        for (auto const& [id, hash] : sortedBaseHashes) {
+            while (iter != sortedHashes.end() && iter->first < id) {
+                ++iter;
+            }
+            if (iter == sortedHashes.end() || iter->first != id) {
+                removedIds.emplace_back(id);
+            }
+        }
+        return {changedIndices, removedIds};
+    }
+}
+
+void DataTOSerializer::serialize(DataTO const& dataTO, std::ostream& stream)
+{
+    std::vector<uint64_t> cellIndices(*dataTO.numCells);
+    std::iota(cellIndices.begin(), cellIndices.end(), 0);
+    std::vector<uint64_t> particleIndices(*dataTO.numParticles);
+    std::iota(particleIndices.begin(), particleIndices.end(), 0);
+
+    ColumnarSnapshotWriter writer(Const::ProgramVersion);
+    addSections(writer, dataTO, cellIndices, particleIndices);
+    writer.write(stream);
+}
+
+DataTOFingerprint DataTOSerializer::serializeDelta(
+    DataTO const& dataTO,
+    DataTOFingerprint const& baseFingerprint,
+    std::filesystem::path const& baseFilename,
+    std::ostream& stream)
+{
+    auto cellHashes = calcHashes(dataTO.cells, *dataTO.numCells, [&](auto const& cell) { return calcCellHash(dataTO, cell); });
+    auto particleHashes = calcHashes(dataTO.particles, *dataTO.numParticles, [](auto const& particle) { return calcParticleHash(particle); });
+
+    DataTOFingerprint result{.cellHashes = cellHashes, .particleHashes = particleHashes};
+    std::ranges::sort(result.cellHashes);
+    std::ranges::sort(result.particleHashes);
+
+    auto [changedCellIndices, removedCellIds] = calcDelta(cellHashes, baseFingerprint.cellHashes, result.cellHashes);
+    auto [changedParticleIndices, removedParticleIds] = calcDelta(particleHashes, baseFingerprint.particleHashes, result.particleHashes);
+    auto baseFilenameString = baseFilename.generic_u8string();
+
+    ColumnarSnapshotWriter writer(Const::ProgramVersion);
+    addSections(writer, dataTO, changedCellIndices, changedParticleIndices);
+    writer.addSection(
+        ColumnarSnapshotSection_DeltaBaseFilename, 1, reinterpret_cast<uint8_t const*>(baseFilenameString.data()), baseFilenameString.size());
+    writer.addSection(ColumnarSnapshotSection_DeltaRemovedCellIds, removedCellIds);
+    writer.addSection(ColumnarSnapshotSection_DeltaRemovedParticleIds, removedParticleIds);
+    writer.write(stream);
+
+    return result;
+}
+
+DataTOFingerprint DataTOSerializer::calcFingerprint(DataTO const& dataTO)
+{
+    DataTOFingerprint result{
+        .cellHashes = calcHashes(dataTO.cells, *dataTO.numCells, [&](auto const& cell) { return calcCellHash(dataTO, cell); }),
+        .particleHashes = calcHashes(dataTO.particles, *dataTO.numParticles, [](auto const& particle) { return calcParticleHash(particle); })};
+    std::ranges::sort(result.cellHashes);
+    std::ranges::sort(result.particleHashes);
+    return result;
+}
+
+DataTO DataTOSerializer::deserialize(std::filesystem::path const& filename)
+{
+    ColumnarSnapshotReader reader(filename);
+    ColumnarSnapshotService::get().checkProgramVersion(reader);
+    if (ColumnarSnapshotService::get().isDelta(reader)) {
+        throw std::runtime_error("Delta snapshots need to be loaded together with their base snapshots.");
+    }
+
+    auto numCells = reader.getNumElements(ColumnarSnapshotSection_CellId);
+    auto numParticles = reader.getNumElements(ColumnarSnapshotSection_ParticleId);
+    auto cellFunctions = readColumn<uint8_t>(reader, ColumnarSnapshotSection_CellCellFunction, numCells);
+    ColumnarGenomeReader genomeReader(reader);
+    auto metadataStrings = reader.readSection<uint8_t>(ColumnarSnapshotSection_MetadataStrings);
+
+    ArraySizes arraySizes{
+        .cellArraySize = numCells, .particleArraySize = numParticles, .auxiliaryDataSize = genomeReader.getDataSize() + metadataStrings.size()};
+    for (auto const& cellFunction : cellFunctions) {
+        if (cellFunction == CellFunction_Neuron) {
+            arraySizes.auxiliaryDataSize += NeuronDataSize;
+        }
+    }
+
+    DataTO result;
+    result.init(arraySizes);
+    try {
+        auto cells = result.cells;
+        *result.numCells = numCells;
+        *result.numParticles = numParticles;
+
+        readColumn<uint64_t>(reader, ColumnarSnapshotSection_CellId, numCells, [&](auto i, auto value) {
+            cells[i] = CellTO();
+            cells[i].id = value != 0 ? value : NumberGenerator::get().getId();
+        });
+        readColumn<float>(reader, ColumnarSnapshotSection_CellPosX, numCells, [&](auto i, auto value) { cells[i].pos.x = value; });
+        readColumn<float>(reader, ColumnarSnapshotSection_CellPosY, numCells, [&](auto i, auto value) { cells[i].pos.y = value; });
+        readColumn<float>(reader, ColumnarSnapshotSection_CellVelX, numCells, [&](auto i, auto value) { cells[i].vel.x = value; });
+        readColumn<float>(reader, ColumnarSnapshotSection_CellVelY, numCells, [&](auto i, auto value) { cells[i].vel.y = value; });
+        readColumn<float>(reader, ColumnarSnapshotSection_CellEnergy, numCells, [&](auto i, auto value) {
+            cells[i].energy = value;
+            checkAndCorrectInvalidEnergy(cells[i].energy);
+        });
+        readColumn<float>(reader, ColumnarSnapshotSection_CellStiffness, numCells, [&](auto i, auto value) { cells[i].stiffness = value; });
+        readColumn<uint8_t>(reader, ColumnarSnapshotSection_CellColor, numCells, [&](auto i, auto value) { cells[i].color = value; });
+        readColumn<uint8_t>(reader, ColumnarSnapshotSection_CellMaxConnections, numCells, [&](auto i, auto value) { cells[i].maxConnections = value; });
+        readColumn<uint8_t>(reader, ColumnarSnapshotSection_CellBarrier, numCells, [&](auto i, auto value) { cells[i].barrier = value != 0; });
+        readColumn<int32_t>(reader, ColumnarSnapshotSection_CellAge, numCells, [&](auto i, auto value) { cells[i].age = value; });
+        readColumn<uint8_t>(reader, ColumnarSnapshotSection_CellLivingState, numCells, [&](auto i, auto value) { cells[i].livingState = value; });
+        readColumn<int32_t>(reader, ColumnarSnapshotSection_CellCreatureId, numCells, [&](auto i, auto value) { cells[i].creatureId = value; });
+        readColumn<int32_t>(reader, ColumnarSnapshotSection_CellMutationId, numCells, [&](auto i, auto value) { cells[i].mutationId = value; });
+        readColumn<uint8_t>(reader, ColumnarSnapshotSection_CellAncestorMutationId, numCells, [&](auto i, auto value) { cells[i].ancestorMutationId = value; });
+        readColumn<float>(reader, ColumnarSnapshotSection_CellGenomeComplexity, numCells, [&](auto i, auto value) { cells[i].genomeComplexity = value; });
+        readColumn<int32_t>(reader, ColumnarSnapshotSection_CellExecutionOrderNumber, numCells, [&](auto i, auto value) {
+            cells[i].executionOrderNumber = static_cast<uint8_t>(value);
+        });
+        readColumn<int32_t>(reader, ColumnarSnapshotSection_CellInputExecutionOrderNumber, numCells, [&](auto i, auto value) {
+            cells[i].inputExecutionOrderNumber = static_cast<int8_t>(value);
+        });
+        readColumn<uint8_t>(reader, ColumnarSnapshotSection_CellOutputBlocked, numCells, [&](auto i, auto value) { cells[i].outputBlocked = value != 0; });
+        readColumn<float>(reader, ColumnarSnapshotSection_CellSignalChannels, numCells * MAX_CHANNELS, [&](auto i, auto value) {
+            cells[i / MAX_CHANNELS].signal.channels[i % MAX_CHANNELS] = value;
+        });
+        readColumn<uint8_t>(reader, ColumnarSnapshotSection_CellSignalOrigin, numCells, [&](auto i, auto value) { cells[i].signal.origin = value; });
+        readColumn<float>(reader, ColumnarSnapshotSection_CellSignalTargetX, numCells, [&](auto i, auto value) { cells[i].signal.targetX = value; });
+        readColumn<float>(reader, ColumnarSnapshotSection_CellSignalTargetY, numCells, [&](auto i, auto value) { cells[i].signal.targetY = value; });
+        readColumn<int32_t>(reader, ColumnarSnapshotSection_CellActivationTime, numCells, [&](auto i, auto value) { cells[i].activationTime = value; });
+        readColumn<int32_t>(reader, ColumnarSnapshotSection_CellDetectedByCreatureId, numCells, [&](auto i, auto value) {
+            cells[i].detectedByCreatureId = static_cast<uint16_t>(value);
+        });
+        readColumn<uint8_t>(reader, ColumnarSnapshotSection_CellCellFunctionUsed, numCells, [&](auto i, auto value) { cells[i].cellFunctionUsed = value; });
+
+        //connections refer to cell ids in the file, connections to cells which are not present are removed as in the DescriptionConverter
+        std::unordered_map<uint64_t, int> cellIndexByIds;
+        cellIndexByIds.reserve(numCells);
+        for (uint64_t i = 0; i < numCells; ++i) {
+            cellIndexByIds.insert_or_assign(cells[i].id, toInt(i));
+        }
+        auto numConnections = readColumn<uint8_t>(reader, ColumnarSnapshotSection_CellNumConnections, numCells);
+        auto numConnectionEntries = reader.getNumElements(ColumnarSnapshotSection_ConnectionCellId);
+        auto connectionCellId = readColumn<uint64_t>(reader, ColumnarSnapshotSection_ConnectionCellId, numConnectionEntries);
+        auto connectionDistance = readColumn<float>(reader, ColumnarSnapshotSection_ConnectionDistance, numConnectionEntries);
+        auto connectionAngleFromPrevious = readColumn<float>(reader, ColumnarSnapshotSection_ConnectionAngleFromPrevious, numConnectionEntries);
+        uint64_t connectionIndex = 0;
+        for (uint64_t i = 0; i < numCells; ++i) {
+            auto& cell = cells[i];
+            if (numConnections[i] > MAX_CELL_BONDS || connectionIndex + numConnections[i] > numConnectionEntries) {
+                throw std::runtime_error("Invalid connections in columnar snapshot.");
+            }
+            int index = 0;
+            float angleOffset = 0;
+            for (int j = 0; j < numConnections[i]; ++j, ++connectionIndex) {
+                auto findResult = cellIndexByIds.find(connectionCellId[connectionIndex]);
+                if (connectionCellId[connectionIndex] != 0 && findResult != cellIndexByIds.end()) {
+                    cell.connections[index].cellIndex = findResult->second;
+                    cell.connections[index].distance = connectionDistance[connectionIndex];
+                    cell.connections[index].angleFromPrevious = connectionAngleFromPrevious[connectionIndex] + angleOffset;
+                    ++index;
+                    angleOffset = 0;
+                } else {
+                    angleOffset += connectionAngleFromPrevious[connectionIndex];
+                }
+            }
+            if (angleOffset != 0 && index > 0) {
+                cell.connections[0].angleFromPrevious += angleOffset;
+            }
+            cell.numConnections = static_cast<uint8_t>(index);
+        }
+
+        AuxiliaryDataWriter auxiliaryDataWriter(result);
+        auto cellFunctionData = reader.readSection<uint8_t>(ColumnarSnapshotSection_CellFunctionData);
+        ColumnarByteReader cellFunctionReader(cellFunctionData);
+        std::vector<std::optional<uint64_t>> genomeDataIndices(genomeReader.getNumGenomes());
+        for (uint64_t i = 0; i < numCells; ++i) {
+            cells[i].cellFunction = cellFunctions[i];
+            readCellFunction(cellFunctionReader, auxiliaryDataWriter, genomeReader, genomeDataIndices, cells[i]);
+        }
+
+        auto metadataNameSizes = readColumn<uint32_t>(reader, ColumnarSnapshotSection_MetadataNameSizes, numCells);
+        auto metadataDescriptionSizes = readColumn<uint32_t>(reader, ColumnarSnapshotSection_MetadataDescriptionSizes, numCells);
+        uint64_t metadataPosition = 0;
+        auto readMetadataString = [&](uint32_t size, uint16_t& targetSize, uint64_t& targetIndex) {
+            if (metadataPosition + size > metadataStrings.size()) {
+                throw std::runtime_error("Metadata of columnar snapshot is truncated.");
+            }
+            targetSize = static_cast<uint16_t>(size);
+            targetIndex = size > 0 ? auxiliaryDataWriter.append(metadataStrings.data() + metadataPosition, size) : 0;
+            metadataPosition += size;
+        };
+        for (uint64_t i = 0; i < numCells; ++i) {
+            readMetadataString(metadataNameSizes[i], cells[i].metadata.nameSize, cells[i].metadata.nameDataIndex);
+            readMetadataString(metadataDescriptionSizes[i], cells[i].metadata.descriptionSize, cells[i].metadata.descriptionDataIndex);
+        }
+
+        auto particles = result.particles;
+        readColumn<uint64_t>(reader, ColumnarSnapshotSection_ParticleId, numParticles, [&](auto i, auto value) {
+            particles[i] = ParticleTO();
+            particles[i].id = value != 0 ? value : NumberGenerator::get().getId();
+        });
+        readColumn<float>(reader, ColumnarSnapshotSection_ParticlePosX, numParticles, [&](auto i, auto value) { particles[i].pos.x = value; });
+        readColumn<float>(reader, ColumnarSnapshotSection_ParticlePosY, numParticles, [&](auto i, auto value) { particles[i].pos.y = value; });
+        readColumn<float>(reader, ColumnarSnapshotSection_ParticleVelX, numParticles, [&](auto i, auto value) { particles[i].vel.x = value; });
+        readColumn<float>(reader, ColumnarSnapshotSection_ParticleVelY, numParticles, [&](auto i, auto value) { particles[i].vel.y = value; });
+        readColumn<float>(reader, ColumnarSnapshotSection_ParticleEnergy, numParticles, [&](auto i, auto value) {
+            particles[i].energy = value;
+            checkAndCorrectInvalidEnergy(particles[i].energy);
+        });
+        readColumn<uint8_t>(reader, ColumnarSnapshotSection_ParticleColor, numParticles, [&](auto i, auto value) { particles[i].color = value; });
+    } catch (...) {
+        result.destroy();
+        throw;
+    }
+    return result;
+}
+
+ArraySizes DataTOSerializer::getArraySizes(DataTO const& dataTO)
+{
+    //genomes are shared between cells in the DataTO but the GPU copies them for every referencing cell
+    ArraySizes result{.cellArraySize = *dataTO.numCells, .particleArraySize = *dataTO.numParticles, .auxiliaryDataSize = 0};
+    for (uint64_t i = 0; i < *dataTO.numCells; ++i) {
+        auto const& cell = dataTO.cells[i];
+        result.auxiliaryDataSize += cell.metadata.nameSize + cell.metadata.descriptionSize;
+        switch (cell.cellFunction) {
+        case CellFunction_Neuron:
+            result.auxiliaryDataSize += NeuronDataSize;
+            break;
+        case CellFunction_Constructor:
+            result.auxiliaryDataSize += cell.cellFunctionData.constructor.genomeSize;
+            break;
+        case CellFunction_Injector:
+            result.auxiliaryDataSize += cell.cellFunctionData.injector.genomeSize;
+            break;
+        }
+    }
+    return result;
+}
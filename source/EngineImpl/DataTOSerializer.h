@@ -0,0 +1,37 @@
+#pragma once
+
+#include <filesystem>
+#include <ostream>
+
+#include "EngineInterface/ArraySizes.h"
+#include "EngineGpuKernels/TOs.cuh"
+
+#include "DataTOFingerprint.h"
+#include "Definitions.h"
+
+/**
+ * Writes and reads the columnar .sim format (see PersisterInterface/ColumnarSnapshot.h) directly from and into DataTOs.
+ * It produces the same sections as the ColumnarSnapshotService without building descriptions. All cells are stored in a single cluster.
+ * A delta snapshot (see SimulationDelta) is computed from the fingerprint of its base, which consists of the ids and content hashes of
+ * the written cells and particles.
+ */
+class DataTOSerializer
+{
+public:
+    static void serialize(DataTO const& dataTO, std::ostream& stream);
+
+    //writes the cells and particles whose hashes differ from baseFingerprint together with the ids of the removed ones,
+    //baseFilename is stored as given and the fingerprint of dataTO is returned
+    static DataTOFingerprint serializeDelta(
+        DataTO const& dataTO,
+        DataTOFingerprint const& baseFingerprint,
+        std::filesystem::path const& baseFilename,
+        std::ostream& stream);
+    static DataTOFingerprint calcFingerprint(DataTO const& dataTO);
+
+    //the returned DataTO has to be destroyed by the caller
+    static DataTO deserialize(std::filesystem::path const& filename);  //throws std::runtime_error
+
+    //array sizes needed on the GPU, i.e. shared genomes are counted for each referencing cell
+    static ArraySizes getArraySizes(DataTO const& dataTO);
+};
@@ -4,3 +4,6 @@
 
 class _AccessDataTOCache;
 using AccessDataTOCache = std::shared_ptr<_AccessDataTOCache>;
+
+class _EngineBackend;
+using EngineBackend = std::shared_ptr<_EngineBackend>;
@@ -2,16 +2,17 @@
 
 #include <cmath>
 #include <algorithm>
-#include <boost/range/adaptor/map.hpp>
 
 #include "Base/NumberGenerator.h"
 #include "Base/Exceptions.h"
+#include "Base/ThreadPool.h"
 #include "EngineInterface/Descriptions.h"
 #include "EngineInterface/GenomeConstants.h"
 
-
 namespace
 {
+    auto constexpr MinChunkSizeForConversion = 2048;
+
     union BytesAsFloat
     {
         float f;
@@ -134,28 +135,63 @@ ClusteredDataDescription DescriptionConverter::convertTOtoClusteredDataDescripti
 	ClusteredDataDescription result;
 
     //cells
-    std::vector<ClusterDescription> clusters;
-    std::unordered_set<int> freeCellIndices;
-    for (int i = 0; i < *dataTO.numCells; ++i) {
-        freeCellIndices.insert(i);
-    }
-    std::unordered_map<int, int> cellTOIndexToCellDescIndex;
-    std::unordered_map<int, int> cellTOIndexToClusterDescIndex;
-    int clusterDescIndex = 0;
-    while (!freeCellIndices.empty()) {
-        auto freeCellIndex = *freeCellIndices.begin();
-        auto createClusterData = scanAndCreateClusterDescription(dataTO, freeCellIndex, freeCellIndices);
-        clusters.emplace_back(createClusterData.cluster);
-
-        //update index maps
-        cellTOIndexToCellDescIndex.insert(
-            createClusterData.cellTOIndexToCellDescIndex.begin(), createClusterData.cellTOIndexToCellDescIndex.end());
-        for (auto const& cellTOIndex : createClusterData.cellTOIndexToCellDescIndex | boost::adaptors::map_keys) {
-            cellTOIndexToClusterDescIndex.emplace(cellTOIndex, clusterDescIndex);
+    auto numCells = toInt(*dataTO.numCells);
+
+    //connected cells are united in parallel such that the root of each cluster becomes its smallest cell index
+    std::vector<std::atomic<int>> parentIndices(numCells);
+    for (int i = 0; i < numCells; ++i) {
+        parentIndices[i].store(i, std::memory_order_relaxed);
+    }
+    ThreadPool::get().parallelFor(
+        numCells,
+        [&](size_t startIndex, size_t endIndex) {
+            for (auto index = toInt(startIndex); index < toInt(endIndex); ++index) {
+                auto const& cellTO = dataTO.cells[index];
+                for (int i = 0; i < cellTO.numConnections; ++i) {
+                    auto otherIndex = cellTO.connections[i].cellIndex;
+                    if (otherIndex != -1) {
+                        uniteClusters(parentIndices, index, otherIndex);
+                    }
+                }
+            }
+        },
+        MinChunkSizeForConversion);
+    std::vector<int> rootIndices(numCells);
+    ThreadPool::get().parallelFor(
+        numCells,
+        [&](size_t startIndex, size_t endIndex) {
+            for (auto index = toInt(startIndex); index < toInt(endIndex); ++index) {
+                rootIndices[index] = findClusterRoot(parentIndices, index);
+            }
+        },
+        MinChunkSizeForConversion);
+
+    //clusters are ordered by their smallest cell index and cells by their index, which makes the result independent of the scheduling
+    std::vector<int> clusterIndices(numCells);
+    std::vector<int> indicesInCluster(numCells);
+    std::vector<int> clusterSizes;
+    for (int i = 0; i < numCells; ++i) {
+        auto rootIndex = rootIndices[i];
+        if (rootIndex == i) {
+            clusterIndices[i] = toInt(clusterSizes.size());
+            clusterSizes.emplace_back(0);
+        } else {
+            clusterIndices[i] = clusterIndices[rootIndex];
         }
-        ++clusterDescIndex;
+        indicesInCluster[i] = clusterSizes[clusterIndices[i]]++;
+    }
+    result.clusters.resize(clusterSizes.size());
+    for (int i = 0; i < toInt(clusterSizes.size()); ++i) {
+        result.clusters[i].cells.resize(clusterSizes[i]);
     }
-    result.addClusters(clusters);
+    ThreadPool::get().parallelFor(
+        numCells,
+        [&](size_t startIndex, size_t endIndex) {
+            for (auto index = toInt(startIndex); index < toInt(endIndex); ++index) {
+                result.clusters[clusterIndices[index]].cells[indicesInCluster[index]] = createCellDescription(dataTO, index);
+            }
+        },
+        MinChunkSizeForConversion);
 
     //particles
     std::vector<ParticleDescription> particles;
@@ -200,12 +236,11 @@ DataDescription DescriptionConverter::convertTOtoDataDescription(DataTO const& d
     return result;
 }
 
-OverlayDescription DescriptionConverter::convertTOtoOverlayDescription(DataTO const& dataTO) const
+OverlayDescription DescriptionConverter::convertTOtoOverlayDescription(std::span<CellTO const> cells, std::span<ParticleTO const> particles)
 {
     OverlayDescription result;
-    result.elements.reserve(*dataTO.numCells + *dataTO.numParticles);
-    for (int i = 0; i < *dataTO.numCells; ++i) {
-        auto const& cellTO = dataTO.cells[i];
+    result.elements.reserve(cells.size() + particles.size());
+    for (auto const& cellTO : cells) {
         OverlayElementDescription element;
         element.id = cellTO.id;
         element.cell = true;
@@ -216,8 +251,7 @@ OverlayDescription DescriptionConverter::convertTOtoOverlayDescription(DataTO co
         result.elements.emplace_back(element);
     }
 
-    for (int i = 0; i < *dataTO.numParticles; ++i) {
-        auto const& particleTO = dataTO.particles[i];
+    for (auto const& particleTO : particles) {
         OverlayElementDescription element;
         element.id = particleTO.id;
         element.cell = false;
@@ -231,9 +265,10 @@ OverlayDescription DescriptionConverter::convertTOtoOverlayDescription(DataTO co
 void DescriptionConverter::convertDescriptionToTO(DataTO& result, ClusteredDataDescription const& description) const
 {
     std::unordered_map<uint64_t, int> cellIndexByIds;
+    GenomeDataIndices genomeDataIndices;
     for (auto const& cluster: description.clusters) {
         for (auto const& cell : cluster.cells) {
-            addCell(result, cell, cellIndexByIds);
+            addCell(result, cell, cellIndexByIds, genomeDataIndices);
         }
     }
     for (auto const& cluster : description.clusters) {
@@ -251,8 +286,9 @@ void DescriptionConverter::convertDescriptionToTO(DataTO& result, ClusteredDataD
 void DescriptionConverter::convertDescriptionToTO(DataTO& result, DataDescription const& description) const
 {
     std::unordered_map<uint64_t, int> cellIndexByIds;
+    GenomeDataIndices genomeDataIndices;
     for (auto const& cell : description.cells) {
-        addCell(result, cell, cellIndexByIds);
+        addCell(result, cell, cellIndexByIds, genomeDataIndices);
     }
     for (auto const& cell : description.cells) {
         if (cell.id != 0) {
@@ -267,7 +303,8 @@ void DescriptionConverter::convertDescriptionToTO(DataTO& result, DataDescriptio
 void DescriptionConverter::convertDescriptionToTO(DataTO& result, CellDescription const& cell) const
 {
     std::unordered_map<uint64_t, int> cellIndexByIds;
-    addCell(result, cell, cellIndexByIds);
+    GenomeDataIndices genomeDataIndices;
+    addCell(result, cell, cellIndexByIds, genomeDataIndices);
 }
 
 void DescriptionConverter::convertDescriptionToTO(DataTO& result, ParticleDescription const& particle) const
@@ -307,57 +344,37 @@ void DescriptionConverter::addAdditionalDataSizeForCell(CellDescription const& c
     }
 }    
 
-namespace
+int DescriptionConverter::findClusterRoot(std::vector<std::atomic<int>>& parentIndices, int cellIndex)
 {
-    template <typename T>
-    void setInplaceDifference(std::unordered_set<T>& a, std::unordered_set<T> const& b)
-    {
-        for (auto const& element : b) {
-            a.erase(element);
-        }
-    }
+    //path halving: concurrent updates only ever replace a parent by one of its ancestors
+    auto parentIndex = parentIndices[cellIndex].load(std::memory_order_relaxed);
+    while (parentIndex != cellIndex) {
+        auto grandParentIndex = parentIndices[parentIndex].load(std::memory_order_relaxed);
+        parentIndices[cellIndex].compare_exchange_weak(parentIndex, grandParentIndex, std::memory_order_relaxed);
+        cellIndex = parentIndex;
+        parentIndex = parentIndices[cellIndex].load(std::memory_order_relaxed);
+    }
+    return cellIndex;
 }
 
-auto DescriptionConverter::scanAndCreateClusterDescription(
-    DataTO const& dataTO,
-    int startCellIndex,
-    std::unordered_set<int>& freeCellIndices) const
-    -> CreateClusterReturnData
+void DescriptionConverter::uniteClusters(std::vector<std::atomic<int>>& parentIndices, int cellIndex, int otherCellIndex)
 {
-    CreateClusterReturnData result; 
-
-    std::unordered_set<int> currentCellIndices;
-    currentCellIndices.insert(startCellIndex);
-    std::unordered_set<int> scannedCellIndices = currentCellIndices;
-
-    std::vector<CellDescription> cells;
-    std::unordered_set<int> nextCellIndices;
-    int cellDescIndex = 0;
-    do {
-        for (auto const& currentCellIndex : currentCellIndices) {
-            cells.emplace_back(createCellDescription(dataTO, currentCellIndex));
-            result.cellTOIndexToCellDescIndex.emplace(currentCellIndex, cellDescIndex);
-            auto const& cellTO = dataTO.cells[currentCellIndex];
-            for (int i = 0; i < cellTO.numConnections; ++i) {
-                auto connectionTO = cellTO.connections[i];
-                if (connectionTO.cellIndex != -1) {
-                    if (scannedCellIndices.find(connectionTO.cellIndex) == scannedCellIndices.end()) {
-                        nextCellIndices.insert(connectionTO.cellIndex);
-                        scannedCellIndices.insert(connectionTO.cellIndex);
-                    }
-                }
-            }
-            ++cellDescIndex;
+    while (true) {
+        auto rootIndex = findClusterRoot(parentIndices, cellIndex);
+        auto otherRootIndex = findClusterRoot(parentIndices, otherCellIndex);
+        if (rootIndex == otherRootIndex) {
+            return;
+        }
+        if (rootIndex < otherRootIndex) {
+            std::swap(rootIndex, otherRootIndex);
         }
-        currentCellIndices = nextCellIndices;
-        nextCellIndices.clear();
-    } while (!currentCellIndices.empty());
-
-    setInplaceDifference(freeCellIndices, scannedCellIndices);
-
-    result.cluster.addCells(cells);
 
-    return result;
+        //the larger root is attached to the smaller one, the exchange fails if another thread has attached it in the meantime
+        auto expectedIndex = rootIndex;
+        if (parentIndices[rootIndex].compare_exchange_strong(expectedIndex, otherRootIndex, std::memory_order_relaxed)) {
+            return;
+        }
+    }
 }
 
 CellDescription DescriptionConverter::createCellDescription(DataTO const& dataTO, int cellIndex) const
@@ -543,7 +560,10 @@ void DescriptionConverter::addParticle(DataTO const& dataTO, ParticleDescription
 }
 
 void DescriptionConverter::addCell(
-    DataTO const& dataTO, CellDescription const& cellDesc, std::unordered_map<uint64_t, int>& cellIndexTOByIds) const
+    DataTO const& dataTO,
+    CellDescription const& cellDesc,
+    std::unordered_map<uint64_t, int>& cellIndexTOByIds,
+    GenomeDataIndices& genomeDataIndices) const
 {
     int cellIndex = (*dataTO.numCells)++;
     CellTO& cellTO = dataTO.cells[cellIndex];
@@ -589,7 +609,7 @@ void DescriptionConverter::addCell(
         constructorTO.activationMode = constructorDesc.activationMode;
         constructorTO.constructionActivationTime = constructorDesc.constructionActivationTime;
         CHECK(constructorDesc.genome.size() >= Const::GenomeHeaderSize)
-        convert(dataTO, constructorDesc.genome, constructorTO.genomeSize, constructorTO.genomeDataIndex);
+        addGenome(dataTO, constructorDesc.genome, genomeDataIndices, constructorTO.genomeSize, constructorTO.genomeDataIndex);
         constructorTO.numInheritedGenomeNodes = static_cast<uint16_t>(constructorDesc.numInheritedGenomeNodes);
         constructorTO.lastConstructedCellId = constructorDesc.lastConstructedCellId;
         constructorTO.genomeCurrentNodeIndex = static_cast<uint16_t>(constructorDesc.genomeCurrentNodeIndex);
@@ -636,7 +656,7 @@ void DescriptionConverter::addCell(
         injectorTO.mode = injectorDesc.mode;
         injectorTO.counter = injectorDesc.counter;
         CHECK(injectorDesc.genome.size() >= Const::GenomeHeaderSize)
-        convert(dataTO, injectorDesc.genome, injectorTO.genomeSize, injectorTO.genomeDataIndex);
+        addGenome(dataTO, injectorDesc.genome, genomeDataIndices, injectorTO.genomeSize, injectorTO.genomeDataIndex);
         injectorTO.genomeGeneration = injectorDesc.genomeGeneration;
         cellTO.cellFunctionData.injector = injectorTO;
     } break;
@@ -689,6 +709,24 @@ void DescriptionConverter::addCell(
 	cellIndexTOByIds.insert_or_assign(cellTO.id, cellIndex);
 }
 
+void DescriptionConverter::addGenome(
+    DataTO const& dataTO,
+    std::vector<uint8_t> const& genome,
+    GenomeDataIndices& genomeDataIndices,
+    uint16_t& targetSize,
+    uint64_t& targetIndex) const
+{
+    //identical genomes share their data since the engines copy the genome of each cell when importing the TO
+    auto id = genomeDataIndices.pool.add(genome);
+    if (id < toInt(genomeDataIndices.dataIndices.size())) {
+        targetSize = static_cast<uint16_t>(genome.size());
+        targetIndex = genomeDataIndices.dataIndices.at(id);
+    } else {
+        convert(dataTO, genome, targetSize, targetIndex);
+        genomeDataIndices.dataIndices.emplace_back(targetIndex);
+    }
+}
+
 void DescriptionConverter::setConnections(DataTO const& dataTO, CellDescription const& cellToAdd, std::unordered_map<uint64_t, int> const& cellIndexByIds) const
 {
     int index = 0;
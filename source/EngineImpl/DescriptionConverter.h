@@ -1,10 +1,14 @@
 #pragma once
 
+#include <atomic>
+#include <span>
 #include <unordered_map>
+#include <vector>
 
 #include "EngineInterface/Definitions.h"
 #include "EngineInterface/ArraySizes.h"
 #include "EngineInterface/Descriptions.h"
+#include "EngineInterface/GenomePool.h"
 #include "EngineInterface/OverlayDescriptions.h"
 #include "EngineInterface/SimulationParameters.h"
 #include "EngineGpuKernels/TOs.cuh"
@@ -20,7 +24,7 @@ public:
 
     ClusteredDataDescription convertTOtoClusteredDataDescription(DataTO const& dataTO) const;
     DataDescription convertTOtoDataDescription(DataTO const& dataTO) const;
-    OverlayDescription convertTOtoOverlayDescription(DataTO const& dataTO) const;
+    static OverlayDescription convertTOtoOverlayDescription(std::span<CellTO const> cells, std::span<ParticleTO const> particles);
     void convertDescriptionToTO(DataTO& result, ClusteredDataDescription const& description) const;
     void convertDescriptionToTO(DataTO& result, DataDescription const& description) const;
     void convertDescriptionToTO(DataTO& result, CellDescription const& cell) const;
@@ -29,19 +33,22 @@ public:
 private:
     void addAdditionalDataSizeForCell(CellDescription const& cell, uint64_t& additionalDataSize) const;
 
-	struct CreateClusterReturnData
-    {
-        ClusterDescription cluster;
-        std::unordered_map<int, int> cellTOIndexToCellDescIndex;
-	};
-    CreateClusterReturnData scanAndCreateClusterDescription(
-        DataTO const& dataTO,
-        int startCellIndex,
-        std::unordered_set<int>& freeCellIndices) const;
+    static int findClusterRoot(std::vector<std::atomic<int>>& parentIndices, int cellIndex);
+    static void uniteClusters(std::vector<std::atomic<int>>& parentIndices, int cellIndex, int otherCellIndex);
     CellDescription createCellDescription(DataTO const& dataTO, int cellIndex) const;
 
+    struct GenomeDataIndices
+    {
+        GenomePool pool;
+        std::vector<uint64_t> dataIndices;  //position of each pooled genome in the auxiliary data
+    };
 	void addCell(
-        DataTO const& dataTO, CellDescription const& cellToAdd, std::unordered_map<uint64_t, int>& cellIndexTOByIds) const;
+        DataTO const& dataTO,
+        CellDescription const& cellToAdd,
+        std::unordered_map<uint64_t, int>& cellIndexTOByIds,
+        GenomeDataIndices& genomeDataIndices) const;
+    void addGenome(DataTO const& dataTO, std::vector<uint8_t> const& genome, GenomeDataIndices& genomeDataIndices, uint16_t& targetSize, uint64_t& targetIndex)
+        const;
     void addParticle(DataTO const& dataTO, ParticleDescription const& particleDesc) const;
 
 	void setConnections(
@@ -0,0 +1,437 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+#include <vector_types.h>
+#include <GL/gl.h>
+
+#include "EngineInterface/ArraySizes.h"
+#include "EngineInterface/MutationType.h"
+#include "EngineInterface/RawStatisticsData.h"
+#include "EngineInterface/SelectionShallowData.h"
+#include "EngineInterface/Settings.h"
+#include "EngineInterface/ShallowUpdateSelectionData.h"
+#include "EngineInterface/SimulationParametersUpdateConfig.h"
+#include "EngineInterface/StatisticsHistory.h"
+#include "EngineGpuKernels/Definitions.cuh"
+
+#include "Definitions.h"
+
+/**
+ * Common interface of the simulation facades used by the EngineWorker.
+ * The CUDA and the CPU facade provide the same methods and are wrapped by _EngineBackendAdapter.
+ */
+class _EngineBackend
+{
+public:
+    virtual ~_EngineBackend() = default;
+
+    virtual std::string getDeviceName() const = 0;
+
+    virtual void* registerImageResource(GLuint image) = 0;
+
+    virtual void calcTimestep(uint64_t timesteps, bool forceUpdateStatistics) = 0;
+    virtual void applyCataclysm(int power) = 0;
+
+    virtual void drawVectorGraphics(float2 const& rectUpperLeft, float2 const& rectLowerRight, void* cudaResource, int2 const& imageSize, double zoom) = 0;
+    virtual void getSimulationData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataTO const& dataTO) = 0;
+    virtual void getSelectedSimulationData(bool includeClusters, DataTO const& dataTO) = 0;
+    virtual void getInspectedSimulationData(std::vector<uint64_t> entityIds, DataTO const& dataTO) = 0;
+    virtual void getOverlayData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataTO const& dataTO) = 0;
+    virtual void addAndSelectSimulationData(DataTO const& dataTO) = 0;
+    virtual void setSimulationData(DataTO const& dataTO) = 0;
+    virtual void removeSelectedObjects(bool includeClusters) = 0;
+    virtual void relaxSelectedObjects(bool includeClusters) = 0;
+    virtual void uniformVelocitiesForSelectedObjects(bool includeClusters) = 0;
+    virtual void makeSticky(bool includeClusters) = 0;
+    virtual void removeStickiness(bool includeClusters) = 0;
+    virtual void setBarrier(bool value, bool includeClusters) = 0;
+    virtual void changeInspectedSimulationData(DataTO const& changeDataTO) = 0;
+
+    virtual void applyForce(ApplyForceData const& applyData) = 0;
+    virtual void switchSelection(PointSelectionData const& switchData) = 0;
+    virtual void swapSelection(PointSelectionData const& selectionData) = 0;
+    virtual void setSelection(AreaSelectionData const& selectionData) = 0;
+    virtual SelectionShallowData getSelectionShallowData() = 0;
+    virtual void shallowUpdateSelectedObjects(ShallowUpdateSelectionData const& shallowUpdateData) = 0;
+    virtual void removeSelection() = 0;
+    virtual void updateSelection() = 0;
+    virtual void colorSelectedObjects(unsigned char color, bool includeClusters) = 0;
+    virtual void reconnectSelectedObjects() = 0;
+    virtual void setDetached(bool value) = 0;
+
+    virtual void setGpuConstants(GpuSettings const& gpuConstants) = 0;
+    virtual SimulationParameters getSimulationParameters() const = 0;
+    virtual void setSimulationParameters(SimulationParameters const& parameters, SimulationParametersUpdateConfig const& updateConfig) = 0;
+
+    virtual ArraySizes getArraySizes() const = 0;
+
+    virtual RawStatisticsData getRawStatistics() = 0;
+    virtual void updateStatistics() = 0;
+    virtual StatisticsHistory const& getStatisticsHistory() const = 0;
+    virtual void setStatisticsHistory(StatisticsHistoryData const& data) = 0;
+
+    virtual void resetTimeIntervalStatistics() = 0;
+    virtual uint64_t getCurrentTimestep() const = 0;
+    virtual void setCurrentTimestep(uint64_t timestep) = 0;
+
+    virtual void clear() = 0;
+
+    virtual void resizeArraysIfNecessary(ArraySizes const& additionals) = 0;
+
+    // only for tests
+    virtual void testOnly_mutate(uint64_t cellId, MutationType mutationType) = 0;
+    virtual void testOnly_mutationCheck(uint64_t cellId) = 0;
+};
+
+template <typename Facade>
+class _EngineBackendAdapter : public _EngineBackend
+{
+public:
+    _EngineBackendAdapter(std::shared_ptr<Facade> const& facade, std::string const& deviceName);
+
+    std::string getDeviceName() const override;
+
+    void* registerImageResource(GLuint image) override;
+
+    void calcTimestep(uint64_t timesteps, bool forceUpdateStatistics) override;
+    void applyCataclysm(int power) override;
+
+    void drawVectorGraphics(float2 const& rectUpperLeft, float2 const& rectLowerRight, void* cudaResource, int2 const& imageSize, double zoom) override;
+    void getSimulationData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataTO const& dataTO) override;
+    void getSelectedSimulationData(bool includeClusters, DataTO const& dataTO) override;
+    void getInspectedSimulationData(std::vector<uint64_t> entityIds, DataTO const& dataTO) override;
+    void getOverlayData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataTO const& dataTO) override;
+    void addAndSelectSimulationData(DataTO const& dataTO) override;
+    void setSimulationData(DataTO const& dataTO) override;
+    void removeSelectedObjects(bool includeClusters) override;
+    void relaxSelectedObjects(bool includeClusters) override;
+    void uniformVelocitiesForSelectedObjects(bool includeClusters) override;
+    void makeSticky(bool includeClusters) override;
+    void removeStickiness(bool includeClusters) override;
+    void setBarrier(bool value, bool includeClusters) override;
+    void changeInspectedSimulationData(DataTO const& changeDataTO) override;
+
+    void applyForce(ApplyForceData const& applyData) override;
+    void switchSelection(PointSelectionData const& switchData) override;
+    void swapSelection(PointSelectionData const& selectionData) override;
+    void setSelection(AreaSelectionData const& selectionData) override;
+    SelectionShallowData getSelectionShallowData() override;
+    void shallowUpdateSelectedObjects(ShallowUpdateSelectionData const& shallowUpdateData) override;
+    void removeSelection() override;
+    void updateSelection() override;
+    void colorSelectedObjects(unsigned char color, bool includeClusters) override;
+    void reconnectSelectedObjects() override;
+    void setDetached(bool value) override;
+
+    void setGpuConstants(GpuSettings const& gpuConstants) override;
+    SimulationParameters getSimulationParameters() const override;
+    void setSimulationParameters(SimulationParameters const& parameters, SimulationParametersUpdateConfig const& updateConfig) override;
+
+    ArraySizes getArraySizes() const override;
+
+    RawStatisticsData getRawStatistics() override;
+    void updateStatistics() override;
+    StatisticsHistory const& getStatisticsHistory() const override;
+    void setStatisticsHistory(StatisticsHistoryData const& data) override;
+
+    void resetTimeIntervalStatistics() override;
+    uint64_t getCurrentTimestep() const override;
+    void setCurrentTimestep(uint64_t timestep) override;
+
+    void clear() override;
+
+    void resizeArraysIfNecessary(ArraySizes const& additionals) override;
+
+    void testOnly_mutate(uint64_t cellId, MutationType mutationType) override;
+    void testOnly_mutationCheck(uint64_t cellId) override;
+
+private:
+    std::shared_ptr<Facade> _facade;
+    std::string _deviceName;
+};
+
+/************************************************************************/
+/* Implementation                                                       */
+/************************************************************************/
+
+template <typename Facade>
+_EngineBackendAdapter<Facade>::_EngineBackendAdapter(std::shared_ptr<Facade> const& facade, std::string const& deviceName)
+    : _facade(facade)
+    , _deviceName(deviceName)
+{}
+
+template <typename Facade>
+std::string _EngineBackendAdapter<Facade>::getDeviceName() const
+{
+    return _deviceName;
+}
+
+template <typename Facade>
+void* _EngineBackendAdapter<Facade>::registerImageResource(GLuint image)
+{
+    return _facade->registerImageResource(image);
+}
+
+template <typename Facade>
+void _EngineBackendAdapter<Facade>::calcTimestep(uint64_t timesteps, bool forceUpdateStatistics)
+{
+    _facade->calcTimestep(timesteps, forceUpdateStatistics);
+}
+
+template <typename Facade>
+void _EngineBackendAdapter<Facade>::applyCataclysm(int power)
+{
+    _facade->applyCataclysm(power);
+}
+
+template <typename Facade>
+void _EngineBackendAdapter<Facade>::drawVectorGraphics(
+    float2 const& rectUpperLeft,
+    float2 const& rectLowerRight,
+    void* cudaResource,
+    int2 const& imageSize,
+    double zoom)
+{
+    _facade->drawVectorGraphics(rectUpperLeft, rectLowerRight, cudaResource, imageSize, zoom);
+}
+
+template <typename Facade>
+void _EngineBackendAdapter<Facade>::getSimulationData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataTO const& dataTO)
+{
+    _facade->getSimulationData(rectUpperLeft, rectLowerRight, dataTO);
+}
+
+template <typename Facade>
+void _EngineBackendAdapter<Facade>::getSelectedSimulationData(bool includeClusters, DataTO const& dataTO)
+{
+    _facade->getSelectedSimulationData(includeClusters, dataTO);
+}
+
+template <typename Facade>
+void _EngineBackendAdapter<Facade>::getInspectedSimulationData(std::vector<uint64_t> entityIds, DataTO const& dataTO)
+{
+    _facade->getInspectedSimulationData(entityIds, dataTO);
+}
+
+template <typename Facade>
+void _EngineBackendAdapter<Facade>::getOverlayData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataTO const& dataTO)
+{
+    _facade->getOverlayData(rectUpperLeft, rectLowerRight, dataTO);
+}
+
+template <typename Facade>
+void _EngineBackendAdapter<Facade>::addAndSelectSimulationData(DataTO const& dataTO)
+{
+    _facade->addAndSelectSimulationData(dataTO);
+}
+
+template <typename Facade>
+void _EngineBackendAdapter<Facade>::setSimulationData(DataTO const& dataTO)
+{
+    _facade->setSimulationData(dataTO);
+}
+
+template <typename Facade>
+void _EngineBackendAdapter<Facade>::removeSelectedObjects(bool includeClusters)
+{
+    _facade->removeSelectedObjects(includeClusters);
+}
+
+template <typename Facade>
+void _EngineBackendAdapter<Facade>::relaxSelectedObjects(bool includeClusters)
+{
+    _facade->relaxSelectedObjects(includeClusters);
+}
+
+template <typename Facade>
+void _EngineBackendAdapter<Facade>::uniformVelocitiesForSelectedObjects(bool includeClusters)
+{
+    _facade->uniformVelocitiesForSelectedObjects(includeClusters);
+}
+
+template <typename Facade>
+void _EngineBackendAdapter<Facade>::makeSticky(bool includeClusters)
+{
+    _facade->makeSticky(includeClusters);
+}
+
+template <typename Facade>
+void _EngineBackendAdapter<Facade>::removeStickiness(bool includeClusters)
+{
+    _facade->removeStickiness(includeClusters);
+}
+
+template <typename Facade>
+void _EngineBackendAdapter<Facade>::setBarrier(bool value, bool includeClusters)
+{
+    _facade->setBarrier(value, includeClusters);
+}
+
+template <typename Facade>
+void _EngineBackendAdapter<Facade>::changeInspectedSimulationData(DataTO const& changeDataTO)
+{
+    _facade->changeInspectedSimulationData(changeDataTO);
+}
+
+template <typename Facade>
+void _EngineBackendAdapter<Facade>::applyForce(ApplyForceData const& applyData)
+{
+    _facade->applyForce(applyData);
+}
+
+template <typename Facade>
+void _EngineBackendAdapter<Facade>::switchSelection(PointSelectionData const& switchData)
+{
+    _facade->switchSelection(switchData);
+}
+
+template <typename Facade>
+void _EngineBackendAdapter<Facade>::swapSelection(PointSelectionData const& selectionData)
+{
+    _facade->swapSelection(selectionData);
+}
+
+template <typename Facade>
+void _EngineBackendAdapter<Facade>::setSelection(AreaSelectionData const& selectionData)
+{
+    _facade->setSelection(selectionData);
+}
+
+template <typename Facade>
+SelectionShallowData _EngineBackendAdapter<Facade>::getSelectionShallowData()
+{
+    return _facade->getSelectionShallowData();
+}
+
+template <typename Facade>
+void _EngineBackendAdapter<Facade>::shallowUpdateSelectedObjects(ShallowUpdateSelectionData const& shallowUpdateData)
+{
+    _facade->shallowUpdateSelectedObjects(shallowUpdateData);
+}
+
+template <typename Facade>
+void _EngineBackendAdapter<Facade>::removeSelection()
+{
+    _facade->removeSelection();
+}
+
+template <typename Facade>
+void _EngineBackendAdapter<Facade>::updateSelection()
+{
+    _facade->updateSelection();
+}
+
+template <typename Facade>
+void _EngineBackendAdapter<Facade>::colorSelectedObjects(unsigned char color, bool includeClusters)
+{
+    _facade->colorSelectedObjects(color, includeClusters);
+}
+
+template <typename Facade>
+void _EngineBackendAdapter<Facade>::reconnectSelectedObjects()
+{
+    _facade->reconnectSelectedObjects();
+}
+
+template <typename Facade>
+void _EngineBackendAdapter<Facade>::setDetached(bool value)
+{
+    _facade->setDetached(value);
+}
+
+template <typename Facade>
+void _EngineBackendAdapter<Facade>::setGpuConstants(GpuSettings const& gpuConstants)
+{
+    _facade->setGpuConstants(gpuConstants);
+}
+
+template <typename Facade>
+SimulationParameters _EngineBackendAdapter<Facade>::getSimulationParameters() const
+{
+    return _facade->getSimulationParameters();
+}
+
+template <typename Facade>
+void _EngineBackendAdapter<Facade>::setSimulationParameters(SimulationParameters const& parameters, SimulationParametersUpdateConfig const& updateConfig)
+{
+    _facade->setSimulationParameters(parameters, updateConfig);
+}
+
+template <typename Facade>
+ArraySizes _EngineBackendAdapter<Facade>::getArraySizes() const
+{
+    return _facade->getArraySizes();
+}
+
+template <typename Facade>
+RawStatisticsData _EngineBackendAdapter<Facade>::getRawStatistics()
+{
+    return _facade->getRawStatistics();
+}
+
+template <typename Facade>
+void _EngineBackendAdapter<Facade>::updateStatistics()
+{
+    _facade->updateStatistics();
+}
+
+template <typename Facade>
+StatisticsHistory const& _EngineBackendAdapter<Facade>::getStatisticsHistory() const
+{
+    return _facade->getStatisticsHistory();
+}
+
+template <typename Facade>
+void _EngineBackendAdapter<Facade>::setStatisticsHistory(StatisticsHistoryData const& data)
+{
+    _facade->setStatisticsHistory(data);
+}
+
+template <typename Facade>
+void _EngineBackendAdapter<Facade>::resetTimeIntervalStatistics()
+{
+    _facade->resetTimeIntervalStatistics();
+}
+
+template <typename Facade>
+uint64_t _EngineBackendAdapter<Facade>::getCurrentTimestep() const
+{
+    return _facade->getCurrentTimestep();
+}
+
+template <typename Facade>
+void _EngineBackendAdapter<Facade>::setCurrentTimestep(uint64_t timestep)
+{
+    _facade->setCurrentTimestep(timestep);
+}
+
+template <typename Facade>
+void _EngineBackendAdapter<Facade>::clear()
+{
+    _facade->clear();
+}
+
+template <typename Facade>
+void _EngineBackendAdapter<Facade>::resizeArraysIfNecessary(ArraySizes const& additionals)
+{
+    _facade->resizeArraysIfNecessary(additionals);
+}
+
+template <typename Facade>
+void _EngineBackendAdapter<Facade>::testOnly_mutate(uint64_t cellId, MutationType mutationType)
+{
+    _facade->testOnly_mutate(cellId, mutationType);
+}
+
+template <typename Facade>
+void _EngineBackendAdapter<Facade>::testOnly_mutationCheck(uint64_t cellId)
+{
+    _facade->testOnly_mutationCheck(cellId);
+}
@@ -0,0 +1,82 @@
+#include "EngineCommandQueue.h"
+
+#include <algorithm>
+
+#include "Base/Definitions.h"
+
+int EngineCommandQueue::executePendingCommands()
+{
+    std::deque<Command> commands;
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        commands.swap(_commands);
+    }
+    for (auto const& command : commands) {
+        auto waitingTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - command.submitTimepoint);
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            ++_accessStatistics.numRequests;
+            _accessStatistics.totalWaitingTime += waitingTime;
+            _accessStatistics.maxWaitingTime = std::max(_accessStatistics.maxWaitingTime, waitingTime);
+            _accessStatistics.lastWaitingTime = waitingTime;
+        }
+        command.func();
+    }
+    return toInt(commands.size());
+}
+
+void EngineCommandQueue::waitForCommands(std::optional<std::chrono::steady_clock::time_point> const& deadline)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    auto predicate = [this] { return !_commands.empty() || _wakeUp; };
+    if (deadline) {
+        _condition.wait_until(lock, *deadline, predicate);
+    } else {
+        _condition.wait(lock, predicate);
+    }
+    _wakeUp = false;
+    ++_accessStatistics.numWakeUps;
+}
+
+void EngineCommandQueue::wakeUp()
+{
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _wakeUp = true;
+    }
+    _condition.notify_one();
+}
+
+void EngineCommandQueue::open()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _closed = false;
+}
+
+void EngineCommandQueue::close()
+{
+    std::deque<Command> commands;
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _closed = true;
+        commands.swap(_commands);
+    }
+}
+
+EngineAccessStatistics EngineCommandQueue::getAccessStatistics() const
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    return _accessStatistics;
+}
+
+void EngineCommandQueue::addCommand(std::function<void()>&& func)
+{
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (_closed) {
+            return;
+        }
+        _commands.emplace_back(Command{std::move(func), std::chrono::steady_clock::now()});
+    }
+    _condition.notify_one();
+}
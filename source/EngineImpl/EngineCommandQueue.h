@@ -0,0 +1,64 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+
+#include "EngineInterface/EngineAccessStatistics.h"
+
+/**
+ * Commands are submitted from any thread and executed in batches on the engine worker thread between time steps.
+ * The worker thread blocks in waitForCommands() instead of polling while there is nothing to simulate.
+ * Commands of a closed queue are discarded such that their futures report a broken promise.
+ */
+class EngineCommandQueue
+{
+public:
+    template <typename Func>
+    std::future<std::invoke_result_t<Func>> submit(Func&& func);
+
+    //worker thread only
+    int executePendingCommands();  //returns the number of executed commands
+    void waitForCommands(std::optional<std::chrono::steady_clock::time_point> const& deadline = std::nullopt);  //returns on new commands, wakeUp() or deadline
+
+    void wakeUp();
+    void open();
+    void close();
+
+    EngineAccessStatistics getAccessStatistics() const;
+
+private:
+    void addCommand(std::function<void()>&& func);
+
+    struct Command
+    {
+        std::function<void()> func;
+        std::chrono::steady_clock::time_point submitTimepoint;
+    };
+
+    mutable std::mutex _mutex;
+    std::condition_variable _condition;
+    std::deque<Command> _commands;
+    bool _wakeUp = false;
+    bool _closed = true;
+    EngineAccessStatistics _accessStatistics;
+};
+
+/************************************************************************/
+/* Implementation                                                       */
+/************************************************************************/
+
+template <typename Func>
+std::future<std::invoke_result_t<Func>> EngineCommandQueue::submit(Func&& func)
+{
+    auto task = std::make_shared<std::packaged_task<std::invoke_result_t<Func>()>>(std::forward<Func>(func));
+    auto result = task->get_future();
+    addCommand([task] { (*task)(); });
+    return result;
+}
@@ -1,31 +1,56 @@
 #include "EngineWorker.h"
 
+#include <algorithm>
 #include <chrono>
+#include <fstream>
 
 #include "EngineGpuKernels/TOs.cuh"
 #include "EngineGpuKernels/SimulationCudaFacade.cuh"
+#include "EngineCpu/SimulationCpuFacade.h"
+#include "PersisterInterface/SimulationDeltaService.h"
 #include "AccessDataTOCache.h"
+#include "DataTOSerializer.h"
 #include "DescriptionConverter.h"
+#include "EngineBackend.h"
 
 namespace
 {
     std::chrono::milliseconds const FrameTimeout(500);
+    std::chrono::seconds const AccessTimeout(7);
+    std::chrono::milliseconds const SnapshotInterval(30);
 }
 
 void EngineWorker::newSimulation(uint64_t timestep, GeneralSettings const& generalSettings, SimulationParameters const& parameters)
 {
-    _accessState = 0;
+    _commandQueue.open();
     _settings.generalSettings = generalSettings;
     _settings.simulationParameters = parameters;
     _dataTOCache = std::make_shared<_AccessDataTOCache>();
-    _simulationCudaFacade = std::make_shared<_SimulationCudaFacade>(timestep, _settings);
+    if (_backendSettings.backend == SimulationBackend_Cpu) {
+        _backend = std::make_shared<_EngineBackendAdapter<_SimulationCpuFacade>>(
+            std::make_shared<_SimulationCpuFacade>(timestep, _settings, _backendSettings.numCpuThreads), _SimulationCpuFacade::getCpuName());
+    } else {
+        _backend = std::make_shared<_EngineBackendAdapter<_SimulationCudaFacade>>(
+            std::make_shared<_SimulationCudaFacade>(timestep, _settings), _SimulationCudaFacade::checkAndReturnGpuInfo().gpuModelName);
+    }
     _cudaResource = nullptr;
+    _snapshotsOutdated = true;
+}
+
+BackendSettings EngineWorker::getBackendSettings() const
+{
+    return _backendSettings;
+}
+
+void EngineWorker::setBackendSettings(BackendSettings const& value)
+{
+    _backendSettings = value;
 }
 
 void EngineWorker::clear()
 {
     EngineWorkerGuard access(this);
-    return _simulationCudaFacade->clear();
+    return _backend->clear();
 }
 
 void EngineWorker::setImageResource(void* image)
@@ -33,14 +58,20 @@ void EngineWorker::setImageResource(void* image)
     GLuint imageId = reinterpret_cast<uintptr_t>(image);
     _imageResource = imageId;
 
-    if (_simulationCudaFacade) {
+    if (_backend) {
         EngineWorkerGuard access(this);
-        _cudaResource = _simulationCudaFacade->registerImageResource(imageId);
+        _cudaResource = _backend->registerImageResource(imageId);
     }
 }
 
 std::string EngineWorker::getGpuName() const
 {
+    if (_backend) {
+        return _backend->getDeviceName();
+    }
+    if (_backendSettings.backend == SimulationBackend_Cpu) {
+        return _SimulationCpuFacade::getCpuName();
+    }
     return _SimulationCudaFacade::checkAndReturnGpuInfo().gpuModelName;
 }
 
@@ -54,7 +85,7 @@ void EngineWorker::tryDrawVectorGraphics(
 
     if (!access.isTimeout()) {
         registerImageResource();
-        _simulationCudaFacade->drawVectorGraphics(
+        _backend->drawVectorGraphics(
             {rectUpperLeft.x, rectUpperLeft.y}, {rectLowerRight.x, rectLowerRight.y}, _cudaResource, {imageSize.x, imageSize.y}, zoom);
         syncSimulationWithRenderingIfDesired();
     }
@@ -70,18 +101,17 @@ std::optional<OverlayDescription> EngineWorker::tryDrawVectorGraphicsAndReturnOv
 
     if (!access.isTimeout()) {
         registerImageResource();
-        _simulationCudaFacade->drawVectorGraphics(
+        _backend->drawVectorGraphics(
             {rectUpperLeft.x, rectUpperLeft.y}, {rectLowerRight.x, rectLowerRight.y}, _cudaResource, {imageSize.x, imageSize.y}, zoom);
 
         DataTO dataTO = provideTO();
 
-        _simulationCudaFacade->getOverlayData(
+        _backend->getOverlayData(
             {toInt(rectUpperLeft.x), toInt(rectUpperLeft.y)},
             int2{toInt(rectLowerRight.x), toInt(rectLowerRight.y)},
             dataTO);
 
-        DescriptionConverter converter(_settings.simulationParameters);
-        auto result = converter.convertTOtoOverlayDescription(dataTO);
+        auto result = DescriptionConverter::convertTOtoOverlayDescription({dataTO.cells, *dataTO.numCells}, {dataTO.particles, *dataTO.numParticles});
 
         syncSimulationWithRenderingIfDesired();
         return result;
@@ -97,6 +127,7 @@ bool EngineWorker::isSyncSimulationWithRendering() const
 void EngineWorker::setSyncSimulationWithRendering(bool value)
 {
     _syncSimulationWithRendering = value;
+    _commandQueue.wakeUp();
 }
 
 int EngineWorker::getSyncSimulationWithRenderingRatio() const
@@ -115,9 +146,9 @@ ClusteredDataDescription EngineWorker::getClusteredSimulationData(IntVector2D co
     {
         EngineWorkerGuard access(this);
 
-        dataTO.init(_simulationCudaFacade->getArraySizes());
+        dataTO.init(_backend->getArraySizes());
 
-        _simulationCudaFacade->getSimulationData({rectUpperLeft.x, rectUpperLeft.y}, int2{rectLowerRight.x, rectLowerRight.y}, dataTO);
+        _backend->getSimulationData({rectUpperLeft.x, rectUpperLeft.y}, int2{rectLowerRight.x, rectLowerRight.y}, dataTO);
     }
     DescriptionConverter converter(_settings.simulationParameters);
 
@@ -131,7 +162,7 @@ DataDescription EngineWorker::getSimulationData(IntVector2D const& rectUpperLeft
     EngineWorkerGuard access(this);
 
     auto dataTO = provideTO();
-    _simulationCudaFacade->getSimulationData({rectUpperLeft.x, rectUpperLeft.y}, int2{rectLowerRight.x, rectLowerRight.y}, dataTO);
+    _backend->getSimulationData({rectUpperLeft.x, rectUpperLeft.y}, int2{rectLowerRight.x, rectLowerRight.y}, dataTO);
 
     DescriptionConverter converter(_settings.simulationParameters);
     auto result = converter.convertTOtoDataDescription(dataTO);
@@ -144,7 +175,7 @@ ClusteredDataDescription EngineWorker::getSelectedClusteredSimulationData(bool i
 
     DataTO dataTO = provideTO();
     
-    _simulationCudaFacade->getSelectedSimulationData(includeClusters, dataTO);
+    _backend->getSelectedSimulationData(includeClusters, dataTO);
 
     DescriptionConverter converter(_settings.simulationParameters);
 
@@ -158,7 +189,7 @@ DataDescription EngineWorker::getSelectedSimulationData(bool includeClusters)
 
     DataTO dataTO = provideTO();
     
-    _simulationCudaFacade->getSelectedSimulationData(includeClusters, dataTO);
+    _backend->getSelectedSimulationData(includeClusters, dataTO);
 
     DescriptionConverter converter(_settings.simulationParameters);
 
@@ -173,7 +204,7 @@ DataDescription EngineWorker::getInspectedSimulationData(std::vector<uint64_t> o
 
     DataTO dataTO = provideTO();
     
-    _simulationCudaFacade->getInspectedSimulationData(objectsIds, dataTO);
+    _backend->getInspectedSimulationData(objectsIds, dataTO);
 
     DescriptionConverter converter(_settings.simulationParameters);
 
@@ -183,17 +214,17 @@ DataDescription EngineWorker::getInspectedSimulationData(std::vector<uint64_t> o
 
 RawStatisticsData EngineWorker::getRawStatistics() const
 {
-    return _simulationCudaFacade->getRawStatistics();
+    return _backend->getRawStatistics();
 }
 
 StatisticsHistory const& EngineWorker::getStatisticsHistory() const
 {
-    return _simulationCudaFacade->getStatisticsHistory();
+    return _backend->getStatisticsHistory();
 }
 
 void EngineWorker::setStatisticsHistory(StatisticsHistoryData const& data)
 {
-    _simulationCudaFacade->setStatisticsHistory(data);
+    _backend->setStatisticsHistory(data);
 }
 
 void EngineWorker::addAndSelectSimulationData(DataDescription const& dataToUpdate)
@@ -204,13 +235,13 @@ void EngineWorker::addAndSelectSimulationData(DataDescription const& dataToUpdat
 
     EngineWorkerGuard access(this);
 
-    _simulationCudaFacade->resizeArraysIfNecessary(arraySizes);
+    _backend->resizeArraysIfNecessary(arraySizes);
 
     DataTO dataTO = provideTO();
 
     converter.convertDescriptionToTO(dataTO, dataToUpdate);
 
-    _simulationCudaFacade->addAndSelectSimulationData(dataTO);
+    _backend->addAndSelectSimulationData(dataTO);
 }
 
 void EngineWorker::setClusteredSimulationData(ClusteredDataDescription const& dataToUpdate)
@@ -219,13 +250,13 @@ void EngineWorker::setClusteredSimulationData(ClusteredDataDescription const& da
 
     EngineWorkerGuard access(this);
 
-    _simulationCudaFacade->resizeArraysIfNecessary(converter.getArraySizes(dataToUpdate));
+    _backend->resizeArraysIfNecessary(converter.getArraySizes(dataToUpdate));
 
     DataTO dataTO = provideTO();
 
     converter.convertDescriptionToTO(dataTO, dataToUpdate);
 
-    _simulationCudaFacade->setSimulationData(dataTO);
+    _backend->setSimulationData(dataTO);
 }
 
 void EngineWorker::setSimulationData(DataDescription const& dataToUpdate)
@@ -234,54 +265,123 @@ void EngineWorker::setSimulationData(DataDescription const& dataToUpdate)
 
     EngineWorkerGuard access(this);
 
-    _simulationCudaFacade->resizeArraysIfNecessary(converter.getArraySizes(dataToUpdate));
+    _backend->resizeArraysIfNecessary(converter.getArraySizes(dataToUpdate));
 
     DataTO dataTO = provideTO();
     converter.convertDescriptionToTO(dataTO, dataToUpdate);
 
-    _simulationCudaFacade->setSimulationData(dataTO);
+    _backend->setSimulationData(dataTO);
+}
+
+void EngineWorker::saveSimulationData(std::filesystem::path const& filename, IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight)
+{
+    auto dataTO = copySimulationData(rectUpperLeft, rectLowerRight);
+    try {
+        {
+            std::ofstream stream(filename, std::ios::binary);
+            if (!stream) {
+                throw std::runtime_error("Could not open " + filename.string() + ".");
+            }
+            DataTOSerializer::serialize(dataTO, stream);
+        }
+        auto fingerprint = DataTOSerializer::calcFingerprint(dataTO);
+
+        std::lock_guard lock(_mutexForSavedData);
+        _savedDataFilename = filename;
+        _savedDataFingerprint = std::move(fingerprint);
+    } catch (...) {
+        dataTO.destroy();
+        throw;
+    }
+    dataTO.destroy();
+}
+
+bool EngineWorker::saveSimulationDataDelta(
+    std::filesystem::path const& filename,
+    std::filesystem::path const& baseFilename,
+    IntVector2D const& rectUpperLeft,
+    IntVector2D const& rectLowerRight)
+{
+    std::lock_guard lock(_mutexForSavedData);
+
+    std::error_code errorCode;
+    if (_savedDataFilename.empty() || !std::filesystem::equivalent(_savedDataFilename, baseFilename, errorCode)) {
+        return false;
+    }
+
+    auto dataTO = copySimulationData(rectUpperLeft, rectLowerRight);
+    try {
+        std::ofstream stream(filename, std::ios::binary);
+        if (!stream) {
+            throw std::runtime_error("Could not open " + filename.string() + ".");
+        }
+        _savedDataFingerprint = DataTOSerializer::serializeDelta(
+            dataTO, _savedDataFingerprint, SimulationDeltaService::get().calcBaseFilename(filename, baseFilename), stream);
+        _savedDataFilename = filename;
+    } catch (...) {
+        _savedDataFilename.clear();
+        dataTO.destroy();
+        throw;
+    }
+    dataTO.destroy();
+    return true;
+}
+
+void EngineWorker::loadSimulationData(std::filesystem::path const& filename)
+{
+    auto dataTO = DataTOSerializer::deserialize(filename);
+    try {
+        EngineWorkerGuard access(this);
+
+        _backend->resizeArraysIfNecessary(DataTOSerializer::getArraySizes(dataTO));
+        _backend->setSimulationData(dataTO);
+    } catch (...) {
+        dataTO.destroy();
+        throw;
+    }
+    dataTO.destroy();
 }
 
 void EngineWorker::removeSelectedObjects(bool includeClusters)
 {
     EngineWorkerGuard access(this);
 
-    _simulationCudaFacade->removeSelectedObjects(includeClusters);
+    _backend->removeSelectedObjects(includeClusters);
 }
 
 void EngineWorker::relaxSelectedObjects(bool includeClusters)
 {
     EngineWorkerGuard access(this);
 
-    _simulationCudaFacade->relaxSelectedObjects(includeClusters);
+    _backend->relaxSelectedObjects(includeClusters);
 }
 
 void EngineWorker::uniformVelocitiesForSelectedObjects(bool includeClusters)
 {
     EngineWorkerGuard access(this);
 
-    _simulationCudaFacade->uniformVelocitiesForSelectedObjects(includeClusters);
+    _backend->uniformVelocitiesForSelectedObjects(includeClusters);
 }
 
 void EngineWorker::makeSticky(bool includeClusters)
 {
     EngineWorkerGuard access(this);
 
-    _simulationCudaFacade->makeSticky(includeClusters);
+    _backend->makeSticky(includeClusters);
 }
 
 void EngineWorker::removeStickiness(bool includeClusters)
 {
     EngineWorkerGuard access(this);
 
-    _simulationCudaFacade->removeStickiness(includeClusters);
+    _backend->removeStickiness(includeClusters);
 }
 
 void EngineWorker::setBarrier(bool value, bool includeClusters)
 {
     EngineWorkerGuard access(this);
 
-    _simulationCudaFacade->setBarrier(value, includeClusters);
+    _backend->setBarrier(value, includeClusters);
 }
 
 void EngineWorker::changeCell(CellDescription const& changedCell)
@@ -293,7 +393,7 @@ void EngineWorker::changeCell(CellDescription const& changedCell)
     DescriptionConverter converter(_settings.simulationParameters);
     converter.convertDescriptionToTO(dataTO, changedCell);
 
-    _simulationCudaFacade->changeInspectedSimulationData(dataTO);
+    _backend->changeInspectedSimulationData(dataTO);
 }
 
 void EngineWorker::changeParticle(ParticleDescription const& changedParticle)
@@ -305,32 +405,33 @@ void EngineWorker::changeParticle(ParticleDescription const& changedParticle)
     DescriptionConverter converter(_settings.simulationParameters);
     converter.convertDescriptionToTO(dataTO, changedParticle);
 
-    _simulationCudaFacade->changeInspectedSimulationData(dataTO);
+    _backend->changeInspectedSimulationData(dataTO);
 }
 
 void EngineWorker::calcTimesteps(uint64_t timesteps)
 {
     EngineWorkerGuard access(this);
 
-    _simulationCudaFacade->calcTimestep(timesteps, true);
+    _backend->calcTimestep(timesteps, true);
 }
 
 void EngineWorker::applyCataclysm(int power)
 {
     EngineWorkerGuard access(this);
-    _simulationCudaFacade->applyCataclysm(power);
+    _backend->applyCataclysm(power);
 }
 
 void EngineWorker::beginShutdown()
 {
     _isShutdown.store(true);
+    _commandQueue.wakeUp();
 }
 
 void EngineWorker::endShutdown()
 {
     _isSimulationRunning = false;
     _isShutdown = false;
-    _simulationCudaFacade.reset();
+    _backend.reset();
 }
 
 int EngineWorker::getTpsRestriction() const
@@ -349,32 +450,40 @@ float EngineWorker::getTps() const
     return _tps.load();
 }
 
+EngineAccessStatistics EngineWorker::getAccessStatistics() const
+{
+    return _commandQueue.getAccessStatistics();
+}
+
 uint64_t EngineWorker::getCurrentTimestep() const
 {
-    return _simulationCudaFacade->getCurrentTimestep();
+    return _backend->getCurrentTimestep();
 }
 
 void EngineWorker::setCurrentTimestep(uint64_t value)
 {
     EngineWorkerGuard access(this);
-    _simulationCudaFacade->setCurrentTimestep(value);
+    _backend->setCurrentTimestep(value);
     resetTimeIntervalStatistics();
 }
 
 SimulationParameters EngineWorker::getSimulationParameters() const
 {
-    return _simulationCudaFacade->getSimulationParameters();
+    return _backend->getSimulationParameters();
 }
 
 void EngineWorker::setSimulationParameters(SimulationParameters const& parameters, SimulationParametersUpdateConfig const& updateConfig)
 {
-    _simulationCudaFacade->setSimulationParameters(parameters, updateConfig);
+    //unchanged parameters do not trigger an update of the engine
+    if (_backend->getSimulationParameters() == parameters) {
+        return;
+    }
+    _backend->setSimulationParameters(parameters, updateConfig);
 }
 
 void EngineWorker::setGpuSettings_async(GpuSettings const& gpuSettings)
 {
-    std::unique_lock<std::mutex> uniqueLock(_mutexForAsyncJobs);
-    _updateGpuSettingsJob = gpuSettings;
+    submitAsync([this, gpuSettings] { _backend->setGpuConstants(gpuSettings); });
 }
 
 void EngineWorker::applyForce_async(
@@ -383,101 +492,159 @@ void EngineWorker::applyForce_async(
     RealVector2D const& force,
     float radius)
 {
-    std::unique_lock<std::mutex> uniqueLock(_mutexForAsyncJobs);
-    _applyForceJobs.emplace_back(ApplyForceJob{start, end, force, radius});
+    submitAsync([=, this] { _backend->applyForce({{start.x, start.y}, {end.x, end.y}, {force.x, force.y}, radius, false}); });
 }
 
 void EngineWorker::switchSelection(RealVector2D const& pos, float radius)
 {
     EngineWorkerGuard access(this);
-    _simulationCudaFacade->switchSelection(PointSelectionData{{pos.x, pos.y}, radius});
+    _backend->switchSelection(PointSelectionData{{pos.x, pos.y}, radius});
 }
 
 void EngineWorker::swapSelection(RealVector2D const& pos, float radius)
 {
     EngineWorkerGuard access(this);
-    _simulationCudaFacade->swapSelection(PointSelectionData{{pos.x, pos.y}, radius});
+    _backend->swapSelection(PointSelectionData{{pos.x, pos.y}, radius});
 }
 
 SelectionShallowData EngineWorker::getSelectionShallowData()
 {
     EngineWorkerGuard access(this);
-    return _simulationCudaFacade->getSelectionShallowData();
+    return _backend->getSelectionShallowData();
 }
 
 void EngineWorker::setSelection(RealVector2D const& startPos, RealVector2D const& endPos)
 {
     EngineWorkerGuard access(this);
-    _simulationCudaFacade->setSelection(AreaSelectionData{{startPos.x, startPos.y}, {endPos.x, endPos.y}});
+    _backend->setSelection(AreaSelectionData{{startPos.x, startPos.y}, {endPos.x, endPos.y}});
 }
 
 void EngineWorker::removeSelection()
 {
     EngineWorkerGuard access(this);
-    _simulationCudaFacade->removeSelection();
+    _backend->removeSelection();
 }
 
 void EngineWorker::updateSelection()
 {
     EngineWorkerGuard access(this);
-    _simulationCudaFacade->updateSelection();
+    _backend->updateSelection();
 }
 
 void EngineWorker::shallowUpdateSelectedObjects(ShallowUpdateSelectionData const& updateData)
 {
     EngineWorkerGuard access(this);
-    _simulationCudaFacade->shallowUpdateSelectedObjects(updateData);
+    _backend->shallowUpdateSelectedObjects(updateData);
 }
 
 void EngineWorker::colorSelectedObjects(unsigned char color, bool includeClusters)
 {
     EngineWorkerGuard access(this);
-    _simulationCudaFacade->colorSelectedObjects(color, includeClusters);
+    _backend->colorSelectedObjects(color, includeClusters);
 }
 
 void EngineWorker::reconnectSelectedObjects()
 {
     EngineWorkerGuard access(this);
-    _simulationCudaFacade->reconnectSelectedObjects();
+    _backend->reconnectSelectedObjects();
 }
 
 void EngineWorker::setDetached(bool value)
 {
     EngineWorkerGuard access(this);
-    _simulationCudaFacade->setDetached(value);
+    _backend->setDetached(value);
+}
+
+SelectionShallowData EngineWorker::getSelectionShallowDataSnapshot() const
+{
+    return *_selectionSnapshot.getLatest();
+}
+
+void EngineWorker::setInspectedEntityIdsForSnapshot(std::vector<uint64_t> const& entityIds)
+{
+    {
+        std::unique_lock<std::mutex> lock(_mutexForSnapshotRequests);
+        if (_inspectedEntityIdsForSnapshot == entityIds) {
+            return;
+        }
+        _inspectedEntityIdsForSnapshot = entityIds;
+    }
+    _commandQueue.submit([this] { _snapshotsOutdated = true; });
+}
+
+std::shared_ptr<InspectedDataSnapshot const> EngineWorker::getInspectedDataSnapshot() const
+{
+    return _inspectedDataSnapshot.getLatest();
+}
+
+void EngineWorker::setOverlayRegionForSnapshot(std::optional<RealRect> const& region)
+{
+    {
+        std::unique_lock<std::mutex> lock(_mutexForSnapshotRequests);
+        auto isEqual = region.has_value() == _overlayRegionForSnapshot.has_value()
+            && (!region || (region->topLeft == _overlayRegionForSnapshot->topLeft && region->bottomRight == _overlayRegionForSnapshot->bottomRight));
+        if (isEqual) {
+            return;
+        }
+        _overlayRegionForSnapshot = region;
+    }
+    _commandQueue.submit([this] { _snapshotsOutdated = true; });
+}
+
+std::shared_ptr<OverlaySnapshot const> EngineWorker::getOverlaySnapshot() const
+{
+    //the conversion is done by the reader such that the worker thread only copies the transfer objects
+    auto overlayTO = _overlayTOSnapshot.getLatest();
+    std::unique_lock<std::mutex> lock(_mutexForOverlaySnapshot);
+    if (overlayTO != _overlaySnapshotSource) {
+        OverlaySnapshot overlay{.region = overlayTO->region};
+        overlay.overlay = DescriptionConverter::convertTOtoOverlayDescription(overlayTO->cells, overlayTO->particles);
+        std::sort(overlay.overlay.elements.begin(), overlay.overlay.elements.end(), [](auto const& left, auto const& right) {
+            return left.id < right.id;
+        });
+        _overlaySnapshot = std::make_shared<OverlaySnapshot const>(std::move(overlay));
+        _overlaySnapshotSource = overlayTO;
+    }
+    return _overlaySnapshot;
 }
 
 void EngineWorker::runThreadLoop()
 {
     try {
-        std::mutex mutexForLoop;
-        std::unique_lock<std::mutex> lockForLoop(mutexForLoop);
-
         while (!_isShutdown.load()) {
 
-            if (!_syncSimulationWithRendering && _accessState == 0) {
+            if (!_syncSimulationWithRendering) {
                 if (_isSimulationRunning.load()) {
-                    _simulationCudaFacade->calcTimestep(1, false);
+                    _backend->calcTimestep(1, false);
+                    _snapshotsOutdated = true;
                 }
                 measureTPS();
                 slowdownTPS();
             }
-            
-            processJobs();
 
-            if (_accessState == 1) {
-                _accessState = 2;
+            auto commandsExecuted = _commandQueue.executePendingCommands() > 0;
+            if (commandsExecuted) {
+                _snapshotsOutdated = true;
+            }
+
+            //nothing to simulate => sleep until the next command arrives
+            auto isIdle = _syncSimulationWithRendering || !_isSimulationRunning.load();
+            publishSnapshotsIfDesired(isIdle || commandsExecuted);
+            if (!_isShutdown.load() && isIdle) {
+                _commandQueue.waitForCommands();
             }
         }
     } catch (std::exception const& e) {
         std::unique_lock<std::mutex> uniqueLock(_exceptionData.mutex);
         _exceptionData.errorMessage = e.what();
     }
+    _commandQueue.close();
 }
 
 void EngineWorker::runSimulation()
 {
     _isSimulationRunning.store(true);
+    _commandQueue.wakeUp();
 }
 
 void EngineWorker::pauseSimulation()
@@ -494,66 +661,126 @@ bool EngineWorker::isSimulationRunning() const
 void EngineWorker::testOnly_mutate(uint64_t cellId, MutationType mutationType)
 {
     EngineWorkerGuard access(this);
-    _simulationCudaFacade->testOnly_mutate(cellId, mutationType);
+    _backend->testOnly_mutate(cellId, mutationType);
 }
 
 void EngineWorker::testOnly_mutationCheck(uint64_t cellId)
 {
     EngineWorkerGuard access(this);
-    _simulationCudaFacade->testOnly_mutationCheck(cellId);
+    _backend->testOnly_mutationCheck(cellId);
 }
 
 DataTO EngineWorker::provideTO()
 {
-    return _dataTOCache->getDataTO(_simulationCudaFacade->getArraySizes());
+    return _dataTOCache->getDataTO(_backend->getArraySizes());
+}
+
+DataTO EngineWorker::copySimulationData(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight)
+{
+    EngineWorkerGuard access(this);
+
+    DataTO result;
+    result.init(_backend->getArraySizes());
+    try {
+        _backend->getSimulationData({rectUpperLeft.x, rectUpperLeft.y}, int2{rectLowerRight.x, rectLowerRight.y}, result);
+    } catch (...) {
+        result.destroy();
+        throw;
+    }
+    return result;
 }
 
 void EngineWorker::resetTimeIntervalStatistics()
 {
-    _simulationCudaFacade->resetTimeIntervalStatistics();
+    _backend->resetTimeIntervalStatistics();
 }
 
-void EngineWorker::processJobs()
+void EngineWorker::submitAsync(std::function<void()>&& func)
 {
-    std::unique_lock<std::mutex> asyncJobsLock(_mutexForAsyncJobs);
-    if (_updateGpuSettingsJob) {
-        _simulationCudaFacade->setGpuConstants(*_updateGpuSettingsJob);
-        _updateGpuSettingsJob = std::nullopt;
-    }
-    if (!_applyForceJobs.empty()) {
-        for (auto const& applyForceJob : _applyForceJobs) {
-            _simulationCudaFacade->applyForce(
-                {{applyForceJob.start.x, applyForceJob.start.y},
-                 {applyForceJob.end.x, applyForceJob.end.y},
-                 {applyForceJob.force.x, applyForceJob.force.y},
-                 applyForceJob.radius,
-                 false});
+    _commandQueue.submit([this, func = std::move(func)] {
+        try {
+            func();
+        } catch (std::exception const& e) {
+            std::unique_lock<std::mutex> uniqueLock(_exceptionData.mutex);
+            _exceptionData.errorMessage = e.what();
         }
-        _applyForceJobs.clear();
-    }
+    });
 }
 
 void EngineWorker::syncSimulationWithRenderingIfDesired()
 {
     if (_syncSimulationWithRendering && _isSimulationRunning) {
         for (int i = 0; i < _syncSimulationWithRenderingRatio; ++i) {
-            calcTimesteps(1);
+            _backend->calcTimestep(1, true);
             measureTPS();
             slowdownTPS();
         }
     }
 }
 
-void EngineWorker::waitAndAllowAccess(std::chrono::microseconds const& duration)
+void EngineWorker::executeCommandsFor(std::chrono::microseconds const& duration)
 {
-    auto startTimepoint = std::chrono::steady_clock::now();
-    while (std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTimepoint) < duration) {
-        if (_accessState == 1) {
-            _accessState = 2;
+    auto endTimepoint = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < endTimepoint && !_isShutdown.load()) {
+        _commandQueue.waitForCommands(endTimepoint);
+        if (_commandQueue.executePendingCommands() > 0) {
+            _snapshotsOutdated = true;
+            publishSnapshotsIfDesired(true);
         }
     }
 }
 
+void EngineWorker::publishSnapshotsIfDesired(bool immediately)
+{
+    if (!_snapshotsOutdated) {
+        return;
+    }
+    //snapshots outdated by time steps alone are throttled to avoid slowing down the simulation,
+    //changes made by commands are published immediately such that the GUI sees its own modifications in the next frame
+    auto timepoint = std::chrono::steady_clock::now();
+    if (!immediately && _snapshotTimepoint && timepoint - *_snapshotTimepoint < SnapshotInterval) {
+        return;
+    }
+    _snapshotTimepoint = timepoint;
+    _snapshotsOutdated = false;
+    publishSnapshots();
+}
+
+void EngineWorker::publishSnapshots()
+{
+    std::vector<uint64_t> inspectedEntityIds;
+    std::optional<RealRect> overlayRegion;
+    {
+        std::unique_lock<std::mutex> lock(_mutexForSnapshotRequests);
+        inspectedEntityIds = _inspectedEntityIdsForSnapshot;
+        overlayRegion = _overlayRegionForSnapshot;
+    }
+
+    _selectionSnapshot.publish(_backend->getSelectionShallowData());
+
+    DescriptionConverter converter(_settings.simulationParameters);
+
+    InspectedDataSnapshot inspectedData{.entityIds = inspectedEntityIds};
+    if (!inspectedEntityIds.empty()) {
+        auto dataTO = provideTO();
+        _backend->getInspectedSimulationData(inspectedEntityIds, dataTO);
+        inspectedData.data = converter.convertTOtoDataDescription(dataTO);
+    }
+    _inspectedDataSnapshot.publish(std::move(inspectedData));
+
+    OverlayTOSnapshot overlayTO{.region = overlayRegion};
+    if (overlayRegion) {
+        auto dataTO = provideTO();
+        _backend->getOverlayData(
+            {toInt(overlayRegion->topLeft.x), toInt(overlayRegion->topLeft.y)},
+            {toInt(overlayRegion->bottomRight.x), toInt(overlayRegion->bottomRight.y)},
+            dataTO);
+        overlayTO.cells.assign(dataTO.cells, dataTO.cells + *dataTO.numCells);
+        overlayTO.particles.assign(dataTO.particles, dataTO.particles + *dataTO.numParticles);
+    }
+    _overlayTOSnapshot.publish(std::move(overlayTO));
+}
+
 void EngineWorker::measureTPS()
 {
     if (_isSimulationRunning.load()) {
@@ -589,7 +816,7 @@ void EngineWorker::slowdownTPS()
         if (_isSimulationRunning.load() && tpsRestriction > 0) {
             auto desiredDuration = std::chrono::microseconds(1000000 / tpsRestriction);
             if (desiredDuration > timestepDuration) {
-                waitAndAllowAccess(desiredDuration - timestepDuration);
+                executeCommandsFor(desiredDuration - timestepDuration);
             } else {
             }
             _slowDownOvershot = std::min(std::max(timestepDuration - desiredDuration, std::chrono::microseconds(0)), desiredDuration);
@@ -601,7 +828,7 @@ void EngineWorker::slowdownTPS()
 void EngineWorker::registerImageResource()
 {
     if (_imageResource && !_cudaResource) {
-        _cudaResource = _simulationCudaFacade->registerImageResource(*_imageResource);
+        _cudaResource = _backend->registerImageResource(*_imageResource);
     }
 }
 
@@ -609,31 +836,24 @@ EngineWorkerGuard::EngineWorkerGuard(EngineWorker* worker, std::optional<std::ch
     : _worker(worker)
 {
     _worker->_mutexForEngineWorkerGuard.lock();
-    checkForException(worker->_exceptionData);
-
-    worker->_accessState = 1;
-
-    auto startTimepoint = std::chrono::steady_clock::now();
-    while (worker->_accessState == 1) {
-        auto timePassed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTimepoint);
-        if (maxDuration) {
-            if (timePassed > *maxDuration) {
-                _isTimeout = true;
-                break;
-            }
-        } else {
-            if (timePassed > std::chrono::seconds(7)) {
-                _isTimeout = true;
-                throw std::runtime_error("GPU worker thread is not reachable.");
-            }
-        }
+    try {
+        checkForException(worker->_exceptionData);
+        requestAccess(maxDuration);
+    } catch (...) {
+        _worker->_mutexForEngineWorkerGuard.unlock();
+        throw;
     }
-
 }
 
 EngineWorkerGuard::~EngineWorkerGuard()
 {
-    _worker->_accessState = 0;
+    {
+        std::unique_lock<std::mutex> lock(_access->mutex);
+        if (_access->state == AccessState::Granted) {
+            _access->state = AccessState::Released;
+        }
+    }
+    _access->condition.notify_all();
     _worker->_mutexForEngineWorkerGuard.unlock();
 }
 
@@ -642,6 +862,38 @@ bool EngineWorkerGuard::isTimeout() const
     return _isTimeout;
 }
 
+void EngineWorkerGuard::requestAccess(std::optional<std::chrono::milliseconds> const& maxDuration)
+{
+    //the worker thread grants the access by executing the command and waits until the guard releases it,
+    //the promise is owned by the command such that a discarded command breaks it
+    _access = std::make_shared<Access>();
+    auto grantPromise = std::make_shared<std::promise<void>>();
+    auto grantFuture = grantPromise->get_future();
+    _worker->_commandQueue.submit([access = _access, grantPromise] {
+        std::unique_lock<std::mutex> lock(access->mutex);
+        if (access->state == AccessState::Cancelled) {
+            return;
+        }
+        access->state = AccessState::Granted;
+        grantPromise->set_value();
+        access->condition.wait(lock, [&] { return access->state == AccessState::Released; });
+    });
+
+    auto timeout = maxDuration ? std::chrono::duration_cast<std::chrono::microseconds>(*maxDuration) : std::chrono::microseconds(AccessTimeout);
+    grantFuture.wait_for(timeout);
+
+    std::unique_lock<std::mutex> lock(_access->mutex);
+    if (_access->state == AccessState::Granted) {
+        return;
+    }
+    _access->state = AccessState::Cancelled;
+    auto isCommandDiscarded = grantFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    if (!maxDuration || isCommandDiscarded) {
+        throw std::runtime_error("GPU worker thread is not reachable.");
+    }
+    _isTimeout = true;
+}
+
 void EngineWorkerGuard::checkForException(ExceptionData const& exceptionData)
 {
     std::unique_lock<std::mutex> uniqueLock(exceptionData.mutex);
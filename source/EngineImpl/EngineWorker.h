@@ -3,6 +3,7 @@
 #include <atomic>
 #include <mutex>
 #include <condition_variable>
+#include <filesystem>
 
 #if defined(_WIN32)
 #include <windows.h>
@@ -10,7 +11,9 @@
 #include <GL/gl.h>
 
 #include "Base/Definitions.h"
+#include "Base/SnapshotBuffer.h"
 
+#include "EngineInterface/BackendSettings.h"
 #include "EngineInterface/Definitions.h"
 #include "EngineInterface/SimulationParameters.h"
 #include "EngineInterface/GpuSettings.h"
@@ -22,10 +25,23 @@
 #include "EngineInterface/MutationType.h"
 #include "EngineInterface/StatisticsHistory.h"
 #include "EngineInterface/SimulationParametersUpdateConfig.h"
+#include "EngineInterface/EngineAccessStatistics.h"
+#include "EngineInterface/EngineSnapshots.h"
 
 #include "EngineGpuKernels/Definitions.h"
+#include "EngineGpuKernels/TOs.cuh"
 
+#include "DataTOFingerprint.h"
 #include "Definitions.h"
+#include "EngineCommandQueue.h"
+
+//overlay data copied by the worker thread, converted to an OverlaySnapshot by the reader
+struct OverlayTOSnapshot
+{
+    std::optional<RealRect> region;
+    std::vector<CellTO> cells;
+    std::vector<ParticleTO> particles;
+};
 
 struct ExceptionData
 {
@@ -42,6 +58,9 @@ public:
     void newSimulation(uint64_t timestep, GeneralSettings const& generalSettings, SimulationParameters const& parameters);
     void clear();
 
+    BackendSettings getBackendSettings() const;
+    void setBackendSettings(BackendSettings const& value);  //takes effect with the next call of newSimulation
+
     void setImageResource(void* image);
     std::string getGpuName() const;
 
@@ -66,6 +85,13 @@ public:
     void addAndSelectSimulationData(DataDescription const& dataToUpdate);
     void setClusteredSimulationData(ClusteredDataDescription const& dataToUpdate);
     void setSimulationData(DataDescription const& dataToUpdate);
+    void saveSimulationData(std::filesystem::path const& filename, IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight);
+    bool saveSimulationDataDelta(
+        std::filesystem::path const& filename,
+        std::filesystem::path const& baseFilename,
+        IntVector2D const& rectUpperLeft,
+        IntVector2D const& rectLowerRight);
+    void loadSimulationData(std::filesystem::path const& filename);
     void removeSelectedObjects(bool includeClusters);
     void relaxSelectedObjects(bool includeClusters);
     void uniformVelocitiesForSelectedObjects(bool includeClusters);
@@ -85,6 +111,7 @@ public:
     void setTpsRestriction(int value);
 
     float getTps() const;
+    EngineAccessStatistics getAccessStatistics() const;
     uint64_t getCurrentTimestep() const;
     void setCurrentTimestep(uint64_t value);
 
@@ -107,6 +134,13 @@ public:
     void reconnectSelectedObjects();
     void setDetached(bool value);
 
+    //snapshots are published between time steps, reading them does not interrupt the worker thread
+    SelectionShallowData getSelectionShallowDataSnapshot() const;
+    void setInspectedEntityIdsForSnapshot(std::vector<uint64_t> const& entityIds);
+    std::shared_ptr<InspectedDataSnapshot const> getInspectedDataSnapshot() const;
+    void setOverlayRegionForSnapshot(std::optional<RealRect> const& region);
+    std::shared_ptr<OverlaySnapshot const> getOverlaySnapshot() const;
+
     void runThreadLoop();
     void runSimulation();
     void pauseSimulation();
@@ -118,42 +152,55 @@ public:
 
 private:
     DataTO provideTO(); 
+    DataTO copySimulationData(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight);  //returned DataTO has to be destroyed
     void resetTimeIntervalStatistics();
-    void processJobs();
+
+    //the futures of asynchronous commands are not awaited, hence their exceptions are recorded in _exceptionData
+    void submitAsync(std::function<void()>&& func);
 
     void syncSimulationWithRenderingIfDesired();
-    void waitAndAllowAccess(std::chrono::microseconds const& duration);
+    void executeCommandsFor(std::chrono::microseconds const& duration);
+    void publishSnapshotsIfDesired(bool immediately);
+    void publishSnapshots();
     void measureTPS();
     void slowdownTPS();
 
     void registerImageResource();
 
-    CudaSimulationFacade _simulationCudaFacade;
+    EngineBackend _backend;
 
     //settings
     Settings _settings;
+    BackendSettings _backendSettings;
 
     //sync
     std::atomic<bool> _syncSimulationWithRendering{false};
     std::atomic<int> _syncSimulationWithRenderingRatio{2};
-    std::atomic<int> _accessState{0};  //0 = worker thread has access, 1 = require access from other thread, 2 = access granted to other thread
     std::atomic<bool> _isSimulationRunning{false};
     std::atomic<bool> _isShutdown{false};
     ExceptionData _exceptionData;
 
-    //async jobs
+    //commands from other threads including the access requests of EngineWorkerGuard
     std::mutex _mutexForEngineWorkerGuard;
-    mutable std::mutex _mutexForAsyncJobs;
-    std::optional<GpuSettings> _updateGpuSettingsJob;
-
-    struct ApplyForceJob
-    {
-        RealVector2D start;
-        RealVector2D end;
-        RealVector2D force;
-        float radius;
-    };
-    std::vector<ApplyForceJob> _applyForceJobs;
+    EngineCommandQueue _commandQueue;
+
+    //snapshots
+    SnapshotBuffer<SelectionShallowData> _selectionSnapshot;
+    SnapshotBuffer<InspectedDataSnapshot> _inspectedDataSnapshot;
+    SnapshotBuffer<OverlayTOSnapshot> _overlayTOSnapshot;
+    mutable std::mutex _mutexForOverlaySnapshot;
+    mutable std::shared_ptr<OverlayTOSnapshot const> _overlaySnapshotSource;
+    mutable std::shared_ptr<OverlaySnapshot const> _overlaySnapshot;
+    std::mutex _mutexForSnapshotRequests;
+    std::vector<uint64_t> _inspectedEntityIdsForSnapshot;
+    std::optional<RealRect> _overlayRegionForSnapshot;
+    bool _snapshotsOutdated = false;
+    std::optional<std::chrono::steady_clock::time_point> _snapshotTimepoint;
+
+    //base for delta snapshots: the last file written by saveSimulationData or saveSimulationDataDelta
+    std::mutex _mutexForSavedData;
+    std::filesystem::path _savedDataFilename;
+    DataTOFingerprint _savedDataFingerprint;
 
     //time step measurements
     std::atomic<int> _tpsRestriction{0};  //0 = no restriction
@@ -169,6 +216,7 @@ private:
     AccessDataTOCache _dataTOCache;
 };
 
+//submits a command that suspends the worker thread between time steps until the guard is destroyed
 class EngineWorkerGuard
 {
 public:
@@ -178,9 +226,25 @@ public:
     bool isTimeout() const;
 
 private:
+    void requestAccess(std::optional<std::chrono::milliseconds> const& maxDuration);
     void checkForException(ExceptionData const& exceptionData);
 
     EngineWorker* _worker;
 
+    enum class AccessState
+    {
+        Requested,
+        Granted,
+        Cancelled,
+        Released
+    };
+    struct Access
+    {
+        std::mutex mutex;
+        std::condition_variable condition;
+        AccessState state = AccessState::Requested;
+    };
+    std::shared_ptr<Access> _access;
+
     bool _isTimeout = false;
 };
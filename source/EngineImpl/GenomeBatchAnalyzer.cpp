@@ -0,0 +1,83 @@
+#include "GenomeBatchAnalyzer.h"
+
+#include <algorithm>
+
+#include "Base/Definitions.h"
+#include "Base/ThreadPool.h"
+#include "EngineInterface/GenomeAnalysis.h"
+#include "EngineInterface/GenomeConstants.h"
+
+namespace
+{
+    auto constexpr MinChunkSize = 64;
+}
+
+std::vector<GenomeAnalysisResult> GenomeBatchAnalyzer::analyze(DataTO const& dataTO, ThreadPool& threadPool)
+{
+    return threadPool.parallelCollect<GenomeAnalysisResult>(
+        *dataTO.numCells,
+        [&](size_t startIndex, size_t endIndex, std::vector<GenomeAnalysisResult>& result) {
+            for (auto index = startIndex; index < endIndex; ++index) {
+                auto const& cell = dataTO.cells[index];
+                uint64_t genomeDataIndex;
+                uint16_t genomeSize;
+                uint32_t genomeGeneration;
+                if (cell.cellFunction == CellFunction_Constructor) {
+                    genomeDataIndex = cell.cellFunctionData.constructor.genomeDataIndex;
+                    genomeSize = cell.cellFunctionData.constructor.genomeSize;
+                    genomeGeneration = cell.cellFunctionData.constructor.genomeGeneration;
+                } else if (cell.cellFunction == CellFunction_Injector) {
+                    genomeDataIndex = cell.cellFunctionData.injector.genomeDataIndex;
+                    genomeSize = cell.cellFunctionData.injector.genomeSize;
+                    genomeGeneration = cell.cellFunctionData.injector.genomeGeneration;
+                } else {
+                    continue;
+                }
+                if (genomeSize <= Const::GenomeHeaderSize || genomeDataIndex + genomeSize > *dataTO.numAuxiliaryData) {
+                    continue;
+                }
+                auto analysisResult = analyze(std::span<uint8_t const>(dataTO.auxiliaryData + genomeDataIndex, genomeSize));
+                analysisResult.cellId = cell.id;
+                analysisResult.cellFunction = cell.cellFunction;
+                analysisResult.genomeGeneration = genomeGeneration;
+                result.emplace_back(analysisResult);
+            }
+        },
+        MinChunkSize);
+}
+
+std::vector<GenomeAnalysisResult> GenomeBatchAnalyzer::analyze(std::vector<std::span<uint8_t const>> const& genomes, ThreadPool& threadPool)
+{
+    std::vector<GenomeAnalysisResult> result(genomes.size());
+    threadPool.parallelFor(
+        genomes.size(),
+        [&](size_t startIndex, size_t endIndex) {
+            for (auto index = startIndex; index < endIndex; ++index) {
+                result.at(index) = analyze(genomes.at(index));
+                result.at(index).cellId = index;
+            }
+        },
+        MinChunkSize);
+    return result;
+}
+
+GenomeAnalysisResult GenomeBatchAnalyzer::analyze(std::span<uint8_t const> genome)
+{
+    GenomeAnalysisResult result;
+    result.genomeSize = toInt(genome.size());
+    if (genome.size() < Const::GenomeHeaderSize) {
+        return result;
+    }
+    auto data = genome.data();
+    auto size = result.genomeSize;
+    result.numNodes = GenomeAnalysis::getNumNodes(data, size);
+    result.selfReplicating = GenomeAnalysis::containsSelfReplication(data, size);
+
+    //a single traversal for the remaining values
+    GenomeAnalysis::executeForEachNodeRecursively(data, size, true, true, [&](int depth, int nodeAddress, int repetitions) {
+        ++result.numNodesRecursively;
+        result.numNodesRecursivelyWithRepetitions += repetitions;
+        result.genomeDepth = std::max(result.genomeDepth, depth);
+    });
+    return result;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Base/Definitions.h"
+#include "EngineInterface/CellFunctionConstants.h"
+#include "EngineGpuKernels/TOs.cuh"
+
+#include "Definitions.h"
+
+struct GenomeAnalysisResult
+{
+    uint64_t cellId = 0;  //index of the genome if the genomes are passed directly
+    CellFunction cellFunction = CellFunction_Constructor;
+    uint32_t genomeGeneration = 0;
+    int genomeSize = 0;
+    int numNodes = 0;
+    int numNodesRecursively = 0;  //including the sub-genomes of separated parts
+    int numNodesRecursivelyWithRepetitions = 0;
+    int genomeDepth = 0;
+    bool selfReplicating = false;
+
+    bool operator==(GenomeAnalysisResult const&) const = default;
+};
+
+/**
+ * Analyzes many genomes at once on the host (e.g. for offline lineage analysis of a saved simulation).
+ * The genomes are traversed with GenomeAnalysis, i.e. the results agree with those of the CUDA kernels.
+ */
+class GenomeBatchAnalyzer
+{
+public:
+    //constructors and injectors with non-empty genomes in the order of the cells, genomes outside the auxiliary data are skipped
+    static std::vector<GenomeAnalysisResult> analyze(DataTO const& dataTO, ThreadPool& threadPool);
+
+    static std::vector<GenomeAnalysisResult> analyze(std::vector<std::span<uint8_t const>> const& genomes, ThreadPool& threadPool);
+
+    static GenomeAnalysisResult analyze(std::span<uint8_t const> genome);
+};
@@ -30,6 +30,16 @@ void _SimulationFacadeImpl::clear()
     _selectionNeedsUpdate = true;
 }
 
+BackendSettings _SimulationFacadeImpl::getBackendSettings() const
+{
+    return _worker.getBackendSettings();
+}
+
+void _SimulationFacadeImpl::setBackendSettings(BackendSettings const& value)
+{
+    _worker.setBackendSettings(value);
+}
+
 void _SimulationFacadeImpl::setImageResource(void* image)
 {
     _worker.setImageResource(image);
@@ -124,6 +134,24 @@ void _SimulationFacadeImpl::setSimulationData(DataDescription const& dataToUpdat
     _selectionNeedsUpdate = true;
 }
 
+void _SimulationFacadeImpl::saveSimulationData(std::filesystem::path const& filename)
+{
+    auto size = getWorldSize();
+    _worker.saveSimulationData(filename, {-10, -10}, {size.x + 10, size.y + 10});
+}
+
+bool _SimulationFacadeImpl::saveSimulationDataDelta(std::filesystem::path const& filename, std::filesystem::path const& baseFilename)
+{
+    auto size = getWorldSize();
+    return _worker.saveSimulationDataDelta(filename, baseFilename, {-10, -10}, {size.x + 10, size.y + 10});
+}
+
+void _SimulationFacadeImpl::loadSimulationData(std::filesystem::path const& filename)
+{
+    _worker.loadSimulationData(filename);
+    _selectionNeedsUpdate = true;
+}
+
 void _SimulationFacadeImpl::removeSelectedObjects(bool includeClusters)
 {
     _worker.removeSelectedObjects(includeClusters);
@@ -332,6 +360,31 @@ bool _SimulationFacadeImpl::updateSelectionIfNecessary()
     return result;
 }
 
+SelectionShallowData _SimulationFacadeImpl::getSelectionShallowDataSnapshot() const
+{
+    return _worker.getSelectionShallowDataSnapshot();
+}
+
+void _SimulationFacadeImpl::setInspectedEntityIdsForSnapshot(std::vector<uint64_t> const& entityIds)
+{
+    _worker.setInspectedEntityIdsForSnapshot(entityIds);
+}
+
+std::shared_ptr<InspectedDataSnapshot const> _SimulationFacadeImpl::getInspectedDataSnapshot() const
+{
+    return _worker.getInspectedDataSnapshot();
+}
+
+void _SimulationFacadeImpl::setOverlayRegionForSnapshot(std::optional<RealRect> const& region)
+{
+    _worker.setOverlayRegionForSnapshot(region);
+}
+
+std::shared_ptr<OverlaySnapshot const> _SimulationFacadeImpl::getOverlaySnapshot() const
+{
+    return _worker.getOverlaySnapshot();
+}
+
 GeneralSettings _SimulationFacadeImpl::getGeneralSettings() const
 {
     return _generalSettings;
@@ -373,6 +426,11 @@ float _SimulationFacadeImpl::getTps() const
     return _worker.getTps();
 }
 
+EngineAccessStatistics _SimulationFacadeImpl::getEngineAccessStatistics() const
+{
+    return _worker.getAccessStatistics();
+}
+
 void _SimulationFacadeImpl::testOnly_mutate(uint64_t cellId, MutationType mutationType)
 {
     _worker.testOnly_mutate(cellId, mutationType);
@@ -21,6 +21,9 @@ public:
 
     void clear() override;
 
+    BackendSettings getBackendSettings() const override;
+    void setBackendSettings(BackendSettings const& value) override;
+
     void setImageResource(void* image) override;
     std::string getGpuName() const override;
 
@@ -54,6 +57,9 @@ public:
     void addAndSelectSimulationData(DataDescription const& dataToAdd) override;
     void setClusteredSimulationData(ClusteredDataDescription const& dataToUpdate) override;
     void setSimulationData(DataDescription const& dataToUpdate) override;
+    void saveSimulationData(std::filesystem::path const& filename) override;
+    bool saveSimulationDataDelta(std::filesystem::path const& filename, std::filesystem::path const& baseFilename) override;
+    void loadSimulationData(std::filesystem::path const& filename) override;
     void removeSelectedObjects(bool includeClusters) override;
     void relaxSelectedObjects(bool includeClusters) override;
     void uniformVelocitiesForSelectedObjects(bool includeClusters) override;
@@ -102,6 +108,12 @@ public:
     void removeSelection() override;
     bool updateSelectionIfNecessary() override;
 
+    SelectionShallowData getSelectionShallowDataSnapshot() const override;
+    void setInspectedEntityIdsForSnapshot(std::vector<uint64_t> const& entityIds) override;
+    std::shared_ptr<InspectedDataSnapshot const> getInspectedDataSnapshot() const override;
+    void setOverlayRegionForSnapshot(std::optional<RealRect> const& region) override;
+    std::shared_ptr<OverlaySnapshot const> getOverlaySnapshot() const override;
+
     GeneralSettings getGeneralSettings() const override;
     IntVector2D getWorldSize() const override;
     RawStatisticsData getRawStatistics() const override;
@@ -112,6 +124,7 @@ public:
     void setTpsRestriction(std::optional<int> const& value) override;
 
     float getTps() const override;
+    EngineAccessStatistics getEngineAccessStatistics() const override;
 
     // for tests only
     void testOnly_mutate(uint64_t cellId, MutationType mutationType) override;
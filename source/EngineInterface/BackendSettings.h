@@ -0,0 +1,17 @@
+#pragma once
+
+using SimulationBackend = int;
+enum SimulationBackend_
+{
+    SimulationBackend_Cuda,
+    SimulationBackend_Cpu
+};
+
+struct BackendSettings
+{
+    SimulationBackend backend = SimulationBackend_Cuda;
+    int numCpuThreads = 0;  //0 = use all hardware threads
+
+    bool operator==(BackendSettings const& other) const { return backend == other.backend && numCpuThreads == other.numCpuThreads; }
+    bool operator!=(BackendSettings const& other) const { return !operator==(other); }
+};
@@ -1,13 +1,15 @@
 #include "DescriptionEditService.h"
 
+#include <algorithm>
 #include <cmath>
+#include <stdexcept>
 #include <boost/range/adaptor/indexed.hpp>
 #include <boost/range/adaptor/map.hpp>
 
 #include "Base/NumberGenerator.h"
 #include "Base/Math.h"
 #include "GenomeDescriptions.h"
-#include "SpaceCalculator.h"
+#include "SpatialGrid.h"
 #include "GenomeDescriptionService.h"
 
 DataDescription DescriptionEditService::createRect(CreateRectParameters const& parameters)
@@ -200,40 +202,6 @@ void DescriptionEditService::duplicate(ClusteredDataDescription& data, IntVector
     data = result;
 }
 
-namespace
-{
-    std::vector<int> getCellIndicesWithinRadius(
-        DataDescription const& data,
-        std::unordered_map<int, std::unordered_map<int, std::vector<int>>> const& cellIndicesBySlot,
-        RealVector2D const& pos,
-        float radius)
-    {
-        std::vector<int> result;
-        IntVector2D upperLeftIntPos{toInt(pos.x - radius - 0.5f), toInt(pos.y - radius - 0.5f)};
-        IntVector2D lowerRightIntPos{toInt(pos.x + radius + 0.5f), toInt(pos.y + radius + 0.5f)};
-        for (int x = upperLeftIntPos.x; x <= lowerRightIntPos.x; ++x) {
-            for (int y = upperLeftIntPos.y; y <= lowerRightIntPos.y; ++y) {
-                if (cellIndicesBySlot.find(x) != cellIndicesBySlot.end()) {
-                    if (cellIndicesBySlot.at(x).find(y) != cellIndicesBySlot.at(x).end()) {
-                        for (auto const& cellIndex : cellIndicesBySlot.at(x).at(y)) {
-                            auto const& cell = data.cells.at(cellIndex);
-                            if (Math::length(cell.pos - pos) <= radius) {
-                                result.emplace_back(cellIndex);
-                            }
-                        }
-                    }
-                }
-            }
-        }
-        std::sort(result.begin(), result.end(), [&](int index1, int index2) {
-            auto const& cell1 = data.cells.at(index1);
-            auto const& cell2 = data.cells.at(index2);
-            return Math::length(cell1.pos - pos) < Math::length(cell2.pos - pos);
-        });
-        return result;
-    }
-}
-
 DataDescription DescriptionEditService::gridMultiply(DataDescription const& input, GridMultiplyParameters const& parameters)
 {
     DataDescription result;
@@ -263,6 +231,12 @@ DataDescription DescriptionEditService::gridMultiply(DataDescription const& inpu
     return result;
 }
 
+namespace
+{
+    auto constexpr OverlappingDistance = 2.0f;
+    auto constexpr MaxPlacementAttempts = 200;
+}
+
 DataDescription DescriptionEditService::randomMultiply(
     DataDescription const& input,
     RandomMultiplyParameters const& parameters,
@@ -271,17 +245,25 @@ DataDescription DescriptionEditService::randomMultiply(
     bool& overlappingCheckSuccessful)
 {
     overlappingCheckSuccessful = true;
-    SpaceCalculator spaceCalculator(worldSize);
-    std::unordered_map<IntVector2D, std::vector<RealVector2D>> cellPosBySlot;
 
-    //create map for overlapping check
+    //grid for overlapping check
+    SpatialGrid cellOccupancy(worldSize, OverlappingDistance);
     if (parameters._overlappingCheck) {
-        int index = 0;
+        std::vector<RealVector2D> positions;
+        positions.reserve(existentData.cells.size());
         for (auto const& cell : existentData.cells) {
-            auto intPos = toIntVector2D(spaceCalculator.getCorrectedPosition(cell.pos));
-            cellPosBySlot[intPos].emplace_back(cell.pos);
-            ++index;
+            positions.emplace_back(cell.pos);
         }
+        cellOccupancy.build(positions);
+    }
+
+    //only the positions are transformed for the overlapping check, the whole copy is created for the final placement
+    DataDescription shape;
+    for (auto const& cell : input.cells) {
+        shape.addCell(CellDescription().setPos(cell.pos));
+    }
+    for (auto const& particle : input.particles) {
+        shape.addParticle(ParticleDescription().setPos(particle.pos));
     }
 
     //do multiplication
@@ -290,47 +272,47 @@ DataDescription DescriptionEditService::randomMultiply(
     auto& numberGen = NumberGenerator::get();
     for (int i = 0; i < parameters._number; ++i) {
         bool overlapping = false;
-        DataDescription copy;
+        RealVector2D shift;
+        float angle;
         int attempts = 0;
         do {
-            copy = input;
-            removeMetadata(copy);
-            copy.shift({toFloat(numberGen.getRandomReal(0, toInt(worldSize.x))), toFloat(numberGen.getRandomReal(0, toInt(worldSize.y)))});
-            copy.rotate(toInt(numberGen.getRandomReal(parameters._minAngle, parameters._maxAngle)));
-            copy.accelerate(
-                {toFloat(numberGen.getRandomReal(parameters._minVelX, parameters._maxVelX)),
-                 toFloat(numberGen.getRandomReal(parameters._minVelY, parameters._maxVelY))},
-                toFloat(numberGen.getRandomReal(parameters._minAngularVel, parameters._maxAngularVel)));
+            shift = {toFloat(numberGen.getRandomReal(0, toInt(worldSize.x))), toFloat(numberGen.getRandomReal(0, toInt(worldSize.y)))};
+            angle = toFloat(toInt(numberGen.getRandomReal(parameters._minAngle, parameters._maxAngle)));
 
             //overlapping check
             overlapping = false;
             if (parameters._overlappingCheck) {
-                for (auto const& cell : copy.cells) {
-                    auto pos = spaceCalculator.getCorrectedPosition(cell.pos);
-                    if (isCellPresent(cellPosBySlot, spaceCalculator, pos, 2.0f)) {
-                        overlapping = true;
-                    }
-                }
+                auto shapeCopy = shape;
+                shapeCopy.shift(shift);
+                shapeCopy.rotate(angle);
+                overlapping = std::any_of(shapeCopy.cells.begin(), shapeCopy.cells.end(), [&](CellDescription const& cell) {
+                    return cellOccupancy.isOccupied(cell.pos, OverlappingDistance);
+                });
             }
             ++attempts;
-        } while (overlapping && attempts < 200 && overlappingCheckSuccessful);
-        if (attempts == 200) {
+        } while (overlapping && attempts < MaxPlacementAttempts && overlappingCheckSuccessful);
+        if (attempts == MaxPlacementAttempts) {
             overlappingCheckSuccessful = false;
         }
+        auto velX = toFloat(numberGen.getRandomReal(parameters._minVelX, parameters._maxVelX));
+        auto velY = toFloat(numberGen.getRandomReal(parameters._minVelY, parameters._maxVelY));
+        auto angularVel = toFloat(numberGen.getRandomReal(parameters._minAngularVel, parameters._maxAngularVel));
 
+        auto copy = input;
+        removeMetadata(copy);
+        copy.shift(shift);
+        copy.rotate(angle);
+        copy.accelerate({velX, velY}, angularVel);
         generateNewIds(copy);
         generateNewCreatureIds(copy);
-        result.add(copy);
 
-        //add copy to existentData for overlapping check
+        //add copy to occupancy for overlapping check
         if (parameters._overlappingCheck) {
             for (auto const& cell : copy.cells) {
-                auto index = toInt(existentData.cells.size());
-                existentData.cells.emplace_back(cell);
-                auto intPos = toIntVector2D(spaceCalculator.getCorrectedPosition(cell.pos));
-                cellPosBySlot[intPos].emplace_back(cell.pos);
+                cellOccupancy.insert(cell.pos);
             }
         }
+        result.add(copy);
     }
 
     return result;
@@ -343,33 +325,38 @@ void DescriptionEditService::addIfSpaceAvailable(
     float distance,
     IntVector2D const& worldSize)
 {
-    SpaceCalculator space(worldSize);
+    if (cellOccupancy.getWorldSize() != worldSize) {
+        auto positions = cellOccupancy.getPositions();
+        cellOccupancy = SpatialGrid(worldSize, distance);
+        cellOccupancy.build(positions);
+    }
 
     for (auto const& cell : toAdd.cells) {
-        if (!isCellPresent(cellOccupancy, space, cell.pos, distance)) {
+        if (!cellOccupancy.isOccupied(cell.pos, distance)) {
             result.addCell(cell);
-            cellOccupancy[toIntVector2D(cell.pos)].emplace_back(cell.pos);
+            cellOccupancy.insert(cell.pos);
         }
     }
 }
 
 void DescriptionEditService::reconnectCells(DataDescription& data, float maxDistance)
 {
-    std::unordered_map<int, std::unordered_map<int, std::vector<int>>> cellIndicesBySlot;
-
-    int index = 0;
+    std::vector<RealVector2D> positions;
+    positions.reserve(data.cells.size());
     for (auto& cell : data.cells) {
         cell.connections.clear();
-        cellIndicesBySlot[toInt(cell.pos.x)][toInt(cell.pos.y)].emplace_back(toInt(index));
-        ++index;
+        positions.emplace_back(cell.pos);
     }
+    SpatialGrid grid(maxDistance);
+    grid.build(positions);
+    auto nearbyCellIndicesByCell = grid.getIndicesWithinRadius(positions, maxDistance);
 
     std::unordered_map<uint64_t, int> cache;
     for (auto const& [index, cell] : data.cells | boost::adaptors::indexed(0)) {
         cache.emplace(cell.id, static_cast<int>(index));
     }
-    for (auto& cell : data.cells) {
-        auto nearbyCellIndices = getCellIndicesWithinRadius(data, cellIndicesBySlot, cell.pos, maxDistance);
+    for (auto const& [index, nearbyCellIndices] : nearbyCellIndicesByCell | boost::adaptors::indexed(0)) {
+        auto& cell = data.cells.at(index);
         for (auto const& nearbyCellIndex : nearbyCellIndices) {
             auto const& nearbyCell = data.cells.at(nearbyCellIndex);
             if (cell.id != nearbyCell.id && cell.connections.size() < cell.maxConnections && nearbyCell.connections.size() < nearbyCell.maxConnections
@@ -390,19 +377,27 @@ void DescriptionEditService::removeStickiness(DataDescription& data)
 void DescriptionEditService::correctConnections(ClusteredDataDescription& data, IntVector2D const& worldSize)
 {
     auto threshold = std::min(worldSize.x, worldSize.y) /3;
-    std::unordered_map<uint64_t, CellDescription&> cellById;
-    for (auto& cluster : data.clusters) {
-        for (auto& cell : cluster.cells) {
-            cellById.emplace(cell.id, cell);
+    std::vector<std::pair<uint64_t, RealVector2D>> cellPosById;
+    for (auto const& cluster : data.clusters) {
+        for (auto const& cell : cluster.cells) {
+            cellPosById.emplace_back(cell.id, cell.pos);
         }
     }
+    std::sort(cellPosById.begin(), cellPosById.end(), [](auto const& left, auto const& right) { return left.first < right.first; });
+    auto getCellPos = [&](uint64_t id) {
+        auto findResult = std::lower_bound(
+            cellPosById.begin(), cellPosById.end(), id, [](auto const& cellPosAndId, uint64_t id) { return cellPosAndId.first < id; });
+        if (findResult == cellPosById.end() || findResult->first != id) {
+            throw std::out_of_range("Connected cell not found.");
+        }
+        return findResult->second;
+    };
     for (auto& cluster : data.clusters) {
         for (auto& cell: cluster.cells) {
             std::vector<ConnectionDescription> newConnections;
             float angleToAdd = 0;
             for (auto connection : cell.connections) {
-                auto& connectingCell = cellById.at(connection.cellId);
-                if (/*spaceCalculator.distance*/Math::length(cell.pos - connectingCell.pos) > threshold) {
+                if (/*spaceCalculator.distance*/Math::length(cell.pos - getCellPos(connection.cellId)) > threshold) {
                     angleToAdd += connection.angleFromPrevious;
                 } else {
                     connection.angleFromPrevious += angleToAdd;
@@ -614,39 +609,6 @@ void DescriptionEditService::removeMetadata(CellDescription& cell)
     cell.metadata.name.clear();
 }
 
-bool DescriptionEditService::isCellPresent(Occupancy const& cellPosBySlot, SpaceCalculator const& spaceCalculator, RealVector2D const& posToCheck, float distance)
-{
-    auto intPos = toIntVector2D(posToCheck);
-
-    auto getMatchingSlots = [&cellPosBySlot](IntVector2D const& intPos) {
-        auto findResult = cellPosBySlot.find(intPos);
-        if (findResult != cellPosBySlot.end()) {
-            return findResult->second;
-        }
-        return std::vector<RealVector2D>{};
-    };
-
-    auto isOccupied = [&](std::vector<RealVector2D> const& cellPositions) {
-        for (auto const& cellPos : cellPositions) {
-            auto otherPos = spaceCalculator.getCorrectedPosition(cellPos);
-            if (Math::length(posToCheck - otherPos) < distance) {
-                return true;
-            }
-        }
-        return false;
-    };
-
-    auto distanceInt = toInt(ceilf(distance));
-    for (int dx = -distanceInt; dx <= distanceInt; ++dx) {
-        for (int dy = -distanceInt; dy <= distanceInt; ++dy) {
-            if (isOccupied(getMatchingSlots({intPos.x + dx, intPos.y + dy}))) {
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
 uint64_t DescriptionEditService::getId(CellOrParticleDescription const& entity)
 {
     if (std::holds_alternative<CellDescription>(entity)) {
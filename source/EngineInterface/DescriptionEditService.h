@@ -4,6 +4,7 @@
 #include "Base/Singleton.h"
 
 #include "Descriptions.h"
+#include "SpatialGrid.h"
 
 class DescriptionEditService
 {
@@ -96,7 +97,7 @@ public:
         DataDescription&& existentData,
         bool& overlappingCheckSuccessful);
 
-    using Occupancy = std::unordered_map<IntVector2D, std::vector<RealVector2D>>;
+    using Occupancy = SpatialGrid;
     void
     addIfSpaceAvailable(DataDescription& result, Occupancy& cellOccupancy, DataDescription const& toAdd, float distance, IntVector2D const& worldSize);
 
@@ -124,9 +125,4 @@ public:
 
 private:
     void removeMetadata(CellDescription& cell);
-    bool isCellPresent(
-        Occupancy const& cellPosBySlot,
-        SpaceCalculator const& spaceCalculator,
-        RealVector2D const& posToCheck,
-        float distance);
 };
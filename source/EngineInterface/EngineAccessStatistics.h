@@ -0,0 +1,19 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+//waiting times of the callers until their requests are executed by the engine worker thread
+struct EngineAccessStatistics
+{
+    uint64_t numRequests = 0;
+    std::chrono::microseconds totalWaitingTime{0};
+    std::chrono::microseconds maxWaitingTime{0};
+    std::chrono::microseconds lastWaitingTime{0};
+    uint64_t numWakeUps = 0;  //number of times the engine worker thread stopped waiting for requests
+
+    std::chrono::microseconds getAverageWaitingTime() const
+    {
+        return numRequests > 0 ? totalWaitingTime / static_cast<int64_t>(numRequests) : std::chrono::microseconds(0);
+    }
+};
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include "Base/Vector2D.h"
+
+#include "Descriptions.h"
+#include "OverlayDescriptions.h"
+
+//data published by the engine between time steps for readers that must not interrupt the simulation
+
+struct InspectedDataSnapshot
+{
+    std::vector<uint64_t> entityIds;  //requested ids the data belongs to
+    DataDescription data;
+};
+
+struct OverlaySnapshot
+{
+    std::optional<RealRect> region;  //requested region the overlay belongs to
+    OverlayDescription overlay;  //elements are sorted by id
+};
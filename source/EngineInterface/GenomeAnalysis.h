@@ -0,0 +1,402 @@
+#pragma once
+
+#include <cstdint>
+
+#include "CellFunctionConstants.h"
+#include "GenomeConstants.h"
+
+#if defined(__CUDACC__)
+#define GENOME_ANALYSIS_FUNC __host__ __device__ __inline__
+#define GENOME_ANALYSIS_EXEC_CHECK_DISABLE _Pragma("nv_exec_check_disable")
+#else
+#define GENOME_ANALYSIS_FUNC inline
+#define GENOME_ANALYSIS_EXEC_CHECK_DISABLE
+#endif
+
+/**
+ * Read-only traversal of encoded genomes shared by the CUDA kernels (via GenomeDecoder) and host code.
+ * The genomes are expected to be well-formed as produced by the engine, i.e. the bytes of each node lie within the genome.
+ */
+class GenomeAnalysis
+{
+public:
+    static auto constexpr MAX_SUBGENOME_RECURSION_DEPTH = 15;
+    static auto constexpr InfiniteRepetitions = 0x7fffffff;
+
+    //genome-wide methods
+    template <typename Func>
+    GENOME_ANALYSIS_FUNC static void executeForEachNode(uint8_t const* genome, int genomeSize, Func func);
+
+    //func(depth, nodeAddress, repetitions) is called for all nodes in pre-order, nodeAddress is relative to genome
+    //sub-genomes nested deeper than MAX_SUBGENOME_RECURSION_DEPTH are not scanned
+    template <typename Func>
+    GENOME_ANALYSIS_FUNC static void
+    executeForEachNodeRecursively(uint8_t const* genome, int genomeSize, bool includedSeparatedParts, bool countBranches, Func func);
+
+    GENOME_ANALYSIS_FUNC static int getGenomeDepth(uint8_t const* genome, int genomeSize);
+    GENOME_ANALYSIS_FUNC static int getNumNodesRecursively(uint8_t const* genome, int genomeSize, bool includeRepetitions, bool includedSeparatedParts);
+
+    //random has to provide int random(int maxValue) and bool randomBool()
+    template <typename RandomGenerator>
+    GENOME_ANALYSIS_FUNC static int getRandomGenomeNodeAddress(
+        RandomGenerator& random,
+        uint8_t const* genome,
+        int genomeSize,
+        bool considerZeroSubGenomes,
+        int* subGenomesSizeIndices = nullptr,
+        int* numSubGenomesSizeIndices = nullptr,
+        int randomRefIndex = 0);
+
+    GENOME_ANALYSIS_FUNC static int getNumNodes(uint8_t const* genome, int genomeSize);
+    GENOME_ANALYSIS_FUNC static int getNodeAddress(uint8_t const* genome, int genomeSize, int nodeIndex);
+    GENOME_ANALYSIS_FUNC static int findStartNodeAddress(uint8_t const* genome, int genomeSize, int refIndex);
+    GENOME_ANALYSIS_FUNC static bool containsSelfReplication(uint8_t const* genome, int genomeSize);
+    GENOME_ANALYSIS_FUNC static bool containsSectionSelfReplication(uint8_t const* genome, int genomeSize);
+    GENOME_ANALYSIS_FUNC static int getNodeAddressForSelfReplication(uint8_t const* genome, int genomeSize, bool& containsSelfReplicator);
+
+    //header methods
+    GENOME_ANALYSIS_FUNC static bool isSeparating(uint8_t const* genome);
+    GENOME_ANALYSIS_FUNC static int getNumRepetitions(uint8_t const* genome, bool countInfinityAsOne = false);
+    GENOME_ANALYSIS_FUNC static int getNumBranches(uint8_t const* genome);
+
+    //node-wide methods
+    GENOME_ANALYSIS_FUNC static CellFunction getNextCellFunctionType(uint8_t const* genome, int nodeAddress);
+    GENOME_ANALYSIS_FUNC static int getNextCellFunctionDataSize(uint8_t const* genome, int genomeSize, int nodeAddress, bool withSubgenome = true);
+    GENOME_ANALYSIS_FUNC static bool isNextCellSelfReplication(uint8_t const* genome, int nodeAddress);
+    GENOME_ANALYSIS_FUNC static int
+    getNextSubGenomeSize(uint8_t const* genome, int genomeSize, int nodeAddress);  //prerequisites: (constructor or injector) and !makeSelfCopy
+    GENOME_ANALYSIS_FUNC static int getCellFunctionDataSize(
+        CellFunction cellFunction,
+        bool makeSelfCopy,
+        int genomeSize);  //genomeSize only relevant for cellFunction = constructor or injector
+    GENOME_ANALYSIS_FUNC static int getCellFunctionFixedBytes(CellFunction cellFunction);  //without the genome part of constructors and injectors
+
+    //conversion methods
+    GENOME_ANALYSIS_FUNC static bool convertByteToBool(uint8_t b);
+    GENOME_ANALYSIS_FUNC static int convertBytesToWord(uint8_t b1, uint8_t b2);
+};
+
+/************************************************************************/
+/* Implementation                                                       */
+/************************************************************************/
+GENOME_ANALYSIS_EXEC_CHECK_DISABLE
+template <typename Func>
+GENOME_ANALYSIS_FUNC void GenomeAnalysis::executeForEachNode(uint8_t const* genome, int genomeSize, Func func)
+{
+    for (int currentNodeAddress = Const::GenomeHeaderSize; currentNodeAddress < genomeSize;) {
+        currentNodeAddress += Const::CellBasicBytes + getNextCellFunctionDataSize(genome, genomeSize, currentNodeAddress);
+
+        func(currentNodeAddress);
+    }
+}
+
+GENOME_ANALYSIS_EXEC_CHECK_DISABLE
+template <typename Func>
+GENOME_ANALYSIS_FUNC void
+GenomeAnalysis::executeForEachNodeRecursively(uint8_t const* genome, int genomeSize, bool includedSeparatedParts, bool countBranches, Func func)
+{
+    if (genomeSize < Const::GenomeHeaderSize) {
+        return;
+    }
+
+    int subGenomeEndAddresses[MAX_SUBGENOME_RECURSION_DEPTH];
+    int subGenomeNumRepetitions[MAX_SUBGENOME_RECURSION_DEPTH + 1];
+    int depth = 0;
+    subGenomeNumRepetitions[0] = getNumRepetitions(genome, true);
+    for (auto nodeAddress = Const::GenomeHeaderSize; nodeAddress < genomeSize;) {
+        auto cellFunction = getNextCellFunctionType(genome, nodeAddress);
+        func(depth, nodeAddress, subGenomeNumRepetitions[depth]);
+
+        bool goToNextSibling = true;
+        if ((cellFunction == CellFunction_Constructor || cellFunction == CellFunction_Injector) && depth < MAX_SUBGENOME_RECURSION_DEPTH) {
+            auto cellFunctionFixedBytes = getCellFunctionFixedBytes(cellFunction);
+            auto makeSelfCopy = convertByteToBool(genome[nodeAddress + Const::CellBasicBytes + cellFunctionFixedBytes]);
+            if (!makeSelfCopy) {
+                auto deltaSubGenomeStartPos = Const::CellBasicBytes + cellFunctionFixedBytes + 3;
+                if (!includedSeparatedParts && isSeparating(genome + nodeAddress + deltaSubGenomeStartPos)) {
+                    //skip scanning sub-genome
+                } else {
+                    auto subGenomeSize = getNextSubGenomeSize(genome, genomeSize, nodeAddress);
+                    nodeAddress += deltaSubGenomeStartPos;
+                    subGenomeEndAddresses[depth++] = nodeAddress + subGenomeSize;
+
+                    auto numBranches = countBranches ? getNumBranches(genome + nodeAddress) : 1;
+                    auto numRepetitions = getNumRepetitions(genome + nodeAddress, true);
+                    subGenomeNumRepetitions[depth] = subGenomeNumRepetitions[depth - 1] * numRepetitions * numBranches;
+                    nodeAddress += Const::GenomeHeaderSize;
+                    goToNextSibling = false;
+                }
+            }
+        }
+        if (goToNextSibling) {
+            nodeAddress += Const::CellBasicBytes + getNextCellFunctionDataSize(genome, genomeSize, nodeAddress);
+        }
+        for (int i = 0; i < MAX_SUBGENOME_RECURSION_DEPTH && depth > 0; ++i) {
+            if (subGenomeEndAddresses[depth - 1] == nodeAddress) {
+                --depth;
+            } else {
+                break;
+            }
+        }
+    }
+}
+
+GENOME_ANALYSIS_FUNC int GenomeAnalysis::getGenomeDepth(uint8_t const* genome, int genomeSize)
+{
+    auto result = 0;
+    executeForEachNodeRecursively(genome, genomeSize, true, false, [&result](int depth, int nodeAddress, int repetitions) {
+        result = result > depth ? result : depth;
+    });
+    return result;
+}
+
+GENOME_ANALYSIS_FUNC int GenomeAnalysis::getNumNodesRecursively(uint8_t const* genome, int genomeSize, bool includeRepetitions, bool includedSeparatedParts)
+{
+    auto result = 0;
+    if (!includeRepetitions) {
+        executeForEachNodeRecursively(
+            genome, genomeSize, includedSeparatedParts, true, [&result](int depth, int nodeAddress, int repetitions) { ++result; });
+    } else {
+        executeForEachNodeRecursively(
+            genome, genomeSize, includedSeparatedParts, true, [&result](int depth, int nodeAddress, int repetitions) { result += repetitions; });
+    }
+    return result;
+}
+
+GENOME_ANALYSIS_EXEC_CHECK_DISABLE
+template <typename RandomGenerator>
+GENOME_ANALYSIS_FUNC int GenomeAnalysis::getRandomGenomeNodeAddress(
+    RandomGenerator& random,
+    uint8_t const* genome,
+    int genomeSize,
+    bool considerZeroSubGenomes,
+    int* subGenomesSizeIndices,
+    int* numSubGenomesSizeIndices,
+    int randomRefIndex)
+{
+    if (numSubGenomesSizeIndices) {
+        *numSubGenomesSizeIndices = 0;
+    }
+    if (genomeSize <= Const::GenomeHeaderSize) {
+        return Const::GenomeHeaderSize;
+    }
+    if (randomRefIndex == 0) {
+        randomRefIndex = random.random(genomeSize - 1);
+    }
+
+    int result = 0;
+    for (int depth = 0; depth < MAX_SUBGENOME_RECURSION_DEPTH; ++depth) {
+        auto nodeAddress = findStartNodeAddress(genome, genomeSize, randomRefIndex);
+        result += nodeAddress;
+        auto cellFunction = getNextCellFunctionType(genome, nodeAddress);
+
+        if (cellFunction == CellFunction_Constructor || cellFunction == CellFunction_Injector) {
+            auto cellFunctionFixedBytes = getCellFunctionFixedBytes(cellFunction);
+            auto makeSelfCopy = convertByteToBool(genome[nodeAddress + Const::CellBasicBytes + cellFunctionFixedBytes]);
+            if (makeSelfCopy) {
+                break;
+            } else {
+                if (nodeAddress + Const::CellBasicBytes + cellFunctionFixedBytes > randomRefIndex) {
+                    break;
+                }
+                if (numSubGenomesSizeIndices) {
+                    subGenomesSizeIndices[*numSubGenomesSizeIndices] = result + Const::CellBasicBytes + cellFunctionFixedBytes + 1;
+                    ++(*numSubGenomesSizeIndices);
+                }
+                auto subGenomeStartIndex = nodeAddress + Const::CellBasicBytes + cellFunctionFixedBytes + 3;
+                auto subGenomeSize = getNextSubGenomeSize(genome, genomeSize, nodeAddress);
+                if (subGenomeSize == Const::GenomeHeaderSize) {
+                    if (considerZeroSubGenomes && random.randomBool()) {
+                        result += Const::CellBasicBytes + cellFunctionFixedBytes + 3 + Const::GenomeHeaderSize;
+                    } else {
+                        if (numSubGenomesSizeIndices) {
+                            --(*numSubGenomesSizeIndices);
+                        }
+                    }
+                    break;
+                }
+                genomeSize = subGenomeSize;
+                genome = genome + subGenomeStartIndex;
+                randomRefIndex -= subGenomeStartIndex;
+                result += Const::CellBasicBytes + cellFunctionFixedBytes + 3;
+            }
+        } else {
+            break;
+        }
+    }
+    return result;
+}
+
+GENOME_ANALYSIS_FUNC int GenomeAnalysis::getNumNodes(uint8_t const* genome, int genomeSize)
+{
+    int result = 0;
+    int currentNodeAddress = Const::GenomeHeaderSize;
+    for (; result < genomeSize && currentNodeAddress < genomeSize; ++result) {
+        currentNodeAddress += Const::CellBasicBytes + getNextCellFunctionDataSize(genome, genomeSize, currentNodeAddress);
+    }
+
+    return result;
+}
+
+GENOME_ANALYSIS_FUNC int GenomeAnalysis::getNodeAddress(uint8_t const* genome, int genomeSize, int nodeIndex)
+{
+    int currentNodeAddress = Const::GenomeHeaderSize;
+    for (int currentNodeIndex = 0; currentNodeIndex < nodeIndex; ++currentNodeIndex) {
+        if (currentNodeAddress >= genomeSize) {
+            break;
+        }
+        currentNodeAddress += Const::CellBasicBytes + getNextCellFunctionDataSize(genome, genomeSize, currentNodeAddress);
+    }
+
+    return currentNodeAddress;
+}
+
+GENOME_ANALYSIS_FUNC int GenomeAnalysis::findStartNodeAddress(uint8_t const* genome, int genomeSize, int refIndex)
+{
+    int currentNodeAddress = Const::GenomeHeaderSize;
+    for (; currentNodeAddress <= refIndex;) {
+        auto prevCurrentNodeAddress = currentNodeAddress;
+        currentNodeAddress += Const::CellBasicBytes + getNextCellFunctionDataSize(genome, genomeSize, currentNodeAddress);
+        if (currentNodeAddress > refIndex) {
+            return prevCurrentNodeAddress;
+        }
+    }
+    return Const::GenomeHeaderSize;
+}
+
+GENOME_ANALYSIS_FUNC bool GenomeAnalysis::containsSelfReplication(uint8_t const* genome, int genomeSize)
+{
+    for (int currentNodeAddress = Const::GenomeHeaderSize; currentNodeAddress < genomeSize;) {
+        if (isNextCellSelfReplication(genome, currentNodeAddress)) {
+            return true;
+        }
+        currentNodeAddress += Const::CellBasicBytes + getNextCellFunctionDataSize(genome, genomeSize, currentNodeAddress);
+    }
+    return false;
+}
+
+GENOME_ANALYSIS_FUNC bool GenomeAnalysis::containsSectionSelfReplication(uint8_t const* genome, int genomeSize)
+{
+    bool result;
+    getNodeAddressForSelfReplication(genome, genomeSize, result);
+    return result;
+}
+
+GENOME_ANALYSIS_FUNC int GenomeAnalysis::getNodeAddressForSelfReplication(uint8_t const* genome, int genomeSize, bool& containsSelfReplicator)
+{
+    for (int nodeAddress = 0; nodeAddress < genomeSize;) {
+        if (isNextCellSelfReplication(genome, nodeAddress)) {
+            containsSelfReplicator = true;
+            return nodeAddress;
+        }
+        nodeAddress += Const::CellBasicBytes + getNextCellFunctionDataSize(genome, genomeSize, nodeAddress);
+    }
+    containsSelfReplicator = false;
+    return 0;
+}
+
+GENOME_ANALYSIS_FUNC bool GenomeAnalysis::isSeparating(uint8_t const* genome)
+{
+    return convertByteToBool(genome[Const::GenomeHeaderSeparationPos]);
+}
+
+GENOME_ANALYSIS_FUNC int GenomeAnalysis::getNumRepetitions(uint8_t const* genome, bool countInfinityAsOne)
+{
+    int result = genome[Const::GenomeHeaderNumRepetitionsPos];
+    if (result == 0) {
+        result = 1;
+    }
+    if (result == 255) {
+        return countInfinityAsOne ? 1 : InfiniteRepetitions;
+    }
+    return result;
+}
+
+GENOME_ANALYSIS_FUNC int GenomeAnalysis::getNumBranches(uint8_t const* genome)
+{
+    return isSeparating(genome) ? 1 : (genome[Const::GenomeHeaderNumBranchesPos] + 5) % 6 + 1;
+}
+
+GENOME_ANALYSIS_FUNC CellFunction GenomeAnalysis::getNextCellFunctionType(uint8_t const* genome, int nodeAddress)
+{
+    return genome[nodeAddress] % CellFunction_Count;
+}
+
+GENOME_ANALYSIS_FUNC int GenomeAnalysis::getNextCellFunctionDataSize(uint8_t const* genome, int genomeSize, int nodeAddress, bool withSubgenome)
+{
+    auto cellFunction = getNextCellFunctionType(genome, nodeAddress);
+    auto result = getCellFunctionFixedBytes(cellFunction);
+    if (withSubgenome && (cellFunction == CellFunction_Constructor || cellFunction == CellFunction_Injector)) {
+        auto isMakeCopy = convertByteToBool(genome[nodeAddress + Const::CellBasicBytes + result]);
+        result += isMakeCopy ? 1 : 3 + getNextSubGenomeSize(genome, genomeSize, nodeAddress);
+    }
+    return result;
+}
+
+GENOME_ANALYSIS_FUNC bool GenomeAnalysis::isNextCellSelfReplication(uint8_t const* genome, int nodeAddress)
+{
+    auto cellFunction = getNextCellFunctionType(genome, nodeAddress);
+    if (cellFunction == CellFunction_Constructor || cellFunction == CellFunction_Injector) {
+        return convertByteToBool(genome[nodeAddress + Const::CellBasicBytes + getCellFunctionFixedBytes(cellFunction)]);
+    }
+    return false;
+}
+
+GENOME_ANALYSIS_FUNC int GenomeAnalysis::getNextSubGenomeSize(uint8_t const* genome, int genomeSize, int nodeAddress)
+{
+    auto cellFunction = getNextCellFunctionType(genome, nodeAddress);
+    auto subGenomeSizeIndex = nodeAddress + Const::CellBasicBytes + getCellFunctionFixedBytes(cellFunction) + 1;
+    auto result = convertBytesToWord(genome[subGenomeSizeIndex], genome[subGenomeSizeIndex + 1]);
+    auto maxResult = genomeSize - (subGenomeSizeIndex + 2);
+    result = result < maxResult ? result : maxResult;
+    return result > 0 ? result : 0;
+}
+
+GENOME_ANALYSIS_FUNC int GenomeAnalysis::getCellFunctionDataSize(CellFunction cellFunction, bool makeSelfCopy, int genomeSize)
+{
+    auto result = getCellFunctionFixedBytes(cellFunction);
+    if (cellFunction == CellFunction_Constructor || cellFunction == CellFunction_Injector) {
+        result += makeSelfCopy ? 1 : 3 + genomeSize;
+    }
+    return result;
+}
+
+GENOME_ANALYSIS_FUNC int GenomeAnalysis::getCellFunctionFixedBytes(CellFunction cellFunction)
+{
+    switch (cellFunction) {
+    case CellFunction_Neuron:
+        return Const::NeuronBytes;
+    case CellFunction_Transmitter:
+        return Const::TransmitterBytes;
+    case CellFunction_Constructor:
+        return Const::ConstructorFixedBytes;
+    case CellFunction_Sensor:
+        return Const::SensorBytes;
+    case CellFunction_Nerve:
+        return Const::NerveBytes;
+    case CellFunction_Attacker:
+        return Const::AttackerBytes;
+    case CellFunction_Injector:
+        return Const::InjectorFixedBytes;
+    case CellFunction_Muscle:
+        return Const::MuscleBytes;
+    case CellFunction_Defender:
+        return Const::DefenderBytes;
+    case CellFunction_Reconnector:
+        return Const::ReconnectorBytes;
+    case CellFunction_Detonator:
+        return Const::DetonatorBytes;
+    default:
+        return 0;
+    }
+}
+
+GENOME_ANALYSIS_FUNC bool GenomeAnalysis::convertByteToBool(uint8_t b)
+{
+    return static_cast<int8_t>(b) > 0;
+}
+
+GENOME_ANALYSIS_FUNC int GenomeAnalysis::convertBytesToWord(uint8_t b1, uint8_t b2)
+{
+    return static_cast<int>(b1) | (static_cast<int>(b2) << 8);
+}
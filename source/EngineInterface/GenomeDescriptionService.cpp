@@ -1,9 +1,13 @@
 #include "GenomeDescriptionService.h"
 
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
 #include <variant>
 
 #include "Base/Definitions.h"
 
+#include "GenomeAnalysis.h"
 #include "GenomeConstants.h"
 
 namespace
@@ -63,13 +67,13 @@ namespace
         auto makeGenomeCopy = std::holds_alternative<MakeGenomeCopy>(value);
         writeBool(data, makeGenomeCopy);
         if (!makeGenomeCopy) {
-            auto genome = std::get<std::vector<uint8_t>>(value);
+            auto const& genome = std::get<std::vector<uint8_t>>(value);
             writeWord(data, static_cast<int>(genome.size()));
             data.insert(data.end(), genome.begin(), genome.end());
         }
     }
 
-    uint8_t readByte(std::vector<uint8_t> const& data, int& pos)
+    uint8_t readByte(std::span<uint8_t const> data, int& pos)
     {
         if (pos >= data.size()) {
             return 0;
@@ -77,12 +81,12 @@ namespace
         uint8_t result = data[pos++];
         return result;
     }
-    std::optional<int> readOptionalByte(std::vector<uint8_t> const& data, int& pos)
+    std::optional<int> readOptionalByte(std::span<uint8_t const> data, int& pos)
     {
         auto value = static_cast<int>(readByte(data, pos));
         return value > 127 ? std::nullopt : std::make_optional(value);
     }
-    std::optional<int> readOptionalByte(std::vector<uint8_t> const& data, int& pos, int moduloValue)
+    std::optional<int> readOptionalByte(std::span<uint8_t const> data, int& pos, int moduloValue)
     {
         auto value = static_cast<int>(readByte(data, pos));
         return value > 127 ? std::nullopt : std::make_optional(value % moduloValue);
@@ -93,49 +97,49 @@ namespace
         return b == 255 ? std::numeric_limits<int>::max() : b;
 
     }
-    int readByteWithInfinity(std::vector<uint8_t> const& data, int& pos)
+    int readByteWithInfinity(std::span<uint8_t const> data, int& pos)
     {
         return convertByteToByteWithInfinity(readByte(data, pos));
     }
-    bool readBool(std::vector<uint8_t> const& data, int& pos)
+    bool readBool(std::span<uint8_t const> data, int& pos)
     {
         return static_cast<int8_t>(readByte(data, pos)) > 0;
     }
-    int readWord(std::vector<uint8_t> const& data, int& pos)
+    int readWord(std::span<uint8_t const> data, int& pos)
     {
         return static_cast<int>(readByte(data, pos)) | (static_cast<int>(readByte(data, pos) << 8));
     }
     //between -1 and 1
-    float readFloat(std::vector<uint8_t> const& data, int& pos)
+    float readFloat(std::span<uint8_t const> data, int& pos)
     {
         return static_cast<float>(static_cast<int8_t>(readByte(data, pos))) / 128;
     }
     //between -180 and 180
-    float readAngle(std::vector<uint8_t> const& data, int& pos)
+    float readAngle(std::span<uint8_t const> data, int& pos)
     {
         return static_cast<float>(static_cast<int8_t>(readByte(data, pos))) / 120 * 180;
     }
     //between 36 and 1060
-    float readEnergy(std::vector<uint8_t> const& data, int& pos)
+    float readEnergy(std::span<uint8_t const> data, int& pos)
     {
         return readFloat(data, pos) * 100 + 150.0f; 
     }
     //between 0 and 1
-    float readDensity(std::vector<uint8_t> const& data, int& pos)
+    float readDensity(std::span<uint8_t const> data, int& pos)
     {
         return (readFloat(data, pos) + 1.0f) / 2;
     }
-    float readNeuronProperty(std::vector<uint8_t> const& data, int& pos) { return readFloat(data, pos) * 4; }
-    float readDistance(std::vector<uint8_t> const& data, int& pos)
+    float readNeuronProperty(std::span<uint8_t const> data, int& pos) { return readFloat(data, pos) * 4; }
+    float readDistance(std::span<uint8_t const> data, int& pos)
     {
         return toFloat(readByte(data, pos)) / 255 + 0.5f;
     }
-    float readStiffness(std::vector<uint8_t> const& data, int& pos)
+    float readStiffness(std::span<uint8_t const> data, int& pos)
     {
         return toFloat(readByte(data, pos)) / 255;
     }
 
-    std::variant<MakeGenomeCopy, std::vector<uint8_t>> readGenome(std::vector<uint8_t> const& data, int& pos)
+    std::variant<MakeGenomeCopy, std::vector<uint8_t>> readGenome(std::span<uint8_t const> data, int& pos)
     {
         std::variant<MakeGenomeCopy, std::vector<uint8_t>> result;
 
@@ -145,12 +149,9 @@ namespace
         } else {
             auto size = readWord(data, pos);
             size = std::min(size, toInt(data.size()) - pos);
-            std::vector<uint8_t> copiedGenome;
-            copiedGenome.reserve(size);
-            for (int i = 0; i < size; ++i) {
-                copiedGenome.emplace_back(readByte(data, pos));
-            }
-            result = copiedGenome;
+            auto genome = data.subspan(pos, size);
+            result = std::vector<uint8_t>(genome.begin(), genome.end());
+            pos += size;
         }
         return result;
     }
@@ -265,16 +266,11 @@ namespace
         int lastBytePosition = 0;
     };
     
-    ConversionResult convertBytesToDescriptionIntern(
-        std::vector<uint8_t> const& data,
-        size_t maxBytePosition,
-        size_t maxEntries,
-        GenomeEncodingSpecification const& spec)
+    ConversionResult convertBytesToDescriptionIntern(std::span<uint8_t const> data, GenomeEncodingSpecification const& spec)
     {
         SimulationParameters parameters;
         ConversionResult result;
 
-        int nodeIndex = 0;
         auto& bytePosition = result.lastBytePosition;
 
         result.genome.header.shape = readByte(data, bytePosition) % ConstructionShape_Count;
@@ -293,7 +289,7 @@ namespace
             result.genome.header.concatenationAngle2 = readAngle(data, bytePosition);
         }
         
-        while (bytePosition < maxBytePosition && nodeIndex < maxEntries) {
+        while (bytePosition < data.size()) {
             CellFunction cellFunction = readByte(data, bytePosition) % CellFunction_Count;
 
             CellGenomeDescription cell;
@@ -384,45 +380,107 @@ namespace
             } break;
             }
             result.genome.cells.emplace_back(cell);
-            ++nodeIndex;
         }
         return result;
     }
 
 }
 
-GenomeDescription GenomeDescriptionService::convertBytesToDescription(std::vector<uint8_t> const& data, GenomeEncodingSpecification const& spec)
+GenomeDescription GenomeDescriptionService::convertBytesToDescription(std::span<uint8_t const> data, GenomeEncodingSpecification const& spec)
+{
+    return convertBytesToDescriptionIntern(data, spec).genome;
+}
+
+int GenomeDescriptionService::convertNodeAddressToNodeIndex(std::span<uint8_t const> data, int nodeAddress, GenomeEncodingSpecification const& spec)
 {
-    return convertBytesToDescriptionIntern(data, data.size(), data.size(), spec).genome;
+    return convertNodeAddressToNodeIndex(createNodeIndex(data, spec), nodeAddress);
 }
 
-int GenomeDescriptionService::convertNodeAddressToNodeIndex(std::vector<uint8_t> const& data, int nodeAddress, GenomeEncodingSpecification const& spec)
+int GenomeDescriptionService::convertNodeIndexToNodeAddress(std::span<uint8_t const> data, int nodeIndex, GenomeEncodingSpecification const& spec)
 {
-    //wasteful approach but sufficient for GUI
-    return convertBytesToDescriptionIntern(data, nodeAddress, data.size(), spec).genome.cells.size();
+    return convertNodeIndexToNodeAddress(createNodeIndex(data, spec), nodeIndex);
 }
 
-int GenomeDescriptionService::convertNodeIndexToNodeAddress(std::vector<uint8_t> const& data, int nodeIndex, GenomeEncodingSpecification const& spec)
+int GenomeDescriptionService::getNumNodesRecursively(std::span<uint8_t const> data, bool includeRepetitions, GenomeEncodingSpecification const& spec)
 {
-    //wasteful approach but sufficient for GUI
-    return convertBytesToDescriptionIntern(data, data.size(), nodeIndex, spec).lastBytePosition;
+    return getNumNodesRecursively(createNodeIndex(data, spec), includeRepetitions);
 }
 
-int GenomeDescriptionService::getNumNodesRecursively(std::vector<uint8_t> const& data, bool includeRepetitions, GenomeEncodingSpecification const& spec)
+int GenomeDescriptionService::getNumRepetitions(std::span<uint8_t const> data)
 {
-    auto genome = convertBytesToDescriptionIntern(data, data.size(), data.size(), spec).genome;
-    auto result = toInt(genome.cells.size());
-    for (auto const& node : genome.cells) {
-        if (auto subgenome = node.getGenome()) {
-            result += getNumNodesRecursively(*subgenome, includeRepetitions, spec);
+    if (toInt(data.size()) <= Const::GenomeHeaderNumRepetitionsPos) {
+        throw std::out_of_range("Genome header is truncated.");
+    }
+    return convertByteToByteWithInfinity(data[Const::GenomeHeaderNumRepetitionsPos]);
+}
+
+GenomeNodeIndex GenomeDescriptionService::createNodeIndex(std::span<uint8_t const> data, GenomeEncodingSpecification const& spec) const
+{
+    //the byte positions are determined as in convertBytesToDescription without decoding the nodes
+    //in contrast to GenomeAnalysis, truncated genomes are supported: bytes beyond the end count as zero
+    auto size = toInt(data.size());
+    auto getByte = [&](int pos) { return pos < size ? data[pos] : uint8_t(0); };
+    auto skipBytes = [&](int& pos, int numBytes) { pos = std::min(pos + numBytes, size); };
+
+    auto result = std::make_shared<_GenomeNodeIndex>();
+    result->genomeSize = size;
+    auto headerSize = 6 + (spec._numRepetitions ? 1 : 0) + (spec._concatenationAngle1 ? 1 : 0) + (spec._concatenationAngle2 ? 1 : 0);
+    auto pos = std::min(headerSize, size);
+    while (pos < size) {
+        result->nodeAddresses.emplace_back(pos);
+        auto cellFunction = GenomeAnalysis::getNextCellFunctionType(data.data(), pos);
+        skipBytes(pos, Const::CellBasicBytes);
+
+        GenomeNodeIndex subGenomeIndex;
+        auto skipGenome = [&] {
+            auto makeGenomeCopy = GenomeAnalysis::convertByteToBool(getByte(pos));
+            skipBytes(pos, 1);
+            if (!makeGenomeCopy) {
+                auto genomeSize = GenomeAnalysis::convertBytesToWord(getByte(pos), getByte(pos + 1));
+                skipBytes(pos, 2);
+                genomeSize = std::min(genomeSize, size - pos);
+                subGenomeIndex = createNodeIndex(data.subspan(pos, genomeSize), spec);
+                skipBytes(pos, genomeSize);
+            }
+        };
+        skipBytes(pos, GenomeAnalysis::getCellFunctionFixedBytes(cellFunction));
+        if (cellFunction == CellFunction_Constructor || cellFunction == CellFunction_Injector) {
+            skipGenome();
         }
+        result->subGenomeIndices.emplace_back(subGenomeIndex);
     }
 
-    auto numRepetitions = genome.header.numRepetitions == std::numeric_limits<int>::max() ? 1 : genome.header.numRepetitions;
-    return includeRepetitions ? result * numRepetitions * genome.header.getNumBranches() : result;
+    result->numNodesRecursively = toInt(result->nodeAddresses.size());
+    result->numNodesRecursivelyWithRepetitions = toInt(result->nodeAddresses.size());
+    for (auto const& subGenomeIndex : result->subGenomeIndices) {
+        if (subGenomeIndex) {
+            result->numNodesRecursively += subGenomeIndex->numNodesRecursively;
+            result->numNodesRecursivelyWithRepetitions += subGenomeIndex->numNodesRecursivelyWithRepetitions;
+        }
+    }
+    auto separateConstruction = GenomeAnalysis::convertByteToBool(getByte(Const::GenomeHeaderSeparationPos));
+    auto numBranches = separateConstruction ? 1 : (getByte(Const::GenomeHeaderNumBranchesPos) + 5) % 6 + 1;
+    auto numRepetitions = spec._numRepetitions ? convertByteToByteWithInfinity(getByte(Const::GenomeHeaderNumRepetitionsPos)) : 1;
+    if (numRepetitions == std::numeric_limits<int>::max()) {
+        numRepetitions = 1;
+    }
+    result->numNodesRecursivelyWithRepetitions *= numRepetitions * numBranches;
+    return result;
+}
+
+int GenomeDescriptionService::convertNodeAddressToNodeIndex(GenomeNodeIndex const& nodeIndex, int nodeAddress) const
+{
+    auto const& nodeAddresses = nodeIndex->nodeAddresses;
+    return toInt(std::lower_bound(nodeAddresses.begin(), nodeAddresses.end(), nodeAddress) - nodeAddresses.begin());
+}
+
+int GenomeDescriptionService::convertNodeIndexToNodeAddress(GenomeNodeIndex const& nodeIndex, int index) const
+{
+    auto const& nodeAddresses = nodeIndex->nodeAddresses;
+    return index >= 0 && index < toInt(nodeAddresses.size()) ? nodeAddresses.at(index) : nodeIndex->genomeSize;
 }
 
-int GenomeDescriptionService::getNumRepetitions(std::vector<uint8_t> const& data)
+int GenomeDescriptionService::getNumNodesRecursively(GenomeNodeIndex const& nodeIndex, bool includeRepetitions) const
 {
-    return convertByteToByteWithInfinity(data.at(Const::GenomeHeaderNumRepetitionsPos));
+    return includeRepetitions ? nodeIndex->numNodesRecursivelyWithRepetitions : nodeIndex->numNodesRecursively;
 }
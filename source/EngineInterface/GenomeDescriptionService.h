@@ -1,5 +1,7 @@
 #pragma once
 
+#include <memory>
+#include <span>
 #include <vector>
 
 #include "Base/Singleton.h"
@@ -14,15 +16,35 @@ struct GenomeEncodingSpecification
     MEMBER_DECLARATION(GenomeEncodingSpecification, bool, concatenationAngle2, true);
 };
 
+/**
+ * Byte positions of the nodes of an encoded genome and the node counts including all nested sub-genomes.
+ */
+struct _GenomeNodeIndex
+{
+    std::vector<int> nodeAddresses;
+    std::vector<std::shared_ptr<_GenomeNodeIndex const>> subGenomeIndices;  //for each node, nullptr if the node has no sub-genome
+    int genomeSize = 0;
+    int numNodesRecursively = 0;
+    int numNodesRecursivelyWithRepetitions = 0;
+};
+using GenomeNodeIndex = std::shared_ptr<_GenomeNodeIndex const>;
+
 class GenomeDescriptionService
 {
     MAKE_SINGLETON(GenomeDescriptionService);
 public:
     std::vector<uint8_t> convertDescriptionToBytes(GenomeDescription const& genome, GenomeEncodingSpecification const& spec = GenomeEncodingSpecification());
-    GenomeDescription convertBytesToDescription(std::vector<uint8_t> const& data, GenomeEncodingSpecification const& spec = GenomeEncodingSpecification());
+    GenomeDescription convertBytesToDescription(std::span<uint8_t const> data, GenomeEncodingSpecification const& spec = GenomeEncodingSpecification());
+
+    //the following queries build the node index of the genome on each call
+    int convertNodeAddressToNodeIndex(std::span<uint8_t const> data, int nodeAddress, GenomeEncodingSpecification const& spec = GenomeEncodingSpecification());
+    int convertNodeIndexToNodeAddress(std::span<uint8_t const> data, int nodeIndex, GenomeEncodingSpecification const& spec = GenomeEncodingSpecification());
+    int getNumNodesRecursively(std::span<uint8_t const> data, bool includeRepetitions, GenomeEncodingSpecification const& spec = GenomeEncodingSpecification());
+    int getNumRepetitions(std::span<uint8_t const> data);  //throws std::out_of_range
 
-    int convertNodeAddressToNodeIndex(std::vector<uint8_t> const& data, int nodeAddress, GenomeEncodingSpecification const& spec = GenomeEncodingSpecification());
-    int convertNodeIndexToNodeAddress(std::vector<uint8_t> const& data, int nodeIndex, GenomeEncodingSpecification const& spec = GenomeEncodingSpecification());
-    int getNumNodesRecursively(std::vector<uint8_t> const& data, bool includeRepetitions, GenomeEncodingSpecification const& spec = GenomeEncodingSpecification());
-    int getNumRepetitions(std::vector<uint8_t> const& data);
+    //callers with repeated queries on the same genome build the node index once and query it directly
+    GenomeNodeIndex createNodeIndex(std::span<uint8_t const> data, GenomeEncodingSpecification const& spec = GenomeEncodingSpecification()) const;
+    int convertNodeAddressToNodeIndex(GenomeNodeIndex const& nodeIndex, int nodeAddress) const;
+    int convertNodeIndexToNodeAddress(GenomeNodeIndex const& nodeIndex, int index) const;
+    int getNumNodesRecursively(GenomeNodeIndex const& nodeIndex, bool includeRepetitions) const;
 };
@@ -0,0 +1,39 @@
+#include "GenomePool.h"
+
+#include <algorithm>
+#include <string_view>
+
+#include "Base/Definitions.h"
+
+int GenomePool::add(std::span<uint8_t const> genome)
+{
+    auto hash = std::hash<std::string_view>()(std::string_view(reinterpret_cast<char const*>(genome.data()), genome.size()));
+    auto [begin, end] = _idsByHash.equal_range(hash);
+    for (auto it = begin; it != end; ++it) {
+        auto& entry = _entries.at(it->second);
+        if (std::ranges::equal(entry.genome, genome)) {
+            ++entry.numReferences;
+            return it->second;
+        }
+    }
+
+    auto result = toInt(_entries.size());
+    _entries.emplace_back(Entry{genome, 1});
+    _idsByHash.emplace(hash, result);
+    return result;
+}
+
+int GenomePool::getNumGenomes() const
+{
+    return toInt(_entries.size());
+}
+
+std::span<uint8_t const> GenomePool::getGenome(int id) const
+{
+    return _entries.at(id).genome;
+}
+
+int GenomePool::getNumReferences(int id) const
+{
+    return _entries.at(id).numReferences;
+}
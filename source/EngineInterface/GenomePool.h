@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Content-addressed pool of genomes: identical genomes are mapped to the same id and the number of references is counted.
+ * Ids are assigned consecutively starting from 0 in the order of first occurrence.
+ * The genomes are not copied, hence the referenced memory must outlive the pool.
+ */
+class GenomePool
+{
+public:
+    int add(std::span<uint8_t const> genome);
+
+    int getNumGenomes() const;
+    std::span<uint8_t const> getGenome(int id) const;
+    int getNumReferences(int id) const;
+
+private:
+    struct Entry
+    {
+        std::span<uint8_t const> genome;
+        int numReferences = 0;
+    };
+    std::vector<Entry> _entries;
+    std::unordered_multimap<size_t, int> _idsByHash;
+};
@@ -1,5 +1,11 @@
 #pragma once
+
+#include <filesystem>
+
+#include "BackendSettings.h"
 #include "Definitions.h"
+#include "EngineAccessStatistics.h"
+#include "EngineSnapshots.h"
 #include "OverlayDescriptions.h"
 #include "SelectionShallowData.h"
 #include "Settings.h"
@@ -20,6 +26,10 @@ public:
 
     virtual void clear() = 0;
 
+    //the backend settings are applied by the next call of newSimulation
+    virtual BackendSettings getBackendSettings() const = 0;
+    virtual void setBackendSettings(BackendSettings const& value) = 0;
+
     virtual void setImageResource(void* image) = 0;
     virtual std::string getGpuName() const = 0;
 
@@ -45,6 +55,14 @@ public:
     virtual void addAndSelectSimulationData(DataDescription const& dataToAdd) = 0;
     virtual void setClusteredSimulationData(ClusteredDataDescription const& dataToUpdate) = 0;
     virtual void setSimulationData(DataDescription const& dataToUpdate) = 0;
+
+    //writes and reads the simulation data in the columnar .sim format without building descriptions, throws std::runtime_error on failure
+    virtual void saveSimulationData(std::filesystem::path const& filename) = 0;
+    //writes a delta snapshot relative to baseFilename, which has to be the last file written by saveSimulationData or saveSimulationDataDelta,
+    //returns false otherwise
+    virtual bool saveSimulationDataDelta(std::filesystem::path const& filename, std::filesystem::path const& baseFilename) = 0;
+    virtual void loadSimulationData(std::filesystem::path const& filename) = 0;
+
     virtual void removeSelectedObjects(bool includeClusters) = 0;
     virtual void relaxSelectedObjects(bool includeClusters) = 0;
     virtual void uniformVelocitiesForSelectedObjects(bool includeClusters) = 0;
@@ -93,6 +111,13 @@ public:
     virtual void removeSelection() = 0;
     virtual bool updateSelectionIfNecessary() = 0;
 
+    //snapshots published by the engine between time steps, reading them does not interrupt the simulation
+    virtual SelectionShallowData getSelectionShallowDataSnapshot() const = 0;
+    virtual void setInspectedEntityIdsForSnapshot(std::vector<uint64_t> const& entityIds) = 0;
+    virtual std::shared_ptr<InspectedDataSnapshot const> getInspectedDataSnapshot() const = 0;
+    virtual void setOverlayRegionForSnapshot(std::optional<RealRect> const& region) = 0;  //std::nullopt = no overlay
+    virtual std::shared_ptr<OverlaySnapshot const> getOverlaySnapshot() const = 0;
+
     virtual GeneralSettings getGeneralSettings() const = 0;
     virtual IntVector2D getWorldSize() const = 0;
     virtual RawStatisticsData getRawStatistics() const = 0;
@@ -103,6 +128,7 @@ public:
     virtual void setTpsRestriction(std::optional<int> const& value) = 0;
 
     virtual float getTps() const = 0;
+    virtual EngineAccessStatistics getEngineAccessStatistics() const = 0;
 
     //for tests
     virtual void testOnly_mutate(uint64_t cellId, MutationType mutationType) = 0;
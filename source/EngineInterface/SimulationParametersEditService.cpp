@@ -147,3 +147,34 @@ auto SimulationParametersEditService::calcRadiationStrengthsForDeletingZone(
 
     return result;
 }
+
+SimulationParameters SimulationParametersEditService::integrateChanges(
+    SimulationParameters const& currentParameters,
+    SimulationParameters const& changedParameters,
+    SimulationParametersUpdateConfig const& updateConfig) const
+{
+    auto result = changedParameters;
+
+    if (updateConfig == SimulationParametersUpdateConfig::AllExceptChangingPositions) {
+        auto numSpots = std::min(currentParameters.numZones, changedParameters.numZones);
+        for (int i = 0; i < numSpots; ++i) {
+            if (currentParameters.zone[i].velX != 0) {
+                result.zone[i].posX = currentParameters.zone[i].posX;
+            }
+            if (currentParameters.zone[i].velY != 0) {
+                result.zone[i].posY = currentParameters.zone[i].posY;
+            }
+        }
+
+        auto numRadiationSources = std::min(currentParameters.numRadiationSources, changedParameters.numRadiationSources);
+        for (int i = 0; i < numRadiationSources; ++i) {
+            if (currentParameters.radiationSource[i].velX != 0) {
+                result.radiationSource[i].posX = currentParameters.radiationSource[i].posX;
+            }
+            if (currentParameters.radiationSource[i].velY != 0) {
+                result.radiationSource[i].posY = currentParameters.radiationSource[i].posY;
+            }
+        }
+    }
+    return result;
+}
@@ -6,6 +6,7 @@
 
 #include "Base/Singleton.h"
 #include "SimulationParameters.h"
+#include "SimulationParametersUpdateConfig.h"
 
 struct RadiationStrengths
 {
@@ -24,4 +25,10 @@ public:
     void adaptRadiationStrengths(RadiationStrengths& strengths, RadiationStrengths& origStrengths, int changeIndex) const;
     RadiationStrengths calcRadiationStrengthsForAddingZone(RadiationStrengths const& strengths) const;
     RadiationStrengths calcRadiationStrengthsForDeletingZone(RadiationStrengths const& strengths, int deleteIndex) const;
+
+    //merges changed parameters into the parameters of a running simulation (e.g. moving zones keep their current positions)
+    SimulationParameters integrateChanges(
+        SimulationParameters const& currentParameters,
+        SimulationParameters const& changedParameters,
+        SimulationParametersUpdateConfig const& updateConfig) const;
 };
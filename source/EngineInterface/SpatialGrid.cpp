@@ -0,0 +1,219 @@
+#include "SpatialGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "Base/Definitions.h"
+#include "Base/Math.h"
+#include "Base/ThreadPool.h"
+
+namespace
+{
+    auto constexpr MaxNumCells = 1 << 20;
+    auto constexpr MinNumPointsForRepacking = 1024;
+    auto constexpr MinChunkSize = 1 << 14;
+
+    IntVector2D limitNumCells(IntVector2D numCells)
+    {
+        auto totalNumCells = static_cast<double>(numCells.x) * numCells.y;
+        if (totalNumCells > MaxNumCells) {
+            auto factor = std::sqrt(totalNumCells / MaxNumCells);
+            numCells.x = std::max(1, toInt(numCells.x / factor));
+            numCells.y = std::max(1, toInt(numCells.y / factor));
+        }
+        return numCells;
+    }
+}
+
+SpatialGrid::SpatialGrid(float cellSize)
+    : _requestedCellSize(cellSize)
+{
+    build({});
+}
+
+SpatialGrid::SpatialGrid(IntVector2D const& worldSize, float cellSize)
+    : _worldSize(worldSize)
+    , _spaceCalculator(worldSize)
+    , _requestedCellSize(cellSize)
+{
+    //the cells cover the world exactly such that wrapped cell positions are consistent with the space calculator
+    _numCells = limitNumCells(
+        {std::max(1, toInt(toFloat(worldSize.x) / cellSize)), std::max(1, toInt(toFloat(worldSize.y) / cellSize))});
+    _cellSize = {toFloat(worldSize.x) / toFloat(_numCells.x), toFloat(worldSize.y) / toFloat(_numCells.y)};
+    build({});
+}
+
+std::optional<IntVector2D> SpatialGrid::getWorldSize() const
+{
+    return _worldSize;
+}
+
+int SpatialGrid::getNumPoints() const
+{
+    return toInt(_positions.size());
+}
+
+std::vector<RealVector2D> const& SpatialGrid::getPositions() const
+{
+    return _positions;
+}
+
+void SpatialGrid::build(std::vector<RealVector2D> const& positions)
+{
+    auto numPoints = toInt(positions.size());
+    _positions.resize(numPoints);
+    ThreadPool::get().parallelFor(
+        numPoints,
+        [&](size_t startIndex, size_t endIndex) {
+            for (auto i = toInt(startIndex); i < toInt(endIndex); ++i) {
+                _positions[i] = correctPosition(positions[i]);
+            }
+        },
+        MinChunkSize);
+    if (!_worldSize) {
+        updateGeometry();
+    }
+
+    std::vector<int> cellIndices(numPoints);
+    ThreadPool::get().parallelFor(
+        numPoints,
+        [&](size_t startIndex, size_t endIndex) {
+            for (auto i = toInt(startIndex); i < toInt(endIndex); ++i) {
+                cellIndices[i] = getCellIndex(_positions[i]);
+            }
+        },
+        MinChunkSize);
+
+    //counting sort by cell keeps the point indices of a cell in ascending order
+    auto numCells = _numCells.x * _numCells.y;
+    _cellStarts.assign(numCells + 1, 0);
+    for (auto const& cellIndex : cellIndices) {
+        ++_cellStarts[cellIndex + 1];
+    }
+    std::partial_sum(_cellStarts.begin(), _cellStarts.end(), _cellStarts.begin());
+    std::vector<int> cellCursors(_cellStarts.begin(), _cellStarts.end() - 1);
+    _packedPointIndices.resize(numPoints);
+    for (int i = 0; i < numPoints; ++i) {
+        _packedPointIndices[cellCursors[cellIndices[i]]++] = i;
+    }
+    _numPackedPoints = numPoints;
+
+    _firstInsertedPointIndices.assign(numCells, -1);
+    _nextInsertedPointIndices.clear();
+}
+
+int SpatialGrid::insert(RealVector2D const& pos)
+{
+    auto result = toInt(_positions.size());
+    _positions.emplace_back(correctPosition(pos));
+
+    auto cellIndex = getCellIndex(_positions.back());
+    _nextInsertedPointIndices.emplace_back(_firstInsertedPointIndices[cellIndex]);
+    _firstInsertedPointIndices[cellIndex] = result;
+
+    if (toInt(_nextInsertedPointIndices.size()) > std::max(_numPackedPoints, MinNumPointsForRepacking)) {
+        repack();
+    }
+    return result;
+}
+
+void SpatialGrid::clear()
+{
+    build({});
+}
+
+bool SpatialGrid::isOccupied(RealVector2D const& pos, float distance) const
+{
+    auto result = false;
+    forEachWithinRadius(pos, distance, [&](int pointIndex, float pointDistance) {
+        if (pointDistance < distance) {
+            result = true;
+        }
+    });
+    return result;
+}
+
+std::vector<std::vector<int>> SpatialGrid::getIndicesWithinRadius(std::vector<RealVector2D> const& centers, float radius) const
+{
+    std::vector<std::vector<int>> result(centers.size());
+    ThreadPool::get().parallelFor(
+        centers.size(),
+        [&](size_t startIndex, size_t endIndex) {
+            std::vector<std::pair<float, int>> distancesAndIndices;
+            for (auto i = toInt(startIndex); i < toInt(endIndex); ++i) {
+                distancesAndIndices.clear();
+                forEachWithinRadius(centers[i], radius, [&](int pointIndex, float distance) { distancesAndIndices.emplace_back(distance, pointIndex); });
+                std::sort(distancesAndIndices.begin(), distancesAndIndices.end());
+
+                auto& indices = result[i];
+                indices.reserve(distancesAndIndices.size());
+                for (auto const& [distance, pointIndex] : distancesAndIndices) {
+                    indices.emplace_back(pointIndex);
+                }
+            }
+        },
+        MinChunkSize);
+    return result;
+}
+
+RealVector2D SpatialGrid::correctPosition(RealVector2D const& pos) const
+{
+    return _spaceCalculator ? _spaceCalculator->getCorrectedPosition(pos) : pos;
+}
+
+float SpatialGrid::getDistance(RealVector2D const& pos1, RealVector2D const& pos2) const
+{
+    return _spaceCalculator ? _spaceCalculator->distance(pos1, pos2) : Math::length(pos2 - pos1);
+}
+
+void SpatialGrid::updateGeometry()
+{
+    if (_positions.empty()) {
+        _origin = {0, 0};
+        _cellSize = {_requestedCellSize, _requestedCellSize};
+        _numCells = {1, 1};
+        return;
+    }
+    auto minPos = _positions.front();
+    auto maxPos = _positions.front();
+    for (auto const& pos : _positions) {
+        minPos = {std::min(minPos.x, pos.x), std::min(minPos.y, pos.y)};
+        maxPos = {std::max(maxPos.x, pos.x), std::max(maxPos.y, pos.y)};
+    }
+    auto numCells = limitNumCells(
+        {toInt(std::min((maxPos.x - minPos.x) / _requestedCellSize, toFloat(MaxNumCells))) + 1,
+         toInt(std::min((maxPos.y - minPos.y) / _requestedCellSize, toFloat(MaxNumCells))) + 1});
+    _origin = minPos;
+    _numCells = numCells;
+    _cellSize = {
+        std::max(_requestedCellSize, (maxPos.x - minPos.x) / toFloat(numCells.x)), std::max(_requestedCellSize, (maxPos.y - minPos.y) / toFloat(numCells.y))};
+}
+
+IntVector2D SpatialGrid::getUnclampedCellPos(RealVector2D const& pos) const
+{
+    return {toInt(std::floor((pos.x - _origin.x) / _cellSize.x)), toInt(std::floor((pos.y - _origin.y) / _cellSize.y))};
+}
+
+IntVector2D SpatialGrid::clampCellPos(IntVector2D const& cellPos) const
+{
+    return {std::max(0, std::min(_numCells.x - 1, cellPos.x)), std::max(0, std::min(_numCells.y - 1, cellPos.y))};
+}
+
+int SpatialGrid::getCellIndex(RealVector2D const& pos) const
+{
+    //corrected positions may lie slightly below zero (SpaceCalculator truncates towards zero), hence wrapping instead of clamping
+    auto cellPos = getUnclampedCellPos(pos);
+    if (_worldSize) {
+        cellPos = {(cellPos.x % _numCells.x + _numCells.x) % _numCells.x, (cellPos.y % _numCells.y + _numCells.y) % _numCells.y};
+    } else {
+        cellPos = clampCellPos(cellPos);
+    }
+    return cellPos.y * _numCells.x + cellPos.x;
+}
+
+void SpatialGrid::repack()
+{
+    auto positions = std::move(_positions);
+    build(positions);
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include "Base/Vector2D.h"
+
+#include "SpaceCalculator.h"
+
+/**
+ * Uniform grid of point positions for radius queries.
+ * In a periodic grid the positions and distances are corrected as by the SpaceCalculator of the world.
+ * An unbounded grid covers the bounding box of the positions passed to build(), points outside lie in the border cells.
+ *
+ * The point indices of build() are stored as contiguous cell lists (counting sort by cell).
+ * Points added by insert() are chained per cell until they outnumber the packed points and are repacked.
+ */
+class SpatialGrid
+{
+public:
+    SpatialGrid(float cellSize = 1.0f);  //unbounded
+    SpatialGrid(IntVector2D const& worldSize, float cellSize);  //periodic
+
+    std::optional<IntVector2D> getWorldSize() const;
+    int getNumPoints() const;
+    std::vector<RealVector2D> const& getPositions() const;
+
+    //replaces the content, point indices are the indices in positions
+    void build(std::vector<RealVector2D> const& positions);
+    int insert(RealVector2D const& pos);  //returns the point index
+    void clear();
+
+    //func(pointIndex, distance) is called for all points with distance <= radius
+    template <typename Func>
+    void forEachWithinRadius(RealVector2D const& pos, float radius, Func const& func) const;
+    bool isOccupied(RealVector2D const& pos, float distance) const;  //true if a point is closer than distance
+
+    //point indices within radius of each center sorted by distance and index, the queries are done in parallel
+    std::vector<std::vector<int>> getIndicesWithinRadius(std::vector<RealVector2D> const& centers, float radius) const;
+
+private:
+    RealVector2D correctPosition(RealVector2D const& pos) const;
+    float getDistance(RealVector2D const& pos1, RealVector2D const& pos2) const;
+    void updateGeometry();
+    IntVector2D getUnclampedCellPos(RealVector2D const& pos) const;
+    IntVector2D clampCellPos(IntVector2D const& cellPos) const;
+    int getCellIndex(RealVector2D const& pos) const;
+    void repack();
+
+    std::optional<IntVector2D> _worldSize;
+    std::optional<SpaceCalculator> _spaceCalculator;
+    float _requestedCellSize = 1.0f;
+    RealVector2D _origin;
+    RealVector2D _cellSize{1.0f, 1.0f};
+    IntVector2D _numCells{1, 1};
+
+    std::vector<RealVector2D> _positions;
+
+    //cell lists of the packed points
+    int _numPackedPoints = 0;
+    std::vector<int> _cellStarts;  //_cellStarts[cellIndex] to _cellStarts[cellIndex + 1] (exclusive) in _packedPointIndices
+    std::vector<int> _packedPointIndices;
+
+    //chained lists of the points inserted after packing
+    std::vector<int> _firstInsertedPointIndices;  //per cell, -1 = none
+    std::vector<int> _nextInsertedPointIndices;  //per inserted point (offset by _numPackedPoints), -1 = none
+};
+
+/************************************************************************/
+/* Implementation                                                       */
+/************************************************************************/
+
+template <typename Func>
+void SpatialGrid::forEachWithinRadius(RealVector2D const& pos, float radius, Func const& func) const
+{
+    auto correctedPos = correctPosition(pos);
+    auto cellPos1 = getUnclampedCellPos(correctedPos - RealVector2D{radius, radius});
+    auto cellPos2 = getUnclampedCellPos(correctedPos + RealVector2D{radius, radius});
+    if (_worldSize) {
+
+        //cells beyond the world boundary are wrapped, but no cell may be visited twice
+        if (cellPos2.x - cellPos1.x + 1 >= _numCells.x) {
+            cellPos1.x = 0;
+            cellPos2.x = _numCells.x - 1;
+        }
+        if (cellPos2.y - cellPos1.y + 1 >= _numCells.y) {
+            cellPos1.y = 0;
+            cellPos2.y = _numCells.y - 1;
+        }
+    } else {
+        cellPos1 = clampCellPos(cellPos1);
+        cellPos2 = clampCellPos(cellPos2);
+    }
+
+    auto processPoint = [&](int pointIndex) {
+        auto distance = getDistance(correctedPos, _positions[pointIndex]);
+        if (distance <= radius) {
+            func(pointIndex, distance);
+        }
+    };
+    for (int y = cellPos1.y; y <= cellPos2.y; ++y) {
+        auto cellY = (y % _numCells.y + _numCells.y) % _numCells.y;
+        for (int x = cellPos1.x; x <= cellPos2.x; ++x) {
+            auto cellX = (x % _numCells.x + _numCells.x) % _numCells.x;
+            auto cellIndex = cellY * _numCells.x + cellX;
+            for (int i = _cellStarts[cellIndex]; i < _cellStarts[cellIndex + 1]; ++i) {
+                processPoint(_packedPointIndices[i]);
+            }
+            for (int pointIndex = _firstInsertedPointIndices[cellIndex]; pointIndex != -1;
+                 pointIndex = _nextInsertedPointIndices[pointIndex - _numPackedPoints]) {
+                processPoint(pointIndex);
+            }
+        }
+    }
+}
@@ -1,24 +1,325 @@
 #include "StatisticsHistory.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "Base/Definitions.h"
+
+namespace
+{
+    static_assert(std::is_trivially_copyable_v<DataPointCollection>);
+    static_assert(sizeof(DataPointCollection) == StatisticsHistoryTier::NumColumns * sizeof(double));
+
+    DataPointCollection average(DataPointCollection const& sum, int numDataPoints, DataPointCollection const& firstDataPoint)
+    {
+        auto result = sum / toDouble(numDataPoints);
+        result.time = firstDataPoint.time;
+        result.systemClock = firstDataPoint.systemClock;
+        return result;
+    }
+}
+
+bool StatisticsHistoryTier::isEmpty() const
+{
+    return _size == 0;
+}
+
+int StatisticsHistoryTier::getSize() const
+{
+    return _size;
+}
+
+double StatisticsHistoryTier::getValue(int column, int index) const
+{
+    auto position = _startIndex + index;
+    return _chunks[position / ChunkSize]->columns[column][position % ChunkSize];
+}
+
+double StatisticsHistoryTier::getTime(int index) const
+{
+    return getValue(0, index);
+}
+
+DataPointCollection StatisticsHistoryTier::getDataPoint(int index) const
+{
+    double values[NumColumns];
+    for (int column = 0; column < NumColumns; ++column) {
+        values[column] = getValue(column, index);
+    }
+    DataPointCollection result;
+    std::memcpy(&result, values, sizeof(result));
+    return result;
+}
+
+int StatisticsHistoryTier::findFirstIndexAfter(double time) const
+{
+    auto lower = 0;
+    auto upper = _size;
+    while (lower < upper) {
+        auto middle = (lower + upper) / 2;
+        if (getTime(middle) > time) {
+            upper = middle;
+        } else {
+            lower = middle + 1;
+        }
+    }
+    return lower;
+}
+
+void StatisticsHistoryTier::add(DataPointCollection const& dataPoint)
+{
+    auto position = _startIndex + _size;
+    if (position == toInt(_chunks.size()) * ChunkSize) {
+        _chunks.emplace_back(std::make_shared<Chunk>());
+    }
+    double values[NumColumns];
+    std::memcpy(values, &dataPoint, sizeof(values));
+
+    auto& chunk = *_chunks.back();
+    for (int column = 0; column < NumColumns; ++column) {
+        chunk.columns[column][position % ChunkSize] = values[column];
+    }
+    ++_size;
+}
+
+void StatisticsHistoryTier::removeFront(int count)
+{
+    count = std::min(count, _size);
+    _startIndex += count;
+    _size -= count;
+
+    auto numUnusedChunks = _startIndex / ChunkSize;
+    _chunks.erase(_chunks.begin(), _chunks.begin() + numUnusedChunks);
+    _startIndex -= numUnusedChunks * ChunkSize;
+}
+
+void StatisticsHistoryTier::truncate(int size)
+{
+    if (size >= _size) {
+        return;
+    }
+    _size = size;
+    auto numUsedChunks = (_startIndex + _size + ChunkSize - 1) / ChunkSize;
+    _chunks.resize(numUsedChunks);
+
+    //the following values may be part of published snapshots and must not be overwritten
+    if (!_chunks.empty() && (_startIndex + _size) % ChunkSize != 0) {
+        _chunks.back() = std::make_shared<Chunk>(*_chunks.back());
+    }
+}
+
+_StatisticsHistorySnapshot::_StatisticsHistorySnapshot(uint64_t version, std::vector<StatisticsHistoryTier> const& tiers)
+    : _version(version)
+    , _tiers(tiers)
+{}
+
+uint64_t _StatisticsHistorySnapshot::getVersion() const
+{
+    return _version;
+}
+
+bool _StatisticsHistorySnapshot::isEmpty() const
+{
+    return _tiers.front().isEmpty();
+}
+
+double _StatisticsHistorySnapshot::getStartTime() const
+{
+    return _tiers.back().getTime(0);
+}
+
+DataPointCollection _StatisticsHistorySnapshot::getLastDataPoint() const
+{
+    auto const& rawTier = _tiers.front();
+    return rawTier.getDataPoint(rawTier.getSize() - 1);
+}
+
+StatisticsHistoryData _StatisticsHistorySnapshot::getData(std::optional<double> const& startTime) const
+{
+    //coarsest tier needed: the finest one which reaches back to startTime
+    auto tierIndex = getNumTiers() - 1;
+    if (startTime.has_value()) {
+        for (int i = 0; i < getNumTiers(); ++i) {
+            if (!_tiers.at(i).isEmpty() && _tiers.at(i).getTime(0) <= *startTime) {
+                tierIndex = i;
+                break;
+            }
+        }
+    }
+
+    StatisticsHistoryData result;
+    for (; tierIndex >= 0; --tierIndex) {
+        auto const& tier = _tiers.at(tierIndex);
+        auto endTime = tierIndex > 0 && !_tiers.at(tierIndex - 1).isEmpty() ? _tiers.at(tierIndex - 1).getTime(0) : std::numeric_limits<double>::infinity();
+
+        auto index = 0;
+        if (!result.empty()) {
+            index = tier.findFirstIndexAfter(result.back().time);
+        } else if (startTime.has_value()) {
+            index = std::max(0, tier.findFirstIndexAfter(*startTime) - 1);
+        }
+        for (; index < tier.getSize() && tier.getTime(index) < endTime; ++index) {
+            result.emplace_back(tier.getDataPoint(index));
+        }
+    }
+    return result;
+}
+
+int _StatisticsHistorySnapshot::getNumStableDataPoints() const
+{
+    //the data points of the top tier preceding the next finer tier are merged first, added data points only reach the finer tiers
+    auto const& topTier = _tiers.back();
+    auto const& finerTier = _tiers.at(_tiers.size() - 2);
+    if (finerTier.isEmpty()) {
+        return 0;
+    }
+    auto endTime = finerTier.getTime(0);
+    auto result = topTier.findFirstIndexAfter(endTime);
+    while (result > 0 && topTier.getTime(result - 1) >= endTime) {
+        --result;
+    }
+    return result;
+}
+
+int _StatisticsHistorySnapshot::getNumTiers() const
+{
+    return toInt(_tiers.size());
+}
+
+StatisticsHistoryTier const& _StatisticsHistorySnapshot::getTier(int index) const
+{
+    return _tiers.at(index);
+}
+
+StatisticsHistory::StatisticsHistory()
+    : _tiers(NumTiers)
+    , _accumulators(NumTiers)
+{
+    publish();
+}
+
+StatisticsHistorySnapshot StatisticsHistory::getSnapshot() const
+{
+    return _snapshot.load();
+}
 
 StatisticsHistoryData StatisticsHistory::getCopiedData() const
 {
-    std::lock_guard lock(_mutex);
-    auto copy = _data;
-    return copy;
+    return getSnapshot()->getData();
+}
+
+void StatisticsHistory::add(DataPointCollection const& dataPoint)
+{
+    std::lock_guard lock(_writeMutex);
+
+    //coarser tiers keep the replaced data point in their averages
+    auto& rawTier = _tiers.front();
+    if (!rawTier.isEmpty() && std::abs(rawTier.getTime(rawTier.getSize() - 1) - dataPoint.time) < NEAR_ZERO) {
+        rawTier.truncate(rawTier.getSize() - 1);
+        rawTier.add(dataPoint);
+    } else {
+        addToTier(0, dataPoint);
+    }
+    publish();
+}
+
+void StatisticsHistory::removeDataPointsFrom(double time)
+{
+    std::lock_guard lock(_writeMutex);
+
+    for (auto& tier : _tiers) {
+        auto size = tier.getSize();
+        while (size > 0 && tier.getTime(size - 1) >= time) {
+            --size;
+        }
+        tier.truncate(size);
+    }
+    resetAccumulators();
+    publish();
+}
+
+void StatisticsHistory::setData(StatisticsHistoryData const& data)
+{
+    std::lock_guard lock(_writeMutex);
+
+    //the given data points are not averaged again since they usually stem from a merged history
+    _tiers = std::vector<StatisticsHistoryTier>(NumTiers);
+    _topTierFactor = TierFactor;
+    resetAccumulators();
+    for (int i = 0; i < NumTiers; ++i) {
+        for (auto const& dataPoint : data) {
+            _tiers.at(i).add(dataPoint);
+            limitTierSize(i);
+        }
+    }
+    publish();
+}
+
+void StatisticsHistory::clear()
+{
+    setData({});
 }
 
-std::mutex& StatisticsHistory::getMutex() const
+void StatisticsHistory::addToTier(int tierIndex, DataPointCollection const& dataPoint)
 {
-    return _mutex;
+    _tiers.at(tierIndex).add(dataPoint);
+    limitTierSize(tierIndex);
+
+    if (tierIndex == NumTiers - 1) {
+        return;
+    }
+    auto& accumulator = _accumulators.at(tierIndex + 1);
+    if (accumulator.firstDataPoint.has_value()) {
+        accumulator.sum = accumulator.sum + dataPoint;
+    } else {
+        accumulator.firstDataPoint = dataPoint;
+        accumulator.sum = dataPoint;
+    }
+    ++accumulator.numDataPoints;
+
+    auto factor = tierIndex + 1 == NumTiers - 1 ? _topTierFactor : TierFactor;
+    if (accumulator.numDataPoints >= factor) {
+        auto averagedDataPoint = average(accumulator.sum, accumulator.numDataPoints, *accumulator.firstDataPoint);
+        accumulator = Accumulator();
+        addToTier(tierIndex + 1, averagedDataPoint);
+    }
+}
+
+void StatisticsHistory::limitTierSize(int tierIndex)
+{
+    auto& tier = _tiers.at(tierIndex);
+    if (tier.getSize() <= MaxTierSize) {
+        return;
+    }
+    if (tierIndex < NumTiers - 1) {
+        tier.removeFront(tier.getSize() - MaxTierSize);
+        return;
+    }
+
+    //top tier: halve the resolution
+    StatisticsHistoryTier newTier;
+    for (int i = 0; i + 1 < tier.getSize(); i += 2) {
+        auto dataPoint = tier.getDataPoint(i);
+        newTier.add(average(dataPoint + tier.getDataPoint(i + 1), 2, dataPoint));
+    }
+    if (tier.getSize() % 2 == 1) {
+        newTier.add(tier.getDataPoint(tier.getSize() - 1));
+    }
+    tier = newTier;
+    _topTierFactor *= 2;
 }
 
-StatisticsHistoryData& StatisticsHistory::getDataRef()
+void StatisticsHistory::resetAccumulators()
 {
-    return _data;
+    for (auto& accumulator : _accumulators) {
+        accumulator = Accumulator();
+    }
 }
 
-StatisticsHistoryData const& StatisticsHistory::getDataRef() const
+void StatisticsHistory::publish()
 {
-    return _data;
+    _snapshot.store(std::make_shared<_StatisticsHistorySnapshot const>(++_version, _tiers));
 }
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <mutex>
+#include <optional>
 #include <vector>
 
 #include "DataPointCollection.h"
@@ -8,16 +11,125 @@
 
 using StatisticsHistoryData = std::vector<DataPointCollection>;
 
+/**
+ * Consecutive data points of one resolution in a column-per-metric layout. The columns are stored in chunks of ChunkSize data points.
+ * Chunks are shared between the tiers of different snapshots: values are only appended and a chunk is copied before values which may
+ * already have been published are changed.
+ */
+class StatisticsHistoryTier
+{
+public:
+    static int constexpr NumColumns = sizeof(DataPointCollection) / sizeof(double);
+    static int constexpr ChunkSize = 256;
+
+    bool isEmpty() const;
+    int getSize() const;
+
+    double getValue(int column, int index) const;
+    double getTime(int index) const;
+    DataPointCollection getDataPoint(int index) const;
+
+    int findFirstIndexAfter(double time) const;  //returns the index of the first data point whose time is greater than the given time
+
+    void add(DataPointCollection const& dataPoint);
+    void removeFront(int count);
+    void truncate(int size);
+
+private:
+    struct Chunk
+    {
+        double columns[NumColumns][ChunkSize];
+    };
+
+    std::vector<std::shared_ptr<Chunk>> _chunks;
+    int _startIndex = 0;  //position of the first data point in the first chunk
+    int _size = 0;
+};
+
+//immutable state of the statistics history, tier 0 contains the raw data points and each further tier averages over the previous one
+class _StatisticsHistorySnapshot
+{
+public:
+    _StatisticsHistorySnapshot(uint64_t version, std::vector<StatisticsHistoryTier> const& tiers);
+
+    uint64_t getVersion() const;
+    bool isEmpty() const;
+    double getStartTime() const;  //must not be called for empty snapshots
+    DataPointCollection getLastDataPoint() const;  //must not be called for empty snapshots
+
+    //merges the tiers such that each time period is covered in the finest available resolution,
+    //startTime restricts the result to the data points from the one preceding startTime on
+    StatisticsHistoryData getData(std::optional<double> const& startTime = std::nullopt) const;
+
+    //number of leading data points of getData() which are not changed by adding data points: they grow monotonically until the history is
+    //reset or its top tier halves the resolution
+    int getNumStableDataPoints() const;
+
+    int getNumTiers() const;
+    StatisticsHistoryTier const& getTier(int index) const;
+
+private:
+    uint64_t _version = 0;
+    std::vector<StatisticsHistoryTier> _tiers;
+};
+using StatisticsHistorySnapshot = std::shared_ptr<_StatisticsHistorySnapshot const>;
+
+/**
+ * Long-term statistics in NumTiers resolution tiers of at most MaxTierSize data points. The lower tiers keep the most recent data points
+ * while the top tier covers the entire history and halves its resolution when it is full.
+ * Readers obtain snapshots without locking. Writes are serialized and publish a new snapshot which shares the unchanged chunks.
+ */
 class StatisticsHistory
 {
 public:
+    static int constexpr NumTiers = 3;
+    static int constexpr TierFactor = 10;  //number of data points of a tier which are averaged for the next tier
+    static int constexpr MaxTierSize = 1000;
+
+    StatisticsHistory();
+
+    StatisticsHistorySnapshot getSnapshot() const;
     StatisticsHistoryData getCopiedData() const;
 
-    std::mutex& getMutex() const;
-    StatisticsHistoryData& getDataRef();
-    StatisticsHistoryData const& getDataRef() const;
+    void add(DataPointCollection const& dataPoint);  //replaces the most recent raw data point if it has the same time
+    void removeDataPointsFrom(double time);
+    void setData(StatisticsHistoryData const& data);
+    void clear();
 
 private:
-    mutable std::mutex _mutex;
-    StatisticsHistoryData _data;
+    friend class StatisticsService;
+
+    //state of StatisticsService which samples the raw statistics of the simulation owning this history
+    struct SamplingState
+    {
+        std::mutex mutex;  //serializes the updates of the history by StatisticsService
+
+        int numDataPoints = 0;
+        std::optional<DataPointCollection> accumulatedDataPoint;
+
+        std::optional<TimelineStatistics> lastRawStatistics;
+        std::optional<uint64_t> lastTimestep;
+    };
+
+    struct Accumulator
+    {
+        std::optional<DataPointCollection> firstDataPoint;
+        DataPointCollection sum;
+        int numDataPoints = 0;
+    };
+
+    void addToTier(int tierIndex, DataPointCollection const& dataPoint);
+    void limitTierSize(int tierIndex);
+    void resetAccumulators();
+    void publish();
+
+    std::mutex _writeMutex;
+    uint64_t _version = 0;
+    std::vector<StatisticsHistoryTier> _tiers;
+    std::vector<Accumulator> _accumulators;  //one per tier, accumulates the data points of the previous tier
+    int _topTierFactor = TierFactor;
+
+    std::atomic<StatisticsHistorySnapshot> _snapshot;
+
+    SamplingState _samplingState;
 };
@@ -0,0 +1,68 @@
+#include "StatisticsService.h"
+
+#include "Base/Definitions.h"
+
+#include "StatisticsConverterService.h"
+
+void StatisticsService::addDataPoint(StatisticsHistory& history, TimelineStatistics const& newRawStatistics, uint64_t timestep)
+{
+    auto& state = history._samplingState;
+    std::lock_guard lock(state.mutex);
+
+    auto snapshot = history.getSnapshot();
+    if (!snapshot->isEmpty() && snapshot->getLastDataPoint().time > toDouble(timestep) + NEAR_ZERO) {
+        history.clear();
+        snapshot = history.getSnapshot();
+    }
+    auto lastDataPoint = snapshot->isEmpty() ? std::nullopt : std::make_optional(snapshot->getLastDataPoint());
+
+    if (!state.lastRawStatistics || !lastDataPoint || toDouble(timestep) - lastDataPoint->time > TimestepDelta / 100 * (state.numDataPoints + 1)) {
+        auto newDataPoint = [&] {
+            if (!state.lastRawStatistics && lastDataPoint) {
+
+                //reuse last entry if no raw statistics is available
+                auto result = *lastDataPoint;
+                result.time = toDouble(timestep);
+                return result;
+            } else {
+                return StatisticsConverterService::get().convert(newRawStatistics, timestep, toDouble(timestep), state.lastRawStatistics, state.lastTimestep);
+            }
+        }();
+
+        state.lastRawStatistics = newRawStatistics;
+        state.lastTimestep = timestep;
+        state.accumulatedDataPoint = state.accumulatedDataPoint.has_value() ? *state.accumulatedDataPoint + newDataPoint : newDataPoint;
+        ++state.numDataPoints;
+    }
+
+    if (state.accumulatedDataPoint.has_value() && (!lastDataPoint || toDouble(timestep) - lastDataPoint->time > TimestepDelta)) {
+        auto newDataPoint = *state.accumulatedDataPoint / state.numDataPoints;
+        state.numDataPoints = 0;
+        state.accumulatedDataPoint.reset();
+
+        //the history replaces the last entry if timestep has not changed and compresses older entries into its coarser tiers
+        history.add(newDataPoint);
+    }
+}
+
+void StatisticsService::resetTime(StatisticsHistory& history, uint64_t timestep)
+{
+    auto& state = history._samplingState;
+    std::lock_guard lock(state.mutex);
+
+    history.removeDataPointsFrom(toDouble(timestep));
+    state.accumulatedDataPoint.reset();
+    state.numDataPoints = 0;
+}
+
+void StatisticsService::rewriteHistory(StatisticsHistory& history, StatisticsHistoryData const& newHistoryData, uint64_t timestep)
+{
+    auto& state = history._samplingState;
+    std::lock_guard lock(state.mutex);
+
+    state.accumulatedDataPoint.reset();
+    state.numDataPoints = 0;
+    state.lastRawStatistics.reset();
+    state.lastTimestep.reset();
+    history.setData(newHistoryData);
+}
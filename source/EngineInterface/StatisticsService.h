@@ -1,9 +1,8 @@
-#include <optional>
+#pragma once
 
 #include "Base/Singleton.h"
-#include "EngineInterface/StatisticsHistory.h"
 
-#include "Definitions.cuh"
+#include "StatisticsHistory.h"
 
 class StatisticsService
 {
@@ -15,13 +14,5 @@ public:
     void rewriteHistory(StatisticsHistory& history, StatisticsHistoryData const& newHistoryData, uint64_t timestep);
 
 private:
-    static auto constexpr DefaultTimeStepDelta = 10.0;
-
-    double _longtermTimestepDelta = DefaultTimeStepDelta;
-
-    int _numDataPoints = 0;
-    std::optional<DataPointCollection> _accumulatedDataPoint;
-
-    std::optional<TimelineStatistics> _lastRawStatistics;
-    std::optional<uint64_t> _lastTimestep;
+    static auto constexpr TimestepDelta = 10.0;  //between two data points in the raw tier of the history
 };
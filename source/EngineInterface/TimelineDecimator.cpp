@@ -0,0 +1,176 @@
+#include "TimelineDecimator.h"
+
+#include <algorithm>
+
+#include "Base/Definitions.h"
+
+void TimelineDecimator::clear()
+{
+    _numRemovedDataPoints = 0;
+    _pyramids.clear();
+}
+
+void TimelineDecimator::removeFront(int count)
+{
+    _numRemovedDataPoints += count;
+}
+
+int TimelineDecimator::findFirstIndex(std::vector<DataPointCollection> const& dataPoints, double time) const
+{
+    auto it = std::lower_bound(
+        dataPoints.begin(), dataPoints.end(), time, [](DataPointCollection const& dataPoint, double time) { return dataPoint.time < time; });
+    return toInt(it - dataPoints.begin());
+}
+
+double TimelineDecimator::getMaxValue(std::vector<DataPointCollection> const& dataPoints, int column, int fromIndex, int toIndex)
+{
+    if (fromIndex >= toIndex) {
+        return 0.0;
+    }
+    auto const& pyramid = getPyramid(dataPoints, column);
+    return getExtrema(pyramid, dataPoints, column, fromIndex, toIndex).maxValue;
+}
+
+DecimatedTimeline TimelineDecimator::decimate(
+    std::vector<DataPointCollection> const& dataPoints,
+    int column,
+    double startTime,
+    double endTime,
+    int numBuckets)
+{
+    DecimatedTimeline result;
+    auto addToResult = [&](int index) {
+        result.timePoints.emplace_back(dataPoints.at(index).time);
+        result.values.emplace_back(getValue(dataPoints, column, index + _numRemovedDataPoints));
+        result.systemClock.emplace_back(dataPoints.at(index).systemClock);
+    };
+
+    auto fromIndex = std::max(0, findFirstIndex(dataPoints, startTime) - 1);
+    auto toIndex = std::min(toInt(dataPoints.size()), findFirstIndex(dataPoints, endTime) + 1);
+    numBuckets = std::max(1, numBuckets);
+    if (toIndex - fromIndex <= numBuckets * 4) {
+        for (int index = fromIndex; index < toIndex; ++index) {
+            addToResult(index);
+        }
+        return result;
+    }
+
+    auto const& pyramid = getPyramid(dataPoints, column);
+    auto bucketWidth = (endTime - startTime) / toDouble(numBuckets);
+    auto bucketStart = fromIndex;
+    for (int bucket = 0; bucket < numBuckets && bucketStart < toIndex; ++bucket) {
+        auto bucketEnd = bucket == numBuckets - 1 ? toIndex : std::min(toIndex, findFirstIndex(dataPoints, startTime + bucketWidth * toDouble(bucket + 1)));
+        if (bucketEnd <= bucketStart) {
+            continue;
+        }
+        auto extrema = getExtrema(pyramid, dataPoints, column, bucketStart, bucketEnd);
+        int indices[] = {bucketStart, extrema.minIndex - _numRemovedDataPoints, extrema.maxIndex - _numRemovedDataPoints, bucketEnd - 1};
+        std::sort(std::begin(indices), std::end(indices));
+        for (int i = 0; i < 4; ++i) {
+            if (i == 0 || indices[i] != indices[i - 1]) {
+                addToResult(indices[i]);
+            }
+        }
+        bucketStart = bucketEnd;
+    }
+    return result;
+}
+
+auto TimelineDecimator::getPyramid(std::vector<DataPointCollection> const& dataPoints, int column) -> ColumnPyramid&
+{
+    //rebase the pyramids when they mainly consist of removed data points
+    if (_numRemovedDataPoints > toInt(dataPoints.size())) {
+        clear();
+    }
+    auto numDataPoints = _numRemovedDataPoints + toInt(dataPoints.size());
+
+    auto& pyramid = _pyramids[column];
+    if (pyramid.levels.empty() || pyramid.numDataPoints > numDataPoints) {
+        pyramid.numDataPoints = _numRemovedDataPoints;
+        pyramid.levels = {{}};
+    }
+    for (; pyramid.numDataPoints < numDataPoints; ++pyramid.numDataPoints) {
+        auto index = pyramid.numDataPoints;
+        auto value = getValue(dataPoints, column, index);
+        auto position = index / LeafSize;
+        for (size_t level = 0; level < pyramid.levels.size(); ++level, position /= 2) {
+            auto& entries = pyramid.levels.at(level);
+            if (toInt(entries.size()) <= position) {
+                entries.resize(position + 1);
+            }
+            addDataPoint(entries.at(position), value, index);
+
+            //the top level always consists of one entry
+            if (level + 1 == pyramid.levels.size() && entries.size() > 1) {
+                std::vector<Extrema> parentEntries((entries.size() + 1) / 2);
+                for (size_t i = 0; i < entries.size(); ++i) {
+                    addExtrema(parentEntries.at(i / 2), entries.at(i));
+                }
+                pyramid.levels.emplace_back(std::move(parentEntries));
+                break;
+            }
+        }
+    }
+    return pyramid;
+}
+
+auto TimelineDecimator::getExtrema(
+    ColumnPyramid const& pyramid,
+    std::vector<DataPointCollection> const& dataPoints,
+    int column,
+    int fromIndex,
+    int toIndex) const -> Extrema
+{
+    Extrema result;
+    auto begin = fromIndex + _numRemovedDataPoints;
+    auto end = toIndex + _numRemovedDataPoints;
+
+    //data points which do not fill an entire leaf are scanned
+    for (; begin < end && begin % LeafSize != 0; ++begin) {
+        addDataPoint(result, getValue(dataPoints, column, begin), begin);
+    }
+    for (; begin < end && end % LeafSize != 0; --end) {
+        addDataPoint(result, getValue(dataPoints, column, end - 1), end - 1);
+    }
+
+    auto first = begin / LeafSize;
+    auto last = end / LeafSize;
+    for (size_t level = 0; first < last; ++level, first /= 2, last /= 2) {
+        auto const& entries = pyramid.levels.at(level);
+        if (first % 2 == 1) {
+            addExtrema(result, entries.at(first++));
+        }
+        if (last % 2 == 1) {
+            addExtrema(result, entries.at(--last));
+        }
+    }
+    return result;
+}
+
+void TimelineDecimator::addDataPoint(Extrema& extrema, double value, int index) const
+{
+    if (extrema.minIndex == -1 || value < extrema.minValue) {
+        extrema.minValue = value;
+        extrema.minIndex = index;
+    }
+    if (extrema.maxIndex == -1 || value > extrema.maxValue) {
+        extrema.maxValue = value;
+        extrema.maxIndex = index;
+    }
+}
+
+void TimelineDecimator::addExtrema(Extrema& extrema, Extrema const& other) const
+{
+    if (other.minIndex != -1) {
+        addDataPoint(extrema, other.minValue, other.minIndex);
+    }
+    if (other.maxIndex != -1) {
+        addDataPoint(extrema, other.maxValue, other.maxIndex);
+    }
+}
+
+double TimelineDecimator::getValue(std::vector<DataPointCollection> const& dataPoints, int column, int index) const
+{
+    auto const& dataPoint = dataPoints.at(index - _numRemovedDataPoints);
+    return reinterpret_cast<double const*>(&dataPoint)[column];
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "DataPointCollection.h"
+
+struct DecimatedTimeline
+{
+    std::vector<double> timePoints;
+    std::vector<double> values;
+    std::vector<double> systemClock;
+};
+
+/**
+ * Reduces a column of a time-ordered series of data point collections for plotting. The time range is divided into buckets (usually one per
+ * pixel) and only the first, minimum, maximum and last data point of each bucket are kept, which results in the same line on the screen.
+ * Minima and maxima of blocks of data points are cached per column in a pyramid which is extended when data points are appended to the series.
+ * Data points of the series must not change once they have been passed; removals at the front have to be announced via removeFront.
+ */
+class TimelineDecimator
+{
+public:
+    static int constexpr LeafSize = 16;  //number of data points summarized by the lowest level of the pyramid
+
+    void clear();
+    void removeFront(int count);
+
+    int findFirstIndex(std::vector<DataPointCollection> const& dataPoints, double time) const;  //index of the first data point with time >= given time
+    double getMaxValue(std::vector<DataPointCollection> const& dataPoints, int column, int fromIndex, int toIndex);  //returns 0 for empty ranges
+
+    //column refers to the position of the value in DataPointCollection in units of doubles,
+    //the result also contains the data point preceding startTime such that the line reaches the left border
+    DecimatedTimeline decimate(std::vector<DataPointCollection> const& dataPoints, int column, double startTime, double endTime, int numBuckets);
+
+private:
+    struct Extrema
+    {
+        double minValue = 0;
+        double maxValue = 0;
+        int minIndex = -1;
+        int maxIndex = -1;
+    };
+    struct ColumnPyramid
+    {
+        int numDataPoints = 0;  //data points (including removed ones) which have been included
+        std::vector<std::vector<Extrema>> levels;  //level l summarizes LeafSize * 2^l data points per entry
+    };
+
+    ColumnPyramid& getPyramid(std::vector<DataPointCollection> const& dataPoints, int column);
+    Extrema getExtrema(ColumnPyramid const& pyramid, std::vector<DataPointCollection> const& dataPoints, int column, int fromIndex, int toIndex) const;
+    void addDataPoint(Extrema& extrema, double value, int index) const;
+    void addExtrema(Extrema& extrema, Extrema const& other) const;
+    double getValue(std::vector<DataPointCollection> const& dataPoints, int column, int index) const;
+
+    int _numRemovedDataPoints = 0;  //pyramid indices are shifted by this amount compared to the indices of the series
+    std::unordered_map<int, ColumnPyramid> _pyramids;
+};
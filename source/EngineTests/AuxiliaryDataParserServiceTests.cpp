@@ -0,0 +1,231 @@
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+#include <boost/property_tree/json_parser.hpp>
+
+#include "Base/JsonStreamReader.h"
+#include "Base/JsonStreamWriter.h"
+#include "Base/StringHelper.h"
+#include "PersisterInterface/AuxiliaryDataParserService.h"
+
+class AuxiliaryDataParserServiceTests : public ::testing::Test
+{
+protected:
+    AuxiliaryData createAuxiliaryData(MotionType motionType) const
+    {
+        AuxiliaryData result;
+        result.timestep = 123456789012ull;
+        result.realTime = std::chrono::milliseconds(98765);
+        result.zoom = 3.5f;
+        result.center = {100.25f, -20.0f};
+        result.generalSettings.worldSizeX = 1000;
+        result.generalSettings.worldSizeY = 500;
+
+        auto& parameters = result.simulationParameters;
+        StringHelper::copy(parameters.projectName, sizeof(parameters.projectName), "Test \"project\" \\ / \t ä");
+        parameters.motionType = motionType;
+        if (motionType == MotionType_Fluid) {
+            parameters.motionData.fluidMotion.smoothingLength = 0.9f;
+        } else {
+            parameters.motionData.collisionMotion.cellMaxCollisionDistance = 1.5f;
+        }
+        parameters.baseValues.radiationCellAgeStrength[2] = 0.001953125f;  //tie when rounded to 8 decimals
+        parameters.baseValues.cellFunctionAttackerFoodChainColorMatrix[1][3] = -0.5f;
+        parameters.cellFunctionInjectorDurationColorMatrix[6][0] = 42;
+        parameters.cellCopyMutationColorTransitions[2][4] = true;
+        parameters.features.legacyModes = true;
+
+        parameters.numZones = 4;
+        for (int i = 0; i < parameters.numZones; ++i) {
+            auto& zone = parameters.zone[i];
+            StringHelper::copy(zone.name, sizeof(zone.name), "Zone " + std::to_string(i + 1));
+            zone.posX = toFloat(i) * 100.0f;
+            zone.shapeType = i % 2 == 0 ? SpotShapeType_Circular : SpotShapeType_Rectangular;
+            if (zone.shapeType == SpotShapeType_Rectangular) {
+                zone.shapeData.rectangularSpot.width = 20.0f;
+                zone.shapeData.rectangularSpot.height = 30.0f;
+            }
+            zone.flowType = i;
+            if (zone.flowType == FlowType_Radial) {
+                zone.flowData.radialFlow = RadialFlow();
+            } else if (zone.flowType == FlowType_Central) {
+                zone.flowData.centralFlow = CentralFlow();
+            } else if (zone.flowType == FlowType_Linear) {
+                zone.flowData.linearFlow = LinearFlow();
+            }
+            zone.activatedValues.friction = i % 2 == 1;
+            zone.values.friction = 0.1f * toFloat(i);
+            zone.activatedValues.cellFunctionAttackerFoodChainColorMatrix = true;
+            zone.values.cellFunctionAttackerFoodChainColorMatrix[i][i] = 0.25f;
+        }
+
+        parameters.numRadiationSources = 2;
+        for (int i = 0; i < parameters.numRadiationSources; ++i) {
+            auto& source = parameters.radiationSource[i];
+            StringHelper::copy(source.name, sizeof(source.name), "Radiation " + std::to_string(i + 1));
+            source.shapeType = i == 0 ? RadiationSourceShapeType_Circular : RadiationSourceShapeType_Rectangular;
+            if (source.shapeType == RadiationSourceShapeType_Rectangular) {
+                source.shapeData.rectangularRadiationSource = RectangularRadiationSource();
+            }
+            source.strength = 0.5f;
+        }
+        return result;
+    }
+
+    std::string encodeWithPtree(AuxiliaryData const& data) const
+    {
+        std::stringstream stream;
+        boost::property_tree::json_parser::write_json(stream, AuxiliaryDataParserService::get().encodeAuxiliaryData(data));
+        return stream.str();
+    }
+
+    std::string encodeWithStream(AuxiliaryData const& data) const
+    {
+        std::stringstream stream;
+        AuxiliaryDataParserService::get().encodeAuxiliaryDataToJson(data, stream);
+        return stream.str();
+    }
+
+    AuxiliaryData decodeWithPtree(std::string const& json) const
+    {
+        std::stringstream stream(json);
+        boost::property_tree::ptree tree;
+        boost::property_tree::read_json(stream, tree);
+        return AuxiliaryDataParserService::get().decodeAuxiliaryData(tree);
+    }
+
+    void expectEqual(AuxiliaryData const& expected, AuxiliaryData const& actual) const
+    {
+        EXPECT_EQ(expected.timestep, actual.timestep);
+        EXPECT_EQ(expected.realTime, actual.realTime);
+        EXPECT_EQ(expected.zoom, actual.zoom);
+        EXPECT_EQ(expected.center, actual.center);
+        EXPECT_EQ(expected.generalSettings.worldSizeX, actual.generalSettings.worldSizeX);
+        EXPECT_EQ(expected.generalSettings.worldSizeY, actual.generalSettings.worldSizeY);
+        EXPECT_TRUE(expected.simulationParameters == actual.simulationParameters);
+    }
+};
+
+TEST_F(AuxiliaryDataParserServiceTests, jsonOfDefaultsEqualsPtreeJson)
+{
+    AuxiliaryData data;
+    data.realTime = std::chrono::milliseconds(0);
+    EXPECT_EQ(encodeWithPtree(data), encodeWithStream(data));
+}
+
+TEST_F(AuxiliaryDataParserServiceTests, jsonOfZonesAndRadiationSourcesEqualsPtreeJson)
+{
+    for (auto motionType : {MotionType_Fluid, MotionType_Collision}) {
+        auto data = createAuxiliaryData(motionType);
+        EXPECT_EQ(encodeWithPtree(data), encodeWithStream(data));
+    }
+}
+
+TEST_F(AuxiliaryDataParserServiceTests, jsonOfSimulationParametersEqualsPtreeJson)
+{
+    auto parameters = createAuxiliaryData(MotionType_Fluid).simulationParameters;
+
+    std::stringstream ptreeStream;
+    boost::property_tree::json_parser::write_json(ptreeStream, AuxiliaryDataParserService::get().encodeSimulationParameters(parameters));
+    std::stringstream stream;
+    AuxiliaryDataParserService::get().encodeSimulationParametersToJson(parameters, stream);
+    EXPECT_EQ(ptreeStream.str(), stream.str());
+}
+
+TEST_F(AuxiliaryDataParserServiceTests, jsonRoundTrip)
+{
+    for (auto motionType : {MotionType_Fluid, MotionType_Collision}) {
+        auto data = createAuxiliaryData(motionType);
+        auto json = encodeWithStream(data);
+        auto decodedData = AuxiliaryDataParserService::get().decodeAuxiliaryDataFromJson(json);
+        expectEqual(decodeWithPtree(json), decodedData);
+        EXPECT_EQ(std::string(data.simulationParameters.projectName), std::string(decodedData.simulationParameters.projectName));
+    }
+}
+
+//the fixture was written by the ptree codec of the release before the streaming codec, it has to be replaced when the program version changes
+TEST_F(AuxiliaryDataParserServiceTests, settingsFileOfPreviousReleaseRoundTrips)
+{
+    std::ifstream fileStream(std::filesystem::path(TEST_DATA_DIRECTORY) / "release-4.12.0.settings.json", std::ios::binary);
+    ASSERT_TRUE(fileStream);
+    std::stringstream contentStream;
+    contentStream << fileStream.rdbuf();
+    auto json = contentStream.str();
+
+    auto decodedData = AuxiliaryDataParserService::get().decodeAuxiliaryDataFromJson(json);
+    EXPECT_EQ(json, encodeWithStream(decodedData));
+    EXPECT_EQ(json, encodeWithPtree(decodeWithPtree(json)));
+}
+
+TEST_F(AuxiliaryDataParserServiceTests, jsonOfOlderVersionIsDecodedWithLegacyConversion)
+{
+    auto data = createAuxiliaryData(MotionType_Fluid);
+    data.simulationParameters.features.legacyModes = false;
+    boost::property_tree::ptree tree = AuxiliaryDataParserService::get().encodeAuxiliaryData(data);
+    tree.put("simulation parameters.version", "4.11.2");
+    tree.get_child("simulation parameters.features").erase("cell age limiter");
+    std::stringstream stream;
+    boost::property_tree::json_parser::write_json(stream, tree);
+
+    auto decodedData = AuxiliaryDataParserService::get().decodeAuxiliaryDataFromJson(stream.str());
+    expectEqual(decodeWithPtree(stream.str()), decodedData);
+    EXPECT_EQ(std::string("Zone 1"), std::string(decodedData.simulationParameters.zone[0].name));
+}
+
+TEST_F(AuxiliaryDataParserServiceTests, jsonWithInvalidValues)
+{
+    auto data = createAuxiliaryData(MotionType_Fluid);
+    boost::property_tree::ptree tree = AuxiliaryDataParserService::get().encodeAuxiliaryData(data);
+    tree.put("general.zoom", "abc");
+    tree.put("simulation parameters.spots.1.flow.type", "1.5");
+    std::stringstream stream;
+    boost::property_tree::json_parser::write_json(stream, tree);
+
+    auto decodedData = AuxiliaryDataParserService::get().decodeAuxiliaryDataFromJson(stream.str());
+    expectEqual(decodeWithPtree(stream.str()), decodedData);
+    EXPECT_EQ(4.0f, decodedData.zoom);
+}
+
+TEST_F(AuxiliaryDataParserServiceTests, jsonStreamWriterAndReader)
+{
+    std::vector<std::pair<std::string, std::string>> values = {
+        {"a.b", "1"}, {"a.c.d", "escaped \"\\/\b\f\n\r\t\x01 ä"}, {"a.e", ""}, {"f[0, 1]", "true"}};
+    std::stringstream stream;
+    JsonStreamWriter writer(stream);
+    for (auto const& [path, value] : values) {
+        writer.write(path, value);
+    }
+    writer.finish();
+
+    boost::property_tree::ptree tree;
+    for (auto const& [path, value] : values) {
+        tree.put(path, value);
+    }
+    std::stringstream ptreeStream;
+    boost::property_tree::json_parser::write_json(ptreeStream, tree);
+    EXPECT_EQ(ptreeStream.str(), stream.str());
+
+    std::vector<std::pair<std::string, std::string>> readValues;
+    JsonStreamReader::read(stream.str(), [&](std::string_view path, std::string_view value) { readValues.emplace_back(path, value); });
+    EXPECT_EQ(values, readValues);
+}
+
+TEST_F(AuxiliaryDataParserServiceTests, jsonStreamWriterRejectsReopenedObject)
+{
+    std::stringstream stream;
+    JsonStreamWriter writer(stream);
+    writer.write("a.b", "1");
+    writer.write("c", "2");
+    EXPECT_THROW(writer.write("a.d", "3"), std::logic_error);
+}
+
+TEST_F(AuxiliaryDataParserServiceTests, jsonStreamReaderRejectsInvalidJson)
+{
+    auto callback = [](std::string_view, std::string_view) {};
+    EXPECT_THROW(JsonStreamReader::read("{\"a\": {\"b\": \"1\"}", callback), std::runtime_error);
+    EXPECT_THROW(JsonStreamReader::read("{\"a\" \"1\"}", callback), std::runtime_error);
+    EXPECT_THROW(JsonStreamReader::read("{\"a\": \"\\u12\"}", callback), std::runtime_error);
+}
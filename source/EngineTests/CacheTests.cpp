@@ -0,0 +1,151 @@
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Base/Cache.h"
+
+class CacheTests : public ::testing::Test
+{
+public:
+    CacheTests()
+        : _spillDirectory(std::filesystem::temp_directory_path() / "alien_cache_test")
+    {}
+
+    ~CacheTests() { std::filesystem::remove_all(_spillDirectory); }
+
+protected:
+    using StringCache = Cache<int, std::string>;
+
+    static uint64_t getSize(std::string const& value) { return value.size(); }
+
+    StringCache::SpillTier createSpillTier(uint64_t maxBytes) const
+    {
+        return StringCache::SpillTier{
+            .directory = _spillDirectory,
+            .maxBytes = maxBytes,
+            .serialize = [](std::string const& value) { return value; },
+            .deserialize = [](std::string const& data) { return data; },
+        };
+    }
+
+    std::filesystem::path _spillDirectory;
+};
+
+TEST_F(CacheTests, leastRecentlyUsedEntryIsEvicted)
+{
+    StringCache cache(300, getSize);
+    cache.insertOrAssign(1, std::string(100, 'a'));
+    cache.insertOrAssign(2, std::string(100, 'b'));
+    cache.insertOrAssign(3, std::string(100, 'c'));
+
+    //access refreshes the entry
+    EXPECT_TRUE(cache.find(1).has_value());
+    cache.insertOrAssign(4, std::string(100, 'd'));
+
+    EXPECT_EQ(std::string(100, 'a'), cache.find(1));
+    EXPECT_FALSE(cache.find(2).has_value());
+    EXPECT_TRUE(cache.find(3).has_value());
+    EXPECT_TRUE(cache.find(4).has_value());
+
+    auto statistics = cache.getStatistics();
+    EXPECT_EQ(4, statistics.numHits);
+    EXPECT_EQ(1, statistics.numMisses);
+    EXPECT_EQ(1, statistics.numEvictions);
+    EXPECT_EQ(3, statistics.numEntries);
+    EXPECT_EQ(300, statistics.numBytes);
+}
+
+TEST_F(CacheTests, assignReplacesSize)
+{
+    StringCache cache(1000, getSize);
+    cache.insertOrAssign(1, std::string(100, 'a'));
+    cache.insertOrAssign(1, std::string(50, 'b'));
+
+    EXPECT_EQ(std::string(50, 'b'), cache.find(1));
+    EXPECT_EQ(1, cache.getStatistics().numEntries);
+    EXPECT_EQ(50, cache.getStatistics().numBytes);
+
+    cache.erase(1);
+    EXPECT_FALSE(cache.find(1).has_value());
+    EXPECT_EQ(0, cache.getStatistics().numBytes);
+}
+
+TEST_F(CacheTests, mostRecentEntryIsKept)
+{
+    StringCache cache(100, getSize);
+    cache.insertOrAssign(1, std::string(50, 'a'));
+    cache.insertOrAssign(2, std::string(500, 'b'));
+
+    EXPECT_FALSE(cache.find(1).has_value());
+    EXPECT_EQ(std::string(500, 'b'), cache.find(2));
+}
+
+TEST_F(CacheTests, globalBudget)
+{
+    auto origMaxBytes = CacheMemoryBudget::get().getMaxBytes();
+    {
+        StringCache cache(1000000, getSize);
+        CacheMemoryBudget::get().setMaxBytes(CacheMemoryBudget::get().getUsedBytes() + 250);
+        for (int i = 0; i < 10; ++i) {
+            cache.insertOrAssign(i, std::string(100, 'a'));
+        }
+        EXPECT_EQ(2, cache.getStatistics().numEntries);
+        EXPECT_FALSE(CacheMemoryBudget::get().isExceeded());
+    }
+    CacheMemoryBudget::get().setMaxBytes(origMaxBytes);
+}
+
+TEST_F(CacheTests, spillTier)
+{
+    StringCache cache(200, getSize);
+    cache.setSpillTier(createSpillTier(250));
+    cache.insertOrAssign(1, std::string(100, 'a'));
+    cache.insertOrAssign(2, std::string(100, 'b'));
+    cache.insertOrAssign(3, std::string(100, 'c'));
+    cache.insertOrAssign(4, std::string(100, 'd'));
+    cache.insertOrAssign(5, std::string(100, 'e'));
+
+    //entry 1 was dropped from the spill tier since it exceeded its budget
+    auto statistics = cache.getStatistics();
+    EXPECT_EQ(2, statistics.numSpilledEntries);
+    EXPECT_EQ(200, statistics.numSpilledBytes);
+    EXPECT_FALSE(cache.find(1).has_value());
+
+    EXPECT_EQ(std::string(100, 'b'), cache.find(2));
+    statistics = cache.getStatistics();
+    EXPECT_EQ(1, statistics.numSpillHits);
+    EXPECT_EQ(2, statistics.numEntries);
+    EXPECT_EQ(2, statistics.numSpilledEntries);
+
+    cache.clear();
+    EXPECT_TRUE(std::filesystem::is_empty(_spillDirectory));
+}
+
+TEST_F(CacheTests, concurrentAccess)
+{
+    StringCache cache(50 * 100, getSize);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&cache, t] {
+            for (int i = 0; i < 2000; ++i) {
+                auto key = (i * 7 + t) % 200;
+                if (auto value = cache.find(key)) {
+                    EXPECT_EQ(std::string(100, static_cast<char>('a' + key % 26)), *value);
+                } else {
+                    cache.insertOrAssign(key, std::string(100, static_cast<char>('a' + key % 26)));
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto statistics = cache.getStatistics();
+    EXPECT_LE(statistics.numBytes, 50 * 100);
+    EXPECT_EQ(statistics.numBytes, statistics.numEntries * 100);
+    EXPECT_EQ(4 * 2000, statistics.numHits + statistics.numMisses);
+}
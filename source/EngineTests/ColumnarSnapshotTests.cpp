@@ -0,0 +1,140 @@
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/GenomeDescriptionService.h"
+#include "PersisterInterface/ColumnarSnapshot.h"
+#include "PersisterInterface/ColumnarSnapshotService.h"
+
+class ColumnarSnapshotTests : public ::testing::Test
+{
+public:
+    ColumnarSnapshotTests()
+        : _filename(std::filesystem::temp_directory_path() / "alien_columnar_snapshot_test.sim")
+    {}
+
+    ~ColumnarSnapshotTests() { std::filesystem::remove(_filename); }
+
+protected:
+    void write(ClusteredDataDescription const& data) const
+    {
+        std::ofstream stream(_filename, std::ios::binary);
+        ColumnarSnapshotService::get().serialize(data, stream);
+    }
+
+    ClusteredDataDescription read() const
+    {
+        ClusteredDataDescription result;
+        ColumnarSnapshotService::get().deserialize(result, _filename);
+        return result;
+    }
+
+    std::filesystem::path _filename;
+};
+
+TEST_F(ColumnarSnapshotTests, allCellFunctions)
+{
+    auto genome = GenomeDescriptionService::get().convertDescriptionToBytes(GenomeDescription().setCells({CellGenomeDescription()}));
+
+    NeuronDescription neuron;
+    neuron.weights[2][1] = 1.0f;
+    neuron.biases[3] = -0.5f;
+    neuron.activationFunctions[4] = NeuronActivationFunction_Gaussian;
+    SensorDescription sensor;
+    sensor.minRange = 10;
+    sensor.restrictToColor = 3;
+    ReconnectorDescription reconnector;
+    reconnector.restrictToColor = 2;
+
+    std::vector<CellFunctionDescription> cellFunctions = {
+        std::nullopt,
+        neuron,
+        TransmitterDescription().setMode(EnergyDistributionMode_ConnectedCells),
+        ConstructorDescription().setGenome(genome).setGenomeCurrentNodeIndex(1).setConstructionAngle1(45.0f),
+        sensor,
+        NerveDescription().setPulseMode(3).setAlternationMode(2),
+        AttackerDescription(),
+        InjectorDescription().setGenome(genome),
+        MuscleDescription().setMode(MuscleMode_ContractionExpansion),
+        DefenderDescription(),
+        reconnector,
+        DetonatorDescription().setCountDown(5),
+    };
+
+    ClusteredDataDescription data;
+    ClusterDescription cluster;
+    for (int index = 0; index < toInt(cellFunctions.size()); ++index) {
+        CellDescription cell;
+        cell.setId(index + 1)
+            .setPos({toFloat(index), 2.0f})
+            .setVel({0.5f, -1.0f})
+            .setEnergy(120.0f)
+            .setColor(index % MAX_COLORS)
+            .setMaxConnections(2)
+            .setExecutionOrderNumber(index % 6)
+            .setSignal({1.0f, 0, -1.0f, 0, 0, 0, 0, 0.5f})
+            .setMetadata(CellMetadataDescription().setName("cell " + std::to_string(index)).setDescription(index % 2 == 0 ? "" : "description"));
+        if (index % 3 == 0) {
+            cell.setInputExecutionOrderNumber(1);
+        }
+        cell.cellFunction = cellFunctions.at(index);
+        if (index > 0) {
+            cell.connections.emplace_back(ConnectionDescription().setCellId(index).setDistance(1.0f).setAngleFromPrevious(360.0f));
+        }
+        cluster.cells.emplace_back(cell);
+    }
+    data.addCluster(cluster);
+    data.addParticle(ParticleDescription().setId(100).setPos({5.0f, 6.0f}).setVel({0.1f, 0.2f}).setEnergy(10.0f).setColor(4));
+
+    write(data);
+    EXPECT_TRUE(ColumnarSnapshot::isColumnarSnapshot(_filename));
+    EXPECT_EQ(data, read());
+}
+
+TEST_F(ColumnarSnapshotTests, sectionsSpanningSeveralChunks)
+{
+    auto numCells = ColumnarSnapshot::ChunkSize / sizeof(float) * 2 + 17;
+
+    ClusteredDataDescription data;
+    ClusterDescription cluster;
+    for (uint64_t i = 0; i < numCells; ++i) {
+        cluster.cells.emplace_back(CellDescription().setId(i + 1).setPos({toFloat(i % 1000), toFloat(i / 1000)}).setEnergy(toFloat(i % 250)));
+    }
+    data.addCluster(cluster);
+
+    write(data);
+    EXPECT_EQ(data, read());
+}
+
+TEST_F(ColumnarSnapshotTests, identicalGenomesStoredOnce)
+{
+    auto genome = GenomeDescriptionService::get().convertDescriptionToBytes(GenomeDescription().setCells({CellGenomeDescription()}));
+    auto otherGenome = GenomeDescriptionService::get().convertDescriptionToBytes(
+        GenomeDescription().setCells({CellGenomeDescription(), CellGenomeDescription().setColor(2)}));
+
+    ClusterDescription cluster;
+    for (int i = 0; i < 100; ++i) {
+        cluster.addCell(CellDescription().setId(i + 1).setCellFunction(ConstructorDescription().setGenome(i % 10 == 0 ? otherGenome : genome)));
+    }
+    cluster.addCell(CellDescription().setId(101).setCellFunction(InjectorDescription().setGenome(genome)));
+    ClusteredDataDescription data;
+    data.addCluster(cluster);
+
+    write(data);
+    ColumnarSnapshotReader reader(_filename);
+    EXPECT_EQ(2, reader.getNumElements(ColumnarSnapshotSection_GenomeSizes));
+    EXPECT_EQ(genome.size() + otherGenome.size(), reader.getNumElements(ColumnarSnapshotSection_GenomeData));
+    EXPECT_EQ(101, reader.getNumElements(ColumnarSnapshotSection_GenomeIds));
+    EXPECT_EQ(data, read());
+}
+
+TEST_F(ColumnarSnapshotTests, truncatedFile)
+{
+    ClusteredDataDescription data;
+    data.addParticle(ParticleDescription().setId(1).setEnergy(10.0f));
+    write(data);
+
+    std::filesystem::resize_file(_filename, std::filesystem::file_size(_filename) - 4);
+    EXPECT_THROW(read(), std::runtime_error);
+}
@@ -0,0 +1,49 @@
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "PersisterInterface/CompressionService.h"
+
+class CompressionServiceTests : public ::testing::Test
+{
+protected:
+    std::vector<uint8_t> createData(uint64_t size) const
+    {
+        std::vector<uint8_t> result(size);
+        uint32_t state = 17;
+        for (uint64_t i = 0; i < size; ++i) {
+            state = state * 1103515245 + 12345;
+            result[i] = static_cast<uint8_t>(i % 7 == 0 ? (state >> 16) : i % 31);
+        }
+        return result;
+    }
+};
+
+TEST_F(CompressionServiceTests, emptyBlock)
+{
+    auto compressedData = CompressionService::get().compressBlock(nullptr, 0);
+    uint8_t target = 0;
+    EXPECT_NO_THROW(CompressionService::get().decompressBlock(&target, 0, compressedData.data(), compressedData.size()));
+}
+
+TEST_F(CompressionServiceTests, block)
+{
+    auto data = createData(1 << 20);
+    auto compressedData = CompressionService::get().compressBlock(data.data(), data.size());
+    EXPECT_LT(compressedData.size(), data.size());
+
+    std::vector<uint8_t> actualData(data.size());
+    CompressionService::get().decompressBlock(actualData.data(), actualData.size(), compressedData.data(), compressedData.size());
+    EXPECT_EQ(data, actualData);
+}
+
+TEST_F(CompressionServiceTests, truncatedBlock)
+{
+    auto data = createData(100000);
+    auto compressedData = CompressionService::get().compressBlock(data.data(), data.size());
+
+    std::vector<uint8_t> actualData(data.size());
+    EXPECT_THROW(
+        CompressionService::get().decompressBlock(actualData.data(), actualData.size(), compressedData.data(), compressedData.size() - 100),
+        std::runtime_error);
+}
@@ -0,0 +1,317 @@
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "Base/Math.h"
+#include "Base/NumberGenerator.h"
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/GenomeDescriptionService.h"
+#include "EngineInterface/SimulationFacade.h"
+#include "EngineImpl/SimulationFacadeImpl.h"
+#include "PersisterInterface/ColumnarSnapshotService.h"
+#include "IntegrationTestFramework.h"
+
+class CpuBackendTests : public IntegrationTestFramework
+{
+public:
+    CpuBackendTests()
+        : IntegrationTestFramework(std::nullopt, IntVector2D{1000, 1000}, BackendSettings{SimulationBackend_Cpu, 1})
+    {}
+
+    ~CpuBackendTests() = default;
+
+protected:
+    DataDescription createRandomData(int numCellPairs, int numParticles) const
+    {
+        auto& numberGen = NumberGenerator::get();
+        DataDescription result;
+        for (int i = 0; i < numCellPairs; ++i) {
+            RealVector2D pos{numberGen.getRandomFloat(0.0f, 100.0f), numberGen.getRandomFloat(0.0f, 100.0f)};
+            RealVector2D vel{numberGen.getRandomFloat(-0.5f, 0.5f), numberGen.getRandomFloat(-0.5f, 0.5f)};
+            auto id1 = numberGen.getId();
+            auto id2 = numberGen.getId();
+            result.addCells({
+                CellDescription().setId(id1).setPos(pos).setVel(vel).setMaxConnections(2),
+                CellDescription().setId(id2).setPos(pos + RealVector2D{1.0f, 0.0f}).setVel(vel).setMaxConnections(2),
+            });
+            result.addConnection(id1, id2);
+        }
+        for (int i = 0; i < numParticles; ++i) {
+            result.addParticle(ParticleDescription()
+                                   .setId(numberGen.getId())
+                                   .setPos({numberGen.getRandomFloat(0.0f, 100.0f), numberGen.getRandomFloat(0.0f, 100.0f)})
+                                   .setVel({numberGen.getRandomFloat(-1.0f, 1.0f), numberGen.getRandomFloat(-1.0f, 1.0f)})
+                                   .setEnergy(numberGen.getRandomFloat(0.0f, 10.0f)));
+        }
+        return result;
+    }
+};
+
+TEST_F(CpuBackendTests, dataTransfer)
+{
+    DataDescription data;
+    data.addCells({
+        CellDescription().setId(1).setPos({2.0f, 4.0f}).setVel({0.5f, 1.0f}).setMaxConnections(1).setColor(2).setCellFunction(NeuronDescription()),
+        CellDescription().setId(2).setPos({3.0f, 4.0f}).setVel({0.2f, 1.0f}).setMaxConnections(1).setColor(4).setCellFunction(NerveDescription()),
+    });
+    data.addConnection(1, 2);
+    data.addParticle(ParticleDescription().setId(3).setPos({10.0f, 10.0f}).setEnergy(5.0f));
+
+    _simulationFacade->setSimulationData(data);
+    auto actualData = _simulationFacade->getSimulationData();
+
+    EXPECT_TRUE(compare(data, actualData));
+}
+
+TEST_F(CpuBackendTests, saveAndLoadSimulationData)
+{
+    NeuronDescription neuron;
+    neuron.weights[2][1] = 1.0f;
+    neuron.biases[4] = -0.5f;
+    NerveDescription nerve;
+    nerve.pulseMode = 3;
+
+    DataDescription data;
+    data.addCells({
+        CellDescription().setId(1).setPos({2.0f, 4.0f}).setMaxConnections(2).setCellFunction(neuron).setMetadata(CellMetadataDescription().setName("neuron")),
+        CellDescription().setId(2).setPos({3.0f, 4.0f}).setMaxConnections(2),
+        CellDescription().setId(3).setPos({4.0f, 4.0f}).setMaxConnections(2).setCellFunction(nerve).setInputExecutionOrderNumber(2),
+    });
+    data.addConnection(1, 2);
+    data.addConnection(2, 3);
+    data.addParticle(ParticleDescription().setId(4).setPos({10.0f, 10.0f}).setEnergy(5.0f));
+    _simulationFacade->setSimulationData(data);
+
+    auto filename = std::filesystem::temp_directory_path() / "alien_cpu_backend_test.sim";
+    _simulationFacade->saveSimulationData(filename);
+
+    ClusteredDataDescription savedData;
+    ColumnarSnapshotService::get().deserialize(savedData, filename);
+    EXPECT_TRUE(compare(data, DataDescription(savedData)));
+
+    _simulationFacade->clear();
+    _simulationFacade->loadSimulationData(filename);
+    std::filesystem::remove(filename);
+
+    EXPECT_TRUE(compare(data, _simulationFacade->getSimulationData()));
+}
+
+TEST_F(CpuBackendTests, unsupportedCellFunctionsAreRejected)
+{
+    auto genome = GenomeDescriptionService::get().convertDescriptionToBytes(GenomeDescription().setCells({CellGenomeDescription()}));
+    std::vector<CellFunctionDescription> unsupportedCellFunctions = {
+        TransmitterDescription(),
+        ConstructorDescription().setGenome(genome),
+        SensorDescription(),
+        AttackerDescription(),
+        InjectorDescription().setGenome(genome),
+        MuscleDescription(),
+        DefenderDescription(),
+        ReconnectorDescription(),
+        DetonatorDescription()};
+    ASSERT_EQ(CellFunction_WithoutNone_Count - 2, toInt(unsupportedCellFunctions.size()));
+
+    auto supportedData = DataDescription().addCells({
+        CellDescription().setId(1).setPos({2.0f, 4.0f}).setMaxConnections(2).setCellFunction(NeuronDescription()),
+        CellDescription().setId(2).setPos({3.0f, 4.0f}).setMaxConnections(2).setCellFunction(NerveDescription()),
+        CellDescription().setId(3).setPos({4.0f, 4.0f}).setMaxConnections(2),
+    });
+    _simulationFacade->setSimulationData(supportedData);
+
+    for (auto const& cellFunction : unsupportedCellFunctions) {
+        auto cell = CellDescription().setId(4).setPos({20.0f, 4.0f}).setMaxConnections(2);
+        cell.cellFunction = cellFunction;
+        auto data = DataDescription().addCell(cell);
+
+        //no fallback to a cell without function: the data is rejected and the world is left unchanged
+        EXPECT_THROW(_simulationFacade->setSimulationData(data), std::runtime_error);
+        EXPECT_THROW(_simulationFacade->addAndSelectSimulationData(data), std::runtime_error);
+        EXPECT_TRUE(compare(supportedData, _simulationFacade->getSimulationData()));
+    }
+}
+
+TEST_F(CpuBackendTests, nerveExecution)
+{
+    SignalDescription signal;
+    signal.channels = {1, 0, -1, 0, 0, 0, 0, 0};
+
+    auto data = DataDescription().addCells({
+        CellDescription().setId(1).setCellFunction(NerveDescription()).setMaxConnections(2).setExecutionOrderNumber(0).setSignal(signal),
+    });
+
+    _simulationFacade->setSimulationData(data);
+    _simulationFacade->calcTimesteps(1);
+
+    auto actualData = _simulationFacade->getSimulationData();
+    auto actualCellById = getCellById(actualData);
+
+    EXPECT_EQ(SignalDescription(), actualCellById.at(1).signal);
+}
+
+TEST_F(CpuBackendTests, connectedCellsStayConnected)
+{
+    DataDescription data;
+    data.addCells({
+        CellDescription().setId(1).setPos({10.0f, 10.0f}).setVel({0.1f, 0.0f}).setMaxConnections(2),
+        CellDescription().setId(2).setPos({11.0f, 10.0f}).setVel({0.1f, 0.0f}).setMaxConnections(2),
+    });
+    data.addConnection(1, 2);
+
+    _simulationFacade->setSimulationData(data);
+    _simulationFacade->calcTimesteps(100);
+
+    auto actualData = _simulationFacade->getSimulationData();
+    ASSERT_EQ(2, actualData.cells.size());
+    EXPECT_TRUE(hasConnection(actualData, 1, 2));
+    EXPECT_TRUE(approxCompare(getEnergy(data), getEnergy(actualData)));
+}
+
+TEST_F(CpuBackendTests, resultIndependentOfThreadCount)
+{
+    auto data = createRandomData(500, 500);
+
+    auto otherSimulationFacade = std::make_shared<_SimulationFacadeImpl>();
+    otherSimulationFacade->setBackendSettings(BackendSettings{SimulationBackend_Cpu, 4});
+    otherSimulationFacade->newSimulation(0, GeneralSettings{1000, 1000}, _parameters);
+
+    _simulationFacade->setSimulationData(data);
+    otherSimulationFacade->setSimulationData(data);
+    _simulationFacade->calcTimesteps(100);
+    otherSimulationFacade->calcTimesteps(100);
+
+    auto actualData = _simulationFacade->getSimulationData();
+    auto otherActualData = otherSimulationFacade->getSimulationData();
+    otherSimulationFacade->closeSimulation();
+
+    EXPECT_TRUE(compare(actualData, otherActualData));
+}
+
+TEST_F(CpuBackendTests, equivalentToCudaBackendOnSmallWorld)
+{
+    //separated clusters with signal processing and particles which do not collide, hence the result does not depend on the random numbers
+    DataDescription data;
+    NeuronDescription neuron;
+    neuron.weights[0][0] = 1.0f;
+    neuron.weights[1][0] = -0.5f;
+    for (int i = 0; i < 10; ++i) {
+        auto id = static_cast<uint64_t>(i * 4 + 1);
+        RealVector2D pos{50.0f + toFloat(i) * 80.0f, 100.0f + toFloat(i % 3) * 200.0f};
+        RealVector2D vel{0.05f * toFloat(i % 4), -0.03f * toFloat(i % 5)};
+        data.addCells({
+            CellDescription().setId(id).setPos(pos).setVel(vel).setMaxConnections(2).setExecutionOrderNumber(0).setCellFunction(
+                NerveDescription().setPulseMode(2)),
+            CellDescription()
+                .setId(id + 1)
+                .setPos(pos + RealVector2D{1.0f, 0.0f})
+                .setVel(vel)
+                .setMaxConnections(2)
+                .setExecutionOrderNumber(1)
+                .setInputExecutionOrderNumber(0)
+                .setCellFunction(neuron),
+            CellDescription().setId(id + 2).setPos(pos + RealVector2D{1.0f, 1.0f}).setVel(vel).setMaxConnections(2),
+        });
+        data.addConnection(id, id + 1);
+        data.addConnection(id + 1, id + 2);
+        data.addParticle(ParticleDescription().setId(id + 3).setPos(pos + RealVector2D{0.0f, 40.0f}).setVel({0.1f, 0.0f}).setEnergy(5.0f));
+    }
+
+    auto cudaSimulationFacade = std::make_shared<_SimulationFacadeImpl>();
+    cudaSimulationFacade->newSimulation(0, GeneralSettings{1000, 1000}, _parameters);
+
+    _simulationFacade->setSimulationData(data);
+    cudaSimulationFacade->setSimulationData(data);
+    _simulationFacade->calcTimesteps(50);
+    cudaSimulationFacade->calcTimesteps(50);
+
+    auto cpuCellById = getCellById(_simulationFacade->getSimulationData());
+    auto cudaData = cudaSimulationFacade->getSimulationData();
+    cudaSimulationFacade->closeSimulation();
+
+    ASSERT_EQ(cudaData.cells.size(), cpuCellById.size());
+    for (auto const& cudaCell : cudaData.cells) {
+        ASSERT_TRUE(cpuCellById.contains(cudaCell.id));
+        auto const& cpuCell = cpuCellById.at(cudaCell.id);
+        EXPECT_LT(Math::length(cudaCell.pos - cpuCell.pos), 0.01f);
+        EXPECT_LT(Math::length(cudaCell.vel - cpuCell.vel), 0.001f);
+        EXPECT_TRUE(approxCompare(cudaCell.energy, cpuCell.energy));
+        EXPECT_EQ(cudaCell.connections.size(), cpuCell.connections.size());
+        EXPECT_TRUE(approxCompare(cudaCell.signal.channels, cpuCell.signal.channels));
+    }
+    auto cpuParticles = _simulationFacade->getSimulationData().particles;
+    ASSERT_EQ(cudaData.particles.size(), cpuParticles.size());
+    for (auto const& cudaParticle : cudaData.particles) {
+        auto cpuParticle = std::find_if(cpuParticles.begin(), cpuParticles.end(), [&](auto const& particle) { return particle.id == cudaParticle.id; });
+        ASSERT_TRUE(cpuParticle != cpuParticles.end());
+        EXPECT_LT(Math::length(cudaParticle.pos - cpuParticle->pos), 0.01f);
+        EXPECT_TRUE(approxCompare(cudaParticle.energy, cpuParticle->energy));
+    }
+}
+
+TEST_F(CpuBackendTests, pausedWorkerWaitsWithoutPolling)
+{
+    _simulationFacade->setSimulationData(createRandomData(100, 100));
+
+    //a polling worker would wake up repeatedly while there is nothing to do
+    auto accessStatisticsBefore = _simulationFacade->getEngineAccessStatistics();
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    auto accessStatistics = _simulationFacade->getEngineAccessStatistics();
+    EXPECT_EQ(accessStatisticsBefore.numWakeUps, accessStatistics.numWakeUps);
+    EXPECT_EQ(accessStatisticsBefore.numRequests, accessStatistics.numRequests);
+
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(200, _simulationFacade->getSimulationData().cells.size());
+    }
+    accessStatistics = _simulationFacade->getEngineAccessStatistics();
+    EXPECT_EQ(accessStatisticsBefore.numRequests + 3, accessStatistics.numRequests);
+    EXPECT_LE(accessStatistics.numWakeUps, accessStatisticsBefore.numWakeUps + 3);
+}
+
+TEST_F(CpuBackendTests, requestsAreServedDuringTpsRestriction)
+{
+    _simulationFacade->setSimulationData(createRandomData(100, 100));
+    _simulationFacade->setTpsRestriction(1);
+    auto accessStatisticsBefore = _simulationFacade->getEngineAccessStatistics();
+
+    //requests served only between time steps would need one time step each
+    _simulationFacade->runSimulation();
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(200, _simulationFacade->getSimulationData().cells.size());
+    }
+    _simulationFacade->pauseSimulation();
+    _simulationFacade->setTpsRestriction(std::nullopt);
+
+    EXPECT_LT(_simulationFacade->getCurrentTimestep(), 10);
+
+    auto accessStatistics = _simulationFacade->getEngineAccessStatistics();
+    EXPECT_GE(accessStatistics.numRequests, accessStatisticsBefore.numRequests + 11);
+    EXPECT_GE(accessStatistics.numWakeUps, accessStatisticsBefore.numWakeUps + 10);
+    EXPECT_LE(accessStatistics.getAverageWaitingTime(), accessStatistics.maxWaitingTime);
+}
+
+TEST_F(CpuBackendTests, snapshotsFollowModifications)
+{
+    auto data = createRandomData(10, 0);
+    _simulationFacade->setSimulationData(data);
+    auto inspectedCellId = data.cells.front().id;
+    _simulationFacade->setInspectedEntityIdsForSnapshot({inspectedCellId});
+    _simulationFacade->setSelection({0.0f, 0.0f}, {1000.0f, 1000.0f});
+
+    auto waitForSnapshot = [](auto const& predicate) {
+        auto endTimepoint = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!predicate() && std::chrono::steady_clock::now() < endTimepoint) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return predicate();
+    };
+    EXPECT_TRUE(waitForSnapshot([&] { return _simulationFacade->getSelectionShallowDataSnapshot().numCells == 20; }));
+    ASSERT_TRUE(waitForSnapshot([&] { return _simulationFacade->getInspectedDataSnapshot()->entityIds == std::vector<uint64_t>{inspectedCellId}; }));
+
+    auto inspectedData = _simulationFacade->getInspectedDataSnapshot();
+    ASSERT_EQ(1, inspectedData->data.cells.size());
+    EXPECT_EQ(inspectedCellId, inspectedData->data.cells.front().id);
+
+    _simulationFacade->removeSelection();
+    EXPECT_TRUE(waitForSnapshot([&] { return _simulationFacade->getSelectionShallowDataSnapshot().numCells == 0; }));
+}
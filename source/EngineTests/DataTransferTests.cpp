@@ -1,9 +1,13 @@
+#include <filesystem>
+
 #include <gtest/gtest.h>
 
 #include "Base/NumberGenerator.h"
 #include "EngineInterface/DescriptionEditService.h"
 #include "EngineInterface/Descriptions.h"
+#include "EngineInterface/GenomeDescriptionService.h"
 #include "EngineInterface/SimulationFacade.h"
+#include "EngineImpl/DataTOSerializer.h"
 #include "IntegrationTestFramework.h"
 
 class DataTransferTests : public IntegrationTestFramework
@@ -146,3 +150,37 @@ TEST_F(DataTransferTests, largeData)
         EXPECT_EQ(data.particles.size() + newData.particles.size(), actualData.particles.size());
     }
 }
+
+TEST_F(DataTransferTests, loadSimulationDataWithSharedGenome)
+{
+    std::vector<CellGenomeDescription> genomeCells(200, CellGenomeDescription());
+    auto genome = GenomeDescriptionService::get().convertDescriptionToBytes(GenomeDescription().setCells(genomeCells));
+
+    auto& numberGen = NumberGenerator::get();
+    DataDescription data;
+    for (int i = 0; i < 2000; ++i) {
+        data.addCell(CellDescription()
+                         .setId(numberGen.getId())
+                         .setPos({numberGen.getRandomFloat(0.0f, 100.0f), numberGen.getRandomFloat(0.0f, 100.0f)})
+                         .setMaxConnections(1)
+                         .setCellFunction(ConstructorDescription().setGenome(genome)));
+    }
+    _simulationFacade->setSimulationData(data);
+
+    auto filename = std::filesystem::temp_directory_path() / "alien_shared_genome_test.sim";
+    _simulationFacade->saveSimulationData(filename);
+
+    //the file stores the genome once, the GPU needs a copy for every cell
+    auto dataTO = DataTOSerializer::deserialize(filename);
+    auto arraySizes = DataTOSerializer::getArraySizes(dataTO);
+    auto numAuxiliaryData = *dataTO.numAuxiliaryData;
+    dataTO.destroy();
+    EXPECT_LT(numAuxiliaryData, 2000 * genome.size());
+    EXPECT_EQ(2000 * genome.size(), arraySizes.auxiliaryDataSize);
+
+    _simulationFacade->clear();
+    _simulationFacade->loadSimulationData(filename);
+    std::filesystem::remove(filename);
+
+    EXPECT_TRUE(compare(data, _simulationFacade->getSimulationData()));
+}
@@ -0,0 +1,285 @@
+#include <algorithm>
+#include <fstream>
+
+#include <boost/property_tree/ptree.hpp>
+#include <gtest/gtest.h>
+
+#include "EngineInterface/Descriptions.h"
+#include "EngineImpl/DataTOSerializer.h"
+#include "EngineImpl/DescriptionConverter.h"
+#include "PersisterInterface/ColumnarSnapshotService.h"
+#include "PersisterInterface/SavepointTableService.h"
+#include "PersisterInterface/SerializerService.h"
+#include "PersisterInterface/SimulationDeltaService.h"
+
+class DeltaSavepointTests : public ::testing::Test
+{
+public:
+    DeltaSavepointTests()
+        : _directory(std::filesystem::temp_directory_path() / "alien_delta_savepoint_test")
+    {
+        std::filesystem::remove_all(_directory);
+        std::filesystem::create_directories(_directory);
+    }
+
+    ~DeltaSavepointTests() { std::filesystem::remove_all(_directory); }
+
+protected:
+    ClusteredDataDescription createContent(int numClusters) const
+    {
+        ClusteredDataDescription result;
+        for (int i = 0; i < numClusters; ++i) {
+            ClusterDescription cluster;
+            for (int j = 0; j < 10; ++j) {
+                auto id = toInt(i * 10 + j + 1);
+                CellDescription cell;
+                cell.setId(id).setPos({toFloat(j), toFloat(i) * 3}).setEnergy(100.0f).setColor(j % MAX_COLORS);
+                if (j > 0) {
+                    cell.connections.emplace_back(ConnectionDescription().setCellId(id - 1).setDistance(1.0f).setAngleFromPrevious(360.0f));
+                }
+                cluster.addCell(cell);
+            }
+            result.addCluster(cluster);
+            result.addParticle(ParticleDescription().setId(1000 + i).setPos({toFloat(i), -5.0f}).setEnergy(toFloat(i)));
+        }
+        return result;
+    }
+
+    ClusteredDataDescription createChangedContent(ClusteredDataDescription const& content) const
+    {
+        auto result = content;
+        result.clusters.at(0).cells.at(5).energy = 50.0f;
+        result.clusters.at(1).cells.erase(result.clusters.at(1).cells.begin() + 9);
+        result.addCluster(ClusterDescription().addCell(CellDescription().setId(5000).setPos({-10.0f, -10.0f})));
+        result.particles.at(0).vel = {1.0f, 0};
+        result.particles.pop_back();
+        result.addParticle(ParticleDescription().setId(6000));
+        return result;
+    }
+
+    std::vector<CellDescription> getCells(ClusteredDataDescription const& content) const
+    {
+        std::vector<CellDescription> result;
+        for (auto const& cluster : content.clusters) {
+            result.insert(result.end(), cluster.cells.begin(), cluster.cells.end());
+        }
+        std::ranges::sort(result, [](auto const& cell1, auto const& cell2) { return cell1.id < cell2.id; });
+        return result;
+    }
+
+    std::vector<ParticleDescription> getParticles(ClusteredDataDescription const& content) const
+    {
+        auto result = content.particles;
+        std::ranges::sort(result, [](auto const& particle1, auto const& particle2) { return particle1.id < particle2.id; });
+        return result;
+    }
+
+    DeserializedSimulation createSimulation(ClusteredDataDescription const& content, uint32_t timestep) const
+    {
+        DeserializedSimulation result;
+        result.mainData = content;
+        result.auxiliaryData.timestep = timestep;
+        result.auxiliaryData.zoom = toFloat(timestep) / 100;
+        result.statistics.resize(timestep / 100);
+        return result;
+    }
+
+    void createDummyFiles(std::filesystem::path const& filename) const
+    {
+        for (auto const& extension : {".sim", ".settings.json", ".statistics.bin"}) {
+            std::ofstream stream(std::filesystem::path(filename).replace_extension(extension));
+            stream << "dummy";
+        }
+    }
+
+    SavepointEntry createPersistedEntry(std::string const& name, std::string const& baseName) const
+    {
+        createDummyFiles(_directory / (name + ".sim"));
+        auto result = std::make_shared<_SavepointEntry>();
+        result->state = SavepointState_Persisted;
+        result->filename = name + ".sim";
+        result->baseFilename = baseName.empty() ? std::filesystem::path() : std::filesystem::path(baseName + ".sim");
+        return result;
+    }
+
+    std::filesystem::path _directory;
+};
+
+TEST_F(DeltaSavepointTests, calcAndApplyDelta)
+{
+    auto base = createContent(5);
+    auto content = createChangedContent(base);
+
+    auto delta = SimulationDeltaService::get().calcDelta(base, content);
+    EXPECT_EQ(2, getCells(delta.changedContent).size());
+    EXPECT_EQ(2, delta.changedContent.particles.size());
+    EXPECT_EQ(std::vector<uint64_t>{20}, delta.removedCellIds);
+    EXPECT_EQ(std::vector<uint64_t>{1004}, delta.removedParticleIds);
+
+    SimulationDeltaService::get().applyDelta(base, delta);
+    EXPECT_EQ(getCells(content), getCells(base));
+    EXPECT_EQ(getParticles(content), getParticles(base));
+}
+
+TEST_F(DeltaSavepointTests, calcAndApplySettingsDelta)
+{
+    boost::property_tree::ptree base;
+    base.put("simulation parameters.project name", "test");
+    base.put("simulation parameters.radiation.strength", "0.1");
+    base.put("general settings.world size x", "1000");
+
+    auto tree = base;
+    tree.put("simulation parameters.radiation.strength", "0.2");
+    tree.put("simulation parameters.zone.0.name", "zone");
+
+    auto delta = SimulationDeltaService::get().calcDelta(base, tree);
+    EXPECT_FALSE(delta.get_optional<std::string>("simulation parameters.project name").has_value());
+    EXPECT_FALSE(delta.get_child_optional("general settings").has_value());
+    EXPECT_EQ("0.2", delta.get<std::string>("simulation parameters.radiation.strength"));
+    EXPECT_EQ("zone", delta.get<std::string>("simulation parameters.zone.0.name"));
+
+    SimulationDeltaService::get().applyDelta(base, delta);
+    EXPECT_EQ(tree, base);
+}
+
+TEST_F(DeltaSavepointTests, settingsDeltaContainsRemovedKeys)
+{
+    boost::property_tree::ptree base;
+    base.put("simulation parameters.radiation.strength", "0.1");
+    base.put("simulation parameters.zone.0.name", "zone 0");
+    base.put("simulation parameters.zone.1.name", "zone 1");
+
+    auto tree = base;
+    tree.get_child("simulation parameters.zone").erase("1");
+    tree.get_child("simulation parameters").erase("radiation");
+
+    auto delta = SimulationDeltaService::get().calcDelta(base, tree);
+    EXPECT_FALSE(delta.get_child_optional("simulation parameters.zone.0").has_value());
+
+    SimulationDeltaService::get().applyDelta(base, delta);
+    EXPECT_EQ(tree, base);
+}
+
+TEST_F(DeltaSavepointTests, deltaFromDataTO)
+{
+    DescriptionConverter converter{SimulationParameters()};
+    auto convertToTO = [&](ClusteredDataDescription const& data) {
+        DataTO result;
+        result.init(converter.getArraySizes(data));
+        converter.convertDescriptionToTO(result, data);
+        return result;
+    };
+    auto baseTO = convertToTO(createContent(5));
+    auto contentTO = convertToTO(createChangedContent(createContent(5)));
+
+    auto filename = _directory / "delta.sim";
+    DataTOFingerprint fingerprint;
+    {
+        std::ofstream stream(filename, std::ios::binary);
+        fingerprint = DataTOSerializer::serializeDelta(contentTO, DataTOSerializer::calcFingerprint(baseTO), "base.sim", stream);
+    }
+    auto expectedFingerprint = DataTOSerializer::calcFingerprint(contentTO);
+    EXPECT_EQ(expectedFingerprint.cellHashes, fingerprint.cellHashes);
+    EXPECT_EQ(expectedFingerprint.particleHashes, fingerprint.particleHashes);
+
+    SimulationDelta delta;
+    ColumnarSnapshotService::get().deserialize(delta, filename);
+    EXPECT_EQ(std::filesystem::path("base.sim"), delta.baseFilename);
+    EXPECT_EQ(2, getCells(delta.changedContent).size());
+    EXPECT_EQ(2, delta.changedContent.particles.size());
+    EXPECT_EQ(std::vector<uint64_t>{20}, delta.removedCellIds);
+    EXPECT_EQ(std::vector<uint64_t>{1004}, delta.removedParticleIds);
+
+    auto content = converter.convertTOtoClusteredDataDescription(baseTO);
+    SimulationDeltaService::get().applyDelta(content, delta);
+    auto expectedContent = converter.convertTOtoClusteredDataDescription(contentTO);
+    EXPECT_EQ(getCells(expectedContent), getCells(content));
+    EXPECT_EQ(getParticles(expectedContent), getParticles(content));
+
+    baseTO.destroy();
+    contentTO.destroy();
+}
+
+TEST_F(DeltaSavepointTests, loadDeltaChain)
+{
+    auto content1 = createContent(20);
+    auto content2 = createChangedContent(content1);
+    auto content3 = content2;
+    content3.clusters.at(3).cells.at(2).pos = {100.0f, 100.0f};
+
+    auto filename1 = _directory / "savepoint1.sim";
+    auto filename2 = _directory / "savepoint2.sim";
+    auto filename3 = _directory / "savepoint3.sim";
+    ASSERT_TRUE(SerializerService::get().serializeSimulationToFiles(filename1, createSimulation(content1, 100)));
+    ASSERT_TRUE(SerializerService::get().serializeDeltaSimulationToFiles(filename2, filename1, createSimulation(content2, 200)));
+    ASSERT_TRUE(SerializerService::get().serializeDeltaSimulationToFiles(filename3, filename2, createSimulation(content3, 300)));
+
+    EXPECT_EQ(std::filesystem::path("savepoint2.sim"), ColumnarSnapshotService::get().getDeltaBaseFilename(filename3));
+    EXPECT_FALSE(ColumnarSnapshotService::get().getDeltaBaseFilename(filename1).has_value());
+    EXPECT_LT(std::filesystem::file_size(filename3), std::filesystem::file_size(filename1));
+
+    ClusteredDataDescription content;
+    EXPECT_THROW(ColumnarSnapshotService::get().deserialize(content, filename3), std::runtime_error);
+
+    DeserializedSimulation simulation;
+    ASSERT_TRUE(SerializerService::get().deserializeSimulationFromFiles(simulation, filename3));
+    EXPECT_EQ(getCells(content3), getCells(simulation.mainData));
+    EXPECT_EQ(getParticles(content3), getParticles(simulation.mainData));
+    EXPECT_EQ(300, simulation.auxiliaryData.timestep);
+    EXPECT_EQ(3.0f, simulation.auxiliaryData.zoom);
+    EXPECT_EQ(3, simulation.statistics.size());
+
+    ASSERT_TRUE(SerializerService::get().deserializeSimulationFromFiles(simulation, filename2));
+    EXPECT_EQ(getCells(content2), getCells(simulation.mainData));
+    EXPECT_EQ(200, simulation.auxiliaryData.timestep);
+}
+
+TEST_F(DeltaSavepointTests, truncateKeepsBaseSavepoints)
+{
+    auto table = std::get<SavepointTable>(SavepointTableService::get().loadFromFile((_directory / "savepoints.json").string()));
+    SavepointTableService::get().insertEntryAtFront(table, createPersistedEntry("full1", ""));
+    SavepointTableService::get().insertEntryAtFront(table, createPersistedEntry("delta1", "full1"));
+    SavepointTableService::get().insertEntryAtFront(table, createPersistedEntry("delta2", "delta1"));
+    SavepointTableService::get().insertEntryAtFront(table, createPersistedEntry("full2", ""));
+    SavepointTableService::get().insertEntryAtFront(table, createPersistedEntry("delta3", "full2"));
+    EXPECT_EQ(2, SavepointTableService::get().calcNumDeltasSinceFullSavepoint(table, table.at(2)));
+
+    SavepointTableService::get().truncate(table, 3);
+    EXPECT_EQ(3, table.getSize());
+    EXPECT_TRUE(std::filesystem::exists(_directory / "full1.sim"));
+    EXPECT_TRUE(std::filesystem::exists(_directory / "delta1.sim"));
+    EXPECT_EQ(2, SavepointTableService::get().calcNumDeltasSinceFullSavepoint(table, table.at(2)));
+
+    //the table file contains the removed base save points
+    auto loadedTable = std::get<SavepointTable>(SavepointTableService::get().loadFromFile((_directory / "savepoints.json").string()));
+    EXPECT_EQ(2, SavepointTableService::get().calcNumDeltasSinceFullSavepoint(loadedTable, loadedTable.at(2)));
+
+    SavepointTableService::get().truncate(table, 2);
+    EXPECT_FALSE(std::filesystem::exists(_directory / "full1.sim"));
+    EXPECT_FALSE(std::filesystem::exists(_directory / "delta1.sim"));
+    EXPECT_FALSE(std::filesystem::exists(_directory / "delta2.settings.json"));
+    EXPECT_TRUE(std::filesystem::exists(_directory / "full2.sim"));
+}
+
+TEST_F(DeltaSavepointTests, deleteEntryKeepsBaseSavepoints)
+{
+    auto table = std::get<SavepointTable>(SavepointTableService::get().loadFromFile((_directory / "savepoints.json").string()));
+    SavepointTableService::get().insertEntryAtFront(table, createPersistedEntry("full", ""));
+    SavepointTableService::get().insertEntryAtFront(table, createPersistedEntry("delta1", "full"));
+    SavepointTableService::get().insertEntryAtFront(table, createPersistedEntry("delta2", "delta1"));
+
+    auto fullEntry = table.at(2);
+    auto delta1Entry = table.at(1);
+    SavepointTableService::get().deleteEntry(table, fullEntry);
+    SavepointTableService::get().deleteEntry(table, delta1Entry);
+    EXPECT_EQ(1, table.getSize());
+    EXPECT_TRUE(std::filesystem::exists(_directory / "full.sim"));
+    EXPECT_TRUE(std::filesystem::exists(_directory / "delta1.sim"));
+
+    auto delta2Entry = table.at(0);
+    SavepointTableService::get().deleteEntry(table, delta2Entry);
+    EXPECT_TRUE(table.isEmpty());
+    EXPECT_FALSE(std::filesystem::exists(_directory / "full.sim"));
+    EXPECT_FALSE(std::filesystem::exists(_directory / "delta1.sim"));
+    EXPECT_FALSE(std::filesystem::exists(_directory / "delta2.sim"));
+}
@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/DescriptionEditService.h"
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/GenomeDescriptionService.h"
+#include "EngineImpl/DescriptionConverter.h"
+
+class DescriptionConverterTests : public ::testing::Test
+{
+public:
+    DescriptionConverterTests()
+        : _converter(SimulationParameters())
+    {}
+
+    ~DescriptionConverterTests() { _dataTO.destroy(); }
+
+protected:
+    void convertToTO(DataDescription const& data)
+    {
+        _dataTO.init(_converter.getArraySizes(data));
+        _converter.convertDescriptionToTO(_dataTO, data);
+    }
+
+    DataDescription createSyntheticWorld(int numHexagonsPerRow) const
+    {
+        auto hexagon = DescriptionEditService::get().createHex(DescriptionEditService::CreateHexParameters().layers(5).center({5.0f, 5.0f}));
+        auto result = DescriptionEditService::get().gridMultiply(
+            hexagon,
+            DescriptionEditService::GridMultiplyParameters()
+                .horizontalNumber(numHexagonsPerRow)
+                .horizontalDistance(15.0f)
+                .verticalNumber(numHexagonsPerRow)
+                .verticalDistance(15.0f));
+        auto singleCells = DescriptionEditService::get().createUnconnectedCircle(
+            DescriptionEditService::CreateUnconnectedCircleParameters().radius(10.0f).center({-20.0f, -20.0f}));
+        result.add(singleCells);
+        return result;
+    }
+
+    //cluster reconstruction as done before the union-find, serves as reference for the results
+    std::vector<std::set<uint64_t>> getClustersByFloodFill() const
+    {
+        auto cells = _converter.convertTOtoDataDescription(_dataTO).cells;
+
+        std::vector<std::set<uint64_t>> result;
+        std::unordered_set<int> freeCellIndices;
+        for (int i = 0; i < *_dataTO.numCells; ++i) {
+            freeCellIndices.insert(i);
+        }
+        while (!freeCellIndices.empty()) {
+            std::set<uint64_t> cellIds;
+            std::vector<int> currentCellIndices{*freeCellIndices.begin()};
+            freeCellIndices.erase(freeCellIndices.begin());
+            while (!currentCellIndices.empty()) {
+                std::vector<int> nextCellIndices;
+                for (auto const& cellIndex : currentCellIndices) {
+                    cellIds.insert(cells.at(cellIndex).id);
+                    auto const& cellTO = _dataTO.cells[cellIndex];
+                    for (int i = 0; i < cellTO.numConnections; ++i) {
+                        auto otherIndex = cellTO.connections[i].cellIndex;
+                        if (otherIndex != -1 && freeCellIndices.erase(otherIndex) > 0) {
+                            nextCellIndices.emplace_back(otherIndex);
+                        }
+                    }
+                }
+                currentCellIndices = nextCellIndices;
+            }
+            result.emplace_back(cellIds);
+        }
+        return result;
+    }
+
+    std::vector<std::set<uint64_t>> getClusters(ClusteredDataDescription const& data) const
+    {
+        std::vector<std::set<uint64_t>> result;
+        for (auto const& cluster : data.clusters) {
+            std::set<uint64_t> cellIds;
+            for (auto const& cell : cluster.cells) {
+                cellIds.insert(cell.id);
+            }
+            result.emplace_back(cellIds);
+        }
+        return result;
+    }
+
+    DescriptionConverter _converter;
+    DataTO _dataTO;
+};
+
+TEST_F(DescriptionConverterTests, clustersMatchFloodFill)
+{
+    convertToTO(createSyntheticWorld(10));
+
+    auto clusters = getClusters(_converter.convertTOtoClusteredDataDescription(_dataTO));
+    auto expectedClusters = getClustersByFloodFill();
+
+    EXPECT_EQ(expectedClusters.size(), clusters.size());
+    EXPECT_EQ(std::set(expectedClusters.begin(), expectedClusters.end()), std::set(clusters.begin(), clusters.end()));
+}
+
+TEST_F(DescriptionConverterTests, deterministicOrder)
+{
+    convertToTO(createSyntheticWorld(20));
+
+    auto data = _converter.convertTOtoClusteredDataDescription(_dataTO);
+    EXPECT_EQ(data, _converter.convertTOtoClusteredDataDescription(_dataTO));
+
+    //clusters are ordered by their first cell and cells keep their order from the TO
+    std::unordered_map<uint64_t, int> cellIndexByIds;
+    for (int i = 0; i < *_dataTO.numCells; ++i) {
+        cellIndexByIds.emplace(_dataTO.cells[i].id, i);
+    }
+    std::vector<int> firstCellIndices;
+    for (auto const& cluster : data.clusters) {
+        ASSERT_FALSE(cluster.cells.empty());
+        firstCellIndices.emplace_back(cellIndexByIds.at(cluster.cells.front().id));
+        for (int i = 1; i < toInt(cluster.cells.size()); ++i) {
+            EXPECT_LT(cellIndexByIds.at(cluster.cells.at(i - 1).id), cellIndexByIds.at(cluster.cells.at(i).id));
+        }
+    }
+    EXPECT_TRUE(std::is_sorted(firstCellIndices.begin(), firstCellIndices.end()));
+}
+
+TEST_F(DescriptionConverterTests, identicalGenomesShareAuxiliaryData)
+{
+    auto genome = GenomeDescriptionService::get().convertDescriptionToBytes(GenomeDescription().setCells({CellGenomeDescription()}));
+
+    DataDescription data;
+    for (int i = 0; i < 10; ++i) {
+        data.addCell(CellDescription().setId(i + 1).setPos({toFloat(i) * 2, 0}).setCellFunction(ConstructorDescription().setGenome(genome)));
+    }
+    convertToTO(data);
+
+    EXPECT_EQ(genome.size(), *_dataTO.numAuxiliaryData);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(_dataTO.cells[0].cellFunctionData.constructor.genomeDataIndex, _dataTO.cells[i].cellFunctionData.constructor.genomeDataIndex);
+    }
+    for (auto const& cell : _converter.convertTOtoDataDescription(_dataTO).cells) {
+        EXPECT_EQ(genome, std::get<ConstructorDescription>(*cell.cellFunction).genome);
+    }
+}
+
+TEST_F(DescriptionConverterTests, clustersMatchFloodFillInParallelConversion)
+{
+    //the world is large enough for the parallel reconstruction
+    convertToTO(createSyntheticWorld(40));
+
+    auto clusters = getClusters(_converter.convertTOtoClusteredDataDescription(_dataTO));
+    auto expectedClusters = getClustersByFloodFill();
+
+    EXPECT_EQ(expectedClusters.size(), clusters.size());
+    EXPECT_EQ(std::set(expectedClusters.begin(), expectedClusters.end()), std::set(clusters.begin(), clusters.end()));
+}
@@ -0,0 +1,99 @@
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "EngineImpl/EngineCommandQueue.h"
+
+class EngineCommandQueueTests : public ::testing::Test
+{
+public:
+    EngineCommandQueueTests() { _queue.open(); }
+
+protected:
+    EngineCommandQueue _queue;
+};
+
+TEST_F(EngineCommandQueueTests, commandsAreExecutedInOrder)
+{
+    std::vector<int> executedCommands;
+    std::vector<std::future<int>> results;
+    for (int i = 0; i < 10; ++i) {
+        results.emplace_back(_queue.submit([&executedCommands, i] {
+            executedCommands.emplace_back(i);
+            return i * i;
+        }));
+    }
+    EXPECT_TRUE(executedCommands.empty());
+
+    _queue.executePendingCommands();
+
+    ASSERT_EQ(10, executedCommands.size());
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(i, executedCommands.at(i));
+        EXPECT_EQ(i * i, results.at(i).get());
+    }
+    EXPECT_EQ(10, _queue.getAccessStatistics().numRequests);
+}
+
+TEST_F(EngineCommandQueueTests, exceptionIsPassedToCaller)
+{
+    auto result = _queue.submit([]() -> int { throw std::runtime_error("error"); });
+    _queue.executePendingCommands();
+    EXPECT_THROW(result.get(), std::runtime_error);
+}
+
+TEST_F(EngineCommandQueueTests, workerWakesUpOnSubmit)
+{
+    std::atomic<bool> finished = false;
+    std::thread worker([&] {
+        while (!finished) {
+            _queue.waitForCommands();
+            _queue.executePendingCommands();
+        }
+    });
+
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(i, _queue.submit([i] { return i; }).get());
+    }
+    _queue.submit([&] { finished = true; }).wait();
+    worker.join();
+
+    auto accessStatistics = _queue.getAccessStatistics();
+    EXPECT_EQ(101, accessStatistics.numRequests);
+    EXPECT_LE(accessStatistics.getAverageWaitingTime(), accessStatistics.maxWaitingTime);
+}
+
+TEST_F(EngineCommandQueueTests, waitForCommandsReturnsOnWakeUpAndDeadline)
+{
+    auto startTimepoint = std::chrono::steady_clock::now();
+    _queue.waitForCommands(startTimepoint + std::chrono::milliseconds(50));
+    EXPECT_GE(std::chrono::steady_clock::now() - startTimepoint, std::chrono::milliseconds(50));
+
+    std::thread waker([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        _queue.wakeUp();
+    });
+    _queue.waitForCommands();
+    waker.join();
+
+    EXPECT_EQ(2, _queue.getAccessStatistics().numWakeUps);
+}
+
+TEST_F(EngineCommandQueueTests, closedQueueDiscardsCommands)
+{
+    auto pendingResult = _queue.submit([] { return 1; });
+    _queue.close();
+    EXPECT_THROW(pendingResult.get(), std::future_error);
+
+    auto result = _queue.submit([] { return 2; });
+    EXPECT_THROW(result.get(), std::future_error);
+
+    _queue.open();
+    result = _queue.submit([] { return 3; });
+    _queue.executePendingCommands();
+    EXPECT_EQ(3, result.get());
+}
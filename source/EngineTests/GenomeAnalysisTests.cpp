@@ -0,0 +1,221 @@
+#include <set>
+
+#include <gtest/gtest.h>
+
+#include "Base/Definitions.h"
+#include "Base/ThreadPool.h"
+#include "EngineInterface/GenomeAnalysis.h"
+#include "EngineInterface/GenomeDescriptionService.h"
+#include "EngineImpl/DescriptionConverter.h"
+#include "EngineImpl/GenomeBatchAnalyzer.h"
+
+class GenomeAnalysisTests : public ::testing::Test
+{
+protected:
+    class NumberGenerator
+    {
+    public:
+        int random(int maxValue) { return (_state = _state * 1103515245 + 12345) % (maxValue + 1); }
+        bool randomBool() { return random(1) == 0; }
+
+    private:
+        uint32_t _state = 42;
+    };
+
+    //each level contains a constructor and an injector with the next level, the constructor parts are separated on odd levels
+    std::vector<uint8_t> createNestedGenome(int depth, int numRepetitions, bool withSelfCopy = false) const
+    {
+        auto subGenome = GenomeDescriptionService::get().convertDescriptionToBytes(GenomeDescription());
+        for (int level = 0; level < depth; ++level) {
+            std::vector<CellGenomeDescription> nodes;
+            nodes.emplace_back(CellGenomeDescription().setCellFunction(NeuronGenomeDescription()));
+            nodes.emplace_back(CellGenomeDescription().setCellFunction(ConstructorGenomeDescription().setGenome(subGenome)));
+            nodes.emplace_back(CellGenomeDescription().setCellFunction(SensorGenomeDescription()));
+            nodes.emplace_back(CellGenomeDescription().setCellFunction(InjectorGenomeDescription().setGenome(subGenome)));
+            if (withSelfCopy && level == depth - 1) {
+                nodes.emplace_back(CellGenomeDescription().setCellFunction(ConstructorGenomeDescription().setMakeSelfCopy()));
+            }
+            auto header = GenomeHeaderDescription().setNumRepetitions(numRepetitions).setSeparateConstruction(level % 2 == 1).setNumBranches(3);
+            subGenome = GenomeDescriptionService::get().convertDescriptionToBytes(GenomeDescription().setHeader(header).setCells(nodes));
+        }
+        return subGenome;
+    }
+
+    std::vector<uint8_t> createGenomeChain(int depth) const
+    {
+        auto result = GenomeDescriptionService::get().convertDescriptionToBytes(GenomeDescription());
+        for (int level = 0; level < depth; ++level) {
+            auto node = CellGenomeDescription().setCellFunction(ConstructorGenomeDescription().setGenome(result));
+            result = GenomeDescriptionService::get().convertDescriptionToBytes(GenomeDescription().setCells({node}));
+        }
+        return result;
+    }
+
+    //reference implementation by decoding the genomes, the branches and repetitions of the top-level genome are not counted
+    int getNumNodesRecursivelyByDecoding(std::vector<uint8_t> const& data, bool includeRepetitions, bool includeSeparatedParts, int factor = 0) const
+    {
+        auto genome = GenomeDescriptionService::get().convertBytesToDescription(data);
+        if (factor == 0) {
+            factor = genome.header.numRepetitions == std::numeric_limits<int>::max() ? 1 : genome.header.numRepetitions;
+        }
+        auto result = 0;
+        for (auto const& node : genome.cells) {
+            result += includeRepetitions ? factor : 1;
+            if (auto subGenomeData = node.getGenome()) {
+                auto subGenome = GenomeDescriptionService::get().convertBytesToDescription(*subGenomeData);
+                if (includeSeparatedParts || !subGenome.header.separateConstruction) {
+                    auto numRepetitions = subGenome.header.numRepetitions == std::numeric_limits<int>::max() ? 1 : subGenome.header.numRepetitions;
+                    auto subFactor = factor * numRepetitions * subGenome.header.getNumBranches();
+                    result += getNumNodesRecursivelyByDecoding(*subGenomeData, includeRepetitions, includeSeparatedParts, subFactor);
+                }
+            }
+        }
+        return result;
+    }
+
+    int getGenomeDepthByDecoding(std::vector<uint8_t> const& data) const
+    {
+        auto genome = GenomeDescriptionService::get().convertBytesToDescription(data);
+        auto result = 0;
+        for (auto const& node : genome.cells) {
+            if (auto subGenomeData = node.getGenome()) {
+                auto subGenome = GenomeDescriptionService::get().convertBytesToDescription(*subGenomeData);
+                if (!subGenome.cells.empty()) {
+                    result = std::max(result, 1 + getGenomeDepthByDecoding(*subGenomeData));
+                }
+            }
+        }
+        return result;
+    }
+
+    bool containsSelfReplicationByDecoding(std::vector<uint8_t> const& data) const
+    {
+        auto genome = GenomeDescriptionService::get().convertBytesToDescription(data);
+        for (auto const& node : genome.cells) {
+            if (node.getCellFunctionType() == CellFunction_Constructor && std::get<ConstructorGenomeDescription>(*node.cellFunction).isMakeGenomeCopy()) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+TEST_F(GenomeAnalysisTests, nodeAddresses)
+{
+    auto genome = createNestedGenome(3, 1);
+    auto numNodes = GenomeAnalysis::getNumNodes(genome.data(), toInt(genome.size()));
+    EXPECT_EQ(GenomeDescriptionService::get().convertBytesToDescription(genome).cells.size(), numNodes);
+    for (int nodeIndex = 0; nodeIndex <= numNodes; ++nodeIndex) {
+        EXPECT_EQ(
+            GenomeDescriptionService::get().convertNodeIndexToNodeAddress(genome, nodeIndex),
+            GenomeAnalysis::getNodeAddress(genome.data(), toInt(genome.size()), nodeIndex));
+    }
+}
+
+TEST_F(GenomeAnalysisTests, numNodesRecursively)
+{
+    for (auto numRepetitions : {1, 2, std::numeric_limits<int>::max()}) {
+        auto genome = createNestedGenome(4, numRepetitions);
+        for (auto includeRepetitions : {false, true}) {
+            for (auto includeSeparatedParts : {false, true}) {
+                EXPECT_EQ(
+                    getNumNodesRecursivelyByDecoding(genome, includeRepetitions, includeSeparatedParts),
+                    GenomeAnalysis::getNumNodesRecursively(genome.data(), toInt(genome.size()), includeRepetitions, includeSeparatedParts));
+            }
+        }
+    }
+}
+
+TEST_F(GenomeAnalysisTests, genomeDepth)
+{
+    for (int depth = 1; depth <= 5; ++depth) {
+        auto genome = createNestedGenome(depth, 1);
+        EXPECT_EQ(getGenomeDepthByDecoding(genome), GenomeAnalysis::getGenomeDepth(genome.data(), toInt(genome.size())));
+    }
+}
+
+TEST_F(GenomeAnalysisTests, genomeDepth_beyondMaxRecursionDepth)
+{
+    auto genome = createGenomeChain(GenomeAnalysis::MAX_SUBGENOME_RECURSION_DEPTH + 5);
+    EXPECT_EQ(GenomeAnalysis::MAX_SUBGENOME_RECURSION_DEPTH, GenomeAnalysis::getGenomeDepth(genome.data(), toInt(genome.size())));
+}
+
+TEST_F(GenomeAnalysisTests, selfReplication)
+{
+    for (auto withSelfCopy : {false, true}) {
+        auto genome = createNestedGenome(2, 1, withSelfCopy);
+        EXPECT_EQ(containsSelfReplicationByDecoding(genome), GenomeAnalysis::containsSelfReplication(genome.data(), toInt(genome.size())));
+    }
+}
+
+TEST_F(GenomeAnalysisTests, randomGenomeNodeAddress)
+{
+    auto genome = createNestedGenome(3, 1);
+    std::set<int> nodeAddresses;
+    GenomeAnalysis::executeForEachNodeRecursively(
+        genome.data(), toInt(genome.size()), true, false, [&](int depth, int nodeAddress, int repetitions) { nodeAddresses.insert(nodeAddress); });
+    EXPECT_EQ(getNumNodesRecursivelyByDecoding(genome, false, true), nodeAddresses.size());
+
+    NumberGenerator numberGenerator;
+    for (int refIndex = 1; refIndex < toInt(genome.size()); ++refIndex) {
+        int subGenomesSizeIndices[GenomeAnalysis::MAX_SUBGENOME_RECURSION_DEPTH];
+        int numSubGenomesSizeIndices;
+        auto nodeAddress = GenomeAnalysis::getRandomGenomeNodeAddress(
+            numberGenerator, genome.data(), toInt(genome.size()), false, subGenomesSizeIndices, &numSubGenomesSizeIndices, refIndex);
+        EXPECT_TRUE(nodeAddresses.contains(nodeAddress));
+        for (int i = 0; i < numSubGenomesSizeIndices; ++i) {
+            EXPECT_LT(subGenomesSizeIndices[i], nodeAddress);
+        }
+    }
+}
+
+TEST_F(GenomeAnalysisTests, batchAnalysis)
+{
+    auto genome1 = createNestedGenome(2, 1, true);
+    auto genome2 = createNestedGenome(3, 2);
+    DataDescription data;
+    for (int i = 0; i < 100; ++i) {
+        auto position = RealVector2D{toFloat(i), 0};
+        switch (i % 3) {
+        case 0:
+            data.addCell(CellDescription().setId(i + 1).setPos(position).setCellFunction(ConstructorDescription().setGenome(genome1).setGenomeGeneration(i)));
+            break;
+        case 1:
+            data.addCell(CellDescription().setId(i + 1).setPos(position).setCellFunction(InjectorDescription().setGenome(genome2)));
+            break;
+        default:
+            data.addCell(CellDescription().setId(i + 1).setPos(position).setCellFunction(NerveDescription()));
+            break;
+        }
+    }
+    DescriptionConverter converter{SimulationParameters()};
+    DataTO dataTO;
+    dataTO.init(converter.getArraySizes(data));
+    converter.convertDescriptionToTO(dataTO, data);
+
+    ThreadPool threadPool(4);
+    auto results = GenomeBatchAnalyzer::analyze(dataTO, threadPool);
+    dataTO.destroy();
+
+    ASSERT_EQ(67, results.size());
+    auto expectedResult1 = GenomeBatchAnalyzer::analyze(genome1);
+    auto expectedResult2 = GenomeBatchAnalyzer::analyze(genome2);
+    EXPECT_TRUE(expectedResult1.selfReplicating);
+    EXPECT_FALSE(expectedResult2.selfReplicating);
+    EXPECT_EQ(getNumNodesRecursivelyByDecoding(genome2, true, true), expectedResult2.numNodesRecursivelyWithRepetitions);
+    EXPECT_EQ(getGenomeDepthByDecoding(genome2), expectedResult2.genomeDepth);
+    for (auto const& result : results) {
+        auto index = toInt(result.cellId) - 1;
+        auto expectedResult = index % 3 == 0 ? expectedResult1 : expectedResult2;
+        expectedResult.cellId = result.cellId;
+        expectedResult.cellFunction = index % 3 == 0 ? CellFunction_Constructor : CellFunction_Injector;
+        expectedResult.genomeGeneration = index % 3 == 0 ? index : 0;
+        EXPECT_EQ(expectedResult, result);
+    }
+
+    auto spanResults = GenomeBatchAnalyzer::analyze({std::span<uint8_t const>(genome1), std::span<uint8_t const>(genome2)}, threadPool);
+    ASSERT_EQ(2, spanResults.size());
+    EXPECT_EQ(expectedResult1.numNodesRecursively, spanResults.at(0).numNodesRecursively);
+    EXPECT_EQ(1, spanResults.at(1).cellId);
+    EXPECT_EQ(expectedResult2.genomeDepth, spanResults.at(1).genomeDepth);
+}
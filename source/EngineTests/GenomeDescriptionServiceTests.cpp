@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include "Base/Definitions.h"
+#include "EngineInterface/GenomeDescriptionService.h"
+
+class GenomeDescriptionServiceTests : public ::testing::Test
+{
+protected:
+    //each level consists of a neuron, a constructor with the next level, a nerve and an injector with a copy of the next level
+    std::vector<uint8_t> createNestedGenome(int depth, int numRepetitions) const
+    {
+        std::vector<uint8_t> subGenome;
+        for (int level = 0; level < depth; ++level) {
+            std::vector<CellGenomeDescription> nodes;
+            nodes.emplace_back(CellGenomeDescription().setCellFunction(NeuronGenomeDescription()));
+            nodes.emplace_back(CellGenomeDescription().setCellFunction(ConstructorGenomeDescription().setGenome(subGenome)));
+            nodes.emplace_back(CellGenomeDescription().setCellFunction(NerveGenomeDescription()));
+            nodes.emplace_back(CellGenomeDescription().setCellFunction(InjectorGenomeDescription().setGenome(subGenome)));
+            auto header = GenomeHeaderDescription().setNumRepetitions(numRepetitions).setSeparateConstruction(false).setNumBranches(2);
+            subGenome = GenomeDescriptionService::get().convertDescriptionToBytes(GenomeDescription().setHeader(header).setCells(nodes));
+        }
+        return subGenome;
+    }
+
+    //reference implementation by decoding the genomes
+    int getNumNodesRecursivelyByDecoding(std::vector<uint8_t> const& data, bool includeRepetitions) const
+    {
+        auto genome = GenomeDescriptionService::get().convertBytesToDescription(data);
+        auto result = toInt(genome.cells.size());
+        for (auto const& node : genome.cells) {
+            if (auto subGenome = node.getGenome()) {
+                result += getNumNodesRecursivelyByDecoding(*subGenome, includeRepetitions);
+            }
+        }
+        auto numRepetitions = genome.header.numRepetitions == std::numeric_limits<int>::max() ? 1 : genome.header.numRepetitions;
+        return includeRepetitions ? result * numRepetitions * genome.header.getNumBranches() : result;
+    }
+
+    void checkNodeAddresses(std::vector<uint8_t> const& data) const
+    {
+        auto numNodes = toInt(GenomeDescriptionService::get().convertBytesToDescription(data).cells.size());
+        for (int nodeIndex = 0; nodeIndex < numNodes; ++nodeIndex) {
+            auto nodeAddress = GenomeDescriptionService::get().convertNodeIndexToNodeAddress(data, nodeIndex);
+            EXPECT_EQ(nodeIndex, GenomeDescriptionService::get().convertNodeAddressToNodeIndex(data, nodeAddress));
+
+            //the node address ends the preceding nodes
+            auto precedingData = std::span<uint8_t const>(data).first(nodeAddress);
+            EXPECT_EQ(nodeIndex, GenomeDescriptionService::get().convertBytesToDescription(precedingData).cells.size());
+        }
+        EXPECT_EQ(toInt(data.size()), GenomeDescriptionService::get().convertNodeIndexToNodeAddress(data, numNodes));
+        EXPECT_EQ(numNodes, GenomeDescriptionService::get().convertNodeAddressToNodeIndex(data, toInt(data.size())));
+    }
+};
+
+TEST_F(GenomeDescriptionServiceTests, nodeAddresses)
+{
+    checkNodeAddresses(createNestedGenome(4, 1));
+}
+
+TEST_F(GenomeDescriptionServiceTests, numNodesRecursively)
+{
+    for (auto numRepetitions : {1, 3, std::numeric_limits<int>::max()}) {
+        auto genome = createNestedGenome(5, numRepetitions);
+        EXPECT_EQ(getNumNodesRecursivelyByDecoding(genome, false), GenomeDescriptionService::get().getNumNodesRecursively(genome, false));
+        EXPECT_EQ(getNumNodesRecursivelyByDecoding(genome, true), GenomeDescriptionService::get().getNumNodesRecursively(genome, true));
+    }
+}
+
+TEST_F(GenomeDescriptionServiceTests, truncatedGenomes)
+{
+    auto genome = createNestedGenome(3, 2);
+    for (size_t size = 0; size < genome.size(); size += 7) {
+        std::vector<uint8_t> truncatedGenome(genome.begin(), genome.begin() + size);
+        checkNodeAddresses(truncatedGenome);
+        EXPECT_EQ(getNumNodesRecursivelyByDecoding(truncatedGenome, false), GenomeDescriptionService::get().getNumNodesRecursively(truncatedGenome, false));
+        EXPECT_EQ(getNumNodesRecursivelyByDecoding(truncatedGenome, true), GenomeDescriptionService::get().getNumNodesRecursively(truncatedGenome, true));
+    }
+}
+
+TEST_F(GenomeDescriptionServiceTests, encodingSpecification)
+{
+    auto spec = GenomeEncodingSpecification().numRepetitions(false).concatenationAngle1(false).concatenationAngle2(false);
+    auto genome = GenomeDescriptionService::get().convertDescriptionToBytes(
+        GenomeDescription().setCells({CellGenomeDescription(), CellGenomeDescription().setCellFunction(NerveGenomeDescription())}), spec);
+
+    EXPECT_EQ(6, GenomeDescriptionService::get().convertNodeIndexToNodeAddress(genome, 0, spec));
+    EXPECT_EQ(2, GenomeDescriptionService::get().getNumNodesRecursively(genome, false, spec));
+    EXPECT_NE(
+        GenomeDescriptionService::get().createNodeIndex(genome, spec)->nodeAddresses,
+        GenomeDescriptionService::get().createNodeIndex(genome)->nodeAddresses);
+}
+
+TEST_F(GenomeDescriptionServiceTests, queriesOnNodeIndex)
+{
+    auto genome = createNestedGenome(3, 2);
+    auto nodeIndex = GenomeDescriptionService::get().createNodeIndex(genome);
+
+    auto numNodes = GenomeDescriptionService::get().convertNodeAddressToNodeIndex(genome, toInt(genome.size()));
+    EXPECT_EQ(numNodes, GenomeDescriptionService::get().convertNodeAddressToNodeIndex(nodeIndex, toInt(genome.size())));
+    for (int index = -1; index <= numNodes; ++index) {
+        auto nodeAddress = GenomeDescriptionService::get().convertNodeIndexToNodeAddress(genome, index);
+        EXPECT_EQ(nodeAddress, GenomeDescriptionService::get().convertNodeIndexToNodeAddress(nodeIndex, index));
+        EXPECT_EQ(
+            GenomeDescriptionService::get().convertNodeAddressToNodeIndex(genome, nodeAddress),
+            GenomeDescriptionService::get().convertNodeAddressToNodeIndex(nodeIndex, nodeAddress));
+    }
+    EXPECT_EQ(GenomeDescriptionService::get().getNumNodesRecursively(genome, false), GenomeDescriptionService::get().getNumNodesRecursively(nodeIndex, false));
+    EXPECT_EQ(GenomeDescriptionService::get().getNumNodesRecursively(genome, true), GenomeDescriptionService::get().getNumNodesRecursively(nodeIndex, true));
+}
@@ -6,9 +6,13 @@
 #include "EngineInterface/SimulationParameters.h"
 #include "EngineImpl/SimulationFacadeImpl.h"
 
-IntegrationTestFramework::IntegrationTestFramework(std::optional<SimulationParameters> const& parameters_, IntVector2D const& universeSize)
+IntegrationTestFramework::IntegrationTestFramework(
+    std::optional<SimulationParameters> const& parameters_,
+    IntVector2D const& universeSize,
+    BackendSettings const& backendSettings)
 {
     _simulationFacade = std::make_shared<_SimulationFacadeImpl>();
+    _simulationFacade->setBackendSettings(backendSettings);
     GeneralSettings generalSettings{universeSize.x, universeSize.y};
     SimulationParameters parameters;
     if (parameters_) {
@@ -3,6 +3,7 @@
 #include <gtest/gtest.h>
 
 #include "Base/Definitions.h"
+#include "EngineInterface/BackendSettings.h"
 #include "EngineInterface/Definitions.h"
 #include "EngineInterface/Descriptions.h"
 #include "EngineInterface/SimulationParameters.h"
@@ -10,7 +11,10 @@
 class IntegrationTestFramework : public ::testing::Test
 {
 public:
-    IntegrationTestFramework(std::optional<SimulationParameters> const& parameters = std::nullopt, IntVector2D const& universeSize = IntVector2D{1000, 1000});
+    IntegrationTestFramework(
+        std::optional<SimulationParameters> const& parameters = std::nullopt,
+        IntVector2D const& universeSize = IntVector2D{1000, 1000},
+        BackendSettings const& backendSettings = BackendSettings());
     virtual ~IntegrationTestFramework();
 
 protected:
@@ -0,0 +1,156 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Base/FileLogger.h"
+#include "Base/LoggingService.h"
+#include "Base/MpscRingBuffer.h"
+
+class LoggingServiceTests : public ::testing::Test
+{
+public:
+    LoggingServiceTests()
+        : _logDirectory(std::filesystem::temp_directory_path() / "alien_logging_test")
+    {
+        std::filesystem::create_directories(_logDirectory);
+    }
+
+    ~LoggingServiceTests() { std::filesystem::remove_all(_logDirectory); }
+
+protected:
+    class MessageCollector : public LoggingCallBack
+    {
+    public:
+        MessageCollector() { LoggingService::get().registerCallBack(this); }
+        ~MessageCollector() override { LoggingService::get().unregisterCallBack(this); }
+
+        void newLogMessage(Priority priority, std::string const& message) override { _messages.emplace_back(message); }
+        void flush() override { ++_numFlushes; }
+
+        std::vector<std::string> _messages;
+        int _numFlushes = 0;
+    };
+
+    std::vector<std::string> readLines(std::filesystem::path const& filename) const
+    {
+        std::vector<std::string> result;
+        std::ifstream stream(filename);
+        std::string line;
+        while (std::getline(stream, line)) {
+            result.emplace_back(line);
+        }
+        return result;
+    }
+
+    std::filesystem::path _logDirectory;
+};
+
+TEST_F(LoggingServiceTests, ringBuffer_multipleProducers)
+{
+    auto constexpr NumProducers = 4;
+    auto constexpr NumValuesPerProducer = 10000;
+
+    MpscRingBuffer<int> buffer(1000);
+    EXPECT_EQ(1024, buffer.getCapacity());
+
+    std::vector<std::thread> producers;
+    for (int i = 0; i < NumProducers; ++i) {
+        producers.emplace_back([&buffer, i] {
+            for (int j = 0; j < NumValuesPerProducer; ++j) {
+                auto value = i * NumValuesPerProducer + j;
+                while (!buffer.tryPush(std::move(value))) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::vector<int> lastValueByProducer(NumProducers, -1);
+    int numValues = 0;
+    while (numValues < NumProducers * NumValuesPerProducer) {
+        if (auto value = buffer.tryPop()) {
+            auto producer = *value / NumValuesPerProducer;
+            EXPECT_LT(lastValueByProducer.at(producer), *value);
+            lastValueByProducer.at(producer) = *value;
+            ++numValues;
+        }
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    EXPECT_FALSE(buffer.tryPop().has_value());
+}
+
+TEST_F(LoggingServiceTests, ringBuffer_full)
+{
+    MpscRingBuffer<std::string> buffer(2);
+    EXPECT_TRUE(buffer.tryPush("a"));
+    EXPECT_TRUE(buffer.tryPush("b"));
+    EXPECT_FALSE(buffer.tryPush("c"));
+    EXPECT_EQ("a", buffer.tryPop());
+    EXPECT_TRUE(buffer.tryPush("d"));
+    EXPECT_EQ("b", buffer.tryPop());
+    EXPECT_EQ("d", buffer.tryPop());
+    EXPECT_FALSE(buffer.tryPop().has_value());
+}
+
+TEST_F(LoggingServiceTests, messagesFromMultipleThreads)
+{
+    MessageCollector collector;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([i] {
+            for (int j = 0; j < 1000; ++j) {
+                log(Priority::Unimportant, "thread " + std::to_string(i) + " message " + std::to_string(j));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    LoggingService::get().flush();
+
+    auto numDroppedMessages = LoggingService::get().getNumDroppedMessages();
+    auto numMessages = std::count_if(
+        collector._messages.begin(), collector._messages.end(), [](auto const& message) { return message.find("thread ") != std::string::npos; });
+    EXPECT_EQ(4000, numMessages + numDroppedMessages);
+    EXPECT_GT(collector._numFlushes, 0);
+    EXPECT_TRUE(collector._messages.back().ends_with("message 999") || numDroppedMessages > 0);
+}
+
+TEST_F(LoggingServiceTests, fileRotation)
+{
+    auto filename = _logDirectory / "log.txt";
+    {
+        _FileLogger fileLogger(filename, 1000, 2);
+        for (int i = 0; i < 100; ++i) {
+            log(Priority::Important, "message " + std::to_string(i));
+        }
+    }
+
+    auto lines = readLines(filename);
+    ASSERT_FALSE(lines.empty());
+    EXPECT_TRUE(lines.back().ends_with(": message 99"));
+    EXPECT_LE(std::filesystem::file_size(filename), 1000);
+    EXPECT_LE(std::filesystem::file_size(_logDirectory / "log.1.txt"), 1000);
+    EXPECT_LE(std::filesystem::file_size(_logDirectory / "log.2.txt"), 1000);
+    EXPECT_FALSE(std::filesystem::exists(_logDirectory / "log.3.txt"));
+
+    auto rotatedLines = readLines(_logDirectory / "log.1.txt");
+    ASSERT_FALSE(rotatedLines.empty());
+    auto lastRotatedMessageIndex = std::stoi(rotatedLines.back().substr(rotatedLines.back().rfind(' ') + 1));
+    auto firstMessageIndex = std::stoi(lines.front().substr(lines.front().rfind(' ') + 1));
+    EXPECT_EQ(lastRotatedMessageIndex + 1, firstMessageIndex);
+
+    {
+        _FileLogger fileLogger(filename, 1000, 2);
+    }
+    EXPECT_EQ(0, std::filesystem::file_size(filename));
+    EXPECT_FALSE(std::filesystem::exists(_logDirectory / "log.1.txt"));
+}
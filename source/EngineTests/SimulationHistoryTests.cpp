@@ -0,0 +1,180 @@
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/Descriptions.h"
+#include "PersisterInterface/SimulationHistory.h"
+
+class SimulationHistoryTests : public ::testing::Test
+{
+protected:
+    ClusteredDataDescription createContent(int numClusters) const
+    {
+        ClusteredDataDescription result;
+        for (int i = 0; i < numClusters; ++i) {
+            ClusterDescription cluster;
+            for (int j = 0; j < 10; ++j) {
+                auto id = toInt(i * 10 + j + 1);
+                CellDescription cell;
+                cell.setId(id).setPos({toFloat(j), toFloat(i) * 3}).setEnergy(100.0f).setColor(j % MAX_COLORS);
+                if (j > 0) {
+                    cell.connections.emplace_back(ConnectionDescription().setCellId(id - 1).setDistance(1.0f).setAngleFromPrevious(360.0f));
+                }
+                cluster.addCell(cell);
+            }
+            result.addCluster(cluster);
+            result.addParticle(ParticleDescription().setId(100000 + i).setPos({toFloat(i), -5.0f}).setEnergy(toFloat(i)));
+        }
+        return result;
+    }
+
+    //moves one cell, removes one particle and adds one cell per time step
+    SimulationHistoryEntry createEntry(ClusteredDataDescription const& initialContent, int timestep) const
+    {
+        SimulationHistoryEntry result;
+        result.timestep = timestep;
+        result.realTime = std::chrono::milliseconds(timestep * 10);
+        result.parameters.externalEnergy = toFloat(timestep / 4);
+        result.data = initialContent;
+        for (int i = 0; i < timestep; ++i) {
+            auto& cell = result.data.clusters.at(i % initialContent.clusters.size()).cells.at(i % 10);
+            cell.pos.x += 0.5f;
+            if (!result.data.particles.empty()) {
+                result.data.particles.pop_back();
+            }
+            result.data.addCluster(ClusterDescription().addCell(CellDescription().setId(200000 + i).setPos({-10.0f, toFloat(i)})));
+        }
+        return result;
+    }
+
+    std::vector<CellDescription> getCells(ClusteredDataDescription const& content) const
+    {
+        std::vector<CellDescription> result;
+        for (auto const& cluster : content.clusters) {
+            result.insert(result.end(), cluster.cells.begin(), cluster.cells.end());
+        }
+        std::ranges::sort(result, [](auto const& cell1, auto const& cell2) { return cell1.id < cell2.id; });
+        return result;
+    }
+
+    std::vector<ParticleDescription> getParticles(ClusteredDataDescription const& content) const
+    {
+        auto result = content.particles;
+        std::ranges::sort(result, [](auto const& particle1, auto const& particle2) { return particle1.id < particle2.id; });
+        return result;
+    }
+
+    void checkEntry(SimulationHistoryEntry const& expected, SimulationHistoryEntry const& actual) const
+    {
+        EXPECT_EQ(expected.timestep, actual.timestep);
+        EXPECT_EQ(expected.realTime, actual.realTime);
+        EXPECT_EQ(expected.parameters, actual.parameters);
+        EXPECT_EQ(getCells(expected.data), getCells(actual.data));
+        EXPECT_EQ(getParticles(expected.data), getParticles(actual.data));
+    }
+};
+
+TEST_F(SimulationHistoryTests, pushAndPop)
+{
+    auto content = createContent(20);
+    auto numTimesteps = SimulationHistory::KeyframeInterval * 2 + 3;
+
+    SimulationHistory history(1ull << 30);
+    for (int i = 0; i < numTimesteps; ++i) {
+        history.push(createEntry(content, i));
+    }
+    EXPECT_EQ(numTimesteps, history.getSize());
+    EXPECT_GT(history.getMemoryUsage(), 0);
+
+    for (int i = numTimesteps - 1; i >= 0; --i) {
+        checkEntry(createEntry(content, i), history.pop());
+    }
+    EXPECT_TRUE(history.isEmpty());
+    EXPECT_EQ(0, history.getMemoryUsage());
+}
+
+TEST_F(SimulationHistoryTests, pushAfterPop)
+{
+    auto content = createContent(20);
+
+    SimulationHistory history(1ull << 30);
+    for (int i = 0; i < 10; ++i) {
+        history.push(createEntry(content, i));
+    }
+    for (int i = 0; i < 5; ++i) {
+        history.pop();
+    }
+    for (int i = 5; i < 20; ++i) {
+        history.push(createEntry(content, i));
+    }
+    for (int i = 19; i >= 0; --i) {
+        checkEntry(createEntry(content, i), history.pop());
+    }
+}
+
+TEST_F(SimulationHistoryTests, deltasAreSmallerThanKeyframes)
+{
+    auto content = createContent(100);
+
+    SimulationHistory history(1ull << 30);
+    history.push(createEntry(content, 0));
+    auto keyframeUsage = history.getMemoryUsage();
+    history.push(createEntry(content, 1));
+    EXPECT_LT((history.getMemoryUsage() - keyframeUsage) * 10, keyframeUsage);
+}
+
+TEST_F(SimulationHistoryTests, evictOldestEntries)
+{
+    auto content = createContent(50);
+
+    SimulationHistory history(1ull << 30);
+    history.push(createEntry(content, 0));
+    auto budget = history.getMemoryUsage() * 3;
+    history.setMemoryBudget(budget);
+
+    auto numTimesteps = SimulationHistory::KeyframeInterval * 3;
+    for (int i = 1; i < numTimesteps; ++i) {
+        history.push(createEntry(content, i));
+        EXPECT_LE(history.getMemoryUsage(), budget);
+    }
+    EXPECT_LT(history.getSize(), numTimesteps);
+    EXPECT_GT(history.getSize(), 1);
+
+    auto size = history.getSize();
+    for (int i = 0; i < size; ++i) {
+        checkEntry(createEntry(content, numTimesteps - 1 - i), history.pop());
+    }
+    EXPECT_TRUE(history.isEmpty());
+}
+
+TEST_F(SimulationHistoryTests, mostRecentEntryIsKept)
+{
+    auto content = createContent(10);
+
+    SimulationHistory history(0);
+    history.push(createEntry(content, 0));
+    history.push(createEntry(content, 1));
+    EXPECT_EQ(1, history.getSize());
+    checkEntry(createEntry(content, 1), history.pop());
+}
+
+TEST_F(SimulationHistoryTests, changedParametersAreStoredAsPatches)
+{
+    auto content = createContent(10);
+
+    SimulationHistory history(1ull << 30);
+    auto entry = createEntry(content, 0);
+    entry.parameters.numZones = 1;
+    history.push(entry);
+    auto keyframeUsage = history.getMemoryUsage();
+
+    entry.timestep = 1;
+    entry.parameters.zone[0].values.friction = 0.5f;
+    entry.parameters.innerFriction = 0.7f;
+    history.push(entry);
+    EXPECT_LT((history.getMemoryUsage() - keyframeUsage) * 10, sizeof(SimulationParameters));
+
+    auto poppedEntry = history.pop();
+    checkEntry(entry, poppedEntry);
+    EXPECT_EQ(0.7f, poppedEntry.parameters.innerFriction);
+}
@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "Base/StringHelper.h"
+#include "PersisterInterface/SimulationParametersPatchService.h"
+
+class SimulationParametersPatchTests : public ::testing::Test
+{
+protected:
+    SimulationParameters createParameters() const
+    {
+        SimulationParameters result;
+        StringHelper::copy(result.projectName, sizeof(result.projectName), "Patch test");
+        result.numZones = 3;
+        for (int i = 0; i < result.numZones; ++i) {
+            auto& zone = result.zone[i];
+            StringHelper::copy(zone.name, sizeof(zone.name), "Zone " + std::to_string(i + 1));
+            zone.posX = toFloat(i) * 50.0f;
+            zone.activatedValues.friction = true;
+            zone.values.friction = 0.1f * toFloat(i);
+        }
+        result.numRadiationSources = 1;
+        result.radiationSource[0].strength = 0.5f;
+        return result;
+    }
+
+    bool contains(std::vector<std::string> const& paths, std::string const& path) const { return std::ranges::find(paths, path) != paths.end(); }
+};
+
+TEST_F(SimulationParametersPatchTests, equalParameters)
+{
+    auto parameters = createParameters();
+    EXPECT_TRUE(SimulationParametersPatchService::get().calcPatch(parameters, parameters).isEmpty());
+    EXPECT_TRUE(SimulationParametersPatchService::get().calcChangedPaths(parameters, parameters).empty());
+
+    auto patchedParameters = parameters;
+    EXPECT_TRUE(SimulationParametersPatchService::get().applyPatch(patchedParameters, SimulationParametersPatch()));
+    EXPECT_EQ(parameters, patchedParameters);
+}
+
+TEST_F(SimulationParametersPatchTests, changedPaths)
+{
+    auto base = createParameters();
+    auto parameters = base;
+    parameters.baseValues.friction = 0.2f;
+    parameters.baseValues.cellFunctionAttackerFoodChainColorMatrix[1][3] = -0.5f;
+    parameters.zone[1].activatedValues.friction = false;
+
+    auto paths = SimulationParametersPatchService::get().calcChangedPaths(base, parameters);
+    EXPECT_EQ(3, paths.size());
+    EXPECT_TRUE(contains(paths, "simulation parameters.friction"));
+    EXPECT_TRUE(contains(paths, "simulation parameters.cell.function.attacker.food chain color matrix[1, 3]"));
+    EXPECT_TRUE(contains(paths, "simulation parameters.spots.1.friction.activated"));
+}
+
+TEST_F(SimulationParametersPatchTests, patchIsSmall)
+{
+    auto base = createParameters();
+    auto parameters = base;
+    parameters.baseValues.friction = 0.2f;
+
+    auto patch = SimulationParametersPatchService::get().calcPatch(base, parameters);
+    EXPECT_LT(patch.data.size(), 100);
+    EXPECT_TRUE(SimulationParametersPatchService::get().applyPatch(base, patch));
+    EXPECT_EQ(parameters, base);
+}
+
+TEST_F(SimulationParametersPatchTests, addAndRemoveZones)
+{
+    auto base = createParameters();
+    auto parameters = base;
+    parameters.numZones = 5;
+    for (int i = 3; i < parameters.numZones; ++i) {
+        parameters.zone[i].shapeType = SpotShapeType_Rectangular;
+        parameters.zone[i].shapeData.rectangularSpot.width = 20.0f;
+        parameters.zone[i].values.friction = 0.3f;
+    }
+    parameters.zone[0].shapeType = SpotShapeType_Rectangular;
+    parameters.zone[0].shapeData.rectangularSpot.height = 40.0f;
+    parameters.motionType = MotionType_Collision;
+    parameters.motionData.collisionMotion.cellMaxCollisionDistance = 1.5f;
+
+    auto patchedParameters = base;
+    EXPECT_TRUE(SimulationParametersPatchService::get().applyPatch(patchedParameters, SimulationParametersPatchService::get().calcPatch(base, parameters)));
+    EXPECT_EQ(parameters, patchedParameters);
+
+    EXPECT_TRUE(SimulationParametersPatchService::get().applyPatch(patchedParameters, SimulationParametersPatchService::get().calcPatch(parameters, base)));
+    EXPECT_EQ(base, patchedParameters);
+}
+
+TEST_F(SimulationParametersPatchTests, runtimeParameters)
+{
+    auto base = createParameters();
+    auto parameters = base;
+    parameters.innerFriction = 0.7f;
+    parameters.cellFunctionInjectorSignalThreshold = 0.3f;
+
+    auto patch = SimulationParametersPatchService::get().calcPatch(base, parameters);
+    EXPECT_FALSE(patch.isEmpty());
+    EXPECT_TRUE(SimulationParametersPatchService::get().applyPatch(base, patch));
+    EXPECT_EQ(0.7f, base.innerFriction);
+    EXPECT_EQ(0.3f, base.cellFunctionInjectorSignalThreshold);
+}
+
+TEST_F(SimulationParametersPatchTests, patchOfOtherFields)
+{
+    auto base = createParameters();
+    auto parameters = base;
+    parameters.zone[2].values.friction = 0.9f;
+    auto patch = SimulationParametersPatchService::get().calcPatch(base, parameters);
+
+    auto otherParameters = base;
+    otherParameters.numZones = 2;
+    auto expectedParameters = otherParameters;
+    EXPECT_FALSE(SimulationParametersPatchService::get().applyPatch(otherParameters, patch));
+    EXPECT_EQ(expectedParameters, otherParameters);
+}
+
+TEST_F(SimulationParametersPatchTests, corruptedPatch)
+{
+    auto base = createParameters();
+    auto parameters = base;
+    parameters.baseValues.friction = 0.2f;
+    parameters.projectName[0] = 'X';
+    auto patch = SimulationParametersPatchService::get().calcPatch(base, parameters);
+
+    for (auto size : {size_t(1), patch.data.size() / 2, patch.data.size() - 1}) {
+        SimulationParametersPatch truncatedPatch{std::vector<uint8_t>(patch.data.begin(), patch.data.begin() + size)};
+        EXPECT_THROW(SimulationParametersPatchService::get().applyPatch(base, truncatedPatch), std::runtime_error);
+    }
+}
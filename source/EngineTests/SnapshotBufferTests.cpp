@@ -0,0 +1,88 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Base/Definitions.h"
+#include "Base/SnapshotBuffer.h"
+
+class SnapshotBufferTests : public ::testing::Test
+{
+public:
+    SnapshotBufferTests() = default;
+    ~SnapshotBufferTests() = default;
+};
+
+TEST_F(SnapshotBufferTests, initialSnapshot)
+{
+    SnapshotBuffer<std::vector<int>> buffer;
+
+    EXPECT_TRUE(buffer.getLatest()->empty());
+    EXPECT_EQ(0, buffer.getVersion());
+}
+
+TEST_F(SnapshotBufferTests, publish)
+{
+    SnapshotBuffer<std::vector<int>> buffer;
+
+    for (int i = 1; i <= 5; ++i) {
+        buffer.publish(std::vector<int>(i, i));
+
+        EXPECT_EQ(std::vector<int>(i, i), *buffer.getLatest());
+        EXPECT_EQ(i, buffer.getVersion());
+    }
+}
+
+TEST_F(SnapshotBufferTests, heldSnapshotIsNotOverwritten)
+{
+    SnapshotBuffer<std::vector<int>> buffer;
+    buffer.publish({1, 2, 3});
+    auto snapshot = buffer.getLatest();
+
+    buffer.publish({4, 5});
+    buffer.publish({6});
+    buffer.publish({7, 8, 9, 10});
+
+    EXPECT_EQ((std::vector<int>{1, 2, 3}), *snapshot);
+    EXPECT_EQ((std::vector<int>{7, 8, 9, 10}), *buffer.getLatest());
+}
+
+TEST_F(SnapshotBufferTests, concurrentReadersSeeConsistentSnapshots)
+{
+    SnapshotBuffer<std::vector<int>> buffer;
+    std::atomic<bool> finished{false};
+    std::atomic<int> numInconsistentSnapshots{0};
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 3; ++i) {
+        readers.emplace_back([&] {
+            uint64_t lastVersion = 0;
+            while (!finished.load()) {
+                auto version = buffer.getVersion();
+                auto snapshot = buffer.getLatest();
+                for (auto const& value : *snapshot) {
+                    if (value != toInt(snapshot->size())) {
+                        ++numInconsistentSnapshots;
+                        break;
+                    }
+                }
+                if (version < lastVersion) {
+                    ++numInconsistentSnapshots;
+                }
+                lastVersion = version;
+            }
+        });
+    }
+    for (int i = 0; i < 2000; ++i) {
+        auto size = i % 100;
+        buffer.publish(std::vector<int>(size, size));
+    }
+    finished = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(0, numInconsistentSnapshots.load());
+    EXPECT_EQ(2000, buffer.getVersion());
+}
@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <random>
+#include <unordered_map>
+
+#include <gtest/gtest.h>
+
+#include "Base/Definitions.h"
+#include "Base/Math.h"
+#include "EngineInterface/DescriptionEditService.h"
+#include "EngineInterface/SpaceCalculator.h"
+#include "EngineInterface/SpatialGrid.h"
+
+class SpatialGridTests : public ::testing::Test
+{
+protected:
+    std::vector<RealVector2D> createRandomPositions(int numPositions, RealVector2D const& minPos, RealVector2D const& maxPos) const
+    {
+        std::mt19937 engine(42);
+        std::uniform_real_distribution<float> distX(minPos.x, maxPos.x);
+        std::uniform_real_distribution<float> distY(minPos.y, maxPos.y);
+        std::vector<RealVector2D> result;
+        for (int i = 0; i < numPositions; ++i) {
+            result.emplace_back(distX(engine), distY(engine));
+        }
+        return result;
+    }
+
+    std::vector<int> getIndicesWithinRadiusByBruteForce(
+        std::vector<RealVector2D> const& positions,
+        RealVector2D const& center,
+        float radius,
+        std::optional<IntVector2D> const& worldSize) const
+    {
+        std::vector<std::pair<float, int>> distancesAndIndices;
+        for (int i = 0; i < toInt(positions.size()); ++i) {
+            auto distance = worldSize ? SpaceCalculator(*worldSize).distance(center, positions[i]) : Math::length(positions[i] - center);
+            if (distance <= radius) {
+                distancesAndIndices.emplace_back(distance, i);
+            }
+        }
+        std::sort(distancesAndIndices.begin(), distancesAndIndices.end());
+        std::vector<int> result;
+        for (auto const& [distance, index] : distancesAndIndices) {
+            result.emplace_back(index);
+        }
+        return result;
+    }
+
+    std::vector<int> getSortedIndicesWithinRadius(SpatialGrid const& grid, RealVector2D const& center, float radius) const
+    {
+        std::vector<int> result;
+        grid.forEachWithinRadius(center, radius, [&](int pointIndex, float distance) { result.emplace_back(pointIndex); });
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+};
+
+TEST_F(SpatialGridTests, periodicQueries_acrossBoundary)
+{
+    SpatialGrid grid({100, 50}, 2.0f);
+    grid.build({{99.5f, 49.5f}, {0.5f, 0.5f}, {50.0f, 25.0f}, {-0.5f, 25.0f}});
+
+    EXPECT_EQ(std::vector<int>({0, 1}), getSortedIndicesWithinRadius(grid, {0.0f, 0.0f}, 1.0f));
+    EXPECT_EQ(std::vector<int>({3}), getSortedIndicesWithinRadius(grid, {99.0f, 25.0f}, 1.0f));
+    EXPECT_TRUE(grid.isOccupied({100.2f, 50.2f}, 1.0f));
+    EXPECT_FALSE(grid.isOccupied({25.0f, 25.0f}, 1.0f));
+}
+
+TEST_F(SpatialGridTests, periodicQueries_radiusLargerThanWorld)
+{
+    IntVector2D worldSize{20, 10};
+    auto positions = createRandomPositions(200, {0, 0}, {20.0f, 10.0f});
+    SpatialGrid grid(worldSize, 1.0f);
+    grid.build(positions);
+
+    auto indices = getSortedIndicesWithinRadius(grid, {3.0f, 3.0f}, 30.0f);
+    ASSERT_EQ(200, indices.size());
+    for (int i = 0; i < 200; ++i) {
+        EXPECT_EQ(i, indices.at(i));
+    }
+}
+
+TEST_F(SpatialGridTests, bulkQueries_matchBruteForce)
+{
+    for (auto const& worldSize : {std::optional<IntVector2D>(), std::optional<IntVector2D>(IntVector2D{300, 200})}) {
+        auto positions = createRandomPositions(5000, {-10.0f, -10.0f}, {310.0f, 210.0f});
+        auto centers = createRandomPositions(300, {-20.0f, -20.0f}, {320.0f, 220.0f});
+        auto grid = worldSize ? SpatialGrid(*worldSize, 3.0f) : SpatialGrid(3.0f);
+        grid.build(positions);
+
+        auto indicesByCenter = grid.getIndicesWithinRadius(centers, 4.5f);
+        ASSERT_EQ(centers.size(), indicesByCenter.size());
+        for (int i = 0; i < toInt(centers.size()); ++i) {
+            EXPECT_EQ(getIndicesWithinRadiusByBruteForce(positions, centers[i], 4.5f, worldSize), indicesByCenter[i]);
+        }
+    }
+}
+
+TEST_F(SpatialGridTests, insert_withRepacking)
+{
+    IntVector2D worldSize{100, 100};
+    auto positions = createRandomPositions(3000, {0, 0}, {100.0f, 100.0f});
+    SpatialGrid grid(worldSize, 2.0f);
+    grid.build({positions.begin(), positions.begin() + 100});
+    for (int i = 100; i < toInt(positions.size()); ++i) {
+        EXPECT_EQ(i, grid.insert(positions[i]));
+    }
+    EXPECT_EQ(3000, grid.getNumPoints());
+
+    auto centers = createRandomPositions(100, {0, 0}, {100.0f, 100.0f});
+    for (auto const& center : centers) {
+        auto expectedIndices = getIndicesWithinRadiusByBruteForce(positions, center, 3.0f, worldSize);
+        std::sort(expectedIndices.begin(), expectedIndices.end());
+        EXPECT_EQ(expectedIndices, getSortedIndicesWithinRadius(grid, center, 3.0f));
+    }
+
+    grid.clear();
+    EXPECT_EQ(0, grid.getNumPoints());
+    EXPECT_FALSE(grid.isOccupied(centers.front(), 100.0f));
+}
+
+TEST_F(SpatialGridTests, unboundedQueries_outsideBoundingBox)
+{
+    SpatialGrid grid(1.0f);
+    grid.build({{0, 0}, {10.0f, 10.0f}});
+    grid.insert({-5.0f, 20.0f});
+
+    EXPECT_EQ(std::vector<int>({2}), getSortedIndicesWithinRadius(grid, {-5.5f, 20.0f}, 1.0f));
+    EXPECT_EQ(std::vector<int>({0}), getSortedIndicesWithinRadius(grid, {-0.5f, -0.5f}, 1.0f));
+    EXPECT_FALSE(grid.isOccupied({100.0f, 100.0f}, 1.0f));
+}
+
+TEST_F(SpatialGridTests, reconnectCells)
+{
+    auto data = DescriptionEditService::get().createRect(DescriptionEditService::CreateRectParameters().width(10).height(10).cellDistance(1.0f));
+    DescriptionEditService::get().reconnectCells(data, 1.5f);
+
+    std::unordered_map<uint64_t, CellDescription> cellById;
+    for (auto const& cell : data.cells) {
+        cellById.emplace(cell.id, cell);
+    }
+    for (auto const& cell : data.cells) {
+        EXPECT_LE(cell.connections.size(), cell.maxConnections);
+        for (auto const& connection : cell.connections) {
+            auto const& otherCell = cellById.at(connection.cellId);
+            EXPECT_TRUE(otherCell.isConnectedTo(cell.id));
+            EXPECT_LE(Math::length(otherCell.pos - cell.pos), 1.5f + NEAR_ZERO);
+        }
+    }
+}
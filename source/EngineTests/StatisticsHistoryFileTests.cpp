@@ -0,0 +1,159 @@
+#include <cstring>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+#include "PersisterInterface/StatisticsHistoryFileService.h"
+
+class StatisticsHistoryFileTests : public ::testing::Test
+{
+public:
+    StatisticsHistoryFileTests()
+        : _filename(std::filesystem::temp_directory_path() / "alien_statistics_history_test.statistics.bin")
+    {}
+
+    ~StatisticsHistoryFileTests() { std::filesystem::remove(_filename); }
+
+protected:
+    StatisticsHistoryData createStatistics(int numRows, double startTime = 0) const
+    {
+        StatisticsHistoryData result(numRows);
+        for (int i = 0; i < numRows; ++i) {
+            auto& row = result.at(i);
+            row.time = startTime + toDouble(i);
+            row.systemClock = toDouble(i) * 0.5;
+            row.numCells.values[i % MAX_COLORS] = toDouble(i) + 0.25;
+            row.numCells.summedValues = toDouble(i) + 0.25;
+            row.varianceGenomeComplexity.values[MAX_COLORS - 1] = -toDouble(i);
+        }
+        return result;
+    }
+
+    StatisticsHistoryData read() const
+    {
+        StatisticsHistoryData result;
+        StatisticsHistoryFileService::get().read(result, _filename);
+        return result;
+    }
+
+    void expectEqual(StatisticsHistoryData const& expected, StatisticsHistoryData const& actual) const
+    {
+        ASSERT_EQ(expected.size(), actual.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_EQ(0, std::memcmp(&expected.at(i), &actual.at(i), sizeof(DataPointCollection)));
+        }
+    }
+
+    void setMarker(int rowIndex) const
+    {
+        std::fstream stream(_filename, std::ios::binary | std::ios::in | std::ios::out);
+        stream.seekp(sizeof(StatisticsHistoryFile::Header) + rowIndex * sizeof(DataPointCollection) + offsetof(DataPointCollection, systemClock));
+        stream.write(reinterpret_cast<char const*>(&Marker), sizeof(Marker));
+    }
+
+    static double constexpr Marker = -1.0;
+
+    std::filesystem::path _filename;
+};
+
+TEST_F(StatisticsHistoryFileTests, writeAndRead)
+{
+    auto statistics = createStatistics(100);
+    StatisticsHistoryFileService::get().write(_filename, statistics);
+
+    EXPECT_EQ(100, StatisticsHistoryFileService::get().getNumRows(_filename));
+    expectEqual(statistics, read());
+}
+
+TEST_F(StatisticsHistoryFileTests, appendKeepsStableRows)
+{
+    auto statistics = createStatistics(50);
+    StatisticsHistoryFileService::get().append(_filename, statistics, 40);
+
+    //change a stable and an unstable row in the file in order to detect whether they are rewritten
+    setMarker(10);
+    setMarker(45);
+
+    auto extendedStatistics = createStatistics(80);
+    StatisticsHistoryFileService::get().append(_filename, extendedStatistics, 70);
+
+    auto storedStatistics = read();
+    ASSERT_EQ(80, storedStatistics.size());
+    EXPECT_EQ(Marker, storedStatistics.at(10).systemClock);
+    storedStatistics.at(10).systemClock = extendedStatistics.at(10).systemClock;
+    expectEqual(extendedStatistics, storedStatistics);
+}
+
+TEST_F(StatisticsHistoryFileTests, appendDetectsChangedStableRow)
+{
+    auto statistics = createStatistics(50);
+    StatisticsHistoryFileService::get().append(_filename, statistics, 40);
+    setMarker(10);
+
+    //only a row in the middle of the stable rows differs
+    auto changedStatistics = createStatistics(60);
+    changedStatistics.at(20).numCells.summedValues += 1.0;
+    StatisticsHistoryFileService::get().append(_filename, changedStatistics, 50);
+    expectEqual(changedStatistics, read());
+}
+
+TEST_F(StatisticsHistoryFileTests, appendRewritesChangedHistory)
+{
+    StatisticsHistoryFileService::get().append(_filename, createStatistics(50), 40);
+
+    auto compressedStatistics = createStatistics(30, 1000.0);
+    StatisticsHistoryFileService::get().append(_filename, compressedStatistics, 20);
+    expectEqual(compressedStatistics, read());
+
+    auto resetStatistics = createStatistics(10);
+    StatisticsHistoryFileService::get().append(_filename, resetStatistics, 0);
+    expectEqual(resetStatistics, read());
+}
+
+TEST_F(StatisticsHistoryFileTests, partialRowIgnored)
+{
+    auto statistics = createStatistics(20);
+    StatisticsHistoryFileService::get().write(_filename, statistics);
+    std::filesystem::resize_file(_filename, std::filesystem::file_size(_filename) - sizeof(DataPointCollection) / 2);
+
+    statistics.pop_back();
+    expectEqual(statistics, read());
+
+    auto extendedStatistics = createStatistics(25);
+    StatisticsHistoryFileService::get().append(_filename, extendedStatistics, 10);
+    expectEqual(extendedStatistics, read());
+}
+
+TEST_F(StatisticsHistoryFileTests, readVersion1File)
+{
+    auto statistics = createStatistics(20);
+    {
+        StatisticsHistoryFile::Header header;
+        std::memcpy(header.magic, StatisticsHistoryFile::Magic, sizeof(header.magic));
+        header.formatVersion = 1;
+        header.rowSize = sizeof(DataPointCollection);
+
+        std::ofstream stream(_filename, std::ios::binary);
+        stream.write(reinterpret_cast<char const*>(&header), StatisticsHistoryFile::HeaderSizeVersion1);
+        stream.write(reinterpret_cast<char const*>(statistics.data()), statistics.size() * sizeof(DataPointCollection));
+    }
+    expectEqual(statistics, read());
+
+    auto extendedStatistics = createStatistics(30);
+    StatisticsHistoryFileService::get().append(_filename, extendedStatistics, 20);
+    EXPECT_EQ(30, StatisticsHistoryFileService::get().getNumRows(_filename));
+    expectEqual(extendedStatistics, read());
+}
+
+TEST_F(StatisticsHistoryFileTests, invalidFile)
+{
+    {
+        std::ofstream stream(_filename, std::ios::binary);
+        stream << "Time step, Cells (color 0)";
+    }
+    EXPECT_THROW(read(), std::runtime_error);
+
+    auto statistics = createStatistics(5);
+    StatisticsHistoryFileService::get().append(_filename, statistics, 5);
+    expectEqual(statistics, read());
+}
@@ -0,0 +1,202 @@
+#include <gtest/gtest.h>
+
+#include "Base/Definitions.h"
+#include "EngineInterface/StatisticsHistory.h"
+#include "EngineInterface/StatisticsService.h"
+
+class StatisticsHistoryTests : public ::testing::Test
+{
+protected:
+    DataPointCollection createDataPoint(int index) const
+    {
+        DataPointCollection result;
+        result.time = toDouble(index) * 10;
+        result.systemClock = toDouble(index);
+        result.numCells.values[0] = toDouble(index);
+        result.numCells.summedValues = toDouble(index) * 2;
+        result.numDetonations.values[MAX_COLORS - 1] = 1.0;
+        return result;
+    }
+
+    TimelineStatistics createRawStatistics(uint64_t timestep) const
+    {
+        TimelineStatistics result;
+        result.timestep.numCells[0] = 100;
+        result.accumulated.numCreatedCells[0] = timestep;
+        return result;
+    }
+};
+
+TEST_F(StatisticsHistoryTests, addDataPoints)
+{
+    StatisticsHistory history;
+    EXPECT_TRUE(history.getSnapshot()->isEmpty());
+
+    for (int i = 0; i < 100; ++i) {
+        history.add(createDataPoint(i));
+    }
+    auto snapshot = history.getSnapshot();
+    ASSERT_EQ(100, snapshot->getTier(0).getSize());
+    EXPECT_EQ(10, snapshot->getTier(1).getSize());
+    EXPECT_EQ(1, snapshot->getTier(2).getSize());
+
+    auto dataPoint = snapshot->getTier(0).getDataPoint(42);
+    EXPECT_EQ(420.0, dataPoint.time);
+    EXPECT_EQ(42.0, dataPoint.numCells.values[0]);
+    EXPECT_EQ(84.0, dataPoint.numCells.summedValues);
+    EXPECT_EQ(1.0, dataPoint.numDetonations.values[MAX_COLORS - 1]);
+
+    //averages of the tiers are assigned to the time of their first data point
+    auto averagedDataPoint = snapshot->getTier(1).getDataPoint(1);
+    EXPECT_EQ(100.0, averagedDataPoint.time);
+    EXPECT_EQ(14.5, averagedDataPoint.numCells.values[0]);
+    EXPECT_EQ(49.5, snapshot->getTier(2).getDataPoint(0).numCells.values[0]);
+
+    auto data = history.getCopiedData();
+    ASSERT_EQ(100, data.size());
+    EXPECT_EQ(990.0, data.back().time);
+}
+
+TEST_F(StatisticsHistoryTests, replaceDataPointWithSameTime)
+{
+    StatisticsHistory history;
+    history.add(createDataPoint(1));
+    auto dataPoint = createDataPoint(1);
+    dataPoint.numCells.values[0] = 5.0;
+    history.add(dataPoint);
+
+    auto data = history.getCopiedData();
+    ASSERT_EQ(1, data.size());
+    EXPECT_EQ(5.0, data.front().numCells.values[0]);
+}
+
+TEST_F(StatisticsHistoryTests, tiersKeepRecentDetail)
+{
+    StatisticsHistory history;
+    auto numDataPoints = StatisticsHistory::MaxTierSize * 150;
+    for (int i = 0; i < numDataPoints; ++i) {
+        history.add(createDataPoint(i));
+    }
+    auto snapshot = history.getSnapshot();
+    EXPECT_EQ(StatisticsHistory::MaxTierSize, snapshot->getTier(0).getSize());
+    EXPECT_EQ(StatisticsHistory::MaxTierSize, snapshot->getTier(1).getSize());
+    EXPECT_LE(snapshot->getTier(2).getSize(), StatisticsHistory::MaxTierSize);
+
+    //the top tier covers the entire history, the raw tier the most recent data points
+    EXPECT_EQ(0.0, snapshot->getStartTime());
+    EXPECT_EQ(toDouble(numDataPoints - StatisticsHistory::MaxTierSize) * 10, snapshot->getTier(0).getTime(0));
+    EXPECT_EQ(toDouble(numDataPoints - 1) * 10, snapshot->getLastDataPoint().time);
+
+    auto data = snapshot->getData();
+    EXPECT_LE(data.size(), StatisticsHistory::NumTiers * StatisticsHistory::MaxTierSize);
+    EXPECT_EQ(0.0, data.front().time);
+    EXPECT_EQ(toDouble(numDataPoints - 1) * 10, data.back().time);
+    for (size_t i = 1; i < data.size(); ++i) {
+        EXPECT_LT(data.at(i - 1).time, data.at(i).time);
+    }
+
+    //recent time periods are served from the raw tier
+    auto startTime = toDouble(numDataPoints - 100) * 10 + 5;
+    auto recentData = snapshot->getData(startTime);
+    ASSERT_EQ(100, recentData.size());
+    EXPECT_LT(recentData.front().time, startTime);
+}
+
+TEST_F(StatisticsHistoryTests, snapshotsAreImmutable)
+{
+    StatisticsHistory history;
+    for (int i = 0; i < StatisticsHistoryTier::ChunkSize + 10; ++i) {
+        history.add(createDataPoint(i));
+    }
+    auto snapshot = history.getSnapshot();
+    auto data = snapshot->getData();
+
+    history.removeDataPointsFrom(toDouble(StatisticsHistoryTier::ChunkSize - 5) * 10);
+    for (int i = 0; i < 20; ++i) {
+        auto dataPoint = createDataPoint(StatisticsHistoryTier::ChunkSize - 5 + i);
+        dataPoint.numCells.values[0] = -1.0;
+        history.add(dataPoint);
+    }
+    EXPECT_LT(snapshot->getVersion(), history.getSnapshot()->getVersion());
+
+    auto dataAfterChanges = snapshot->getData();
+    ASSERT_EQ(data.size(), dataAfterChanges.size());
+    for (size_t i = 0; i < data.size(); ++i) {
+        EXPECT_EQ(data.at(i).numCells.values[0], dataAfterChanges.at(i).numCells.values[0]);
+    }
+    EXPECT_EQ(-1.0, history.getSnapshot()->getLastDataPoint().numCells.values[0]);
+}
+
+TEST_F(StatisticsHistoryTests, setData)
+{
+    StatisticsHistoryData data;
+    for (int i = 0; i < 3000; ++i) {
+        data.emplace_back(createDataPoint(i));
+    }
+    StatisticsHistory history;
+    history.setData(data);
+
+    auto snapshot = history.getSnapshot();
+    EXPECT_EQ(StatisticsHistory::MaxTierSize, snapshot->getTier(0).getSize());
+    EXPECT_EQ(0.0, snapshot->getStartTime());
+    auto copiedData = snapshot->getData();
+    EXPECT_EQ(0.0, copiedData.front().time);
+    EXPECT_EQ(29990.0, copiedData.back().time);
+
+    history.clear();
+    EXPECT_TRUE(history.getSnapshot()->isEmpty());
+    EXPECT_TRUE(history.getCopiedData().empty());
+}
+
+TEST_F(StatisticsHistoryTests, stableDataPointsRemainUnchanged)
+{
+    StatisticsHistory history;
+    auto snapshot = history.getSnapshot();
+    for (int i = 0; i < 30000; ++i) {
+        history.add(createDataPoint(i));
+        if (i % 250 != 0) {
+            continue;
+        }
+        auto newSnapshot = history.getSnapshot();
+        auto numStableDataPoints = snapshot->getNumStableDataPoints();
+        ASSERT_GE(newSnapshot->getNumStableDataPoints(), numStableDataPoints);
+
+        auto data = snapshot->getData();
+        auto newData = newSnapshot->getData();
+        for (int j = 0; j < numStableDataPoints; ++j) {
+            ASSERT_EQ(data.at(j).time, newData.at(j).time);
+            ASSERT_EQ(data.at(j).numCells.values[0], newData.at(j).numCells.values[0]);
+        }
+        snapshot = newSnapshot;
+    }
+    EXPECT_GT(snapshot->getNumStableDataPoints(), 0);
+}
+
+TEST_F(StatisticsHistoryTests, recreatedHistoryDoesNotInheritSamplingState)
+{
+    auto& statisticsService = StatisticsService::get();
+    auto addDataPoints = [&](StatisticsHistory& history, uint64_t startTimestep, uint64_t endTimestep) {
+        for (auto timestep = startTimestep; timestep <= endTimestep; timestep += 10) {
+            statisticsService.addDataPoint(history, createRawStatistics(timestep * 3), timestep);
+        }
+    };
+
+    //the new history is created at the address of the destroyed one
+    std::optional<StatisticsHistory> history;
+    history.emplace();
+    addDataPoints(*history, 0, 10000);
+    history.reset();
+    history.emplace();
+    addDataPoints(*history, 0, 100);
+
+    StatisticsHistory freshHistory;
+    addDataPoints(freshHistory, 0, 100);
+
+    auto data = history->getCopiedData();
+    auto expectedData = freshHistory.getCopiedData();
+    ASSERT_EQ(expectedData.size(), data.size());
+    for (size_t i = 0; i < data.size(); ++i) {
+        EXPECT_EQ(expectedData.at(i).time, data.at(i).time);
+        EXPECT_EQ(expectedData.at(i).numCreatedCells.summedValues, data.at(i).numCreatedCells.summedValues);
+    }
+}
@@ -0,0 +1,89 @@
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Base/ThreadPool.h"
+
+class ThreadPoolTests : public ::testing::Test
+{};
+
+TEST_F(ThreadPoolTests, chunksCoverAllElements)
+{
+    ThreadPool threadPool(4);
+    std::vector<std::atomic<int>> counts(10007);
+    threadPool.parallelFor(
+        counts.size(),
+        [&](size_t startIndex, size_t endIndex) {
+            for (auto index = startIndex; index < endIndex; ++index) {
+                ++counts.at(index);
+            }
+        },
+        16);
+    for (auto const& count : counts) {
+        EXPECT_EQ(1, count.load());
+    }
+}
+
+TEST_F(ThreadPoolTests, exceptionIsRethrown)
+{
+    ThreadPool threadPool(4);
+    EXPECT_THROW(
+        threadPool.parallelFor(
+            100,
+            [](size_t startIndex, size_t endIndex) {
+                if (startIndex <= 50 && 50 < endIndex) {
+                    throw std::runtime_error("test");
+                }
+            },
+            1),
+        std::runtime_error);
+
+    //pool is still usable afterwards
+    std::atomic<size_t> sum = 0;
+    threadPool.parallelFor(100, [&](size_t startIndex, size_t endIndex) { sum += endIndex - startIndex; }, 1);
+    EXPECT_EQ(100, sum.load());
+}
+
+TEST_F(ThreadPoolTests, concurrentAndNestedCalls)
+{
+    ThreadPool threadPool(4);
+    std::atomic<size_t> sum = 0;
+    std::vector<std::thread> callers;
+    for (int i = 0; i < 4; ++i) {
+        callers.emplace_back([&] {
+            threadPool.parallelFor(
+                20,
+                [&](size_t startIndex, size_t endIndex) {
+                    for (auto index = startIndex; index < endIndex; ++index) {
+                        threadPool.parallelFor(100, [&](size_t innerStartIndex, size_t innerEndIndex) { sum += innerEndIndex - innerStartIndex; }, 1);
+                    }
+                },
+                1);
+        });
+    }
+    for (auto& caller : callers) {
+        caller.join();
+    }
+    EXPECT_EQ(4 * 20 * 100, sum.load());
+}
+
+TEST_F(ThreadPoolTests, parallelCollectKeepsIndexOrder)
+{
+    auto result = ThreadPool::get().parallelCollect<size_t>(
+        1000,
+        [](size_t startIndex, size_t endIndex, std::vector<size_t>& chunkResult) {
+            for (auto index = startIndex; index < endIndex; ++index) {
+                if (index % 3 == 0) {
+                    chunkResult.emplace_back(index);
+                }
+            }
+        },
+        10);
+    ASSERT_EQ(334, result.size());
+    for (size_t i = 0; i < result.size(); ++i) {
+        EXPECT_EQ(i * 3, result.at(i));
+    }
+}
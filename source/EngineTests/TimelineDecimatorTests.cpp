@@ -0,0 +1,118 @@
+#include <algorithm>
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "Base/Definitions.h"
+#include "EngineInterface/TimelineDecimator.h"
+
+class TimelineDecimatorTests : public ::testing::Test
+{
+protected:
+    static int constexpr Column = 2;  //first value of numCells
+
+    DataPointCollection createDataPoint(int index) const
+    {
+        DataPointCollection result;
+        result.time = toDouble(index);
+        result.numCells.values[0] = std::sin(toDouble(index) * 0.37) * 100 + toDouble(index % 23);
+        return result;
+    }
+
+    std::vector<DataPointCollection> createDataPoints(int from, int to) const
+    {
+        std::vector<DataPointCollection> result;
+        for (int i = from; i < to; ++i) {
+            result.emplace_back(createDataPoint(i));
+        }
+        return result;
+    }
+
+    double getExpectedMaxValue(std::vector<DataPointCollection> const& dataPoints, int fromIndex, int toIndex) const
+    {
+        auto result = dataPoints.at(fromIndex).numCells.values[0];
+        for (int i = fromIndex; i < toIndex; ++i) {
+            result = std::max(result, dataPoints.at(i).numCells.values[0]);
+        }
+        return result;
+    }
+
+    void checkMaxValues(TimelineDecimator& decimator, std::vector<DataPointCollection> const& dataPoints) const
+    {
+        auto count = toInt(dataPoints.size());
+        for (int fromIndex = 0; fromIndex < count; fromIndex += 7) {
+            for (int toIndex = fromIndex + 1; toIndex <= count; toIndex += 13) {
+                EXPECT_EQ(getExpectedMaxValue(dataPoints, fromIndex, toIndex), decimator.getMaxValue(dataPoints, Column, fromIndex, toIndex));
+            }
+        }
+    }
+};
+
+TEST_F(TimelineDecimatorTests, maxValues)
+{
+    auto dataPoints = createDataPoints(0, 500);
+
+    TimelineDecimator decimator;
+    checkMaxValues(decimator, dataPoints);
+    EXPECT_EQ(0.0, decimator.getMaxValue(dataPoints, Column, 10, 10));
+}
+
+TEST_F(TimelineDecimatorTests, maxValuesAfterAppendingAndRemoving)
+{
+    auto dataPoints = createDataPoints(0, 100);
+
+    TimelineDecimator decimator;
+    checkMaxValues(decimator, dataPoints);
+    for (int i = 100; i < 1000; ++i) {
+        dataPoints.emplace_back(createDataPoint(i));
+        if (dataPoints.size() > 300) {
+            dataPoints.erase(dataPoints.begin(), dataPoints.begin() + 2);
+            decimator.removeFront(2);
+        }
+        if (i % 97 == 0) {
+            checkMaxValues(decimator, dataPoints);
+        }
+    }
+    checkMaxValues(decimator, dataPoints);
+}
+
+TEST_F(TimelineDecimatorTests, decimateFewDataPoints)
+{
+    auto dataPoints = createDataPoints(0, 100);
+
+    TimelineDecimator decimator;
+    auto timeline = decimator.decimate(dataPoints, Column, 20.5, 99.0, 100);
+
+    //data points are passed unchanged including the one preceding the start time
+    ASSERT_EQ(80, timeline.values.size());
+    EXPECT_EQ(20.0, timeline.timePoints.front());
+    EXPECT_EQ(99.0, timeline.timePoints.back());
+    for (size_t i = 0; i < timeline.values.size(); ++i) {
+        EXPECT_EQ(dataPoints.at(i + 20).numCells.values[0], timeline.values.at(i));
+    }
+}
+
+TEST_F(TimelineDecimatorTests, decimateManyDataPoints)
+{
+    auto dataPoints = createDataPoints(0, 100000);
+    auto numBuckets = 200;
+
+    TimelineDecimator decimator;
+    auto timeline = decimator.decimate(dataPoints, Column, 10000.0, 99999.0, numBuckets);
+    ASSERT_LE(timeline.values.size(), numBuckets * 4);
+    ASSERT_EQ(timeline.values.size(), timeline.timePoints.size());
+    ASSERT_EQ(timeline.values.size(), timeline.systemClock.size());
+    EXPECT_EQ(9999.0, timeline.timePoints.front());
+    EXPECT_EQ(99999.0, timeline.timePoints.back());
+    EXPECT_EQ(dataPoints.back().numCells.values[0], timeline.values.back());
+
+    //the decimated data points are original data points and keep the extremes
+    for (size_t i = 0; i < timeline.values.size(); ++i) {
+        auto index = toInt(timeline.timePoints.at(i));
+        EXPECT_EQ(dataPoints.at(index).numCells.values[0], timeline.values.at(i));
+        if (i > 0) {
+            EXPECT_LT(timeline.timePoints.at(i - 1), timeline.timePoints.at(i));
+        }
+    }
+    EXPECT_EQ(getExpectedMaxValue(dataPoints, 9999, 100000), *std::max_element(timeline.values.begin(), timeline.values.end()));
+}
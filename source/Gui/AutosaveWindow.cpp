@@ -45,6 +45,11 @@ void AutosaveWindow::initIntern(SimulationFacade simulationFacade, PersisterFaca
     _origNumberOfFiles = GlobalSettings::get().getValue("windows.autosave.number of files", _origNumberOfFiles);
     _numberOfFiles = _origNumberOfFiles;
 
+    _origDeltaSavepoints = GlobalSettings::get().getValue("windows.autosave.delta savepoints", _origDeltaSavepoints);
+    _deltaSavepoints = _origDeltaSavepoints;
+    _origFullSavepointInterval = GlobalSettings::get().getValue("windows.autosave.full savepoint interval", _origFullSavepointInterval);
+    _fullSavepointInterval = _origFullSavepointInterval;
+
     _origDirectory = GlobalSettings::get().getValue("windows.autosave.directory", (std::filesystem::current_path() / Const::ResourcePath).string());
     _directory = _origDirectory;
 
@@ -67,6 +72,8 @@ void AutosaveWindow::shutdownIntern()
     GlobalSettings::get().setValue("windows.autosave.interval", _autosaveInterval);
     GlobalSettings::get().setValue("windows.autosave.mode", _saveMode);
     GlobalSettings::get().setValue("windows.autosave.number of files", _numberOfFiles);
+    GlobalSettings::get().setValue("windows.autosave.delta savepoints", _deltaSavepoints);
+    GlobalSettings::get().setValue("windows.autosave.full savepoint interval", _fullSavepointInterval);
     GlobalSettings::get().setValue("windows.autosave.directory", _directory);
     GlobalSettings::get().setValue("windows.autosave.catch peaks", _catchPeaks);
 }
@@ -290,6 +297,15 @@ void AutosaveWindow::processSettings()
                 AlienImGui::InputInt(
                     AlienImGui::InputIntParameters().name("Number of files").textWidth(RightColumnWidth).defaultValue(_origNumberOfFiles), _numberOfFiles);
             }
+            AlienImGui::InputInt(
+                AlienImGui::InputIntParameters()
+                    .name("Full save point interval")
+                    .textWidth(RightColumnWidth)
+                    .defaultValue(_origFullSavepointInterval)
+                    .tooltip("If activated, save points only contain the changes to the previous save point. Every n-th save point is saved "
+                             "completely. Save points which are needed by later save points are kept until these are deleted."),
+                _fullSavepointInterval,
+                &_deltaSavepoints);
         }
         ImGui::EndChild();
     }
@@ -318,27 +334,44 @@ void AutosaveWindow::onCreateSavepoint(bool usePeakSimulation)
 {
     printOverlayMessage("Creating save point ...");
 
-    if (_saveMode == SaveMode_Circular) {
-        auto nonPersistentEntries = SavepointTableService::get().truncate(_savepointTable.value(), _numberOfFiles - 1);
-        scheduleDeleteNonPersistentSavepoint(nonPersistentEntries);
-    }
+    auto deltaBaseFilename = getDeltaBaseFilename();
 
     PersisterRequestId requestId;
     if (usePeakSimulation && !_peakDeserializedSimulation->isEmpty()) {
         auto senderInfo = SenderInfo{.senderId = SenderId{AutosaveSenderId}, .wishResultData = true, .wishErrorInfo = true};
         auto saveData = SaveDeserializedSimulationRequestData{
-            .filename = _directory, .sharedDeserializedSimulation = _peakDeserializedSimulation, .generateNameFromTimestep = true, .resetDeserializedSimulation = true};
+            .filename = _directory,
+            .sharedDeserializedSimulation = _peakDeserializedSimulation,
+            .generateNameFromTimestep = true,
+            .resetDeserializedSimulation = true,
+            .deltaBaseFilename = deltaBaseFilename};
         requestId = _persisterFacade->scheduleSaveDeserializedSimulation(senderInfo, saveData);
     } else {
         auto senderInfo = SenderInfo{.senderId = SenderId{AutosaveSenderId}, .wishResultData = true, .wishErrorInfo = true};
         auto saveData = SaveSimulationRequestData{
-            .filename = _directory, .zoom = Viewport::get().getZoomFactor(), .center = Viewport::get().getCenterInWorldPos(), .generateNameFromTimestep = true};
+            .filename = _directory,
+            .zoom = Viewport::get().getZoomFactor(),
+            .center = Viewport::get().getCenterInWorldPos(),
+            .generateNameFromTimestep = true,
+            .deltaBaseFilename = deltaBaseFilename};
         requestId = _persisterFacade->scheduleSaveSimulation(senderInfo, saveData);
     }
 
-    auto entry = std::make_shared<_SavepointEntry>(
-        _SavepointEntry{.filename = "", .state = SavepointState_InQueue, .timestamp = "", .name = "", .timestep = 0, .requestId = requestId.value});
+    //the new entry is inserted before truncating such that its base save point is kept
+    auto entry = std::make_shared<_SavepointEntry>(_SavepointEntry{
+        .filename = "",
+        .state = SavepointState_InQueue,
+        .timestamp = "",
+        .name = "",
+        .timestep = 0,
+        .baseFilename = SavepointTableService::get().calcEntryPath(_savepointTable.value(), deltaBaseFilename),
+        .requestId = requestId.value});
     SavepointTableService::get().insertEntryAtFront(_savepointTable.value(), entry);
+
+    if (_saveMode == SaveMode_Circular) {
+        auto nonPersistentEntries = SavepointTableService::get().truncate(_savepointTable.value(), _numberOfFiles);
+        scheduleDeleteNonPersistentSavepoint(nonPersistentEntries);
+    }
 }
 
 void AutosaveWindow::onDeleteSavepoint(SavepointEntry const& entry)
@@ -460,18 +493,21 @@ void AutosaveWindow::updateSavepoint(int row)
                     newEntry->timestamp = StringHelper::format(data.timestamp);
                     newEntry->name = data.projectName;
                     newEntry->filename = SavepointTableService::get().calcEntryPath(_savepointTable.value(), data.filename);
+                    newEntry->baseFilename = SavepointTableService::get().calcEntryPath(_savepointTable.value(), data.baseFilename);
                 } else if (auto saveResult = std::dynamic_pointer_cast<_SaveDeserializedSimulationRequestResult>(requestResult)) {
                     auto const& data = saveResult->getData();
                     newEntry->timestep = data.timestep;
                     newEntry->timestamp = StringHelper::format(data.timestamp);
                     newEntry->name = data.projectName;
                     newEntry->filename = SavepointTableService::get().calcEntryPath(_savepointTable.value(), data.filename);
+                    newEntry->baseFilename = SavepointTableService::get().calcEntryPath(_savepointTable.value(), data.baseFilename);
                     newEntry->peak = StringHelper::format(toFloat(sumColorVector(data.rawStatisticsData.timeline.timestep.genomeComplexityVariance)), 2);
                     newEntry->peakType = "genome complexity variance";
                 }
             }
             if (requestState.value() == PersisterRequestState::Error) {
                 newEntry->state = SavepointState_Error;
+                newEntry->baseFilename.clear();
             }
             SavepointTableService::get().updateEntry(_savepointTable.value(), row, newEntry);
         }
@@ -488,6 +524,21 @@ void AutosaveWindow::updateSavepointTableFromFile()
     _selectedEntry.reset();
 }
 
+std::filesystem::path AutosaveWindow::getDeltaBaseFilename() const
+{
+    if (!_deltaSavepoints || _savepointTable->isEmpty()) {
+        return {};
+    }
+    auto const& entry = _savepointTable->at(0);
+    if (entry->state != SavepointState_Persisted || entry->filename.empty()) {
+        return {};
+    }
+    if (SavepointTableService::get().calcNumDeltasSinceFullSavepoint(_savepointTable.value(), entry) + 1 >= _fullSavepointInterval) {
+        return {};
+    }
+    return SavepointTableService::get().calcAbsolutePath(_savepointTable.value(), entry);
+}
+
 std::string AutosaveWindow::getSavepointFilename() const
 {
     return (std::filesystem::path(_directory) / Const::SavepointTableFilename).string();
@@ -496,5 +547,6 @@ std::string AutosaveWindow::getSavepointFilename() const
 void AutosaveWindow::validateAndCorrect()
 {
     _numberOfFiles = std::max(1, _numberOfFiles);
+    _fullSavepointInterval = std::max(1, _fullSavepointInterval);
     _autosaveInterval = std::max(1, _autosaveInterval);
 }
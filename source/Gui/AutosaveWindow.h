@@ -39,6 +39,7 @@ private:
     void processAutomaticSavepoints();
 
     void updateSavepoint(int row);
+    std::filesystem::path getDeltaBaseFilename() const;
 
     void updateSavepointTableFromFile();
     std::string getSavepointFilename() const;
@@ -66,6 +67,10 @@ private:
     SaveMode _saveMode = _origSaveMode;
     int _origNumberOfFiles = 20;
     int _numberOfFiles = _origNumberOfFiles;
+    bool _origDeltaSavepoints = false;
+    bool _deltaSavepoints = _origDeltaSavepoints;
+    int _origFullSavepointInterval = 10;
+    int _fullSavepointInterval = _origFullSavepointInterval;
 
     std::optional<SavepointTable> _savepointTable;
     SavepointEntry _selectedEntry;
@@ -6,8 +6,10 @@
 #include <imgui.h>
 
 #include "Base/LoggingService.h"
+#include "Base/StringHelper.h"
 
 #include "AlienImGui.h"
+#include "FpsController.h"
 #include "WindowController.h"
 #include "StyleRepository.h"
 
@@ -62,6 +64,11 @@ void DisplaySettingsDialog::processIntern()
             &fps)) {
         WindowController::get().setFps(fps);
     }
+    auto frameTimeStatistics = FpsController::get().getFrameTimeStatistics();
+    AlienImGui::Text(
+        "Frame time: " + StringHelper::format(toFloat(frameTimeStatistics.achievedFrameTime.count()) / 1000, 1) + " ms achieved, "
+        + StringHelper::format(toFloat(frameTimeStatistics.requestedFrameTime.count()) / 1000, 1) + " ms requested, "
+        + StringHelper::format(toFloat(frameTimeStatistics.workTime.count()) / 1000, 1) + " ms busy");
 
     ImGui::Dummy({0, ImGui::GetContentRegionAvail().y - scale(50.0f)});
     AlienImGui::Separator();
@@ -211,16 +211,20 @@ void EditorController::processInspectorWindows()
     _inspectorWindows = inspectorWindows;
     EditorModel::get().setInspectedEntities(inspectedEntities);
 
-    //update inspected entities from simulation
-    if (inspectedEntities.empty()) {
-        return;
-    }
+    //update inspected entities from the latest snapshot of the simulation
     std::vector<uint64_t> entityIds;
     for (auto const& entity : inspectedEntities) {
         entityIds.emplace_back(DescriptionEditService::get().getId(entity));
     }
-    auto inspectedData = _simulationFacade->getInspectedSimulationData(entityIds);
-    auto newInspectedEntities = DescriptionEditService::get().getObjects(inspectedData);
+    _simulationFacade->setInspectedEntityIdsForSnapshot(entityIds);
+    if (inspectedEntities.empty()) {
+        return;
+    }
+    auto inspectedData = _simulationFacade->getInspectedDataSnapshot();
+    if (inspectedData->entityIds != entityIds) {
+        return;  //snapshot for the currently inspected entities not yet published
+    }
+    auto newInspectedEntities = DescriptionEditService::get().getObjects(inspectedData->data);
     EditorModel::get().setInspectedEntities(newInspectedEntities);
 
     inspectorWindows.clear();
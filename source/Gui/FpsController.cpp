@@ -1,16 +1,120 @@
 #include "FpsController.h"
 
-void FpsController::processForceFps(int fps)
-{
-    auto callTimepoint = std::chrono::steady_clock::now();
-    if (_lastCallTimepoint) {
-        auto desiredDuration = std::chrono::milliseconds(1000 / fps);
-        auto actualDuration = std::chrono::duration_cast<std::chrono::milliseconds>(callTimepoint - *_lastCallTimepoint);
-        auto remainingTime = desiredDuration - actualDuration;
-        if (remainingTime.count() > 0) {
-            while (std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - callTimepoint) < remainingTime) {
-            }
+#include <thread>
+
+#if defined(_WIN32)
+#include <windows.h>
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+#endif
+#include <GLFW/glfw3.h>
+
+#include "Base/Definitions.h"
+
+#include "WindowController.h"
+
+namespace
+{
+    auto constexpr UnfocusedFps = 10;
+    auto constexpr MinimizedFps = 5;
+    auto constexpr SmoothingFactor = 0.05;
+    std::chrono::microseconds const SleepTolerance(100);  //remaining times below are not slept
+
+    std::chrono::microseconds smooth(std::chrono::microseconds const& average, std::chrono::microseconds const& value)
+    {
+        if (average.count() == 0) {
+            return value;
+        }
+        return std::chrono::microseconds(
+            static_cast<std::chrono::microseconds::rep>(toDouble(average.count()) * (1.0 - SmoothingFactor) + toDouble(value.count()) * SmoothingFactor));
+    }
+}
+
+FpsController::FpsController()
+{
+#if defined(_WIN32)
+    _timerHandle = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+#endif
+}
+
+FpsController::~FpsController()
+{
+#if defined(_WIN32)
+    if (_timerHandle) {
+        CloseHandle(_timerHandle);
+    }
+#endif
+}
+
+void FpsController::processForceFps(int fps, bool syncSimulationWithRendering)
+{
+    auto frameDuration = std::chrono::microseconds(1000000 / getEffectiveFps(fps, syncSimulationWithRendering));
+
+    auto workEndTimepoint = std::chrono::steady_clock::now();
+    if (_frameStartTimepoint) {
+        auto workTime = std::chrono::duration_cast<std::chrono::microseconds>(workEndTimepoint - *_frameStartTimepoint);
+        _frameTimeStatistics.workTime = smooth(_frameTimeStatistics.workTime, workTime);
+    }
+    if (_nextFrameTimepoint && *_nextFrameTimepoint - workEndTimepoint > SleepTolerance) {
+        sleepUntil(*_nextFrameTimepoint);
+    }
+
+    auto frameStartTimepoint = std::chrono::steady_clock::now();
+    if (_frameStartTimepoint) {
+        auto achievedFrameTime = std::chrono::duration_cast<std::chrono::microseconds>(frameStartTimepoint - *_frameStartTimepoint);
+        _frameTimeStatistics.achievedFrameTime = smooth(_frameTimeStatistics.achievedFrameTime, achievedFrameTime);
+    }
+    _frameTimeStatistics.requestedFrameTime = frameDuration;
+
+    //the next frame is scheduled relative to the last deadline such that oversleeping is compensated,
+    //after a frame that took longer than its duration the schedule restarts from now
+    if (_nextFrameTimepoint && frameStartTimepoint - *_nextFrameTimepoint < frameDuration) {
+        _nextFrameTimepoint = *_nextFrameTimepoint + frameDuration;
+    } else {
+        _nextFrameTimepoint = frameStartTimepoint + frameDuration;
+    }
+    _frameStartTimepoint = frameStartTimepoint;
+}
+
+bool FpsController::isRenderingSuspended() const
+{
+    return glfwGetWindowAttrib(WindowController::get().getWindowData().window, GLFW_ICONIFIED) != 0;
+}
+
+auto FpsController::getFrameTimeStatistics() const -> FrameTimeStatistics
+{
+    return _frameTimeStatistics;
+}
+
+int FpsController::getEffectiveFps(int fps, bool syncSimulationWithRendering) const
+{
+    if (syncSimulationWithRendering) {
+        return std::max(1, fps);
+    }
+    auto window = WindowController::get().getWindowData().window;
+    if (glfwGetWindowAttrib(window, GLFW_ICONIFIED) != 0) {
+        return std::min(fps, MinimizedFps);
+    }
+    if (glfwGetWindowAttrib(window, GLFW_FOCUSED) == 0) {
+        return std::min(fps, UnfocusedFps);
+    }
+    return std::max(1, fps);
+}
+
+void FpsController::sleepUntil(std::chrono::steady_clock::time_point const& timepoint)
+{
+#if defined(_WIN32)
+    //the default sleep granularity on Windows is about 15 ms
+    if (_timerHandle) {
+        auto remainingTime = std::chrono::duration_cast<std::chrono::nanoseconds>(timepoint - std::chrono::steady_clock::now());
+        LARGE_INTEGER dueTime;
+        dueTime.QuadPart = -static_cast<LONGLONG>(remainingTime.count() / 100);  //relative time in 100 ns units
+        if (SetWaitableTimer(_timerHandle, &dueTime, 0, nullptr, nullptr, FALSE)) {
+            WaitForSingleObject(_timerHandle, INFINITE);
+            return;
         }
     }
-    _lastCallTimepoint = callTimepoint;
+#endif
+    std::this_thread::sleep_until(timepoint);
 }
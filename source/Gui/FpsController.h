@@ -1,18 +1,42 @@
 #pragma once
 
 #include <chrono>
+#include <optional>
 
 #include "Base/Singleton.h"
 
 #include "Definitions.h"
 
+//paces the main loop by sleeping until the next frame is due instead of busy waiting
 class FpsController
 {
-    MAKE_SINGLETON(FpsController);
+    MAKE_SINGLETON_NO_DEFAULT_CONSTRUCTION(FpsController);
 
 public:
-    void processForceFps(int fps);
+    ~FpsController();
+
+    struct FrameTimeStatistics
+    {
+        std::chrono::microseconds requestedFrameTime{0};
+        std::chrono::microseconds achievedFrameTime{0};  //smoothed
+        std::chrono::microseconds workTime{0};  //smoothed time per frame without sleeping
+    };
+
+    //the frame rate is reduced while the window is unfocused or minimized unless the simulation time steps are bound to the frames
+    void processForceFps(int fps, bool syncSimulationWithRendering);
+    bool isRenderingSuspended() const;  //true while the window is minimized
+
+    FrameTimeStatistics getFrameTimeStatistics() const;
 
 private:
-    std::optional<std::chrono::steady_clock::time_point> _lastCallTimepoint;
-};
\ No newline at end of file
+    FpsController();
+
+    int getEffectiveFps(int fps, bool syncSimulationWithRendering) const;
+    void sleepUntil(std::chrono::steady_clock::time_point const& timepoint);
+
+    std::optional<std::chrono::steady_clock::time_point> _frameStartTimepoint;
+    std::optional<std::chrono::steady_clock::time_point> _nextFrameTimepoint;
+    FrameTimeStatistics _frameTimeStatistics;
+
+    void* _timerHandle = nullptr;  //high-resolution waitable timer on Windows
+};
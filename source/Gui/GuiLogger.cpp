@@ -2,6 +2,19 @@
 
 #include "Base/LoggingService.h"
 
+namespace
+{
+    auto constexpr MaxNumLogMessages = 1000;
+
+    void addLogMessage(std::deque<std::string>& logMessages, std::string const& message)
+    {
+        logMessages.emplace_back(message);
+        if (logMessages.size() > MaxNumLogMessages) {
+            logMessages.pop_front();
+        }
+    }
+}
+
 _GuiLogger::_GuiLogger()
 {
     LoggingService::get().registerCallBack(this);
@@ -12,18 +25,20 @@ _GuiLogger::~_GuiLogger()
     LoggingService::get().unregisterCallBack(this);
 }
 
-std::vector<std::string> const& _GuiLogger::getMessages(Priority minPriority) const
+std::vector<std::string> _GuiLogger::getMessages(Priority minPriority) const
 {
+    std::lock_guard<std::mutex> lock(_mutex);
     if (Priority::Important == minPriority) {
-        return _importantLogMessages;
+        return {_importantLogMessages.begin(), _importantLogMessages.end()};
     }
-    return _allLogMessages;
+    return {_allLogMessages.begin(), _allLogMessages.end()};
 }
 
 void _GuiLogger::newLogMessage(Priority priority, std::string const& message)
 {
-    _allLogMessages.emplace_back(message);
+    std::lock_guard<std::mutex> lock(_mutex);
+    addLogMessage(_allLogMessages, message);
     if (Priority::Important == priority) {
-        _importantLogMessages.emplace_back(message);
+        addLogMessage(_importantLogMessages, message);
     }
 }
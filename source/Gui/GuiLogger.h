@@ -1,5 +1,8 @@
 #pragma once
 
+#include <deque>
+#include <mutex>
+
 #include "Base/LoggingService.h"
 #include "Definitions.h"
 
@@ -9,12 +12,14 @@ public:
     _GuiLogger();
     ~_GuiLogger() override;
 
-    std::vector<std::string> const& getMessages(Priority minPriority) const;
+    //returns a copy since messages arrive on the logging thread, only the most recent messages are kept
+    std::vector<std::string> getMessages(Priority minPriority) const;
 
 private:
 
     void newLogMessage(Priority priority, std::string const& message) override;
 
-    std::vector<std::string> _allLogMessages;
-    std::vector<std::string> _importantLogMessages;
+    std::deque<std::string> _allLogMessages;
+    std::deque<std::string> _importantLogMessages;
+    mutable std::mutex _mutex;
 };
@@ -33,7 +33,8 @@ void LogWindow::processIntern()
         ImGui::PushFont(StyleRepository::get().getMonospaceMediumFont());
         ImGui::PushStyleColor(ImGuiCol_Text, (ImVec4)Const::MonospaceColor);
 
-        for (auto const& logMessage : _logger->getMessages(_verbose ? Priority::Unimportant : Priority::Important) | boost::adaptors::reversed) {
+        auto logMessages = _logger->getMessages(_verbose ? Priority::Unimportant : Priority::Important);
+        for (auto const& logMessage : logMessages | boost::adaptors::reversed) {
             ImGui::TextUnformatted(logMessage.c_str());
         }
         ImGui::PopStyleColor();
@@ -229,7 +229,7 @@ void MainLoopController::processOperatingMode()
     SimulationView::get().processSimulationScrollbars();
     popGlobalStyle();
 
-    FpsController::get().processForceFps(WindowController::get().getFps());
+    FpsController::get().processForceFps(WindowController::get().getFps(), _simulationFacade->isSyncSimulationWithRendering());
 
     if (glfwWindowShouldClose(WindowController::get().getWindowData().window)) {
         scheduleClosing();
@@ -261,7 +261,7 @@ void MainLoopController::processExiting()
     SimulationView::get().processSimulationScrollbars();
     popGlobalStyle();
 
-    FpsController::get().processForceFps(WindowController::get().getFps());
+    FpsController::get().processForceFps(WindowController::get().getFps(), _simulationFacade->isSyncSimulationWithRendering());
 
     auto requestedSimState = _persisterFacade->getRequestState(_saveSimRequestId).value();
     if (requestedSimState == PersisterRequestState::Finished) {
@@ -175,7 +175,7 @@ void SimulationInteractionController::leftMouseButtonPressed(IntVector2D const&
                     _simulationFacade->setDetached(true);
                 }
 
-                auto shallowData = _simulationFacade->getSelectionShallowData();
+                auto const& shallowData = EditorModel::get().getSelectionShallowData();
                 _selectionPositionOnClick = {shallowData.centerPosX, shallowData.centerPosY};
             } else {
                 CreatorWindow::get().onDrawing();
@@ -1,5 +1,7 @@
 #include "SimulationParametersMainWindow.h"
 
+#include <algorithm>
+
 #include <ImFileDialog.h>
 
 #include <Fonts/IconsFontAwesome5.h>
@@ -8,6 +10,7 @@
 #include "EngineInterface/SimulationFacade.h"
 #include "EngineInterface/SimulationParametersEditService.h"
 #include "PersisterInterface/SerializerService.h"
+#include "PersisterInterface/SimulationParametersPatchService.h"
 
 #include "GenericFileDialog.h"
 #include "GenericMessageDialog.h"
@@ -29,6 +32,8 @@ namespace
 
     auto constexpr ExpertWidgetHeight = 130.0f;
     auto constexpr ExpertWidgetMinHeight = 60.0f;
+
+    auto constexpr MaxUndoChanges = 100;
 }
 
 SimulationParametersMainWindow::SimulationParametersMainWindow()
@@ -63,6 +68,14 @@ void SimulationParametersMainWindow::processIntern()
 {
     if (!_sessionId.has_value() || _sessionId.value() != _simulationFacade->getSessionId()) {
         _selectedLocationIndex = 0;
+        _undoChanges.clear();
+        _redoChanges.clear();
+    }
+
+    //the engine also changes parameters (e.g. positions of moving zones), hence only changes during user interactions with this window are recorded
+    std::optional<SimulationParameters> origParameters;
+    if (ImGui::IsWindowFocused(ImGuiFocusedFlags_RootAndChildWindows) && ImGui::IsAnyItemActive()) {
+        origParameters = _simulationFacade->getSimulationParameters();
     }
 
     processToolbar();
@@ -84,6 +97,13 @@ void SimulationParametersMainWindow::processIntern()
 
     processStatusBar();
 
+    auto changeRecorded = false;
+    if (origParameters.has_value() && !_changedByHistory) {
+        changeRecorded = recordChange(*origParameters, _simulationFacade->getSimulationParameters());
+    }
+    _editInProgress = ImGui::IsAnyItemActive() && (changeRecorded || _editInProgress);
+    _changedByHistory = false;
+
     _sessionId = _simulationFacade->getSessionId();
 }
 
@@ -110,6 +130,19 @@ void SimulationParametersMainWindow::processToolbar()
     ImGui::SameLine();
     AlienImGui::ToolbarSeparator();
 
+    ImGui::SameLine();
+    if (AlienImGui::ToolbarButton(AlienImGui::ToolbarButtonParameters().text(ICON_FA_UNDO).tooltip("Undo last change").disabled(_undoChanges.empty()))) {
+        onUndo();
+    }
+
+    ImGui::SameLine();
+    if (AlienImGui::ToolbarButton(AlienImGui::ToolbarButtonParameters().text(ICON_FA_REDO).tooltip("Redo last undone change").disabled(_redoChanges.empty()))) {
+        onRedo();
+    }
+
+    ImGui::SameLine();
+    AlienImGui::ToolbarSeparator();
+
     ImGui::SameLine();
     if (AlienImGui::ToolbarButton(AlienImGui::ToolbarButtonParameters().text(ICON_FA_COPY).tooltip("Copy simulation parameters to clipboard"))) {
         _copiedParameters = _simulationFacade->getSimulationParameters();
@@ -470,6 +503,40 @@ void SimulationParametersMainWindow::onSaveParameters()
         });
 }
 
+void SimulationParametersMainWindow::onUndo()
+{
+    auto change = std::move(_undoChanges.back());
+    _undoChanges.pop_back();
+
+    auto parameters = _simulationFacade->getSimulationParameters();
+    if (!SimulationParametersPatchService::get().applyPatch(parameters, change.undoPatch)) {
+        _redoChanges.clear();
+        GenericMessageDialog::get().information("Undo", "The change cannot be undone because the zones or radiation sources have been changed meanwhile.");
+        return;
+    }
+    _simulationFacade->setSimulationParameters(parameters);
+    _selectedLocationIndex = std::min(_selectedLocationIndex, parameters.numZones + parameters.numRadiationSources);
+    _redoChanges.emplace_back(std::move(change));
+    _changedByHistory = true;
+}
+
+void SimulationParametersMainWindow::onRedo()
+{
+    auto change = std::move(_redoChanges.back());
+    _redoChanges.pop_back();
+
+    auto parameters = _simulationFacade->getSimulationParameters();
+    if (!SimulationParametersPatchService::get().applyPatch(parameters, change.redoPatch)) {
+        _redoChanges.clear();
+        GenericMessageDialog::get().information("Redo", "The change cannot be redone because the zones or radiation sources have been changed meanwhile.");
+        return;
+    }
+    _simulationFacade->setSimulationParameters(parameters);
+    _selectedLocationIndex = std::min(_selectedLocationIndex, parameters.numZones + parameters.numRadiationSources);
+    _undoChanges.emplace_back(std::move(change));
+    _changedByHistory = true;
+}
+
 void SimulationParametersMainWindow::onAddZone()
 {
     auto parameters = _simulationFacade->getSimulationParameters();
@@ -731,6 +798,28 @@ void SimulationParametersMainWindow::updateLocations()
     }
 }
 
+bool SimulationParametersMainWindow::recordChange(SimulationParameters const& origParameters, SimulationParameters const& parameters)
+{
+    auto changedPaths = SimulationParametersPatchService::get().calcChangedPaths(origParameters, parameters);
+    if (changedPaths.empty()) {
+        return false;
+    }
+
+    //continuous edits of the same fields (e.g. dragging a slider) are combined to one change
+    auto redoPatch = SimulationParametersPatchService::get().calcPatch(origParameters, parameters);
+    if (_editInProgress && !_undoChanges.empty() && _undoChanges.back().changedPaths == changedPaths) {
+        _undoChanges.back().redoPatch = std::move(redoPatch);
+    } else {
+        auto undoPatch = SimulationParametersPatchService::get().calcPatch(parameters, origParameters);
+        _undoChanges.emplace_back(Change{std::move(changedPaths), std::move(undoPatch), std::move(redoPatch)});
+        if (toInt(_undoChanges.size()) > MaxUndoChanges) {
+            _undoChanges.pop_front();
+        }
+    }
+    _redoChanges.clear();
+    return true;
+}
+
 void SimulationParametersMainWindow::setDefaultShapeDataForZone(SimulationParametersZone& spot) const
 {
     auto worldSize = _simulationFacade->getWorldSize();
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <deque>
+
 #include "Base/Singleton.h"
 #include "EngineInterface/Definitions.h"
 #include "EngineInterface/SimulationParameters.h"
+#include "PersisterInterface/SimulationParametersPatch.h"
 
 #include "AlienWindow.h"
 #include "SimulationParametersBaseWidgets.h"
@@ -44,6 +47,8 @@ private:
 
     void onOpenParameters();
     void onSaveParameters();
+    void onUndo();
+    void onRedo();
     void onAddZone();
     void onAddSource();
     void onCloneLocation();
@@ -55,6 +60,9 @@ private:
 
     void updateLocations();
 
+    //returns true if a change has been recorded
+    bool recordChange(SimulationParameters const& origParameters, SimulationParameters const& parameters);
+
     void setDefaultShapeDataForZone(SimulationParametersZone& spot) const;
 
     void correctLayout(float origMasterHeight, float origExpertWidgetHeight);
@@ -86,6 +94,18 @@ private:
     std::optional<SimulationParameters> _copiedParameters;
     std::optional<int> _sessionId;
 
+    //undo history of the changes made in this window
+    struct Change
+    {
+        std::vector<std::string> changedPaths;
+        SimulationParametersPatch undoPatch;
+        SimulationParametersPatch redoPatch;
+    };
+    std::deque<Change> _undoChanges;
+    std::vector<Change> _redoChanges;
+    bool _editInProgress = false;
+    bool _changedByHistory = false;
+
     std::vector<Location> _locations;
     int _selectedLocationIndex = 0;
 
@@ -16,6 +16,7 @@
 #include "SimulationInteractionController.h"
 #include "StyleRepository.h"
 #include "CellFunctionStrings.h"
+#include "FpsController.h"
 
 namespace
 {
@@ -147,7 +148,11 @@ void SimulationView::resize(IntVector2D const& size)
 void SimulationView::draw()
 {
     if (_renderSimulation) {
-        updateImageFromSimulation();
+
+        //a minimized window does not need new images unless the simulation is synced with rendering
+        if (!FpsController::get().isRenderingSuspended() || _simulationFacade->isSyncSimulationWithRendering()) {
+            updateImageFromSimulation();
+        }
 
         _shader->use();
 
@@ -285,27 +290,22 @@ void SimulationView::updateImageFromSimulation()
     auto viewSize = Viewport::get().getViewSize();
     auto zoomFactor = Viewport::get().getZoomFactor();
 
+    //the overlay is taken from the latest snapshot and may lag behind the image by one snapshot
     if (zoomFactor >= ZoomFactorForOverlay) {
-        auto overlay = _simulationFacade->tryDrawVectorGraphicsAndReturnOverlay(
-            worldRect.topLeft, worldRect.bottomRight, {viewSize.x, viewSize.y}, zoomFactor);
-        if (overlay) {
-            std::sort(overlay->elements.begin(), overlay->elements.end(), [](OverlayElementDescription const& left, OverlayElementDescription const& right) {
-                return left.id < right.id;
-            });
-            _overlay = overlay;
-        }
+        _simulationFacade->setOverlayRegionForSnapshot(worldRect);
     } else {
-        _simulationFacade->tryDrawVectorGraphics(
-            worldRect.topLeft, worldRect.bottomRight, {viewSize.x, viewSize.y}, zoomFactor);
-        _overlay = std::nullopt;
+        _simulationFacade->setOverlayRegionForSnapshot(std::nullopt);
     }
+    _simulationFacade->tryDrawVectorGraphics(
+        worldRect.topLeft, worldRect.bottomRight, {viewSize.x, viewSize.y}, zoomFactor);
+    _overlay = _simulationFacade->getOverlaySnapshot();
 
     //draw overlay
-    if (_overlay) {
+    if (zoomFactor >= ZoomFactorForOverlay && _overlay->region) {
         ImDrawList* drawList = ImGui::GetBackgroundDrawList();
         auto parameters = _simulationFacade->getSimulationParameters();
         auto timestep = _simulationFacade->getCurrentTimestep();
-        for (auto const& overlayElement : _overlay->elements) {
+        for (auto const& overlayElement : _overlay->overlay.elements) {
             if (_cellDetailOverlayActive && overlayElement.cell) {
                 {
                     auto fontSizeUnit = std::min(40.0f, Viewport::get().getZoomFactor()) / 2;
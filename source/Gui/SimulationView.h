@@ -5,7 +5,7 @@
 #include "Base/Singleton.h"
 #include "Base/Definitions.h"
 #include "EngineInterface/Definitions.h"
-#include "EngineInterface/OverlayDescriptions.h"
+#include "EngineInterface/EngineSnapshots.h"
 
 #include "Definitions.h"
 
@@ -54,7 +54,7 @@ private:
 
     //overlay
     bool _cellDetailOverlayActive = false;
-    std::optional<OverlayDescription> _overlay;
+    std::shared_ptr<OverlaySnapshot const> _overlay;
 
     //shader data
     unsigned int _vao, _vbo, _ebo;
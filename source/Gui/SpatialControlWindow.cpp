@@ -131,7 +131,7 @@ void SpatialControlWindow::processResizeButton()
 void SpatialControlWindow::processCenterOnSelection()
 {
     if (_centerSelection && _simulationFacade->isSimulationRunning()) {
-        auto shallowData = _simulationFacade->getSelectionShallowData();
+        auto shallowData = _simulationFacade->getSelectionShallowDataSnapshot();
         if (shallowData.numCells > 0 || shallowData.numParticles > 0) {
             Viewport::get().setCenterInWorldPos({shallowData.centerPosX, shallowData.centerPosY});
         }
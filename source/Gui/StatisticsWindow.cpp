@@ -296,6 +296,8 @@ void StatisticsWindow::processSettings()
 
 void StatisticsWindow::processTimelineStatistics()
 {
+    updateLongtermStatistics();
+
     ImGui::Spacing();
     AlienImGui::Group("Time step data");
     ImGui::PushID(1);
@@ -480,6 +482,15 @@ void StatisticsWindow::processTimelineStatistics()
     ImGui::PopID();
 }
 
+namespace
+{
+    int getColumn(DataPoint DataPointCollection::*valuesPtr)
+    {
+        DataPointCollection dataPoint;
+        return toInt(reinterpret_cast<double const*>(&(dataPoint.*valuesPtr)) - reinterpret_cast<double const*>(&dataPoint));
+    }
+}
+
 void StatisticsWindow::processPlot(int row, DataPoint DataPointCollection::*valuesPtr, int fracPartDecimals)
 {
     auto isCollapsed = _collapsedPlotIndices.contains(row);
@@ -494,40 +505,60 @@ void StatisticsWindow::processPlot(int row, DataPoint DataPointCollection::*valu
     ImGui::PopID();
     ImGui::SameLine();
 
-    auto const& statisticsHistory = _simulationFacade->getStatisticsHistory();
-
-    std::lock_guard lock(statisticsHistory.getMutex());
-    auto longtermStatistics = &statisticsHistory.getDataRef();
-
-    //create dummy history if empty
-    std::vector dummy = {DataPointCollection()};
-    if (longtermStatistics->empty()) {
-        longtermStatistics = &dummy;
-    }
-
-    auto const& dataPointCollectionHistory = _timelineLiveStatistics.getDataPointCollectionHistory();
-    auto count = _plotMode == 0 ? toInt(dataPointCollectionHistory.size()) : toInt(longtermStatistics->size());
-    auto startTime = _plotMode == 0 ? dataPointCollectionHistory.back().time - toDouble(_timeHorizonForLiveStatistics)
-        : longtermStatistics->back().time - (longtermStatistics->back().time - longtermStatistics->front().time) * toDouble(_timeHorizonForLongtermStatistics) / 100;
-    auto endTime = _plotMode == 0 ? dataPointCollectionHistory.back().time : longtermStatistics->back().time;
-    auto values = _plotMode == 0 ? &(dataPointCollectionHistory[0].*valuesPtr) : &((*longtermStatistics)[0].*valuesPtr);
-    auto timePoints = _plotMode == 0 ? &dataPointCollectionHistory[0].time : &(*longtermStatistics)[0].time;
-    auto systemClock = _plotMode == 0 ? nullptr : &(*longtermStatistics)[0].systemClock;
+    auto const& dataPoints = _plotMode == 0 ? _timelineLiveStatistics.getDataPointCollectionHistory() : _longtermStatistics;
+    auto& decimator = _plotMode == 0 ? _timelineLiveStatistics.getDecimator() : _longtermDecimator;
+    auto startTime = _plotMode == 0 ? dataPoints.back().time - toDouble(_timeHorizonForLiveStatistics) : _longtermStartTime;
+    auto endTime = dataPoints.back().time;
+    auto showSystemClock = _plotMode != 0;
+    auto column = getColumn(valuesPtr);
 
     switch (_plotType) {
     case 0:
-        plotSumColorsIntern(row, values, timePoints, systemClock, count, startTime, endTime, fracPartDecimals);
+        plotSumColorsIntern(row, dataPoints, decimator, column, showSystemClock, startTime, endTime, fracPartDecimals);
         break;
     case 1:
-        plotByColorIntern(row, values, timePoints, count, startTime, endTime, fracPartDecimals);
+        plotByColorIntern(row, dataPoints, decimator, column, startTime, endTime, fracPartDecimals);
         break;
     default:
-        plotForColorIntern(row, values, _plotType - 2, timePoints, systemClock, count, startTime, endTime, fracPartDecimals);
+        plotForColorIntern(row, dataPoints, decimator, column, _plotType - 2, showSystemClock, startTime, endTime, fracPartDecimals);
         break;
     }
     ImGui::Spacing();
 }
 
+void StatisticsWindow::updateLongtermStatistics()
+{
+    auto snapshot = _simulationFacade->getStatisticsHistory().getSnapshot();
+    if (_longtermStatisticsTimeHorizon == _timeHorizonForLongtermStatistics) {
+        if (_longtermStatisticsVersion == snapshot->getVersion()) {
+            return;
+        }
+
+        //new data points are fetched at most as frequently as the live statistics are updated
+        auto timepoint = std::chrono::steady_clock::now();
+        if (_lastLongtermStatisticsTimepoint
+            && std::chrono::duration_cast<std::chrono::milliseconds>(timepoint - *_lastLongtermStatisticsTimepoint).count() <= LiveStatisticsDeltaTime) {
+            return;
+        }
+    }
+    _longtermStatisticsVersion = snapshot->getVersion();
+    _longtermStatisticsTimeHorizon = _timeHorizonForLongtermStatistics;
+    _lastLongtermStatisticsTimepoint = std::chrono::steady_clock::now();
+    _longtermDecimator.clear();
+
+    //create dummy history if empty
+    if (snapshot->isEmpty()) {
+        _longtermStatistics = {DataPointCollection()};
+        _longtermStartTime = 0;
+        return;
+    }
+
+    //only the data points in the time horizon are fetched, preferably from the finer resolution tiers
+    auto endTime = snapshot->getLastDataPoint().time;
+    _longtermStartTime = endTime - (endTime - snapshot->getStartTime()) * toDouble(_timeHorizonForLongtermStatistics) / 100;
+    _longtermStatistics = snapshot->getData(_longtermStartTime);
+}
+
 void StatisticsWindow::processBackground()
 {
     auto timepoint = std::chrono::steady_clock::now();
@@ -543,36 +574,36 @@ void StatisticsWindow::processBackground()
 
 namespace
 {
-    double getMaxWithDataPointStride(double const* data, double const* timePoints, double startTime, int count)
+    //data points at the beginning of the history are not taken into account
+    double getMaxValue(TimelineDecimator& decimator, std::vector<DataPointCollection> const& dataPoints, int column, double startTime)
     {
-        auto constexpr strideDouble = sizeof(DataPointCollection) / sizeof(double);
+        auto count = toInt(dataPoints.size());
+        auto fromIndex = std::max(count / 20, decimator.findFirstIndex(dataPoints, startTime - NEAR_ZERO));
+        return std::max(0.0, decimator.getMaxValue(dataPoints, column, fromIndex, count));
+    }
 
-        auto result = 0.0;
-        for (int i = count / 20; i < count; ++i) {
-            if (timePoints[i * strideDouble] >= startTime - NEAR_ZERO) {
-                result = std::max(result, data[i * strideDouble]);
-            }
-        }
-        return result;
+    //one bucket per pixel of the plot width
+    int getNumPlotBuckets()
+    {
+        return std::max(1, toInt(ImGui::GetContentRegionAvail().x));
     }
 }
 
 void StatisticsWindow::plotSumColorsIntern(
     int row,
-    DataPoint const* dataPoints,
-    double const* timePoints,
-    double const* systemClock,
-    int count,
+    std::vector<DataPointCollection> const& dataPoints,
+    TimelineDecimator& decimator,
+    int column,
+    bool showSystemClock,
     double startTime,
     double endTime,
     int fracPartDecimals)
 {
-    auto constexpr strideBytes = sizeof(DataPointCollection);
-    auto constexpr strideDouble = sizeof(DataPointCollection) / sizeof(double);
-
-    double const* plotDataY = reinterpret_cast<double const*>(dataPoints) + MAX_COLORS;
-    double upperBound = getMaxWithDataPointStride(plotDataY, timePoints, startTime, count);
-    double endValue = count > 0 ? plotDataY[(count - 1) * strideDouble] : 0.0;
+    auto sumColumn = column + MAX_COLORS;
+    auto timeline = decimator.decimate(dataPoints, sumColumn, startTime, endTime, getNumPlotBuckets());
+    auto count = toInt(timeline.values.size());
+    double upperBound = getMaxValue(decimator, dataPoints, sumColumn, startTime);
+    double endValue = count > 0 ? timeline.values.back() : 0.0;
     upperBound = getUpperBound(upperBound);
 
     ImGui::PushID(row);
@@ -595,14 +626,14 @@ void StatisticsWindow::plotSumColorsIntern(
         }
         if (count > 0) {
             ImPlot::PushStyleColor(ImPlotCol_Line, color);
-            ImPlot::PlotLine("##", timePoints, plotDataY, count, 0, 0, strideBytes);
+            ImPlot::PlotLine("##", timeline.timePoints.data(), timeline.values.data(), count);
             ImPlot::PushStyleVar(ImPlotStyleVar_FillAlpha, 0.5f * ImGui::GetStyle().Alpha);
-            ImPlot::PlotShaded("##", timePoints, plotDataY, count, 0, 0, 0, strideBytes);
+            ImPlot::PlotShaded("##", timeline.timePoints.data(), timeline.values.data(), count);
             ImPlot::PopStyleVar();
             ImPlot::PopStyleColor();
         }
         if (ImGui::GetStyle().Alpha == 1.0f && ImPlot::IsPlotHovered() && count > 0) {
-            drawValuesAtMouseCursor(plotDataY, timePoints, systemClock, count, startTime, endTime, upperBound, fracPartDecimals);
+            drawValuesAtMouseCursor(timeline, showSystemClock, startTime, endTime, upperBound, fracPartDecimals);
         }
         ImPlot::EndPlot();
     }
@@ -613,16 +644,16 @@ void StatisticsWindow::plotSumColorsIntern(
 
 void StatisticsWindow::plotByColorIntern(
     int row,
-    DataPoint const* values,
-    double const* timePoints,
-    int count,
+    std::vector<DataPointCollection> const& dataPoints,
+    TimelineDecimator& decimator,
+    int column,
     double startTime,
     double endTime,
     int fracPartDecimals)
 {
     auto upperBound = 0.0;
     for (int i = 0; i < MAX_COLORS; ++i) {
-        upperBound = std::max(upperBound, getMaxWithDataPointStride(reinterpret_cast<double const*>(values) + i, timePoints, startTime, count));
+        upperBound = std::max(upperBound, getMaxValue(decimator, dataPoints, column + i, startTime));
     }
     upperBound = getUpperBound(upperBound);
 
@@ -636,6 +667,7 @@ void StatisticsWindow::plotByColorIntern(
 
     auto isCollapsed = _collapsedPlotIndices.contains(row);
     auto flags = _plotHeight > 159.0f && !isCollapsed ? ImPlotFlags_None : ImPlotFlags_NoLegend;
+    auto numBuckets = getNumPlotBuckets();
     if (ImPlot::BeginPlot("##", ImVec2(-1, scale(calcPlotHeight(row))), flags)) {
         ImPlot::SetupAxis(ImAxis_X1, "", ImPlotAxisFlags_NoTickLabels);
         ImPlot::SetupAxis(ImAxis_Y1, "", ImPlotAxisFlags_NoTickLabels);
@@ -648,9 +680,10 @@ void StatisticsWindow::plotByColorIntern(
             ImColor color(toInt((colorRaw >> 16) & 0xff), toInt((colorRaw >> 8) & 0xff), toInt(colorRaw & 0xff));
 
             ImPlot::PushStyleColor(ImPlotCol_Line, (ImU32)color);
-            auto endValue = count > 0 ? *(reinterpret_cast<double const*>(reinterpret_cast<DataPointCollection const*>(values) + (count - 1)) + i) : 0.0f;
+            auto timeline = decimator.decimate(dataPoints, column + i, startTime, endTime, numBuckets);
+            auto endValue = !timeline.values.empty() ? timeline.values.back() : 0.0;
             auto labelId = StringHelper::format(toFloat(endValue), fracPartDecimals);
-            ImPlot::PlotLine(labelId.c_str(), timePoints, reinterpret_cast<double const*>(values) + i, count, 0, 0, sizeof(DataPointCollection));
+            ImPlot::PlotLine(labelId.c_str(), timeline.timePoints.data(), timeline.values.data(), toInt(timeline.values.size()));
             ImPlot::PopStyleColor();
             ImGui::PopID();
         }
@@ -664,22 +697,21 @@ void StatisticsWindow::plotByColorIntern(
 
 void StatisticsWindow::plotForColorIntern(
     int row,
-    DataPoint const* values,
+    std::vector<DataPointCollection> const& dataPoints,
+    TimelineDecimator& decimator,
+    int column,
     int colorIndex,
-    double const* timePoints,
-    double const* systemClock,
-    int count,
+    bool showSystemClock,
     double startTime,
     double endTime,
     int fracPartDecimals)
 {
-    auto constexpr strideBytes = sizeof(DataPointCollection);
-    auto constexpr strideDouble = sizeof(DataPointCollection) / sizeof(double);
-
-    auto valuesForColor = reinterpret_cast<double const*>(values) + colorIndex;
-    auto upperBound = getMaxWithDataPointStride(valuesForColor, timePoints, startTime, count);
+    auto colorColumn = column + colorIndex;
+    auto timeline = decimator.decimate(dataPoints, colorColumn, startTime, endTime, getNumPlotBuckets());
+    auto count = toInt(timeline.values.size());
+    auto upperBound = getMaxValue(decimator, dataPoints, colorColumn, startTime);
     upperBound = getUpperBound(upperBound);
-    auto endValue = count > 0 ? valuesForColor[(count - 1) * strideDouble] : 0.0;
+    auto endValue = count > 0 ? timeline.values.back() : 0.0;
 
     ImGui::PushID(row);
     ImPlot::PushStyleColor(ImPlotCol_FrameBg, (ImU32)ImColor(0.0f, 0.0f, 0.0f, ImGui::GetStyle().Alpha));
@@ -709,13 +741,13 @@ void StatisticsWindow::plotForColorIntern(
         }
         if (count > 0) {
             ImPlot::PushStyleColor(ImPlotCol_Line, color);
-            ImPlot::PlotLine("##", timePoints, valuesForColor, count, 0, 0, strideBytes);
+            ImPlot::PlotLine("##", timeline.timePoints.data(), timeline.values.data(), count);
             ImPlot::PushStyleVar(ImPlotStyleVar_FillAlpha, 0.5f * ImGui::GetStyle().Alpha);
-            ImPlot::PlotShaded("##", timePoints, valuesForColor, count, 0, 0, 0, strideBytes);
+            ImPlot::PlotShaded("##", timeline.timePoints.data(), timeline.values.data(), count);
             ImPlot::PopStyleVar();
             ImPlot::PopStyleColor();
             if (ImGui::GetStyle().Alpha == 1.0f && ImPlot::IsPlotHovered()) {
-                drawValuesAtMouseCursor(valuesForColor, timePoints, systemClock, count, startTime, endTime, upperBound, fracPartDecimals);
+                drawValuesAtMouseCursor(timeline, showSystemClock, startTime, endTime, upperBound, fracPartDecimals);
             }
         }
         ImPlot::EndPlot();
@@ -774,37 +806,35 @@ namespace
 }
 
 void StatisticsWindow::drawValuesAtMouseCursor(
-    double const* dataPoints,
-    double const* timePoints,
-    double const* systemClock,
-    int count,
+    DecimatedTimeline const& timeline,
+    bool showSystemClock,
     double startTime,
     double endTime,
     double upperBound,
     int fracPartDecimals)
 {
-    auto constexpr stride = sizeof(DataPointCollection) / sizeof(double);
+    auto count = toInt(timeline.values.size());
 
     auto mousePos = ImPlot::GetPlotMousePos();
     mousePos.x = std::max(startTime, std::min(endTime, mousePos.x));
-    mousePos.y = dataPoints[0];
+    mousePos.y = timeline.values[0];
 
     auto dateTimeString =
         [&] {
-        if (systemClock == nullptr) {
+        if (!showSystemClock) {
             for (int i = 1; i < count; ++i) {
-                if (timePoints[i * stride] > mousePos.x) {
-                    mousePos.y = dataPoints[i * stride];
+                if (timeline.timePoints[i] > mousePos.x) {
+                    mousePos.y = timeline.values[i];
                     break;
                 }
             }
             return std::string();
         }
-        auto systemClockEntry = systemClock[0];
+        auto systemClockEntry = timeline.systemClock[0];
         for (int i = 1; i < count; ++i) {
-            if (timePoints[i * stride] > mousePos.x) {
-                mousePos.y = dataPoints[i * stride];
-                systemClockEntry = systemClock[i * stride];
+            if (timeline.timePoints[i] > mousePos.x) {
+                mousePos.y = timeline.values[i];
+                systemClockEntry = timeline.systemClock[i];
                 break;
             }
         }
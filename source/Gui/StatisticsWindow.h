@@ -5,6 +5,8 @@
 #include "Base/Singleton.h"
 #include "EngineInterface/Definitions.h"
 #include "EngineInterface/RawStatisticsData.h"
+#include "EngineInterface/StatisticsHistory.h"
+#include "EngineInterface/TimelineDecimator.h"
 
 #include "Definitions.h"
 #include "AlienWindow.h"
@@ -33,26 +35,35 @@ private:
     void processTimelineStatistics();
 
     void processPlot(int row, DataPoint DataPointCollection::*valuesPtr, int fracPartDecimals = 0);
+    void updateLongtermStatistics();
 
     void processBackground() override;
 
+    //column denotes the position of the plotted DataPoint in DataPointCollection in units of doubles
     void plotSumColorsIntern(
         int row,
-        DataPoint const* dataPoints,
-        double const* timePoints,
-        double const* systemClock,
-        int count,
+        std::vector<DataPointCollection> const& dataPoints,
+        TimelineDecimator& decimator,
+        int column,
+        bool showSystemClock,
+        double startTime,
+        double endTime,
+        int fracPartDecimals);
+    void plotByColorIntern(
+        int row,
+        std::vector<DataPointCollection> const& dataPoints,
+        TimelineDecimator& decimator,
+        int column,
         double startTime,
         double endTime,
         int fracPartDecimals);
-    void plotByColorIntern(int row, DataPoint const* values, double const* timePoints, int count, double startTime, double endTime, int fracPartDecimals);
     void plotForColorIntern(
         int row,
-        DataPoint const* values,
+        std::vector<DataPointCollection> const& dataPoints,
+        TimelineDecimator& decimator,
+        int column,
         int colorIndex,
-        double const* timePoints,
-        double const* systemClock,
-        int count,
+        bool showSystemClock,
         double startTime,
         double endTime,
         int fracPartDecimals);
@@ -61,10 +72,8 @@ private:
     double getUpperBound(double maxValue);
 
     void drawValuesAtMouseCursor(
-        double const* dataPoints,
-        double const* timePoints,
-        double const* systemClock,
-        int count,
+        DecimatedTimeline const& timeline,
+        bool showSystemClock,
         double startTime,
         double endTime,
         double upperBound,
@@ -122,6 +131,12 @@ private:
     float _timeHorizonForLiveStatistics = 10.0f;  //in seconds
     float _timeHorizonForLongtermStatistics = 100.0f;  //in percent
     std::optional<std::chrono::steady_clock::time_point> _lastTimepoint;
+    std::optional<uint64_t> _longtermStatisticsVersion;
+    float _longtermStatisticsTimeHorizon = 0;
+    double _longtermStartTime = 0;
+    std::optional<std::chrono::steady_clock::time_point> _lastLongtermStatisticsTimepoint;
+    StatisticsHistoryData _longtermStatistics;  //data points of the statistics history in the time horizon
+    TimelineDecimator _longtermDecimator;
     TimelineLiveStatistics _timelineLiveStatistics;
     HistogramLiveStatistics _histogramLiveStatistics;
     TableLiveStatistics _tableLiveStatistics;
@@ -5,6 +5,7 @@
 #include "Fonts/IconsFontAwesome5.h"
 
 #include "Base/Definitions.h"
+#include "Base/GlobalSettings.h"
 #include "Base/StringHelper.h"
 #include "EngineInterface/SimulationFacade.h"
 #include "EngineInterface/SpaceCalculator.h"
@@ -18,11 +19,24 @@
 namespace
 {
     auto constexpr LeftColumnWidth = 180.0f;
+    auto constexpr RightColumnWidth = 160.0f;
+
+    uint64_t convertMBToBytes(int value)
+    {
+        return static_cast<uint64_t>(std::max(0, value)) * 1024 * 1024;
+    }
 }
 
 void TemporalControlWindow::initIntern(SimulationFacade simulationFacade)
 {
     _simulationFacade = simulationFacade;
+    _historyMemoryBudget = GlobalSettings::get().getValue("windows.temporal control.history memory budget", _origHistoryMemoryBudget);
+    _history.setMemoryBudget(convertMBToBytes(_historyMemoryBudget));
+}
+
+void TemporalControlWindow::shutdownIntern()
+{
+    GlobalSettings::get().setValue("windows.temporal control.history memory budget", _historyMemoryBudget);
 }
 
 void TemporalControlWindow::onSnapshot()
@@ -32,6 +46,7 @@ void TemporalControlWindow::onSnapshot()
 
 TemporalControlWindow::TemporalControlWindow()
     : AlienWindow("Temporal control", "windows.temporal control", true)
+    , _history(convertMBToBytes(_origHistoryMemoryBudget))
 {
 }
 
@@ -62,6 +77,9 @@ void TemporalControlWindow::processIntern()
 
         AlienImGui::Separator();
         processTpsRestriction();
+
+        AlienImGui::Separator();
+        processHistoryMemoryBudget();
     }
     ImGui::EndChild();
 }
@@ -128,6 +146,22 @@ void TemporalControlWindow::processTpsRestriction()
     ImGui::EndDisabled();
 }
 
+void TemporalControlWindow::processHistoryMemoryBudget()
+{
+    if (AlienImGui::InputInt(
+            AlienImGui::InputIntParameters()
+                .name("Step back memory (MB)")
+                .textWidth(RightColumnWidth)
+                .defaultValue(_origHistoryMemoryBudget)
+                .tooltip("Memory budget for the time steps which can be restored by stepping back. The time steps are stored compressed and only the "
+                         "changes to the previous time step are kept for most of them. The oldest time steps are discarded when the budget is exceeded."),
+            _historyMemoryBudget)) {
+        _history.setMemoryBudget(convertMBToBytes(_historyMemoryBudget));
+    }
+    auto memoryUsage = toFloat(_history.getMemoryUsage()) / (1024 * 1024);
+    AlienImGui::Text(StringHelper::format(memoryUsage, 1) + " MB used for " + std::to_string(_history.getSize()) + " time steps");
+}
+
 void TemporalControlWindow::processRunButton()
 {
     ImGui::BeginDisabled(_simulationFacade->isSimulationRunning());
@@ -155,15 +189,13 @@ void TemporalControlWindow::processPauseButton()
 
 void TemporalControlWindow::processStepBackwardButton()
 {
-    ImGui::BeginDisabled(_history.empty() || _simulationFacade->isSimulationRunning());
+    ImGui::BeginDisabled(_history.isEmpty() || _simulationFacade->isSimulationRunning());
     auto result = AlienImGui::ToolbarButton(AlienImGui::ToolbarButtonParameters().text(ICON_FA_CHEVRON_LEFT));
     AlienImGui::Tooltip("Load previous time step");
     if (result) {
-        auto const& snapshot = _history.back();
-        delayedExecution([this, snapshot] { applySnapshot(snapshot); });
+        auto snapshot = std::make_shared<Snapshot>(_history.pop());
+        delayedExecution([this, snapshot] { applySnapshot(*snapshot); });
         printOverlayMessage("Loading previous time step ...");
-
-        _history.pop_back();
     }
     ImGui::EndDisabled();
 }
@@ -174,7 +206,7 @@ void TemporalControlWindow::processStepForwardButton()
     auto result = AlienImGui::ToolbarButton(AlienImGui::ToolbarButtonParameters().text(ICON_FA_CHEVRON_RIGHT));
     AlienImGui::Tooltip("Process single time step");
     if (result) {
-        _history.emplace_back(createSnapshot());
+        _history.push(createSnapshot());
         _simulationFacade->calcTimesteps(1);
     }
     ImGui::EndDisabled();
@@ -212,7 +244,7 @@ TemporalControlWindow::Snapshot TemporalControlWindow::createSnapshot()
     Snapshot result;
     result.timestep = _simulationFacade->getCurrentTimestep();
     result.realTime = _simulationFacade->getRealTime();
-    result.data = _simulationFacade->getSimulationData();
+    result.data = _simulationFacade->getClusteredSimulationData();
     result.parameters = _simulationFacade->getSimulationParameters();
     return result;
 }
@@ -244,7 +276,7 @@ void TemporalControlWindow::applySnapshot(Snapshot const& snapshot)
     _simulationFacade->setCurrentTimestep(snapshot.timestep);
     _simulationFacade->setRealTime(snapshot.realTime);
     _simulationFacade->clear();
-    _simulationFacade->setSimulationData(snapshot.data);
+    _simulationFacade->setClusteredSimulationData(snapshot.data);
     _simulationFacade->setSimulationParameters(parameters);
 }
 
@@ -6,6 +6,7 @@
 #include "EngineInterface/Definitions.h"
 #include "EngineInterface/Descriptions.h"
 #include "EngineInterface/SimulationParameters.h"
+#include "PersisterInterface/SimulationHistory.h"
 
 #include "Definitions.h"
 #include "AlienWindow.h"
@@ -21,12 +22,14 @@ private:
     TemporalControlWindow();
 
     void initIntern(SimulationFacade simulationFacade) override;
+    void shutdownIntern() override;
     void processIntern();
 
     void processTpsInfo();
     void processTotalTimestepsInfo();
     void processRealTimeInfo();
     void processTpsRestriction();
+    void processHistoryMemoryBudget();
 
     void processRunButton();
     void processPauseButton();
@@ -35,13 +38,7 @@ private:
     void processCreateFlashbackButton();
     void processLoadFlashbackButton();
 
-    struct Snapshot
-    {
-        uint64_t timestep;
-        std::chrono::milliseconds realTime;
-        SimulationParameters parameters;
-        DataDescription data;
-    };
+    using Snapshot = SimulationHistoryEntry;
     Snapshot createSnapshot();
     void applySnapshot(Snapshot const& snapshot);
 
@@ -52,7 +49,9 @@ private:
 
     std::optional<Snapshot> _snapshot;
 
-    std::vector<Snapshot> _history;
+    int _origHistoryMemoryBudget = 1024;  //in MB
+    int _historyMemoryBudget = _origHistoryMemoryBudget;
+    SimulationHistory _history;
 
     bool _slowDown = false;
     int _tpsRestriction = 30;
@@ -12,6 +12,11 @@ std::vector<DataPointCollection> const& TimelineLiveStatistics::getDataPointColl
     return _dataPointCollectionHistory;
 }
 
+TimelineDecimator& TimelineLiveStatistics::getDecimator()
+{
+    return _decimator;
+}
+
 void TimelineLiveStatistics::update(TimelineStatistics const& data, uint64_t timestep)
 {
     truncate();
@@ -32,5 +37,6 @@ void TimelineLiveStatistics::truncate()
 {
     if (!_dataPointCollectionHistory.empty() && _dataPointCollectionHistory.back().time - _dataPointCollectionHistory.front().time > (MaxLiveHistory + 1.0)) {
         _dataPointCollectionHistory.erase(_dataPointCollectionHistory.begin());
+        _decimator.removeFront(1);
     }
 }
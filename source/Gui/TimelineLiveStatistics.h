@@ -7,6 +7,7 @@
 #include "EngineInterface/Colors.h"
 #include "EngineInterface/RawStatisticsData.h"
 #include "EngineInterface/DataPointCollection.h"
+#include "EngineInterface/TimelineDecimator.h"
 
 class TimelineLiveStatistics
 {
@@ -14,6 +15,7 @@ public:
     static auto constexpr MaxLiveHistory = 240.0f;  //in seconds
 
     std::vector<DataPointCollection> const& getDataPointCollectionHistory() const;
+    TimelineDecimator& getDecimator();
     void update(TimelineStatistics const& statistics, uint64_t timestep);
 
 private:
@@ -22,6 +24,7 @@ private:
     double _timeSinceSimStart = 0;  //in seconds
 
     std::vector<DataPointCollection> _dataPointCollectionHistory;
+    TimelineDecimator _decimator;
 
     std::optional<uint64_t> _lastTimestep;
     std::optional<std::chrono::steady_clock::time_point> _lastTimepoint;
@@ -0,0 +1,67 @@
+#include <sstream>
+
+#include <boost/property_tree/json_parser.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include "PersisterInterface/AuxiliaryDataParserService.h"
+
+#include "SyntheticWorlds.h"
+
+namespace
+{
+    void encodeAuxiliaryDataToJson(benchmark::State& state)
+    {
+        auto data = SyntheticWorlds::createAuxiliaryData(1000, toInt(state.range(0)));
+
+        for (auto _ : state) {
+            std::stringstream stream;
+            boost::property_tree::json_parser::write_json(stream, AuxiliaryDataParserService::get().encodeAuxiliaryData(data));
+            benchmark::DoNotOptimize(stream.str());
+        }
+    }
+
+    void decodeAuxiliaryDataFromJson(benchmark::State& state)
+    {
+        auto data = SyntheticWorlds::createAuxiliaryData(1000, toInt(state.range(0)));
+        std::stringstream stream;
+        boost::property_tree::json_parser::write_json(stream, AuxiliaryDataParserService::get().encodeAuxiliaryData(data));
+        auto json = stream.str();
+
+        for (auto _ : state) {
+            std::stringstream inputStream(json);
+            boost::property_tree::ptree tree;
+            boost::property_tree::json_parser::read_json(inputStream, tree);
+            benchmark::DoNotOptimize(AuxiliaryDataParserService::get().decodeAuxiliaryData(tree));
+        }
+    }
+
+    void encodeAuxiliaryDataToJsonStreaming(benchmark::State& state)
+    {
+        auto data = SyntheticWorlds::createAuxiliaryData(1000, toInt(state.range(0)));
+
+        for (auto _ : state) {
+            std::stringstream stream;
+            AuxiliaryDataParserService::get().encodeAuxiliaryDataToJson(data, stream);
+            benchmark::DoNotOptimize(stream.str());
+        }
+    }
+
+    void decodeAuxiliaryDataFromJsonStreaming(benchmark::State& state)
+    {
+        auto data = SyntheticWorlds::createAuxiliaryData(1000, toInt(state.range(0)));
+        std::stringstream stream;
+        AuxiliaryDataParserService::get().encodeAuxiliaryDataToJson(data, stream);
+        auto json = stream.str();
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(AuxiliaryDataParserService::get().decodeAuxiliaryDataFromJson(json));
+        }
+    }
+
+}
+
+BENCHMARK(encodeAuxiliaryDataToJson)->Arg(0)->Arg(MAX_ZONES);
+BENCHMARK(decodeAuxiliaryDataFromJson)->Arg(0)->Arg(MAX_ZONES);
+BENCHMARK(encodeAuxiliaryDataToJsonStreaming)->Arg(0)->Arg(MAX_ZONES);
+BENCHMARK(decodeAuxiliaryDataFromJsonStreaming)->Arg(0)->Arg(MAX_ZONES);
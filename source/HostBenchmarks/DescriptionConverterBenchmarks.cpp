@@ -0,0 +1,88 @@
+#include <unordered_set>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "EngineImpl/DescriptionConverter.h"
+
+#include "SyntheticWorlds.h"
+
+namespace
+{
+    void convertDescriptionToTO(benchmark::State& state)
+    {
+        auto data = SyntheticWorlds::createClusteredWorld(toInt(state.range(0)));
+        DescriptionConverter converter(SimulationParameters{});
+        DataTO dataTO;
+        dataTO.init(converter.getArraySizes(data));
+
+        for (auto _ : state) {
+            *dataTO.numCells = 0;
+            *dataTO.numParticles = 0;
+            *dataTO.numAuxiliaryData = 0;
+            converter.convertDescriptionToTO(dataTO, data);
+        }
+        state.SetItemsProcessed(state.iterations() * *dataTO.numCells);
+        dataTO.destroy();
+    }
+
+    void convertTOToClusteredDescription(benchmark::State& state)
+    {
+        auto data = SyntheticWorlds::createClusteredWorld(toInt(state.range(0)));
+        DescriptionConverter converter(SimulationParameters{});
+        DataTO dataTO;
+        dataTO.init(converter.getArraySizes(data));
+        converter.convertDescriptionToTO(dataTO, data);
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(converter.convertTOtoClusteredDataDescription(dataTO));
+        }
+        state.SetItemsProcessed(state.iterations() * *dataTO.numCells);
+        dataTO.destroy();
+    }
+
+    //cluster reconstruction as done before the union-find, serves as reference for convertTOToClusteredDescription
+    void reconstructClustersByFloodFill(benchmark::State& state)
+    {
+        auto data = SyntheticWorlds::createClusteredWorld(toInt(state.range(0)));
+        DescriptionConverter converter(SimulationParameters{});
+        DataTO dataTO;
+        dataTO.init(converter.getArraySizes(data));
+        converter.convertDescriptionToTO(dataTO, data);
+
+        for (auto _ : state) {
+            std::vector<std::vector<int>> clusters;
+            std::unordered_set<int> freeCellIndices;
+            for (int i = 0; i < toInt(*dataTO.numCells); ++i) {
+                freeCellIndices.insert(i);
+            }
+            while (!freeCellIndices.empty()) {
+                std::vector<int> cellIndices;
+                std::vector<int> currentCellIndices{*freeCellIndices.begin()};
+                freeCellIndices.erase(freeCellIndices.begin());
+                while (!currentCellIndices.empty()) {
+                    std::vector<int> nextCellIndices;
+                    for (auto const& cellIndex : currentCellIndices) {
+                        cellIndices.emplace_back(cellIndex);
+                        auto const& cellTO = dataTO.cells[cellIndex];
+                        for (int i = 0; i < cellTO.numConnections; ++i) {
+                            auto otherIndex = cellTO.connections[i].cellIndex;
+                            if (otherIndex != -1 && freeCellIndices.erase(otherIndex) > 0) {
+                                nextCellIndices.emplace_back(otherIndex);
+                            }
+                        }
+                    }
+                    currentCellIndices = nextCellIndices;
+                }
+                clusters.emplace_back(cellIndices);
+            }
+            benchmark::DoNotOptimize(clusters);
+        }
+        state.SetItemsProcessed(state.iterations() * *dataTO.numCells);
+        dataTO.destroy();
+    }
+}
+
+BENCHMARK(convertDescriptionToTO)->Arg(100)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+BENCHMARK(convertTOToClusteredDescription)->Arg(100)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+BENCHMARK(reconstructClustersByFloodFill)->Arg(100)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
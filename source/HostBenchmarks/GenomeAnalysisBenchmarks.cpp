@@ -0,0 +1,42 @@
+#include <benchmark/benchmark.h>
+
+#include "Base/ThreadPool.h"
+
+#include "EngineInterface/GenomeAnalysis.h"
+#include "EngineImpl/GenomeBatchAnalyzer.h"
+
+#include "SyntheticWorlds.h"
+
+namespace
+{
+    void getNumNodesRecursivelyOnHost(benchmark::State& state)
+    {
+        auto genome = SyntheticWorlds::createNestedGenome(toInt(state.range(0)), 20);
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(GenomeAnalysis::getNumNodesRecursively(genome.data(), toInt(genome.size()), true, true));
+        }
+        state.SetBytesProcessed(state.iterations() * genome.size());
+    }
+
+    void analyzeGenomeBatch(benchmark::State& state)
+    {
+        std::vector<std::vector<uint8_t>> genomes;
+        for (int i = 0; i < 16; ++i) {
+            genomes.emplace_back(SyntheticWorlds::createNestedGenome(1 + i % 5, 10 + i));
+        }
+        std::vector<std::span<uint8_t const>> genomeBatch;
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            genomeBatch.emplace_back(genomes.at(i % genomes.size()));
+        }
+        ThreadPool threadPool(0);
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(GenomeBatchAnalyzer::analyze(genomeBatch, threadPool));
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+}
+
+BENCHMARK(getNumNodesRecursivelyOnHost)->Arg(2)->Arg(5)->Arg(10);
+BENCHMARK(analyzeGenomeBatch)->Arg(1000)->Arg(10000)->Arg(100000);
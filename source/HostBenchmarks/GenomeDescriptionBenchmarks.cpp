@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+
+#include "EngineInterface/GenomeDescriptionService.h"
+
+#include "SyntheticWorlds.h"
+
+namespace
+{
+    void encodeGenome(benchmark::State& state)
+    {
+        auto genome = GenomeDescriptionService::get().convertBytesToDescription(SyntheticWorlds::createGenome(toInt(state.range(0))));
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(GenomeDescriptionService::get().convertDescriptionToBytes(genome));
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void decodeGenome(benchmark::State& state)
+    {
+        auto genome = SyntheticWorlds::createGenome(toInt(state.range(0)));
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(GenomeDescriptionService::get().convertBytesToDescription(genome));
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void getNumNodesRecursively(benchmark::State& state)
+    {
+        auto genome = SyntheticWorlds::createNestedGenome(toInt(state.range(0)), 20);
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(GenomeDescriptionService::get().getNumNodesRecursively(genome, true));
+        }
+    }
+
+    //typical access pattern of the genome editor: address of each node in turn on a node index built once
+    void convertNodeIndexToNodeAddress(benchmark::State& state)
+    {
+        auto genome = SyntheticWorlds::createNestedGenome(toInt(state.range(0)), 20);
+        auto nodeIndex = GenomeDescriptionService::get().createNodeIndex(genome);
+
+        for (auto _ : state) {
+            for (int index = 0; index <= 20; ++index) {
+                benchmark::DoNotOptimize(GenomeDescriptionService::get().convertNodeIndexToNodeAddress(nodeIndex, index));
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * 21);
+    }
+}
+
+BENCHMARK(encodeGenome)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK(decodeGenome)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK(getNumNodesRecursively)->Arg(2)->Arg(5)->Arg(10);
+BENCHMARK(convertNodeIndexToNodeAddress)->Arg(2)->Arg(5)->Arg(10);
@@ -0,0 +1,40 @@
+#include <atomic>
+
+#include <benchmark/benchmark.h>
+
+#include "Base/Definitions.h"
+#include "Base/LoggingService.h"
+
+namespace
+{
+    class CountingCallBack : public LoggingCallBack
+    {
+    public:
+        void newLogMessage(Priority priority, std::string const& message) override { _numMessages.fetch_add(1, std::memory_order_relaxed); }
+
+        std::atomic<uint64_t> _numMessages = 0;
+    };
+
+    //measures the cost at the caller, the messages are passed to the callback on the logging thread
+    void logFromMultipleThreads(benchmark::State& state)
+    {
+        static CountingCallBack callback;
+        if (state.thread_index() == 0) {
+            LoggingService::get().registerCallBack(&callback);
+        }
+
+        auto message = std::string("simulation step finished with ") + std::to_string(state.thread_index()) + " errors";
+        for (auto _ : state) {
+            LoggingService::get().log(Priority::Unimportant, message);
+        }
+
+        if (state.thread_index() == 0) {
+            LoggingService::get().flush();
+            LoggingService::get().unregisterCallBack(&callback);
+            state.counters["dropped"] = toDouble(LoggingService::get().getNumDroppedMessages());
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+}
+
+BENCHMARK(logFromMultipleThreads)->Threads(1)->Threads(2)->Threads(4)->Threads(8)->UseRealTime();
@@ -0,0 +1,27 @@
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Base/Definitions.h"
+
+int main(int argc, char** argv)
+{
+    //results are reported as json unless another format is requested, so that they can be compared across releases
+    std::vector<char*> arguments(argv, argv + argc);
+    std::string formatArgument = "--benchmark_format=json";
+    if (std::none_of(arguments.begin(), arguments.end(), [](char* argument) { return std::string_view(argument).starts_with("--benchmark_format"); })) {
+        arguments.insert(arguments.begin() + 1, formatArgument.data());
+    }
+
+    auto numArguments = toInt(arguments.size());
+    benchmark::Initialize(&numArguments, arguments.data());
+    if (benchmark::ReportUnrecognizedArguments(numArguments, arguments.data())) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
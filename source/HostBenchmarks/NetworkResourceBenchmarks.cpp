@@ -0,0 +1,21 @@
+#include <benchmark/benchmark.h>
+
+#include "Network/NetworkResourceService.h"
+#include "Network/NetworkResourceTreeTO.h"
+
+#include "SyntheticWorlds.h"
+
+namespace
+{
+    void createTreeTOs(benchmark::State& state)
+    {
+        auto rawTOs = SyntheticWorlds::createNetworkResources(toInt(state.range(0)));
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(NetworkResourceService::get().createTreeTOs(rawTOs, {}));
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+}
+
+BENCHMARK(createTreeTOs)->Arg(100)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
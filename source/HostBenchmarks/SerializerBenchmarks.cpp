@@ -0,0 +1,55 @@
+#include <filesystem>
+
+#include <benchmark/benchmark.h>
+
+#include "PersisterInterface/SerializerService.h"
+
+#include "SyntheticWorlds.h"
+
+namespace
+{
+    DeserializedSimulation createSimulation(int numCreatures)
+    {
+        DeserializedSimulation result;
+        result.mainData = SyntheticWorlds::createClusteredWorld(numCreatures);
+        result.auxiliaryData = SyntheticWorlds::createAuxiliaryData(numCreatures, 0);
+        return result;
+    }
+
+    std::filesystem::path getFilename()
+    {
+        return std::filesystem::temp_directory_path() / "alien_host_benchmark.sim";
+    }
+
+    void saveSimulation(benchmark::State& state)
+    {
+        auto simulation = createSimulation(toInt(state.range(0)));
+
+        for (auto _ : state) {
+            if (!SerializerService::get().serializeSimulationToFiles(getFilename(), simulation)) {
+                state.SkipWithError("Simulation could not be saved.");
+                break;
+            }
+        }
+        state.SetBytesProcessed(state.iterations() * std::filesystem::file_size(getFilename()));
+        SerializerService::get().deleteSimulation(getFilename());
+    }
+
+    void loadSimulation(benchmark::State& state)
+    {
+        SerializerService::get().serializeSimulationToFiles(getFilename(), createSimulation(toInt(state.range(0))));
+
+        for (auto _ : state) {
+            DeserializedSimulation simulation;
+            if (!SerializerService::get().deserializeSimulationFromFiles(simulation, getFilename())) {
+                state.SkipWithError("Simulation could not be loaded.");
+                break;
+            }
+        }
+        state.SetBytesProcessed(state.iterations() * std::filesystem::file_size(getFilename()));
+        SerializerService::get().deleteSimulation(getFilename());
+    }
+}
+
+BENCHMARK(saveSimulation)->Arg(100)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+BENCHMARK(loadSimulation)->Arg(100)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
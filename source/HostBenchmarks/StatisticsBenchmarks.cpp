@@ -0,0 +1,27 @@
+#include <benchmark/benchmark.h>
+
+#include "EngineInterface/StatisticsService.h"
+
+#include "SyntheticWorlds.h"
+
+namespace
+{
+    //measures the steady state in which the history is already filled and compacted regularly
+    void addDataPoint(benchmark::State& state)
+    {
+        std::vector<TimelineStatistics> rawStatistics;
+        for (int i = 0; i < 100; ++i) {
+            rawStatistics.emplace_back(SyntheticWorlds::createTimelineStatistics(i));
+        }
+
+        StatisticsHistory history;
+        uint64_t timestep = 0;
+        for (auto _ : state) {
+            StatisticsService::get().addDataPoint(history, rawStatistics.at(timestep % rawStatistics.size()), timestep * state.range(0));
+            ++timestep;
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+}
+
+BENCHMARK(addDataPoint)->Arg(1)->Arg(100);
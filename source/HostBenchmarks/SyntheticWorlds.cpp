@@ -0,0 +1,147 @@
+#include "SyntheticWorlds.h"
+
+#include <cmath>
+
+#include "Base/NumberGenerator.h"
+#include "EngineInterface/DescriptionEditService.h"
+#include "EngineInterface/GenomeDescriptionService.h"
+
+namespace
+{
+    void addCellFunctions(DataDescription& creature, std::vector<uint8_t> const& genome)
+    {
+        for (int i = 0; i < toInt(creature.cells.size()); ++i) {
+            if (i % 8 == 0) {
+                creature.cells.at(i).setCellFunction(ConstructorDescription().setGenome(genome));
+            } else if (i % 8 == 1) {
+                creature.cells.at(i).setCellFunction(NeuronDescription());
+            }
+        }
+    }
+}
+
+DataDescription SyntheticWorlds::createWorld(int numCreatures)
+{
+    auto genome = createGenome(20);
+
+    auto rect = DescriptionEditService::get().createRect(DescriptionEditService::CreateRectParameters().width(5).height(4).randomCreatureId(false));
+    addCellFunctions(rect, genome);
+    auto hex = DescriptionEditService::get().createHex(DescriptionEditService::CreateHexParameters().layers(3).randomCreatureId(false));
+    addCellFunctions(hex, genome);
+
+    NumberGenerator::get().setSeed(Seed);
+    auto worldSize = getWorldSize(numCreatures);
+    auto numRects = numCreatures / 2;
+    auto numHexes = numCreatures - numRects;
+    bool overlappingCheckSuccessful;
+    DataDescription result;
+    if (numRects > 0) {
+        result.add(DescriptionEditService::get().randomMultiply(
+            rect, DescriptionEditService::RandomMultiplyParameters().number(numRects - 1), worldSize, {}, overlappingCheckSuccessful));
+    }
+    if (numHexes > 0) {
+        result.add(DescriptionEditService::get().randomMultiply(
+            hex, DescriptionEditService::RandomMultiplyParameters().number(numHexes - 1), worldSize, {}, overlappingCheckSuccessful));
+    }
+    return result;
+}
+
+ClusteredDataDescription SyntheticWorlds::createClusteredWorld(int numCreatures)
+{
+    ClusteredDataDescription result;
+    result.addCluster(ClusterDescription().addCells(createWorld(numCreatures).cells));
+    return result;
+}
+
+IntVector2D SyntheticWorlds::getWorldSize(int numCreatures)
+{
+    auto size = std::max(100, toInt(std::sqrt(toFloat(numCreatures)) * 20));
+    return {size, size};
+}
+
+AuxiliaryData SyntheticWorlds::createAuxiliaryData(int numCreatures, int numZones)
+{
+    AuxiliaryData result;
+    auto worldSize = getWorldSize(numCreatures);
+    result.realTime = std::chrono::milliseconds(0);
+    result.center = {toFloat(worldSize.x) / 2, toFloat(worldSize.y) / 2};
+    result.generalSettings.worldSizeX = worldSize.x;
+    result.generalSettings.worldSizeY = worldSize.y;
+    result.simulationParameters.numZones = numZones;
+    return result;
+}
+
+std::vector<uint8_t> SyntheticWorlds::createGenome(int numNodes)
+{
+    std::vector<CellGenomeDescription> nodes;
+    for (int i = 0; i < numNodes; ++i) {
+        CellGenomeDescription node;
+        switch (i % 4) {
+        case 0:
+            node.setCellFunction(NeuronGenomeDescription());
+            break;
+        case 1:
+            node.setCellFunction(NerveGenomeDescription().setPulseMode(i % 5));
+            break;
+        case 2:
+            node.setCellFunction(SensorGenomeDescription().setMinDensity(0.1f));
+            break;
+        default:
+            node.setCellFunction(MuscleGenomeDescription());
+            break;
+        }
+        nodes.emplace_back(node.setColor(i % MAX_COLORS).setExecutionOrderNumber(i % 6));
+    }
+    return GenomeDescriptionService::get().convertDescriptionToBytes(GenomeDescription().setCells(nodes));
+}
+
+std::vector<uint8_t> SyntheticWorlds::createNestedGenome(int depth, int numNodes)
+{
+    std::vector<uint8_t> result;
+    for (int level = 0; level < depth; ++level) {
+        auto genome = GenomeDescriptionService::get().convertBytesToDescription(createGenome(numNodes));
+        genome.cells.emplace_back(CellGenomeDescription().setCellFunction(ConstructorGenomeDescription().setGenome(result)));
+        genome.header.setNumRepetitions(2);
+        result = GenomeDescriptionService::get().convertDescriptionToBytes(genome);
+    }
+    return result;
+}
+
+TimelineStatistics SyntheticWorlds::createTimelineStatistics(uint64_t timestep)
+{
+    TimelineStatistics result;
+    for (int i = 0; i < MAX_COLORS; ++i) {
+        result.timestep.numCells[i] = toInt(1000 + timestep % 100 + i);
+        result.timestep.numParticles[i] = toInt(500 + timestep % 50);
+        result.timestep.totalEnergy[i] = toFloat(100000 + timestep % 1000);
+        result.accumulated.numCreatedCells[i] = timestep * 2 + i;
+        result.accumulated.numNeuronActivities[i] = timestep * 10 + i;
+    }
+    return result;
+}
+
+std::vector<NetworkResourceRawTO> SyntheticWorlds::createNetworkResources(int numResources)
+{
+    NumberGenerator::get().setSeed(Seed);
+    std::vector<NetworkResourceRawTO> result;
+    result.reserve(numResources);
+    auto& numberGenerator = NumberGenerator::get();
+    for (int i = 0; i < numResources; ++i) {
+        auto resource = std::make_shared<_NetworkResourceRawTO>();
+        resource->id = std::to_string(i);
+        resource->timestamp = "2024-01-01 00:00:00";
+        resource->userName = "user" + std::to_string(numberGenerator.getRandomInt(50));
+        auto folderName = "folder" + std::to_string(numberGenerator.getRandomInt(10)) + "/sub" + std::to_string(numberGenerator.getRandomInt(5));
+        resource->resourceName = folderName + "/simulation" + std::to_string(i);
+        resource->numDownloads = toInt(numberGenerator.getRandomInt(1000));
+        resource->width = 1000;
+        resource->height = 1000;
+        resource->particles = 0;
+        resource->contentSize = 1000000;
+        resource->version = "4.12.0";
+        resource->workspaceType = WorkspaceType_Public;
+        resource->resourceType = NetworkResourceType_Simulation;
+        result.emplace_back(resource);
+    }
+    return result;
+}
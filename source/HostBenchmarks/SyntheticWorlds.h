@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Base/Definitions.h"
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/RawStatisticsData.h"
+#include "Network/NetworkResourceRawTO.h"
+#include "PersisterInterface/AuxiliaryData.h"
+
+/**
+ * Reproducible inputs for the benchmarks: the random number generator is seeded with a fixed value on each call,
+ * so that the same arguments always yield the same content.
+ */
+class SyntheticWorlds
+{
+public:
+    //rectangular and hexagonal creatures with constructors and neurons, randomly distributed in a world whose size grows with numCreatures
+    static DataDescription createWorld(int numCreatures);
+    static ClusteredDataDescription createClusteredWorld(int numCreatures);
+    static IntVector2D getWorldSize(int numCreatures);
+    static AuxiliaryData createAuxiliaryData(int numCreatures, int numZones);
+
+    static std::vector<uint8_t> createGenome(int numNodes);
+    //each level consists of numNodes nodes and a constructor with the genome of the next level
+    static std::vector<uint8_t> createNestedGenome(int depth, int numNodes);
+
+    static TimelineStatistics createTimelineStatistics(uint64_t timestep);
+
+    static std::vector<NetworkResourceRawTO> createNetworkResources(int numResources);
+
+private:
+    static auto constexpr Seed = 42;
+};
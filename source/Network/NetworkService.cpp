@@ -1,6 +1,12 @@
 #include "NetworkService.h"
 
+#include <cstring>
+#include <filesystem>
+#include <list>
+#include <mutex>
 #include <ranges>
+#include <string_view>
+#include <thread>
 #include <boost/property_tree/json_parser.hpp>
 
 #define CPPHTTPLIB_OPENSSL_SUPPORT
@@ -17,32 +23,120 @@
 namespace
 {
     auto constexpr RefreshInterval = 20;  //in minutes
-    auto constexpr MaxChunkSize = 24 * 1024 * 1024;
+    size_t constexpr MaxChunkSize = 24 * 1024 * 1024;
 
-    void configureClient(httplib::SSLClient& client)
+    auto constexpr MaxAttempts = 5;
+    auto constexpr MaxChunksInFlight = 4;
+    auto constexpr MaxNumDownloadChunks = 6;
+
+    //server addresses without scheme refer to an alien-server via https, "http://host:port" addresses are used for local servers
+    httplib::Client createClient(std::string const& serverAddress)
     {
-        client.set_ca_cert_path("./resources/ca-bundle.crt");
-        client.enable_server_certificate_verification(true);
-        if (auto result = client.get_openssl_verify_result()) {
-            throw std::runtime_error("OpenSSL verify error: " + std::string(X509_verify_cert_error_string(result)));
+        auto isLocal = serverAddress.starts_with("http://");
+        httplib::Client result(serverAddress.find("://") != std::string::npos ? serverAddress : "https://" + serverAddress);
+        if (!isLocal) {
+            result.set_ca_cert_path("./resources/ca-bundle.crt");
+            result.enable_server_certificate_verification(true);
+            if (auto verifyResult = result.get_openssl_verify_result()) {
+                throw std::runtime_error("OpenSSL verify error: " + std::string(X509_verify_cert_error_string(verifyResult)));
+            }
         }
+        return result;
     }
 
-    httplib::Result executeRequest(std::function<httplib::Result()> const& func, bool withRetry = true)
+    //requests are sent again after dropped connections and transient server errors if withRetry is set,
+    //which must only be done for read-only requests and chunk transfers since the server may already have processed a failed request
+    httplib::Result executeRequest(std::function<httplib::Result()> const& func, bool withRetry)
     {
         auto attempt = 0;
         while (true) {
             auto result = func();
-            if (result) {
+            if (result && result->status < 500) {
                 return result;
             }
-            if (++attempt == 5 || !withRetry) {
+            if (++attempt == MaxAttempts || !withRetry) {
                 throw std::runtime_error("Error connecting to the server.");
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            std::this_thread::sleep_for(std::chrono::milliseconds(100 * attempt));
+        }
+    }
+
+    //calls func on numThreads threads including the calling thread
+    void runInParallel(int numThreads, std::function<void()> const& func)
+    {
+        std::vector<std::thread> threads;
+        for (int i = 1; i < numThreads; ++i) {
+            threads.emplace_back(func);
+        }
+        func();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    std::vector<std::string_view> splitIntoChunks(std::string const& data)
+    {
+        std::vector<std::string_view> result{std::string_view(data).substr(0, MaxChunkSize)};
+        for (size_t i = MaxChunkSize; i < data.size(); i += MaxChunkSize) {
+            result.emplace_back(std::string_view(data).substr(i, MaxChunkSize));
         }
+        return result;
     }
 
+    //multipart form data whose contents may refer to buffers of the caller, hence large contents are streamed without copying
+    class MultipartFormDataBody
+    {
+    public:
+        MultipartFormDataBody()
+            : _boundary(httplib::detail::make_multipart_data_boundary())
+            , _closing("--" + _boundary + "--\r\n")
+        {}
+
+        void addValue(std::string const& name, std::string const& value) { addContent(name, _values.emplace_back(value)); }
+
+        void addContent(std::string const& name, std::string_view const& content, std::string const& contentType = "")
+        {
+            auto& header = _values.emplace_back("--" + _boundary + "\r\nContent-Disposition: form-data; name=\"" + name + "\"\r\n");
+            if (!contentType.empty()) {
+                header += "Content-Type: " + contentType + "\r\n";
+            }
+            header += "\r\n";
+            _segments.emplace_back(header);
+            _segments.emplace_back(content);
+            _segments.emplace_back(LineBreak);
+        }
+
+        httplib::Result post(httplib::Client& client, char const* path) const
+        {
+            auto segments = _segments;
+            segments.emplace_back(_closing);
+
+            size_t contentLength = 0;
+            for (auto const& segment : segments) {
+                contentLength += segment.size();
+            }
+            auto contentProvider = [&segments](size_t offset, size_t length, httplib::DataSink& sink) {
+                for (auto const& segment : segments) {
+                    if (offset < segment.size()) {
+                        return sink.write(segment.data() + offset, std::min(length, segment.size() - offset));
+                    }
+                    offset -= segment.size();
+                }
+                return false;
+            };
+            auto contentType = "multipart/form-data; boundary=" + _boundary;
+            return client.Post(path, {}, contentLength, contentProvider, contentType.c_str());
+        }
+
+    private:
+        static auto constexpr LineBreak = "\r\n";
+
+        std::string _boundary;
+        std::string _closing;
+        std::list<std::string> _values;  //list keeps the referenced strings in place
+        std::vector<std::string_view> _segments;
+    };
+
     void logNetworkError()
     {
         log(Priority::Important, "network: an error occurred");
@@ -65,11 +159,56 @@ namespace
         }
         return result;
     }
+
+    //length-prefixed strings for the spill files of the download cache
+    std::string serializeStrings(std::vector<std::string> const& strings)
+    {
+        std::string result;
+        for (auto const& string : strings) {
+            uint64_t size = string.size();
+            result.append(reinterpret_cast<char const*>(&size), sizeof(size));
+            result.append(string);
+        }
+        return result;
+    }
+
+    std::vector<std::string> deserializeStrings(std::string const& data)
+    {
+        std::vector<std::string> result;
+        size_t pos = 0;
+        while (pos < data.size()) {
+            uint64_t size = 0;
+            if (data.size() - pos < sizeof(size)) {
+                throw std::runtime_error("Truncated data.");
+            }
+            std::memcpy(&size, data.data() + pos, sizeof(size));
+            pos += sizeof(size);
+            if (data.size() - pos < size) {
+                throw std::runtime_error("Truncated data.");
+            }
+            result.emplace_back(data.substr(pos, size));
+            pos += size;
+        }
+        return result;
+    }
 }
 
 void NetworkService::setup()
 {
     _serverAddress = GlobalSettings::get().getValue("settings.server", std::string(Const::AlienURL));
+    _downloadCache.setSpillTier({
+        .directory = std::filesystem::temp_directory_path() / "alien_download_cache",
+        .maxBytes = DownloadCacheMaxSpilledBytes,
+        .serialize = [](ResourceData const& data) { return serializeStrings({data.content, data.auxiliaryData, data.statistics}); },
+        .deserialize =
+            [](std::string const& data) {
+                auto strings = deserializeStrings(data);
+                if (strings.size() != 3) {
+                    throw std::runtime_error("Invalid resource data.");
+                }
+                return ResourceData{strings.at(0), strings.at(1), strings.at(2)};
+            },
+    });
 }
 
 void NetworkService::shutdown()
@@ -108,8 +247,7 @@ bool NetworkService::createUser(std::string const& userName, std::string const&
 {
     log(Priority::Important, "network: create user '" + userName + "'");
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    auto client = createClient(_serverAddress);
 
     httplib::Params params;
     params.emplace("userName", userName);
@@ -117,7 +255,7 @@ bool NetworkService::createUser(std::string const& userName, std::string const&
     params.emplace("email", email);
 
     try {
-        auto result = executeRequest([&] { return client.Post("/alien-server/createuser.php", params); });
+        auto result = executeRequest([&] { return client.Post("/alien-server/createuser.php", params); }, false);
         return parseBoolResult(result->body);
     } catch (...) {
         logNetworkError();
@@ -129,8 +267,7 @@ bool NetworkService::activateUser(std::string const& userName, std::string const
 {
     log(Priority::Important, "network: activate user '" + userName + "'");
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    auto client = createClient(_serverAddress);
 
     httplib::Params params;
     params.emplace("userName", userName);
@@ -141,7 +278,7 @@ bool NetworkService::activateUser(std::string const& userName, std::string const
     }
 
     try {
-        auto result = executeRequest([&] { return client.Post("/alien-server/activateuser.php", params); });
+        auto result = executeRequest([&] { return client.Post("/alien-server/activateuser.php", params); }, false);
         return parseBoolResult(result->body);
     } catch (...) {
         logNetworkError();
@@ -153,8 +290,7 @@ bool NetworkService::login(LoginErrorCode& errorCode, std::string const& userNam
 {
     log(Priority::Important, "network: login user '" + userName + "'");
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    auto client = createClient(_serverAddress);
 
     httplib::Params params;
     params.emplace("userName", userName);
@@ -164,7 +300,7 @@ bool NetworkService::login(LoginErrorCode& errorCode, std::string const& userNam
     }
 
     try {
-        auto result = executeRequest([&] { return client.Post("/alien-server/login.php", params); });
+        auto result = executeRequest([&] { return client.Post("/alien-server/login.php", params); }, true);
 
         auto boolResult = parseBoolResult(result->body);
         if (boolResult) {
@@ -191,15 +327,14 @@ bool NetworkService::logout()
     bool result = true;
 
     if (_loggedInUserName && _password) {
-        httplib::SSLClient client(_serverAddress);
-        configureClient(client);
+        auto client = createClient(_serverAddress);
 
         httplib::Params params;
         params.emplace("userName", *_loggedInUserName);
         params.emplace("password", *_password);
 
         try {
-            result = executeRequest([&] { return client.Post("/alien-server/logout.php", params); });
+            result = executeRequest([&] { return client.Post("/alien-server/logout.php", params); }, true);
         } catch (...) {
             logNetworkError();
             result = false;
@@ -216,15 +351,14 @@ void NetworkService::refreshLogin()
     if (_loggedInUserName && _password) {
         log(Priority::Important, "network: refresh login");
 
-        httplib::SSLClient client(_serverAddress);
-        configureClient(client);
+        auto client = createClient(_serverAddress);
 
         httplib::Params params;
         params.emplace("userName", *_loggedInUserName);
         params.emplace("password", *_password);
 
         try {
-            executeRequest([&] { return client.Post("/alien-server/refreshlogin.php", params); });
+            executeRequest([&] { return client.Post("/alien-server/refreshlogin.php", params); }, true);
         } catch (...) {
         }
     }
@@ -234,15 +368,14 @@ bool NetworkService::deleteUser()
 {
     log(Priority::Important, "network: delete user '" + *_loggedInUserName + "'");
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    auto client = createClient(_serverAddress);
 
     httplib::Params params;
     params.emplace("userName", *_loggedInUserName);
     params.emplace("password", *_password);
 
     try {
-        auto postResult = executeRequest([&] { return client.Post("/alien-server/deleteuser.php", params); });
+        auto postResult = executeRequest([&] { return client.Post("/alien-server/deleteuser.php", params); }, false);
 
         auto result = parseBoolResult(postResult->body);
         if (result) {
@@ -259,15 +392,14 @@ bool NetworkService::resetPassword(std::string const& userName, std::string cons
 {
     log(Priority::Important, "network: reset password of user '" + userName + "'");
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    auto client = createClient(_serverAddress);
 
     httplib::Params params;
     params.emplace("userName", userName);
     params.emplace("email", email);
 
     try {
-        auto result = executeRequest([&] { return client.Post("/alien-server/resetpw.php", params); });
+        auto result = executeRequest([&] { return client.Post("/alien-server/resetpw.php", params); }, false);
         return parseBoolResult(result->body);
     } catch (...) {
         logNetworkError();
@@ -279,8 +411,7 @@ bool NetworkService::setNewPassword(std::string const& userName, std::string con
 {
     log(Priority::Important, "network: set new password for user '" + userName + "'");
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    auto client = createClient(_serverAddress);
 
     httplib::Params params;
     params.emplace("userName", userName);
@@ -288,7 +419,7 @@ bool NetworkService::setNewPassword(std::string const& userName, std::string con
     params.emplace("activationCode", confirmationCode);
 
     try {
-        auto result = executeRequest([&] { return client.Post("/alien-server/setnewpw.php", params); });
+        auto result = executeRequest([&] { return client.Post("/alien-server/setnewpw.php", params); }, false);
         return parseBoolResult(result->body);
     } catch (...) {
         logNetworkError();
@@ -300,8 +431,7 @@ bool NetworkService::getNetworkResources(std::vector<NetworkResourceRawTO>& resu
 {
     log(Priority::Important, "network: get resource list");
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    auto client = createClient(_serverAddress);
 
     httplib::Params params;
     params.emplace("version", Const::ProgramVersion);
@@ -328,8 +458,7 @@ bool NetworkService::getUserList(std::vector<UserTO>& result, bool withRetry)
 {
     log(Priority::Important, "network: get user list");
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    auto client = createClient(_serverAddress);
 
     try {
         httplib::Params params;
@@ -354,15 +483,14 @@ bool NetworkService::getEmojiTypeByResourceId(std::unordered_map<std::string, in
 {
     log(Priority::Important, "network: get liked resources");
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    auto client = createClient(_serverAddress);
 
     httplib::Params params;
     params.emplace("userName", *_loggedInUserName);
     params.emplace("password", *_password);
 
     try {
-        auto postResult = executeRequest([&] { return client.Post("/alien-server/getlikedsimulations.php", params); });
+        auto postResult = executeRequest([&] { return client.Post("/alien-server/getlikedsimulations.php", params); }, true);
 
         std::stringstream stream(postResult->body);
         boost::property_tree::ptree tree;
@@ -383,15 +511,14 @@ bool NetworkService::getUserNamesForResourceAndEmojiType(std::set<std::string>&
 {
     log(Priority::Important, "network: get user reactions for resource with id=" + simId + " and reaction type=" + std::to_string(likeType));
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    auto client = createClient(_serverAddress);
 
     httplib::Params params;
     params.emplace("simId", simId);
     params.emplace("likeType", std::to_string(likeType));
 
     try {
-        auto postResult = executeRequest([&] { return client.Post("/alien-server/getuserlikes.php", params); });
+        auto postResult = executeRequest([&] { return client.Post("/alien-server/getuserlikes.php", params); }, true);
 
         std::stringstream stream(postResult->body);
         boost::property_tree::ptree tree;
@@ -412,8 +539,7 @@ bool NetworkService::toggleReactionForResource(std::string const& simId, int lik
 {
     log(Priority::Important, "network: toggle like for resource with id=" + simId);
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    auto client = createClient(_serverAddress);
 
     httplib::Params params;
     params.emplace("userName", *_loggedInUserName);
@@ -423,7 +549,7 @@ bool NetworkService::toggleReactionForResource(std::string const& simId, int lik
 
 
     try {
-        auto result = executeRequest([&] { return client.Post("/alien-server/togglelikesimulation.php", params); });
+        auto result = executeRequest([&] { return client.Post("/alien-server/togglelikesimulation.php", params); }, false);
         return parseBoolResult(result->body);
     } catch (...) {
         logNetworkError();
@@ -445,35 +571,27 @@ bool NetworkService::uploadResource(
 {
     log(Priority::Important, "network: upload resource with name='" + resourceName + "'");
 
-    std::vector<std::string> chunks;
-
-    for (size_t i = 0; i < mainData.length(); i += MaxChunkSize) {
-        std::string chunk = mainData.substr(i, MaxChunkSize);
-        chunks.emplace_back(chunk);
-    }
-
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
-
-    httplib::MultipartFormDataItems items = {
-        {"userName", *_loggedInUserName, "", ""},
-        {"password", *_password, "", ""},
-        {"simName", resourceName, "", ""},
-        {"simDesc", description, "", ""},
-        {"width", std::to_string(worldSize.x), "", ""},
-        {"height", std::to_string(worldSize.y), "", ""},
-        {"particles", std::to_string(numParticles), "", ""},
-        {"version", Const::ProgramVersion, "", ""},
-        {"content", chunks.front(), "", "application/octet-stream"},
-        {"settings", settings, "", ""},
-        {"symbolMap", "", "", ""},
-        {"type", std::to_string(resourceType), "", ""},
-        {"workspace", std::to_string(workspaceType), "", ""},
-        {"statistics", statistics, "", ""},
-    };
+    auto chunks = splitIntoChunks(mainData);
+
+    MultipartFormDataBody body;
+    body.addValue("userName", *_loggedInUserName);
+    body.addValue("password", *_password);
+    body.addValue("simName", resourceName);
+    body.addValue("simDesc", description);
+    body.addValue("width", std::to_string(worldSize.x));
+    body.addValue("height", std::to_string(worldSize.y));
+    body.addValue("particles", std::to_string(numParticles));
+    body.addValue("version", Const::ProgramVersion);
+    body.addContent("content", chunks.front(), "application/octet-stream");
+    body.addContent("settings", settings);
+    body.addValue("symbolMap", "");
+    body.addValue("type", std::to_string(resourceType));
+    body.addValue("workspace", std::to_string(workspaceType));
+    body.addContent("statistics", statistics);
 
     try {
-        auto result = executeRequest([&] { return client.Post("/alien-server/uploadsimulation.php", items); });
+        auto client = createClient(_serverAddress);
+        auto result = executeRequest([&] { return body.post(client, "/alien-server/uploadsimulation.php"); }, false);
         if (parseBoolResult(result->body)) {
             resourceId = parseValueFromKey<std::string>(result->body, "simId");
         } else {
@@ -484,13 +602,9 @@ bool NetworkService::uploadResource(
         return false;
     }
 
-    int index = 1;
-    for (auto const& chunk : chunks | std::views::drop(1)) {
-        if (!appendResourceData(resourceId, chunk, toInt(index))) {
-            deleteResource(resourceId);
-            return false;
-        }
-        ++index;
+    if (!appendResourceData(resourceId, chunks)) {
+        deleteResource(resourceId);
+        return false;
     }
     _downloadCache.insertOrAssign(resourceId, ResourceData{mainData, settings, statistics});
 
@@ -507,31 +621,24 @@ bool NetworkService::replaceResource(
 {
     log(Priority::Important, "network: replace resource with id='" + resourceId + "'");
 
-    std::vector<std::string> chunks;
-    for (size_t i = 0; i < mainData.length(); i += MaxChunkSize) {
-        std::string chunk = mainData.substr(i, MaxChunkSize);
-        chunks.emplace_back(chunk);
-    }
-
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
-
-    httplib::MultipartFormDataItems items = {
-        {"userName", *_loggedInUserName, "", ""},
-        {"password", *_password, "", ""},
-        {"simId", resourceId, "", ""},
-        {"width", std::to_string(worldSize.x), "", ""},
-        {"height", std::to_string(worldSize.y), "", ""},
-        {"particles", std::to_string(numParticles), "", ""},
-        {"version", Const::ProgramVersion, "", ""},
-        {"content", chunks.front(), "", "application/octet-stream"},
-        {"settings", settings, "", ""},
-        {"symbolMap", "", "", ""},
-        {"statistics", statistics, "", ""},
-    };
+    auto chunks = splitIntoChunks(mainData);
+
+    MultipartFormDataBody body;
+    body.addValue("userName", *_loggedInUserName);
+    body.addValue("password", *_password);
+    body.addValue("simId", resourceId);
+    body.addValue("width", std::to_string(worldSize.x));
+    body.addValue("height", std::to_string(worldSize.y));
+    body.addValue("particles", std::to_string(numParticles));
+    body.addValue("version", Const::ProgramVersion);
+    body.addContent("content", chunks.front(), "application/octet-stream");
+    body.addContent("settings", settings);
+    body.addValue("symbolMap", "");
+    body.addContent("statistics", statistics);
 
     try {
-        auto result = executeRequest([&] { return client.Post("/alien-server/replacesimulation.php", items); });
+        auto client = createClient(_serverAddress);
+        auto result = executeRequest([&] { return body.post(client, "/alien-server/replacesimulation.php"); }, false);
         if (!parseBoolResult(result->body)) {
             return false;
         }
@@ -540,13 +647,9 @@ bool NetworkService::replaceResource(
         return false;
     }
 
-    int index = 1;
-    for (auto const& chunk : chunks | std::views::drop(1)) {
-        if (!appendResourceData(resourceId, chunk, toInt(index))) {
-            deleteResource(resourceId);
-            return false;
-        }
-        ++index;
+    if (!appendResourceData(resourceId, chunks)) {
+        deleteResource(resourceId);
+        return false;
     }
     _downloadCache.insertOrAssign(resourceId, ResourceData{mainData, settings, statistics});
 
@@ -566,29 +669,18 @@ bool NetworkService::downloadResource(std::string& mainData, std::string& auxili
         } else {
             log(Priority::Important, "network: download resource with id=" + simId);
 
-            httplib::SSLClient client(_serverAddress);
-            configureClient(client);
+            downloadResourceData(mainData, simId);
+
+            auto client = createClient(_serverAddress);
 
             httplib::Params params;
             params.emplace("id", simId);
             {
-                
-                for (int chunkIndex = 0; chunkIndex < 6; ++chunkIndex) {
-                    auto paramsClone = params;
-                    paramsClone.emplace("chunkIndex", std::to_string(chunkIndex));
-                    auto result = executeRequest([&] { return client.Get("/alien-server/downloadcontent.php", paramsClone, {}); });
-                    if (result->body.empty()) {
-                        break;
-                    }
-                    mainData.append(result->body);
-                }
-            }
-            {
-                auto result = executeRequest([&] { return client.Get("/alien-server/downloadsettings.php", params, {}); });
+                auto result = executeRequest([&] { return client.Get("/alien-server/downloadsettings.php", params, {}); }, true);
                 auxiliaryData = result->body;
             }
             {
-                auto result = executeRequest([&] { return client.Get("/alien-server/downloadstatistics.php", params, {}); });
+                auto result = executeRequest([&] { return client.Get("/alien-server/downloadstatistics.php", params, {}); }, true);
                 statistics = result->body;
             }
             _downloadCache.insertOrAssign(simId, ResourceData{mainData, auxiliaryData, statistics});
@@ -605,12 +697,11 @@ void NetworkService::incDownloadCounter(std::string const& simId)
     try {
         log(Priority::Important, "network: increment download counter for resource with id=" + simId);
 
-        httplib::SSLClient client(_serverAddress);
-        configureClient(client);
+        auto client = createClient(_serverAddress);
 
         httplib::Params params;
         params.emplace("id", simId);
-        executeRequest([&] { return client.Get("/alien-server/incdownloadcount.php", params, {}); });
+        executeRequest([&] { return client.Get("/alien-server/incdownloadcount.php", params, {}); }, false);
     }
     catch(...) {
        //do nothing 
@@ -621,8 +712,7 @@ bool NetworkService::editResource(std::string const& simId, std::string const& n
 {
     log(Priority::Important, "network: edit resource with id=" + simId);
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    auto client = createClient(_serverAddress);
 
     httplib::Params params;
     params.emplace("userName", *_loggedInUserName);
@@ -632,7 +722,7 @@ bool NetworkService::editResource(std::string const& simId, std::string const& n
     params.emplace("newDescription", newDescription);
 
     try {
-        auto result = executeRequest([&] { return client.Post("/alien-server/editsimulation.php", params); });
+        auto result = executeRequest([&] { return client.Post("/alien-server/editsimulation.php", params); }, false);
         return parseBoolResult(result->body);
     } catch (...) {
         logNetworkError();
@@ -644,8 +734,7 @@ bool NetworkService::moveResource(std::string const& simId, WorkspaceType target
 {
     log(Priority::Important, "network: move resource with id=" + simId + " to other workspace");
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    auto client = createClient(_serverAddress);
 
     httplib::Params params;
     params.emplace("userName", *_loggedInUserName);
@@ -654,7 +743,7 @@ bool NetworkService::moveResource(std::string const& simId, WorkspaceType target
     params.emplace("targetWorkspace", std::to_string(targetWorkspace));
 
     try {
-        auto result = executeRequest([&] { return client.Post("/alien-server/movesimulation.php", params); });
+        auto result = executeRequest([&] { return client.Post("/alien-server/movesimulation.php", params); }, false);
         return parseBoolResult(result->body);
     } catch (...) {
         logNetworkError();
@@ -666,8 +755,7 @@ bool NetworkService::deleteResource(std::string const& simId)
 {
     log(Priority::Important, "network: delete resource with id=" + simId);
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    auto client = createClient(_serverAddress);
 
     httplib::Params params;
     params.emplace("userName", *_loggedInUserName);
@@ -675,7 +763,7 @@ bool NetworkService::deleteResource(std::string const& simId)
     params.emplace("simId", simId);
 
     try {
-        auto result = executeRequest([&] { return client.Post("/alien-server/deletesimulation.php", params); });
+        auto result = executeRequest([&] { return client.Post("/alien-server/deletesimulation.php", params); }, false);
         return parseBoolResult(result->body);
     } catch (...) {
         logNetworkError();
@@ -683,21 +771,34 @@ bool NetworkService::deleteResource(std::string const& simId)
     }
 }
 
-bool NetworkService::appendResourceData(std::string const& resourceId, std::string const& data, int chunkIndex)
+bool NetworkService::appendResourceData(std::string const& resourceId, std::vector<std::string_view> const& chunks)
 {
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
-
-    httplib::MultipartFormDataItems items = {
-        {"userName", *_loggedInUserName, "", ""},
-        {"password", *_password, "", ""},
-        {"simId", resourceId, "", ""},
-        {"content", data, "", "application/octet-stream"},
-        {"chunkIndex", std::to_string(chunkIndex), "", ""},
-    };
+    //the chunks following the first one are sent in parallel
+    std::atomic<int> nextChunkIndex = 1;
+    std::atomic<bool> success = true;
+    runInParallel(std::min(MaxChunksInFlight, toInt(chunks.size()) - 1), [&] {
+        for (auto chunkIndex = nextChunkIndex++; chunkIndex < toInt(chunks.size()) && success; chunkIndex = nextChunkIndex++) {
+            if (!appendResourceData(resourceId, chunks.at(chunkIndex), chunkIndex)) {
+                success = false;
+            }
+        }
+    });
+    return success;
+}
 
+bool NetworkService::appendResourceData(std::string const& resourceId, std::string_view const& data, int chunkIndex)
+{
+    MultipartFormDataBody body;
+    body.addValue("userName", *_loggedInUserName);
+    body.addValue("password", *_password);
+    body.addValue("simId", resourceId);
+    body.addContent("content", data, "application/octet-stream");
+    body.addValue("chunkIndex", std::to_string(chunkIndex));
+
+    //a chunk whose transfer failed is sent again without repeating the other chunks
     try {
-        auto result = executeRequest([&] { return client.Post("/alien-server/appendsimulationdata.php", items); });
+        auto client = createClient(_serverAddress);
+        auto result = executeRequest([&] { return body.post(client, "/alien-server/appendsimulationdata.php"); }, true);
         if (!parseBoolResult(result->body)) {
             return false;
         }
@@ -707,3 +808,68 @@ bool NetworkService::appendResourceData(std::string const& resourceId, std::stri
     }
     return true;
 }
+
+void NetworkService::downloadResourceData(std::string& mainData, std::string const& simId)
+{
+    auto downloadChunk = [&](std::string& target, int chunkIndex) {
+        auto client = createClient(_serverAddress);
+        httplib::Params params;
+        params.emplace("id", simId);
+        params.emplace("chunkIndex", std::to_string(chunkIndex));
+
+        //the data received before a connection is dropped are discarded and the chunk is requested again
+        executeRequest([&] {
+            target.clear();
+            return client.Get("/alien-server/downloadcontent.php", params, {}, [&](char const* data, size_t length) {
+                target.append(data, length);
+                return true;
+            });
+        }, true);
+    };
+
+    //the first chunk is received directly in mainData, further chunks only exist for large resources and are downloaded in parallel
+    downloadChunk(mainData, 0);
+    if (mainData.size() < MaxChunkSize) {
+        return;
+    }
+
+    std::vector<std::string> chunks(MaxNumDownloadChunks);
+    std::mutex mutex;
+    auto numChunks = MaxNumDownloadChunks;
+    std::exception_ptr exception;
+    std::atomic<int> nextChunkIndex = 1;
+    runInParallel(MaxChunksInFlight, [&] {
+        while (true) {
+            auto chunkIndex = nextChunkIndex++;
+            {
+                std::lock_guard lock(mutex);
+                if (chunkIndex >= numChunks || exception) {
+                    return;
+                }
+            }
+            try {
+                auto& chunk = chunks.at(chunkIndex);
+                downloadChunk(chunk, chunkIndex);
+                if (chunk.size() < MaxChunkSize) {
+                    std::lock_guard lock(mutex);
+                    numChunks = std::min(numChunks, chunk.empty() ? chunkIndex : chunkIndex + 1);
+                }
+            } catch (...) {
+                std::lock_guard lock(mutex);
+                exception = std::current_exception();
+            }
+        }
+    });
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+
+    size_t size = mainData.size();
+    for (int i = 1; i < numChunks; ++i) {
+        size += chunks.at(i).size();
+    }
+    mainData.reserve(size);
+    for (int i = 1; i < numChunks; ++i) {
+        mainData.append(chunks.at(i));
+    }
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <string_view>
 
 #include "Base/Cache.h"
 #include "NetworkResourceRawTO.h"
@@ -75,7 +76,9 @@ public:
     bool deleteResource(std::string const& simId);
 
 private:
-    bool appendResourceData(std::string const& resourceId, std::string const& data, int chunkIndex);
+    bool appendResourceData(std::string const& resourceId, std::vector<std::string_view> const& chunks);
+    bool appendResourceData(std::string const& resourceId, std::string_view const& data, int chunkIndex);
+    void downloadResourceData(std::string& mainData, std::string const& simId);  //throws std::runtime_error
 
     std::string _serverAddress;
     std::optional<std::string> _loggedInUserName;
@@ -88,5 +91,9 @@ private:
         std::string auxiliaryData;
         std::string statistics;
     };
-    Cache<std::string, ResourceData, 20> _downloadCache;
+    static uint64_t constexpr DownloadCacheMaxBytes = 256ull << 20;
+    static uint64_t constexpr DownloadCacheMaxSpilledBytes = 2ull << 30;
+    Cache<std::string, ResourceData> _downloadCache{DownloadCacheMaxBytes, [](ResourceData const& data) {
+        return sizeof(ResourceData) + data.content.size() + data.auxiliaryData.size() + data.statistics.size();
+    }};
 };
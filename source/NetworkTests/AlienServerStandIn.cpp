@@ -0,0 +1,196 @@
+#include "AlienServerStandIn.h"
+
+#include <chrono>
+#include <memory>
+
+namespace
+{
+    std::string const PathPrefix = "/alien-server/";
+
+    std::string getValue(httplib::Request const& request, std::string const& key)
+    {
+        if (request.has_file(key.c_str())) {
+            return request.get_file_value(key.c_str()).content;
+        }
+        return request.get_param_value(key.c_str());
+    }
+}
+
+AlienServerStandIn::AlienServerStandIn()
+{
+    auto setResult = [](httplib::Response& response, bool result, std::string const& additionalFields = "") {
+        response.set_content("{\"result\": " + std::string(result ? "true" : "false") + additionalFields + "}", "application/json");
+    };
+
+    registerHandler("login.php", true, [=](auto const&, auto& response) { setResult(response, true, ", \"errorCode\": 0"); });
+    registerHandler("logout.php", true, [=](auto const&, auto& response) { setResult(response, true); });
+    registerHandler("uploadsimulation.php", true, [=, this](auto const& request, auto& response) {
+        std::string resourceId;
+        {
+            std::lock_guard lock(_mutex);
+            resourceId = "resource" + std::to_string(++_resourceCounter);
+            _resources[resourceId] = Resource{{{0, getValue(request, "content")}}, getValue(request, "settings"), getValue(request, "statistics")};
+        }
+        setResult(response, true, ", \"simId\": \"" + resourceId + "\"");
+    });
+    registerHandler("replacesimulation.php", true, [=, this](auto const& request, auto& response) {
+        std::lock_guard lock(_mutex);
+        _resources[getValue(request, "simId")] =
+            Resource{{{0, getValue(request, "content")}}, getValue(request, "settings"), getValue(request, "statistics")};
+        setResult(response, true);
+    });
+    registerHandler("appendsimulationdata.php", true, [=, this](auto const& request, auto& response) {
+        std::lock_guard lock(_mutex);
+        auto findResult = _resources.find(getValue(request, "simId"));
+        if (findResult == _resources.end()) {
+            setResult(response, false);
+            return;
+        }
+        findResult->second.chunks[std::stoi(getValue(request, "chunkIndex"))] = getValue(request, "content");
+        setResult(response, true);
+    });
+    registerHandler("deletesimulation.php", true, [=, this](auto const& request, auto& response) {
+        std::lock_guard lock(_mutex);
+        _resources.erase(getValue(request, "simId"));
+        setResult(response, true);
+    });
+    registerHandler("downloadcontent.php", false, [this](auto const& request, auto& response) {
+        std::lock_guard lock(_mutex);
+        auto content = std::make_shared<std::string>();
+        auto findResult = _resources.find(getValue(request, "id"));
+        if (findResult != _resources.end()) {
+            auto chunkIt = findResult->second.chunks.find(std::stoi(getValue(request, "chunkIndex")));
+            if (chunkIt != findResult->second.chunks.end()) {
+                *content = chunkIt->second;
+            }
+        }
+        if (content->empty() || _numDroppedDownloads == 0) {
+            response.set_content(*content, "application/octet-stream");
+            return;
+        }
+
+        //the announced content length is not reached
+        --_numDroppedDownloads;
+        response.set_content_provider(content->size(), "application/octet-stream", [content](size_t offset, size_t length, httplib::DataSink& sink) {
+            if (offset >= content->size() / 2) {
+                return false;
+            }
+            return sink.write(content->data() + offset, std::min(length, content->size() / 2 - offset));
+        });
+    });
+    registerHandler("downloadsettings.php", false, [this](auto const& request, auto& response) {
+        std::lock_guard lock(_mutex);
+        auto findResult = _resources.find(getValue(request, "id"));
+        response.set_content(findResult != _resources.end() ? findResult->second.settings : "", "text/plain");
+    });
+    registerHandler("downloadstatistics.php", false, [this](auto const& request, auto& response) {
+        std::lock_guard lock(_mutex);
+        auto findResult = _resources.find(getValue(request, "id"));
+        response.set_content(findResult != _resources.end() ? findResult->second.statistics : "", "text/plain");
+    });
+    registerHandler("incdownloadcount.php", false, [=](auto const&, auto& response) { setResult(response, true); });
+
+    _port = _server.bind_to_any_port("127.0.0.1");
+    _thread = std::thread([this] { _server.listen_after_bind(); });
+    while (!_server.is_running()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+AlienServerStandIn::~AlienServerStandIn()
+{
+    releaseRequests();
+    _server.stop();
+    _thread.join();
+}
+
+std::string AlienServerStandIn::getAddress() const
+{
+    return "http://127.0.0.1:" + std::to_string(_port);
+}
+
+void AlienServerStandIn::addResource(std::string const& resourceId, std::string const& content, std::string const& settings, std::string const& statistics)
+{
+    std::lock_guard lock(_mutex);
+    auto& resource = _resources[resourceId];
+    resource = Resource{{}, settings, statistics};
+    for (size_t offset = 0, chunkIndex = 0; offset < content.size() || chunkIndex == 0; offset += ChunkSize, ++chunkIndex) {
+        resource.chunks[static_cast<int>(chunkIndex)] = content.substr(offset, ChunkSize);
+    }
+}
+
+std::optional<std::string> AlienServerStandIn::getContent(std::string const& resourceId) const
+{
+    std::lock_guard lock(_mutex);
+    auto findResult = _resources.find(resourceId);
+    if (findResult == _resources.end()) {
+        return std::nullopt;
+    }
+    std::string result;
+    for (auto const& [chunkIndex, chunk] : findResult->second.chunks) {
+        if (chunkIndex != 0 && !findResult->second.chunks.contains(chunkIndex - 1)) {
+            return std::nullopt;
+        }
+        result.append(chunk);
+    }
+    return result;
+}
+
+void AlienServerStandIn::failRequests(std::string const& path, int count)
+{
+    std::lock_guard lock(_mutex);
+    _numFailingRequests[PathPrefix + path] = count;
+}
+
+void AlienServerStandIn::dropDownloads(int count)
+{
+    std::lock_guard lock(_mutex);
+    _numDroppedDownloads = count;
+}
+
+void AlienServerStandIn::holdRequests(std::string const& path)
+{
+    std::lock_guard lock(_mutex);
+    _heldPaths.insert(PathPrefix + path);
+}
+
+void AlienServerStandIn::releaseRequests()
+{
+    {
+        std::lock_guard lock(_mutex);
+        _heldPaths.clear();
+    }
+    _heldRequestsCondition.notify_all();
+}
+
+int AlienServerStandIn::getNumRequests(std::string const& path) const
+{
+    std::lock_guard lock(_mutex);
+    auto findResult = _numRequests.find(PathPrefix + path);
+    return findResult != _numRequests.end() ? findResult->second : 0;
+}
+
+void AlienServerStandIn::registerHandler(
+    std::string const& path,
+    bool isPost,
+    std::function<void(httplib::Request const&, httplib::Response&)> const& handler)
+{
+    auto countingHandler = [this, handler](httplib::Request const& request, httplib::Response& response) {
+        {
+            std::unique_lock lock(_mutex);
+            ++_numRequests[request.path];
+            if (auto& numFailingRequests = _numFailingRequests[request.path]; numFailingRequests > 0) {
+                --numFailingRequests;
+                response.status = 503;
+                return;
+            }
+            _heldRequestsCondition.wait(lock, [&] { return !_heldPaths.contains(request.path); });
+        }
+        handler(request, response);
+    };
+    if (isPost) {
+        _server.Post(PathPrefix + path, countingHandler);
+    } else {
+        _server.Get(PathPrefix + path, countingHandler);
+    }
+}
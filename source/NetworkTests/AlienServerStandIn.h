@@ -0,0 +1,61 @@
+#pragma once
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#define CPPHTTPLIB_OPENSSL_SUPPORT
+#include <cpp-httplib/httplib.h>
+
+/**
+ * In-process stand-in for the alien-server endpoints which are used for transferring resources. Requests can be made to fail in order to
+ * test the resumption of transfers offline.
+ */
+class AlienServerStandIn
+{
+public:
+    static size_t constexpr ChunkSize = 24 * 1024 * 1024;  //content of resources is transferred in chunks of this size
+
+    AlienServerStandIn();
+    ~AlienServerStandIn();
+
+    std::string getAddress() const;
+
+    void addResource(std::string const& resourceId, std::string const& content, std::string const& settings, std::string const& statistics);
+    std::optional<std::string> getContent(std::string const& resourceId) const;
+
+    void failRequests(std::string const& path, int count);  //responds with a server error
+    void dropDownloads(int count);  //closes the connection in the middle of a content chunk
+    void holdRequests(std::string const& path);  //requests are answered after releaseRequests() has been called
+    void releaseRequests();
+
+    int getNumRequests(std::string const& path) const;
+
+private:
+    struct Resource
+    {
+        std::map<int, std::string> chunks;
+        std::string settings;
+        std::string statistics;
+    };
+
+    void registerHandler(std::string const& path, bool isPost, std::function<void(httplib::Request const&, httplib::Response&)> const& handler);
+
+    httplib::Server _server;
+    int _port = 0;
+    std::thread _thread;
+
+    mutable std::mutex _mutex;
+    std::unordered_map<std::string, Resource> _resources;
+    int _resourceCounter = 0;
+    std::unordered_map<std::string, int> _numFailingRequests;
+    int _numDroppedDownloads = 0;
+    std::set<std::string> _heldPaths;
+    std::condition_variable _heldRequestsCondition;
+    std::unordered_map<std::string, int> _numRequests;
+};
@@ -0,0 +1,139 @@
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+#include "Base/Definitions.h"
+#include "Network/NetworkService.h"
+
+#include "AlienServerStandIn.h"
+
+class NetworkServiceTests : public ::testing::Test
+{
+public:
+    NetworkServiceTests()
+    {
+        NetworkService::get().setServerAddress(_server.getAddress());
+        LoginErrorCode errorCode;
+        NetworkService::get().login(errorCode, "user", "password", UserInfo());
+    }
+
+    ~NetworkServiceTests() { NetworkService::get().logout(); }
+
+protected:
+    std::string createContent(size_t size) const
+    {
+        std::string result(size, '\0');
+        for (size_t i = 0; i < size; ++i) {
+            result[i] = static_cast<char>((i * 7919) % 251);
+        }
+        return result;
+    }
+
+    std::string upload(std::string const& content) const
+    {
+        std::string resourceId;
+        EXPECT_TRUE(NetworkService::get().uploadResource(
+            resourceId, "test", "", {100, 100}, 0, content, "settings", "statistics", NetworkResourceType_Simulation, WorkspaceType_Private));
+        return resourceId;
+    }
+
+    AlienServerStandIn _server;
+};
+
+TEST_F(NetworkServiceTests, uploadSmallResource)
+{
+    auto content = createContent(1000);
+    auto resourceId = upload(content);
+
+    EXPECT_EQ(content, _server.getContent(resourceId));
+    EXPECT_EQ(0, _server.getNumRequests("appendsimulationdata.php"));
+}
+
+TEST_F(NetworkServiceTests, uploadLargeResource)
+{
+    auto content = createContent(AlienServerStandIn::ChunkSize * 4 + 1000);
+    auto resourceId = upload(content);
+
+    EXPECT_EQ(content, _server.getContent(resourceId));
+    EXPECT_EQ(4, _server.getNumRequests("appendsimulationdata.php"));
+}
+
+TEST_F(NetworkServiceTests, resumeUploadAfterServerErrors)
+{
+    _server.failRequests("appendsimulationdata.php", 2);
+
+    auto content = createContent(AlienServerStandIn::ChunkSize * 2 + 1000);
+    auto resourceId = upload(content);
+
+    //only the failed chunks are sent again
+    EXPECT_EQ(content, _server.getContent(resourceId));
+    EXPECT_EQ(4, _server.getNumRequests("appendsimulationdata.php"));
+    EXPECT_EQ(1, _server.getNumRequests("uploadsimulation.php"));
+}
+
+TEST_F(NetworkServiceTests, downloadLargeResource)
+{
+    auto content = createContent(AlienServerStandIn::ChunkSize * 3 + 1000);
+    _server.addResource("downloadLargeResource", content, "settings", "statistics");
+
+    std::string mainData, auxiliaryData, statistics;
+    ASSERT_TRUE(NetworkService::get().downloadResource(mainData, auxiliaryData, statistics, "downloadLargeResource"));
+    EXPECT_EQ(content, mainData);
+    EXPECT_EQ("settings", auxiliaryData);
+    EXPECT_EQ("statistics", statistics);
+}
+
+TEST_F(NetworkServiceTests, resumeDownloadAfterDroppedConnections)
+{
+    _server.dropDownloads(3);
+
+    auto content = createContent(AlienServerStandIn::ChunkSize * 2 + 1000);
+    _server.addResource("resumeDownloadAfterDroppedConnections", content, "settings", "statistics");
+
+    std::string mainData, auxiliaryData, statistics;
+    ASSERT_TRUE(NetworkService::get().downloadResource(mainData, auxiliaryData, statistics, "resumeDownloadAfterDroppedConnections"));
+    EXPECT_EQ(content, mainData);
+}
+
+TEST_F(NetworkServiceTests, failedUploadIsDeleted)
+{
+    _server.failRequests("appendsimulationdata.php", 100);
+
+    std::string resourceId;
+    EXPECT_FALSE(NetworkService::get().uploadResource(
+        resourceId,
+        "test",
+        "",
+        {100, 100},
+        0,
+        createContent(AlienServerStandIn::ChunkSize + 1000),
+        "settings",
+        "statistics",
+        NetworkResourceType_Simulation,
+        WorkspaceType_Private));
+    EXPECT_FALSE(_server.getContent(resourceId).has_value());
+}
+
+TEST_F(NetworkServiceTests, throughput)
+{
+    auto content = createContent(AlienServerStandIn::ChunkSize * 6);
+
+    auto startTime = std::chrono::steady_clock::now();
+    auto resourceId = upload(content);
+    auto uploadTime = std::chrono::steady_clock::now() - startTime;
+
+    _server.addResource("throughput", content, "settings", "statistics");
+    startTime = std::chrono::steady_clock::now();
+    std::string mainData, auxiliaryData, statistics;
+    ASSERT_TRUE(NetworkService::get().downloadResource(mainData, auxiliaryData, statistics, "throughput"));
+    auto downloadTime = std::chrono::steady_clock::now() - startTime;
+
+    auto toMegabytesPerSecond = [&](auto duration) {
+        auto seconds = std::chrono::duration<double>(duration).count();
+        return toInt(toDouble(content.size()) / 1024 / 1024 / std::max(seconds, 1e-6));
+    };
+    RecordProperty("uploadMegabytesPerSecond", toMegabytesPerSecond(uploadTime));
+    RecordProperty("downloadMegabytesPerSecond", toMegabytesPerSecond(downloadTime));
+    EXPECT_EQ(content, _server.getContent(resourceId));
+    EXPECT_EQ(content, mainData);
+}
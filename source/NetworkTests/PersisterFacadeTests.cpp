@@ -0,0 +1,94 @@
+#include <chrono>
+#include <functional>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/GenomeDescriptionService.h"
+#include "Network/NetworkService.h"
+#include "PersisterImpl/PersisterFacadeImpl.h"
+#include "PersisterInterface/SerializerService.h"
+
+#include "AlienServerStandIn.h"
+
+class PersisterFacadeTests : public ::testing::Test
+{
+public:
+    PersisterFacadeTests()
+    {
+        NetworkService::get().setServerAddress(_server.getAddress());
+        LoginErrorCode errorCode;
+        NetworkService::get().login(errorCode, "user", "password", UserInfo());
+
+        _persisterFacade = std::make_shared<_PersisterFacadeImpl>();
+        _persisterFacade->setup(nullptr);
+    }
+
+    ~PersisterFacadeTests()
+    {
+        _persisterFacade->shutdown();
+        NetworkService::get().logout();
+    }
+
+protected:
+    bool waitUntil(std::function<bool()> const& predicate) const
+    {
+        //only guards against hanging tests, the predicates do not depend on timing
+        auto endTimepoint = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (!predicate()) {
+            if (std::chrono::steady_clock::now() > endTimepoint) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+    AlienServerStandIn _server;
+    PersisterFacade _persisterFacade;
+};
+
+TEST_F(PersisterFacadeTests, interactiveRequestsOvertakeBulkRequests)
+{
+    auto constexpr NumDownloads = 8;
+
+    std::string genomeContent;
+    auto genome = GenomeDescriptionService::get().convertDescriptionToBytes(GenomeDescription().setCells({CellGenomeDescription()}));
+    ASSERT_TRUE(SerializerService::get().serializeGenomeToString(genomeContent, genome));
+
+    //downloads are bulk requests and occupy all threads serving the bulk lane until the server answers them
+    _server.holdRequests("downloadcontent.php");
+    std::vector<PersisterRequestId> downloadRequestIds;
+    for (int i = 0; i < NumDownloads; ++i) {
+        auto resourceId = "genome" + std::to_string(i);
+        _server.addResource(resourceId, genomeContent, "", "");
+        downloadRequestIds.emplace_back(_persisterFacade->scheduleDownloadNetworkResource(
+            SenderInfo{.senderId = SenderId{"test"}},
+            DownloadNetworkResourceRequestData{.resourceId = resourceId, .resourceType = NetworkResourceType_Genome}));
+    }
+
+    auto deleteRequestId = _persisterFacade->scheduleDeleteNetworkResource(
+        SenderInfo{.senderId = SenderId{"test"}}, DeleteNetworkResourceRequestData{.entries = {{.resourceId = "other"}}});
+    ASSERT_TRUE(waitUntil([&] { return _persisterFacade->getRequestState(deleteRequestId) == PersisterRequestState::Finished; }));
+
+    auto statistics = _persisterFacade->getStatistics();
+    auto const& interactiveStatistics = statistics.lanes.at(PersisterLane_Interactive);
+    auto const& bulkStatistics = statistics.lanes.at(PersisterLane_Bulk);
+    EXPECT_EQ(1, interactiveStatistics.numProcessedRequests);
+    EXPECT_EQ(0, interactiveStatistics.queueDepth);
+    EXPECT_EQ(0, bulkStatistics.numProcessedRequests);
+    EXPECT_GT(bulkStatistics.queueDepth, 0);
+    EXPECT_EQ(NumDownloads, bulkStatistics.queueDepth + bulkStatistics.numRequestsInProgress);
+
+    _server.releaseRequests();
+    ASSERT_TRUE(waitUntil([&] { return !_persisterFacade->isBusy(); }));
+
+    statistics = _persisterFacade->getStatistics();
+    EXPECT_EQ(1, statistics.lanes.at(PersisterLane_Interactive).numProcessedRequests);
+    EXPECT_EQ(NumDownloads, statistics.lanes.at(PersisterLane_Bulk).numProcessedRequests);
+    EXPECT_EQ(0, statistics.lanes.at(PersisterLane_Bulk).queueDepth);
+    EXPECT_EQ(0, statistics.lanes.at(PersisterLane_Bulk).numRequestsInProgress);
+    for (auto const& requestId : downloadRequestIds) {
+        EXPECT_EQ(PersisterRequestState::Finished, _persisterFacade->getRequestState(requestId));
+    }
+}
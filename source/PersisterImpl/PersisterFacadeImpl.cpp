@@ -31,7 +31,8 @@ void _PersisterFacadeImpl::restart()
 {
     _worker->restart();
     for (int i = 0; i < MaxWorkerThreads; ++i) {
-        _thread[i] = new std::thread(&_PersisterWorker::runThreadLoop, _worker.get());
+        auto servesBulkLane = i >= NumInteractiveWorkerThreads;
+        _thread[i] = new std::thread(&_PersisterWorker::runThreadLoop, _worker.get(), servesBulkLane);
     }
 }
 
@@ -60,6 +61,11 @@ PersisterErrorInfo _PersisterFacadeImpl::fetchError(PersisterRequestId const& id
     return _worker->fetchJobError(id)->getErrorInfo();
 }
 
+PersisterStatistics _PersisterFacadeImpl::getStatistics() const
+{
+    return _worker->getStatistics();
+}
+
 PersisterRequestId _PersisterFacadeImpl::scheduleSaveSimulation(SenderInfo const& senderInfo, SaveSimulationRequestData const& data)
 {
     return scheduleRequest<_SaveSimulationRequest>(senderInfo, data);
@@ -22,6 +22,7 @@ public:
     PersisterRequestResult fetchPersisterRequestResult(PersisterRequestId const& id) override;
     std::vector<PersisterErrorInfo> fetchAllErrorInfos(SenderId const& senderId) override;
     PersisterErrorInfo fetchError(PersisterRequestId const& id) override;
+    PersisterStatistics getStatistics() const override;
 
     PersisterRequestId scheduleSaveSimulation(SenderInfo const& senderInfo, SaveSimulationRequestData const& data) override;
     SaveSimulationResultData fetchSaveSimulationData(PersisterRequestId const& id) override;
@@ -67,6 +68,7 @@ public:
 
 private:
     static auto constexpr MaxWorkerThreads = 4;
+    static auto constexpr NumInteractiveWorkerThreads = 1;  //threads which only serve the interactive lane
 
     template<typename Request, typename RequestData>
     PersisterRequestId scheduleRequest(SenderInfo const& senderInfo, RequestData const& data);
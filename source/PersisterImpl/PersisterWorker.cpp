@@ -14,17 +14,42 @@
 #include "EngineInterface/GenomeDescriptionService.h"
 #include "Network/NetworkService.h"
 
+template <typename ConcreteRequest>
+void _PersisterWorker::registerRequestType(PersisterLane lane)
+{
+    RequestType requestType;
+    requestType.lane = lane;
+    requestType.process = [this](std::unique_lock<std::mutex>& lock, PersisterRequest const& request) -> PersisterRequestResultOrError {
+        return processRequest(lock, std::static_pointer_cast<ConcreteRequest>(request));
+    };
+    _requestTypes.emplace(typeid(ConcreteRequest), requestType);
+}
+
 _PersisterWorker::_PersisterWorker(SimulationFacade const& simulationFacade)
     : _simulationFacade(simulationFacade)
 {
+    registerRequestType<_SaveSimulationRequest>(PersisterLane_Bulk);
+    registerRequestType<_ReadSimulationRequest>(PersisterLane_Bulk);
+    registerRequestType<_GetPeakSimulationRequest>(PersisterLane_Bulk);
+    registerRequestType<_SaveDeserializedSimulationRequest>(PersisterLane_Bulk);
+    registerRequestType<_DownloadNetworkResourceRequest>(PersisterLane_Bulk);
+    registerRequestType<_UploadNetworkResourceRequest>(PersisterLane_Bulk);
+    registerRequestType<_ReplaceNetworkResourceRequest>(PersisterLane_Bulk);
+    registerRequestType<_LoginRequest>(PersisterLane_Interactive);
+    registerRequestType<_GetNetworkResourcesRequest>(PersisterLane_Interactive);
+    registerRequestType<_GetUserNamesForEmojiRequest>(PersisterLane_Interactive);
+    registerRequestType<_DeleteNetworkResourceRequest>(PersisterLane_Interactive);
+    registerRequestType<_EditNetworkResourceRequest>(PersisterLane_Interactive);
+    registerRequestType<_MoveNetworkResourceRequest>(PersisterLane_Interactive);
+    registerRequestType<_ToggleReactionNetworkResourceRequest>(PersisterLane_Interactive);
 }
 
-void _PersisterWorker::runThreadLoop()
+void _PersisterWorker::runThreadLoop(bool servesBulkLane)
 {
     std::unique_lock lock(_requestMutex);
     while (!_isShutdown.load()) {
-        _conditionVariable.wait(lock);
-        processRequests(lock);
+        _conditionVariable.wait(lock, [&] { return _isShutdown.load() || getNextLane(servesBulkLane).has_value(); });
+        processRequests(lock, servesBulkLane);
     }
 }
 
@@ -35,7 +60,10 @@ void _PersisterWorker::restart()
 
 void _PersisterWorker::shutdown()
 {
-    _isShutdown = true;
+    {
+        std::unique_lock uniqueLock(_requestMutex);
+        _isShutdown = true;
+    }
     _conditionVariable.notify_all();
 }
 
@@ -43,26 +71,23 @@ bool _PersisterWorker::isBusy() const
 {
     std::unique_lock uniqueLock(_requestMutex);
 
-    return !_openRequests.empty() || !_inProgressRequests.empty();
+    for (int lane = 0; lane < PersisterLane_Count; ++lane) {
+        if (!_openRequests.at(lane).empty() || _laneStatistics.at(lane).numRequestsInProgress > 0) {
+            return true;
+        }
+    }
+    return false;
 }
 
 std::optional<PersisterRequestState> _PersisterWorker::getRequestState(PersisterRequestId const& id) const
 {
     std::unique_lock uniqueLock(_requestMutex);
 
-    if (std::ranges::find_if(_openRequests, [&](PersisterRequest const& request) { return request->getRequestId() == id; }) != _openRequests.end()) {
-        return PersisterRequestState::InQueue;
-    }
-    if (std::ranges::find_if(_inProgressRequests, [&](PersisterRequest const& request) { return request->getRequestId() == id; }) != _inProgressRequests.end()) {
-        return PersisterRequestState::InProgress;
+    auto findResult = _requestEntries.find(id.value);
+    if (findResult == _requestEntries.end()) {
+        return std::nullopt;
     }
-    if (std::ranges::find_if(_finishedRequests, [&](PersisterRequestResult const& request) { return request->getRequestId() == id; }) != _finishedRequests.end()) {
-        return PersisterRequestState::Finished;
-    }
-    if (std::ranges::find_if(_requestErrors, [&](PersisterRequestError const& request) { return request->getRequestId() == id; }) != _requestErrors.end()) {
-        return PersisterRequestState::Error;
-    }
-    return std::nullopt;
+    return findResult->second.state;
 }
 
 void _PersisterWorker::addRequest(PersisterRequest const& job)
@@ -70,7 +95,9 @@ void _PersisterWorker::addRequest(PersisterRequest const& job)
     {
         std::unique_lock uniqueLock(_requestMutex);
 
-        _openRequests.emplace_back(job);
+        auto const& requestType = _requestTypes.at(typeid(*job));
+        _openRequests.at(requestType.lane).emplace_back(OpenRequest{job, std::chrono::steady_clock::now()});
+        _requestEntries.insert_or_assign(job->getRequestId().value, RequestEntry{.sequenceNumber = _numAddedRequests++});
     }
     _conditionVariable.notify_all();
 }
@@ -79,11 +106,11 @@ PersisterRequestResult _PersisterWorker::fetchRequestResult(PersisterRequestId c
 {
     std::unique_lock uniqueLock(_requestMutex);
 
-    auto finishedJobsIter = std::ranges::find_if(_finishedRequests, [&](PersisterRequestResult const& job) { return job->getRequestId() == id; });
-    if (finishedJobsIter != _finishedRequests.end()) {
-        auto resultCopy = *finishedJobsIter;
-        _finishedRequests.erase(finishedJobsIter);
-        return resultCopy;
+    auto findResult = _requestEntries.find(id.value);
+    if (findResult != _requestEntries.end() && findResult->second.state == PersisterRequestState::Finished) {
+        auto result = findResult->second.result;
+        _requestEntries.erase(findResult);
+        return result;
     }
     THROW_NOT_IMPLEMENTED();
 }
@@ -92,11 +119,11 @@ PersisterRequestError _PersisterWorker::fetchJobError(PersisterRequestId const&
 {
     std::unique_lock uniqueLock(_requestMutex);
 
-    auto jobsErrorsIter = std::ranges::find_if(_requestErrors, [&](PersisterRequestError const& job) { return job->getRequestId() == id; });
-    if (jobsErrorsIter != _requestErrors.end()) {
-        auto resultCopy = *jobsErrorsIter;
-        _requestErrors.erase(jobsErrorsIter);
-        return resultCopy;
+    auto findResult = _requestEntries.find(id.value);
+    if (findResult != _requestEntries.end() && findResult->second.state == PersisterRequestState::Error) {
+        auto result = findResult->second.error;
+        _requestEntries.erase(findResult);
+        return result;
     }
     THROW_NOT_IMPLEMENTED();
 }
@@ -105,75 +132,80 @@ std::vector<PersisterErrorInfo> _PersisterWorker::fetchAllErrorInfos(SenderId co
 {
     std::unique_lock lock(_requestMutex);
 
-    std::vector<PersisterErrorInfo> result;
-    std::deque<PersisterRequestError> filteredErrorJobs;
-    for (auto const& errorJob : _requestErrors) {
-        if (errorJob->getSenderId() == senderId) {
-            result.emplace_back(errorJob->getErrorInfo());
+    std::vector<RequestEntry> errorEntries;
+    for (auto it = _requestEntries.begin(); it != _requestEntries.end();) {
+        auto const& entry = it->second;
+        if (entry.state == PersisterRequestState::Error && entry.error->getSenderId() == senderId) {
+            errorEntries.emplace_back(entry);
+            it = _requestEntries.erase(it);
         } else {
-            filteredErrorJobs.emplace_back(errorJob);
+            ++it;
         }
     }
-    _requestErrors = filteredErrorJobs;
+    std::ranges::sort(errorEntries, [](auto const& entry1, auto const& entry2) { return entry1.sequenceNumber < entry2.sequenceNumber; });
+
+    std::vector<PersisterErrorInfo> result;
+    for (auto const& entry : errorEntries) {
+        result.emplace_back(entry.error->getErrorInfo());
+    }
     return result;
 }
 
-void _PersisterWorker::processRequests(std::unique_lock<std::mutex>& lock)
+PersisterStatistics _PersisterWorker::getStatistics() const
 {
-    if (_openRequests.empty()) {
-        return;
-    }
-
-    while (!_openRequests.empty()) {
-
-        auto request = _openRequests.front();
-        _openRequests.pop_front();
-
-        _inProgressRequests.push_back(request);
-
-        std::variant<PersisterRequestResult, PersisterRequestError> processingResult;
-        if (auto const& concreteRequest = std::dynamic_pointer_cast<_SaveSimulationRequest>(request)) {
-            processingResult = processRequest(lock, concreteRequest);
-        } else if (auto const& concreteRequest = std::dynamic_pointer_cast<_ReadSimulationRequest>(request)) {
-            processingResult = processRequest(lock, concreteRequest);
-        } else if (auto const& concreteRequest = std::dynamic_pointer_cast<_LoginRequest>(request)) {
-            processingResult = processRequest(lock, concreteRequest);
-        } else if (auto const& concreteRequest = std::dynamic_pointer_cast<_GetNetworkResourcesRequest>(request)) {
-            processingResult = processRequest(lock, concreteRequest);
-        } else if (auto const& concreteRequest = std::dynamic_pointer_cast<_DownloadNetworkResourceRequest>(request)) {
-            processingResult = processRequest(lock, concreteRequest);
-        } else if (auto const& concreteRequest = std::dynamic_pointer_cast<_UploadNetworkResourceRequest>(request)) {
-            processingResult = processRequest(lock, concreteRequest);
-        } else if (auto const& concreteRequest = std::dynamic_pointer_cast<_ReplaceNetworkResourceRequest>(request)) {
-            processingResult = processRequest(lock, concreteRequest);
-        } else if (auto const& concreteRequest = std::dynamic_pointer_cast<_GetUserNamesForEmojiRequest>(request)) {
-            processingResult = processRequest(lock, concreteRequest);
-        } else if (auto const& concreteRequest = std::dynamic_pointer_cast<_DeleteNetworkResourceRequest>(request)) {
-            processingResult = processRequest(lock, concreteRequest);
-        } else if (auto const& concreteRequest = std::dynamic_pointer_cast<_EditNetworkResourceRequest>(request)) {
-            processingResult = processRequest(lock, concreteRequest);
-        } else if (auto const& concreteRequest = std::dynamic_pointer_cast<_MoveNetworkResourceRequest>(request)) {
-            processingResult = processRequest(lock, concreteRequest);
-        } else if (auto const& concreteRequest = std::dynamic_pointer_cast<_ToggleReactionNetworkResourceRequest>(request)) {
-            processingResult = processRequest(lock, concreteRequest);
-        } else if (auto const& concreteRequest = std::dynamic_pointer_cast<_GetPeakSimulationRequest>(request)) {
-            processingResult = processRequest(lock, concreteRequest);
-        } else if (auto const& concreteRequest = std::dynamic_pointer_cast<_SaveDeserializedSimulationRequest>(request)) {
-            processingResult = processRequest(lock, concreteRequest);
-        }
-        auto inProgressJobsIter = std::ranges::find_if(
-            _inProgressRequests, [&](PersisterRequest const& otherRequest) { return otherRequest->getRequestId() == request->getRequestId(); });
-        _inProgressRequests.erase(inProgressJobsIter);
+    std::unique_lock lock(_requestMutex);
 
-        if (std::holds_alternative<PersisterRequestResult>(processingResult)) {
-            if (request->getSenderInfo().wishResultData) {
-                _finishedRequests.emplace_back(std::get<PersisterRequestResult>(processingResult));
-            }
-        }
-        if (std::holds_alternative<PersisterRequestError>(processingResult)) {
-            if (request->getSenderInfo().wishErrorInfo) {
-                _requestErrors.emplace_back(std::get<PersisterRequestError>(processingResult));
-            }
+    PersisterStatistics result;
+    result.lanes = _laneStatistics;
+    for (int lane = 0; lane < PersisterLane_Count; ++lane) {
+        result.lanes.at(lane).queueDepth = toInt(_openRequests.at(lane).size());
+    }
+    return result;
+}
+
+std::optional<PersisterLane> _PersisterWorker::getNextLane(bool servesBulkLane) const
+{
+    if (!_openRequests.at(PersisterLane_Interactive).empty()) {
+        return PersisterLane_Interactive;
+    }
+    if (servesBulkLane && !_openRequests.at(PersisterLane_Bulk).empty()) {
+        return PersisterLane_Bulk;
+    }
+    return std::nullopt;
+}
+
+void _PersisterWorker::processRequests(std::unique_lock<std::mutex>& lock, bool servesBulkLane)
+{
+    while (auto lane = getNextLane(servesBulkLane)) {
+        auto openRequest = _openRequests.at(*lane).front();
+        _openRequests.at(*lane).pop_front();
+
+        auto const& request = openRequest.request;
+        auto const& requestId = request->getRequestId().value;
+        _requestEntries.at(requestId).state = PersisterRequestState::InProgress;
+
+        auto& statistics = _laneStatistics.at(*lane);
+        auto startTimepoint = std::chrono::steady_clock::now();
+        auto waitingTime = std::chrono::duration_cast<std::chrono::microseconds>(startTimepoint - openRequest.addTimepoint);
+        statistics.totalWaitingTime += waitingTime;
+        statistics.maxWaitingTime = std::max(statistics.maxWaitingTime, waitingTime);
+        ++statistics.numRequestsInProgress;
+
+        auto processingResult = _requestTypes.at(typeid(*request)).process(lock, request);
+
+        --statistics.numRequestsInProgress;
+        ++statistics.numProcessedRequests;
+        statistics.totalProcessingTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTimepoint);
+
+        auto& entry = _requestEntries.at(requestId);
+        if (std::holds_alternative<PersisterRequestResult>(processingResult) && request->getSenderInfo().wishResultData) {
+            entry.state = PersisterRequestState::Finished;
+            entry.result = std::get<PersisterRequestResult>(processingResult);
+        } else if (std::holds_alternative<PersisterRequestError>(processingResult) && request->getSenderInfo().wishErrorInfo) {
+            entry.state = PersisterRequestState::Error;
+            entry.error = std::get<PersisterRequestError>(processingResult);
+        } else {
+            _requestEntries.erase(requestId);
         }
     }
 }
@@ -200,31 +232,52 @@ auto _PersisterWorker::processRequest(std::unique_lock<std::mutex>& lock, SaveSi
     auto const& requestData = request->getData();
 
     DeserializedSimulation deserializedData;
+    auto& auxiliaryData = deserializedData.auxiliaryData;
+    auto& statistics = deserializedData.statistics;
     std::chrono::system_clock::time_point timestamp;
+    std::filesystem::path filename;
+    std::filesystem::path baseFilename;
 
     try {
         timestamp = std::chrono::system_clock::now();
-        deserializedData.statistics = _simulationFacade->getStatisticsHistory().getCopiedData();
-        deserializedData.auxiliaryData.realTime = _simulationFacade->getRealTime();
-        deserializedData.auxiliaryData.zoom = requestData.zoom;
-        deserializedData.auxiliaryData.center = requestData.center;
-        deserializedData.auxiliaryData.generalSettings = _simulationFacade->getGeneralSettings();
-        deserializedData.auxiliaryData.simulationParameters = _simulationFacade->getSimulationParameters();
-        deserializedData.auxiliaryData.timestep = static_cast<uint32_t>(_simulationFacade->getCurrentTimestep());
-        deserializedData.mainData = _simulationFacade->getClusteredSimulationData();
+        auto statisticsSnapshot = _simulationFacade->getStatisticsHistory().getSnapshot();
+        statistics = statisticsSnapshot->getData();
+        deserializedData.numStableStatistics = statisticsSnapshot->getNumStableDataPoints();
+        auxiliaryData.realTime = _simulationFacade->getRealTime();
+        auxiliaryData.zoom = requestData.zoom;
+        auxiliaryData.center = requestData.center;
+        auxiliaryData.generalSettings = _simulationFacade->getGeneralSettings();
+        auxiliaryData.simulationParameters = _simulationFacade->getSimulationParameters();
+        auxiliaryData.timestep = static_cast<uint32_t>(_simulationFacade->getCurrentTimestep());
+
+        filename = requestData.filename;
+        if (requestData.generateNameFromTimestep) {
+            filename = generateFilename(filename, auxiliaryData.timestep);
+        }
+
+        //the simulation data is written without building descriptions and the engine is only blocked while the data is copied, a delta is
+        //computed by the engine from the hashes of the last saved content and requires that the base has been saved by this engine
+        if (!requestData.deltaBaseFilename.empty()
+            && SerializerService::get().serializeDeltaSettingsAndStatisticsToFiles(
+                filename, requestData.deltaBaseFilename, auxiliaryData, statistics, deserializedData.numStableStatistics)) {
+            if (_simulationFacade->saveSimulationDataDelta(filename, requestData.deltaBaseFilename)) {
+                log(Priority::Important, "save simulation delta to " + filename.string());
+                baseFilename = requestData.deltaBaseFilename;
+            }
+        }
+        if (baseFilename.empty()) {
+            log(Priority::Important, "save simulation to " + filename.string());
+            _simulationFacade->saveSimulationData(filename);
+        }
     } catch (...) {
         return std::make_shared<_PersisterRequestError>(
             request->getRequestId(),
             request->getSenderInfo().senderId,
-            PersisterErrorInfo{"The simulation could not be saved because no valid data could be obtained from the GPU."});
+            PersisterErrorInfo{"The simulation could not be saved because no valid data could be obtained from the GPU or written to the specified file."});
     }
 
     try {
-        auto filename = requestData.filename;
-        if (requestData.generateNameFromTimestep) {
-            filename = generateFilename(filename, deserializedData.auxiliaryData.timestep);
-        }
-        if (!SerializerService::get().serializeSimulationToFiles(filename, deserializedData)) {
+        if (baseFilename.empty() && !SerializerService::get().serializeSettingsAndStatisticsToFiles(filename, auxiliaryData, statistics, deserializedData.numStableStatistics)) {
             throw std::runtime_error("Error");
         }
 
@@ -232,9 +285,10 @@ auto _PersisterWorker::processRequest(std::unique_lock<std::mutex>& lock, SaveSi
             request->getRequestId(),
             SaveSimulationResultData{
                 .filename = filename,
-                .projectName = deserializedData.auxiliaryData.simulationParameters.projectName,
-                .timestep = deserializedData.auxiliaryData.timestep,
-                .timestamp = timestamp});
+                .projectName = auxiliaryData.simulationParameters.projectName,
+                .timestep = auxiliaryData.timestep,
+                .timestamp = timestamp,
+                .baseFilename = baseFilename});
     } catch (...) {
         return std::make_shared<_PersisterRequestError>(
             request->getRequestId(),
@@ -666,7 +720,11 @@ _PersisterWorker::PersisterRequestResultOrError _PersisterWorker::processRequest
         if (requestData.generateNameFromTimestep) {
             filename = generateFilename(filename, deserializedData.auxiliaryData.timestep);
         }
-        if (!SerializerService::get().serializeSimulationToFiles(filename, deserializedData)) {
+        std::filesystem::path baseFilename;
+        if (!requestData.deltaBaseFilename.empty()
+            && SerializerService::get().serializeDeltaSimulationToFiles(filename, requestData.deltaBaseFilename, deserializedData)) {
+            baseFilename = requestData.deltaBaseFilename;
+        } else if (!SerializerService::get().serializeSimulationToFiles(filename, deserializedData)) {
             throw std::runtime_error("Error");
         }
         auto result = std::make_shared<_SaveDeserializedSimulationRequestResult>(
@@ -676,7 +734,8 @@ _PersisterWorker::PersisterRequestResultOrError _PersisterWorker::processRequest
                 .projectName = deserializedData.auxiliaryData.simulationParameters.projectName,
                 .timestep = deserializedData.auxiliaryData.timestep,
                 .timestamp = requestData.sharedDeserializedSimulation->getTimestamp(),
-                .rawStatisticsData = requestData.sharedDeserializedSimulation->getRawStatisticsData()});
+                .rawStatisticsData = requestData.sharedDeserializedSimulation->getRawStatisticsData(),
+                .baseFilename = baseFilename});
 
         if (requestData.resetDeserializedSimulation) {
             requestData.sharedDeserializedSimulation->reset();
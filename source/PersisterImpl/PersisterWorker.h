@@ -1,23 +1,30 @@
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <deque>
+#include <functional>
 #include <mutex>
 #include <condition_variable>
+#include <typeindex>
+#include <unordered_map>
 
 #include "PersisterInterface/PersisterRequestState.h"
 #include "PersisterInterface/PersisterRequestResult.h"
+#include "PersisterInterface/PersisterStatistics.h"
 
 #include "Definitions.h"
 #include "PersisterRequest.h"
 #include "PersisterRequestError.h"
 
+//requests are served in separate lanes such that bulk I/O does not delay interactive requests
 class _PersisterWorker
 {
 public:
     _PersisterWorker(SimulationFacade const& simulationFacade);
 
-    void runThreadLoop();
+    void runThreadLoop(bool servesBulkLane);  //interactive requests are served by all threads and take precedence
     void shutdown();
     void restart();
 
@@ -30,10 +37,16 @@ public:
 
     std::vector<PersisterErrorInfo> fetchAllErrorInfos(SenderId const& senderId);
 
+    PersisterStatistics getStatistics() const;
+
 private:
-    void processRequests(std::unique_lock<std::mutex>& lock);
+    std::optional<PersisterLane> getNextLane(bool servesBulkLane) const;
+    void processRequests(std::unique_lock<std::mutex>& lock, bool servesBulkLane);
 
     using PersisterRequestResultOrError = std::variant<PersisterRequestResult, PersisterRequestError>;
+
+    template <typename ConcreteRequest>
+    void registerRequestType(PersisterLane lane);
     PersisterRequestResultOrError processRequest(std::unique_lock<std::mutex>& lock, SaveSimulationRequest const& job);
     PersisterRequestResultOrError processRequest(std::unique_lock<std::mutex>& lock, ReadSimulationRequest const& request);
     PersisterRequestResultOrError processRequest(std::unique_lock<std::mutex>& lock, LoginRequest const& request);
@@ -53,11 +66,31 @@ private:
 
     std::atomic<bool> _isShutdown{false};
 
+    struct RequestType
+    {
+        PersisterLane lane = PersisterLane_Interactive;
+        std::function<PersisterRequestResultOrError(std::unique_lock<std::mutex>&, PersisterRequest const&)> process;
+    };
+    std::unordered_map<std::type_index, RequestType> _requestTypes;
+
+    struct OpenRequest
+    {
+        PersisterRequest request;
+        std::chrono::steady_clock::time_point addTimepoint;
+    };
+    struct RequestEntry
+    {
+        PersisterRequestState state = PersisterRequestState::InQueue;
+        uint64_t sequenceNumber = 0;
+        PersisterRequestResult result;
+        PersisterRequestError error;
+    };
+
     mutable std::mutex _requestMutex;
-    std::deque<PersisterRequest> _openRequests;
-    std::deque<PersisterRequest> _inProgressRequests;
-    std::deque<PersisterRequestResult> _finishedRequests;
-    std::deque<PersisterRequestError> _requestErrors;
+    std::array<std::deque<OpenRequest>, PersisterLane_Count> _openRequests;
+    std::unordered_map<std::string, RequestEntry> _requestEntries;  //indexed by the values of the request ids
+    uint64_t _numAddedRequests = 0;
+    std::array<PersisterLaneStatistics, PersisterLane_Count> _laneStatistics;
 
     std::condition_variable _conditionVariable;
 };
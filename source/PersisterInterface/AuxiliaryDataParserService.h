@@ -1,5 +1,8 @@
 #pragma once
 
+#include <ostream>
+#include <string_view>
+
 #include <boost/property_tree/ptree.hpp>
 
 #include "Base/JsonParser.h"
@@ -19,4 +22,12 @@ public:
 
     boost::property_tree::ptree encodeSimulationParameters(SimulationParameters const& data);
     SimulationParameters decodeSimulationParameters(boost::property_tree::ptree tree);
+
+    //streaming codecs without property tree, the JSON output equals write_json of the ptree encoding
+    //files of other program versions or with missing parameters are decoded via ptree for the legacy conversions
+    void encodeAuxiliaryDataToJson(AuxiliaryData const& data, std::ostream& stream);
+    AuxiliaryData decodeAuxiliaryDataFromJson(std::string_view json);
+
+    void encodeSimulationParametersToJson(SimulationParameters const& data, std::ostream& stream);
+    SimulationParameters decodeSimulationParametersFromJson(std::string_view json);
 };
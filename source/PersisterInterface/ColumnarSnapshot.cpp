@@ -0,0 +1,281 @@
+#include "ColumnarSnapshot.h"
+
+#include <algorithm>
+#include <bit>
+#include <fstream>
+#include <ranges>
+
+#include "Base/Definitions.h"
+#include "Base/ThreadPool.h"
+
+#include "CompressionService.h"
+
+static_assert(std::endian::native == std::endian::little, "columnar snapshots are written in the native byte order of little-endian hosts");
+static_assert(sizeof(ColumnarSnapshot::Header) == 32);
+
+namespace
+{
+    class IndexWriter
+    {
+    public:
+        template <typename T>
+        void write(T const& value)
+        {
+            auto bytes = reinterpret_cast<uint8_t const*>(&value);
+            _data.insert(_data.end(), bytes, bytes + sizeof(T));
+        }
+        void write(std::string const& value)
+        {
+            write(static_cast<uint32_t>(value.size()));
+            _data.insert(_data.end(), value.begin(), value.end());
+        }
+        std::vector<uint8_t> const& getData() const { return _data; }
+
+    private:
+        std::vector<uint8_t> _data;
+    };
+
+    class IndexReader
+    {
+    public:
+        IndexReader(uint8_t const* data, uint64_t size)
+            : _data(data)
+            , _size(size)
+        {}
+
+        template <typename T>
+        T read()
+        {
+            checkRemaining(sizeof(T));
+            T result;
+            std::memcpy(&result, _data + _position, sizeof(T));
+            _position += sizeof(T);
+            return result;
+        }
+        std::string readString()
+        {
+            auto size = read<uint32_t>();
+            checkRemaining(size);
+            std::string result(reinterpret_cast<char const*>(_data + _position), size);
+            _position += size;
+            return result;
+        }
+
+    private:
+        void checkRemaining(uint64_t size) const
+        {
+            if (_position + size > _size) {
+                throw std::runtime_error("Index of columnar snapshot is truncated.");
+            }
+        }
+
+        uint8_t const* _data;
+        uint64_t _size;
+        uint64_t _position = 0;
+    };
+}
+
+bool ColumnarSnapshot::isColumnarSnapshot(std::filesystem::path const& filename)
+{
+    std::ifstream stream(filename, std::ios::binary);
+    char magic[sizeof(Magic)];
+    if (!stream.read(magic, sizeof(magic))) {
+        return false;
+    }
+    return std::memcmp(magic, Magic, sizeof(Magic)) == 0;
+}
+
+ColumnarSnapshotWriter::ColumnarSnapshotWriter(std::string const& programVersion)
+    : _programVersion(programVersion)
+{}
+
+void ColumnarSnapshotWriter::addSection(ColumnarSectionId id, uint32_t elementSize, uint8_t const* data, uint64_t numElements)
+{
+    CompressedSection section;
+    section.elementSize = elementSize;
+    section.numElements = numElements;
+
+    //chunks contain whole elements and are compressed in parallel
+    auto elementsPerChunk = std::max(uint64_t(1), ColumnarSnapshot::ChunkSize / elementSize);
+    auto numChunks = (numElements + elementsPerChunk - 1) / elementsPerChunk;
+    section.compressedChunks.resize(numChunks);
+    section.uncompressedChunkSizes.resize(numChunks);
+    ThreadPool::get().parallelFor(
+        numChunks,
+        [&](size_t startIndex, size_t endIndex) {
+            for (auto index = startIndex; index < endIndex; ++index) {
+                auto startElement = index * elementsPerChunk;
+                auto uncompressedSize = std::min(elementsPerChunk, numElements - startElement) * elementSize;
+                section.compressedChunks.at(index) = CompressionService::get().compressBlock(data + startElement * elementSize, uncompressedSize);
+                section.uncompressedChunkSizes.at(index) = uncompressedSize;
+            }
+        },
+        1);
+    _sections[id] = std::move(section);
+}
+
+void ColumnarSnapshotWriter::write(std::ostream& stream) const
+{
+    uint64_t offset = sizeof(ColumnarSnapshot::Header);
+
+    IndexWriter index;
+    index.write(_programVersion);
+    index.write(static_cast<uint32_t>(_sections.size()));
+    for (auto const& [id, section] : _sections) {
+        index.write(id);
+        index.write(section.elementSize);
+        index.write(section.numElements);
+        index.write(static_cast<uint32_t>(section.compressedChunks.size()));
+        for (size_t i = 0; i < section.compressedChunks.size(); ++i) {
+            index.write(offset);
+            index.write(static_cast<uint64_t>(section.compressedChunks.at(i).size()));
+            index.write(section.uncompressedChunkSizes.at(i));
+            offset += section.compressedChunks.at(i).size();
+        }
+    }
+
+    ColumnarSnapshot::Header header;
+    std::memcpy(header.magic, ColumnarSnapshot::Magic, sizeof(header.magic));
+    header.formatVersion = ColumnarSnapshot::FormatVersion;
+    header.reserved = 0;
+    header.indexOffset = offset;
+    header.indexSize = index.getData().size();
+    stream.write(reinterpret_cast<char const*>(&header), sizeof(header));
+
+    for (auto const& section : _sections | std::views::values) {
+        for (auto const& compressedChunk : section.compressedChunks) {
+            stream.write(reinterpret_cast<char const*>(compressedChunk.data()), compressedChunk.size());
+        }
+    }
+    stream.write(reinterpret_cast<char const*>(index.getData().data()), index.getData().size());
+    if (!stream) {
+        throw std::runtime_error("Could not write columnar snapshot.");
+    }
+}
+
+ColumnarSnapshotReader::ColumnarSnapshotReader(std::filesystem::path const& filename)
+{
+    _file = std::make_unique<MappedFile>(filename);
+    _data = std::span<uint8_t const>(_file->getData(), _file->getSize());
+    init();
+}
+
+ColumnarSnapshotReader::ColumnarSnapshotReader(std::span<uint8_t const> data)
+    : _data(data)
+{
+    init();
+}
+
+void ColumnarSnapshotReader::init()
+{
+    auto data = _data.data();
+    auto size = _data.size();
+
+    ColumnarSnapshot::Header header;
+    if (size < sizeof(header)) {
+        throw std::runtime_error("Columnar snapshot is truncated.");
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, ColumnarSnapshot::Magic, sizeof(header.magic)) != 0) {
+        throw std::runtime_error("File is not a columnar snapshot.");
+    }
+    if (header.formatVersion > ColumnarSnapshot::FormatVersion) {
+        throw std::runtime_error("Format version of columnar snapshot not supported.");
+    }
+    if (header.indexOffset > size || header.indexSize > size - header.indexOffset) {
+        throw std::runtime_error("Columnar snapshot is truncated.");
+    }
+
+    IndexReader index(data + header.indexOffset, header.indexSize);
+    _programVersion = index.readString();
+    auto numSections = index.read<uint32_t>();
+    for (uint32_t i = 0; i < numSections; ++i) {
+        auto id = index.read<ColumnarSectionId>();
+        ColumnarSnapshot::Section section;
+        section.elementSize = index.read<uint32_t>();
+        section.numElements = index.read<uint64_t>();
+        auto numChunks = index.read<uint32_t>();
+        uint64_t totalSize = 0;
+        for (uint32_t j = 0; j < numChunks; ++j) {
+            ColumnarSnapshot::Chunk chunk;
+            chunk.offset = index.read<uint64_t>();
+            chunk.compressedSize = index.read<uint64_t>();
+            chunk.uncompressedSize = index.read<uint64_t>();
+            if (chunk.offset > header.indexOffset || chunk.compressedSize > header.indexOffset - chunk.offset) {
+                throw std::runtime_error("Chunk of columnar snapshot is out of range.");
+            }
+            totalSize += chunk.uncompressedSize;
+            section.chunks.emplace_back(chunk);
+        }
+        if (totalSize != section.numElements * section.elementSize) {
+            throw std::runtime_error("Section of columnar snapshot is inconsistent.");
+        }
+        _sections.emplace(id, std::move(section));
+    }
+}
+
+std::string const& ColumnarSnapshotReader::getProgramVersion() const
+{
+    return _programVersion;
+}
+
+bool ColumnarSnapshotReader::hasSection(ColumnarSectionId id) const
+{
+    return _sections.contains(id);
+}
+
+uint64_t ColumnarSnapshotReader::getNumElements(ColumnarSectionId id) const
+{
+    return getSection(id).numElements;
+}
+
+void ColumnarSnapshotReader::readSection(ColumnarSectionId id, uint32_t elementSize, uint8_t* target) const
+{
+    auto const& section = getSection(id);
+    if (section.elementSize != elementSize) {
+        throw std::runtime_error("Unexpected element size in section of columnar snapshot.");
+    }
+    std::vector<uint8_t*> chunkTargets;
+    for (auto const& chunk : section.chunks) {
+        chunkTargets.emplace_back(target);
+        target += chunk.uncompressedSize;
+    }
+    ThreadPool::get().parallelFor(
+        section.chunks.size(),
+        [&](size_t startIndex, size_t endIndex) {
+            for (auto index = startIndex; index < endIndex; ++index) {
+                auto const& chunk = section.chunks.at(index);
+                CompressionService::get().decompressBlock(chunkTargets.at(index), chunk.uncompressedSize, _data.data() + chunk.offset, chunk.compressedSize);
+            }
+        },
+        1);
+}
+
+ColumnarSnapshot::Section const& ColumnarSnapshotReader::getSection(ColumnarSectionId id) const
+{
+    auto findResult = _sections.find(id);
+    if (findResult == _sections.end()) {
+        throw std::runtime_error("Section " + std::to_string(id) + " missing in columnar snapshot.");
+    }
+    return findResult->second;
+}
+
+void ColumnarByteWriter::write(std::optional<int> const& value)
+{
+    write(value.value_or(-1));
+}
+
+std::vector<uint8_t> const& ColumnarByteWriter::getData() const
+{
+    return _data;
+}
+
+ColumnarByteReader::ColumnarByteReader(std::vector<uint8_t> const& data)
+    : _data(data)
+{}
+
+std::optional<int> ColumnarByteReader::readOptional()
+{
+    auto value = read<int>();
+    return value != -1 ? std::make_optional(value) : std::nullopt;
+}
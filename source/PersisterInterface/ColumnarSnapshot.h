@@ -0,0 +1,201 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Base/MappedFile.h"
+
+/**
+ * Container format of the columnar .sim files:
+ *
+ *   header (magic, format version, offset and size of the index)
+ *   compressed chunks of all sections
+ *   index (program version, section table with the position of each chunk)
+ *
+ * A section holds one column of fixed-size elements or a blob of bytes (element size 1). Sections are split into chunks of about
+ * ChunkSize bytes which are compressed independently, so that a reader can decompress them directly from a memory-mapped file into
+ * the target arrays. All values are stored in little-endian byte order.
+ */
+namespace ColumnarSnapshot
+{
+    char constexpr Magic[8] = {'A', 'L', 'I', 'E', 'N', 'C', 'O', 'L'};
+    uint32_t constexpr FormatVersion = 2;
+    uint64_t constexpr ChunkSize = 1 << 20;
+
+    struct Header
+    {
+        char magic[8];
+        uint32_t formatVersion;
+        uint32_t reserved;
+        uint64_t indexOffset;
+        uint64_t indexSize;
+    };
+
+    struct Chunk
+    {
+        uint64_t offset = 0;
+        uint64_t compressedSize = 0;
+        uint64_t uncompressedSize = 0;
+    };
+
+    struct Section
+    {
+        uint32_t elementSize = 1;
+        uint64_t numElements = 0;
+        std::vector<Chunk> chunks;
+    };
+
+    bool isColumnarSnapshot(std::filesystem::path const& filename);
+}
+
+using ColumnarSectionId = uint32_t;
+
+class ColumnarSnapshotWriter
+{
+public:
+    ColumnarSnapshotWriter(std::string const& programVersion);
+
+    template <typename T>
+    void addSection(ColumnarSectionId id, std::vector<T> const& elements);
+    void addSection(ColumnarSectionId id, uint32_t elementSize, uint8_t const* data, uint64_t numElements);
+
+    void write(std::ostream& stream) const;
+
+private:
+    struct CompressedSection
+    {
+        uint32_t elementSize = 1;
+        uint64_t numElements = 0;
+        std::vector<std::vector<uint8_t>> compressedChunks;
+        std::vector<uint64_t> uncompressedChunkSizes;
+    };
+
+    std::string _programVersion;
+    std::map<ColumnarSectionId, CompressedSection> _sections;
+};
+
+class ColumnarSnapshotReader
+{
+public:
+    ColumnarSnapshotReader(std::filesystem::path const& filename);  //throws std::runtime_error if the file is not a valid columnar snapshot
+    ColumnarSnapshotReader(std::span<uint8_t const> data);  //data must stay valid during the lifetime of the reader, throws as above
+
+    std::string const& getProgramVersion() const;
+
+    bool hasSection(ColumnarSectionId id) const;
+    uint64_t getNumElements(ColumnarSectionId id) const;
+
+    //decompresses the chunks of a section into target, which must hold getNumElements(id) * elementSize bytes
+    void readSection(ColumnarSectionId id, uint32_t elementSize, uint8_t* target) const;
+
+    template <typename T>
+    std::vector<T> readSection(ColumnarSectionId id) const;
+
+private:
+    void init();  //throws std::runtime_error
+    ColumnarSnapshot::Section const& getSection(ColumnarSectionId id) const;
+
+    std::unique_ptr<MappedFile> _file;
+    std::span<uint8_t const> _data;
+    std::string _programVersion;
+    std::map<ColumnarSectionId, ColumnarSnapshot::Section> _sections;
+};
+
+//byte stream for variable-sized records stored in a section with element size 1
+class ColumnarByteWriter
+{
+public:
+    template <typename T>
+    void write(T const& value);
+    void write(std::optional<int> const& value);  //-1 encodes no value
+    template <typename T>
+    void writeVector(std::vector<T> const& values);
+
+    std::vector<uint8_t> const& getData() const;
+
+private:
+    std::vector<uint8_t> _data;
+};
+
+class ColumnarByteReader
+{
+public:
+    ColumnarByteReader(std::vector<uint8_t> const& data);
+
+    template <typename T>
+    T read();  //throws std::runtime_error if the stream is exhausted
+    std::optional<int> readOptional();
+    template <typename T>
+    std::vector<T> readVector();
+
+private:
+    std::vector<uint8_t> const& _data;
+    size_t _position = 0;
+};
+
+/************************************************************************/
+/* Implementation                                                       */
+/************************************************************************/
+
+template <typename T>
+void ColumnarSnapshotWriter::addSection(ColumnarSectionId id, std::vector<T> const& elements)
+{
+    addSection(id, sizeof(T), reinterpret_cast<uint8_t const*>(elements.data()), elements.size());
+}
+
+template <typename T>
+std::vector<T> ColumnarSnapshotReader::readSection(ColumnarSectionId id) const
+{
+    std::vector<T> result(getNumElements(id));
+    readSection(id, sizeof(T), reinterpret_cast<uint8_t*>(result.data()));
+    return result;
+}
+
+template <typename T>
+void ColumnarByteWriter::write(T const& value)
+{
+    auto bytes = reinterpret_cast<uint8_t const*>(&value);
+    _data.insert(_data.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+void ColumnarByteWriter::writeVector(std::vector<T> const& values)
+{
+    write(static_cast<uint32_t>(values.size()));
+    for (auto const& value : values) {
+        write(value);
+    }
+}
+
+template <typename T>
+T ColumnarByteReader::read()
+{
+    if (_position + sizeof(T) > _data.size()) {
+        throw std::runtime_error("Byte stream of columnar snapshot is truncated.");
+    }
+    T result;
+    std::memcpy(&result, _data.data() + _position, sizeof(T));
+    _position += sizeof(T);
+    return result;
+}
+
+template <typename T>
+std::vector<T> ColumnarByteReader::readVector()
+{
+    auto size = read<uint32_t>();
+    std::vector<T> result;
+    result.reserve(size);
+    for (uint32_t i = 0; i < size; ++i) {
+        result.emplace_back(read<T>());
+    }
+    return result;
+}
@@ -0,0 +1,662 @@
+#include "ColumnarSnapshotService.h"
+
+#include <stdexcept>
+
+#include "Base/Resources.h"
+#include "Base/VersionParserService.h"
+
+#include "ColumnarSnapshot.h"
+
+namespace
+{
+    class BlobReader
+    {
+    public:
+        BlobReader(std::vector<uint8_t> const& data)
+            : _data(data)
+        {}
+
+        template <typename Container>
+        Container read(uint32_t size)
+        {
+            if (_position + size > _data.size()) {
+                throw std::runtime_error("Byte section of columnar snapshot is truncated.");
+            }
+            Container result(_data.begin() + _position, _data.begin() + _position + size);
+            _position += size;
+            return result;
+        }
+
+    private:
+        std::vector<uint8_t> const& _data;
+        size_t _position = 0;
+    };
+
+    void writeCellFunction(ColumnarByteWriter& writer, ColumnarGenomeWriter& genomeWriter, CellDescription const& cell)
+    {
+        auto writeGenome = [&](std::vector<uint8_t> const& genome) { genomeWriter.add(genome); };
+
+        switch (cell.getCellFunctionType()) {
+        case CellFunction_Neuron: {
+            auto const& neuron = std::get<NeuronDescription>(*cell.cellFunction);
+            writer.write(static_cast<uint32_t>(neuron.weights.size()));
+            for (auto const& row : neuron.weights) {
+                writer.writeVector(row);
+            }
+            writer.writeVector(neuron.biases);
+            writer.writeVector(neuron.activationFunctions);
+        } break;
+        case CellFunction_Transmitter: {
+            writer.write(std::get<TransmitterDescription>(*cell.cellFunction).mode);
+        } break;
+        case CellFunction_Constructor: {
+            auto const& constructor = std::get<ConstructorDescription>(*cell.cellFunction);
+            writer.write(constructor.activationMode);
+            writer.write(constructor.constructionActivationTime);
+            writer.write(constructor.numInheritedGenomeNodes);
+            writer.write(constructor.genomeGeneration);
+            writer.write(constructor.constructionAngle1);
+            writer.write(constructor.constructionAngle2);
+            writer.write(constructor.lastConstructedCellId);
+            writer.write(constructor.genomeCurrentNodeIndex);
+            writer.write(constructor.genomeCurrentRepetition);
+            writer.write(constructor.currentBranch);
+            writer.write(constructor.offspringCreatureId);
+            writer.write(constructor.offspringMutationId);
+            writeGenome(constructor.genome);
+        } break;
+        case CellFunction_Sensor: {
+            auto const& sensor = std::get<SensorDescription>(*cell.cellFunction);
+            writer.write(sensor.minDensity);
+            writer.write(sensor.minRange);
+            writer.write(sensor.maxRange);
+            writer.write(sensor.restrictToColor);
+            writer.write(sensor.restrictToMutants);
+            writer.write(sensor.memoryChannel1);
+            writer.write(sensor.memoryChannel2);
+            writer.write(sensor.memoryChannel3);
+            writer.write(sensor.memoryTargetX);
+            writer.write(sensor.memoryTargetY);
+        } break;
+        case CellFunction_Nerve: {
+            auto const& nerve = std::get<NerveDescription>(*cell.cellFunction);
+            writer.write(nerve.pulseMode);
+            writer.write(nerve.alternationMode);
+        } break;
+        case CellFunction_Attacker: {
+            writer.write(std::get<AttackerDescription>(*cell.cellFunction).mode);
+        } break;
+        case CellFunction_Injector: {
+            auto const& injector = std::get<InjectorDescription>(*cell.cellFunction);
+            writer.write(injector.mode);
+            writer.write(injector.counter);
+            writer.write(injector.genomeGeneration);
+            writeGenome(injector.genome);
+        } break;
+        case CellFunction_Muscle: {
+            auto const& muscle = std::get<MuscleDescription>(*cell.cellFunction);
+            writer.write(muscle.mode);
+            writer.write(muscle.lastBendingDirection);
+            writer.write(muscle.lastBendingSourceIndex);
+            writer.write(muscle.consecutiveBendingAngle);
+            writer.write(muscle.lastMovementX);
+            writer.write(muscle.lastMovementY);
+        } break;
+        case CellFunction_Defender: {
+            writer.write(std::get<DefenderDescription>(*cell.cellFunction).mode);
+        } break;
+        case CellFunction_Reconnector: {
+            auto const& reconnector = std::get<ReconnectorDescription>(*cell.cellFunction);
+            writer.write(reconnector.restrictToColor);
+            writer.write(reconnector.restrictToMutants);
+        } break;
+        case CellFunction_Detonator: {
+            auto const& detonator = std::get<DetonatorDescription>(*cell.cellFunction);
+            writer.write(detonator.state);
+            writer.write(detonator.countdown);
+        } break;
+        }
+    }
+
+    CellFunctionDescription readCellFunction(ColumnarByteReader& reader, ColumnarGenomeReader& genomeReader, CellFunction type)
+    {
+        auto readGenome = [&] {
+            auto genome = genomeReader.getGenome(genomeReader.readNextId());
+            return std::vector<uint8_t>(genome.begin(), genome.end());
+        };
+
+        switch (type) {
+        case CellFunction_Neuron: {
+            NeuronDescription neuron;
+            auto numRows = reader.read<uint32_t>();
+            neuron.weights.clear();
+            for (uint32_t i = 0; i < numRows; ++i) {
+                neuron.weights.emplace_back(reader.readVector<float>());
+            }
+            neuron.biases = reader.readVector<float>();
+            neuron.activationFunctions = reader.readVector<NeuronActivationFunction>();
+            return neuron;
+        }
+        case CellFunction_Transmitter: {
+            TransmitterDescription transmitter;
+            transmitter.mode = reader.read<EnergyDistributionMode>();
+            return transmitter;
+        }
+        case CellFunction_Constructor: {
+            ConstructorDescription constructor;
+            constructor.activationMode = reader.read<int>();
+            constructor.constructionActivationTime = reader.read<int>();
+            constructor.numInheritedGenomeNodes = reader.read<int>();
+            constructor.genomeGeneration = reader.read<int>();
+            constructor.constructionAngle1 = reader.read<float>();
+            constructor.constructionAngle2 = reader.read<float>();
+            constructor.lastConstructedCellId = reader.read<uint64_t>();
+            constructor.genomeCurrentNodeIndex = reader.read<int>();
+            constructor.genomeCurrentRepetition = reader.read<int>();
+            constructor.currentBranch = reader.read<int>();
+            constructor.offspringCreatureId = reader.read<int>();
+            constructor.offspringMutationId = reader.read<int>();
+            constructor.genome = readGenome();
+            return constructor;
+        }
+        case CellFunction_Sensor: {
+            SensorDescription sensor;
+            sensor.minDensity = reader.read<float>();
+            sensor.minRange = reader.readOptional();
+            sensor.maxRange = reader.readOptional();
+            sensor.restrictToColor = reader.readOptional();
+            sensor.restrictToMutants = reader.read<SensorRestrictToMutants>();
+            sensor.memoryChannel1 = reader.read<float>();
+            sensor.memoryChannel2 = reader.read<float>();
+            sensor.memoryChannel3 = reader.read<float>();
+            sensor.memoryTargetX = reader.read<float>();
+            sensor.memoryTargetY = reader.read<float>();
+            return sensor;
+        }
+        case CellFunction_Nerve: {
+            NerveDescription nerve;
+            nerve.pulseMode = reader.read<int>();
+            nerve.alternationMode = reader.read<int>();
+            return nerve;
+        }
+        case CellFunction_Attacker: {
+            AttackerDescription attacker;
+            attacker.mode = reader.read<EnergyDistributionMode>();
+            return attacker;
+        }
+        case CellFunction_Injector: {
+            InjectorDescription injector;
+            injector.mode = reader.read<InjectorMode>();
+            injector.counter = reader.read<int>();
+            injector.genomeGeneration = reader.read<int>();
+            injector.genome = readGenome();
+            return injector;
+        }
+        case CellFunction_Muscle: {
+            MuscleDescription muscle;
+            muscle.mode = reader.read<MuscleMode>();
+            muscle.lastBendingDirection = reader.read<MuscleBendingDirection>();
+            muscle.lastBendingSourceIndex = reader.read<int>();
+            muscle.consecutiveBendingAngle = reader.read<float>();
+            muscle.lastMovementX = reader.read<float>();
+            muscle.lastMovementY = reader.read<float>();
+            return muscle;
+        }
+        case CellFunction_Defender: {
+            DefenderDescription defender;
+            defender.mode = reader.read<DefenderMode>();
+            return defender;
+        }
+        case CellFunction_Reconnector: {
+            ReconnectorDescription reconnector;
+            reconnector.restrictToColor = reader.readOptional();
+            reconnector.restrictToMutants = reader.read<ReconnectorRestrictToMutants>();
+            return reconnector;
+        }
+        case CellFunction_Detonator: {
+            DetonatorDescription detonator;
+            detonator.state = reader.read<DetonatorState>();
+            detonator.countdown = reader.read<int>();
+            return detonator;
+        }
+        case CellFunction_None:
+            return std::nullopt;
+        }
+        throw std::runtime_error("Unknown cell function in columnar snapshot.");
+    }
+
+    template <typename T>
+    std::vector<T> readColumn(ColumnarSnapshotReader const& reader, ColumnarSnapshotSection section, size_t expectedSize)
+    {
+        auto result = reader.readSection<T>(section);
+        if (result.size() != expectedSize) {
+            throw std::runtime_error("Section " + std::to_string(section) + " of columnar snapshot has an unexpected size.");
+        }
+        return result;
+    }
+}
+
+void ColumnarGenomeWriter::add(std::span<uint8_t const> genome)
+{
+    _genomeIds.emplace_back(static_cast<uint32_t>(_pool.add(genome)));
+}
+
+void ColumnarGenomeWriter::addSections(ColumnarSnapshotWriter& writer) const
+{
+    std::vector<uint32_t> genomeSizes;
+    std::vector<uint8_t> genomeData;
+    for (int id = 0; id < _pool.getNumGenomes(); ++id) {
+        auto genome = _pool.getGenome(id);
+        genomeSizes.emplace_back(static_cast<uint32_t>(genome.size()));
+        genomeData.insert(genomeData.end(), genome.begin(), genome.end());
+    }
+    writer.addSection(ColumnarSnapshotSection_GenomeSizes, genomeSizes);
+    writer.addSection(ColumnarSnapshotSection_GenomeData, genomeData);
+    writer.addSection(ColumnarSnapshotSection_GenomeIds, _genomeIds);
+}
+
+ColumnarGenomeReader::ColumnarGenomeReader(ColumnarSnapshotReader const& reader)
+    : _genomeData(reader.readSection<uint8_t>(ColumnarSnapshotSection_GenomeData))
+{
+    auto genomeSizes = reader.readSection<uint32_t>(ColumnarSnapshotSection_GenomeSizes);
+    _genomeOffsets.reserve(genomeSizes.size() + 1);
+    _genomeOffsets.emplace_back(0);
+    for (auto const& genomeSize : genomeSizes) {
+        _genomeOffsets.emplace_back(_genomeOffsets.back() + genomeSize);
+    }
+    if (_genomeOffsets.back() > _genomeData.size()) {
+        throw std::runtime_error("Genome data of columnar snapshot is truncated.");
+    }
+    if (reader.hasSection(ColumnarSnapshotSection_GenomeIds)) {
+        _genomeIds = reader.readSection<uint32_t>(ColumnarSnapshotSection_GenomeIds);
+    }
+}
+
+uint32_t ColumnarGenomeReader::readNextId()
+{
+    if (_genomeIds && _referenceIndex >= _genomeIds->size()) {
+        throw std::runtime_error("Genome missing in columnar snapshot.");
+    }
+    auto result = _genomeIds ? _genomeIds->at(_referenceIndex) : static_cast<uint32_t>(_referenceIndex);
+    if (result >= _genomeOffsets.size() - 1) {
+        throw std::runtime_error("Genome missing in columnar snapshot.");
+    }
+    ++_referenceIndex;
+    return result;
+}
+
+std::span<uint8_t const> ColumnarGenomeReader::getGenome(uint32_t id) const
+{
+    return std::span<uint8_t const>(_genomeData.data() + _genomeOffsets.at(id), _genomeOffsets.at(id + 1) - _genomeOffsets.at(id));
+}
+
+uint32_t ColumnarGenomeReader::getNumGenomes() const
+{
+    return static_cast<uint32_t>(_genomeOffsets.size() - 1);
+}
+
+uint64_t ColumnarGenomeReader::getDataSize() const
+{
+    return _genomeData.size();
+}
+
+void ColumnarSnapshotService::serialize(ClusteredDataDescription const& data, std::ostream& stream) const
+{
+    ColumnarSnapshotWriter writer(Const::ProgramVersion);
+    addSections(writer, data);
+    writer.write(stream);
+}
+
+void ColumnarSnapshotService::serialize(SimulationDelta const& delta, std::ostream& stream) const
+{
+    auto baseFilename = delta.baseFilename.generic_u8string();
+
+    ColumnarSnapshotWriter writer(Const::ProgramVersion);
+    addSections(writer, delta.changedContent);
+    writer.addSection(ColumnarSnapshotSection_DeltaBaseFilename, 1, reinterpret_cast<uint8_t const*>(baseFilename.data()), baseFilename.size());
+    writer.addSection(ColumnarSnapshotSection_DeltaRemovedCellIds, delta.removedCellIds);
+    writer.addSection(ColumnarSnapshotSection_DeltaRemovedParticleIds, delta.removedParticleIds);
+    writer.write(stream);
+}
+
+void ColumnarSnapshotService::deserialize(ClusteredDataDescription& data, std::filesystem::path const& filename) const
+{
+    deserialize(data, ColumnarSnapshotReader(filename));
+}
+
+void ColumnarSnapshotService::deserialize(SimulationDelta& delta, std::filesystem::path const& filename) const
+{
+    deserialize(delta, ColumnarSnapshotReader(filename));
+}
+
+void ColumnarSnapshotService::deserialize(ClusteredDataDescription& data, std::span<uint8_t const> bytes) const
+{
+    deserialize(data, ColumnarSnapshotReader(bytes));
+}
+
+void ColumnarSnapshotService::deserialize(SimulationDelta& delta, std::span<uint8_t const> bytes) const
+{
+    deserialize(delta, ColumnarSnapshotReader(bytes));
+}
+
+std::optional<std::filesystem::path> ColumnarSnapshotService::getDeltaBaseFilename(std::filesystem::path const& filename) const
+{
+    if (!ColumnarSnapshot::isColumnarSnapshot(filename)) {
+        return std::nullopt;
+    }
+    ColumnarSnapshotReader reader(filename);
+    if (!isDelta(reader)) {
+        return std::nullopt;
+    }
+    return getDeltaBaseFilename(reader);
+}
+
+bool ColumnarSnapshotService::isDelta(ColumnarSnapshotReader const& reader) const
+{
+    return reader.hasSection(ColumnarSnapshotSection_DeltaBaseFilename);
+}
+
+void ColumnarSnapshotService::checkProgramVersion(ColumnarSnapshotReader const& reader) const
+{
+    auto const& version = reader.getProgramVersion();
+    if (!VersionParserService::get().isVersionValid(version)) {
+        throw std::runtime_error("No version detected.");
+    }
+    if (VersionParserService::get().isVersionOutdated(version)) {
+        throw std::runtime_error("Version not supported.");
+    }
+}
+
+void ColumnarSnapshotService::deserialize(ClusteredDataDescription& data, ColumnarSnapshotReader const& reader) const
+{
+    checkProgramVersion(reader);
+    if (isDelta(reader)) {
+        throw std::runtime_error("Columnar snapshot only contains the changes to another snapshot.");
+    }
+    readSections(data, reader);
+}
+
+void ColumnarSnapshotService::deserialize(SimulationDelta& delta, ColumnarSnapshotReader const& reader) const
+{
+    checkProgramVersion(reader);
+    if (!isDelta(reader)) {
+        throw std::runtime_error("Columnar snapshot is not a delta snapshot.");
+    }
+    readSections(delta.changedContent, reader);
+    delta.baseFilename = getDeltaBaseFilename(reader);
+    delta.removedCellIds = reader.readSection<uint64_t>(ColumnarSnapshotSection_DeltaRemovedCellIds);
+    delta.removedParticleIds = reader.readSection<uint64_t>(ColumnarSnapshotSection_DeltaRemovedParticleIds);
+}
+
+std::filesystem::path ColumnarSnapshotService::getDeltaBaseFilename(ColumnarSnapshotReader const& reader) const
+{
+    auto baseFilename = reader.readSection<char8_t>(ColumnarSnapshotSection_DeltaBaseFilename);
+    return std::filesystem::path(std::u8string(baseFilename.begin(), baseFilename.end()));
+}
+
+void ColumnarSnapshotService::addSections(ColumnarSnapshotWriter& writer, ClusteredDataDescription const& data) const
+{
+    std::vector<uint32_t> clusterNumCells;
+    clusterNumCells.reserve(data.clusters.size());
+    size_t numCells = 0;
+    for (auto const& cluster : data.clusters) {
+        clusterNumCells.emplace_back(static_cast<uint32_t>(cluster.cells.size()));
+        numCells += cluster.cells.size();
+    }
+
+    std::vector<uint64_t> id;
+    std::vector<float> posX, posY, velX, velY, energy, stiffness, genomeComplexity, signalChannels, signalTargetX, signalTargetY;
+    std::vector<uint8_t> color, maxConnections, barrier, livingState, ancestorMutationId, outputBlocked, cellFunction, signalOrigin, cellFunctionUsed,
+        numConnections;
+    std::vector<int32_t> age, creatureId, mutationId, executionOrderNumber, inputExecutionOrderNumber, activationTime, detectedByCreatureId;
+    for (auto column : {&posX, &posY, &velX, &velY, &energy, &stiffness, &genomeComplexity, &signalTargetX, &signalTargetY}) {
+        column->reserve(numCells);
+    }
+    signalChannels.reserve(numCells * MAX_CHANNELS);
+
+    std::vector<uint64_t> connectionCellId;
+    std::vector<float> connectionDistance, connectionAngleFromPrevious;
+
+    ColumnarByteWriter cellFunctionData;
+    ColumnarGenomeWriter genomeWriter;
+    std::vector<uint32_t> metadataNameSizes, metadataDescriptionSizes;
+    std::vector<uint8_t> metadataStrings;
+
+    for (auto const& cluster : data.clusters) {
+        for (auto const& cell : cluster.cells) {
+            id.emplace_back(cell.id);
+            posX.emplace_back(cell.pos.x);
+            posY.emplace_back(cell.pos.y);
+            velX.emplace_back(cell.vel.x);
+            velY.emplace_back(cell.vel.y);
+            energy.emplace_back(cell.energy);
+            stiffness.emplace_back(cell.stiffness);
+            color.emplace_back(static_cast<uint8_t>(cell.color));
+            maxConnections.emplace_back(static_cast<uint8_t>(cell.maxConnections));
+            barrier.emplace_back(cell.barrier ? 1 : 0);
+            age.emplace_back(cell.age);
+            livingState.emplace_back(static_cast<uint8_t>(cell.livingState));
+            creatureId.emplace_back(cell.creatureId);
+            mutationId.emplace_back(cell.mutationId);
+            ancestorMutationId.emplace_back(cell.ancestorMutationId);
+            genomeComplexity.emplace_back(cell.genomeComplexity);
+            executionOrderNumber.emplace_back(cell.executionOrderNumber);
+            inputExecutionOrderNumber.emplace_back(cell.inputExecutionOrderNumber.value_or(-1));
+            outputBlocked.emplace_back(cell.outputBlocked ? 1 : 0);
+            cellFunction.emplace_back(static_cast<uint8_t>(cell.getCellFunctionType()));
+            for (int i = 0; i < MAX_CHANNELS; ++i) {
+                signalChannels.emplace_back(i < toInt(cell.signal.channels.size()) ? cell.signal.channels.at(i) : 0.0f);
+            }
+            signalOrigin.emplace_back(cell.signal.origin);
+            signalTargetX.emplace_back(cell.signal.targetX);
+            signalTargetY.emplace_back(cell.signal.targetY);
+            activationTime.emplace_back(cell.activationTime);
+            detectedByCreatureId.emplace_back(cell.detectedByCreatureId);
+            cellFunctionUsed.emplace_back(cell.cellFunctionUsed);
+
+            numConnections.emplace_back(static_cast<uint8_t>(cell.connections.size()));
+            for (auto const& connection : cell.connections) {
+                connectionCellId.emplace_back(connection.cellId);
+                connectionDistance.emplace_back(connection.distance);
+                connectionAngleFromPrevious.emplace_back(connection.angleFromPrevious);
+            }
+
+            writeCellFunction(cellFunctionData, genomeWriter, cell);
+
+            metadataNameSizes.emplace_back(static_cast<uint32_t>(cell.metadata.name.size()));
+            metadataDescriptionSizes.emplace_back(static_cast<uint32_t>(cell.metadata.description.size()));
+            metadataStrings.insert(metadataStrings.end(), cell.metadata.name.begin(), cell.metadata.name.end());
+            metadataStrings.insert(metadataStrings.end(), cell.metadata.description.begin(), cell.metadata.description.end());
+        }
+    }
+
+    writer.addSection(ColumnarSnapshotSection_ClusterNumCells, clusterNumCells);
+
+    writer.addSection(ColumnarSnapshotSection_CellId, id);
+    writer.addSection(ColumnarSnapshotSection_CellPosX, posX);
+    writer.addSection(ColumnarSnapshotSection_CellPosY, posY);
+    writer.addSection(ColumnarSnapshotSection_CellVelX, velX);
+    writer.addSection(ColumnarSnapshotSection_CellVelY, velY);
+    writer.addSection(ColumnarSnapshotSection_CellEnergy, energy);
+    writer.addSection(ColumnarSnapshotSection_CellStiffness, stiffness);
+    writer.addSection(ColumnarSnapshotSection_CellColor, color);
+    writer.addSection(ColumnarSnapshotSection_CellMaxConnections, maxConnections);
+    writer.addSection(ColumnarSnapshotSection_CellBarrier, barrier);
+    writer.addSection(ColumnarSnapshotSection_CellAge, age);
+    writer.addSection(ColumnarSnapshotSection_CellLivingState, livingState);
+    writer.addSection(ColumnarSnapshotSection_CellCreatureId, creatureId);
+    writer.addSection(ColumnarSnapshotSection_CellMutationId, mutationId);
+    writer.addSection(ColumnarSnapshotSection_CellAncestorMutationId, ancestorMutationId);
+    writer.addSection(ColumnarSnapshotSection_CellGenomeComplexity, genomeComplexity);
+    writer.addSection(ColumnarSnapshotSection_CellExecutionOrderNumber, executionOrderNumber);
+    writer.addSection(ColumnarSnapshotSection_CellInputExecutionOrderNumber, inputExecutionOrderNumber);
+    writer.addSection(ColumnarSnapshotSection_CellOutputBlocked, outputBlocked);
+    writer.addSection(ColumnarSnapshotSection_CellCellFunction, cellFunction);
+    writer.addSection(ColumnarSnapshotSection_CellSignalChannels, signalChannels);
+    writer.addSection(ColumnarSnapshotSection_CellSignalOrigin, signalOrigin);
+    writer.addSection(ColumnarSnapshotSection_CellSignalTargetX, signalTargetX);
+    writer.addSection(ColumnarSnapshotSection_CellSignalTargetY, signalTargetY);
+    writer.addSection(ColumnarSnapshotSection_CellActivationTime, activationTime);
+    writer.addSection(ColumnarSnapshotSection_CellDetectedByCreatureId, detectedByCreatureId);
+    writer.addSection(ColumnarSnapshotSection_CellCellFunctionUsed, cellFunctionUsed);
+    writer.addSection(ColumnarSnapshotSection_CellNumConnections, numConnections);
+
+    writer.addSection(ColumnarSnapshotSection_ConnectionCellId, connectionCellId);
+    writer.addSection(ColumnarSnapshotSection_ConnectionDistance, connectionDistance);
+    writer.addSection(ColumnarSnapshotSection_ConnectionAngleFromPrevious, connectionAngleFromPrevious);
+
+    writer.addSection(ColumnarSnapshotSection_CellFunctionData, cellFunctionData.getData());
+    genomeWriter.addSections(writer);
+    writer.addSection(ColumnarSnapshotSection_MetadataNameSizes, metadataNameSizes);
+    writer.addSection(ColumnarSnapshotSection_MetadataDescriptionSizes, metadataDescriptionSizes);
+    writer.addSection(ColumnarSnapshotSection_MetadataStrings, metadataStrings);
+
+    std::vector<uint64_t> particleId;
+    std::vector<float> particlePosX, particlePosY, particleVelX, particleVelY, particleEnergy;
+    std::vector<uint8_t> particleColor;
+    for (auto const& particle : data.particles) {
+        particleId.emplace_back(particle.id);
+        particlePosX.emplace_back(particle.pos.x);
+        particlePosY.emplace_back(particle.pos.y);
+        particleVelX.emplace_back(particle.vel.x);
+        particleVelY.emplace_back(particle.vel.y);
+        particleEnergy.emplace_back(particle.energy);
+        particleColor.emplace_back(static_cast<uint8_t>(particle.color));
+    }
+    writer.addSection(ColumnarSnapshotSection_ParticleId, particleId);
+    writer.addSection(ColumnarSnapshotSection_ParticlePosX, particlePosX);
+    writer.addSection(ColumnarSnapshotSection_ParticlePosY, particlePosY);
+    writer.addSection(ColumnarSnapshotSection_ParticleVelX, particleVelX);
+    writer.addSection(ColumnarSnapshotSection_ParticleVelY, particleVelY);
+    writer.addSection(ColumnarSnapshotSection_ParticleEnergy, particleEnergy);
+    writer.addSection(ColumnarSnapshotSection_ParticleColor, particleColor);
+}
+
+void ColumnarSnapshotService::readSections(ClusteredDataDescription& data, ColumnarSnapshotReader const& reader) const
+{
+    auto clusterNumCells = reader.readSection<uint32_t>(ColumnarSnapshotSection_ClusterNumCells);
+    auto numCells = reader.getNumElements(ColumnarSnapshotSection_CellId);
+
+    auto id = readColumn<uint64_t>(reader, ColumnarSnapshotSection_CellId, numCells);
+    auto posX = readColumn<float>(reader, ColumnarSnapshotSection_CellPosX, numCells);
+    auto posY = readColumn<float>(reader, ColumnarSnapshotSection_CellPosY, numCells);
+    auto velX = readColumn<float>(reader, ColumnarSnapshotSection_CellVelX, numCells);
+    auto velY = readColumn<float>(reader, ColumnarSnapshotSection_CellVelY, numCells);
+    auto energy = readColumn<float>(reader, ColumnarSnapshotSection_CellEnergy, numCells);
+    auto stiffness = readColumn<float>(reader, ColumnarSnapshotSection_CellStiffness, numCells);
+    auto color = readColumn<uint8_t>(reader, ColumnarSnapshotSection_CellColor, numCells);
+    auto maxConnections = readColumn<uint8_t>(reader, ColumnarSnapshotSection_CellMaxConnections, numCells);
+    auto barrier = readColumn<uint8_t>(reader, ColumnarSnapshotSection_CellBarrier, numCells);
+    auto age = readColumn<int32_t>(reader, ColumnarSnapshotSection_CellAge, numCells);
+    auto livingState = readColumn<uint8_t>(reader, ColumnarSnapshotSection_CellLivingState, numCells);
+    auto creatureId = readColumn<int32_t>(reader, ColumnarSnapshotSection_CellCreatureId, numCells);
+    auto mutationId = readColumn<int32_t>(reader, ColumnarSnapshotSection_CellMutationId, numCells);
+    auto ancestorMutationId = readColumn<uint8_t>(reader, ColumnarSnapshotSection_CellAncestorMutationId, numCells);
+    auto genomeComplexity = readColumn<float>(reader, ColumnarSnapshotSection_CellGenomeComplexity, numCells);
+    auto executionOrderNumber = readColumn<int32_t>(reader, ColumnarSnapshotSection_CellExecutionOrderNumber, numCells);
+    auto inputExecutionOrderNumber = readColumn<int32_t>(reader, ColumnarSnapshotSection_CellInputExecutionOrderNumber, numCells);
+    auto outputBlocked = readColumn<uint8_t>(reader, ColumnarSnapshotSection_CellOutputBlocked, numCells);
+    auto cellFunction = readColumn<uint8_t>(reader, ColumnarSnapshotSection_CellCellFunction, numCells);
+    auto signalChannels = readColumn<float>(reader, ColumnarSnapshotSection_CellSignalChannels, numCells * MAX_CHANNELS);
+    auto signalOrigin = readColumn<uint8_t>(reader, ColumnarSnapshotSection_CellSignalOrigin, numCells);
+    auto signalTargetX = readColumn<float>(reader, ColumnarSnapshotSection_CellSignalTargetX, numCells);
+    auto signalTargetY = readColumn<float>(reader, ColumnarSnapshotSection_CellSignalTargetY, numCells);
+    auto activationTime = readColumn<int32_t>(reader, ColumnarSnapshotSection_CellActivationTime, numCells);
+    auto detectedByCreatureId = readColumn<int32_t>(reader, ColumnarSnapshotSection_CellDetectedByCreatureId, numCells);
+    auto cellFunctionUsed = readColumn<uint8_t>(reader, ColumnarSnapshotSection_CellCellFunctionUsed, numCells);
+    auto numConnections = readColumn<uint8_t>(reader, ColumnarSnapshotSection_CellNumConnections, numCells);
+
+    auto numConnectionEntries = reader.getNumElements(ColumnarSnapshotSection_ConnectionCellId);
+    auto connectionCellId = readColumn<uint64_t>(reader, ColumnarSnapshotSection_ConnectionCellId, numConnectionEntries);
+    auto connectionDistance = readColumn<float>(reader, ColumnarSnapshotSection_ConnectionDistance, numConnectionEntries);
+    auto connectionAngleFromPrevious = readColumn<float>(reader, ColumnarSnapshotSection_ConnectionAngleFromPrevious, numConnectionEntries);
+
+    auto cellFunctionData = reader.readSection<uint8_t>(ColumnarSnapshotSection_CellFunctionData);
+    auto metadataNameSizes = readColumn<uint32_t>(reader, ColumnarSnapshotSection_MetadataNameSizes, numCells);
+    auto metadataDescriptionSizes = readColumn<uint32_t>(reader, ColumnarSnapshotSection_MetadataDescriptionSizes, numCells);
+    auto metadataStrings = reader.readSection<uint8_t>(ColumnarSnapshotSection_MetadataStrings);
+
+    ColumnarByteReader cellFunctionReader(cellFunctionData);
+    ColumnarGenomeReader genomeReader(reader);
+    BlobReader metadataReader(metadataStrings);
+    size_t connectionIndex = 0;
+    size_t cellIndex = 0;
+
+    data.clusters.clear();
+    data.clusters.reserve(clusterNumCells.size());
+    for (auto const& clusterSize : clusterNumCells) {
+        if (cellIndex + clusterSize > numCells) {
+            throw std::runtime_error("Cluster of columnar snapshot exceeds the number of cells.");
+        }
+        ClusterDescription cluster;
+        cluster.cells.reserve(clusterSize);
+        for (uint32_t i = 0; i < clusterSize; ++i, ++cellIndex) {
+            CellDescription cell;
+            cell.id = id[cellIndex];
+            cell.pos = {posX[cellIndex], posY[cellIndex]};
+            cell.vel = {velX[cellIndex], velY[cellIndex]};
+            cell.energy = energy[cellIndex];
+            cell.stiffness = stiffness[cellIndex];
+            cell.color = color[cellIndex];
+            cell.maxConnections = maxConnections[cellIndex];
+            cell.barrier = barrier[cellIndex] != 0;
+            cell.age = age[cellIndex];
+            cell.livingState = livingState[cellIndex];
+            cell.creatureId = creatureId[cellIndex];
+            cell.mutationId = mutationId[cellIndex];
+            cell.ancestorMutationId = ancestorMutationId[cellIndex];
+            cell.genomeComplexity = genomeComplexity[cellIndex];
+            cell.executionOrderNumber = executionOrderNumber[cellIndex];
+            if (inputExecutionOrderNumber[cellIndex] != -1) {
+                cell.inputExecutionOrderNumber = inputExecutionOrderNumber[cellIndex];
+            }
+            cell.outputBlocked = outputBlocked[cellIndex] != 0;
+            cell.cellFunction = readCellFunction(cellFunctionReader, genomeReader, cellFunction[cellIndex]);
+            cell.signal.channels.assign(signalChannels.begin() + cellIndex * MAX_CHANNELS, signalChannels.begin() + (cellIndex + 1) * MAX_CHANNELS);
+            cell.signal.origin = signalOrigin[cellIndex];
+            cell.signal.targetX = signalTargetX[cellIndex];
+            cell.signal.targetY = signalTargetY[cellIndex];
+            cell.activationTime = activationTime[cellIndex];
+            cell.detectedByCreatureId = detectedByCreatureId[cellIndex];
+            cell.cellFunctionUsed = cellFunctionUsed[cellIndex];
+
+            if (connectionIndex + numConnections[cellIndex] > numConnectionEntries) {
+                throw std::runtime_error("Connections of columnar snapshot are truncated.");
+            }
+            cell.connections.reserve(numConnections[cellIndex]);
+            for (int j = 0; j < numConnections[cellIndex]; ++j, ++connectionIndex) {
+                ConnectionDescription connection;
+                connection.cellId = connectionCellId[connectionIndex];
+                connection.distance = connectionDistance[connectionIndex];
+                connection.angleFromPrevious = connectionAngleFromPrevious[connectionIndex];
+                cell.connections.emplace_back(connection);
+            }
+
+            cell.metadata.name = metadataReader.read<std::string>(metadataNameSizes[cellIndex]);
+            cell.metadata.description = metadataReader.read<std::string>(metadataDescriptionSizes[cellIndex]);
+            cluster.cells.emplace_back(std::move(cell));
+        }
+        data.clusters.emplace_back(std::move(cluster));
+    }
+
+    auto numParticles = reader.getNumElements(ColumnarSnapshotSection_ParticleId);
+    auto particleId = readColumn<uint64_t>(reader, ColumnarSnapshotSection_ParticleId, numParticles);
+    auto particlePosX = readColumn<float>(reader, ColumnarSnapshotSection_ParticlePosX, numParticles);
+    auto particlePosY = readColumn<float>(reader, ColumnarSnapshotSection_ParticlePosY, numParticles);
+    auto particleVelX = readColumn<float>(reader, ColumnarSnapshotSection_ParticleVelX, numParticles);
+    auto particleVelY = readColumn<float>(reader, ColumnarSnapshotSection_ParticleVelY, numParticles);
+    auto particleEnergy = readColumn<float>(reader, ColumnarSnapshotSection_ParticleEnergy, numParticles);
+    auto particleColor = readColumn<uint8_t>(reader, ColumnarSnapshotSection_ParticleColor, numParticles);
+
+    data.particles.clear();
+    data.particles.reserve(numParticles);
+    for (size_t i = 0; i < numParticles; ++i) {
+        ParticleDescription particle;
+        particle.id = particleId[i];
+        particle.pos = {particlePosX[i], particlePosY[i]};
+        particle.vel = {particleVelX[i], particleVelY[i]};
+        particle.energy = particleEnergy[i];
+        particle.color = particleColor[i];
+        data.particles.emplace_back(particle);
+    }
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <ostream>
+#include <span>
+
+#include "Base/Singleton.h"
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/GenomePool.h"
+
+#include "ColumnarSnapshot.h"
+#include "Definitions.h"
+#include "SimulationDelta.h"
+
+using ColumnarSnapshotSection = int;
+enum ColumnarSnapshotSection_
+{
+    ColumnarSnapshotSection_ClusterNumCells,
+
+    ColumnarSnapshotSection_CellId,
+    ColumnarSnapshotSection_CellPosX,
+    ColumnarSnapshotSection_CellPosY,
+    ColumnarSnapshotSection_CellVelX,
+    ColumnarSnapshotSection_CellVelY,
+    ColumnarSnapshotSection_CellEnergy,
+    ColumnarSnapshotSection_CellStiffness,
+    ColumnarSnapshotSection_CellColor,
+    ColumnarSnapshotSection_CellMaxConnections,
+    ColumnarSnapshotSection_CellBarrier,
+    ColumnarSnapshotSection_CellAge,
+    ColumnarSnapshotSection_CellLivingState,
+    ColumnarSnapshotSection_CellCreatureId,
+    ColumnarSnapshotSection_CellMutationId,
+    ColumnarSnapshotSection_CellAncestorMutationId,
+    ColumnarSnapshotSection_CellGenomeComplexity,
+    ColumnarSnapshotSection_CellExecutionOrderNumber,
+    ColumnarSnapshotSection_CellInputExecutionOrderNumber,
+    ColumnarSnapshotSection_CellOutputBlocked,
+    ColumnarSnapshotSection_CellCellFunction,
+    ColumnarSnapshotSection_CellSignalChannels,
+    ColumnarSnapshotSection_CellSignalOrigin,
+    ColumnarSnapshotSection_CellSignalTargetX,
+    ColumnarSnapshotSection_CellSignalTargetY,
+    ColumnarSnapshotSection_CellActivationTime,
+    ColumnarSnapshotSection_CellDetectedByCreatureId,
+    ColumnarSnapshotSection_CellCellFunctionUsed,
+    ColumnarSnapshotSection_CellNumConnections,
+
+    ColumnarSnapshotSection_ConnectionCellId,
+    ColumnarSnapshotSection_ConnectionDistance,
+    ColumnarSnapshotSection_ConnectionAngleFromPrevious,
+
+    ColumnarSnapshotSection_CellFunctionData,
+    ColumnarSnapshotSection_GenomeSizes,
+    ColumnarSnapshotSection_GenomeData,
+    ColumnarSnapshotSection_MetadataNameSizes,
+    ColumnarSnapshotSection_MetadataDescriptionSizes,
+    ColumnarSnapshotSection_MetadataStrings,
+
+    ColumnarSnapshotSection_ParticleId,
+    ColumnarSnapshotSection_ParticlePosX,
+    ColumnarSnapshotSection_ParticlePosY,
+    ColumnarSnapshotSection_ParticleVelX,
+    ColumnarSnapshotSection_ParticleVelY,
+    ColumnarSnapshotSection_ParticleEnergy,
+    ColumnarSnapshotSection_ParticleColor,
+
+    ColumnarSnapshotSection_GenomeIds,
+
+    ColumnarSnapshotSection_DeltaBaseFilename,
+    ColumnarSnapshotSection_DeltaRemovedCellIds,
+    ColumnarSnapshotSection_DeltaRemovedParticleIds,
+};
+
+/**
+ * Genomes are stored once per distinct content in GenomeSizes/GenomeData and referenced by constructors and injectors in the order of
+ * the cells via GenomeIds. Files of format version 1 lack GenomeIds and contain one genome per reference.
+ */
+class ColumnarGenomeWriter
+{
+public:
+    void add(std::span<uint8_t const> genome);  //genome must stay valid until addSections has been called
+    void addSections(ColumnarSnapshotWriter& writer) const;
+
+private:
+    GenomePool _pool;
+    std::vector<uint32_t> _genomeIds;
+};
+
+class ColumnarGenomeReader
+{
+public:
+    ColumnarGenomeReader(ColumnarSnapshotReader const& reader);
+
+    uint32_t readNextId();  //throws std::runtime_error
+    std::span<uint8_t const> getGenome(uint32_t id) const;
+
+    uint32_t getNumGenomes() const;
+    uint64_t getDataSize() const;
+
+private:
+    std::vector<uint8_t> _genomeData;
+    std::vector<uint64_t> _genomeOffsets;  //contains one more entry than genomes
+    std::optional<std::vector<uint32_t>> _genomeIds;
+    size_t _referenceIndex = 0;
+};
+
+/**
+ * Converts the simulation content into the columnar .sim format (see ColumnarSnapshot.h).
+ * Each cell and particle property is stored in its own section, variable-sized data such as the cell function properties and metadata
+ * are stored in byte sections in the order of the cells.
+ * A delta snapshot stores the changed content in the same sections and additionally the base file and the ids of the removed objects.
+ */
+class ColumnarSnapshotService
+{
+    MAKE_SINGLETON(ColumnarSnapshotService);
+
+public:
+    void serialize(ClusteredDataDescription const& data, std::ostream& stream) const;
+    void serialize(SimulationDelta const& delta, std::ostream& stream) const;
+    void deserialize(ClusteredDataDescription& data, std::filesystem::path const& filename) const;  //throws std::runtime_error
+    void deserialize(SimulationDelta& delta, std::filesystem::path const& filename) const;  //throws std::runtime_error
+    void deserialize(ClusteredDataDescription& data, std::span<uint8_t const> bytes) const;  //throws std::runtime_error
+    void deserialize(SimulationDelta& delta, std::span<uint8_t const> bytes) const;  //throws std::runtime_error
+
+    //returns std::nullopt for files which are no delta snapshots
+    std::optional<std::filesystem::path> getDeltaBaseFilename(std::filesystem::path const& filename) const;  //throws std::runtime_error
+
+    bool isDelta(ColumnarSnapshotReader const& reader) const;
+    void checkProgramVersion(ColumnarSnapshotReader const& reader) const;  //throws std::runtime_error
+
+private:
+    void deserialize(ClusteredDataDescription& data, ColumnarSnapshotReader const& reader) const;
+    void deserialize(SimulationDelta& delta, ColumnarSnapshotReader const& reader) const;
+    std::filesystem::path getDeltaBaseFilename(ColumnarSnapshotReader const& reader) const;
+
+    void addSections(ColumnarSnapshotWriter& writer, ClusteredDataDescription const& data) const;
+    void readSections(ClusteredDataDescription& data, ColumnarSnapshotReader const& reader) const;
+};
@@ -0,0 +1,25 @@
+#include "CompressionService.h"
+
+#include <stdexcept>
+
+#include <zlib.h>
+
+std::vector<uint8_t> CompressionService::compressBlock(uint8_t const* data, uint64_t size) const
+{
+    auto compressedSize = compressBound(static_cast<uLong>(size));
+    std::vector<uint8_t> result(compressedSize);
+    if (compress2(result.data(), &compressedSize, data, static_cast<uLong>(size), Level) != Z_OK) {
+        throw std::runtime_error("Could not compress data.");
+    }
+    result.resize(compressedSize);
+    return result;
+}
+
+void CompressionService::decompressBlock(uint8_t* target, uint64_t size, uint8_t const* data, uint64_t compressedSize) const
+{
+    auto uncompressedSize = static_cast<uLongf>(size);
+    auto result = uncompress(target, &uncompressedSize, data, static_cast<uLong>(compressedSize));
+    if (result != Z_OK || uncompressedSize != size) {
+        throw std::runtime_error("Could not decompress data.");
+    }
+}
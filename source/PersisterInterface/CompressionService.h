@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Base/Singleton.h"
+
+#include "Definitions.h"
+
+/**
+ * Deflates independent blocks for container formats (e.g. columnar snapshots), hence blocks can be compressed and decompressed in parallel.
+ */
+class CompressionService
+{
+    MAKE_SINGLETON(CompressionService);
+
+public:
+    static int constexpr Level = 1;  //zlib compression level, favours throughput
+
+    std::vector<uint8_t> compressBlock(uint8_t const* data, uint64_t size) const;  //throws std::runtime_error
+    void decompressBlock(uint8_t* target, uint64_t size, uint8_t const* data, uint64_t compressedSize) const;  //throws std::runtime_error
+};
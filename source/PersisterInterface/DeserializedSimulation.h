@@ -10,4 +10,5 @@ struct DeserializedSimulation
     ClusteredDataDescription mainData;
     AuxiliaryData auxiliaryData;
     StatisticsHistoryData statistics;
+    uint64_t numStableStatistics = 0;  //leading rows of statistics which are not changed by the history anymore
 };
@@ -0,0 +1,37 @@
+#include "DownloadCache.h"
+
+#include <variant>
+
+_DownloadCache::_DownloadCache()
+    : Cache(MaxBytes, estimateSize)
+{}
+
+uint64_t _DownloadCache::estimateSize(DeserializedSimulation const& simulation)
+{
+    uint64_t result = sizeof(DeserializedSimulation);
+    result += simulation.statistics.size() * sizeof(DataPointCollection);
+    result += simulation.mainData.particles.size() * sizeof(ParticleDescription);
+    for (auto const& cluster : simulation.mainData.clusters) {
+        result += sizeof(ClusterDescription);
+        for (auto const& cell : cluster.cells) {
+            result += sizeof(CellDescription);
+            result += cell.connections.size() * sizeof(ConnectionDescription);
+            result += cell.signal.channels.size() * sizeof(float);
+            result += cell.metadata.name.size() + cell.metadata.description.size();
+            if (!cell.cellFunction) {
+                continue;
+            }
+            if (auto neuron = std::get_if<NeuronDescription>(&*cell.cellFunction)) {
+                result += neuron->weights.size() * (sizeof(std::vector<float>) + MAX_CHANNELS * sizeof(float));
+                result += neuron->biases.size() * sizeof(float) + neuron->activationFunctions.size() * sizeof(NeuronActivationFunction);
+            }
+            if (auto constructor = std::get_if<ConstructorDescription>(&*cell.cellFunction)) {
+                result += constructor->genome.size();
+            }
+            if (auto injector = std::get_if<InjectorDescription>(&*cell.cellFunction)) {
+                result += injector->genome.size();
+            }
+        }
+    }
+    return result;
+}
@@ -6,5 +6,13 @@
 
 #include "DeserializedSimulation.h"
 
-using _DownloadCache = Cache<std::string, DeserializedSimulation, 5>;
+class _DownloadCache : public Cache<std::string, DeserializedSimulation>
+{
+public:
+    static uint64_t constexpr MaxBytes = 1ull << 30;
+
+    _DownloadCache();
+
+    static uint64_t estimateSize(DeserializedSimulation const& simulation);
+};
 using DownloadCache = std::shared_ptr<_DownloadCache>;
@@ -15,6 +15,8 @@ struct MissingFeatures
     bool cellColorTransitionRules = false;
     bool cellAgeLimiter = false;
     bool legacyMode = false;
+
+    bool operator==(MissingFeatures const&) const = default;
 };
 
 struct MissingParameters
@@ -22,6 +24,8 @@ struct MissingParameters
     bool externalEnergyBackflowFactor = false;
     bool copyMutations = false;
     bool cellDeathConsequences = false;
+
+    bool operator==(MissingParameters const&) const = default;
 };
 
 template <typename T>
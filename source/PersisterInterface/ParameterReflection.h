@@ -0,0 +1,1086 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "Base/Definitions.h"
+#include "EngineInterface/SimulationParameters.h"
+
+#include "AuxiliaryData.h"
+#include "LegacyAuxiliaryDataParserService.h"
+
+/**
+ * Dotted node path of an indexed zone or radiation source, get() appends a property name.
+ * The returned view is valid until the next call of get().
+ */
+class ParameterPathPrefix
+{
+public:
+    explicit ParameterPathPrefix(std::string prefix);
+
+    std::string_view get(std::string_view name);
+
+private:
+    std::string _path;
+    size_t _prefixLength;
+};
+
+/**
+ * Single description of all fields of the settings files with their node paths, used by the ptree, streaming JSON and binary codecs.
+ * A visitor provides
+ *   bool field(T& value, T const& defaultValue, std::string_view path)
+ *   bool fieldWithEnabled(T& value, bool& isActivated, T const& defaultValue, std::string_view path)
+ * which return true if the field is missing and the default value has been applied. Paths are only valid during the call.
+ * Fields sharing a path prefix are visited consecutively such that a streaming writer can emit nested JSON objects in one pass.
+ * Encoding visitors must not modify the values.
+ */
+class ParameterReflection
+{
+public:
+    template <typename Visitor>
+    static void reflectAuxiliaryData(
+        Visitor& visitor,
+        AuxiliaryData& data,
+        std::string& programVersion,
+        MissingParameters& missingParameters,
+        MissingFeatures& missingFeatures);
+
+    template <typename Visitor>
+    static void reflectSimulationParameters(
+        Visitor& visitor,
+        SimulationParameters& parameters,
+        std::string& programVersion,
+        MissingParameters& missingParameters,
+        MissingFeatures& missingFeatures);
+
+    //fields which are not stored in settings files but belong to the in-memory encodings
+    template <typename Visitor>
+    static void reflectRuntimeParameters(Visitor& visitor, SimulationParameters& parameters);
+
+private:
+    static void clampCount(int& count, int maxCount);
+};
+
+/**
+ * Adapts a leaf visitor providing bool leaf(T& value, T const& defaultValue, std::string_view path) for scalars and strings
+ * to a visitor of ParameterReflection. Color vectors and matrices are decomposed into their elements with the node paths of ParameterParser.
+ */
+template <typename LeafVisitor>
+class ParameterLeafAdapter
+{
+public:
+    explicit ParameterLeafAdapter(LeafVisitor& leafVisitor);
+
+    template <typename T>
+    bool field(T& value, T const& defaultValue, std::string_view path);
+
+    template <typename T>
+    bool fieldWithEnabled(T& value, bool& isActivated, T const& defaultValue, std::string_view path);
+
+private:
+    void appendIndex(int index);
+
+    LeafVisitor& _leafVisitor;
+    std::string _path;
+    std::string _valuePath;
+};
+
+/**
+ * Leaf visitors for the binary encoding: values are stored with their native size, strings with a 32-bit length.
+ */
+class ParameterBinaryWriter
+{
+public:
+    explicit ParameterBinaryWriter(std::vector<uint8_t>& data);
+
+    template <typename T>
+    bool leaf(T& value, T const& defaultValue, std::string_view path);
+
+private:
+    template <typename T>
+    void writeBytes(T const& value);
+    void writeString(std::string_view text);
+
+    std::vector<uint8_t>& _data;
+};
+
+class ParameterBinaryReader
+{
+public:
+    ParameterBinaryReader(std::vector<uint8_t> const& data, size_t pos);
+
+    template <typename T>
+    bool leaf(T& value, T const& defaultValue, std::string_view path);  //throws std::runtime_error at the end of the data
+
+    size_t getPos() const;
+
+private:
+    template <typename T>
+    T readBytes();
+    std::string_view readString();
+
+    [[noreturn]] static void throwCorruptedData();
+
+    std::vector<uint8_t> const& _data;
+    size_t _pos;
+};
+
+/************************************************************************/
+/* Implementation                                                       */
+/************************************************************************/
+
+inline ParameterPathPrefix::ParameterPathPrefix(std::string prefix)
+    : _path(std::move(prefix))
+    , _prefixLength(_path.size())
+{}
+
+inline std::string_view ParameterPathPrefix::get(std::string_view name)
+{
+    _path.resize(_prefixLength);
+    _path.append(name);
+    return _path;
+}
+
+template <typename Visitor>
+void ParameterReflection::reflectAuxiliaryData(
+    Visitor& visitor,
+    AuxiliaryData& data,
+    std::string& programVersion,
+    MissingParameters& missingParameters,
+    MissingFeatures& missingFeatures)
+{
+    static AuxiliaryData const defaultSettings{};
+
+    //general settings
+    visitor.field(data.timestep, uint64_t(0), "general.time step");
+    visitor.field(data.realTime, std::chrono::milliseconds(0), "general.real time");
+    visitor.field(data.zoom, 4.0f, "general.zoom");
+    visitor.field(data.center.x, 0.0f, "general.center.x");
+    visitor.field(data.center.y, 0.0f, "general.center.y");
+    visitor.field(data.generalSettings.worldSizeX, defaultSettings.generalSettings.worldSizeX, "general.world size.x");
+    visitor.field(data.generalSettings.worldSizeY, defaultSettings.generalSettings.worldSizeY, "general.world size.y");
+
+    reflectSimulationParameters(visitor, data.simulationParameters, programVersion, missingParameters, missingFeatures);
+}
+
+template <typename Visitor>
+void ParameterReflection::reflectSimulationParameters(
+    Visitor& visitor,
+    SimulationParameters& parameters,
+    std::string& programVersion,
+    MissingParameters& missingParameters,
+    MissingFeatures& missingFeatures)
+{
+    static SimulationParameters const defaultParameters;
+
+    visitor.field(programVersion, std::string(), "simulation parameters.version");
+
+    visitor.field(parameters.projectName, defaultParameters.projectName, "simulation parameters.project name");
+    visitor.field(parameters.backgroundColor, defaultParameters.backgroundColor, "simulation parameters.background color");
+    visitor.field(parameters.cellColoring, defaultParameters.cellColoring, "simulation parameters.cell colorization");
+    visitor.field(parameters.cellGlowColoring, defaultParameters.cellGlowColoring, "simulation parameters.cell glow.coloring");
+    visitor.field(parameters.cellGlowRadius, defaultParameters.cellGlowRadius, "simulation parameters.cell glow.radius");
+    visitor.field(parameters.cellGlowStrength, defaultParameters.cellGlowStrength, "simulation parameters.cell glow.strength");
+    visitor.field(
+        parameters.highlightedCellFunction, defaultParameters.highlightedCellFunction, "simulation parameters.highlighted cell function");
+    visitor.field(
+        parameters.zoomLevelNeuronalActivity, defaultParameters.zoomLevelNeuronalActivity, "simulation parameters.zoom level.neural activity");
+    visitor.field(parameters.borderlessRendering, defaultParameters.borderlessRendering, "simulation parameters.borderless rendering");
+    visitor.field(parameters.markReferenceDomain, defaultParameters.markReferenceDomain, "simulation parameters.mark reference domain");
+    visitor.field(parameters.showRadiationSources, defaultParameters.showRadiationSources, "simulation parameters.show radiation sources");
+    visitor.field(parameters.gridLines, defaultParameters.gridLines, "simulation parameters.grid lines");
+    visitor.field(parameters.attackVisualization, defaultParameters.attackVisualization, "simulation parameters.attack visualization");
+    visitor.field(
+        parameters.muscleMovementVisualization,
+        defaultParameters.muscleMovementVisualization,
+        "simulation parameters.muscle movement visualization");
+    visitor.field(parameters.cellRadius, defaultParameters.cellRadius, "simulation parameters.cek");
+
+    visitor.field(parameters.timestepSize, defaultParameters.timestepSize, "simulation parameters.time step size");
+
+    visitor.field(parameters.motionType, defaultParameters.motionType, "simulation parameters.motion.type");
+    if (parameters.motionType == MotionType_Fluid) {
+        visitor.field(
+            parameters.motionData.fluidMotion.smoothingLength,
+            defaultParameters.motionData.fluidMotion.smoothingLength,
+            "simulation parameters.fluid.smoothing length");
+        visitor.field(
+            parameters.motionData.fluidMotion.pressureStrength,
+            defaultParameters.motionData.fluidMotion.pressureStrength,
+            "simulation parameters.fluid.pressure strength");
+        visitor.field(
+            parameters.motionData.fluidMotion.viscosityStrength,
+            defaultParameters.motionData.fluidMotion.viscosityStrength,
+            "simulation parameters.fluid.viscosity strength");
+    } else {
+        visitor.field(
+            parameters.motionData.collisionMotion.cellMaxCollisionDistance,
+            defaultParameters.motionData.collisionMotion.cellMaxCollisionDistance,
+            "simulation parameters.motion.collision.max distance");
+        visitor.field(
+            parameters.motionData.collisionMotion.cellRepulsionStrength,
+            defaultParameters.motionData.collisionMotion.cellRepulsionStrength,
+            "simulation parameters.motion.collision.repulsion strength");
+    }
+
+    visitor.field(parameters.baseValues.friction, defaultParameters.baseValues.friction, "simulation parameters.friction");
+    visitor.field(parameters.baseValues.rigidity, defaultParameters.baseValues.rigidity, "simulation parameters.rigidity");
+    visitor.field(parameters.cellMaxVelocity, defaultParameters.cellMaxVelocity, "simulation parameters.cell.max velocity");
+    visitor.field(parameters.cellMaxBindingDistance, defaultParameters.cellMaxBindingDistance, "simulation parameters.cell.max binding distance");
+    visitor.field(parameters.cellNormalEnergy, defaultParameters.cellNormalEnergy, "simulation parameters.cell.normal energy");
+
+    visitor.field(parameters.cellMinDistance, defaultParameters.cellMinDistance, "simulation parameters.cell.min distance");
+    visitor.field(parameters.baseValues.cellMaxForce, defaultParameters.baseValues.cellMaxForce, "simulation parameters.cell.max force");
+    visitor.field(
+        parameters.cellMaxForceDecayProb, defaultParameters.cellMaxForceDecayProb, "simulation parameters.cell.max force decay probability");
+    visitor.field(
+        parameters.cellNumExecutionOrderNumbers,
+        defaultParameters.cellNumExecutionOrderNumbers,
+        "simulation parameters.cell.max execution order number");
+    visitor.field(parameters.baseValues.cellMinEnergy, defaultParameters.baseValues.cellMinEnergy, "simulation parameters.cell.min energy");
+    visitor.field(
+        parameters.baseValues.cellFusionVelocity, defaultParameters.baseValues.cellFusionVelocity, "simulation parameters.cell.fusion velocity");
+    visitor.field(
+        parameters.baseValues.cellMaxBindingEnergy, parameters.baseValues.cellMaxBindingEnergy, "simulation parameters.cell.max binding energy");
+    visitor.field(parameters.cellMaxAge, defaultParameters.cellMaxAge, "simulation parameters.cell.max age");
+    visitor.field(parameters.cellMaxAgeBalancer, defaultParameters.cellMaxAgeBalancer, "simulation parameters.cell.max age.balance.enabled");
+    visitor.field(
+        parameters.cellMaxAgeBalancerInterval,
+        defaultParameters.cellMaxAgeBalancerInterval,
+        "simulation parameters.cell.max age.balance.interval");
+    visitor.field(
+        parameters.cellInactiveMaxAgeActivated,
+        defaultParameters.cellInactiveMaxAgeActivated,
+        "simulation parameters.cell.inactive max age activated");
+    visitor.field(
+        parameters.baseValues.cellInactiveMaxAge, defaultParameters.baseValues.cellInactiveMaxAge, "simulation parameters.cell.inactive max age");
+    visitor.field(
+        parameters.cellEmergentMaxAgeActivated,
+        defaultParameters.cellEmergentMaxAgeActivated,
+        "simulation parameters.cell.nutrient max age activated");
+    visitor.field(parameters.cellEmergentMaxAge, defaultParameters.cellEmergentMaxAge, "simulation parameters.cell.nutrient max age");
+    visitor.field(
+        parameters.cellResetAgeAfterActivation,
+        defaultParameters.cellResetAgeAfterActivation,
+        "simulation parameters.cell.reset age after activation");
+    visitor.field(
+        parameters.baseValues.cellColorTransitionDuration,
+        defaultParameters.baseValues.cellColorTransitionDuration,
+        "simulation parameters.cell.color transition rules.duration");
+    visitor.field(
+        parameters.baseValues.cellColorTransitionTargetColor,
+        defaultParameters.baseValues.cellColorTransitionTargetColor,
+        "simulation parameters.cell.color transition rules.target color");
+
+    visitor.field(parameters.externalEnergy, defaultParameters.externalEnergy, "simulation parameters.cell.function.constructor.external energy");
+    visitor.field(
+        parameters.externalEnergyInflowFactor,
+        defaultParameters.externalEnergyInflowFactor,
+        "simulation parameters.cell.function.constructor.external energy supply rate");
+    visitor.field(
+        parameters.externalEnergyConditionalInflowFactor,
+        defaultParameters.externalEnergyConditionalInflowFactor,
+        "simulation parameters.cell.function.constructor.pump energy factor");
+    missingParameters.externalEnergyBackflowFactor = visitor.field(
+        parameters.externalEnergyBackflowFactor,
+        defaultParameters.externalEnergyBackflowFactor,
+        "simulation parameters.cell.function.constructor.external energy backflow");
+    visitor.field(
+        parameters.externalEnergyInflowOnlyForNonSelfReplicators,
+        defaultParameters.externalEnergyInflowOnlyForNonSelfReplicators,
+        "simulation parameters.cell.function.constructor.external energy inflow only for non-self-replicators");
+    visitor.field(
+        parameters.externalEnergyBackflowLimit,
+        defaultParameters.externalEnergyBackflowLimit,
+        "simulation parameters.cell.function.constructor.external energy backflow limit");
+
+    visitor.field(
+        parameters.cellFunctionConstructorConnectingCellMaxDistance,
+        defaultParameters.cellFunctionConstructorConnectingCellMaxDistance,
+        "simulation parameters.cell.function.constructor.connecting cell max distance");
+    visitor.field(
+        parameters.cellFunctionConstructorSignalThreshold,
+        defaultParameters.cellFunctionConstructorSignalThreshold,
+        "simulation parameters.cell.function.constructor.activity threshold");
+    visitor.field(
+        parameters.cellFunctionConstructorCheckCompletenessForSelfReplication,
+        defaultParameters.cellFunctionConstructorCheckCompletenessForSelfReplication,
+        "simulation parameters.cell.function.constructor.completeness check for self-replication");
+
+    visitor.field(
+        parameters.cellFunctionInjectorRadius,
+        defaultParameters.cellFunctionInjectorRadius,
+        "simulation parameters.cell.function.injector.radius");
+    visitor.field(
+        parameters.cellFunctionInjectorDurationColorMatrix,
+        defaultParameters.cellFunctionInjectorDurationColorMatrix,
+        "simulation parameters.cell.function.injector.duration");
+
+    visitor.field(
+        parameters.cellFunctionAttackerRadius,
+        defaultParameters.cellFunctionAttackerRadius,
+        "simulation parameters.cell.function.attacker.radius");
+    visitor.field(
+        parameters.cellFunctionAttackerStrength,
+        defaultParameters.cellFunctionAttackerStrength,
+        "simulation parameters.cell.function.attacker.strength");
+    visitor.field(
+        parameters.cellFunctionAttackerEnergyDistributionRadius,
+        defaultParameters.cellFunctionAttackerEnergyDistributionRadius,
+        "simulation parameters.cell.function.attacker.energy distribution radius");
+    visitor.field(
+        parameters.cellFunctionAttackerEnergyDistributionValue,
+        defaultParameters.cellFunctionAttackerEnergyDistributionValue,
+        "simulation parameters.cell.function.attacker.energy distribution value");
+    visitor.field(
+        parameters.cellFunctionAttackerColorInhomogeneityFactor,
+        defaultParameters.cellFunctionAttackerColorInhomogeneityFactor,
+        "simulation parameters.cell.function.attacker.color inhomogeneity factor");
+    visitor.field(
+        parameters.cellFunctionAttackerSignalThreshold,
+        defaultParameters.cellFunctionAttackerSignalThreshold,
+        "simulation parameters.cell.function.attacker.activity threshold");
+    visitor.field(
+        parameters.baseValues.cellFunctionAttackerEnergyCost,
+        defaultParameters.baseValues.cellFunctionAttackerEnergyCost,
+        "simulation parameters.cell.function.attacker.energy cost");
+    visitor.field(
+        parameters.baseValues.cellFunctionAttackerGeometryDeviationExponent,
+        defaultParameters.baseValues.cellFunctionAttackerGeometryDeviationExponent,
+        "simulation parameters.cell.function.attacker.geometry deviation exponent");
+    visitor.field(
+        parameters.baseValues.cellFunctionAttackerFoodChainColorMatrix,
+        defaultParameters.baseValues.cellFunctionAttackerFoodChainColorMatrix,
+        "simulation parameters.cell.function.attacker.food chain color matrix");
+    visitor.field(
+        parameters.baseValues.cellFunctionAttackerConnectionsMismatchPenalty,
+        defaultParameters.baseValues.cellFunctionAttackerConnectionsMismatchPenalty,
+        "simulation parameters.cell.function.attacker.connections mismatch penalty");
+    visitor.field(
+        parameters.baseValues.cellFunctionAttackerGenomeComplexityBonus,
+        defaultParameters.baseValues.cellFunctionAttackerGenomeComplexityBonus,
+        "simulation parameters.cell.function.attacker.genome size bonus");
+    visitor.field(
+        parameters.cellFunctionAttackerSameMutantPenalty,
+        defaultParameters.cellFunctionAttackerSameMutantPenalty,
+        "simulation parameters.cell.function.attacker.same mutant penalty");
+    visitor.field(
+        parameters.baseValues.cellFunctionAttackerNewComplexMutantPenalty,
+        defaultParameters.baseValues.cellFunctionAttackerNewComplexMutantPenalty,
+        "simulation parameters.cell.function.attacker.new complex mutant penalty");
+    visitor.field(
+        parameters.cellFunctionAttackerSensorDetectionFactor,
+        defaultParameters.cellFunctionAttackerSensorDetectionFactor,
+        "simulation parameters.cell.function.attacker.sensor detection factor");
+    visitor.field(
+        parameters.cellFunctionAttackerDestroyCells,
+        defaultParameters.cellFunctionAttackerDestroyCells,
+        "simulation parameters.cell.function.attacker.destroy cells");
+
+    visitor.field(
+        parameters.cellFunctionDefenderAgainstAttackerStrength,
+        defaultParameters.cellFunctionDefenderAgainstAttackerStrength,
+        "simulation parameters.cell.function.defender.against attacker strength");
+    visitor.field(
+        parameters.cellFunctionDefenderAgainstInjectorStrength,
+        defaultParameters.cellFunctionDefenderAgainstInjectorStrength,
+        "simulation parameters.cell.function.defender.against injector strength");
+
+    visitor.field(
+        parameters.cellFunctionTransmitterEnergyDistributionSameCreature,
+        defaultParameters.cellFunctionTransmitterEnergyDistributionSameCreature,
+        "simulation parameters.cell.function.transmitter.energy distribution same creature");
+    visitor.field(
+        parameters.cellFunctionTransmitterEnergyDistributionRadius,
+        defaultParameters.cellFunctionTransmitterEnergyDistributionRadius,
+        "simulation parameters.cell.function.transmitter.energy distribution radius");
+    visitor.field(
+        parameters.cellFunctionTransmitterEnergyDistributionValue,
+        defaultParameters.cellFunctionTransmitterEnergyDistributionValue,
+        "simulation parameters.cell.function.transmitter.energy distribution value");
+
+    visitor.field(
+        parameters.cellFunctionMuscleContractionExpansionDelta,
+        defaultParameters.cellFunctionMuscleContractionExpansionDelta,
+        "simulation parameters.cell.function.muscle.contraction expansion delta");
+    visitor.field(
+        parameters.cellFunctionMuscleMovementAcceleration,
+        defaultParameters.cellFunctionMuscleMovementAcceleration,
+        "simulation parameters.cell.function.muscle.movement acceleration");
+    visitor.field(
+        parameters.cellFunctionMuscleBendingAngle,
+        defaultParameters.cellFunctionMuscleBendingAngle,
+        "simulation parameters.cell.function.muscle.bending angle");
+    visitor.field(
+        parameters.cellFunctionMuscleBendingAcceleration,
+        defaultParameters.cellFunctionMuscleBendingAcceleration,
+        "simulation parameters.cell.function.muscle.bending acceleration");
+    visitor.field(
+        parameters.cellFunctionMuscleBendingAccelerationThreshold,
+        defaultParameters.cellFunctionMuscleBendingAccelerationThreshold,
+        "simulation parameters.cell.function.muscle.bending acceleration threshold");
+    visitor.field(
+        parameters.cellFunctionMuscleMovementTowardTargetedObject,
+        defaultParameters.cellFunctionMuscleMovementTowardTargetedObject,
+        "simulation parameters.cell.function.muscle.movement toward targeted object");
+
+    visitor.field(
+        parameters.cellFunctionSensorRange, defaultParameters.cellFunctionSensorRange, "simulation parameters.cell.function.sensor.range");
+    visitor.field(
+        parameters.cellFunctionSensorSignalThreshold,
+        defaultParameters.cellFunctionSensorSignalThreshold,
+        "simulation parameters.cell.function.sensor.activity threshold");
+
+    visitor.field(
+        parameters.cellFunctionReconnectorRadius,
+        defaultParameters.cellFunctionReconnectorRadius,
+        "simulation parameters.cell.function.reconnector.radius");
+    visitor.field(
+        parameters.cellFunctionReconnectorSignalThreshold,
+        defaultParameters.cellFunctionReconnectorSignalThreshold,
+        "simulation parameters.cell.function.reconnector.activity threshold");
+
+    visitor.field(
+        parameters.cellFunctionDetonatorRadius,
+        defaultParameters.cellFunctionDetonatorRadius,
+        "simulation parameters.cell.function.detonator.radius");
+    visitor.field(
+        parameters.cellFunctionDetonatorChainExplosionProbability,
+        defaultParameters.cellFunctionDetonatorChainExplosionProbability,
+        "simulation parameters.cell.function.detonator.chain explosion probability");
+    visitor.field(
+        parameters.cellFunctionDetonatorSignalThreshold,
+        defaultParameters.cellFunctionDetonatorSignalThreshold,
+        "simulation parameters.cell.function.detonator.activity threshold");
+
+    missingParameters.cellDeathConsequences = visitor.field(
+        parameters.cellDeathConsequences, defaultParameters.cellDeathConsequences, "simulation parameters.cell.death consequences");
+    visitor.field(
+        parameters.baseValues.cellDeathProbability,
+        defaultParameters.baseValues.cellDeathProbability,
+        "simulation parameters.cell.death probability");
+
+    missingParameters.copyMutations = visitor.field(
+        parameters.baseValues.cellCopyMutationNeuronData,
+        defaultParameters.baseValues.cellCopyMutationNeuronData,
+        "simulation parameters.cell.copy mutation.neuron data");
+    visitor.field(
+        parameters.cellCopyMutationNeuronDataWeight,
+        defaultParameters.cellCopyMutationNeuronDataWeight,
+        "simulation parameters.cell.copy mutation.neuron data.weights");
+    visitor.field(
+        parameters.cellCopyMutationNeuronDataBias,
+        defaultParameters.cellCopyMutationNeuronDataBias,
+        "simulation parameters.cell.copy mutation.neuron data.biases");
+    visitor.field(
+        parameters.cellCopyMutationNeuronDataActivationFunction,
+        defaultParameters.cellCopyMutationNeuronDataActivationFunction,
+        "simulation parameters.cell.copy mutation.neuron data.activation functions");
+    visitor.field(
+        parameters.cellCopyMutationNeuronDataReinforcement,
+        defaultParameters.cellCopyMutationNeuronDataReinforcement,
+        "simulation parameters.cell.copy mutation.neuron data.reinforcement");
+    visitor.field(
+        parameters.cellCopyMutationNeuronDataDamping,
+        defaultParameters.cellCopyMutationNeuronDataDamping,
+        "simulation parameters.cell.copy mutation.neuron data.damping");
+    visitor.field(
+        parameters.cellCopyMutationNeuronDataOffset,
+        defaultParameters.cellCopyMutationNeuronDataOffset,
+        "simulation parameters.cell.copy mutation.neuron data.offset");
+    visitor.field(
+        parameters.baseValues.cellCopyMutationCellProperties,
+        defaultParameters.baseValues.cellCopyMutationCellProperties,
+        "simulation parameters.cell.copy mutation.cell properties");
+    visitor.field(
+        parameters.baseValues.cellCopyMutationGeometry,
+        defaultParameters.baseValues.cellCopyMutationGeometry,
+        "simulation parameters.cell.copy mutation.geometry");
+    visitor.field(
+        parameters.baseValues.cellCopyMutationCustomGeometry,
+        defaultParameters.baseValues.cellCopyMutationCustomGeometry,
+        "simulation parameters.cell.copy mutation.custom geometry");
+    visitor.field(
+        parameters.baseValues.cellCopyMutationCellFunction,
+        defaultParameters.baseValues.cellCopyMutationCellFunction,
+        "simulation parameters.cell.copy mutation.cell function");
+    visitor.field(
+        parameters.baseValues.cellCopyMutationInsertion,
+        defaultParameters.baseValues.cellCopyMutationInsertion,
+        "simulation parameters.cell.copy mutation.insertion");
+    visitor.field(
+        parameters.baseValues.cellCopyMutationDeletion,
+        defaultParameters.baseValues.cellCopyMutationDeletion,
+        "simulation parameters.cell.copy mutation.deletion");
+    visitor.field(
+        parameters.cellCopyMutationDeletionMinSize,
+        defaultParameters.cellCopyMutationDeletionMinSize,
+        "simulation parameters.cell.copy mutation.deletion.min size");
+    visitor.field(
+        parameters.baseValues.cellCopyMutationTranslation,
+        defaultParameters.baseValues.cellCopyMutationTranslation,
+        "simulation parameters.cell.copy mutation.translation");
+    visitor.field(
+        parameters.baseValues.cellCopyMutationDuplication,
+        defaultParameters.baseValues.cellCopyMutationDuplication,
+        "simulation parameters.cell.copy mutation.duplication");
+    visitor.field(
+        parameters.baseValues.cellCopyMutationCellColor,
+        defaultParameters.baseValues.cellCopyMutationCellColor,
+        "simulation parameters.cell.copy mutation.cell color");
+    visitor.field(
+        parameters.baseValues.cellCopyMutationSubgenomeColor,
+        defaultParameters.baseValues.cellCopyMutationSubgenomeColor,
+        "simulation parameters.cell.copy mutation.subgenome color");
+    visitor.field(
+        parameters.baseValues.cellCopyMutationGenomeColor,
+        defaultParameters.baseValues.cellCopyMutationGenomeColor,
+        "simulation parameters.cell.copy mutation.genome color");
+    visitor.field(
+        parameters.cellCopyMutationColorTransitions,
+        defaultParameters.cellCopyMutationColorTransitions,
+        "simulation parameters.cell.copy mutation.color transition");
+    visitor.field(
+        parameters.cellCopyMutationSelfReplication,
+        defaultParameters.cellCopyMutationSelfReplication,
+        "simulation parameters.cell.copy mutation.self replication flag");
+    visitor.field(
+        parameters.cellCopyMutationPreventDepthIncrease,
+        defaultParameters.cellCopyMutationPreventDepthIncrease,
+        "simulation parameters.cell.copy mutation.prevent depth increase");
+    visitor.field(
+        parameters.genomeComplexityRamificationFactor,
+        defaultParameters.genomeComplexityRamificationFactor,
+        "simulation parameters.genome complexity.genome complexity ramification factor");
+    visitor.field(
+        parameters.genomeComplexitySizeFactor,
+        defaultParameters.genomeComplexitySizeFactor,
+        "simulation parameters.genome complexity.genome complexity size factor");
+    visitor.field(
+        parameters.genomeComplexityNeuronFactor,
+        defaultParameters.genomeComplexityNeuronFactor,
+        "simulation parameters.genome complexity.genome complexity neuron factor");
+    visitor.field(
+        parameters.genomeComplexityDepthLevel,
+        defaultParameters.genomeComplexityDepthLevel,
+        "simulation parameters.genome complexity.genome complexity depth level");
+    visitor.field(
+        parameters.baseValues.radiationCellAgeStrength,
+        defaultParameters.baseValues.radiationCellAgeStrength,
+        "simulation parameters.radiation.factor");
+    visitor.field(parameters.radiationProb, defaultParameters.radiationProb, "simulation parameters.radiation.probability");
+    visitor.field(
+        parameters.radiationVelocityMultiplier,
+        defaultParameters.radiationVelocityMultiplier,
+        "simulation parameters.radiation.velocity multiplier");
+    visitor.field(
+        parameters.radiationVelocityPerturbation,
+        defaultParameters.radiationVelocityPerturbation,
+        "simulation parameters.radiation.velocity perturbation");
+    visitor.field(
+        parameters.baseValues.radiationDisableSources,
+        defaultParameters.baseValues.radiationDisableSources,
+        "simulation parameters.radiation.disable sources");
+    visitor.field(
+        parameters.baseValues.radiationAbsorption,
+        defaultParameters.baseValues.radiationAbsorption,
+        "simulation parameters.radiation.absorption");
+    visitor.field(
+        parameters.radiationAbsorptionHighVelocityPenalty,
+        defaultParameters.radiationAbsorptionHighVelocityPenalty,
+        "simulation parameters.radiation.absorption velocity penalty");
+    visitor.field(
+        parameters.baseValues.radiationAbsorptionLowVelocityPenalty,
+        defaultParameters.baseValues.radiationAbsorptionLowVelocityPenalty,
+        "simulation parameters.radiation.absorption low velocity penalty");
+    visitor.field(
+        parameters.radiationAbsorptionLowConnectionPenalty,
+        defaultParameters.radiationAbsorptionLowConnectionPenalty,
+        "simulation parameters.radiation.absorption low connection penalty");
+    visitor.field(
+        parameters.baseValues.radiationAbsorptionLowGenomeComplexityPenalty,
+        defaultParameters.baseValues.radiationAbsorptionLowGenomeComplexityPenalty,
+        "simulation parameters.radiation.absorption low genome complexity penalty");
+    visitor.field(parameters.radiationMinCellAge, defaultParameters.radiationMinCellAge, "simulation parameters.radiation.min cell age");
+    visitor.field(
+        parameters.highRadiationMinCellEnergy,
+        defaultParameters.highRadiationMinCellEnergy,
+        "simulation parameters.high radiation.min cell energy");
+    visitor.field(parameters.highRadiationFactor, defaultParameters.highRadiationFactor, "simulation parameters.high radiation.factor");
+
+    visitor.field(
+        parameters.particleTransformationAllowed,
+        defaultParameters.particleTransformationAllowed,
+        "simulation parameters.particle.transformation allowed");
+    visitor.field(
+        parameters.particleTransformationRandomCellFunction,
+        defaultParameters.particleTransformationRandomCellFunction,
+        "simulation parameters.particle.transformation.random cell function");
+    visitor.field(
+        parameters.particleTransformationMaxGenomeSize,
+        defaultParameters.particleTransformationMaxGenomeSize,
+        "simulation parameters.particle.transformation.max genome size");
+    visitor.field(parameters.particleSplitEnergy, defaultParameters.particleSplitEnergy, "simulation parameters.particle.split energy");
+
+    visitor.field(
+        parameters.legacyCellFunctionMuscleMovementAngleFromSensor,
+        defaultParameters.legacyCellFunctionMuscleMovementAngleFromSensor,
+        "simulation parameters.legacy.cell.function.muscle.movement angle from sensor");
+
+    //particle sources
+    visitor.field(parameters.numRadiationSources, defaultParameters.numRadiationSources, "simulation parameters.particle sources.num sources");
+    clampCount(parameters.numRadiationSources, MAX_RADIATION_SOURCES);
+    visitor.field(
+        parameters.baseStrengthRatioPinned,
+        defaultParameters.baseStrengthRatioPinned,
+        "simulation parameters.particle sources.base strength pinned");
+    for (int index = 0; index < parameters.numRadiationSources; ++index) {
+        ParameterPathPrefix base("simulation parameters.particle sources." + std::to_string(index) + ".");
+        auto& source = parameters.radiationSource[index];
+        auto& defaultSource = defaultParameters.radiationSource[index];
+        visitor.field(source.name, defaultSource.name, base.get("name"));
+        visitor.field(source.locationIndex, defaultSource.locationIndex, base.get("location index"));
+        visitor.field(source.posX, defaultSource.posX, base.get("pos.x"));
+        visitor.field(source.posY, defaultSource.posY, base.get("pos.y"));
+        visitor.field(source.velX, defaultSource.velX, base.get("vel.x"));
+        visitor.field(source.velY, defaultSource.velY, base.get("vel.y"));
+        visitor.field(source.useAngle, defaultSource.useAngle, base.get("use angle"));
+        visitor.field(source.strength, defaultSource.strength, base.get("strength"));
+        visitor.field(source.strengthPinned, defaultSource.strengthPinned, base.get("strength pinned"));
+        visitor.field(source.angle, defaultSource.angle, base.get("angle"));
+        visitor.field(source.shapeType, defaultSource.shapeType, base.get("shape.type"));
+        if (source.shapeType == SpotShapeType_Circular) {
+            visitor.field(
+                source.shapeData.circularRadiationSource.radius,
+                defaultSource.shapeData.circularRadiationSource.radius,
+                base.get("shape.circular.radius"));
+        }
+        if (source.shapeType == SpotShapeType_Rectangular) {
+            visitor.field(
+                source.shapeData.rectangularRadiationSource.width,
+                defaultSource.shapeData.rectangularRadiationSource.width,
+                base.get("shape.rectangular.width"));
+            visitor.field(
+                source.shapeData.rectangularRadiationSource.height,
+                defaultSource.shapeData.rectangularRadiationSource.height,
+                base.get("shape.rectangular.height"));
+        }
+    }
+
+    //spots
+    visitor.field(parameters.numZones, defaultParameters.numZones, "simulation parameters.spots.num spots");
+    clampCount(parameters.numZones, MAX_ZONES);
+    for (int index = 0; index < parameters.numZones; ++index) {
+        ParameterPathPrefix base("simulation parameters.spots." + std::to_string(index) + ".");
+        auto& spot = parameters.zone[index];
+        auto& defaultSpot = defaultParameters.zone[index];
+        visitor.field(spot.name, defaultSpot.name, base.get("name"));
+        visitor.field(spot.locationIndex, defaultSpot.locationIndex, base.get("location index"));
+        visitor.field(spot.color, defaultSpot.color, base.get("color"));
+        visitor.field(spot.posX, defaultSpot.posX, base.get("pos.x"));
+        visitor.field(spot.posY, defaultSpot.posY, base.get("pos.y"));
+        visitor.field(spot.velX, defaultSpot.velX, base.get("vel.x"));
+        visitor.field(spot.velY, defaultSpot.velY, base.get("vel.y"));
+
+        visitor.field(spot.shapeType, defaultSpot.shapeType, base.get("shape.type"));
+        if (spot.shapeType == SpotShapeType_Circular) {
+            visitor.field(
+                spot.shapeData.circularSpot.coreRadius, defaultSpot.shapeData.circularSpot.coreRadius, base.get("shape.circular.core radius"));
+        }
+        if (spot.shapeType == SpotShapeType_Rectangular) {
+            visitor.field(
+                spot.shapeData.rectangularSpot.width, defaultSpot.shapeData.rectangularSpot.width, base.get("shape.rectangular.core width"));
+            visitor.field(
+                spot.shapeData.rectangularSpot.height, defaultSpot.shapeData.rectangularSpot.height, base.get("shape.rectangular.core height"));
+        }
+        visitor.field(spot.flowType, defaultSpot.flowType, base.get("flow.type"));
+        if (spot.flowType == FlowType_Radial) {
+            visitor.field(spot.flowData.radialFlow.orientation, defaultSpot.flowData.radialFlow.orientation, base.get("flow.radial.orientation"));
+            visitor.field(spot.flowData.radialFlow.strength, defaultSpot.flowData.radialFlow.strength, base.get("flow.radial.strength"));
+            visitor.field(spot.flowData.radialFlow.driftAngle, defaultSpot.flowData.radialFlow.driftAngle, base.get("flow.radial.drift angle"));
+        }
+        if (spot.flowType == FlowType_Central) {
+            visitor.field(spot.flowData.centralFlow.strength, defaultSpot.flowData.centralFlow.strength, base.get("flow.central.strength"));
+        }
+        if (spot.flowType == FlowType_Linear) {
+            visitor.field(spot.flowData.linearFlow.angle, defaultSpot.flowData.linearFlow.angle, base.get("flow.linear.angle"));
+            visitor.field(spot.flowData.linearFlow.strength, defaultSpot.flowData.linearFlow.strength, base.get("flow.linear.strength"));
+        }
+        visitor.field(spot.fadeoutRadius, defaultSpot.fadeoutRadius, base.get("fadeout radius"));
+
+        visitor.fieldWithEnabled(spot.values.friction, spot.activatedValues.friction, defaultSpot.values.friction, base.get("friction"));
+        visitor.fieldWithEnabled(spot.values.rigidity, spot.activatedValues.rigidity, defaultSpot.values.rigidity, base.get("rigidity"));
+        visitor.fieldWithEnabled(
+            spot.values.radiationDisableSources,
+            spot.activatedValues.radiationDisableSources,
+            defaultSpot.values.radiationDisableSources,
+            base.get("radiation.disable sources"));
+        visitor.fieldWithEnabled(
+            spot.values.radiationAbsorption,
+            spot.activatedValues.radiationAbsorption,
+            defaultSpot.values.radiationAbsorption,
+            base.get("radiation.absorption"));
+        visitor.fieldWithEnabled(
+            spot.values.radiationAbsorptionLowVelocityPenalty,
+            spot.activatedValues.radiationAbsorptionLowVelocityPenalty,
+            defaultSpot.values.radiationAbsorptionLowVelocityPenalty,
+            base.get("radiation.absorption low velocity penalty"));
+        visitor.fieldWithEnabled(
+            spot.values.radiationAbsorptionLowGenomeComplexityPenalty,
+            spot.activatedValues.radiationAbsorptionLowGenomeComplexityPenalty,
+            defaultSpot.values.radiationAbsorptionLowGenomeComplexityPenalty,
+            base.get("radiation.absorption low genome complexity penalty"));
+        visitor.fieldWithEnabled(
+            spot.values.radiationCellAgeStrength,
+            spot.activatedValues.radiationCellAgeStrength,
+            defaultSpot.values.radiationCellAgeStrength,
+            base.get("radiation.factor"));
+        visitor.fieldWithEnabled(
+            spot.values.cellMaxForce, spot.activatedValues.cellMaxForce, defaultSpot.values.cellMaxForce, base.get("cell.max force"));
+        visitor.fieldWithEnabled(
+            spot.values.cellMinEnergy, spot.activatedValues.cellMinEnergy, defaultSpot.values.cellMinEnergy, base.get("cell.min energy"));
+        visitor.fieldWithEnabled(
+            spot.values.cellDeathProbability,
+            spot.activatedValues.cellDeathProbability,
+            defaultSpot.values.cellDeathProbability,
+            base.get("cell.death probability"));
+
+        visitor.fieldWithEnabled(
+            spot.values.cellFusionVelocity,
+            spot.activatedValues.cellFusionVelocity,
+            defaultSpot.values.cellFusionVelocity,
+            base.get("cell.fusion velocity"));
+        visitor.fieldWithEnabled(
+            spot.values.cellMaxBindingEnergy,
+            spot.activatedValues.cellMaxBindingEnergy,
+            defaultSpot.values.cellMaxBindingEnergy,
+            base.get("cell.max binding energy"));
+        visitor.fieldWithEnabled(
+            spot.values.cellInactiveMaxAge,
+            spot.activatedValues.cellInactiveMaxAge,
+            defaultSpot.values.cellInactiveMaxAge,
+            base.get("cell.inactive max age"));
+
+        visitor.field(spot.activatedValues.cellColorTransition, false, base.get("cell.color transition rules.activated"));
+        visitor.field(
+            spot.values.cellColorTransitionDuration,
+            defaultSpot.values.cellColorTransitionDuration,
+            base.get("cell.color transition rules.duration"));
+        visitor.field(
+            spot.values.cellColorTransitionTargetColor,
+            defaultSpot.values.cellColorTransitionTargetColor,
+            base.get("cell.color transition rules.target color"));
+
+        visitor.fieldWithEnabled(
+            spot.values.cellFunctionAttackerEnergyCost,
+            spot.activatedValues.cellFunctionAttackerEnergyCost,
+            defaultSpot.values.cellFunctionAttackerEnergyCost,
+            base.get("cell.function.attacker.energy cost"));
+
+        visitor.fieldWithEnabled(
+            spot.values.cellFunctionAttackerFoodChainColorMatrix,
+            spot.activatedValues.cellFunctionAttackerFoodChainColorMatrix,
+            defaultSpot.values.cellFunctionAttackerFoodChainColorMatrix,
+            base.get("cell.function.attacker.food chain color matrix"));
+        visitor.fieldWithEnabled(
+            spot.values.cellFunctionAttackerGenomeComplexityBonus,
+            spot.activatedValues.cellFunctionAttackerGenomeComplexityBonus,
+            defaultSpot.values.cellFunctionAttackerGenomeComplexityBonus,
+            base.get("cell.function.attacker.genome size bonus"));
+        visitor.fieldWithEnabled(
+            spot.values.cellFunctionAttackerNewComplexMutantPenalty,
+            spot.activatedValues.cellFunctionAttackerNewComplexMutantPenalty,
+            defaultSpot.values.cellFunctionAttackerNewComplexMutantPenalty,
+            base.get("cell.function.attacker.new complex mutant penalty"));
+        visitor.fieldWithEnabled(
+            spot.values.cellFunctionAttackerGeometryDeviationExponent,
+            spot.activatedValues.cellFunctionAttackerGeometryDeviationExponent,
+            defaultSpot.values.cellFunctionAttackerGeometryDeviationExponent,
+            base.get("cell.function.attacker.geometry deviation exponent"));
+        visitor.fieldWithEnabled(
+            spot.values.cellFunctionAttackerConnectionsMismatchPenalty,
+            spot.activatedValues.cellFunctionAttackerConnectionsMismatchPenalty,
+            defaultSpot.values.cellFunctionAttackerConnectionsMismatchPenalty,
+            base.get("cell.function.attacker.connections mismatch penalty"));
+
+        visitor.fieldWithEnabled(
+            spot.values.cellCopyMutationNeuronData,
+            spot.activatedValues.cellCopyMutationNeuronData,
+            defaultSpot.values.cellCopyMutationNeuronData,
+            base.get("cell.copy mutation.neuron data"));
+        visitor.fieldWithEnabled(
+            spot.values.cellCopyMutationCellProperties,
+            spot.activatedValues.cellCopyMutationCellProperties,
+            defaultSpot.values.cellCopyMutationCellProperties,
+            base.get("cell.copy mutation.cell properties"));
+        visitor.fieldWithEnabled(
+            spot.values.cellCopyMutationGeometry,
+            spot.activatedValues.cellCopyMutationGeometry,
+            defaultSpot.values.cellCopyMutationGeometry,
+            base.get("cell.copy mutation.geometry"));
+        visitor.fieldWithEnabled(
+            spot.values.cellCopyMutationCustomGeometry,
+            spot.activatedValues.cellCopyMutationCustomGeometry,
+            defaultSpot.values.cellCopyMutationCustomGeometry,
+            base.get("cell.copy mutation.custom geometry"));
+        visitor.fieldWithEnabled(
+            spot.values.cellCopyMutationCellFunction,
+            spot.activatedValues.cellCopyMutationCellFunction,
+            defaultSpot.values.cellCopyMutationCellFunction,
+            base.get("cell.copy mutation.cell function"));
+        visitor.fieldWithEnabled(
+            spot.values.cellCopyMutationInsertion,
+            spot.activatedValues.cellCopyMutationInsertion,
+            defaultSpot.values.cellCopyMutationInsertion,
+            base.get("cell.copy mutation.insertion"));
+        visitor.fieldWithEnabled(
+            spot.values.cellCopyMutationDeletion,
+            spot.activatedValues.cellCopyMutationDeletion,
+            defaultSpot.values.cellCopyMutationDeletion,
+            base.get("cell.copy mutation.deletion"));
+        visitor.fieldWithEnabled(
+            spot.values.cellCopyMutationTranslation,
+            spot.activatedValues.cellCopyMutationTranslation,
+            defaultSpot.values.cellCopyMutationTranslation,
+            base.get("cell.copy mutation.translation"));
+        visitor.fieldWithEnabled(
+            spot.values.cellCopyMutationDuplication,
+            spot.activatedValues.cellCopyMutationDuplication,
+            defaultSpot.values.cellCopyMutationDuplication,
+            base.get("cell.copy mutation.duplication"));
+        visitor.fieldWithEnabled(
+            spot.values.cellCopyMutationCellColor,
+            spot.activatedValues.cellCopyMutationCellColor,
+            defaultSpot.values.cellCopyMutationCellColor,
+            base.get("cell.copy mutation.cell color"));
+        visitor.fieldWithEnabled(
+            spot.values.cellCopyMutationSubgenomeColor,
+            spot.activatedValues.cellCopyMutationSubgenomeColor,
+            defaultSpot.values.cellCopyMutationSubgenomeColor,
+            base.get("cell.copy mutation.subgenome color"));
+        visitor.fieldWithEnabled(
+            spot.values.cellCopyMutationGenomeColor,
+            spot.activatedValues.cellCopyMutationGenomeColor,
+            defaultSpot.values.cellCopyMutationGenomeColor,
+            base.get("cell.copy mutation.genome color"));
+    }
+
+    //features
+    visitor.field(
+        parameters.features.genomeComplexityMeasurement,
+        defaultParameters.features.genomeComplexityMeasurement,
+        "simulation parameters.features.genome complexity measurement");
+    missingFeatures.advancedAbsorptionControl = visitor.field(
+        parameters.features.advancedAbsorptionControl,
+        defaultParameters.features.advancedAbsorptionControl,
+        "simulation parameters.features.additional absorption control");
+    missingFeatures.advancedAttackerControl = visitor.field(
+        parameters.features.advancedAttackerControl,
+        defaultParameters.features.advancedAttackerControl,
+        "simulation parameters.features.additional attacker control");
+    missingFeatures.externalEnergyControl = visitor.field(
+        parameters.features.externalEnergyControl,
+        defaultParameters.features.externalEnergyControl,
+        "simulation parameters.features.external energy");
+    missingFeatures.cellColorTransitionRules = visitor.field(
+        parameters.features.cellColorTransitionRules,
+        defaultParameters.features.cellColorTransitionRules,
+        "simulation parameters.features.cell color transition rules");
+    missingFeatures.cellAgeLimiter = visitor.field(
+        parameters.features.cellAgeLimiter, defaultParameters.features.cellAgeLimiter, "simulation parameters.features.cell age limiter");
+    visitor.field(parameters.features.cellGlow, defaultParameters.features.cellGlow, "simulation parameters.features.cell glow");
+    missingFeatures.legacyMode = visitor.field(
+        parameters.features.legacyModes, defaultParameters.features.legacyModes, "simulation parameters.features.legacy modes");
+    visitor.field(
+        parameters.features.customizeNeuronMutations,
+        defaultParameters.features.customizeNeuronMutations,
+        "simulation parameters.features.customize neuron mutations");
+    visitor.field(
+        parameters.features.customizeDeletionMutations,
+        defaultParameters.features.customizeDeletionMutations,
+        "simulation parameters.features.customize deletion mutations");
+}
+
+template <typename Visitor>
+void ParameterReflection::reflectRuntimeParameters(Visitor& visitor, SimulationParameters& parameters)
+{
+    static SimulationParameters const defaultParameters;
+
+    visitor.field(parameters.innerFriction, defaultParameters.innerFriction, "runtime.inner friction");
+    visitor.field(
+        parameters.cellFunctionInjectorSignalThreshold,
+        defaultParameters.cellFunctionInjectorSignalThreshold,
+        "runtime.cell.function.injector.signal threshold");
+}
+
+inline void ParameterReflection::clampCount(int& count, int maxCount)
+{
+    //protects the zone and radiation source arrays from corrupted input, valid counts are not written to allow encoding of constant data
+    if (count < 0 || count > maxCount) {
+        count = std::clamp(count, 0, maxCount);
+    }
+}
+
+template <typename LeafVisitor>
+ParameterLeafAdapter<LeafVisitor>::ParameterLeafAdapter(LeafVisitor& leafVisitor)
+    : _leafVisitor(leafVisitor)
+{}
+
+template <typename LeafVisitor>
+template <typename T>
+bool ParameterLeafAdapter<LeafVisitor>::field(T& value, T const& defaultValue, std::string_view path)
+{
+    if constexpr (std::rank_v<T> == 1 && !std::is_same_v<T, Char64>) {
+        _path.assign(path);
+        auto result = false;
+        for (int i = 0; i < toInt(std::extent_v<T>); ++i) {
+            _path.resize(path.size());
+            _path.push_back('[');
+            appendIndex(i);
+            _path.push_back(']');
+            result |= _leafVisitor.leaf(value[i], defaultValue[i], _path);
+        }
+        return result;
+    } else if constexpr (std::rank_v<T> == 2) {
+        _path.assign(path);
+        auto result = false;
+        for (int i = 0; i < toInt(std::extent_v<T, 0>); ++i) {
+            for (int j = 0; j < toInt(std::extent_v<T, 1>); ++j) {
+                _path.resize(path.size());
+                _path.push_back('[');
+                appendIndex(i);
+                _path.append(", ");
+                appendIndex(j);
+                _path.push_back(']');
+                result |= _leafVisitor.leaf(value[i][j], defaultValue[i][j], _path);
+            }
+        }
+        return result;
+    } else {
+        return _leafVisitor.leaf(value, defaultValue, path);
+    }
+}
+
+template <typename LeafVisitor>
+template <typename T>
+bool ParameterLeafAdapter<LeafVisitor>::fieldWithEnabled(T& value, bool& isActivated, T const& defaultValue, std::string_view path)
+{
+    _valuePath.assign(path);
+    _valuePath.append(".activated");
+    auto result = _leafVisitor.leaf(isActivated, false, _valuePath);
+
+    //as in ParameterParser only color vectors are stored directly at the node, scalars and color matrices below ".value"
+    if constexpr (std::rank_v<T> == 1) {
+        result |= field(value, defaultValue, path);
+    } else {
+        _valuePath.assign(path);
+        _valuePath.append(".value");
+        result |= field(value, defaultValue, _valuePath);
+    }
+    return result;
+}
+
+template <typename LeafVisitor>
+void ParameterLeafAdapter<LeafVisitor>::appendIndex(int index)
+{
+    char buffer[16];
+    auto [end, error] = std::to_chars(buffer, buffer + sizeof(buffer), index);
+    _path.append(buffer, end);
+}
+
+inline ParameterBinaryWriter::ParameterBinaryWriter(std::vector<uint8_t>& data)
+    : _data(data)
+{}
+
+template <typename T>
+bool ParameterBinaryWriter::leaf(T& value, T const& defaultValue, std::string_view path)
+{
+    if constexpr (std::is_same_v<T, std::string>) {
+        writeString(value);
+    } else if constexpr (std::is_same_v<T, Char64>) {
+        writeString(std::string_view(value, strnlen(value, sizeof(Char64))));
+    } else if constexpr (std::is_same_v<T, std::chrono::milliseconds>) {
+        writeBytes(value.count());
+    } else {
+        writeBytes(value);
+    }
+    return false;
+}
+
+template <typename T>
+void ParameterBinaryWriter::writeBytes(T const& value)
+{
+    auto bytes = reinterpret_cast<uint8_t const*>(&value);
+    _data.insert(_data.end(), bytes, bytes + sizeof(T));
+}
+
+inline void ParameterBinaryWriter::writeString(std::string_view text)
+{
+    writeBytes(static_cast<uint32_t>(text.size()));
+    _data.insert(_data.end(), text.begin(), text.end());
+}
+
+inline ParameterBinaryReader::ParameterBinaryReader(std::vector<uint8_t> const& data, size_t pos)
+    : _data(data)
+    , _pos(pos)
+{}
+
+template <typename T>
+bool ParameterBinaryReader::leaf(T& value, T const& defaultValue, std::string_view path)
+{
+    if constexpr (std::is_same_v<T, std::string>) {
+        value.assign(readString());
+    } else if constexpr (std::is_same_v<T, Char64>) {
+        auto text = readString();
+        if (text.size() >= sizeof(Char64)) {
+            throwCorruptedData();
+        }
+        text.copy(value, text.size());
+        value[text.size()] = '\0';
+    } else if constexpr (std::is_same_v<T, std::chrono::milliseconds>) {
+        value = std::chrono::milliseconds(readBytes<std::chrono::milliseconds::rep>());
+    } else {
+        value = readBytes<T>();
+    }
+    return false;
+}
+
+inline size_t ParameterBinaryReader::getPos() const
+{
+    return _pos;
+}
+
+template <typename T>
+T ParameterBinaryReader::readBytes()
+{
+    if (_data.size() - _pos < sizeof(T)) {
+        throwCorruptedData();
+    }
+    T result;
+    std::memcpy(&result, _data.data() + _pos, sizeof(T));
+    _pos += sizeof(T);
+    return result;
+}
+
+inline std::string_view ParameterBinaryReader::readString()
+{
+    auto length = readBytes<uint32_t>();
+    if (_data.size() - _pos < length) {
+        throwCorruptedData();
+    }
+    std::string_view result(reinterpret_cast<char const*>(_data.data() + _pos), length);
+    _pos += length;
+    return result;
+}
+
+inline void ParameterBinaryReader::throwCorruptedData()
+{
+    throw std::runtime_error("Binary simulation parameters are corrupted.");
+}
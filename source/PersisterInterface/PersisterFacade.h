@@ -27,6 +27,7 @@
 #include "PersisterErrorInfo.h"
 #include "PersisterRequestId.h"
 #include "PersisterRequestState.h"
+#include "PersisterStatistics.h"
 #include "ReplaceNetworkResourceRequestData.h"
 #include "ReplaceNetworkResourceResultData.h"
 #include "SaveDeserializedSimulationRequestData.h"
@@ -57,6 +58,7 @@ public:
     virtual PersisterRequestResult fetchPersisterRequestResult(PersisterRequestId const& id) = 0;
     virtual std::vector<PersisterErrorInfo> fetchAllErrorInfos(SenderId const& senderId) = 0;
     virtual PersisterErrorInfo fetchError(PersisterRequestId const& id) = 0;
+    virtual PersisterStatistics getStatistics() const = 0;
 
     //specific request
     virtual PersisterRequestId scheduleSaveSimulation(SenderInfo const& senderInfo, SaveSimulationRequestData const& data) = 0;
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+using PersisterLane = int;
+enum PersisterLane_
+{
+    PersisterLane_Interactive,  //small network requests a user is waiting for
+    PersisterLane_Bulk,  //reading and writing of simulations, transfers of network resources
+    PersisterLane_Count
+};
+
+struct PersisterLaneStatistics
+{
+    int queueDepth = 0;
+    int numRequestsInProgress = 0;
+    uint64_t numProcessedRequests = 0;
+
+    //latencies of the processed requests: time in queue and time for processing
+    std::chrono::microseconds totalWaitingTime{0};
+    std::chrono::microseconds maxWaitingTime{0};
+    std::chrono::microseconds totalProcessingTime{0};
+};
+
+struct PersisterStatistics
+{
+    std::array<PersisterLaneStatistics, PersisterLane_Count> lanes;
+};
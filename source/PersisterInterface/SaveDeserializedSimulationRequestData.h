@@ -10,4 +10,5 @@ struct SaveDeserializedSimulationRequestData
     SharedDeserializedSimulation sharedDeserializedSimulation;
     bool generateNameFromTimestep = false;
     bool resetDeserializedSimulation = false;
+    std::filesystem::path deltaBaseFilename;  //if not empty, only the changes relative to this simulation file are saved
 };
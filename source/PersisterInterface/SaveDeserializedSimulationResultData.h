@@ -10,4 +10,5 @@ struct SaveDeserializedSimulationResultData
     uint64_t timestep = 0;
     std::chrono::system_clock::time_point timestamp;
     RawStatisticsData rawStatisticsData;
+    std::filesystem::path baseFilename;  //empty if the complete simulation has been saved
 };
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <filesystem>
 #include <string>
 
 #include "Base/Vector2D.h"
@@ -10,4 +11,5 @@ struct SaveSimulationRequestData
     float zoom = 1.0f;
     RealVector2D center;
     bool generateNameFromTimestep = false;
+    std::filesystem::path deltaBaseFilename;  //if not empty, only the changes relative to this simulation file are saved
 };
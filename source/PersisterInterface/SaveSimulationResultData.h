@@ -9,4 +9,5 @@ struct SaveSimulationResultData
     std::string projectName;
     uint64_t timestep = 0;
     std::chrono::system_clock::time_point timestamp;
+    std::filesystem::path baseFilename;  //empty if the complete simulation has been saved
 };
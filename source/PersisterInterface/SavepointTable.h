@@ -25,6 +25,7 @@ struct _SavepointEntry
     uint64_t timestep = 0;
     std::string peak;
     std::string peakType;
+    std::filesystem::path baseFilename;  // savepoint of which only the changes are stored, empty for full savepoints
 
     std::string requestId;  // transient
 };
@@ -41,7 +42,6 @@ public:
     std::filesystem::path const& getFilename() const { return _filename; }
     int const& getSequenceNumber() const { return _sequenceNumber; }
 
-
 private:
     SavepointTable(std::filesystem::path const& filename, std::deque<SavepointEntry> const& entries)
         : _filename(filename)
@@ -51,5 +51,6 @@ private:
     std::filesystem::path _filename;
     int _sequenceNumber = 0;
     std::deque<SavepointEntry> _entries;
+    std::deque<SavepointEntry> _baseEntries;  // removed entries which are still needed by delta savepoints
 };
 
@@ -3,6 +3,7 @@
 #include <filesystem>
 #include <fstream>
 #include <ranges>
+#include <set>
 
 #include <boost/property_tree/json_parser.hpp>
 
@@ -71,16 +72,17 @@ std::vector<SavepointEntry> SavepointTableService::truncate(SavepointTable& tabl
         return result;
     }
 
+    std::vector<SavepointEntry> persistedEntries;
     for (auto const& entry : entries | std::views::drop(newSize)) {
         if (entry->state == SavepointState_Persisted) {
-            auto filename = calcAbsolutePath(table, entry);
-            SerializerService::get().deleteSimulation(filename);
+            persistedEntries.emplace_back(entry);
         } else {
             result.emplace_back(entry);
         }
     }
 
     entries.erase(entries.begin() + newSize, entries.end());
+    removeEntries(table, persistedEntries);
     updateFile(table);
     return result;
 }
@@ -95,20 +97,34 @@ void SavepointTableService::insertEntryAtFront(SavepointTable& table, SavepointE
 void SavepointTableService::updateEntry(SavepointTable& table, int row, SavepointEntry const& newEntry) const
 {
     table._entries.at(row) = newEntry;
+    deleteUnreferencedBaseEntries(table);
     updateFile(table);
 }
 
 void SavepointTableService::deleteEntry(SavepointTable& table, SavepointEntry const& entry) const
 {
+    table._entries.erase(std::remove(table._entries.begin(), table._entries.end(), entry), table._entries.end());
     if (!entry->filename.empty()) {
-        auto filename = calcAbsolutePath(table, entry);
-        SerializerService::get().deleteSimulation(filename);
+        removeEntries(table, {entry});
+    } else {
+        deleteUnreferencedBaseEntries(table);
     }
-
-    table._entries.erase(std::remove(table._entries.begin(), table._entries.end(), entry), table._entries.end());
     updateFile(table);
 }
 
+int SavepointTableService::calcNumDeltasSinceFullSavepoint(SavepointTable const& table, SavepointEntry const& entry) const
+{
+    auto maxNumDeltas = toInt(table._entries.size() + table._baseEntries.size());
+
+    int result = 0;
+    auto currentEntry = entry;
+    while (currentEntry && !currentEntry->baseFilename.empty() && result <= maxNumDeltas) {
+        ++result;
+        currentEntry = findEntry(table, currentEntry->baseFilename);
+    }
+    return result;
+}
+
 std::filesystem::path SavepointTableService::calcAbsolutePath(SavepointTable const& table, SavepointEntry const& entry) const
 {
     //compatibility with v4.11
@@ -121,9 +137,55 @@ std::filesystem::path SavepointTableService::calcAbsolutePath(SavepointTable con
 
 std::filesystem::path SavepointTableService::calcEntryPath(SavepointTable const& table, std::filesystem::path const& absolutePath) const
 {
+    if (absolutePath.empty()) {
+        return {};
+    }
     return std::filesystem::relative(absolutePath, table.getFilename().parent_path());
 }
 
+void SavepointTableService::removeEntries(SavepointTable& table, std::vector<SavepointEntry> const& entries) const
+{
+    table._baseEntries.insert(table._baseEntries.end(), entries.begin(), entries.end());
+    deleteUnreferencedBaseEntries(table);
+}
+
+void SavepointTableService::deleteUnreferencedBaseEntries(SavepointTable& table) const
+{
+    std::set<SavepointEntry> referencedEntries;
+    for (auto const& entry : table._entries) {
+        auto baseEntry = entry;
+        while (!baseEntry->baseFilename.empty()) {
+            baseEntry = findEntry(table, baseEntry->baseFilename);
+            if (!baseEntry || !referencedEntries.insert(baseEntry).second) {
+                break;
+            }
+        }
+    }
+
+    std::deque<SavepointEntry> baseEntries;
+    for (auto const& entry : table._baseEntries) {
+        if (referencedEntries.contains(entry)) {
+            baseEntries.emplace_back(entry);
+        } else {
+            SerializerService::get().deleteSimulation(calcAbsolutePath(table, entry));
+        }
+    }
+    table._baseEntries = baseEntries;
+}
+
+SavepointEntry SavepointTableService::findEntry(SavepointTable const& table, std::filesystem::path const& filename) const
+{
+    auto absolutePath = filename.is_absolute() ? filename : table.getFilename().parent_path() / filename;
+    for (auto const& entries : {&table._entries, &table._baseEntries}) {
+        for (auto const& entry : *entries) {
+            if (!entry->filename.empty() && calcAbsolutePath(table, entry) == absolutePath) {
+                return entry;
+            }
+        }
+    }
+    return nullptr;
+}
+
 void SavepointTableService::updateFile(SavepointTable& table) const
 {
     try {
@@ -144,10 +206,15 @@ void SavepointTableService::updateFile(SavepointTable& table) const
 void SavepointTableService::encodeDecode(boost::property_tree::ptree& tree, SavepointTable& table, ParserTask task) const
 {
     JsonParser::encodeDecode(tree, table._sequenceNumber, 0, "sequence number", task);
-    encodeDecode(tree, table._entries, task);
+    encodeDecode(tree, table._entries, "entries", task);
+    encodeDecode(tree, table._baseEntries, "base entries", task);
 }
 
-void SavepointTableService::encodeDecode(boost::property_tree::ptree& tree, std::deque<SavepointEntry>& entries, ParserTask task) const
+void SavepointTableService::encodeDecode(
+    boost::property_tree::ptree& tree,
+    std::deque<SavepointEntry>& entries,
+    std::string const& node,
+    ParserTask task) const
 {
     if (ParserTask::Encode == task) {
         boost::property_tree::ptree subtree;
@@ -159,10 +226,14 @@ void SavepointTableService::encodeDecode(boost::property_tree::ptree& tree, std:
             subtree.push_back(std::make_pair(std::to_string(index), subsubtree));
             ++index;
         }
-        tree.push_back(std::make_pair("entries", subtree));
+        tree.push_back(std::make_pair(node, subtree));
     } else {
         entries.clear();
-        for (auto& [key, subtree] : tree.get_child("entries")) {
+        auto entriesTree = tree.get_child_optional(node);
+        if (!entriesTree) {
+            return;
+        }
+        for (auto& [key, subtree] : *entriesTree) {
             SavepointEntry entry = std::make_shared<_SavepointEntry>();
             encodeDecode(subtree, entry, task);
             entries.emplace_back(entry);
@@ -179,6 +250,7 @@ void SavepointTableService::encodeDecode(boost::property_tree::ptree& tree, Save
     JsonParser::encodeDecode(tree, entry->timestep, uint64_t(0), "timestep", task);
     JsonParser::encodeDecode(tree, entry->peak, std::string(), "peak", task);
     JsonParser::encodeDecode(tree, entry->peakType, std::string(), "peak type", task);
+    encodeDecode(tree, entry->baseFilename, "base filename", task);
 }
 
 void SavepointTableService::encodeDecode(boost::property_tree::ptree& tree, std::filesystem::path& path, std::string const& node, ParserTask task) const
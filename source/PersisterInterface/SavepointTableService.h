@@ -25,13 +25,20 @@ public:
     void updateEntry(SavepointTable& table, int row, SavepointEntry const& newEntry) const;
     void deleteEntry(SavepointTable& table, SavepointEntry const& entry) const;
 
+    int calcNumDeltasSinceFullSavepoint(SavepointTable const& table, SavepointEntry const& entry) const;
+
     std::filesystem::path calcAbsolutePath(SavepointTable const& table, SavepointEntry const& entry) const;
     std::filesystem::path calcEntryPath(SavepointTable const& table, std::filesystem::path const& absolutePath) const;
 
 private:
+    //the files of removed entries are kept as long as they are needed as base for other entries
+    void removeEntries(SavepointTable& table, std::vector<SavepointEntry> const& entries) const;
+    void deleteUnreferencedBaseEntries(SavepointTable& table) const;
+    SavepointEntry findEntry(SavepointTable const& table, std::filesystem::path const& filename) const;
+
     void updateFile(SavepointTable& table) const;
     void encodeDecode(boost::property_tree::ptree& tree, SavepointTable& table, ParserTask task) const;
-    void encodeDecode(boost::property_tree::ptree& tree, std::deque<SavepointEntry>& entries, ParserTask task) const;
+    void encodeDecode(boost::property_tree::ptree& tree, std::deque<SavepointEntry>& entries, std::string const& node, ParserTask task) const;
     void encodeDecode(boost::property_tree::ptree& tree, SavepointEntry& entry, ParserTask task) const;
     void encodeDecode(boost::property_tree::ptree& tree, std::filesystem::path& path, std::string const& node, ParserTask task) const;
 };
\ No newline at end of file
@@ -1,10 +1,15 @@
 #include "SerializerService.h"
 
+#include <algorithm>
+#include <charconv>
 #include <sstream>
 #include <stdexcept>
+#include <string_view>
 #include <filesystem>
+#include <iterator>
 
 #include <optional>
+#include <ranges>
 #include <cereal/archives/portable_binary.hpp>
 #include <cereal/types/optional.hpp>
 #include <cereal/types/memory.hpp>
@@ -29,6 +34,10 @@
 #include "EngineInterface/GenomeDescriptionService.h"
 
 #include "AuxiliaryDataParserService.h"
+#include "ColumnarSnapshot.h"
+#include "ColumnarSnapshotService.h"
+#include "SimulationDeltaService.h"
+#include "StatisticsHistoryFileService.h"
 
 #define SPLIT_SERIALIZATION(Classname) \
     template <class Archive> \
@@ -44,6 +53,8 @@
 
 namespace
 {
+    auto constexpr MaxDeltaChainLength = 1000;
+
     auto constexpr Id_GenomeHeader_Shape = 0;
     auto constexpr Id_GenomeHeader_SeparateConstruction = 2;
     auto constexpr Id_GenomeHeader_AngleAlignment = 3;
@@ -851,32 +862,81 @@ bool SerializerService::serializeSimulationToFiles(std::filesystem::path const&
 {
     try {
         log(Priority::Important, "save simulation to " + filename.string());
-        std::filesystem::path settingsFilename(filename);
-        settingsFilename.replace_extension(std::filesystem::path(".settings.json"));
-        std::filesystem::path statisticsFilename(filename);
-        statisticsFilename.replace_extension(std::filesystem::path(".statistics.csv"));
 
         {
-            zstr::ofstream stream(filename.string(), std::ios::binary);
+            std::ofstream stream(filename.string(), std::ios::binary);
             if (!stream) {
                 return false;
             }
-            serializeDataDescription(data.mainData, stream);
+            ColumnarSnapshotService::get().serialize(data.mainData, stream);
+        }
+        return serializeSettingsAndStatisticsToFiles(filename, data.auxiliaryData, data.statistics, data.numStableStatistics);
+    } catch (...) {
+        return false;
+    }
+}
+
+bool SerializerService::serializeDeltaSimulationToFiles(
+    std::filesystem::path const& filename,
+    std::filesystem::path const& baseFilename,
+    DeserializedSimulation const& data)
+{
+    try {
+        log(Priority::Important, "save simulation delta to " + filename.string());
+
+        if (getDeltaChain(baseFilename).size() >= MaxDeltaChainLength) {
+            return false;
         }
+        ClusteredDataDescription baseContent;
+        if (!deserializeDataDescription(baseContent, baseFilename)) {
+            return false;
+        }
+
+        auto delta = SimulationDeltaService::get().calcDelta(baseContent, data.mainData);
+        delta.baseFilename = SimulationDeltaService::get().calcBaseFilename(filename, baseFilename);
         {
-            std::ofstream stream(settingsFilename.string(), std::ios::binary);
+            std::ofstream stream(filename.string(), std::ios::binary);
             if (!stream) {
                 return false;
             }
-            serializeAuxiliaryData(data.auxiliaryData, stream);
+            ColumnarSnapshotService::get().serialize(delta, stream);
+        }
+        return serializeDeltaSettingsAndStatisticsToFiles(filename, baseFilename, data.auxiliaryData, data.statistics, data.numStableStatistics);
+    } catch (...) {
+        return false;
+    }
+}
+
+bool SerializerService::serializeDeltaSettingsAndStatisticsToFiles(
+    std::filesystem::path const& filename,
+    std::filesystem::path const& baseFilename,
+    AuxiliaryData const& auxiliaryData,
+    StatisticsHistoryData const& statistics,
+    uint64_t numStableStatistics)
+{
+    try {
+        auto deltaChain = getDeltaChain(baseFilename);
+        if (deltaChain.size() >= MaxDeltaChainLength) {
+            return false;
         }
+        boost::property_tree::ptree baseSettingsTree;
+        if (!deserializeSettingsTree(baseSettingsTree, deltaChain)) {
+            return false;
+        }
+
+        std::filesystem::path settingsFilename(filename);
+        settingsFilename.replace_extension(std::filesystem::path(".settings.json"));
+        std::filesystem::path statisticsFilename(filename);
+        statisticsFilename.replace_extension(std::filesystem::path(".statistics.bin"));
         {
-            std::ofstream stream(statisticsFilename.string(), std::ios::binary);
+            std::ofstream stream(settingsFilename.string(), std::ios::binary);
             if (!stream) {
                 return false;
             }
-            serializeStatistics(data.statistics, stream);
+            auto settingsTree = AuxiliaryDataParserService::get().encodeAuxiliaryData(auxiliaryData);
+            boost::property_tree::json_parser::write_json(stream, SimulationDeltaService::get().calcDelta(baseSettingsTree, settingsTree));
         }
+        StatisticsHistoryFileService::get().append(statisticsFilename, statistics, numStableStatistics);
         return true;
     } catch (...) {
         return false;
@@ -887,27 +947,70 @@ bool SerializerService::deserializeSimulationFromFiles(DeserializedSimulation& d
 {
     try {
         log(Priority::Important, "load simulation from " + filename.string());
-        std::filesystem::path settingsFilename(filename);
-        settingsFilename.replace_extension(std::filesystem::path(".settings.json"));
-        std::filesystem::path statisticsFilename(filename);
-        statisticsFilename.replace_extension(std::filesystem::path(".statistics.csv"));
 
         if (!deserializeDataDescription(data.mainData, filename)) {
             return false;
         }
+        return deserializeSettingsAndStatisticsFromFiles(data.auxiliaryData, data.statistics, filename);
+    } catch (...) {
+        return false;
+    }
+}
+
+bool SerializerService::serializeSettingsAndStatisticsToFiles(
+    std::filesystem::path const& filename,
+    AuxiliaryData const& auxiliaryData,
+    StatisticsHistoryData const& statistics,
+    uint64_t numStableStatistics)
+{
+    try {
+        std::filesystem::path settingsFilename(filename);
+        settingsFilename.replace_extension(std::filesystem::path(".settings.json"));
+        std::filesystem::path statisticsFilename(filename);
+        statisticsFilename.replace_extension(std::filesystem::path(".statistics.bin"));
+
         {
-            std::ifstream stream(settingsFilename.string(), std::ios::binary);
+            std::ofstream stream(settingsFilename.string(), std::ios::binary);
             if (!stream) {
                 return false;
             }
-            deserializeAuxiliaryData(data.auxiliaryData, stream);
+            serializeAuxiliaryData(auxiliaryData, stream);
         }
+        StatisticsHistoryFileService::get().append(statisticsFilename, statistics, numStableStatistics);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+bool SerializerService::deserializeSettingsAndStatisticsFromFiles(
+    AuxiliaryData& auxiliaryData,
+    StatisticsHistoryData& statistics,
+    std::filesystem::path const& filename)
+{
+    try {
+        std::filesystem::path settingsFilename(filename);
+        settingsFilename.replace_extension(std::filesystem::path(".settings.json"));
+        std::filesystem::path statisticsFilename(filename);
+        statisticsFilename.replace_extension(std::filesystem::path(".statistics.bin"));
+        std::filesystem::path legacyStatisticsFilename(filename);
+        legacyStatisticsFilename.replace_extension(std::filesystem::path(".statistics.csv"));
+
         {
-            std::ifstream stream(statisticsFilename.string(), std::ios::binary);
+            boost::property_tree::ptree tree;
+            if (!deserializeSettingsTree(tree, getDeltaChain(filename))) {
+                return false;
+            }
+            auxiliaryData = AuxiliaryDataParserService::get().decodeAuxiliaryData(tree);
+        }
+        if (std::filesystem::exists(statisticsFilename)) {
+            StatisticsHistoryFileService::get().read(statistics, statisticsFilename);
+        } else {
+            std::ifstream stream(legacyStatisticsFilename.string(), std::ios::binary);
             if (!stream) {
                 return true;
             }
-            deserializeStatistics(data.statistics, stream);
+            deserializeStatistics(statistics, stream);
         }
         return true;
     } catch (...) {
@@ -922,7 +1025,9 @@ bool SerializerService::deleteSimulation(std::filesystem::path const& filename)
         std::filesystem::path settingsFilename(filename);
         settingsFilename.replace_extension(std::filesystem::path(".settings.json"));
         std::filesystem::path statisticsFilename(filename);
-        statisticsFilename.replace_extension(std::filesystem::path(".statistics.csv"));
+        statisticsFilename.replace_extension(std::filesystem::path(".statistics.bin"));
+        std::filesystem::path legacyStatisticsFilename(filename);
+        legacyStatisticsFilename.replace_extension(std::filesystem::path(".statistics.csv"));
 
         if (!std::filesystem::remove(filename)) {
             return false;
@@ -930,7 +1035,9 @@ bool SerializerService::deleteSimulation(std::filesystem::path const& filename)
         if (!std::filesystem::remove(settingsFilename)) {
             return false;
         }
-        if (!std::filesystem::remove(statisticsFilename)) {
+        auto statisticsRemoved = std::filesystem::remove(statisticsFilename);
+        auto legacyStatisticsRemoved = std::filesystem::remove(legacyStatisticsFilename);
+        if (!statisticsRemoved && !legacyStatisticsRemoved) {
             return false;
         }
         return true;
@@ -979,10 +1086,7 @@ bool SerializerService::deserializeSimulationFromStrings(DeserializedSimulation&
             }
             deserializeDataDescription(output.mainData, stream);
         }
-        {
-            std::stringstream stream(input.auxiliaryData);
-            deserializeAuxiliaryData(output.auxiliaryData, stream);
-        }
+        output.auxiliaryData = AuxiliaryDataParserService::get().decodeAuxiliaryDataFromJson(input.auxiliaryData);
         {
             std::stringstream stream(input.statistics);
             deserializeStatistics(output.statistics, stream);
@@ -1127,11 +1231,11 @@ bool SerializerService::serializeStatisticsToFile(std::filesystem::path const& f
 bool SerializerService::serializeContentToFile(std::filesystem::path const& filename, ClusteredDataDescription const& content)
 {
     try {
-        zstr::ofstream fileStream(filename.string(), std::ios::binary);
+        std::ofstream fileStream(filename.string(), std::ios::binary);
         if (!fileStream) {
             return false;
         }
-        serializeDataDescription(content, fileStream);
+        ColumnarSnapshotService::get().serialize(content, fileStream);
 
         return true;
     } catch (...) {
@@ -1160,6 +1264,25 @@ void SerializerService::serializeDataDescription(ClusteredDataDescription const&
 
 bool SerializerService::deserializeDataDescription(ClusteredDataDescription& data, std::filesystem::path const& filename)
 {
+    auto deltaChain = getDeltaChain(filename);
+    if (deltaChain.size() > 1) {
+        if (!deserializeDataDescription(data, deltaChain.front())) {
+            return false;
+        }
+        for (auto const& deltaFilename : deltaChain | std::views::drop(1)) {
+            SimulationDelta delta;
+            ColumnarSnapshotService::get().deserialize(delta, deltaFilename);
+            SimulationDeltaService::get().applyDelta(data, delta);
+        }
+        return true;
+    }
+
+    if (ColumnarSnapshot::isColumnarSnapshot(filename)) {
+        ColumnarSnapshotService::get().deserialize(data, filename);
+        return true;
+    }
+
+    //files of older versions are compressed cereal archives
     zstr::ifstream stream(filename.string(), std::ios::binary);
     if (!stream) {
         return false;
@@ -1183,37 +1306,104 @@ void SerializerService::deserializeDataDescription(ClusteredDataDescription& dat
     archive(data);
 }
 
+std::vector<std::filesystem::path> SerializerService::getDeltaChain(std::filesystem::path const& filename)
+{
+    std::vector<std::filesystem::path> result{filename};
+    while (auto baseFilename = ColumnarSnapshotService::get().getDeltaBaseFilename(result.back())) {
+        if (result.size() > MaxDeltaChainLength) {
+            throw std::runtime_error("Chain of delta snapshots is too long.");
+        }
+        result.emplace_back(result.back().parent_path() / baseFilename.value());
+    }
+    std::ranges::reverse(result);
+    return result;
+}
+
+bool SerializerService::deserializeSettingsTree(boost::property_tree::ptree& tree, std::vector<std::filesystem::path> const& deltaChain)
+{
+    tree.clear();
+    for (auto const& [index, filename] : deltaChain | boost::adaptors::indexed(0)) {
+        std::filesystem::path settingsFilename(filename);
+        settingsFilename.replace_extension(std::filesystem::path(".settings.json"));
+
+        std::ifstream stream(settingsFilename.string(), std::ios::binary);
+        if (!stream) {
+            return false;
+        }
+        boost::property_tree::ptree settingsTree;
+        boost::property_tree::read_json(stream, settingsTree);
+        if (index == 0) {
+            tree = settingsTree;
+        } else {
+            SimulationDeltaService::get().applyDelta(tree, settingsTree);
+        }
+    }
+    return true;
+}
+
 void SerializerService::serializeAuxiliaryData(AuxiliaryData const& auxiliaryData, std::ostream& stream)
 {
-    boost::property_tree::json_parser::write_json(stream, AuxiliaryDataParserService::get().encodeAuxiliaryData(auxiliaryData));
+    AuxiliaryDataParserService::get().encodeAuxiliaryDataToJson(auxiliaryData, stream);
 }
 
 void SerializerService::deserializeAuxiliaryData(AuxiliaryData& auxiliaryData, std::istream& stream)
 {
-    boost::property_tree::ptree tree;
-    boost::property_tree::read_json(stream, tree);
-    auxiliaryData = AuxiliaryDataParserService::get().decodeAuxiliaryData(tree);
+    std::string json(std::istreambuf_iterator<char>(stream), {});
+    auxiliaryData = AuxiliaryDataParserService::get().decodeAuxiliaryDataFromJson(json);
 }
 
 void SerializerService::serializeSimulationParameters(SimulationParameters const& parameters, std::ostream& stream)
 {
-    boost::property_tree::json_parser::write_json(stream, AuxiliaryDataParserService::get().encodeSimulationParameters(parameters));
+    AuxiliaryDataParserService::get().encodeSimulationParametersToJson(parameters, stream);
 }
 
 void SerializerService::deserializeSimulationParameters(SimulationParameters& parameters, std::istream& stream)
 {
-    boost::property_tree::ptree tree;
-    boost::property_tree::read_json(stream, tree);
-    parameters = AuxiliaryDataParserService::get().decodeSimulationParameters(tree);
+    std::string json(std::istreambuf_iterator<char>(stream), {});
+    parameters = AuxiliaryDataParserService::get().decodeSimulationParametersFromJson(json);
 }
 
 namespace
 {
-    std::string toString(double value)
+    void appendValue(std::string& line, double value)
     {
-        std::stringstream ss;
-        ss << std::fixed << std::setprecision(9) << value;
-        return ss.str();        
+        char buffer[128];
+        auto [end, error] = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed, 9);
+        if (error != std::errc()) {
+            throw std::runtime_error("Could not format statistics value.");
+        }
+        if (!line.empty()) {
+            line.push_back(',');
+        }
+        line.append(buffer, end);
+    }
+
+    double parseValue(std::string_view field)
+    {
+        while (!field.empty() && field.front() == ' ') {
+            field.remove_prefix(1);
+        }
+        double result;
+        auto [ptr, error] = std::from_chars(field.data(), field.data() + field.size(), result);
+        if (error != std::errc()) {
+            throw std::runtime_error("Could not parse statistics value.");
+        }
+        return result;
+    }
+
+    void splitFields(std::vector<std::string_view>& fields, std::string_view line)
+    {
+        fields.clear();
+        size_t startPos = 0;
+        while (true) {
+            auto endPos = line.find(',', startPos);
+            if (endPos == std::string_view::npos) {
+                fields.emplace_back(line.substr(startPos));
+                return;
+            }
+            fields.emplace_back(line.substr(startPos, endPos - startPos));
+            startPos = endPos + 1;
+        }
     }
 
     struct ColumnDescription
@@ -1310,37 +1500,37 @@ namespace
         THROW_NOT_IMPLEMENTED();
     }
 
-    void load(int startIndex, std::vector<std::string>& serializedData, double& value)
+    void load(int startIndex, std::vector<std::string_view> const& serializedData, double& value)
     {
         if (startIndex < serializedData.size()) {
-            value = std::stod(serializedData.at(startIndex));
+            value = parseValue(serializedData.at(startIndex));
         }
     }
 
-    void save(std::vector<std::string>& serializedData, double& value)
+    void save(std::string& serializedData, double& value)
     {
-        serializedData.emplace_back(toString(value));
+        appendValue(serializedData, value);
     }
 
-    void load(int startIndex, std::vector<std::string>& serializedData, DataPoint& dataPoint)
+    void load(int startIndex, std::vector<std::string_view> const& serializedData, DataPoint& dataPoint)
     {
         for (int i = 0; i < MAX_COLORS; ++i) {
             auto index = startIndex + i;
             if (index < serializedData.size()) {
-                dataPoint.values[i] = std::stod(serializedData.at(index));
+                dataPoint.values[i] = parseValue(serializedData.at(index));
             }
         }
         if (startIndex + 7 < serializedData.size()) {
-            dataPoint.summedValues = std::stod(serializedData.at(startIndex + 7));
+            dataPoint.summedValues = parseValue(serializedData.at(startIndex + 7));
         }
     }
 
-    void save(std::vector<std::string>& serializedData, DataPoint& dataPoint)
+    void save(std::string& serializedData, DataPoint& dataPoint)
     {
         for (int i = 0; i < MAX_COLORS; ++i) {
-            serializedData.emplace_back(toString(dataPoint.values[i]));
+            appendValue(serializedData, dataPoint.values[i]);
         }
-        serializedData.emplace_back(toString(dataPoint.summedValues));
+        appendValue(serializedData, dataPoint.summedValues);
     }
 
     struct ParsedColumnInfo
@@ -1349,7 +1539,7 @@ namespace
         std::optional<int> colIndex;
         int size = 0;
     };
-    void load(std::vector<ParsedColumnInfo> const& colInfos, std::vector<std::string>& serializedData, DataPointCollection& dataPoints)
+    void load(std::vector<ParsedColumnInfo> const& colInfos, std::vector<std::string_view> const& serializedData, DataPointCollection& dataPoints)
     {
         int startIndex = 0;
         for (auto const& colInfo : colInfos) {
@@ -1369,7 +1559,7 @@ namespace
         }
     }
 
-    void save(std::vector<std::string>& serializedData, DataPointCollection& dataPoints)
+    void save(std::string& serializedData, DataPointCollection& dataPoints)
     {
         int index = 0;
         for (auto const& column : ColumnDescriptions) {
@@ -1435,10 +1625,12 @@ void SerializerService::serializeStatistics(StatisticsHistoryData const& statist
     stream << std::endl;
 
     //content
+    std::string line;
     for (auto dataPoints : statistics) {
-        std::vector<std::string> entries;
-        save(entries, dataPoints);
-        stream << boost::join(entries, ",") << std::endl;
+        line.clear();
+        save(line, dataPoints);
+        line.push_back('\n');
+        stream.write(line.data(), line.size());
     }
 }
 
@@ -1472,9 +1664,9 @@ void SerializerService::deserializeStatistics(StatisticsHistoryData& statistics,
     }
 
     // data lines
+    std::vector<std::string_view> entries;
     while (std::getline(stream, header)) {
-        std::vector<std::string> entries;
-        boost::split(entries, header, boost::is_any_of(","));
+        splitFields(entries, header);
 
         DataPointCollection dataPoints;
         load(colInfos, entries, dataPoints);
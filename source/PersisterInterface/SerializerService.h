@@ -2,6 +2,8 @@
 
 #include <filesystem>
 
+#include <boost/property_tree/ptree_fwd.hpp>
+
 #include "Base/Definitions.h"
 
 #include "EngineInterface/Descriptions.h"
@@ -19,9 +21,32 @@ class SerializerService
 
 public:
     bool serializeSimulationToFiles(std::filesystem::path const& filename, DeserializedSimulation const& data);
-    bool deserializeSimulationFromFiles(DeserializedSimulation& data, std::filesystem::path const& filename);
+    bool deserializeSimulationFromFiles(DeserializedSimulation& data, std::filesystem::path const& filename);  //also resolves delta snapshots
     bool deleteSimulation(std::filesystem::path const& filename);
 
+    //the settings and statistics files belonging to a simulation file, the simulation data itself can be written with
+    //SimulationFacade::saveSimulationData
+    bool serializeSettingsAndStatisticsToFiles(
+        std::filesystem::path const& filename,
+        AuxiliaryData const& auxiliaryData,
+        StatisticsHistoryData const& statistics,
+        uint64_t numStableStatistics = 0);
+    bool deserializeSettingsAndStatisticsFromFiles(AuxiliaryData& auxiliaryData, StatisticsHistoryData& statistics, std::filesystem::path const& filename);
+
+    //writes only the changes relative to the simulation in baseFilename, which can be a delta snapshot itself
+    bool serializeDeltaSimulationToFiles(
+        std::filesystem::path const& filename,
+        std::filesystem::path const& baseFilename,
+        DeserializedSimulation const& data);
+    //the settings and statistics files belonging to a delta snapshot, the simulation data itself can be written with
+    //SimulationFacade::saveSimulationDataDelta
+    bool serializeDeltaSettingsAndStatisticsToFiles(
+        std::filesystem::path const& filename,
+        std::filesystem::path const& baseFilename,
+        AuxiliaryData const& auxiliaryData,
+        StatisticsHistoryData const& statistics,
+        uint64_t numStableStatistics = 0);
+
     bool serializeSimulationToStrings(SerializedSimulation& output, DeserializedSimulation const& input);
     bool deserializeSimulationFromStrings(DeserializedSimulation& output, SerializedSimulation const& input);
 
@@ -44,6 +69,9 @@ private:
     bool deserializeDataDescription(ClusteredDataDescription& data, std::filesystem::path const& filename);
     void deserializeDataDescription(ClusteredDataDescription& data, std::istream& stream);
 
+    std::vector<std::filesystem::path> getDeltaChain(std::filesystem::path const& filename);  //starts with the full snapshot
+    bool deserializeSettingsTree(boost::property_tree::ptree& tree, std::vector<std::filesystem::path> const& deltaChain);
+
     void serializeAuxiliaryData(AuxiliaryData const& auxiliaryData, std::ostream& stream);
     void deserializeAuxiliaryData(AuxiliaryData& auxiliaryData, std::istream& stream);
 
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include "EngineInterface/Descriptions.h"
+
+//content of a simulation relative to the content of a base simulation file
+struct SimulationDelta
+{
+    std::filesystem::path baseFilename;  //relative to the directory of the delta file
+    ClusteredDataDescription changedContent;  //added and changed cells and particles
+    std::vector<uint64_t> removedCellIds;
+    std::vector<uint64_t> removedParticleIds;
+};
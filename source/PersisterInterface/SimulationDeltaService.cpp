@@ -0,0 +1,197 @@
+#include "SimulationDeltaService.h"
+
+#include <unordered_map>
+#include <unordered_set>
+
+std::filesystem::path SimulationDeltaService::calcBaseFilename(std::filesystem::path const& filename, std::filesystem::path const& baseFilename) const
+{
+    auto result = std::filesystem::relative(std::filesystem::absolute(baseFilename), std::filesystem::absolute(filename).parent_path());
+    if (result.empty()) {
+        result = std::filesystem::absolute(baseFilename);
+    }
+    return result;
+}
+
+SimulationDelta SimulationDeltaService::calcDelta(ClusteredDataDescription const& base, ClusteredDataDescription const& content) const
+{
+    SimulationDelta result;
+
+    std::unordered_map<uint64_t, CellDescription const*> baseCellById;
+    for (auto const& cluster : base.clusters) {
+        for (auto const& cell : cluster.cells) {
+            baseCellById.emplace(cell.id, &cell);
+        }
+    }
+    for (auto const& cluster : content.clusters) {
+        ClusterDescription changedCluster;
+        for (auto const& cell : cluster.cells) {
+            auto findResult = baseCellById.find(cell.id);
+            if (findResult == baseCellById.end()) {
+                changedCluster.addCell(cell);
+                continue;
+            }
+            if (*findResult->second != cell) {
+                changedCluster.addCell(cell);
+            }
+            baseCellById.erase(findResult);
+        }
+        if (!changedCluster.cells.empty()) {
+            result.changedContent.addCluster(changedCluster);
+        }
+    }
+    for (auto const& cluster : base.clusters) {
+        for (auto const& cell : cluster.cells) {
+            if (baseCellById.contains(cell.id)) {
+                result.removedCellIds.emplace_back(cell.id);
+            }
+        }
+    }
+
+    std::unordered_map<uint64_t, ParticleDescription const*> baseParticleById;
+    for (auto const& particle : base.particles) {
+        baseParticleById.emplace(particle.id, &particle);
+    }
+    for (auto const& particle : content.particles) {
+        auto findResult = baseParticleById.find(particle.id);
+        if (findResult == baseParticleById.end()) {
+            result.changedContent.addParticle(particle);
+            continue;
+        }
+        if (*findResult->second != particle) {
+            result.changedContent.addParticle(particle);
+        }
+        baseParticleById.erase(findResult);
+    }
+    for (auto const& particle : base.particles) {
+        if (baseParticleById.contains(particle.id)) {
+            result.removedParticleIds.emplace_back(particle.id);
+        }
+    }
+    return result;
+}
+
+void SimulationDeltaService::applyDelta(ClusteredDataDescription& content, SimulationDelta const& delta) const
+{
+    std::unordered_set<uint64_t> removedCellIds(delta.removedCellIds.begin(), delta.removedCellIds.end());
+    std::unordered_map<uint64_t, CellDescription const*> changedCellById;
+    for (auto const& cluster : delta.changedContent.clusters) {
+        for (auto const& cell : cluster.cells) {
+            changedCellById.emplace(cell.id, &cell);
+        }
+    }
+
+    std::vector<ClusterDescription> clusters;
+    clusters.reserve(content.clusters.size());
+    for (auto& cluster : content.clusters) {
+        ClusterDescription newCluster;
+        newCluster.cells.reserve(cluster.cells.size());
+        for (auto& cell : cluster.cells) {
+            if (removedCellIds.contains(cell.id)) {
+                continue;
+            }
+            if (auto findResult = changedCellById.find(cell.id); findResult != changedCellById.end()) {
+                newCluster.cells.emplace_back(*findResult->second);
+                changedCellById.erase(findResult);
+            } else {
+                newCluster.cells.emplace_back(std::move(cell));
+            }
+        }
+        if (!newCluster.cells.empty()) {
+            clusters.emplace_back(std::move(newCluster));
+        }
+    }
+    for (auto const& cluster : delta.changedContent.clusters) {
+        ClusterDescription addedCluster;
+        for (auto const& cell : cluster.cells) {
+            if (changedCellById.contains(cell.id)) {
+                addedCluster.addCell(cell);
+            }
+        }
+        if (!addedCluster.cells.empty()) {
+            clusters.emplace_back(std::move(addedCluster));
+        }
+    }
+    content.clusters = std::move(clusters);
+
+    std::unordered_set<uint64_t> removedParticleIds(delta.removedParticleIds.begin(), delta.removedParticleIds.end());
+    std::unordered_map<uint64_t, ParticleDescription const*> changedParticleById;
+    for (auto const& particle : delta.changedContent.particles) {
+        changedParticleById.emplace(particle.id, &particle);
+    }
+    std::vector<ParticleDescription> particles;
+    particles.reserve(content.particles.size());
+    for (auto const& particle : content.particles) {
+        if (removedParticleIds.contains(particle.id)) {
+            continue;
+        }
+        if (auto findResult = changedParticleById.find(particle.id); findResult != changedParticleById.end()) {
+            particles.emplace_back(*findResult->second);
+            changedParticleById.erase(findResult);
+        } else {
+            particles.emplace_back(particle);
+        }
+    }
+    for (auto const& particle : delta.changedContent.particles) {
+        if (changedParticleById.contains(particle.id)) {
+            particles.emplace_back(particle);
+        }
+    }
+    content.particles = std::move(particles);
+}
+
+boost::property_tree::ptree SimulationDeltaService::calcDelta(boost::property_tree::ptree const& base, boost::property_tree::ptree const& tree) const
+{
+    boost::property_tree::ptree result;
+    for (auto const& [key, subtree] : tree) {
+        auto findResult = base.find(key);
+        if (findResult == base.not_found()) {
+            result.push_back(std::make_pair(key, subtree));
+            continue;
+        }
+        auto const& baseSubtree = findResult->second;
+        if (subtree.empty()) {
+            if (!baseSubtree.empty() || baseSubtree.data() != subtree.data()) {
+                result.push_back(std::make_pair(key, subtree));
+            }
+        } else {
+            auto subtreeDelta = calcDelta(baseSubtree, subtree);
+            if (!subtreeDelta.empty()) {
+                result.push_back(std::make_pair(key, subtreeDelta));
+            }
+        }
+    }
+
+    boost::property_tree::ptree removedKeys;
+    for (auto const& [key, baseSubtree] : base) {
+        if (tree.find(key) == tree.not_found()) {
+            removedKeys.push_back(std::make_pair("", boost::property_tree::ptree(key)));
+        }
+    }
+    if (!removedKeys.empty()) {
+        result.push_back(std::make_pair(RemovedKeysKey, removedKeys));
+    }
+    return result;
+}
+
+void SimulationDeltaService::applyDelta(boost::property_tree::ptree& tree, boost::property_tree::ptree const& delta) const
+{
+    for (auto const& [key, subtree] : delta) {
+        if (key == RemovedKeysKey) {
+            for (auto const& [index, removedKey] : subtree) {
+                tree.erase(removedKey.data());
+            }
+            continue;
+        }
+        auto findResult = tree.find(key);
+        if (findResult == tree.not_found()) {
+            tree.push_back(std::make_pair(key, subtree));
+            continue;
+        }
+        auto& targetSubtree = tree.to_iterator(findResult)->second;
+        if (subtree.empty()) {
+            targetSubtree = subtree;
+        } else {
+            applyDelta(targetSubtree, subtree);
+        }
+    }
+}
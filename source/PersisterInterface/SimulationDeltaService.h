@@ -0,0 +1,31 @@
+#pragma once
+
+#include <boost/property_tree/ptree.hpp>
+
+#include "Base/Singleton.h"
+
+#include "Definitions.h"
+#include "SimulationDelta.h"
+
+/**
+ * Cells and particles are matched by their ids. Applying a delta replaces changed objects in place and appends added cells in clusters of
+ * their own, hence the cluster grouping may differ from the original one, which is irrelevant for the engine.
+ * Settings are compared on the level of the JSON trees: a delta tree only contains the values which differ from the base tree and lists
+ * the keys which are missing in the tree under RemovedKeysKey.
+ */
+class SimulationDeltaService
+{
+    MAKE_SINGLETON(SimulationDeltaService);
+
+public:
+    static auto constexpr RemovedKeysKey = "$removed";
+
+    //path of the base file as it is stored in a delta file
+    std::filesystem::path calcBaseFilename(std::filesystem::path const& filename, std::filesystem::path const& baseFilename) const;
+
+    SimulationDelta calcDelta(ClusteredDataDescription const& base, ClusteredDataDescription const& content) const;
+    void applyDelta(ClusteredDataDescription& content, SimulationDelta const& delta) const;
+
+    boost::property_tree::ptree calcDelta(boost::property_tree::ptree const& base, boost::property_tree::ptree const& tree) const;
+    void applyDelta(boost::property_tree::ptree& tree, boost::property_tree::ptree const& delta) const;
+};
@@ -0,0 +1,209 @@
+#include "SimulationHistory.h"
+
+#include <sstream>
+#include <stdexcept>
+
+#include "ColumnarSnapshotService.h"
+#include "SimulationDeltaService.h"
+#include "SimulationParametersPatchService.h"
+
+namespace
+{
+    template <typename T>
+    std::vector<uint8_t> encode(T const& value)
+    {
+        std::ostringstream stream(std::ios::binary);
+        ColumnarSnapshotService::get().serialize(value, stream);
+        auto bytes = stream.str();
+        return std::vector<uint8_t>(bytes.begin(), bytes.end());
+    }
+}
+
+SimulationHistory::SimulationHistory(uint64_t memoryBudget)
+    : _memoryBudget(memoryBudget)
+{}
+
+void SimulationHistory::setMemoryBudget(uint64_t value)
+{
+    _memoryBudget = value;
+    evictOldestStates();
+}
+
+uint64_t SimulationHistory::getMemoryBudget() const
+{
+    return _memoryBudget;
+}
+
+uint64_t SimulationHistory::getMemoryUsage() const
+{
+    return _memoryUsage;
+}
+
+bool SimulationHistory::isEmpty() const
+{
+    return _states.empty();
+}
+
+int SimulationHistory::getSize() const
+{
+    return toInt(_states.size());
+}
+
+void SimulationHistory::clear()
+{
+    _states.clear();
+    _latestContent.reset();
+    _latestParameters.reset();
+    _memoryUsage = 0;
+}
+
+void SimulationHistory::push(SimulationHistoryEntry entry)
+{
+    StoredState state;
+    state.timestep = entry.timestep;
+    state.realTime = entry.realTime;
+
+    auto numDeltas = 0;
+    for (auto it = _states.rbegin(); it != _states.rend() && !it->keyframe; ++it) {
+        ++numDeltas;
+    }
+    if (_states.empty() || numDeltas + 1 >= KeyframeInterval) {
+        state.keyframe = true;
+        state.content = encode(entry.data);
+    } else {
+        state.content = encode(SimulationDeltaService::get().calcDelta(getLatestContent(), entry.data));
+    }
+
+    std::shared_ptr<SimulationParameters const> parameters;
+    if (!_states.empty()) {
+        auto const& latestParameters = getLatestParameters();
+        state.parametersPatch = SimulationParametersPatchService::get().calcPatch(*latestParameters, entry.parameters);
+        if (state.parametersPatch.isEmpty()) {
+            parameters = latestParameters;
+        }
+    }
+    if (!parameters) {
+        parameters = std::make_shared<SimulationParameters const>(std::move(entry.parameters));
+    }
+    if (state.keyframe) {
+        state.parameters = parameters;
+        state.parametersPatch = SimulationParametersPatch();
+    }
+
+    _states.emplace_back(std::move(state));
+    _latestContent = std::move(entry.data);
+    _latestParameters = std::move(parameters);
+    _memoryUsage += getStateSize(getSize() - 1);
+
+    evictOldestStates();
+}
+
+SimulationHistoryEntry SimulationHistory::pop()
+{
+    if (_states.empty()) {
+        throw std::runtime_error("Simulation history is empty.");
+    }
+    getLatestContent();
+
+    auto const& state = _states.back();
+    SimulationHistoryEntry result;
+    result.timestep = state.timestep;
+    result.realTime = state.realTime;
+    result.parameters = *getLatestParameters();
+    result.data = std::move(*_latestContent);
+
+    _memoryUsage -= getStateSize(getSize() - 1);
+    _states.pop_back();
+    _latestContent.reset();
+    _latestParameters.reset();
+    return result;
+}
+
+ClusteredDataDescription SimulationHistory::decode(int index) const
+{
+    auto keyframeIndex = index;
+    while (!_states.at(keyframeIndex).keyframe) {
+        --keyframeIndex;
+    }
+
+    ClusteredDataDescription result;
+    ColumnarSnapshotService::get().deserialize(result, _states.at(keyframeIndex).content);
+    for (int i = keyframeIndex + 1; i <= index; ++i) {
+        SimulationDelta delta;
+        ColumnarSnapshotService::get().deserialize(delta, _states.at(i).content);
+        SimulationDeltaService::get().applyDelta(result, delta);
+    }
+    return result;
+}
+
+ClusteredDataDescription const& SimulationHistory::getLatestContent()
+{
+    if (!_latestContent.has_value()) {
+        _latestContent = decode(getSize() - 1);
+    }
+    return *_latestContent;
+}
+
+std::shared_ptr<SimulationParameters const> SimulationHistory::decodeParameters(int index) const
+{
+    auto keyframeIndex = index;
+    while (!_states.at(keyframeIndex).keyframe) {
+        --keyframeIndex;
+    }
+
+    auto result = _states.at(keyframeIndex).parameters;
+    for (int i = keyframeIndex + 1; i <= index; ++i) {
+        auto const& patch = _states.at(i).parametersPatch;
+        if (patch.isEmpty()) {
+            continue;
+        }
+        auto parameters = *result;
+        if (!SimulationParametersPatchService::get().applyPatch(parameters, patch)) {
+            throw std::runtime_error("Simulation parameters of the history could not be restored.");
+        }
+        result = std::make_shared<SimulationParameters const>(std::move(parameters));
+    }
+    return result;
+}
+
+std::shared_ptr<SimulationParameters const> const& SimulationHistory::getLatestParameters()
+{
+    if (!_latestParameters) {
+        _latestParameters = decodeParameters(getSize() - 1);
+    }
+    return _latestParameters;
+}
+
+void SimulationHistory::evictOldestStates()
+{
+    while (_memoryUsage > _memoryBudget && _states.size() > 1) {
+        _memoryUsage -= getStateSize(0) + getStateSize(1);
+        if (!_states.at(1).keyframe) {
+            _states.at(1).content = _states.size() == 2 ? encode(getLatestContent()) : encode(decode(1));
+            _states.at(1).parameters = _states.size() == 2 ? getLatestParameters() : decodeParameters(1);
+            _states.at(1).parametersPatch = SimulationParametersPatch();
+            _states.at(1).keyframe = true;
+        }
+        _states.pop_front();
+        _memoryUsage += getStateSize(0);
+    }
+}
+
+uint64_t SimulationHistory::getStateSize(int index) const
+{
+    auto const& state = _states.at(index);
+    uint64_t result = sizeof(StoredState) + state.content.size() + state.parametersPatch.data.size();
+    if (!state.keyframe) {
+        return result;
+    }
+
+    //parameters of a keyframe are only counted if they are not shared with the preceding keyframe
+    auto previousKeyframeIndex = index - 1;
+    while (previousKeyframeIndex >= 0 && !_states.at(previousKeyframeIndex).keyframe) {
+        --previousKeyframeIndex;
+    }
+    if (previousKeyframeIndex < 0 || _states.at(previousKeyframeIndex).parameters != state.parameters) {
+        result += sizeof(SimulationParameters);
+    }
+    return result;
+}
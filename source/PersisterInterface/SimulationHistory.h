@@ -0,0 +1,75 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/SimulationParameters.h"
+
+#include "Definitions.h"
+#include "SimulationParametersPatch.h"
+
+struct SimulationHistoryEntry
+{
+    uint64_t timestep = 0;
+    std::chrono::milliseconds realTime = std::chrono::milliseconds(0);
+    SimulationParameters parameters;
+    ClusteredDataDescription data;
+};
+
+/**
+ * In-memory history of consecutive simulation states with a memory budget.
+ * Every KeyframeInterval-th state is stored as compressed columnar snapshot (keyframe), the states in between as compressed deltas to
+ * their predecessor. Simulation parameters are stored in the same way: completely for keyframes, where unchanged parameters are shared, and
+ * as field-level patches for deltas. If the budget is exceeded, the oldest states are evicted and a delta becoming the oldest state is
+ * converted into a keyframe. The most recent state is always kept.
+ * The content and parameters of the most recent state are additionally held decoded for calculating the next delta, the content is not
+ * included in getMemoryUsage().
+ */
+class SimulationHistory
+{
+public:
+    static int constexpr KeyframeInterval = 16;
+
+    SimulationHistory(uint64_t memoryBudget);
+
+    void setMemoryBudget(uint64_t value);
+    uint64_t getMemoryBudget() const;
+    uint64_t getMemoryUsage() const;
+
+    bool isEmpty() const;
+    int getSize() const;
+    void clear();
+
+    void push(SimulationHistoryEntry entry);  //throws std::runtime_error
+    SimulationHistoryEntry pop();  //throws std::runtime_error
+
+private:
+    struct StoredState
+    {
+        uint64_t timestep = 0;
+        std::chrono::milliseconds realTime;
+        bool keyframe = false;
+        std::shared_ptr<SimulationParameters const> parameters;  //only for keyframes
+        SimulationParametersPatch parametersPatch;  //only for deltas
+        std::vector<uint8_t> content;  //columnar snapshot or columnar delta snapshot
+    };
+
+    ClusteredDataDescription decode(int index) const;
+    ClusteredDataDescription const& getLatestContent();
+    std::shared_ptr<SimulationParameters const> decodeParameters(int index) const;
+    std::shared_ptr<SimulationParameters const> const& getLatestParameters();
+
+    void evictOldestStates();
+    uint64_t getStateSize(int index) const;
+
+    uint64_t _memoryBudget = 0;
+    uint64_t _memoryUsage = 0;
+    std::deque<StoredState> _states;
+    std::optional<ClusteredDataDescription> _latestContent;
+    std::shared_ptr<SimulationParameters const> _latestParameters;
+};
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+//changed fields of simulation parameters relative to base parameters, created and applied by SimulationParametersPatchService
+struct SimulationParametersPatch
+{
+    std::vector<uint8_t> data;  //node path and binary encoded value for each changed field
+
+    bool isEmpty() const { return data.empty(); }
+    bool operator==(SimulationParametersPatch const& other) const = default;
+};
@@ -0,0 +1,236 @@
+#include "SimulationParametersPatchService.h"
+
+#include <algorithm>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+
+#include "ParameterReflection.h"
+
+namespace
+{
+    //node paths and binary encoded values of all leaves in visiting order
+    class LeafCollector
+    {
+    public:
+        template <typename T>
+        bool leaf(T& value, T const& defaultValue, std::string_view path)
+        {
+            _paths.append(path);
+            _pathEnds.emplace_back(_paths.size());
+            ParameterBinaryWriter writer(_values);
+            writer.leaf(value, defaultValue, path);
+            _valueEnds.emplace_back(_values.size());
+            return false;
+        }
+
+        size_t getNumLeaves() const { return _pathEnds.size(); }
+
+        std::string_view getPath(size_t index) const
+        {
+            auto start = index == 0 ? 0 : _pathEnds[index - 1];
+            return std::string_view(_paths).substr(start, _pathEnds[index] - start);
+        }
+
+        std::span<uint8_t const> getValue(size_t index) const
+        {
+            auto start = index == 0 ? 0 : _valueEnds[index - 1];
+            return std::span<uint8_t const>(_values).subspan(start, _valueEnds[index] - start);
+        }
+
+    private:
+        std::string _paths;
+        std::vector<size_t> _pathEnds;
+        std::vector<uint8_t> _values;
+        std::vector<size_t> _valueEnds;
+    };
+
+    LeafCollector collectLeaves(SimulationParameters const& parameters)
+    {
+        LeafCollector result;
+        ParameterLeafAdapter adapter(result);
+        std::string programVersion;
+        MissingParameters missingParameters;
+        MissingFeatures missingFeatures;
+        auto& parametersToVisit = const_cast<SimulationParameters&>(parameters);
+        ParameterReflection::reflectSimulationParameters(adapter, parametersToVisit, programVersion, missingParameters, missingFeatures);
+        ParameterReflection::reflectRuntimeParameters(adapter, parametersToVisit);
+        return result;
+    }
+
+    //returns the indices of the leaves whose path does not exist in the base leaves or whose value differs
+    std::vector<size_t> calcChangedLeaves(LeafCollector const& baseLeaves, LeafCollector const& leaves)
+    {
+        std::vector<size_t> result;
+
+        //both leaf sequences coincide until a count or type differs
+        size_t index = 0;
+        for (auto numCommonLeaves = std::min(baseLeaves.getNumLeaves(), leaves.getNumLeaves()); index < numCommonLeaves; ++index) {
+            if (baseLeaves.getPath(index) != leaves.getPath(index)) {
+                break;
+            }
+            if (!std::ranges::equal(baseLeaves.getValue(index), leaves.getValue(index))) {
+                result.emplace_back(index);
+            }
+        }
+        if (index == leaves.getNumLeaves()) {
+            return result;
+        }
+
+        std::unordered_map<std::string_view, size_t> baseIndexByPath;
+        for (auto baseIndex = index; baseIndex < baseLeaves.getNumLeaves(); ++baseIndex) {
+            baseIndexByPath.emplace(baseLeaves.getPath(baseIndex), baseIndex);
+        }
+        for (; index < leaves.getNumLeaves(); ++index) {
+            auto findResult = baseIndexByPath.find(leaves.getPath(index));
+            if (findResult == baseIndexByPath.end() || !std::ranges::equal(baseLeaves.getValue(findResult->second), leaves.getValue(index))) {
+                result.emplace_back(index);
+            }
+        }
+        return result;
+    }
+
+    [[noreturn]] void throwCorruptedPatch()
+    {
+        throw std::runtime_error("Simulation parameters patch is corrupted.");
+    }
+
+    //entry layout: 16-bit path length, path, 32-bit value length, binary encoded value
+    template <typename T>
+    void writeBytes(std::vector<uint8_t>& data, T const& value)
+    {
+        auto bytes = reinterpret_cast<uint8_t const*>(&value);
+        data.insert(data.end(), bytes, bytes + sizeof(T));
+    }
+
+    template <typename T>
+    T readBytes(std::vector<uint8_t> const& data, size_t& pos)
+    {
+        if (data.size() - pos < sizeof(T)) {
+            throwCorruptedPatch();
+        }
+        T result;
+        std::memcpy(&result, data.data() + pos, sizeof(T));
+        pos += sizeof(T);
+        return result;
+    }
+
+    struct PatchValueRange
+    {
+        size_t start;
+        size_t end;
+    };
+
+    std::unordered_map<std::string_view, PatchValueRange> getValueRangeByPath(SimulationParametersPatch const& patch)
+    {
+        std::unordered_map<std::string_view, PatchValueRange> result;
+        size_t pos = 0;
+        while (pos < patch.data.size()) {
+            auto pathLength = readBytes<uint16_t>(patch.data, pos);
+            if (patch.data.size() - pos < pathLength) {
+                throwCorruptedPatch();
+            }
+            std::string_view path(reinterpret_cast<char const*>(patch.data.data() + pos), pathLength);
+            pos += pathLength;
+
+            auto valueLength = readBytes<uint32_t>(patch.data, pos);
+            if (patch.data.size() - pos < valueLength) {
+                throwCorruptedPatch();
+            }
+            if (!result.emplace(path, PatchValueRange{pos, pos + valueLength}).second) {
+                throwCorruptedPatch();
+            }
+            pos += valueLength;
+        }
+        return result;
+    }
+
+    class PatchApplier
+    {
+    public:
+        PatchApplier(SimulationParametersPatch const& patch, std::unordered_map<std::string_view, PatchValueRange> const& valueRangeByPath)
+            : _patch(patch)
+            , _valueRangeByPath(valueRangeByPath)
+        {}
+
+        template <typename T>
+        bool leaf(T& value, T const& defaultValue, std::string_view path)
+        {
+            auto findResult = _valueRangeByPath.find(path);
+            if (findResult == _valueRangeByPath.end()) {
+                return false;
+            }
+            auto const& [start, end] = findResult->second;
+            ParameterBinaryReader reader(_patch.data, start);
+            reader.leaf(value, defaultValue, path);
+            if (reader.getPos() != end) {
+                throwCorruptedPatch();
+            }
+            ++_numAppliedValues;
+            return false;
+        }
+
+        size_t getNumAppliedValues() const { return _numAppliedValues; }
+
+    private:
+        SimulationParametersPatch const& _patch;
+        std::unordered_map<std::string_view, PatchValueRange> const& _valueRangeByPath;
+        size_t _numAppliedValues = 0;
+    };
+}
+
+std::vector<std::string> SimulationParametersPatchService::calcChangedPaths(
+    SimulationParameters const& base,
+    SimulationParameters const& parameters) const
+{
+    auto baseLeaves = collectLeaves(base);
+    auto leaves = collectLeaves(parameters);
+
+    std::vector<std::string> result;
+    for (auto index : calcChangedLeaves(baseLeaves, leaves)) {
+        result.emplace_back(leaves.getPath(index));
+    }
+    return result;
+}
+
+SimulationParametersPatch SimulationParametersPatchService::calcPatch(SimulationParameters const& base, SimulationParameters const& parameters) const
+{
+    auto baseLeaves = collectLeaves(base);
+    auto leaves = collectLeaves(parameters);
+
+    SimulationParametersPatch result;
+    for (auto index : calcChangedLeaves(baseLeaves, leaves)) {
+        auto path = leaves.getPath(index);
+        auto value = leaves.getValue(index);
+        writeBytes(result.data, static_cast<uint16_t>(path.size()));
+        result.data.insert(result.data.end(), path.begin(), path.end());
+        writeBytes(result.data, static_cast<uint32_t>(value.size()));
+        result.data.insert(result.data.end(), value.begin(), value.end());
+    }
+    return result;
+}
+
+bool SimulationParametersPatchService::applyPatch(SimulationParameters& parameters, SimulationParametersPatch const& patch) const
+{
+    auto valueRangeByPath = getValueRangeByPath(patch);
+    if (valueRangeByPath.empty()) {
+        return true;
+    }
+
+    //counts and types are visited before their dependent fields, hence the patched values determine the visited fields
+    auto result = parameters;
+    PatchApplier leafVisitor(patch, valueRangeByPath);
+    ParameterLeafAdapter adapter(leafVisitor);
+    std::string programVersion;
+    MissingParameters missingParameters;
+    MissingFeatures missingFeatures;
+    ParameterReflection::reflectSimulationParameters(adapter, result, programVersion, missingParameters, missingFeatures);
+    ParameterReflection::reflectRuntimeParameters(adapter, result);
+    if (leafVisitor.getNumAppliedValues() != valueRangeByPath.size()) {
+        return false;
+    }
+    parameters = result;
+    return true;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Base/Singleton.h"
+#include "EngineInterface/SimulationParameters.h"
+
+#include "Definitions.h"
+#include "SimulationParametersPatch.h"
+
+/**
+ * Field-level diffs of simulation parameters based on the node paths of ParameterReflection including the runtime fields.
+ * Fields which only exist in the base parameters (e.g. of removed zones or of a former motion type) are not part of a patch
+ * since they are not visited after the new counts and types have been applied.
+ */
+class SimulationParametersPatchService
+{
+    MAKE_SINGLETON(SimulationParametersPatchService);
+
+public:
+    std::vector<std::string> calcChangedPaths(SimulationParameters const& base, SimulationParameters const& parameters) const;
+    SimulationParametersPatch calcPatch(SimulationParameters const& base, SimulationParameters const& parameters) const;
+
+    //returns false and leaves the parameters unchanged if the patch contains fields which do not exist in the patched parameters
+    //throws std::runtime_error for corrupted patches
+    bool applyPatch(SimulationParameters& parameters, SimulationParametersPatch const& patch) const;
+};
@@ -0,0 +1,158 @@
+#include "StatisticsHistoryFileService.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+
+namespace
+{
+    static_assert(std::is_trivially_copyable_v<DataPointCollection>);
+    static_assert(sizeof(DataPointCollection) % sizeof(uint64_t) == 0);
+    uint64_t constexpr RowSize = sizeof(DataPointCollection);
+
+    struct FileInfo
+    {
+        uint64_t headerSize = 0;
+        uint64_t numRows = 0;
+        uint64_t numStableRows = 0;
+        uint64_t stableRowsChecksum = 0;
+    };
+
+    FileInfo readFileInfo(std::filesystem::path const& filename)
+    {
+        std::ifstream stream(filename, std::ios::binary);
+        if (!stream) {
+            throw std::runtime_error("Could not open statistics history file.");
+        }
+        auto fileSize = std::filesystem::file_size(filename);
+
+        StatisticsHistoryFile::Header header;
+        stream.read(reinterpret_cast<char*>(&header), StatisticsHistoryFile::HeaderSizeVersion1);
+        if (!stream || fileSize < StatisticsHistoryFile::HeaderSizeVersion1) {
+            throw std::runtime_error("Statistics history file is truncated.");
+        }
+        if (std::memcmp(header.magic, StatisticsHistoryFile::Magic, sizeof(header.magic)) != 0) {
+            throw std::runtime_error("File is not a statistics history file.");
+        }
+        if ((header.formatVersion != 1 && header.formatVersion != StatisticsHistoryFile::FormatVersion) || header.rowSize != RowSize) {
+            throw std::runtime_error("Format version of statistics history file not supported.");
+        }
+
+        FileInfo result;
+        if (header.formatVersion == 1) {
+            result.headerSize = StatisticsHistoryFile::HeaderSizeVersion1;
+        } else {
+            stream.read(reinterpret_cast<char*>(&header) + StatisticsHistoryFile::HeaderSizeVersion1, sizeof(header) - StatisticsHistoryFile::HeaderSizeVersion1);
+            if (!stream) {
+                throw std::runtime_error("Statistics history file is truncated.");
+            }
+            result.headerSize = sizeof(header);
+            result.numStableRows = header.numStableRows;
+            result.stableRowsChecksum = header.stableRowsChecksum;
+        }
+        result.numRows = (fileSize - result.headerSize) / RowSize;
+        return result;
+    }
+
+    //FNV-1a over the 64 bit words of the rows
+    uint64_t calcChecksum(StatisticsHistoryData const& statistics, uint64_t numRows)
+    {
+        uint64_t result = 14695981039346656037ull;
+        auto bytes = reinterpret_cast<char const*>(statistics.data());
+        for (uint64_t offset = 0; offset < numRows * RowSize; offset += sizeof(uint64_t)) {
+            uint64_t word;
+            std::memcpy(&word, bytes + offset, sizeof(word));
+            result ^= word;
+            result *= 1099511628211ull;
+        }
+        return result;
+    }
+
+    StatisticsHistoryFile::Header createHeader(StatisticsHistoryData const& statistics, uint64_t numStableRows)
+    {
+        StatisticsHistoryFile::Header result;
+        std::memcpy(result.magic, StatisticsHistoryFile::Magic, sizeof(result.magic));
+        result.formatVersion = StatisticsHistoryFile::FormatVersion;
+        result.rowSize = static_cast<uint32_t>(RowSize);
+        result.numStableRows = numStableRows;
+        result.stableRowsChecksum = calcChecksum(statistics, numStableRows);
+        return result;
+    }
+
+    void writeFile(std::filesystem::path const& filename, StatisticsHistoryData const& statistics, uint64_t numStableRows)
+    {
+        auto header = createHeader(statistics, numStableRows);
+
+        std::ofstream stream(filename, std::ios::binary | std::ios::trunc);
+        stream.write(reinterpret_cast<char const*>(&header), sizeof(header));
+        stream.write(reinterpret_cast<char const*>(statistics.data()), statistics.size() * RowSize);
+        stream.close();
+        if (!stream) {
+            throw std::runtime_error("Could not write statistics history file.");
+        }
+    }
+}
+
+void StatisticsHistoryFileService::append(std::filesystem::path const& filename, StatisticsHistoryData const& statistics, uint64_t numStableRows) const
+{
+    numStableRows = std::min(numStableRows, static_cast<uint64_t>(statistics.size()));
+
+    std::optional<FileInfo> fileInfo;
+    if (std::filesystem::exists(filename)) {
+        try {
+            fileInfo = readFileInfo(filename);
+        } catch (std::runtime_error const&) {
+            //file of another format version is replaced
+        }
+    }
+    if (!fileInfo.has_value() || fileInfo->headerSize != sizeof(StatisticsHistoryFile::Header) || fileInfo->numStableRows > fileInfo->numRows
+        || fileInfo->numStableRows > statistics.size() || fileInfo->stableRowsChecksum != calcChecksum(statistics, fileInfo->numStableRows)) {
+        writeFile(filename, statistics, numStableRows);
+        return;
+    }
+
+    //the rows after the stable ones are replaced before the header refers to the new stable rows, hence an interrupted append leaves a
+    //consistent file
+    auto numKeptRows = fileInfo->numStableRows;
+    std::filesystem::resize_file(filename, sizeof(StatisticsHistoryFile::Header) + numKeptRows * RowSize);
+
+    std::fstream stream(filename, std::ios::binary | std::ios::in | std::ios::out);
+    stream.seekp(sizeof(StatisticsHistoryFile::Header) + numKeptRows * RowSize);
+    stream.write(reinterpret_cast<char const*>(statistics.data() + numKeptRows), (statistics.size() - numKeptRows) * RowSize);
+    stream.flush();
+
+    auto header = createHeader(statistics, numStableRows);
+    stream.seekp(0);
+    stream.write(reinterpret_cast<char const*>(&header), sizeof(header));
+    stream.close();
+    if (!stream) {
+        throw std::runtime_error("Could not append to statistics history file.");
+    }
+}
+
+void StatisticsHistoryFileService::write(std::filesystem::path const& filename, StatisticsHistoryData const& statistics) const
+{
+    writeFile(filename, statistics, 0);
+}
+
+void StatisticsHistoryFileService::read(StatisticsHistoryData& statistics, std::filesystem::path const& filename) const
+{
+    auto fileInfo = readFileInfo(filename);
+
+    std::ifstream stream(filename, std::ios::binary);
+    stream.seekg(fileInfo.headerSize);
+    statistics.resize(fileInfo.numRows);
+    stream.read(reinterpret_cast<char*>(statistics.data()), fileInfo.numRows * RowSize);
+    if (!stream) {
+        statistics.clear();
+        throw std::runtime_error("Could not read statistics history file.");
+    }
+}
+
+uint64_t StatisticsHistoryFileService::getNumRows(std::filesystem::path const& filename) const
+{
+    return readFileInfo(filename).numRows;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+#include "Base/Singleton.h"
+#include "EngineInterface/StatisticsHistory.h"
+
+#include "Definitions.h"
+
+/**
+ * Binary sidecar of a simulation file holding its statistics history (*.statistics.bin):
+ *
+ *   header (magic, format version, size of a row, number and checksum of the stable rows)
+ *   rows of DataPointCollection in their memory layout
+ *
+ * The number of rows follows from the file size, hence new rows can be appended without touching the existing content. A row which has
+ * only been written partially (e.g. due to a crash while saving) is ignored when reading. The stable rows are the leading rows which the
+ * history does not change when data points are added (see _StatisticsHistorySnapshot::getNumStableDataPoints), all further rows are
+ * rewritten on each append. The format version has to be increased when the fields of DataPointCollection change.
+ */
+namespace StatisticsHistoryFile
+{
+    char constexpr Magic[8] = {'A', 'L', 'I', 'E', 'N', 'S', 'T', 'A'};
+    uint32_t constexpr FormatVersion = 2;
+
+    struct Header
+    {
+        char magic[8];
+        uint32_t formatVersion;
+        uint32_t rowSize;
+        uint64_t numStableRows;
+        uint64_t stableRowsChecksum;
+    };
+    uint64_t constexpr HeaderSizeVersion1 = offsetof(Header, numStableRows);  //version 1 has no stable rows
+}
+
+class StatisticsHistoryFileService
+{
+    MAKE_SINGLETON(StatisticsHistoryFileService);
+
+public:
+    //keeps the stable rows of the file if their checksum matches the corresponding rows of statistics (otherwise, e.g. after the history
+    //has been reset, the file is rewritten), numStableRows specifies the rows of statistics which can be kept by the next append
+    void append(std::filesystem::path const& filename, StatisticsHistoryData const& statistics, uint64_t numStableRows) const;  //throws std::runtime_error
+    void write(std::filesystem::path const& filename, StatisticsHistoryData const& statistics) const;  //throws std::runtime_error
+    void read(StatisticsHistoryData& statistics, std::filesystem::path const& filename) const;  //throws std::runtime_error
+
+    uint64_t getNumRows(std::filesystem::path const& filename) const;  //throws std::runtime_error
+};